@@ -7,6 +7,7 @@
 
 #include <stddef.h>
 
+#include <cstddef>
 #include <functional>
 #include <memory>
 #include <tuple>
@@ -815,6 +816,9 @@ struct BindState final : BindStateBase {
     // a common pattern of racy situation.
     BanUnconstructedRefCountedReceiver<ForwardFunctor>(bound_args...);
 
+    static_assert(alignof(BindState) <= alignof(std::max_align_t),
+                  "BindStateAllocator doesn't support over-aligned BindStates.");
+
     // IsCancellable is std::false_type if
     // CallbackCancellationTraits<>::IsCancelled returns always false.
     // Otherwise, it's std::true_type.
@@ -823,6 +827,15 @@ struct BindState final : BindStateBase {
                          std::forward<ForwardBoundArgs>(bound_args)...);
   }
 
+  // BindStates are allocated through BindStateAllocator, which recycles small
+  // blocks.
+  static void* operator new(size_t size) {
+    return BindStateAllocator::Allocate(size);
+  }
+  static void operator delete(void* ptr, size_t size) {
+    BindStateAllocator::Free(ptr, size);
+  }
+
   Functor functor_;
   std::tuple<BoundArgs...> bound_args_;
 
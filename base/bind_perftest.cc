@@ -0,0 +1,85 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/bind.h"
+
+#include <array>
+#include <string>
+
+#include "base/callback.h"
+#include "base/callback_internal.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+
+namespace {
+
+#if DCHECK_IS_ON()
+constexpr int kLaps = 100000;
+#else
+constexpr int kLaps = 10000000;
+#endif
+
+// Ask the compiler not to use a register for this counter, in case it decides
+// to do magic optimizations like |counter += kLaps|.
+volatile int g_bind_perf_test_counter;
+
+void Increment() {
+  ++g_bind_perf_test_counter;
+}
+
+template <size_t kSize>
+void IncrementWithPayload(const std::array<char, kSize>& payload) {
+  g_bind_perf_test_counter += payload[0];
+}
+
+// Binds and runs |kLaps| OnceClosures created by |bind|, then prints the time
+// per closure and the number of BindState blocks cached by this thread.
+template <typename BindFunction>
+void RunBindPerfTest(const std::string& trace, BindFunction bind) {
+  // Warm up the BindState cache.
+  for (int i = 0; i < 100; ++i)
+    bind().Run();
+
+  g_bind_perf_test_counter = 0;
+  const TimeTicks start = TimeTicks::Now();
+  for (int i = 0; i < kLaps; ++i)
+    bind().Run();
+  const TimeDelta duration = TimeTicks::Now() - start;
+
+  EXPECT_EQ(kLaps, g_bind_perf_test_counter);
+  perf_test::PrintResult("BindOnceAndRun", "", trace,
+                         duration.InNanosecondsF() / kLaps, "ns/closure",
+                         true);
+  perf_test::PrintResult(
+      "BindOnceAndRun_cached_blocks", "", trace,
+      internal::BindStateAllocator::GetCachedBlockCountForTesting(), "blocks",
+      true);
+}
+
+}  // namespace
+
+TEST(BindPerfTest, NoBoundArgs) {
+  RunBindPerfTest("no_bound_args", [] { return BindOnce(&Increment); });
+}
+
+TEST(BindPerfTest, SmallBoundArgs) {
+  std::array<char, 32> payload = {1};
+  RunBindPerfTest("32_byte_bound_args", [&payload] {
+    return BindOnce(&IncrementWithPayload<32>, payload);
+  });
+}
+
+// Exceeds BindStateAllocator::kMaxCachedSize, so every BindState goes through
+// the heap.
+TEST(BindPerfTest, LargeBoundArgs) {
+  std::array<char, 256> payload = {1};
+  RunBindPerfTest("256_byte_bound_args", [&payload] {
+    return BindOnce(&IncrementWithPayload<256>, payload);
+  });
+}
+
+}  // namespace base
@@ -1549,6 +1549,33 @@ TEST_F(BindTest, BindNoexcept) {
               .Run());
 }
 
+#if !defined(ADDRESS_SANITIZER) && !defined(MEMORY_SANITIZER) && \
+    !defined(THREAD_SANITIZER)
+// Small BindState blocks are recycled by the thread which frees them.
+TEST_F(BindTest, BindStateAllocatorReusesSmallBlocks) {
+  void* block = internal::BindStateAllocator::Allocate(24);
+  internal::BindStateAllocator::Free(block, 24);
+  const size_t cached_blocks =
+      internal::BindStateAllocator::GetCachedBlockCountForTesting();
+  EXPECT_GT(cached_blocks, 0u);
+
+  // Any size of the same size class can reuse the block.
+  void* reused_block = internal::BindStateAllocator::Allocate(32);
+  EXPECT_EQ(block, reused_block);
+  EXPECT_EQ(cached_blocks - 1,
+            internal::BindStateAllocator::GetCachedBlockCountForTesting());
+  internal::BindStateAllocator::Free(reused_block, 32);
+
+  // Blocks above the threshold aren't cached.
+  constexpr size_t kLargeSize =
+      internal::BindStateAllocator::kMaxCachedSize + 1;
+  void* large_block = internal::BindStateAllocator::Allocate(kLargeSize);
+  internal::BindStateAllocator::Free(large_block, kLargeSize);
+  EXPECT_EQ(cached_blocks,
+            internal::BindStateAllocator::GetCachedBlockCountForTesting());
+}
+#endif
+
 // Test null callbacks cause a DCHECK.
 TEST(BindDeathTest, NullCallback) {
   base::Callback<void(int)> null_cb;
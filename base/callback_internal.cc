@@ -4,7 +4,11 @@
 
 #include "base/callback_internal.h"
 
+#include <stdlib.h>
+
 #include "base/logging.h"
+#include "base/no_destructor.h"
+#include "base/threading/thread_local_storage.h"
 
 namespace base {
 namespace internal {
@@ -23,8 +27,123 @@ bool QueryCancellationTraitsForNonCancellables(
   NOTREACHED();
 }
 
+// Sanitizers need every BindState to go through malloc to detect use-after-free
+// of recycled blocks.
+#if defined(ADDRESS_SANITIZER) || defined(MEMORY_SANITIZER) || \
+    defined(THREAD_SANITIZER)
+constexpr bool kUseBindStateCache = false;
+#else
+constexpr bool kUseBindStateCache = true;
+#endif
+
+// Blocks are cached in size classes of |kSizeClassGranularity| bytes.
+constexpr size_t kSizeClassGranularity = 16;
+constexpr size_t kNumSizeClasses =
+    BindStateAllocator::kMaxCachedSize / kSizeClassGranularity;
+
+// Bounds the memory held by an idle thread.
+constexpr size_t kMaxCachedBlocksPerSizeClass = 32;
+
+size_t GetSizeClass(size_t size) {
+  DCHECK_GT(size, 0u);
+  return (size - 1) / kSizeClassGranularity;
+}
+
+// Per-thread free lists of BindState blocks. A free block stores the pointer
+// to the next free block of its size class.
+struct BindStateCache {
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  ~BindStateCache() {
+    for (FreeBlock* head : free_lists) {
+      while (head) {
+        FreeBlock* next = head->next;
+        free(head);
+        head = next;
+      }
+    }
+  }
+
+  FreeBlock* free_lists[kNumSizeClasses] = {};
+  size_t num_free_blocks[kNumSizeClasses] = {};
+};
+
+void DeleteBindStateCache(void* cache) {
+  delete static_cast<BindStateCache*>(cache);
+}
+
+ThreadLocalStorage::Slot& GetBindStateCacheTLS() {
+  static NoDestructor<ThreadLocalStorage::Slot> bind_state_cache_tls(
+      &DeleteBindStateCache);
+  return *bind_state_cache_tls;
+}
+
 }  // namespace
 
+// static
+void* BindStateAllocator::Allocate(size_t size) {
+  if (!kUseBindStateCache || size > kMaxCachedSize)
+    return ::operator new(size);
+
+  const size_t size_class = GetSizeClass(size);
+  if (!ThreadLocalStorage::HasBeenDestroyed()) {
+    auto* cache = static_cast<BindStateCache*>(GetBindStateCacheTLS().Get());
+    if (cache && cache->free_lists[size_class]) {
+      BindStateCache::FreeBlock* block = cache->free_lists[size_class];
+      cache->free_lists[size_class] = block->next;
+      --cache->num_free_blocks[size_class];
+      return block;
+    }
+  }
+
+  // Allocate the full size class so that the block can be reused for any
+  // BindState of the same class, on any thread.
+  void* block = malloc((size_class + 1) * kSizeClassGranularity);
+  CHECK(block);
+  return block;
+}
+
+// static
+void BindStateAllocator::Free(void* ptr, size_t size) {
+  if (!kUseBindStateCache || size > kMaxCachedSize) {
+    ::operator delete(ptr);
+    return;
+  }
+
+  const size_t size_class = GetSizeClass(size);
+  if (!ThreadLocalStorage::HasBeenDestroyed()) {
+    ThreadLocalStorage::Slot& tls = GetBindStateCacheTLS();
+    auto* cache = static_cast<BindStateCache*>(tls.Get());
+    if (!cache) {
+      cache = new BindStateCache;
+      tls.Set(cache);
+    }
+    if (cache->num_free_blocks[size_class] < kMaxCachedBlocksPerSizeClass) {
+      auto* block = static_cast<BindStateCache::FreeBlock*>(ptr);
+      block->next = cache->free_lists[size_class];
+      cache->free_lists[size_class] = block;
+      ++cache->num_free_blocks[size_class];
+      return;
+    }
+  }
+  free(ptr);
+}
+
+// static
+size_t BindStateAllocator::GetCachedBlockCountForTesting() {
+  if (!kUseBindStateCache || ThreadLocalStorage::HasBeenDestroyed())
+    return 0;
+  auto* cache = static_cast<BindStateCache*>(GetBindStateCacheTLS().Get());
+  if (!cache)
+    return 0;
+  size_t count = 0;
+  for (size_t num_free_blocks : cache->num_free_blocks)
+    count += num_free_blocks;
+  return count;
+}
+
 void BindStateBaseRefCountTraits::Destruct(const BindStateBase* bind_state) {
   bind_state->destructor_(bind_state);
 }
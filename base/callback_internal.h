@@ -8,6 +8,8 @@
 #ifndef BASE_CALLBACK_INTERNAL_H_
 #define BASE_CALLBACK_INTERNAL_H_
 
+#include <stddef.h>
+
 #include "base/base_export.h"
 #include "base/callback_forward.h"
 #include "base/macros.h"
@@ -34,6 +36,25 @@ struct BindStateBaseRefCountTraits {
 template <typename T>
 using PassingType = std::conditional_t<std::is_scalar<T>::value, T, T&&>;
 
+// Allocates the storage of BindState objects. Blocks of up to |kMaxCachedSize|
+// bytes are recycled through a small per-thread free list, since most
+// BindStates are short-lived (e.g. bound for PostTask() and deleted once the
+// task runs). A block may be freed on a different thread than the one which
+// allocated it; it then joins the cache of the freeing thread.
+class BASE_EXPORT BindStateAllocator {
+ public:
+  static constexpr size_t kMaxCachedSize = 128;
+
+  static void* Allocate(size_t size);
+  static void Free(void* ptr, size_t size);
+
+  // Returns the number of free blocks cached by the current thread.
+  static size_t GetCachedBlockCountForTesting();
+
+ private:
+  DISALLOW_IMPLICIT_CONSTRUCTORS(BindStateAllocator);
+};
+
 // BindStateBase is used to provide an opaque handle that the Callback
 // class can use to represent a function object with bound arguments.  It
 // behaves as an existential type that is used by a corresponding
@@ -0,0 +1,233 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_CONTAINERS_FLAT_HASH_MAP_H_
+#define BASE_CONTAINERS_FLAT_HASH_MAP_H_
+
+#include <functional>
+#include <tuple>
+#include <utility>
+
+#include "base/containers/flat_hash_table.h"
+#include "base/containers/flat_map.h"
+#include "base/logging.h"
+
+namespace base {
+
+// flat_hash_map is a container with a std::unordered_map-like interface that
+// stores its contents inline in an open addressing hash table.
+//
+// Please see //base/containers/README.md for an overview of which container
+// to select.
+//
+// PROS
+//
+//  - Good memory locality: no allocation per element, and a lookup usually
+//    touches one group of control bytes and one element.
+//  - Fast lookups and insertions at all sizes.
+//
+// CONS
+//
+//  - Iterators and references are invalidated when the table is rehashed.
+//  - Keys and mapped values must be move-constructible.
+//  - Iteration order is unspecified.
+//
+// IMPORTANT NOTES
+//
+//  - Use reserve() when the final size is known, to avoid rehashing.
+//  - Like flat_map, the value type is std::pair<Key, Mapped> rather than
+//    std::pair<const Key, Mapped>, so that elements can be moved when the table
+//    is rehashed. Never modify the key of an element in place.
+//  - Lookups are transparent when |Hash| accepts the looked up type. The
+//    default std::hash<Key> implicitly converts it to |Key| first.
+//
+// QUICK REFERENCE
+//
+// Most of the core functionality is inherited from flat_hash_table. Please
+// see flat_hash_table.h for more details for most of these functions. As a
+// quick reference, the functions available are:
+//
+// Constructors:
+//   flat_hash_map(size_t bucket_count, const Hash& = Hash(),
+//                 const KeyEqual& = KeyEqual());
+//   flat_hash_map(InputIterator first, InputIterator last,
+//                 const Hash& = Hash(), const KeyEqual& = KeyEqual());
+//   flat_hash_map(const flat_hash_map&);
+//   flat_hash_map(flat_hash_map&&);
+//   flat_hash_map(std::initializer_list<value_type> ilist,
+//                 const Hash& = Hash(), const KeyEqual& = KeyEqual());
+//
+// Assignment functions:
+//   flat_hash_map& operator=(const flat_hash_map&);
+//   flat_hash_map& operator=(flat_hash_map&&);
+//   flat_hash_map& operator=(initializer_list<value_type>);
+//
+// Memory management functions:
+//   void   reserve(size_t);
+//   size_t bucket_count() const;
+//
+// Size management functions:
+//   void   clear();
+//   size_t size() const;
+//   size_t max_size() const;
+//   bool   empty() const;
+//
+// Iterator functions:
+//   iterator       begin();
+//   const_iterator begin() const;
+//   const_iterator cbegin() const;
+//   iterator       end();
+//   const_iterator end() const;
+//   const_iterator cend() const;
+//
+// Insert and accessor functions:
+//   mapped_type&         operator[](const key_type&);
+//   mapped_type&         operator[](key_type&&);
+//   mapped_type&         at(const K&);
+//   const mapped_type&   at(const K&) const;
+//   pair<iterator, bool> insert(const value_type&);
+//   pair<iterator, bool> insert(value_type&&);
+//   void                 insert(InputIterator first, InputIterator last);
+//   pair<iterator, bool> insert_or_assign(K&&, M&&);
+//   pair<iterator, bool> emplace(Args&&...);
+//   pair<iterator, bool> try_emplace(K&&, Args&&...);
+//
+// Erase functions:
+//   iterator erase(iterator);
+//   iterator erase(const_iterator);
+//   template <typename K> size_t erase(const K& key);
+//
+// Search functions:
+//   template <typename K> size_t         count(const K&) const;
+//   template <typename K> iterator       find(const K&);
+//   template <typename K> const_iterator find(const K&) const;
+//   template <typename K> bool           contains(const K&) const;
+//
+// General functions:
+//   void swap(flat_hash_map&);
+//
+// Non-member operators:
+//   bool operator==(const flat_hash_map&, const flat_hash_map&);
+//   bool operator!=(const flat_hash_map&, const flat_hash_map&);
+//
+template <class Key,
+          class Mapped,
+          class Hash = std::hash<Key>,
+          class KeyEqual = std::equal_to<>>
+class flat_hash_map
+    : public ::base::internal::flat_hash_table<
+          Key,
+          std::pair<Key, Mapped>,
+          ::base::internal::GetKeyFromValuePairFirst<Key, Mapped>,
+          Hash,
+          KeyEqual> {
+ private:
+  using table = typename ::base::internal::flat_hash_table<
+      Key,
+      std::pair<Key, Mapped>,
+      ::base::internal::GetKeyFromValuePairFirst<Key, Mapped>,
+      Hash,
+      KeyEqual>;
+
+ public:
+  using key_type = typename table::key_type;
+  using mapped_type = Mapped;
+  using value_type = typename table::value_type;
+  using iterator = typename table::iterator;
+  using const_iterator = typename table::const_iterator;
+
+  // --------------------------------------------------------------------------
+  // Lifetime and assignments.
+
+  flat_hash_map() = default;
+
+  explicit flat_hash_map(size_t bucket_count,
+                         const Hash& hash = Hash(),
+                         const KeyEqual& key_equal = KeyEqual())
+      : table(bucket_count, hash, key_equal) {}
+
+  template <class InputIterator>
+  flat_hash_map(InputIterator first,
+                InputIterator last,
+                const Hash& hash = Hash(),
+                const KeyEqual& key_equal = KeyEqual())
+      : table(first, last, hash, key_equal) {}
+
+  flat_hash_map(std::initializer_list<value_type> ilist,
+                const Hash& hash = Hash(),
+                const KeyEqual& key_equal = KeyEqual())
+      : table(ilist, hash, key_equal) {}
+
+  flat_hash_map(const flat_hash_map&) = default;
+  flat_hash_map(flat_hash_map&&) noexcept = default;
+
+  ~flat_hash_map() = default;
+
+  flat_hash_map& operator=(const flat_hash_map&) = default;
+  flat_hash_map& operator=(flat_hash_map&&) = default;
+  flat_hash_map& operator=(std::initializer_list<value_type> ilist) {
+    table::operator=(ilist);
+    return *this;
+  }
+
+  // --------------------------------------------------------------------------
+  // Map-specific insert and accessor operations.
+  //
+  // Normal insert() functions are inherited from flat_hash_table.
+
+  mapped_type& operator[](const key_type& key) {
+    return try_emplace(key).first->second;
+  }
+
+  mapped_type& operator[](key_type&& key) {
+    return try_emplace(std::move(key)).first->second;
+  }
+
+  // The element with |key| must exist.
+  template <class K>
+  mapped_type& at(const K& key) {
+    iterator found = table::find(key);
+    CHECK(found != table::end());
+    return found->second;
+  }
+
+  template <class K>
+  const mapped_type& at(const K& key) const {
+    const_iterator found = table::find(key);
+    CHECK(found != table::end());
+    return found->second;
+  }
+
+  template <class K, class M>
+  std::pair<iterator, bool> insert_or_assign(K&& key, M&& obj) {
+    auto result = table::emplace_key_args(key, std::forward<K>(key),
+                                          std::forward<M>(obj));
+    if (!result.second)
+      result.first->second = std::forward<M>(obj);
+    return result;
+  }
+
+  template <class K, class... Args>
+  std::enable_if_t<std::is_constructible<key_type, K&&>::value,
+                   std::pair<iterator, bool>>
+  try_emplace(K&& key, Args&&... args) {
+    return table::emplace_key_args(
+        key, std::piecewise_construct,
+        std::forward_as_tuple(std::forward<K>(key)),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  // --------------------------------------------------------------------------
+  // General operations.
+
+  void swap(flat_hash_map& other) noexcept { table::swap(other); }
+
+  friend void swap(flat_hash_map& lhs, flat_hash_map& rhs) noexcept {
+    lhs.swap(rhs);
+  }
+};
+
+}  // namespace base
+
+#endif  // BASE_CONTAINERS_FLAT_HASH_MAP_H_
@@ -0,0 +1,126 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/containers/flat_hash_map.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "base/containers/flat_map.h"
+#include "base/strings/stringprintf.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+
+namespace {
+
+// Number of operations timed for each container and size.
+constexpr size_t kOperationCount = 1 << 22;
+
+// Returns |count| distinct pseudo-random keys.
+std::vector<uint64_t> GetKeys(size_t count) {
+  std::vector<uint64_t> keys;
+  keys.reserve(count);
+  uint64_t key = 1;
+  for (size_t i = 0; i < count; ++i) {
+    key = key * UINT64_C(6364136223846793005) + 1442695040888963407;
+    keys.push_back(key);
+  }
+  return keys;
+}
+
+template <class Map>
+Map Build(const std::vector<uint64_t>& keys) {
+  Map map;
+  for (uint64_t key : keys)
+    map.emplace(key, key);
+  return map;
+}
+
+// flat_map is built in one shot, as recommended, since inserting in it one
+// element at a time is quadratic.
+template <>
+flat_map<uint64_t, uint64_t> Build<flat_map<uint64_t, uint64_t>>(
+    const std::vector<uint64_t>& keys) {
+  std::vector<std::pair<uint64_t, uint64_t>> items;
+  items.reserve(keys.size());
+  for (uint64_t key : keys)
+    items.emplace_back(key, key);
+  return flat_map<uint64_t, uint64_t>(std::move(items));
+}
+
+template <class Map>
+void RunTest(const char* container, size_t size) {
+  const std::vector<uint64_t> keys = GetKeys(size);
+  const std::vector<uint64_t> missing_keys = GetKeys(size * 2);
+  const std::string story = StringPrintf("%zu_elements", size);
+
+  // Build the map repeatedly, so that about |kOperationCount| elements are
+  // inserted.
+  const size_t build_count = std::max<size_t>(kOperationCount / size / 4, 1);
+  TimeTicks begin = TimeTicks::Now();
+  size_t total_size = 0;
+  for (size_t i = 0; i < build_count; ++i)
+    total_size += Build<Map>(keys).size();
+  TimeDelta elapsed = TimeTicks::Now() - begin;
+  EXPECT_EQ(size * build_count, total_size);
+  perf_test::PrintResult(
+      "FlatHashMap_Insert", container, story,
+      elapsed.InNanoseconds() / static_cast<double>(size * build_count),
+      "ns/element", true);
+
+  const Map map = Build<Map>(keys);
+  uint64_t sum = 0;
+  begin = TimeTicks::Now();
+  for (size_t i = 0; i < kOperationCount; ++i)
+    sum += map.find(keys[i % size])->second;
+  elapsed = TimeTicks::Now() - begin;
+  EXPECT_NE(0u, sum);
+  perf_test::PrintResult(
+      "FlatHashMap_FindHit", container, story,
+      elapsed.InNanoseconds() / static_cast<double>(kOperationCount),
+      "ns/lookup", true);
+
+  // The second half of |missing_keys| isn't in the map.
+  size_t found = 0;
+  begin = TimeTicks::Now();
+  for (size_t i = 0; i < kOperationCount; ++i)
+    found += map.count(missing_keys[size + i % size]);
+  elapsed = TimeTicks::Now() - begin;
+  EXPECT_EQ(0u, found);
+  perf_test::PrintResult(
+      "FlatHashMap_FindMiss", container, story,
+      elapsed.InNanoseconds() / static_cast<double>(kOperationCount),
+      "ns/lookup", true);
+}
+
+template <class Map>
+void RunTests(const char* container) {
+  for (size_t size : {4, 64, 1024, 16384, 262144})
+    RunTest<Map>(container, size);
+}
+
+}  // namespace
+
+TEST(FlatHashMapPerfTest, FlatHashMap) {
+  RunTests<flat_hash_map<uint64_t, uint64_t>>("flat_hash_map");
+}
+
+TEST(FlatHashMapPerfTest, FlatMap) {
+  RunTests<flat_map<uint64_t, uint64_t>>("flat_map");
+}
+
+TEST(FlatHashMapPerfTest, UnorderedMap) {
+  RunTests<std::unordered_map<uint64_t, uint64_t>>("unordered_map");
+}
+
+}  // namespace base
@@ -0,0 +1,256 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/containers/flat_hash_map.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/test/move_only_int.h"
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// flat_hash_map and flat_hash_set share their implementation, flat_hash_table,
+// so the bulk of the table tests are here and flat_hash_set_unittest.cc only
+// covers the set-specific parts.
+
+using ::testing::Pair;
+using ::testing::UnorderedElementsAre;
+
+namespace base {
+
+namespace {
+
+struct MoveOnlyIntHash {
+  size_t operator()(const MoveOnlyInt& value) const { return value.data(); }
+  size_t operator()(int value) const { return value; }
+};
+
+struct MoveOnlyIntEqual {
+  bool operator()(const MoveOnlyInt& lhs, const MoveOnlyInt& rhs) const {
+    return lhs == rhs;
+  }
+  bool operator()(const MoveOnlyInt& lhs, int rhs) const {
+    return lhs.data() == rhs;
+  }
+};
+
+// A hash that sends all the keys to the same group, to exercise probing.
+struct ConstantHash {
+  size_t operator()(int value) const { return 0; }
+};
+
+}  // namespace
+
+TEST(FlatHashMap, InsertFindErase) {
+  flat_hash_map<int, int> map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.end(), map.find(1));
+  EXPECT_EQ(map.begin(), map.end());
+
+  EXPECT_TRUE(map.insert({1, 10}).second);
+  EXPECT_TRUE(map.insert({2, 20}).second);
+  std::pair<flat_hash_map<int, int>::iterator, bool> result =
+      map.insert({1, 11});
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ(10, result.first->second);
+  EXPECT_EQ(2u, map.size());
+  EXPECT_THAT(map, UnorderedElementsAre(Pair(1, 10), Pair(2, 20)));
+
+  EXPECT_TRUE(map.contains(2));
+  EXPECT_EQ(1u, map.count(1));
+  EXPECT_EQ(0u, map.count(3));
+
+  EXPECT_EQ(1u, map.erase(1));
+  EXPECT_EQ(0u, map.erase(1));
+  EXPECT_FALSE(map.contains(1));
+  EXPECT_THAT(map, UnorderedElementsAre(Pair(2, 20)));
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.begin(), map.end());
+}
+
+TEST(FlatHashMap, ManyElements) {
+  constexpr int kCount = 10000;
+  flat_hash_map<int, int> map;
+  for (int i = 0; i < kCount; ++i)
+    EXPECT_TRUE(map.try_emplace(i, -i).second);
+  EXPECT_EQ(static_cast<size_t>(kCount), map.size());
+  EXPECT_GE(map.bucket_count(), map.size());
+
+  for (int i = 0; i < kCount; ++i) {
+    flat_hash_map<int, int>::iterator found = map.find(i);
+    ASSERT_NE(map.end(), found);
+    EXPECT_EQ(-i, found->second);
+  }
+  EXPECT_FALSE(map.contains(kCount));
+
+  size_t iterated = 0;
+  for (const auto& entry : map) {
+    EXPECT_EQ(-entry.first, entry.second);
+    ++iterated;
+  }
+  EXPECT_EQ(map.size(), iterated);
+
+  for (int i = 0; i < kCount; i += 2)
+    EXPECT_EQ(1u, map.erase(i));
+  for (int i = 0; i < kCount; ++i)
+    EXPECT_EQ(i % 2 == 1, map.contains(i));
+}
+
+// Erasing and inserting keys that all probe the same groups leaves tombstones,
+// which must not break lookups nor make the table grow without bound.
+TEST(FlatHashMap, Tombstones) {
+  flat_hash_map<int, int, ConstantHash> map;
+  for (int i = 0; i < 100; ++i)
+    map[i] = i;
+  const size_t bucket_count = map.bucket_count();
+
+  for (int round = 0; round < 100; ++round) {
+    for (int i = 0; i < 50; ++i)
+      EXPECT_EQ(1u, map.erase(i + round * 100));
+    for (int i = 0; i < 50; ++i)
+      map[i + (round + 1) * 100] = i;
+    for (int i = 50; i < 100; ++i) {
+      EXPECT_TRUE(map.contains(i + round * 100));
+      map[i + (round + 1) * 100] = map[i + round * 100];
+      map.erase(i + round * 100);
+    }
+    EXPECT_EQ(100u, map.size());
+  }
+  EXPECT_EQ(bucket_count, map.bucket_count());
+  for (int i = 0; i < 100; ++i)
+    EXPECT_EQ(i, map[i + 100 * 100]);
+}
+
+TEST(FlatHashMap, EraseDuringIteration) {
+  flat_hash_map<int, int> map;
+  for (int i = 0; i < 100; ++i)
+    map[i] = i;
+
+  for (auto it = map.begin(); it != map.end();) {
+    if (it->first % 3 == 0)
+      it = map.erase(it);
+    else
+      ++it;
+  }
+  EXPECT_EQ(66u, map.size());
+  for (int i = 0; i < 100; ++i)
+    EXPECT_EQ(i % 3 != 0, map.contains(i));
+}
+
+TEST(FlatHashMap, Reserve) {
+  flat_hash_map<int, int> map;
+  map.reserve(1000);
+  const size_t bucket_count = map.bucket_count();
+  EXPECT_GE(bucket_count, 1000u);
+  for (int i = 0; i < 1000; ++i)
+    map[i] = i;
+  EXPECT_EQ(bucket_count, map.bucket_count());
+}
+
+TEST(FlatHashMap, MoveOnly) {
+  flat_hash_map<MoveOnlyInt, MoveOnlyInt, MoveOnlyIntHash, MoveOnlyIntEqual>
+      map;
+  for (int i = 0; i < 100; ++i)
+    map.try_emplace(MoveOnlyInt(i), MoveOnlyInt(i * 2));
+  EXPECT_EQ(100u, map.size());
+
+  // Transparent lookup.
+  auto found = map.find(42);
+  ASSERT_NE(map.end(), found);
+  EXPECT_EQ(84, found->second.data());
+
+  decltype(map) moved(std::move(map));
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(100u, moved.size());
+  EXPECT_TRUE(moved.contains(99));
+
+  map = std::move(moved);
+  EXPECT_EQ(100u, map.size());
+  EXPECT_TRUE(moved.empty());
+}
+
+TEST(FlatHashMap, CopyAndCompare) {
+  flat_hash_map<std::string, int> map = {{"a", 1}, {"b", 2}, {"c", 3}};
+  flat_hash_map<std::string, int> copy(map);
+  EXPECT_EQ(map, copy);
+
+  copy["b"] = 4;
+  EXPECT_NE(map, copy);
+  EXPECT_EQ(2, map.at("b"));
+
+  copy = map;
+  EXPECT_EQ(map, copy);
+
+  copy = {{"d", 4}};
+  EXPECT_THAT(copy, UnorderedElementsAre(Pair("d", 4)));
+}
+
+TEST(FlatHashMap, InsertOrAssign) {
+  flat_hash_map<int, std::string> map;
+  EXPECT_TRUE(map.insert_or_assign(1, "a").second);
+  EXPECT_FALSE(map.insert_or_assign(1, "b").second);
+  EXPECT_EQ("b", map[1]);
+}
+
+TEST(FlatHashMap, UniquePtrValues) {
+  flat_hash_map<int, std::unique_ptr<int>> map;
+  for (int i = 0; i < 100; ++i)
+    map.emplace(i, std::make_unique<int>(i));
+  for (int i = 0; i < 100; ++i)
+    EXPECT_EQ(i, *map.at(i));
+}
+
+TEST(FlatHashMap, Swap) {
+  flat_hash_map<int, int> a = {{1, 1}};
+  flat_hash_map<int, int> b = {{2, 2}, {3, 3}};
+  swap(a, b);
+  EXPECT_THAT(a, UnorderedElementsAre(Pair(2, 2), Pair(3, 3)));
+  EXPECT_THAT(b, UnorderedElementsAre(Pair(1, 1)));
+}
+
+TEST(FlatHashMap, EraseIf) {
+  flat_hash_map<int, int> map;
+  for (int i = 0; i < 100; ++i)
+    map[i] = i * 2;
+  EraseIf(map, [](const std::pair<int, int>& entry) {
+    return entry.first % 4 != 0;
+  });
+  EXPECT_EQ(25u, map.size());
+  for (int i = 0; i < 100; ++i)
+    EXPECT_EQ(i % 4 == 0, map.contains(i));
+}
+
+// Compares with std::map through a pseudo-random sequence of operations.
+TEST(FlatHashMap, MatchesStdMap) {
+  flat_hash_map<int, int> map;
+  std::map<int, int> reference;
+  uint32_t seed = 1;
+  for (int i = 0; i < 100000; ++i) {
+    seed = seed * 1103515245 + 12345;
+    const int key = (seed >> 8) % 2000;
+    switch ((seed >> 24) % 3) {
+      case 0:
+        map[key] = i;
+        reference[key] = i;
+        break;
+      case 1:
+        EXPECT_EQ(reference.erase(key), map.erase(key));
+        break;
+      case 2:
+        EXPECT_EQ(reference.count(key), map.count(key));
+        break;
+    }
+  }
+  EXPECT_EQ(reference.size(), map.size());
+  for (const auto& entry : reference)
+    EXPECT_EQ(entry.second, map.at(entry.first));
+}
+
+}  // namespace base
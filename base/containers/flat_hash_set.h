@@ -0,0 +1,114 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_CONTAINERS_FLAT_HASH_SET_H_
+#define BASE_CONTAINERS_FLAT_HASH_SET_H_
+
+#include <functional>
+
+#include "base/containers/flat_hash_table.h"
+#include "base/containers/flat_tree.h"
+
+namespace base {
+
+// flat_hash_set is a container with a std::unordered_set-like interface that
+// stores its contents inline in an open addressing hash table.
+//
+// Please see //base/containers/README.md for an overview of which container
+// to select.
+//
+// PROS
+//
+//  - Good memory locality: no allocation per element, and a lookup usually
+//    touches one group of control bytes and one element.
+//  - Fast lookups and insertions at all sizes.
+//
+// CONS
+//
+//  - Iterators and references are invalidated when the table is rehashed.
+//  - Elements must be move-constructible.
+//  - Iteration order is unspecified.
+//
+// IMPORTANT NOTES
+//
+//  - Use reserve() when the final size is known, to avoid rehashing.
+//  - Lookups are transparent when |Hash| accepts the looked up type. The
+//    default std::hash<Key> implicitly converts it to |Key| first.
+//
+// QUICK REFERENCE
+//
+// Most of the core functionality is implemented in flat_hash_table. Please
+// see flat_hash_table.h for more details. As a quick reference, the functions
+// available are:
+//
+// Constructors:
+//   flat_hash_set(size_t bucket_count, const Hash& = Hash(),
+//                 const KeyEqual& = KeyEqual());
+//   flat_hash_set(InputIterator first, InputIterator last,
+//                 const Hash& = Hash(), const KeyEqual& = KeyEqual());
+//   flat_hash_set(const flat_hash_set&);
+//   flat_hash_set(flat_hash_set&&);
+//   flat_hash_set(std::initializer_list<value_type> ilist,
+//                 const Hash& = Hash(), const KeyEqual& = KeyEqual());
+//
+// Assignment functions:
+//   flat_hash_set& operator=(const flat_hash_set&);
+//   flat_hash_set& operator=(flat_hash_set&&);
+//   flat_hash_set& operator=(initializer_list<Key>);
+//
+// Memory management functions:
+//   void   reserve(size_t);
+//   size_t bucket_count() const;
+//
+// Size management functions:
+//   void   clear();
+//   size_t size() const;
+//   size_t max_size() const;
+//   bool   empty() const;
+//
+// Iterator functions:
+//   iterator       begin();
+//   const_iterator begin() const;
+//   const_iterator cbegin() const;
+//   iterator       end();
+//   const_iterator end() const;
+//   const_iterator cend() const;
+//
+// Insert and accessor functions:
+//   pair<iterator, bool> insert(const key_type&);
+//   pair<iterator, bool> insert(key_type&&);
+//   void                 insert(InputIterator first, InputIterator last);
+//   pair<iterator, bool> emplace(Args&&...);
+//
+// Erase functions:
+//   iterator erase(iterator);
+//   iterator erase(const_iterator);
+//   template <typename K> size_t erase(const K& key);
+//
+// Search functions:
+//   template <typename K> size_t         count(const K&) const;
+//   template <typename K> iterator       find(const K&);
+//   template <typename K> const_iterator find(const K&) const;
+//   template <typename K> bool           contains(const K&) const;
+//
+// General functions:
+//   void swap(flat_hash_set&);
+//
+// Non-member operators:
+//   bool operator==(const flat_hash_set&, const flat_hash_set&);
+//   bool operator!=(const flat_hash_set&, const flat_hash_set&);
+//
+template <class Key,
+          class Hash = std::hash<Key>,
+          class KeyEqual = std::equal_to<>>
+using flat_hash_set = typename ::base::internal::flat_hash_table<
+    Key,
+    Key,
+    ::base::internal::GetKeyFromValueIdentity<Key>,
+    Hash,
+    KeyEqual>;
+
+}  // namespace base
+
+#endif  // BASE_CONTAINERS_FLAT_HASH_SET_H_
@@ -0,0 +1,47 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/containers/flat_hash_set.h"
+
+#include <string>
+#include <vector>
+
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// A flat_hash_set is basically an interface to flat_hash_table, which is tested
+// through flat_hash_map in flat_hash_map_unittest.cc.
+
+using ::testing::UnorderedElementsAre;
+
+namespace base {
+
+TEST(FlatHashSet, RangeConstructor) {
+  std::vector<int> input = {3, 1, 2, 3, 1};
+  flat_hash_set<int> set(input.begin(), input.end());
+  EXPECT_THAT(set, UnorderedElementsAre(1, 2, 3));
+}
+
+TEST(FlatHashSet, InsertAndErase) {
+  flat_hash_set<std::string> set;
+  EXPECT_TRUE(set.insert("a").second);
+  EXPECT_TRUE(set.emplace("b").second);
+  EXPECT_FALSE(set.insert("a").second);
+  EXPECT_TRUE(set.contains("b"));
+  EXPECT_EQ(1u, set.erase("a"));
+  EXPECT_THAT(set, UnorderedElementsAre("b"));
+}
+
+TEST(FlatHashSet, Pointers) {
+  std::vector<int> values(1000);
+  flat_hash_set<const int*> set;
+  for (const int& value : values)
+    set.insert(&value);
+  EXPECT_EQ(values.size(), set.size());
+  for (const int& value : values)
+    EXPECT_TRUE(set.contains(&value));
+  EXPECT_FALSE(set.contains(nullptr));
+}
+
+}  // namespace base
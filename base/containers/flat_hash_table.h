@@ -0,0 +1,678 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_CONTAINERS_FLAT_HASH_TABLE_H_
+#define BASE_CONTAINERS_FLAT_HASH_TABLE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "base/bits.h"
+#include "base/logging.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace base {
+namespace internal {
+
+// Implementation -------------------------------------------------------------
+//
+// flat_hash_table is an open addressing hash table which stores its elements
+// inline in a single array of slots. Next to it, an array of control bytes
+// holds one byte per slot:
+//   - kEmpty if the slot has never held an element since the last rehash,
+//   - kDeleted if the element it held was erased (a "tombstone"),
+//   - the 7 low bits of the hash of the element's key otherwise.
+//
+// The slots are split in groups of kGroupWidth consecutive slots. A key is
+// looked up by probing groups, starting at the one selected by the high bits
+// of its hash and moving on quadratically. The control bytes of a whole group
+// are compared against the 7 low bits of the hash at once (with SSE2
+// instructions where available), so that the key only needs to be compared
+// against the few elements whose control byte matches. The probe stops at the
+// first group that has an empty slot.
+//
+// The table is kept at most 7/8 full (counting tombstones), which keeps probe
+// sequences short. When it is full, it is rehashed in a table twice as large,
+// or of the same size if more than half of its used slots are tombstones.
+//
+// The hashes are mixed before use, so the weak hash functions of
+// std::hash<int> and std::hash<T*> are fine.
+
+using ctrl_t = int8_t;
+
+constexpr ctrl_t kEmpty = -128;
+constexpr ctrl_t kDeleted = -2;
+// Marks the end of the control bytes, so that iterators stop there.
+constexpr ctrl_t kSentinel = -1;
+
+constexpr size_t kGroupWidth = 16;
+
+inline bool IsFull(ctrl_t ctrl) {
+  return ctrl >= 0;
+}
+
+inline bool IsEmptyOrDeleted(ctrl_t ctrl) {
+  return ctrl < kSentinel;
+}
+
+// Finalizer of MurmurHash3, which mixes all the bits of |hash|.
+inline size_t MixHash(size_t hash) {
+  uint64_t h = hash;
+  h ^= h >> 33;
+  h *= UINT64_C(0xff51afd7ed558ccd);
+  h ^= h >> 33;
+  h *= UINT64_C(0xc4ceb9fe1a85ec53);
+  h ^= h >> 33;
+  return static_cast<size_t>(h);
+}
+
+// The 7 bits of the hash stored in the control bytes.
+inline ctrl_t H2(size_t hash) {
+  return static_cast<ctrl_t>(hash & 0x7f);
+}
+
+// The bits of the hash used to select the first group to probe.
+inline size_t H1(size_t hash) {
+  return hash >> 7;
+}
+
+// The control bytes of a group. Matches return a mask with bit i set if the
+// control byte of the i-th slot of the group matches.
+class Group {
+ public:
+  explicit Group(const ctrl_t* ctrl) {
+#if defined(__SSE2__)
+    ctrl_ = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+#else
+    memcpy(ctrl_, ctrl, kGroupWidth);
+#endif
+  }
+
+  uint32_t Match(ctrl_t h2) const {
+#if defined(__SSE2__)
+    return static_cast<uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_)));
+#else
+    uint32_t mask = 0;
+    for (size_t i = 0; i < kGroupWidth; ++i)
+      mask |= static_cast<uint32_t>(ctrl_[i] == h2) << i;
+    return mask;
+#endif
+  }
+
+  uint32_t MatchEmpty() const { return Match(kEmpty); }
+
+  uint32_t MatchEmptyOrDeleted() const {
+#if defined(__SSE2__)
+    return static_cast<uint32_t>(_mm_movemask_epi8(
+        _mm_cmpgt_epi8(_mm_set1_epi8(kSentinel), ctrl_)));
+#else
+    uint32_t mask = 0;
+    for (size_t i = 0; i < kGroupWidth; ++i)
+      mask |= static_cast<uint32_t>(IsEmptyOrDeleted(ctrl_[i])) << i;
+    return mask;
+#endif
+  }
+
+ private:
+#if defined(__SSE2__)
+  __m128i ctrl_;
+#else
+  ctrl_t ctrl_[kGroupWidth];
+#endif
+};
+
+// Iterates over the full slots of the table. |ValueType| is const for
+// const_iterator.
+template <class ValueType>
+class flat_hash_table_iterator {
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = std::remove_const_t<ValueType>;
+  using difference_type = ptrdiff_t;
+  using pointer = ValueType*;
+  using reference = ValueType&;
+
+  flat_hash_table_iterator() = default;
+  flat_hash_table_iterator(const ctrl_t* ctrl, ValueType* slot)
+      : ctrl_(ctrl), slot_(slot) {}
+
+  // Allows conversion from iterator to const_iterator.
+  template <class OtherValueType,
+            class = std::enable_if_t<
+                std::is_same<const OtherValueType, ValueType>::value>>
+  flat_hash_table_iterator(
+      const flat_hash_table_iterator<OtherValueType>& other)
+      : ctrl_(other.ctrl_), slot_(other.slot_) {}
+
+  reference operator*() const { return *slot_; }
+  pointer operator->() const { return slot_; }
+
+  flat_hash_table_iterator& operator++() {
+    ++ctrl_;
+    ++slot_;
+    SkipEmptyOrDeleted();
+    return *this;
+  }
+
+  flat_hash_table_iterator operator++(int) {
+    flat_hash_table_iterator result = *this;
+    ++*this;
+    return result;
+  }
+
+  friend bool operator==(const flat_hash_table_iterator& lhs,
+                         const flat_hash_table_iterator& rhs) {
+    return lhs.slot_ == rhs.slot_;
+  }
+
+  friend bool operator!=(const flat_hash_table_iterator& lhs,
+                         const flat_hash_table_iterator& rhs) {
+    return !(lhs == rhs);
+  }
+
+ private:
+  template <class, class, class, class, class>
+  friend class flat_hash_table;
+  template <class>
+  friend class flat_hash_table_iterator;
+
+  void SkipEmptyOrDeleted() {
+    while (IsEmptyOrDeleted(*ctrl_)) {
+      ++ctrl_;
+      ++slot_;
+    }
+  }
+
+  const ctrl_t* ctrl_ = nullptr;
+  ValueType* slot_ = nullptr;
+};
+
+// flat_hash_table is the common implementation of flat_hash_map and
+// flat_hash_set. See flat_hash_map.h for the public documentation.
+//
+// |GetKeyFromValue| is a functor that extracts the key from a value.
+template <class Key,
+          class Value,
+          class GetKeyFromValue,
+          class Hash,
+          class KeyEqual>
+class flat_hash_table {
+ public:
+  using key_type = Key;
+  using value_type = Value;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using pointer = value_type*;
+  using const_pointer = const value_type*;
+  using iterator = flat_hash_table_iterator<value_type>;
+  using const_iterator = flat_hash_table_iterator<const value_type>;
+
+  // --------------------------------------------------------------------------
+  // Lifetime.
+
+  flat_hash_table() = default;
+
+  explicit flat_hash_table(size_type bucket_count,
+                           const Hash& hash = Hash(),
+                           const KeyEqual& key_equal = KeyEqual())
+      : hash_(hash), key_equal_(key_equal) {
+    reserve(bucket_count);
+  }
+
+  template <class InputIterator>
+  flat_hash_table(InputIterator first,
+                  InputIterator last,
+                  const Hash& hash = Hash(),
+                  const KeyEqual& key_equal = KeyEqual())
+      : hash_(hash), key_equal_(key_equal) {
+    insert(first, last);
+  }
+
+  flat_hash_table(std::initializer_list<value_type> ilist,
+                  const Hash& hash = Hash(),
+                  const KeyEqual& key_equal = KeyEqual())
+      : flat_hash_table(std::begin(ilist), std::end(ilist), hash, key_equal) {}
+
+  flat_hash_table(const flat_hash_table& other)
+      : hash_(other.hash_), key_equal_(other.key_equal_) {
+    reserve(other.size());
+    for (const value_type& value : other)
+      InsertUnique(value);
+  }
+
+  flat_hash_table(flat_hash_table&& other) noexcept
+      : hash_(std::move(other.hash_)), key_equal_(std::move(other.key_equal_)) {
+    SwapStorage(other);
+  }
+
+  ~flat_hash_table() { DestroyAndDeallocate(); }
+
+  // --------------------------------------------------------------------------
+  // Assignments.
+
+  flat_hash_table& operator=(const flat_hash_table& other) {
+    if (this != &other) {
+      flat_hash_table copy(other);
+      swap(copy);
+    }
+    return *this;
+  }
+
+  flat_hash_table& operator=(flat_hash_table&& other) noexcept {
+    if (this != &other) {
+      DestroyAndDeallocate();
+      hash_ = std::move(other.hash_);
+      key_equal_ = std::move(other.key_equal_);
+      SwapStorage(other);
+    }
+    return *this;
+  }
+
+  flat_hash_table& operator=(std::initializer_list<value_type> ilist) {
+    clear();
+    insert(std::begin(ilist), std::end(ilist));
+    return *this;
+  }
+
+  // --------------------------------------------------------------------------
+  // Memory management.
+
+  // Makes room for |new_size| elements without rehashing.
+  void reserve(size_type new_size) {
+    if (new_size <= size_ + growth_left_)
+      return;
+    size_type new_capacity = std::max(capacity_, kGroupWidth);
+    while (MaxLoad(new_capacity) < new_size)
+      new_capacity *= 2;
+    Rehash(new_capacity);
+  }
+
+  // Number of slots. Up to 7/8 of them can be used before rehashing.
+  size_type bucket_count() const { return capacity_; }
+
+  // --------------------------------------------------------------------------
+  // Size management.
+
+  // Destroys all the elements but keeps the slots.
+  void clear() {
+    if (!capacity_)
+      return;
+    for (size_type i = 0; i < capacity_; ++i) {
+      if (IsFull(ctrl_[i]))
+        slots_[i].~value_type();
+    }
+    memset(ctrl_, kEmpty, capacity_);
+    size_ = 0;
+    growth_left_ = MaxLoad(capacity_);
+  }
+
+  size_type size() const { return size_; }
+  size_type max_size() const {
+    return std::numeric_limits<difference_type>::max() / sizeof(value_type);
+  }
+  bool empty() const { return !size_; }
+
+  // --------------------------------------------------------------------------
+  // Iterators.
+  //
+  // Iteration order is unspecified, and changes when the table is rehashed.
+
+  iterator begin() {
+    if (!size_)
+      return end();
+    iterator it(ctrl_, slots_);
+    it.SkipEmptyOrDeleted();
+    return it;
+  }
+  const_iterator begin() const {
+    return const_cast<flat_hash_table*>(this)->begin();
+  }
+  const_iterator cbegin() const { return begin(); }
+
+  iterator end() { return iterator(ctrl_ + capacity_, slots_ + capacity_); }
+  const_iterator end() const {
+    return const_iterator(ctrl_ + capacity_, slots_ + capacity_);
+  }
+  const_iterator cend() const { return end(); }
+
+  // --------------------------------------------------------------------------
+  // Insert operations.
+  //
+  // Insertions invalidate all iterators and references when they rehash the
+  // table, which happens when size() reaches 7/8 of bucket_count().
+
+  std::pair<iterator, bool> insert(const value_type& value) {
+    return emplace_key_args(GetKeyFromValue()(value), value);
+  }
+
+  std::pair<iterator, bool> insert(value_type&& value) {
+    return emplace_key_args(GetKeyFromValue()(value), std::move(value));
+  }
+
+  template <class InputIterator>
+  void insert(InputIterator first, InputIterator last) {
+    for (; first != last; ++first)
+      insert(*first);
+  }
+
+  template <class... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    value_type value(std::forward<Args>(args)...);
+    return insert(std::move(value));
+  }
+
+  // --------------------------------------------------------------------------
+  // Erase operations.
+  //
+  // Erasing doesn't invalidate iterators and references to other elements.
+
+  iterator erase(iterator position) {
+    return erase(const_iterator(position));
+  }
+
+  iterator erase(const_iterator position) {
+    const size_type index = position.slot_ - slots_;
+    DCHECK_LT(index, capacity_);
+    DCHECK(IsFull(ctrl_[index]));
+    slots_[index].~value_type();
+    --size_;
+
+    // Probe sequences stop at the first group that has an empty slot, and a
+    // group that has one has had one since the table was last rehashed. So if
+    // the group of the slot has one, no probe sequence goes past it and the
+    // slot can be marked empty. Otherwise it must be marked deleted so that
+    // lookups of the keys further along the probe sequence keep going.
+    const size_type group_start = index & ~(kGroupWidth - 1);
+    if (Group(ctrl_ + group_start).MatchEmpty()) {
+      ctrl_[index] = kEmpty;
+      ++growth_left_;
+    } else {
+      ctrl_[index] = kDeleted;
+    }
+
+    iterator next(ctrl_ + index, slots_ + index);
+    next.SkipEmptyOrDeleted();
+    return next;
+  }
+
+  template <class K>
+  size_type erase(const K& key) {
+    iterator found = find(key);
+    if (found == end())
+      return 0;
+    erase(found);
+    return 1;
+  }
+
+  // --------------------------------------------------------------------------
+  // Search operations.
+
+  template <class K>
+  size_type count(const K& key) const {
+    return contains(key) ? 1 : 0;
+  }
+
+  template <class K>
+  iterator find(const K& key) {
+    if (!size_)
+      return end();
+    const size_type index = FindIndex(key, HashKey(key));
+    return iterator(ctrl_ + index, slots_ + index);
+  }
+
+  template <class K>
+  const_iterator find(const K& key) const {
+    return const_cast<flat_hash_table*>(this)->find(key);
+  }
+
+  template <class K>
+  bool contains(const K& key) const {
+    return find(key) != end();
+  }
+
+  // --------------------------------------------------------------------------
+  // Observers.
+
+  hasher hash_function() const { return hash_; }
+  key_equal key_eq() const { return key_equal_; }
+
+  // --------------------------------------------------------------------------
+  // General operations.
+
+  void swap(flat_hash_table& other) noexcept {
+    std::swap(hash_, other.hash_);
+    std::swap(key_equal_, other.key_equal_);
+    SwapStorage(other);
+  }
+
+  friend bool operator==(const flat_hash_table& lhs,
+                         const flat_hash_table& rhs) {
+    if (lhs.size() != rhs.size())
+      return false;
+    for (const value_type& value : lhs) {
+      const_iterator found = rhs.find(GetKeyFromValue()(value));
+      if (found == rhs.end() || !(*found == value))
+        return false;
+    }
+    return true;
+  }
+
+  friend bool operator!=(const flat_hash_table& lhs,
+                         const flat_hash_table& rhs) {
+    return !(lhs == rhs);
+  }
+
+ protected:
+  // Inserts an element constructed from |args| if there is none with |key|.
+  // |key| must compare equal to the key of the constructed element.
+  template <class K, class... Args>
+  std::pair<iterator, bool> emplace_key_args(const K& key, Args&&... args) {
+    const size_t hash = HashKey(key);
+    if (size_) {
+      const size_type index = FindIndex(key, hash);
+      if (index != capacity_)
+        return {iterator(ctrl_ + index, slots_ + index), false};
+    }
+
+    size_type index = FindFirstNonFull(hash);
+    // Reusing a tombstone doesn't use up room in the table.
+    if (!capacity_ || (!growth_left_ && ctrl_[index] != kDeleted)) {
+      Grow();
+      index = FindFirstNonFull(hash);
+    }
+    if (ctrl_[index] == kEmpty)
+      --growth_left_;
+    ctrl_[index] = H2(hash);
+    new (slots_ + index) value_type(std::forward<Args>(args)...);
+    ++size_;
+    return {iterator(ctrl_ + index, slots_ + index), true};
+  }
+
+ private:
+  // Returns the number of elements a table with |capacity| slots can hold
+  // before it is rehashed.
+  static size_type MaxLoad(size_type capacity) {
+    return capacity - capacity / 8;
+  }
+
+  template <class K>
+  size_t HashKey(const K& key) const {
+    return MixHash(hash_(key));
+  }
+
+  // Returns the index of the element with |key|, or |capacity_| if there is
+  // none. Must not be called on a table without slots.
+  template <class K>
+  size_type FindIndex(const K& key, size_t hash) const {
+    const size_type mask = capacity_ / kGroupWidth - 1;
+    size_type group = H1(hash) & mask;
+    // Triangular probing visits every group since their number is a power of
+    // two.
+    for (size_type probe = 1;; ++probe) {
+      const Group g(ctrl_ + group * kGroupWidth);
+      for (uint32_t match = g.Match(H2(hash)); match; match &= match - 1) {
+        const size_type index =
+            group * kGroupWidth + bits::CountTrailingZeroBits(match);
+        if (key_equal_(GetKeyFromValue()(slots_[index]), key))
+          return index;
+      }
+      if (g.MatchEmpty())
+        return capacity_;
+      DCHECK_LE(probe, mask);
+      group = (group + probe) & mask;
+    }
+  }
+
+  // Returns the index of the first empty or deleted slot in the probe
+  // sequence of |hash|, or 0 if the table has no slots.
+  size_type FindFirstNonFull(size_t hash) const {
+    if (!capacity_)
+      return 0;
+    const size_type mask = capacity_ / kGroupWidth - 1;
+    size_type group = H1(hash) & mask;
+    for (size_type probe = 1;; ++probe) {
+      const uint32_t match =
+          Group(ctrl_ + group * kGroupWidth).MatchEmptyOrDeleted();
+      if (match)
+        return group * kGroupWidth + bits::CountTrailingZeroBits(match);
+      DCHECK_LE(probe, mask);
+      group = (group + probe) & mask;
+    }
+  }
+
+  // Inserts |value|, whose key isn't in the table yet, in a table that has
+  // room for it.
+  void InsertUnique(const value_type& value) {
+    DCHECK(growth_left_);
+    const size_t hash = HashKey(GetKeyFromValue()(value));
+    const size_type index = FindFirstNonFull(hash);
+    ctrl_[index] = H2(hash);
+    new (slots_ + index) value_type(value);
+    ++size_;
+    --growth_left_;
+  }
+
+  // Rehashes the table so that it has room for at least one more element.
+  void Grow() {
+    if (!capacity_)
+      Rehash(kGroupWidth);
+    else if (size_ <= MaxLoad(capacity_) / 2)
+      Rehash(capacity_);  // Mostly tombstones, only clean them up.
+    else
+      Rehash(capacity_ * 2);
+  }
+
+  // Moves all the elements to |new_capacity| new slots. |new_capacity| must be
+  // a power of two and at least kGroupWidth.
+  void Rehash(size_type new_capacity) {
+    DCHECK(bits::IsPowerOfTwo(new_capacity));
+    DCHECK_GE(new_capacity, kGroupWidth);
+    DCHECK_GE(MaxLoad(new_capacity), size_);
+
+    ctrl_t* old_ctrl = ctrl_;
+    value_type* old_slots = slots_;
+    const size_type old_capacity = capacity_;
+
+    ctrl_ = new ctrl_t[new_capacity + 1];
+    memset(ctrl_, kEmpty, new_capacity);
+    ctrl_[new_capacity] = kSentinel;
+    slots_ = std::allocator<value_type>().allocate(new_capacity);
+    capacity_ = new_capacity;
+    growth_left_ = MaxLoad(new_capacity) - size_;
+
+    for (size_type i = 0; i < old_capacity; ++i) {
+      if (!IsFull(old_ctrl[i]))
+        continue;
+      const size_t hash = HashKey(GetKeyFromValue()(old_slots[i]));
+      const size_type index = FindFirstNonFull(hash);
+      ctrl_[index] = H2(hash);
+      new (slots_ + index) value_type(std::move(old_slots[i]));
+      old_slots[i].~value_type();
+    }
+
+    if (old_capacity) {
+      std::allocator<value_type>().deallocate(old_slots, old_capacity);
+      delete[] old_ctrl;
+    }
+  }
+
+  void DestroyAndDeallocate() {
+    if (!capacity_)
+      return;
+    clear();
+    std::allocator<value_type>().deallocate(slots_, capacity_);
+    delete[] ctrl_;
+    ctrl_ = nullptr;
+    slots_ = nullptr;
+    capacity_ = 0;
+    growth_left_ = 0;
+  }
+
+  void SwapStorage(flat_hash_table& other) {
+    std::swap(ctrl_, other.ctrl_);
+    std::swap(slots_, other.slots_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(size_, other.size_);
+    std::swap(growth_left_, other.growth_left_);
+  }
+
+  Hash hash_;
+  KeyEqual key_equal_;
+
+  // |capacity_| + 1 control bytes, the last one being kSentinel.
+  ctrl_t* ctrl_ = nullptr;
+  // |capacity_| slots. Only the full ones hold a constructed element.
+  value_type* slots_ = nullptr;
+  size_type capacity_ = 0;
+  size_type size_ = 0;
+  // Number of elements that can be inserted in empty slots before rehashing.
+  size_type growth_left_ = 0;
+};
+
+}  // namespace internal
+
+// ----------------------------------------------------------------------------
+// Free functions.
+
+// Erases all elements that match predicate. It has O(bucket_count())
+// complexity.
+template <class Key,
+          class Value,
+          class GetKeyFromValue,
+          class Hash,
+          class KeyEqual,
+          typename Predicate>
+void EraseIf(
+    base::internal::flat_hash_table<Key, Value, GetKeyFromValue, Hash, KeyEqual>&
+        container,
+    Predicate pred) {
+  for (auto it = container.begin(); it != container.end();) {
+    if (pred(*it))
+      it = container.erase(it);
+    else
+      ++it;
+  }
+}
+
+}  // namespace base
+
+#endif  // BASE_CONTAINERS_FLAT_HASH_TABLE_H_
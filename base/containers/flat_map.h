@@ -71,6 +71,14 @@ struct GetKeyFromValuePairFirst {
 //            FlatContainerDupes = KEEP_FIRST_OF_DUPES,
 //            const Compare& comp = Compare());
 //
+// Constructors (inputs must be sorted and unique, see sorted_unique_t):
+//   flat_map(sorted_unique_t, InputIterator first, InputIterator last,
+//            const Compare& compare = Compare());
+//   flat_map(sorted_unique_t, std::vector<value_type>,
+//            const Compare& compare = Compare());  // Re-use storage.
+//   flat_map(sorted_unique_t, std::initializer_list<value_type> ilist,
+//            const Compare& comp = Compare());
+//
 // Assignment functions:
 //   flat_map& operator=(const flat_map&);
 //   flat_map& operator=(flat_map&&);
@@ -80,6 +88,8 @@ struct GetKeyFromValuePairFirst {
 //   void   reserve(size_t);
 //   size_t capacity() const;
 //   void   shrink_to_fit();
+//   std::vector<value_type> extract() &&;
+//   void   replace(std::vector<value_type>&&);
 //
 // Size management functions:
 //   void   clear();
@@ -110,6 +120,9 @@ struct GetKeyFromValuePairFirst {
 //   iterator             insert(const_iterator hint, value_type&&);
 //   void                 insert(InputIterator first, InputIterator last,
 //                               FlatContainerDupes = KEEP_FIRST_OF_DUPES);
+//   void                 insert(sorted_unique_t,
+//                               InputIterator first, InputIterator last,
+//                               FlatContainerDupes = KEEP_FIRST_OF_DUPES);
 //   pair<iterator, bool> insert_or_assign(K&&, M&&);
 //   iterator             insert_or_assign(const_iterator hint, K&&, M&&);
 //   pair<iterator, bool> emplace(Args&&...);
@@ -197,6 +210,20 @@ class flat_map : public ::base::internal::flat_tree<
            FlatContainerDupes dupe_handling = KEEP_FIRST_OF_DUPES,
            const Compare& comp = Compare());
 
+  template <class InputIterator>
+  flat_map(sorted_unique_t,
+           InputIterator first,
+           InputIterator last,
+           const Compare& comp = Compare());
+
+  flat_map(sorted_unique_t,
+           std::vector<value_type> items,
+           const Compare& comp = Compare());
+
+  flat_map(sorted_unique_t,
+           std::initializer_list<value_type> ilist,
+           const Compare& comp = Compare());
+
   ~flat_map() = default;
 
   flat_map& operator=(const flat_map&) = default;
@@ -266,6 +293,27 @@ flat_map<Key, Mapped, Compare>::flat_map(
     const Compare& comp)
     : flat_map(std::begin(ilist), std::end(ilist), dupe_handling, comp) {}
 
+template <class Key, class Mapped, class Compare>
+template <class InputIterator>
+flat_map<Key, Mapped, Compare>::flat_map(sorted_unique_t,
+                                         InputIterator first,
+                                         InputIterator last,
+                                         const Compare& comp)
+    : tree(sorted_unique, first, last, comp) {}
+
+template <class Key, class Mapped, class Compare>
+flat_map<Key, Mapped, Compare>::flat_map(sorted_unique_t,
+                                         std::vector<value_type> items,
+                                         const Compare& comp)
+    : tree(sorted_unique, std::move(items), comp) {}
+
+template <class Key, class Mapped, class Compare>
+flat_map<Key, Mapped, Compare>::flat_map(
+    sorted_unique_t,
+    std::initializer_list<value_type> ilist,
+    const Compare& comp)
+    : flat_map(sorted_unique, std::begin(ilist), std::end(ilist), comp) {}
+
 // ----------------------------------------------------------------------------
 // Assignments.
 
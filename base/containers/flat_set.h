@@ -57,6 +57,14 @@ namespace base {
 //            FlatContainerDupes = KEEP_FIRST_OF_DUPES,
 //            const Compare& comp = Compare());
 //
+// Constructors (inputs must be sorted and unique, see sorted_unique_t):
+//   flat_set(sorted_unique_t, InputIterator first, InputIterator last,
+//            const Compare& compare = Compare());
+//   flat_set(sorted_unique_t, std::vector<Key>,
+//            const Compare& compare = Compare());  // Re-use storage.
+//   flat_set(sorted_unique_t, std::initializer_list<value_type> ilist,
+//            const Compare& comp = Compare());
+//
 // Assignment functions:
 //   flat_set& operator=(const flat_set&);
 //   flat_set& operator=(flat_set&&);
@@ -66,6 +74,8 @@ namespace base {
 //   void   reserve(size_t);
 //   size_t capacity() const;
 //   void   shrink_to_fit();
+//   std::vector<Key> extract() &&;
+//   void   replace(std::vector<Key>&&);
 //
 // Size management functions:
 //   void   clear();
@@ -92,6 +102,9 @@ namespace base {
 //   pair<iterator, bool> insert(key_type&&);
 //   void                 insert(InputIterator first, InputIterator last,
 //                               FlatContainerDupes = KEEP_FIRST_OF_DUPES);
+//   void                 insert(sorted_unique_t,
+//                               InputIterator first, InputIterator last,
+//                               FlatContainerDupes = KEEP_FIRST_OF_DUPES);
 //   iterator             insert(const_iterator hint, const key_type&);
 //   iterator             insert(const_iterator hint, key_type&&);
 //   pair<iterator, bool> emplace(Args&&...);
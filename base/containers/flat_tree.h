@@ -8,8 +8,10 @@
 #include <algorithm>
 #include <iterator>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "base/logging.h"
 #include "base/template_util.h"
 
 namespace base {
@@ -19,6 +21,17 @@ enum FlatContainerDupes {
   KEEP_LAST_OF_DUPES,
 };
 
+// Tag type for the constructors and insert() overload of flat_tree (and thus
+// flat_map and flat_set) that take a range which is already sorted according
+// to the comparator and has no duplicates. They skip the sort, and insert()
+// merges the range in linear time. Passing a range that is not sorted and
+// unique is undefined behavior (checked in debug builds).
+struct sorted_unique_t {
+  constexpr sorted_unique_t() = default;
+};
+
+constexpr sorted_unique_t sorted_unique;
+
 namespace internal {
 
 // This is a convenience method returning true if Iterator is at least a
@@ -58,6 +71,16 @@ Iterator LastUnique(Iterator first, Iterator last, BinaryPredicate compare) {
   return replacable;
 }
 
+// Returns whether [first, last) is sorted according to |compare| and has no
+// equivalent elements.
+template <class Iterator, class Compare>
+bool IsSortedAndUnique(Iterator first, Iterator last, const Compare& compare) {
+  return std::adjacent_find(first, last,
+                            [&compare](const auto& lhs, const auto& rhs) {
+                              return !compare(lhs, rhs);
+                            }) == last;
+}
+
 // Uses SFINAE to detect whether type has is_transparent member.
 template <typename T, typename = void>
 struct IsTransparentCompare : std::false_type {};
@@ -150,6 +173,23 @@ class flat_tree {
             FlatContainerDupes dupe_handling = KEEP_FIRST_OF_DUPES,
             const key_compare& comp = key_compare());
 
+  // These constructors take O(N) and require the input to be sorted and
+  // unique (see sorted_unique_t).
+
+  template <class InputIterator>
+  flat_tree(sorted_unique_t,
+            InputIterator first,
+            InputIterator last,
+            const key_compare& comp = key_compare());
+
+  flat_tree(sorted_unique_t,
+            std::vector<value_type> items,
+            const key_compare& comp = key_compare());
+
+  flat_tree(sorted_unique_t,
+            std::initializer_list<value_type> ilist,
+            const key_compare& comp = key_compare());
+
   ~flat_tree();
 
   // --------------------------------------------------------------------------
@@ -175,6 +215,16 @@ class flat_tree {
   size_type capacity() const;
   void shrink_to_fit();
 
+  // Moves the sorted and unique underlying vector out of the flat_tree, which
+  // is left empty. Together with replace(), this lets a flat_tree be updated
+  // in place of the vector, e.g. to batch several modifications and fix the
+  // order once, without copying the elements.
+  std::vector<value_type> extract() &&;
+
+  // Replaces the contents with |body|, which must be sorted and unique (see
+  // sorted_unique_t).
+  void replace(std::vector<value_type>&& body);
+
   // --------------------------------------------------------------------------
   // Size management.
   //
@@ -229,6 +279,15 @@ class flat_tree {
               InputIterator last,
               FlatContainerDupes dupes = KEEP_FIRST_OF_DUPES);
 
+  // Same as above for a range that is sorted and unique (see sorted_unique_t),
+  // which is merged in O(size + N). This is the fastest way to add many
+  // elements to a large flat_tree.
+  template <class InputIterator>
+  void insert(sorted_unique_t,
+              InputIterator first,
+              InputIterator last,
+              FlatContainerDupes dupes = KEEP_FIRST_OF_DUPES);
+
   template <class... Args>
   std::pair<iterator, bool> emplace(Args&&... args);
 
@@ -538,6 +597,33 @@ flat_tree<Key, Value, GetKeyFromValue, KeyCompare>::flat_tree(
     const KeyCompare& comp)
     : flat_tree(std::begin(ilist), std::end(ilist), dupe_handling, comp) {}
 
+template <class Key, class Value, class GetKeyFromValue, class KeyCompare>
+template <class InputIterator>
+flat_tree<Key, Value, GetKeyFromValue, KeyCompare>::flat_tree(
+    sorted_unique_t,
+    InputIterator first,
+    InputIterator last,
+    const KeyCompare& comp)
+    : impl_(comp, first, last) {
+  DCHECK(IsSortedAndUnique(begin(), end(), impl_.get_value_comp()));
+}
+
+template <class Key, class Value, class GetKeyFromValue, class KeyCompare>
+flat_tree<Key, Value, GetKeyFromValue, KeyCompare>::flat_tree(
+    sorted_unique_t,
+    std::vector<value_type> items,
+    const KeyCompare& comp)
+    : impl_(comp, std::move(items)) {
+  DCHECK(IsSortedAndUnique(begin(), end(), impl_.get_value_comp()));
+}
+
+template <class Key, class Value, class GetKeyFromValue, class KeyCompare>
+flat_tree<Key, Value, GetKeyFromValue, KeyCompare>::flat_tree(
+    sorted_unique_t,
+    std::initializer_list<value_type> ilist,
+    const KeyCompare& comp)
+    : flat_tree(sorted_unique, std::begin(ilist), std::end(ilist), comp) {}
+
 template <class Key, class Value, class GetKeyFromValue, class KeyCompare>
 flat_tree<Key, Value, GetKeyFromValue, KeyCompare>::~flat_tree() = default;
 
@@ -580,6 +666,19 @@ void flat_tree<Key, Value, GetKeyFromValue, KeyCompare>::shrink_to_fit() {
   impl_.body_.shrink_to_fit();
 }
 
+template <class Key, class Value, class GetKeyFromValue, class KeyCompare>
+auto flat_tree<Key, Value, GetKeyFromValue, KeyCompare>::extract() &&
+    -> std::vector<value_type> {
+  return std::exchange(impl_.body_, std::vector<value_type>());
+}
+
+template <class Key, class Value, class GetKeyFromValue, class KeyCompare>
+void flat_tree<Key, Value, GetKeyFromValue, KeyCompare>::replace(
+    std::vector<value_type>&& body) {
+  DCHECK(IsSortedAndUnique(body.begin(), body.end(), impl_.get_value_comp()));
+  impl_.body_ = std::move(body);
+}
+
 // ----------------------------------------------------------------------------
 // Size management.
 
@@ -777,6 +876,46 @@ void flat_tree<Key, Value, GetKeyFromValue, KeyCompare>::insert(
                      value_comp());
 }
 
+template <class Key, class Value, class GetKeyFromValue, class KeyCompare>
+template <class InputIterator>
+void flat_tree<Key, Value, GetKeyFromValue, KeyCompare>::insert(
+    sorted_unique_t,
+    InputIterator first,
+    InputIterator last,
+    FlatContainerDupes dupes) {
+  if (first == last)
+    return;
+
+  // A single linear pass merges both ranges into a new vector, so that no
+  // element needs to be moved more than once.
+  underlying_type merged;
+  if (is_multipass<InputIterator>())
+    merged.reserve(size() + std::distance(first, last));
+  else
+    merged.reserve(size());
+
+  const value_compare& compare = impl_.get_value_comp();
+  iterator current = begin();
+  for (; first != last; ++first) {
+    while (current != end() && compare(*current, *first))
+      merged.push_back(std::move(*current++));
+    if (current != end() && !compare(*first, *current)) {
+      // Equivalent elements.
+      if (dupes == KEEP_FIRST_OF_DUPES)
+        merged.push_back(std::move(*current));
+      else
+        merged.push_back(*first);
+      ++current;
+    } else {
+      merged.push_back(*first);
+    }
+  }
+  std::move(current, end(), std::back_inserter(merged));
+
+  DCHECK(IsSortedAndUnique(merged.begin(), merged.end(), compare));
+  impl_.body_ = std::move(merged);
+}
+
 template <class Key, class Value, class GetKeyFromValue, class KeyCompare>
 template <class... Args>
 auto flat_tree<Key, Value, GetKeyFromValue, KeyCompare>::emplace(Args&&... args)
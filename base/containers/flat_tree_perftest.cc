@@ -0,0 +1,130 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/containers/flat_tree.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "base/containers/flat_set.h"
+#include "base/strings/stringprintf.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+
+namespace {
+
+// Number of batches added by each test.
+constexpr size_t kBatchCount = 64;
+
+// Returns |count| pseudo-random values.
+std::vector<uint32_t> GetValues(size_t count, uint32_t seed) {
+  std::vector<uint32_t> values;
+  values.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    seed = seed * 1103515245 + 12345;
+    values.push_back(seed);
+  }
+  return values;
+}
+
+enum class InsertMethod {
+  // insert() of each element.
+  kSingle,
+  // insert() of the unsorted batch.
+  kRange,
+  // insert(sorted_unique, ...) of the batch, including the time to sort it.
+  kSortedUnique,
+  // Construction of a new flat_set from the elements of the set and the batch.
+  kRebuild,
+};
+
+const char* GetMethodName(InsertMethod method) {
+  switch (method) {
+    case InsertMethod::kSingle:
+      return "single";
+    case InsertMethod::kRange:
+      return "range";
+    case InsertMethod::kSortedUnique:
+      return "sorted_unique";
+    case InsertMethod::kRebuild:
+      return "rebuild";
+  }
+  return "";
+}
+
+void InsertBatch(InsertMethod method,
+                 std::vector<uint32_t> batch,
+                 flat_set<uint32_t>* set) {
+  switch (method) {
+    case InsertMethod::kSingle:
+      for (uint32_t value : batch)
+        set->insert(value);
+      break;
+    case InsertMethod::kRange:
+      set->insert(batch.begin(), batch.end());
+      break;
+    case InsertMethod::kSortedUnique:
+      std::sort(batch.begin(), batch.end());
+      batch.erase(std::unique(batch.begin(), batch.end()), batch.end());
+      set->insert(sorted_unique, batch.begin(), batch.end());
+      break;
+    case InsertMethod::kRebuild: {
+      std::vector<uint32_t> body = std::move(*set).extract();
+      body.insert(body.end(), batch.begin(), batch.end());
+      *set = flat_set<uint32_t>(std::move(body));
+      break;
+    }
+  }
+}
+
+// Measures the cost of growing a flat_set by adding kBatchCount batches of
+// |batch_size| elements with |method|.
+void RunInsertTest(InsertMethod method, size_t batch_size) {
+  const size_t total_inserted = kBatchCount * batch_size;
+  const std::vector<uint32_t> values = GetValues(total_inserted, 1);
+  flat_set<uint32_t> set;
+
+  TimeTicks begin = TimeTicks::Now();
+  for (size_t i = 0; i < total_inserted; i += batch_size) {
+    InsertBatch(method,
+                std::vector<uint32_t>(values.begin() + i,
+                                      values.begin() + i + batch_size),
+                &set);
+  }
+  TimeDelta elapsed = TimeTicks::Now() - begin;
+
+  EXPECT_TRUE(std::is_sorted(set.begin(), set.end()));
+  perf_test::PrintResult(
+      "FlatTree_Insert", GetMethodName(method),
+      StringPrintf("batch_%zu", batch_size),
+      elapsed.InNanoseconds() / static_cast<double>(total_inserted),
+      "ns/element", true);
+}
+
+}  // namespace
+
+TEST(FlatTreePerfTest, InsertBatches) {
+  for (size_t batch_size : {256, 4096, 32768}) {
+    for (InsertMethod method :
+         {InsertMethod::kRange, InsertMethod::kSortedUnique,
+          InsertMethod::kRebuild}) {
+      RunInsertTest(method, batch_size);
+    }
+  }
+}
+
+// Single insertions are quadratic, so they are only measured with the smallest
+// batches.
+TEST(FlatTreePerfTest, InsertSingle) {
+  RunInsertTest(InsertMethod::kSingle, 256);
+}
+
+}  // namespace base
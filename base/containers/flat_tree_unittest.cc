@@ -850,6 +850,101 @@ TEST(FlatTree, InsertIterIter) {
   }
 }
 
+// insert(sorted_unique_t, first, last, dupes)
+
+TEST(FlatTree, InsertSortedUnique) {
+  struct GetKeyFromIntIntPair {
+    const int& operator()(const std::pair<int, int>& p) const {
+      return p.first;
+    }
+  };
+
+  using IntIntMap =
+      flat_tree<int, IntPair, GetKeyFromIntIntPair, std::less<int>>;
+
+  {
+    IntIntMap cont;
+    IntPair int_pairs[] = {{1, 1}, {2, 1}, {3, 1}};
+    cont.insert(sorted_unique, std::begin(int_pairs), std::end(int_pairs));
+    EXPECT_THAT(cont, ElementsAre(IntPair(1, 1), IntPair(2, 1), IntPair(3, 1)));
+  }
+
+  {
+    IntIntMap cont({{1, 1}, {3, 1}, {5, 1}, {7, 1}});
+    IntPair int_pairs[] = {{0, 2}, {3, 2}, {4, 2}, {7, 2}, {9, 2}};
+    cont.insert(sorted_unique, std::begin(int_pairs), std::end(int_pairs));
+    EXPECT_THAT(cont, ElementsAre(IntPair(0, 2), IntPair(1, 1), IntPair(3, 1),
+                                  IntPair(4, 2), IntPair(5, 1), IntPair(7, 1),
+                                  IntPair(9, 2)));
+  }
+
+  {
+    IntIntMap cont({{1, 1}, {3, 1}, {5, 1}, {7, 1}});
+    IntPair int_pairs[] = {{0, 2}, {3, 2}, {4, 2}, {7, 2}, {9, 2}};
+    cont.insert(sorted_unique, std::begin(int_pairs), std::end(int_pairs),
+                KEEP_LAST_OF_DUPES);
+    EXPECT_THAT(cont, ElementsAre(IntPair(0, 2), IntPair(1, 1), IntPair(3, 2),
+                                  IntPair(4, 2), IntPair(5, 1), IntPair(7, 2),
+                                  IntPair(9, 2)));
+  }
+
+  {
+    IntTree cont({1, 2, 3});
+    int ints[] = {0, 4, 5};
+    cont.insert(sorted_unique, MakeInputIterator(std::begin(ints)),
+                MakeInputIterator(std::end(ints)));
+    EXPECT_THAT(cont, ElementsAre(0, 1, 2, 3, 4, 5));
+  }
+
+  {
+    MoveOnlyTree cont;
+    cont.insert(MoveOnlyInt(2));
+    MoveOnlyInt input[] = {MoveOnlyInt(1), MoveOnlyInt(3)};
+    cont.insert(sorted_unique, std::make_move_iterator(std::begin(input)),
+                std::make_move_iterator(std::end(input)));
+    EXPECT_EQ(3u, cont.size());
+    EXPECT_EQ(1, cont.begin()->data());
+    EXPECT_EQ(3, std::prev(cont.end())->data());
+  }
+}
+
+// flat_tree(sorted_unique_t, ...)
+
+TEST(FlatTree, SortedUniqueConstructors) {
+  {
+    int ints[] = {1, 2, 3};
+    IntTree cont(sorted_unique, std::begin(ints), std::end(ints));
+    EXPECT_THAT(cont, ElementsAre(1, 2, 3));
+  }
+  {
+    IntTree cont(sorted_unique, std::vector<int>({1, 2, 3}));
+    EXPECT_THAT(cont, ElementsAre(1, 2, 3));
+  }
+  {
+    IntTree cont(sorted_unique, {1, 2, 3});
+    EXPECT_THAT(cont, ElementsAre(1, 2, 3));
+  }
+}
+
+// extract() &&
+// replace(std::vector<value_type>&&)
+
+TEST(FlatTree, ExtractAndReplace) {
+  IntTree cont({1, 2, 3});
+  const int* data = &*cont.begin();
+
+  std::vector<int> body = std::move(cont).extract();
+  EXPECT_TRUE(cont.empty());
+  EXPECT_THAT(body, ElementsAre(1, 2, 3));
+  EXPECT_EQ(data, body.data());
+
+  body.push_back(4);
+  data = body.data();
+  cont.replace(std::move(body));
+  EXPECT_THAT(cont, ElementsAre(1, 2, 3, 4));
+  EXPECT_EQ(data, &*cont.begin());
+}
+
 // template <class... Args>
 // pair<iterator, bool> emplace(Args&&... args)
 
@@ -0,0 +1,162 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/files/batched_file_io.h"
+
+#include <string.h>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/callback.h"
+#include "base/logging.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
+#include "base/sequence_checker.h"
+#include "base/task/post_task.h"
+
+namespace base {
+
+namespace {
+
+// Implementation of BatchedFileIO that performs each batch of operations with
+// blocking calls in a thread pool task. Batches may run concurrently.
+class BlockingBatchedFileIO : public BatchedFileIO {
+ public:
+  explicit BlockingBatchedFileIO(File file)
+      : file_(MakeRefCounted<RefCountedData<File>>(std::move(file))),
+        weak_factory_(this) {}
+
+  ~BlockingBatchedFileIO() override {
+    DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  }
+
+  void Read(int64_t offset,
+            int bytes_to_read,
+            ReadCallback callback) override {
+    DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+    DCHECK_GE(bytes_to_read, 0);
+    DCHECK(callback);
+    Operation operation;
+    operation.offset = offset;
+    operation.buffer.reset(new char[bytes_to_read]);
+    operation.size = bytes_to_read;
+    operation.read_callback = std::move(callback);
+    queued_.push_back(std::move(operation));
+  }
+
+  void Write(int64_t offset,
+             const char* data,
+             int bytes_to_write,
+             WriteCallback callback) override {
+    DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+    DCHECK_GE(bytes_to_write, 0);
+    Operation operation;
+    operation.is_write = true;
+    operation.offset = offset;
+    operation.buffer.reset(new char[bytes_to_write]);
+    memcpy(operation.buffer.get(), data, bytes_to_write);
+    operation.size = bytes_to_write;
+    operation.write_callback = std::move(callback);
+    queued_.push_back(std::move(operation));
+  }
+
+  void Submit() override {
+    DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+    if (queued_.empty())
+      return;
+
+    // The task holds a reference to the file, so that it can outlive this.
+    auto operations = std::make_unique<std::vector<Operation>>();
+    operations->swap(queued_);
+    std::vector<Operation>* const operations_ptr = operations.get();
+    PostTaskWithTraitsAndReply(
+        FROM_HERE,
+        {MayBlock(), TaskPriority::USER_VISIBLE,
+         TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+        BindOnce(&RunOperations, file_, Unretained(operations_ptr)),
+        BindOnce(&BlockingBatchedFileIO::OnOperationsDone,
+                 weak_factory_.GetWeakPtr(), std::move(operations)));
+  }
+
+ private:
+  struct Operation {
+    bool is_write = false;
+    int64_t offset = 0;
+    std::unique_ptr<char[]> buffer;
+    int size = 0;
+    ReadCallback read_callback;
+    WriteCallback write_callback;
+
+    // Result of the operation: the number of bytes read or written, or -1.
+    int result = 0;
+    File::Error error = File::FILE_OK;
+  };
+
+  static void RunOperations(scoped_refptr<RefCountedData<File>> file,
+                            std::vector<Operation>* operations) {
+    for (Operation& operation : *operations) {
+      if (operation.is_write) {
+        operation.result = file->data.Write(
+            operation.offset, operation.buffer.get(), operation.size);
+      } else {
+        operation.result = file->data.ReadNoBestEffort(
+            operation.offset, operation.buffer.get(), operation.size);
+      }
+      if (operation.result < 0)
+        operation.error = File::GetLastFileError();
+    }
+  }
+
+  void OnOperationsDone(std::unique_ptr<std::vector<Operation>> operations) {
+    DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+    WeakPtr<BlockingBatchedFileIO> self = weak_factory_.GetWeakPtr();
+    for (Operation& operation : *operations) {
+      if (operation.is_write) {
+        if (operation.write_callback) {
+          std::move(operation.write_callback)
+              .Run(operation.error, operation.result);
+        }
+      } else {
+        std::move(operation.read_callback)
+            .Run(operation.error, operation.buffer.get(), operation.result);
+      }
+      // A callback may have deleted this.
+      if (!self)
+        return;
+    }
+  }
+
+  const scoped_refptr<RefCountedData<File>> file_;
+
+  // Operations queued since the last call to Submit().
+  std::vector<Operation> queued_;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+
+  WeakPtrFactory<BlockingBatchedFileIO> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(BlockingBatchedFileIO);
+};
+
+}  // namespace
+
+// static
+std::unique_ptr<BatchedFileIO> BatchedFileIO::Create(File file) {
+#if defined(OS_LINUX)
+  std::unique_ptr<BatchedFileIO> io_uring = CreateIOUring(&file);
+  if (io_uring)
+    return io_uring;
+#endif
+  return CreateBlocking(std::move(file));
+}
+
+// static
+std::unique_ptr<BatchedFileIO> BatchedFileIO::CreateBlocking(File file) {
+  return std::make_unique<BlockingBatchedFileIO>(std::move(file));
+}
+
+}  // namespace base
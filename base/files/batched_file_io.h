@@ -0,0 +1,96 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_FILES_BATCHED_FILE_IO_H_
+#define BASE_FILES_BATCHED_FILE_IO_H_
+
+#include <stdint.h>
+
+#include <memory>
+
+#include "base/base_export.h"
+#include "base/callback_forward.h"
+#include "base/files/file.h"
+#include "base/macros.h"
+#include "build/build_config.h"
+
+namespace base {
+
+// BatchedFileIO issues positional reads and writes on a file without blocking
+// the calling sequence, and submits them to the OS in batches. It is meant for
+// callers that issue many small operations at once, e.g. a disk cache reading
+// entries, where a blocking call per operation on a MayBlock thread is
+// dominated by the per-operation overhead. Like FileProxy, it owns the file.
+//
+// Operations are queued by Read() and Write() and passed to the OS by Submit().
+// Their callbacks run on the sequence on which the BatchedFileIO was created,
+// in the order in which they complete, which is not necessarily the order in
+// which they were queued. Callbacks of the operations that didn't complete
+// when the BatchedFileIO is deleted are never run.
+//
+// Example:
+//
+//   std::unique_ptr<BatchedFileIO> io = BatchedFileIO::Create(std::move(file));
+//   for (const Entry& entry : entries) {
+//     io->Read(entry.offset, entry.size,
+//              BindOnce(&OnEntryRead, weak_factory_.GetWeakPtr(), entry.id));
+//   }
+//   io->Submit();
+//
+// This class must be used on a single sequence, which must allow blocking
+// calls: deleting a BatchedFileIO closes the file and may wait for the
+// operations in flight.
+class BASE_EXPORT BatchedFileIO {
+ public:
+  // Same as FileProxy's callbacks. |data| is only valid during the call.
+  using ReadCallback =
+      OnceCallback<void(File::Error, const char* data, int bytes_read)>;
+  using WriteCallback = OnceCallback<void(File::Error, int bytes_written)>;
+
+  // Returns a BatchedFileIO using the most efficient mechanism available: an
+  // io_uring on Linux kernels that support it, blocking calls on the thread
+  // pool otherwise.
+  static std::unique_ptr<BatchedFileIO> Create(File file);
+
+  // Returns a BatchedFileIO that runs each batch of operations with blocking
+  // calls in a MayBlock thread pool task.
+  static std::unique_ptr<BatchedFileIO> CreateBlocking(File file);
+
+#if defined(OS_LINUX)
+  // Returns a BatchedFileIO backed by an io_uring, which takes |*file|, or
+  // nullptr and leaves |*file| alone if the kernel doesn't support io_uring.
+  // Completions are watched with FileDescriptorWatcher, which must be
+  // available on the current sequence.
+  static std::unique_ptr<BatchedFileIO> CreateIOUring(File* file);
+#endif
+
+  virtual ~BatchedFileIO() = default;
+
+  // Queues a read of at most |bytes_to_read| bytes at |offset|. As with
+  // File::ReadNoBestEffort(), fewer bytes may be read even when the file is
+  // long enough.
+  virtual void Read(int64_t offset,
+                    int bytes_to_read,
+                    ReadCallback callback) = 0;
+
+  // Queues a write of |bytes_to_write| bytes of |data| at |offset|. |data| is
+  // copied. |callback| can be null.
+  virtual void Write(int64_t offset,
+                     const char* data,
+                     int bytes_to_write,
+                     WriteCallback callback) = 0;
+
+  // Submits the operations queued since the last call.
+  virtual void Submit() = 0;
+
+ protected:
+  BatchedFileIO() = default;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(BatchedFileIO);
+};
+
+}  // namespace base
+
+#endif  // BASE_FILES_BATCHED_FILE_IO_H_
@@ -0,0 +1,372 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/files/batched_file_io.h"
+
+#include <errno.h>
+#include <linux/io_uring.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/callback.h"
+#include "base/containers/circular_deque.h"
+#include "base/files/file_descriptor_watcher_posix.h"
+#include "base/files/scoped_file.h"
+#include "base/logging.h"
+#include "base/memory/weak_ptr.h"
+#include "base/posix/eintr_wrapper.h"
+#include "base/sequence_checker.h"
+#include "base/threading/scoped_blocking_call.h"
+
+namespace base {
+
+namespace {
+
+// Number of entries of the submission queue. The kernel makes the completion
+// queue twice as large.
+constexpr unsigned kSubmissionQueueSize = 128;
+
+int IOUringSetup(unsigned entries, io_uring_params* params) {
+  return syscall(__NR_io_uring_setup, entries, params);
+}
+
+int IOUringEnter(int ring_fd,
+                 unsigned to_submit,
+                 unsigned min_complete,
+                 unsigned flags) {
+  return syscall(__NR_io_uring_enter, ring_fd, to_submit, min_complete, flags,
+                 nullptr, 0);
+}
+
+int IOUringRegister(int ring_fd,
+                    unsigned opcode,
+                    const void* arg,
+                    unsigned nr_args) {
+  return syscall(__NR_io_uring_register, ring_fd, opcode, arg, nr_args);
+}
+
+// Implementation of BatchedFileIO that submits operations to an io_uring, a
+// pair of queues shared with the kernel: Submit() adds the queued operations
+// to the submission queue and passes them all to the kernel with a single
+// system call, and the kernel signals an eventfd when it adds completions to
+// the completion queue.
+class IOUringBatchedFileIO : public BatchedFileIO {
+ public:
+  IOUringBatchedFileIO(ScopedFD ring_fd, ScopedFD event_fd)
+      : ring_fd_(std::move(ring_fd)),
+        event_fd_(std::move(event_fd)),
+        weak_factory_(this) {}
+
+  ~IOUringBatchedFileIO() override {
+    DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+    watch_controller_.reset();
+
+    // The kernel writes to the buffers of the operations in flight, so they
+    // can't be deleted before completing.
+    if (in_flight_count_ > 0) {
+      ScopedBlockingCall scoped_blocking_call(FROM_HERE,
+                                              BlockingType::MAY_BLOCK);
+      while (in_flight_count_ > 0) {
+        if (HANDLE_EINTR(IOUringEnter(ring_fd_.get(), GetUnsubmittedCount(), 1,
+                                      IORING_ENTER_GETEVENTS)) < 0 &&
+            errno != EAGAIN && errno != EBUSY) {
+          PLOG(ERROR) << "io_uring_enter";
+          break;
+        }
+        // Delete the completed operations without running their callbacks.
+        ReapCompletions();
+      }
+    }
+
+    if (sqes_)
+      munmap(sqes_, sqes_size_);
+    if (cq_ring_ && cq_ring_ != sq_ring_)
+      munmap(cq_ring_, cq_ring_size_);
+    if (sq_ring_)
+      munmap(sq_ring_, sq_ring_size_);
+  }
+
+  // Maps the queues of the ring, set up with |params|, and starts watching for
+  // completions. Takes |*file| on success, and returns false on failure.
+  bool Init(const io_uring_params& params, File* file) {
+    DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+    sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    cq_ring_size_ =
+        params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (single_mmap)
+      sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+
+    sq_ring_ = Map(sq_ring_size_, IORING_OFF_SQ_RING);
+    if (!sq_ring_)
+      return false;
+    cq_ring_ = single_mmap ? sq_ring_ : Map(cq_ring_size_, IORING_OFF_CQ_RING);
+    if (!cq_ring_)
+      return false;
+    sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+    sqes_ = static_cast<io_uring_sqe*>(Map(sqes_size_, IORING_OFF_SQES));
+    if (!sqes_)
+      return false;
+
+    char* const sq_ring = static_cast<char*>(sq_ring_);
+    sq_head_ = reinterpret_cast<uint32_t*>(sq_ring + params.sq_off.head);
+    sq_tail_ = reinterpret_cast<uint32_t*>(sq_ring + params.sq_off.tail);
+    sq_mask_ = *reinterpret_cast<uint32_t*>(sq_ring + params.sq_off.ring_mask);
+    sq_array_ = reinterpret_cast<uint32_t*>(sq_ring + params.sq_off.array);
+    sq_entries_ = params.sq_entries;
+
+    char* const cq_ring = static_cast<char*>(cq_ring_);
+    cq_head_ = reinterpret_cast<uint32_t*>(cq_ring + params.cq_off.head);
+    cq_tail_ = reinterpret_cast<uint32_t*>(cq_ring + params.cq_off.tail);
+    cq_mask_ = *reinterpret_cast<uint32_t*>(cq_ring + params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<io_uring_cqe*>(cq_ring + params.cq_off.cqes);
+    cq_entries_ = params.cq_entries;
+
+    const int event_fd = event_fd_.get();
+    if (IOUringRegister(ring_fd_.get(), IORING_REGISTER_EVENTFD, &event_fd,
+                        1) < 0) {
+      DPLOG(ERROR) << "io_uring_register";
+      return false;
+    }
+    watch_controller_ = FileDescriptorWatcher::WatchReadable(
+        event_fd, BindRepeating(&IOUringBatchedFileIO::OnCompletionsAvailable,
+                                Unretained(this)));
+
+    file_ = std::move(*file);
+    return true;
+  }
+
+  void Read(int64_t offset,
+            int bytes_to_read,
+            ReadCallback callback) override {
+    DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+    DCHECK_GE(bytes_to_read, 0);
+    DCHECK(callback);
+    auto operation = std::make_unique<Operation>();
+    operation->offset = offset;
+    operation->buffer.reset(new char[bytes_to_read]);
+    operation->iov = {operation->buffer.get(),
+                      static_cast<size_t>(bytes_to_read)};
+    operation->read_callback = std::move(callback);
+    queued_.push_back(std::move(operation));
+  }
+
+  void Write(int64_t offset,
+             const char* data,
+             int bytes_to_write,
+             WriteCallback callback) override {
+    DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+    DCHECK_GE(bytes_to_write, 0);
+    auto operation = std::make_unique<Operation>();
+    operation->is_write = true;
+    operation->offset = offset;
+    operation->buffer.reset(new char[bytes_to_write]);
+    memcpy(operation->buffer.get(), data, bytes_to_write);
+    operation->iov = {operation->buffer.get(),
+                      static_cast<size_t>(bytes_to_write)};
+    operation->write_callback = std::move(callback);
+    queued_.push_back(std::move(operation));
+  }
+
+  void Submit() override {
+    DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+    SubmitQueuedOperations();
+  }
+
+ private:
+  struct Operation {
+    bool is_write = false;
+    int64_t offset = 0;
+    std::unique_ptr<char[]> buffer;
+    iovec iov;
+    ReadCallback read_callback;
+    WriteCallback write_callback;
+
+    // Result of the operation: the number of bytes read or written, or minus
+    // the errno of the failure.
+    int result = 0;
+  };
+
+  void* Map(size_t size, off_t offset) {
+    void* address = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_POPULATE, ring_fd_.get(), offset);
+    if (address == MAP_FAILED) {
+      DPLOG(ERROR) << "mmap";
+      return nullptr;
+    }
+    return address;
+  }
+
+  // Returns the number of entries of the submission queue not yet consumed by
+  // the kernel.
+  uint32_t GetUnsubmittedCount() const {
+    return *sq_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+  }
+
+  // Moves queued operations to the submission queue, as long as the number of
+  // operations in flight is low enough for the completion queue never to
+  // overflow, and passes them to the kernel.
+  void SubmitQueuedOperations() {
+    uint32_t tail = *sq_tail_;
+    const uint32_t head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+    bool added = false;
+    while (!queued_.empty() && in_flight_count_ < cq_entries_ &&
+           tail - head < sq_entries_) {
+      std::unique_ptr<Operation> operation = std::move(queued_.front());
+      queued_.pop_front();
+
+      const uint32_t index = tail & sq_mask_;
+      io_uring_sqe* const sqe = &sqes_[index];
+      memset(sqe, 0, sizeof(*sqe));
+      sqe->opcode = operation->is_write ? IORING_OP_WRITEV : IORING_OP_READV;
+      sqe->fd = file_.GetPlatformFile();
+      sqe->off = operation->offset;
+      sqe->addr = reinterpret_cast<uintptr_t>(&operation->iov);
+      sqe->len = 1;
+      sqe->user_data = reinterpret_cast<uintptr_t>(operation.release());
+      sq_array_[index] = index;
+      ++tail;
+      ++in_flight_count_;
+      added = true;
+    }
+    if (added)
+      __atomic_store_n(sq_tail_, tail, __ATOMIC_RELEASE);
+
+    const uint32_t unsubmitted = GetUnsubmittedCount();
+    if (unsubmitted == 0)
+      return;
+    // The kernel may decline to take new operations while it is short on
+    // resources. They stay in the submission queue and are passed again with
+    // the next batch, or when operations complete.
+    if (HANDLE_EINTR(IOUringEnter(ring_fd_.get(), unsubmitted, 0, 0)) < 0 &&
+        errno != EAGAIN && errno != EBUSY) {
+      DPLOG(ERROR) << "io_uring_enter";
+    }
+  }
+
+  // Removes the entries of the completion queue and returns their operations.
+  std::vector<std::unique_ptr<Operation>> ReapCompletions() {
+    std::vector<std::unique_ptr<Operation>> completed;
+    uint32_t head = *cq_head_;
+    const uint32_t tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    for (; head != tail; ++head) {
+      const io_uring_cqe& cqe = cqes_[head & cq_mask_];
+      completed.emplace_back(reinterpret_cast<Operation*>(cqe.user_data));
+      completed.back()->result = cqe.res;
+    }
+    __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+    in_flight_count_ -= completed.size();
+    return completed;
+  }
+
+  void OnCompletionsAvailable() {
+    DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+    uint64_t event_count;
+    if (HANDLE_EINTR(read(event_fd_.get(), &event_count,
+                          sizeof(event_count))) < 0 &&
+        errno != EAGAIN) {
+      DPLOG(ERROR) << "read";
+    }
+
+    std::vector<std::unique_ptr<Operation>> completed = ReapCompletions();
+    // Completions make room for more operations.
+    SubmitQueuedOperations();
+
+    WeakPtr<IOUringBatchedFileIO> self = weak_factory_.GetWeakPtr();
+    for (const std::unique_ptr<Operation>& operation : completed) {
+      File::Error error = File::FILE_OK;
+      int result = operation->result;
+      if (result < 0) {
+        error = File::OSErrorToFileError(-result);
+        result = -1;
+      }
+      if (operation->is_write) {
+        if (operation->write_callback)
+          std::move(operation->write_callback).Run(error, result);
+      } else {
+        std::move(operation->read_callback)
+            .Run(error, operation->buffer.get(), result);
+      }
+      // A callback may have deleted this.
+      if (!self)
+        return;
+    }
+  }
+
+  const ScopedFD ring_fd_;
+  const ScopedFD event_fd_;
+  File file_;
+
+  // Mappings of the submission queue, of the completion queue (which may be
+  // the same mapping) and of the submission queue entries.
+  void* sq_ring_ = nullptr;
+  size_t sq_ring_size_ = 0;
+  void* cq_ring_ = nullptr;
+  size_t cq_ring_size_ = 0;
+  io_uring_sqe* sqes_ = nullptr;
+  size_t sqes_size_ = 0;
+
+  // Fields of the queues, the heads and tails being shared with the kernel.
+  uint32_t* sq_head_ = nullptr;
+  uint32_t* sq_tail_ = nullptr;
+  uint32_t sq_mask_ = 0;
+  uint32_t* sq_array_ = nullptr;
+  uint32_t sq_entries_ = 0;
+  uint32_t* cq_head_ = nullptr;
+  uint32_t* cq_tail_ = nullptr;
+  uint32_t cq_mask_ = 0;
+  io_uring_cqe* cqes_ = nullptr;
+  uint32_t cq_entries_ = 0;
+
+  // Operations queued by Read() and Write() but not yet in the submission
+  // queue.
+  circular_deque<std::unique_ptr<Operation>> queued_;
+
+  // Number of operations in the submission queue or in the kernel.
+  size_t in_flight_count_ = 0;
+
+  std::unique_ptr<FileDescriptorWatcher::Controller> watch_controller_;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+
+  WeakPtrFactory<IOUringBatchedFileIO> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(IOUringBatchedFileIO);
+};
+
+}  // namespace
+
+// static
+std::unique_ptr<BatchedFileIO> BatchedFileIO::CreateIOUring(File* file) {
+  DCHECK(file->IsValid());
+  io_uring_params params = {};
+  // Fails with ENOSYS on kernels older than 5.1.
+  ScopedFD ring_fd(IOUringSetup(kSubmissionQueueSize, &params));
+  if (!ring_fd.is_valid())
+    return nullptr;
+
+  ScopedFD event_fd(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK));
+  if (!event_fd.is_valid()) {
+    DPLOG(ERROR) << "eventfd";
+    return nullptr;
+  }
+
+  auto io = std::make_unique<IOUringBatchedFileIO>(std::move(ring_fd),
+                                                   std::move(event_fd));
+  if (!io->Init(params, file))
+    return nullptr;
+  return io;
+}
+
+}  // namespace base
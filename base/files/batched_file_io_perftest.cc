@@ -0,0 +1,133 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/files/batched_file_io.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/logging.h"
+#include "base/run_loop.h"
+#include "base/strings/stringprintf.h"
+#include "base/test/bind_test_util.h"
+#include "base/test/scoped_task_environment.h"
+#include "base/time/time.h"
+#include "build/build_config.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+
+namespace {
+
+// The file is small enough to stay in the page cache, so that the benchmark
+// measures the cost of issuing the reads rather than the speed of the disk.
+constexpr int64_t kFileSize = 64 * 1024 * 1024;
+constexpr int kReadSize = 4096;
+constexpr int kReadCount = 50000;
+
+class BatchedFileIOPerfTest : public testing::Test {
+ public:
+  BatchedFileIOPerfTest()
+      : scoped_task_environment_(
+            test::ScopedTaskEnvironment::MainThreadType::IO) {}
+
+  void SetUp() override {
+    ASSERT_TRUE(dir_.CreateUniqueTempDir());
+    path_ = dir_.GetPath().AppendASCII("file");
+    File file(path_, File::FLAG_CREATE | File::FLAG_WRITE);
+    ASSERT_TRUE(file.IsValid());
+    const std::string chunk(1024 * 1024, 'a');
+    for (int64_t offset = 0; offset < kFileSize; offset += chunk.size()) {
+      ASSERT_EQ(static_cast<int>(chunk.size()),
+                file.Write(offset, chunk.data(), chunk.size()));
+    }
+
+    uint32_t seed = 1;
+    for (int i = 0; i < kReadCount; ++i) {
+      seed = seed * 1103515245 + 12345;
+      offsets_.push_back((seed % (kFileSize / kReadSize)) * kReadSize);
+    }
+  }
+
+  File OpenFile() { return File(path_, File::FLAG_OPEN | File::FLAG_READ); }
+
+  // Reads kReadSize bytes at each of |offsets_| with |io|, submitting
+  // |batch_size| reads at a time and waiting for them to complete.
+  void RunTest(const char* backend,
+               std::unique_ptr<BatchedFileIO> io,
+               int batch_size) {
+    TimeTicks begin = TimeTicks::Now();
+    for (int i = 0; i < kReadCount; i += batch_size) {
+      const int count = std::min(batch_size, kReadCount - i);
+      int completed = 0;
+      RunLoop run_loop;
+      for (int j = 0; j < count; ++j) {
+        io->Read(offsets_[i + j], kReadSize,
+                 BindLambdaForTesting(
+                     [&](File::Error error, const char* data, int size) {
+                       EXPECT_EQ(kReadSize, size);
+                       if (++completed == count)
+                         run_loop.Quit();
+                     }));
+      }
+      io->Submit();
+      run_loop.Run();
+    }
+    PrintResult(backend, batch_size, TimeTicks::Now() - begin);
+  }
+
+  void PrintResult(const char* backend, int batch_size, TimeDelta elapsed) {
+    perf_test::PrintResult("BatchedFileIO_RandomRead", backend,
+                           StringPrintf("batch_%d", batch_size),
+                           kReadCount / elapsed.InSecondsF(), "IOPS", true);
+  }
+
+ protected:
+  test::ScopedTaskEnvironment scoped_task_environment_;
+  ScopedTempDir dir_;
+  FilePath path_;
+  std::vector<int64_t> offsets_;
+};
+
+}  // namespace
+
+// Baseline: one blocking read at a time on the current thread.
+TEST_F(BatchedFileIOPerfTest, SynchronousRead) {
+  File file = OpenFile();
+  std::vector<char> buffer(kReadSize);
+  TimeTicks begin = TimeTicks::Now();
+  for (int64_t offset : offsets_)
+    EXPECT_EQ(kReadSize, file.Read(offset, buffer.data(), kReadSize));
+  PrintResult("synchronous", 1, TimeTicks::Now() - begin);
+}
+
+TEST_F(BatchedFileIOPerfTest, BlockingRead) {
+  for (int batch_size : {1, 16, 128})
+    RunTest("blocking", BatchedFileIO::CreateBlocking(OpenFile()), batch_size);
+}
+
+#if defined(OS_LINUX)
+TEST_F(BatchedFileIOPerfTest, IOUringRead) {
+  for (int batch_size : {1, 16, 128}) {
+    File file = OpenFile();
+    std::unique_ptr<BatchedFileIO> io = BatchedFileIO::CreateIOUring(&file);
+    if (!io) {
+      LOG(WARNING) << "io_uring isn't supported";
+      return;
+    }
+    RunTest("io_uring", std::move(io), batch_size);
+  }
+}
+#endif  // defined(OS_LINUX)
+
+}  // namespace base
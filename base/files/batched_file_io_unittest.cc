@@ -0,0 +1,223 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/files/batched_file_io.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/run_loop.h"
+#include "base/test/bind_test_util.h"
+#include "base/test/scoped_task_environment.h"
+#include "build/build_config.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+namespace {
+
+enum class Backend {
+  kDefault,
+  kBlocking,
+#if defined(OS_LINUX)
+  kIOUring,
+#endif
+};
+
+class BatchedFileIOTest : public testing::TestWithParam<Backend> {
+ public:
+  BatchedFileIOTest()
+      : scoped_task_environment_(
+            test::ScopedTaskEnvironment::MainThreadType::IO) {}
+
+  void SetUp() override {
+    ASSERT_TRUE(dir_.CreateUniqueTempDir());
+    path_ = dir_.GetPath().AppendASCII("file");
+    for (size_t i = 0; i < 64 * 1024; ++i)
+      contents_.push_back(static_cast<char>(i * 7 + i / 256));
+    ASSERT_EQ(static_cast<int>(contents_.size()),
+              WriteFile(path_, contents_.data(), contents_.size()));
+  }
+
+  // Returns a BatchedFileIO for the test file, or nullptr if the backend of the
+  // test isn't available.
+  std::unique_ptr<BatchedFileIO> CreateBatchedFileIO() {
+    File file(path_, File::FLAG_OPEN | File::FLAG_READ | File::FLAG_WRITE);
+    EXPECT_TRUE(file.IsValid());
+    switch (GetParam()) {
+      case Backend::kDefault:
+        return BatchedFileIO::Create(std::move(file));
+      case Backend::kBlocking:
+        return BatchedFileIO::CreateBlocking(std::move(file));
+#if defined(OS_LINUX)
+      case Backend::kIOUring:
+        return BatchedFileIO::CreateIOUring(&file);
+#endif
+    }
+    return nullptr;
+  }
+
+ protected:
+  test::ScopedTaskEnvironment scoped_task_environment_;
+  ScopedTempDir dir_;
+  FilePath path_;
+  std::string contents_;
+};
+
+}  // namespace
+
+TEST_P(BatchedFileIOTest, Read) {
+  std::unique_ptr<BatchedFileIO> io = CreateBatchedFileIO();
+  if (!io)
+    return;
+
+  constexpr int kReadCount = 500;
+  constexpr int kReadSize = 1000;
+  int completed = 0;
+  RunLoop run_loop;
+  for (int i = 0; i < kReadCount; ++i) {
+    const int64_t offset = (i * 4099) % (contents_.size() - kReadSize);
+    io->Read(offset, kReadSize,
+             BindLambdaForTesting(
+                 [&, offset](File::Error error, const char* data, int size) {
+                   EXPECT_EQ(File::FILE_OK, error);
+                   EXPECT_EQ(contents_.substr(offset, kReadSize),
+                             std::string(data, size));
+                   if (++completed == kReadCount)
+                     run_loop.Quit();
+                 }));
+  }
+  io->Submit();
+  run_loop.Run();
+}
+
+TEST_P(BatchedFileIOTest, ReadPastEnd) {
+  std::unique_ptr<BatchedFileIO> io = CreateBatchedFileIO();
+  if (!io)
+    return;
+
+  RunLoop run_loop;
+  io->Read(contents_.size() - 10, 100,
+           BindLambdaForTesting([&](File::Error error, const char* data,
+                                    int size) {
+             EXPECT_EQ(File::FILE_OK, error);
+             EXPECT_EQ(contents_.substr(contents_.size() - 10),
+                       std::string(data, size));
+             run_loop.Quit();
+           }));
+  io->Submit();
+  run_loop.Run();
+}
+
+TEST_P(BatchedFileIOTest, WriteThenRead) {
+  std::unique_ptr<BatchedFileIO> io = CreateBatchedFileIO();
+  if (!io)
+    return;
+
+  {
+    RunLoop run_loop;
+    io->Write(100, "hello", 5,
+              BindLambdaForTesting([&](File::Error error, int size) {
+                EXPECT_EQ(File::FILE_OK, error);
+                EXPECT_EQ(5, size);
+                run_loop.Quit();
+              }));
+    io->Submit();
+    run_loop.Run();
+  }
+
+  RunLoop run_loop;
+  io->Read(98, 9,
+           BindLambdaForTesting(
+               [&](File::Error error, const char* data, int size) {
+                 EXPECT_EQ(File::FILE_OK, error);
+                 EXPECT_EQ(contents_.substr(98, 2) + "hello" +
+                               contents_.substr(105, 2),
+                           std::string(data, size));
+                 run_loop.Quit();
+               }));
+  io->Submit();
+  run_loop.Run();
+}
+
+// Operations are only passed to the OS by Submit().
+TEST_P(BatchedFileIOTest, NothingRunsBeforeSubmit) {
+  std::unique_ptr<BatchedFileIO> io = CreateBatchedFileIO();
+  if (!io)
+    return;
+
+  bool completed = false;
+  RunLoop run_loop;
+  io->Write(0, "x", 1, BindLambdaForTesting([&](File::Error error, int size) {
+              completed = true;
+              run_loop.Quit();
+            }));
+  scoped_task_environment_.RunUntilIdle();
+  EXPECT_FALSE(completed);
+
+  io->Submit();
+  run_loop.Run();
+  EXPECT_TRUE(completed);
+}
+
+// Deleting a BatchedFileIO with operations in flight doesn't run their
+// callbacks.
+TEST_P(BatchedFileIOTest, DeleteWithOperationsInFlight) {
+  std::unique_ptr<BatchedFileIO> io = CreateBatchedFileIO();
+  if (!io)
+    return;
+
+  for (int i = 0; i < 100; ++i) {
+    io->Read(i * 100, 100,
+             BindOnce([](File::Error error, const char* data, int size) {
+               ADD_FAILURE();
+             }));
+  }
+  io->Submit();
+  io.reset();
+  scoped_task_environment_.RunUntilIdle();
+}
+
+// A callback can delete the BatchedFileIO.
+TEST_P(BatchedFileIOTest, DeleteFromCallback) {
+  std::unique_ptr<BatchedFileIO> io = CreateBatchedFileIO();
+  if (!io)
+    return;
+
+  int completed = 0;
+  RunLoop run_loop;
+  for (int i = 0; i < 10; ++i) {
+    io->Read(i * 100, 100,
+             BindLambdaForTesting(
+                 [&](File::Error error, const char* data, int size) {
+                   ++completed;
+                   io.reset();
+                   run_loop.Quit();
+                 }));
+  }
+  io->Submit();
+  run_loop.Run();
+  scoped_task_environment_.RunUntilIdle();
+  EXPECT_EQ(1, completed);
+}
+
+INSTANTIATE_TEST_SUITE_P(,
+                         BatchedFileIOTest,
+                         testing::Values(Backend::kDefault,
+                                         Backend::kBlocking
+#if defined(OS_LINUX)
+                                         ,
+                                         Backend::kIOUring
+#endif
+                                         ));
+
+}  // namespace base
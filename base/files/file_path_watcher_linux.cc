@@ -315,10 +315,15 @@ void InotifyReader::RemoveWatch(Watch watch, FilePathWatcherImpl* watcher) {
 
   AutoLock auto_lock(lock_);
 
-  watchers_[watch].erase(watcher);
+  auto watchers_it = watchers_.find(watch);
+  if (watchers_it == watchers_.end())
+    return;
+
+  auto& watcher_set = watchers_it->second;
+  watcher_set.erase(watcher);
 
-  if (watchers_[watch].empty()) {
-    watchers_.erase(watch);
+  if (watcher_set.empty()) {
+    watchers_.erase(watchers_it);
 
     ScopedBlockingCall scoped_blocking_call(FROM_HERE,
                                             BlockingType::WILL_BLOCK);
@@ -333,8 +338,13 @@ void InotifyReader::OnInotifyEvent(const inotify_event* event) {
   FilePath::StringType child(event->len ? event->name : FILE_PATH_LITERAL(""));
   AutoLock auto_lock(lock_);
 
-  auto& watcher_set = watchers_[event->wd];
-  for (FilePathWatcherImpl* watcher : watcher_set) {
+  // Events can still arrive for a watch that was just removed. Do not add an
+  // empty entry to |watchers_| for it.
+  auto watchers_it = watchers_.find(event->wd);
+  if (watchers_it == watchers_.end())
+    return;
+
+  for (FilePathWatcherImpl* watcher : watchers_it->second) {
     watcher->OnFilePathChanged(
         event->wd, child, event->mask & (IN_CREATE | IN_MOVED_TO),
         event->mask & (IN_DELETE | IN_MOVED_FROM), event->mask & IN_ISDIR);
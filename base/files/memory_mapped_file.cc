@@ -112,6 +112,28 @@ bool MemoryMappedFile::IsValid() const {
   return data_ != nullptr;
 }
 
+bool MemoryMappedFile::GetRegionBounds(const Region& region,
+                                       uint8_t** start,
+                                       size_t* size) const {
+  if (!IsValid())
+    return false;
+  if (region == Region::kWholeFile) {
+    *start = data_;
+    *size = length_;
+    return true;
+  }
+  CheckedNumeric<size_t> region_end(region.offset);
+  region_end += region.size;
+  if (region.offset < 0 || !region_end.IsValid() ||
+      region_end.ValueOrDie() > length_) {
+    DLOG(ERROR) << "Region isn't within the mapping.";
+    return false;
+  }
+  *start = data_ + region.offset;
+  *size = region.size;
+  return true;
+}
+
 // static
 void MemoryMappedFile::CalculateVMAlignedBoundaries(int64_t start,
                                                     size_t size,
@@ -102,6 +102,40 @@ class BASE_EXPORT MemoryMappedFile {
   // Is file_ a valid file handle that points to an open, memory mapped file?
   bool IsValid() const;
 
+  // How the mapping will be accessed, which lets the OS tune how much and when
+  // it reads ahead of page faults.
+  enum class AccessPattern {
+    // The default: read ahead a little around each fault.
+    kNormal,
+    // Pages are accessed in order: read ahead aggressively, and reclaim pages
+    // soon after they have been accessed.
+    kSequential,
+    // Pages are accessed in no particular order: don't read ahead.
+    kRandom,
+  };
+
+  // Advises the OS that the mapping will be accessed following |pattern|.
+  // Returns false if the OS doesn't support the advice, which is the case on
+  // Windows.
+  bool SetAccessPattern(AccessPattern pattern);
+
+  // Asks the OS to start reading |region| of the mapping, relative to data(),
+  // in the background, so that accessing it later doesn't take a blocking page
+  // fault for every few pages. Region::kWholeFile prefetches the whole mapping.
+  // Returns false if |region| isn't within the mapping or if the OS doesn't
+  // support prefetching (Windows before 8). Uses MADV_WILLNEED on POSIX and
+  // PrefetchVirtualMemory() on Windows.
+  bool Prefetch(const Region& region);
+
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+  // Asks the kernel to back the mapping with transparent huge pages, reducing
+  // the number of page faults and TLB misses. This only has an effect on
+  // kernels that support huge pages in the page cache (e.g. with
+  // CONFIG_READ_ONLY_THP_FOR_FS for read-only mappings). Returns false if the
+  // kernel rejected the advice.
+  bool RequestHugePages();
+#endif
+
  private:
   // Given the arbitrarily aligned memory region [start, size], returns the
   // boundaries of the region aligned to the granularity specified by the OS,
@@ -119,6 +153,12 @@ class BASE_EXPORT MemoryMappedFile {
   // success, false on any kind of failure. This is a helper for Initialize().
   bool MapFileRegionToMemory(const Region& region, Access access);
 
+  // Sets |*start| and |*size| to the bounds in memory of |region| of the
+  // mapping. Returns false if |region| isn't within the mapping.
+  bool GetRegionBounds(const Region& region,
+                       uint8_t** start,
+                       size_t* size) const;
+
   // Closes all open handles.
   void CloseHandles();
 
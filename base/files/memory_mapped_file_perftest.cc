@@ -0,0 +1,154 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/files/memory_mapped_file.h"
+
+#include <fcntl.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+
+#include "base/files/file.h"
+#include "base/files/file_path.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/process/process_metrics.h"
+#include "base/time/time.h"
+#include "build/build_config.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+
+// Page fault counts are only available on Linux and Android.
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+
+namespace {
+
+constexpr size_t kFileSize = 64 * 1024 * 1024;
+
+enum class Hint {
+  kNone,
+  kSequential,
+  kRandom,
+  kPrefetch,
+  kHugePages,
+};
+
+const char* GetHintName(Hint hint) {
+  switch (hint) {
+    case Hint::kNone:
+      return "none";
+    case Hint::kSequential:
+      return "sequential";
+    case Hint::kRandom:
+      return "random";
+    case Hint::kPrefetch:
+      return "prefetch";
+    case Hint::kHugePages:
+      return "huge_pages";
+  }
+  return "";
+}
+
+class MemoryMappedFilePerfTest : public testing::Test {
+ public:
+  void SetUp() override {
+    ASSERT_TRUE(dir_.CreateUniqueTempDir());
+    path_ = dir_.GetPath().AppendASCII("file");
+    File file(path_, File::FLAG_CREATE | File::FLAG_WRITE);
+    ASSERT_TRUE(file.IsValid());
+    std::string chunk(1024 * 1024, 0);
+    for (size_t i = 0; i < chunk.size(); ++i)
+      chunk[i] = static_cast<char>(i);
+    for (size_t offset = 0; offset < kFileSize; offset += chunk.size()) {
+      ASSERT_EQ(static_cast<int>(chunk.size()),
+                file.Write(offset, chunk.data(), chunk.size()));
+    }
+    ASSERT_TRUE(file.Flush());
+  }
+
+  // Maps the file after evicting it from the page cache, applies |hint| and
+  // reads every page, the way startup reads a ruleset or a snapshot. Reports
+  // the time taken and the page faults caused by the reads.
+  void RunTest(Hint hint, bool random_order) {
+    File file(path_, File::FLAG_OPEN | File::FLAG_READ);
+    ASSERT_TRUE(file.IsValid());
+    // The pages are clean after Flush(), so this drops them from the cache.
+    posix_fadvise(file.GetPlatformFile(), 0, 0, POSIX_FADV_DONTNEED);
+
+    MemoryMappedFile map;
+    ASSERT_TRUE(map.Initialize(std::move(file)));
+    std::unique_ptr<ProcessMetrics> metrics =
+        ProcessMetrics::CreateCurrentProcessMetrics();
+    PageFaultCounts before;
+    ASSERT_TRUE(metrics->GetPageFaultCounts(&before));
+
+    TimeTicks begin = TimeTicks::Now();
+    switch (hint) {
+      case Hint::kNone:
+        break;
+      case Hint::kSequential:
+        map.SetAccessPattern(MemoryMappedFile::AccessPattern::kSequential);
+        break;
+      case Hint::kRandom:
+        map.SetAccessPattern(MemoryMappedFile::AccessPattern::kRandom);
+        break;
+      case Hint::kPrefetch:
+        map.Prefetch(MemoryMappedFile::Region::kWholeFile);
+        break;
+      case Hint::kHugePages:
+        map.RequestHugePages();
+        break;
+    }
+
+    const size_t page_size = GetPageSize();
+    const size_t page_count = map.length() / page_size;
+    uint32_t sum = 0;
+    for (size_t i = 0; i < page_count; ++i) {
+      // 4099 is coprime with the page count, so this visits every page.
+      const size_t page = random_order ? (i * 4099) % page_count : i;
+      sum += map.data()[page * page_size];
+    }
+    TimeDelta elapsed = TimeTicks::Now() - begin;
+
+    PageFaultCounts after;
+    ASSERT_TRUE(metrics->GetPageFaultCounts(&after));
+    EXPECT_EQ(0u, sum);
+
+    const std::string story = std::string(random_order ? "random_" : "") +
+                              "hint_" + GetHintName(hint);
+    perf_test::PrintResult("MemoryMappedFile_Read", "", story,
+                           elapsed.InMillisecondsF(), "ms", true);
+    perf_test::PrintResult("MemoryMappedFile_MinorFaults", "", story,
+                           static_cast<size_t>(after.minor - before.minor),
+                           "faults", true);
+    perf_test::PrintResult("MemoryMappedFile_MajorFaults", "", story,
+                           static_cast<size_t>(after.major - before.major),
+                           "faults", true);
+  }
+
+ private:
+  ScopedTempDir dir_;
+  FilePath path_;
+};
+
+}  // namespace
+
+TEST_F(MemoryMappedFilePerfTest, SequentialRead) {
+  for (Hint hint : {Hint::kNone, Hint::kSequential, Hint::kPrefetch,
+                    Hint::kHugePages}) {
+    RunTest(hint, false);
+  }
+}
+
+TEST_F(MemoryMappedFilePerfTest, RandomRead) {
+  for (Hint hint : {Hint::kNone, Hint::kRandom, Hint::kPrefetch})
+    RunTest(hint, true);
+}
+
+#endif  // defined(OS_LINUX) || defined(OS_ANDROID)
+
+}  // namespace base
@@ -13,6 +13,7 @@
 
 #include "base/logging.h"
 #include "base/numerics/safe_conversions.h"
+#include "base/process/process_metrics.h"
 #include "base/threading/scoped_blocking_call.h"
 #include "build/build_config.h"
 
@@ -22,6 +23,27 @@
 
 namespace base {
 
+#if !defined(OS_NACL)
+namespace {
+
+// Calls madvise() on the pages containing [start, start + size), which are all
+// part of the mapping since it starts on a page boundary.
+bool AdvisePages(uint8_t* start, size_t size, int advice) {
+  const uintptr_t page_mask = GetPageSize() - 1;
+  const uintptr_t aligned_start =
+      reinterpret_cast<uintptr_t>(start) & ~page_mask;
+  const size_t aligned_size =
+      reinterpret_cast<uintptr_t>(start) + size - aligned_start;
+  if (madvise(reinterpret_cast<void*>(aligned_start), aligned_size, advice)) {
+    DPLOG(ERROR) << "madvise";
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+#endif  // !defined(OS_NACL)
+
 MemoryMappedFile::MemoryMappedFile() : data_(nullptr), length_(0) {}
 
 #if !defined(OS_NACL)
@@ -171,6 +193,56 @@ bool MemoryMappedFile::MapFileRegionToMemory(
 }
 #endif
 
+bool MemoryMappedFile::SetAccessPattern(AccessPattern pattern) {
+#if defined(OS_NACL)
+  return false;
+#else
+  uint8_t* start;
+  size_t size;
+  if (!GetRegionBounds(Region::kWholeFile, &start, &size))
+    return false;
+  int advice = MADV_NORMAL;
+  switch (pattern) {
+    case AccessPattern::kNormal:
+      advice = MADV_NORMAL;
+      break;
+    case AccessPattern::kSequential:
+      advice = MADV_SEQUENTIAL;
+      break;
+    case AccessPattern::kRandom:
+      advice = MADV_RANDOM;
+      break;
+  }
+  return AdvisePages(start, size, advice);
+#endif
+}
+
+bool MemoryMappedFile::Prefetch(const Region& region) {
+#if defined(OS_NACL)
+  return false;
+#else
+  uint8_t* start;
+  size_t size;
+  if (!GetRegionBounds(region, &start, &size))
+    return false;
+  return AdvisePages(start, size, MADV_WILLNEED);
+#endif
+}
+
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+bool MemoryMappedFile::RequestHugePages() {
+#if defined(MADV_HUGEPAGE)
+  uint8_t* start;
+  size_t size;
+  if (!GetRegionBounds(Region::kWholeFile, &start, &size))
+    return false;
+  return AdvisePages(start, size, MADV_HUGEPAGE);
+#else
+  return false;
+#endif
+}
+#endif  // defined(OS_LINUX) || defined(OS_ANDROID)
+
 void MemoryMappedFile::CloseHandles() {
   ScopedBlockingCall scoped_blocking_call(FROM_HERE, BlockingType::MAY_BLOCK);
 
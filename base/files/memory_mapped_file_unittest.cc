@@ -11,6 +11,7 @@
 
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
+#include "build/build_config.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "testing/platform_test.h"
 
@@ -240,6 +241,68 @@ TEST_F(MemoryMappedFileTest, ExtendableFile) {
   EXPECT_EQ("BAZ", contents.substr(kFileSize, 3));
 }
 
+TEST_F(MemoryMappedFileTest, Prefetch) {
+  const size_t kFileSize = 157 * 1024;
+  const size_t kOffset = 1024 * 5 + 32;
+  const size_t kPartialSize = 16 * 1024 - 32;
+
+  CreateTemporaryTestFile(kFileSize);
+  MemoryMappedFile map;
+  File file(temp_file_path(), File::FLAG_OPEN | File::FLAG_READ);
+  MemoryMappedFile::Region region = {kOffset, kPartialSize};
+  ASSERT_TRUE(map.Initialize(std::move(file), region));
+
+#if defined(OS_WIN)
+  // PrefetchVirtualMemory() may not be available.
+  map.Prefetch(MemoryMappedFile::Region::kWholeFile);
+#else
+  EXPECT_TRUE(map.Prefetch(MemoryMappedFile::Region::kWholeFile));
+  EXPECT_TRUE(map.Prefetch({0, kPartialSize}));
+  EXPECT_TRUE(map.Prefetch({100, 1000}));
+  EXPECT_TRUE(map.Prefetch({kPartialSize - 1, 1}));
+#endif
+
+  // Regions are relative to the mapping, and must be within it.
+  EXPECT_FALSE(map.Prefetch({0, kPartialSize + 1}));
+  EXPECT_FALSE(map.Prefetch({-1, 10}));
+  EXPECT_FALSE(map.Prefetch({kPartialSize, 1}));
+
+  ASSERT_TRUE(CheckBufferContents(map.data(), kPartialSize, kOffset));
+}
+
+TEST_F(MemoryMappedFileTest, SetAccessPattern) {
+  const size_t kFileSize = 68 * 1024;
+  CreateTemporaryTestFile(kFileSize);
+  MemoryMappedFile map;
+  ASSERT_TRUE(map.Initialize(temp_file_path()));
+
+  for (MemoryMappedFile::AccessPattern pattern :
+       {MemoryMappedFile::AccessPattern::kSequential,
+        MemoryMappedFile::AccessPattern::kRandom,
+        MemoryMappedFile::AccessPattern::kNormal}) {
+#if defined(OS_WIN)
+    EXPECT_FALSE(map.SetAccessPattern(pattern));
+#else
+    EXPECT_TRUE(map.SetAccessPattern(pattern));
+#endif
+    ASSERT_TRUE(CheckBufferContents(map.data(), kFileSize, 0));
+  }
+
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+  // Whether huge pages are supported depends on the kernel, but the mapping
+  // must remain usable either way.
+  map.RequestHugePages();
+  ASSERT_TRUE(CheckBufferContents(map.data(), kFileSize, 0));
+#endif
+}
+
+TEST_F(MemoryMappedFileTest, HintsOnInvalidMapping) {
+  MemoryMappedFile map;
+  EXPECT_FALSE(map.Prefetch(MemoryMappedFile::Region::kWholeFile));
+  EXPECT_FALSE(
+      map.SetAccessPattern(MemoryMappedFile::AccessPattern::kSequential));
+}
+
 }  // namespace
 
 }  // namespace base
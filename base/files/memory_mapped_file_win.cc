@@ -10,6 +10,7 @@
 #include <limits>
 
 #include "base/files/file_path.h"
+#include "base/logging.h"
 #include "base/strings/string16.h"
 #include "base/threading/scoped_blocking_call.h"
 
@@ -94,6 +95,33 @@ bool MemoryMappedFile::MapFileRegionToMemory(
   return true;
 }
 
+bool MemoryMappedFile::SetAccessPattern(AccessPattern pattern) {
+  // Windows has no equivalent of madvise() for mapped views.
+  return false;
+}
+
+bool MemoryMappedFile::Prefetch(const Region& region) {
+  uint8_t* start;
+  size_t size;
+  if (!GetRegionBounds(region, &start, &size))
+    return false;
+
+  // PrefetchVirtualMemory() is only available on Windows 8 and later.
+  using PrefetchVirtualMemoryFunction = decltype(&::PrefetchVirtualMemory);
+  static const PrefetchVirtualMemoryFunction prefetch_virtual_memory =
+      reinterpret_cast<PrefetchVirtualMemoryFunction>(::GetProcAddress(
+          ::GetModuleHandle(L"kernel32.dll"), "PrefetchVirtualMemory"));
+  if (!prefetch_virtual_memory)
+    return false;
+
+  WIN32_MEMORY_RANGE_ENTRY range = {start, size};
+  if (!prefetch_virtual_memory(::GetCurrentProcess(), 1, &range, 0)) {
+    DPLOG(ERROR) << "PrefetchVirtualMemory";
+    return false;
+  }
+  return true;
+}
+
 void MemoryMappedFile::CloseHandles() {
   if (data_)
     ::UnmapViewOfFile(data_);
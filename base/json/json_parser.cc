@@ -8,6 +8,7 @@
 #include <utility>
 #include <vector>
 
+#include "base/bits.h"
 #include "base/logging.h"
 #include "base/macros.h"
 #include "base/numerics/safe_conversions.h"
@@ -20,6 +21,12 @@
 #include "base/third_party/icu/icu_utf.h"
 #include "base/values.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace base {
 namespace internal {
 
@@ -50,6 +57,58 @@ class StackMarker {
 
 constexpr uint32_t kUnicodeReplacementPoint = 0xFFFD;
 
+// Returns true if |c| can be copied verbatim into a string: it is ASCII and is
+// neither the string terminator nor the start of an escape sequence.
+inline bool IsPlainStringChar(char c) {
+  return static_cast<unsigned char>(c) < kExtendedASCIIStart && c != '"' &&
+         c != '\\';
+}
+
+// Returns the length of the longest prefix of |input| made only of characters
+// for which IsPlainStringChar() is true. Scans 16 bytes at a time where SIMD
+// is available.
+size_t CountPlainStringChars(StringPiece input) {
+  const char* const begin = input.data();
+  const size_t length = input.length();
+  size_t i = 0;
+
+#if defined(__SSE2__)
+  const __m128i quote = _mm_set1_epi8('"');
+  const __m128i backslash = _mm_set1_epi8('\\');
+  for (; i + 16 <= length; i += 16) {
+    const __m128i chunk =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin + i));
+    const __m128i special = _mm_or_si128(_mm_cmpeq_epi8(chunk, quote),
+                                          _mm_cmpeq_epi8(chunk, backslash));
+    // The sign bit of each byte is set for non-ASCII characters.
+    const uint32_t mask = static_cast<uint32_t>(
+        _mm_movemask_epi8(_mm_or_si128(special, chunk)));
+    if (mask)
+      return i + bits::CountTrailingZeroBits(mask);
+  }
+#elif defined(__ARM_NEON)
+  const uint8x16_t quote = vdupq_n_u8('"');
+  const uint8x16_t backslash = vdupq_n_u8('\\');
+  const uint8x16_t extended_ascii_start = vdupq_n_u8(kExtendedASCIIStart);
+  for (; i + 16 <= length; i += 16) {
+    const uint8x16_t chunk =
+        vld1q_u8(reinterpret_cast<const uint8_t*>(begin + i));
+    const uint8x16_t special =
+        vorrq_u8(vorrq_u8(vceqq_u8(chunk, quote), vceqq_u8(chunk, backslash)),
+                 vcgeq_u8(chunk, extended_ascii_start));
+    // Reduce to 64 bits to test whether any lane matched. The exact position
+    // is found by the scalar loop below.
+    const uint64x2_t special64 = vreinterpretq_u64_u8(special);
+    if (vgetq_lane_u64(special64, 0) | vgetq_lane_u64(special64, 1))
+      break;
+  }
+#endif
+
+  while (i < length && IsPlainStringChar(begin[i]))
+    ++i;
+  return i;
+}
+
 }  // namespace
 
 // This is U+FFFD.
@@ -71,41 +130,24 @@ JSONParser::JSONParser(int options, int max_depth)
 JSONParser::~JSONParser() = default;
 
 Optional<Value> JSONParser::Parse(StringPiece input) {
-  input_ = input;
-  index_ = 0;
-  line_number_ = 1;
-  index_last_line_ = 0;
-
-  error_code_ = JSONReader::JSON_NO_ERROR;
-  error_line_ = 0;
-  error_column_ = 0;
-
-  // ICU and ReadUnicodeCharacter() use int32_t for lengths, so ensure
-  // that the index_ will not overflow when parsing.
-  if (!base::IsValueInRangeForNumericType<int32_t>(input.length())) {
-    ReportError(JSONReader::JSON_TOO_LARGE, 0);
+  if (!BeginParse(input))
     return nullopt;
-  }
-
-  // When the input JSON string starts with a UTF-8 Byte-Order-Mark,
-  // advance the start position to avoid the ParseNextToken function mis-
-  // treating a Unicode BOM as an invalid character and returning NULL.
-  ConsumeIfMatch("\xEF\xBB\xBF");
 
   // Parse the first and any nested tokens.
   Optional<Value> root(ParseNextToken());
-  if (!root)
-    return nullopt;
-
-  // Make sure the input stream is at an end.
-  if (GetNextToken() != T_END_OF_INPUT) {
-    ReportError(JSONReader::JSON_UNEXPECTED_DATA_AFTER_ROOT, 1);
+  if (!root || !EndParse())
     return nullopt;
-  }
 
   return root;
 }
 
+bool JSONParser::ParseWithHandler(StringPiece input,
+                                  JSONReader::Handler* handler) {
+  DCHECK(handler);
+  return BeginParse(input) && ParseNextTokenWithHandler(handler) &&
+         EndParse();
+}
+
 JSONReader::JsonParseError JSONParser::error_code() const {
   return error_code_;
 }
@@ -151,6 +193,15 @@ void JSONParser::StringBuilder::Append(uint32_t point) {
   }
 }
 
+void JSONParser::StringBuilder::AppendASCII(StringPiece chars) {
+  if (!string_) {
+    DCHECK_EQ(chars.data(), pos_ + length_);
+    length_ += chars.length();
+  } else {
+    string_->append(chars.data(), chars.length());
+  }
+}
+
 void JSONParser::StringBuilder::Convert() {
   if (string_)
     return;
@@ -163,8 +214,47 @@ std::string JSONParser::StringBuilder::DestructiveAsString() {
   return std::string(pos_, length_);
 }
 
+StringPiece JSONParser::StringBuilder::AsStringPiece() const {
+  if (string_)
+    return *string_;
+  return StringPiece(pos_, length_);
+}
+
 // JSONParser private //////////////////////////////////////////////////////////
 
+bool JSONParser::BeginParse(StringPiece input) {
+  input_ = input;
+  index_ = 0;
+  line_number_ = 1;
+  index_last_line_ = 0;
+
+  error_code_ = JSONReader::JSON_NO_ERROR;
+  error_line_ = 0;
+  error_column_ = 0;
+
+  // ICU and ReadUnicodeCharacter() use int32_t for lengths, so ensure
+  // that the index_ will not overflow when parsing.
+  if (!base::IsValueInRangeForNumericType<int32_t>(input.length())) {
+    ReportError(JSONReader::JSON_TOO_LARGE, 0);
+    return false;
+  }
+
+  // When the input JSON string starts with a UTF-8 Byte-Order-Mark,
+  // advance the start position to avoid the ParseNextToken function mis-
+  // treating a Unicode BOM as an invalid character and returning NULL.
+  ConsumeIfMatch("\xEF\xBB\xBF");
+  return true;
+}
+
+bool JSONParser::EndParse() {
+  // Make sure the input stream is at an end.
+  if (GetNextToken() != T_END_OF_INPUT) {
+    ReportError(JSONReader::JSON_UNEXPECTED_DATA_AFTER_ROOT, 1);
+    return false;
+  }
+  return true;
+}
+
 Optional<StringPiece> JSONParser::PeekChars(size_t count) {
   if (index_ + count > input_.length())
     return nullopt;
@@ -386,6 +476,9 @@ Optional<Value> JSONParser::ConsumeDictionary() {
 
   ConsumeChar();  // Closing '}'.
 
+  // Parsed documents are mostly read, rarely grown. Drop the capacity left by
+  // geometric growth, which can reach half of the storage.
+  dict_storage.shrink_to_fit();
   return Value(Value::DictStorage(std::move(dict_storage), KEEP_LAST_OF_DUPES));
 }
 
@@ -429,9 +522,141 @@ Optional<Value> JSONParser::ConsumeList() {
 
   ConsumeChar();  // Closing ']'.
 
+  // See ConsumeDictionary().
+  list_storage.shrink_to_fit();
   return Value(std::move(list_storage));
 }
 
+bool JSONParser::ParseNextTokenWithHandler(JSONReader::Handler* handler) {
+  return ParseTokenWithHandler(GetNextToken(), handler);
+}
+
+bool JSONParser::ParseTokenWithHandler(Token token,
+                                       JSONReader::Handler* handler) {
+  Optional<Value> scalar;
+  switch (token) {
+    case T_OBJECT_BEGIN:
+      return ConsumeDictionaryWithHandler(handler);
+    case T_ARRAY_BEGIN:
+      return ConsumeListWithHandler(handler);
+    case T_STRING:
+      scalar = ConsumeString();
+      break;
+    case T_NUMBER:
+      scalar = ConsumeNumber();
+      break;
+    case T_BOOL_TRUE:
+    case T_BOOL_FALSE:
+    case T_NULL:
+      scalar = ConsumeLiteral();
+      break;
+    default:
+      ReportError(JSONReader::JSON_UNEXPECTED_TOKEN, 1);
+      return false;
+  }
+
+  if (!scalar)
+    return false;
+  handler->OnScalar(std::move(*scalar));
+  return true;
+}
+
+// Mirrors ConsumeDictionary(), including the error positions.
+bool JSONParser::ConsumeDictionaryWithHandler(JSONReader::Handler* handler) {
+  if (ConsumeChar() != '{') {
+    ReportError(JSONReader::JSON_UNEXPECTED_TOKEN, 1);
+    return false;
+  }
+
+  StackMarker depth_check(max_depth_, &stack_depth_);
+  if (depth_check.IsTooDeep()) {
+    ReportError(JSONReader::JSON_TOO_MUCH_NESTING, 0);
+    return false;
+  }
+
+  handler->OnDictionaryBegin();
+
+  Token token = GetNextToken();
+  while (token != T_OBJECT_END) {
+    if (token != T_STRING) {
+      ReportError(JSONReader::JSON_UNQUOTED_DICTIONARY_KEY, 1);
+      return false;
+    }
+
+    StringBuilder key;
+    if (!ConsumeStringRaw(&key))
+      return false;
+
+    token = GetNextToken();
+    if (token != T_OBJECT_PAIR_SEPARATOR) {
+      ReportError(JSONReader::JSON_SYNTAX_ERROR, 1);
+      return false;
+    }
+
+    handler->OnDictionaryKey(key.AsStringPiece());
+
+    ConsumeChar();
+    if (!ParseNextTokenWithHandler(handler))
+      return false;
+
+    token = GetNextToken();
+    if (token == T_LIST_SEPARATOR) {
+      ConsumeChar();
+      token = GetNextToken();
+      if (token == T_OBJECT_END && !(options_ & JSON_ALLOW_TRAILING_COMMAS)) {
+        ReportError(JSONReader::JSON_TRAILING_COMMA, 1);
+        return false;
+      }
+    } else if (token != T_OBJECT_END) {
+      ReportError(JSONReader::JSON_SYNTAX_ERROR, 0);
+      return false;
+    }
+  }
+
+  ConsumeChar();  // Closing '}'.
+  handler->OnDictionaryEnd();
+  return true;
+}
+
+// Mirrors ConsumeList(), including the error positions.
+bool JSONParser::ConsumeListWithHandler(JSONReader::Handler* handler) {
+  if (ConsumeChar() != '[') {
+    ReportError(JSONReader::JSON_UNEXPECTED_TOKEN, 1);
+    return false;
+  }
+
+  StackMarker depth_check(max_depth_, &stack_depth_);
+  if (depth_check.IsTooDeep()) {
+    ReportError(JSONReader::JSON_TOO_MUCH_NESTING, 0);
+    return false;
+  }
+
+  handler->OnListBegin();
+
+  Token token = GetNextToken();
+  while (token != T_ARRAY_END) {
+    if (!ParseTokenWithHandler(token, handler))
+      return false;
+
+    token = GetNextToken();
+    if (token == T_LIST_SEPARATOR) {
+      ConsumeChar();
+      token = GetNextToken();
+      if (token == T_ARRAY_END && !(options_ & JSON_ALLOW_TRAILING_COMMAS)) {
+        ReportError(JSONReader::JSON_TRAILING_COMMA, 1);
+        return false;
+      }
+    } else if (token != T_ARRAY_END) {
+      ReportError(JSONReader::JSON_SYNTAX_ERROR, 1);
+      return false;
+    }
+  }
+
+  ConsumeChar();  // Closing ']'.
+  handler->OnListEnd();
+  return true;
+}
+
 Optional<Value> JSONParser::ConsumeString() {
   StringBuilder string;
   if (!ConsumeStringRaw(&string))
@@ -452,6 +677,17 @@ bool JSONParser::ConsumeStringRaw(StringBuilder* out) {
   StringBuilder string(pos());
 
   while (PeekChar()) {
+    // Copy runs of characters which need no decoding in bulk. This produces
+    // the same result as appending them one at a time below.
+    const StringPiece remaining_input(input_.data() + index_,
+                                      input_.length() - index_);
+    const size_t plain_length = CountPlainStringChars(remaining_input);
+    if (plain_length) {
+      string.AppendASCII(remaining_input.substr(0, plain_length));
+      index_ += static_cast<int>(plain_length);
+      continue;
+    }
+
     uint32_t next_char = 0;
     if (!ReadUnicodeCharacter(input_.data(),
                               static_cast<int32_t>(input_.length()),
@@ -52,6 +52,10 @@ class BASE_EXPORT JSONParser {
   // convert to a FooValue at the same time.
   Optional<Value> Parse(StringPiece input);
 
+  // Parses the input string according to the set options and reports its
+  // contents to |handler|. Returns false on error.
+  bool ParseWithHandler(StringPiece input, JSONReader::Handler* handler);
+
   // Returns the error code.
   JSONReader::JsonParseError error_code() const;
 
@@ -105,6 +109,10 @@ class BASE_EXPORT JSONParser {
     // converted, or by appending the UTF8 bytes for the code point.
     void Append(uint32_t point);
 
+    // Appends |chars|, which must be ASCII and, unless the builder has been
+    // converted, start right after the characters already appended.
+    void AppendASCII(StringPiece chars);
+
     // Converts the builder from its default StringPiece to a full std::string,
     // performing a copy. Once a builder is converted, it cannot be made a
     // StringPiece again.
@@ -115,6 +123,10 @@ class BASE_EXPORT JSONParser {
     // in cases where the builder will not be needed any more.
     std::string DestructiveAsString();
 
+    // Returns a view of the string built so far, valid until the builder is
+    // modified.
+    StringPiece AsStringPiece() const;
+
    private:
     // The beginning of the input string.
     const char* pos_;
@@ -144,6 +156,14 @@ class BASE_EXPORT JSONParser {
   // Returns a pointer to the current character position.
   const char* pos();
 
+  // Resets the parser state to read |input|, and skips a leading Byte-Order
+  // Mark. Returns false if |input| is too large.
+  bool BeginParse(StringPiece input);
+
+  // Returns true if the whole input has been consumed, and reports an error
+  // otherwise.
+  bool EndParse();
+
   // Skips over whitespace and comments to find the next token in the stream.
   // This does not advance the parser for non-whitespace or comment chars.
   Token GetNextToken();
@@ -170,6 +190,14 @@ class BASE_EXPORT JSONParser {
   // Value.
   Optional<Value> ConsumeList();
 
+  // Counterparts of ParseNextToken(), ParseToken(), ConsumeDictionary() and
+  // ConsumeList() which report the contents of the value to |handler|
+  // instead of returning it. Return false on error.
+  bool ParseNextTokenWithHandler(JSONReader::Handler* handler);
+  bool ParseTokenWithHandler(Token token, JSONReader::Handler* handler);
+  bool ConsumeDictionaryWithHandler(JSONReader::Handler* handler);
+  bool ConsumeListWithHandler(JSONReader::Handler* handler);
+
   // Calls through ConsumeStringRaw and wraps it in a value.
   Optional<Value> ConsumeString();
 
@@ -242,6 +270,7 @@ class BASE_EXPORT JSONParser {
   FRIEND_TEST_ALL_PREFIXES(JSONParserTest, ConsumeDictionary);
   FRIEND_TEST_ALL_PREFIXES(JSONParserTest, ConsumeList);
   FRIEND_TEST_ALL_PREFIXES(JSONParserTest, ConsumeString);
+  FRIEND_TEST_ALL_PREFIXES(JSONParserTest, ConsumeLongStrings);
   FRIEND_TEST_ALL_PREFIXES(JSONParserTest, ConsumeLiterals);
   FRIEND_TEST_ALL_PREFIXES(JSONParserTest, ConsumeNumbers);
   FRIEND_TEST_ALL_PREFIXES(JSONParserTest, ErrorMessages);
@@ -78,6 +78,37 @@ TEST_F(JSONParserTest, ConsumeString) {
   EXPECT_EQ("test", str);
 }
 
+// Strings longer than a SIMD block, with the special characters at every
+// offset within a block.
+TEST_F(JSONParserTest, ConsumeLongStrings) {
+  for (size_t prefix_length = 0; prefix_length < 40; ++prefix_length) {
+    const std::string prefix(prefix_length, 'a');
+    const std::string suffix(20, 'z');
+    const struct {
+      std::string input;
+      std::string expected;
+    } kCases[] = {
+        {prefix, prefix},
+        {prefix + "\\n" + suffix, prefix + "\n" + suffix},
+        {prefix + "\xC3\xA9" + suffix, prefix + "\xC3\xA9" + suffix},
+        {prefix + "\\u00e9" + suffix + "\\\"" + suffix,
+         prefix + "\xC3\xA9" + suffix + "\"" + suffix},
+    };
+    for (const auto& test_case : kCases) {
+      std::string input = "\"" + test_case.input + "\",|";
+      std::unique_ptr<JSONParser> parser(NewTestParser(input));
+      Optional<Value> value(parser->ConsumeString());
+      EXPECT_EQ(',', *parser->pos());
+      TestLastThree(parser.get());
+
+      ASSERT_TRUE(value);
+      std::string str;
+      EXPECT_TRUE(value->GetAsString(&str));
+      EXPECT_EQ(test_case.expected, str);
+    }
+  }
+}
+
 TEST_F(JSONParserTest, ConsumeList) {
   std::string input("[true, false],|");
   std::unique_ptr<JSONParser> parser(NewTestParser(input));
@@ -5,6 +5,7 @@
 #include "base/json/json_reader.h"
 #include "base/json/json_writer.h"
 #include "base/memory/ptr_util.h"
+#include "base/test/scoped_task_environment.h"
 #include "base/time/time.h"
 #include "base/values.h"
 #include "build/build_config.h"
@@ -48,6 +49,48 @@ std::unique_ptr<DictionaryValue> GenerateLayeredDict(int breadth, int depth) {
   return root;
 }
 
+// Generates a pretty-printed dictionary of |count| entries whose values are
+// strings of |string_length| characters, with an escape sequence in one of
+// every |escape_period| strings (or none if it is 0).
+std::string GenerateStringHeavyJSON(int count,
+                                    int string_length,
+                                    int escape_period) {
+  std::string json = "{\n";
+  for (int i = 0; i < count; ++i) {
+    json += "  \"key" + std::to_string(i) + "\": \"";
+    json += std::string(string_length, 'x');
+    if (escape_period && i % escape_period == 0)
+      json += "\\n\\u00e9";
+    json += i + 1 < count ? "\",\n" : "\"\n";
+  }
+  json += "}";
+  return json;
+}
+
+// Generates a list of |count| numbers.
+std::string GenerateNumberListJSON(int count) {
+  std::string json = "[";
+  for (int i = 0; i < count; ++i) {
+    json += std::to_string(i * 31) + "." + std::to_string(i % 97);
+    if (i + 1 < count)
+      json += ",";
+  }
+  json += "]";
+  return json;
+}
+
+void TestRead(const std::string& description, const std::string& json) {
+  TimeTicks start_read = TimeTicks::Now();
+  EXPECT_TRUE(JSONReader::Read(json));
+  TimeTicks end_read = TimeTicks::Now();
+  perf_test::PrintResult("Read", "", description,
+                         (end_read - start_read).InMillisecondsF(), "ms",
+                         true);
+  perf_test::PrintResult(
+      "ReadThroughput", "", description,
+      json.size() / (end_read - start_read).InMicrosecondsF(), "MB/s", true);
+}
+
 }  // namespace
 
 class JSONPerfTest : public testing::Test {
@@ -88,4 +131,36 @@ TEST_F(JSONPerfTest, MAYBE_StressTest) {
   }
 }
 
+TEST_F(JSONPerfTest, ReadDocumentShapes) {
+  TestRead("Short strings", GenerateStringHeavyJSON(100000, 8, 0));
+  TestRead("Long strings", GenerateStringHeavyJSON(10000, 1000, 0));
+  TestRead("Long strings with escapes",
+           GenerateStringHeavyJSON(10000, 1000, 10));
+  TestRead("Numbers", GenerateNumberListJSON(500000));
+}
+
+// Serializes a dictionary of more than 10MB with and without
+// JSONWriter::OPTIONS_PARALLEL_SERIALIZATION.
+TEST_F(JSONPerfTest, WriteLargeDictionary) {
+  test::ScopedTaskEnvironment scoped_task_environment;
+
+  auto dict = std::make_unique<DictionaryValue>();
+  for (int i = 0; i < 48; ++i)
+    dict->Set("Subtree" + std::to_string(i), GenerateLayeredDict(3, 8));
+
+  for (int options : {0, static_cast<int>(
+                             JSONWriter::OPTIONS_PARALLEL_SERIALIZATION)}) {
+    const std::string description =
+        options ? "Parallel, 48 subtrees" : "Serial, 48 subtrees";
+    std::string json;
+    TimeTicks start_write = TimeTicks::Now();
+    EXPECT_TRUE(JSONWriter::WriteWithOptions(*dict, options, &json));
+    TimeTicks end_write = TimeTicks::Now();
+    EXPECT_GT(json.size(), 10u * 1024 * 1024);
+    perf_test::PrintResult("Write", "", description,
+                           (end_write - start_write).InMillisecondsF(), "ms",
+                           true);
+  }
+}
+
 }  // namespace base
@@ -49,6 +49,8 @@ JSONReader::ValueWithError::~ValueWithError() = default;
 JSONReader::ValueWithError& JSONReader::ValueWithError::operator=(
     ValueWithError&& other) = default;
 
+JSONReader::Handler::~Handler() = default;
+
 JSONReader::JSONReader(int options, int max_depth)
     : parser_(new internal::JSONParser(options, max_depth)) {}
 
@@ -145,6 +147,10 @@ std::unique_ptr<Value> JSONReader::ReadToValueDeprecated(StringPiece json) {
   return value ? std::make_unique<Value>(std::move(*value)) : nullptr;
 }
 
+bool JSONReader::ReadWithHandler(StringPiece json, Handler* handler) {
+  return parser_->ParseWithHandler(json, handler);
+}
+
 JSONReader::JsonParseError JSONReader::error_code() const {
   return parser_->error_code();
 }
@@ -104,6 +104,26 @@ class BASE_EXPORT JSONReader {
   static const char kUnquotedDictionaryKey[];
   static const char kInputTooLarge[];
 
+  // Receives the contents of a JSON document from ReadWithHandler() as a
+  // sequence of events in document order, without a Value tree being built.
+  // Unlike Read(), duplicate dictionary keys are all reported.
+  class BASE_EXPORT Handler {
+   public:
+    virtual ~Handler();
+
+    virtual void OnDictionaryBegin() = 0;
+    // Called before the value of each dictionary entry. |key| is only valid
+    // for the duration of the call.
+    virtual void OnDictionaryKey(StringPiece key) = 0;
+    virtual void OnDictionaryEnd() = 0;
+
+    virtual void OnListBegin() = 0;
+    virtual void OnListEnd() = 0;
+
+    // Called for strings, numbers, booleans and null.
+    virtual void OnScalar(Value value) = 0;
+  };
+
   // Constructs a reader.
   JSONReader(int options = JSON_PARSE_RFC, int max_depth = kStackMaxDepth);
 
@@ -154,8 +174,14 @@ class BASE_EXPORT JSONReader {
   // Non-static version of Read() above.
   std::unique_ptr<Value> ReadToValueDeprecated(StringPiece json);
 
-  // Returns the error code if the last call to ReadToValue() failed.
-  // Returns JSON_NO_ERROR otherwise.
+  // Parses |json| like ReadToValue(), but reports its contents to |handler|
+  // instead of building a Value. Returns false if |json| is not a properly
+  // formed JSON string, in which case |handler| may already have received the
+  // events preceding the error.
+  bool ReadWithHandler(StringPiece json, Handler* handler);
+
+  // Returns the error code if the last call to ReadToValue() or
+  // ReadWithHandler() failed. Returns JSON_NO_ERROR otherwise.
   JsonParseError error_code() const;
 
   // Converts error_code_ to a human-readable string, including line and column
@@ -6,11 +6,13 @@
 
 #include <stddef.h>
 
+#include <string>
 #include <utility>
 
 #include "base/base_paths.h"
 #include "base/files/file_util.h"
 #include "base/logging.h"
+#include "base/macros.h"
 #include "base/path_service.h"
 #include "base/stl_util.h"
 #include "base/strings/string_piece.h"
@@ -21,6 +23,55 @@
 
 namespace base {
 
+namespace {
+
+// Records the events received from JSONReader::ReadWithHandler() as a string.
+class RecordingHandler : public JSONReader::Handler {
+ public:
+  RecordingHandler() = default;
+  ~RecordingHandler() override = default;
+
+  // JSONReader::Handler:
+  void OnDictionaryBegin() override { events_ += "{"; }
+  void OnDictionaryKey(StringPiece key) override {
+    events_ += key.as_string() + ":";
+  }
+  void OnDictionaryEnd() override { events_ += "}"; }
+  void OnListBegin() override { events_ += "["; }
+  void OnListEnd() override { events_ += "]"; }
+  void OnScalar(Value value) override {
+    switch (value.type()) {
+      case Value::Type::NONE:
+        events_ += "null";
+        break;
+      case Value::Type::BOOLEAN:
+        events_ += value.GetBool() ? "true" : "false";
+        break;
+      case Value::Type::INTEGER:
+        events_ += "i" + std::to_string(value.GetInt());
+        break;
+      case Value::Type::DOUBLE:
+        events_ += "d" + std::to_string(value.GetDouble());
+        break;
+      case Value::Type::STRING:
+        events_ += "'" + value.GetString() + "'";
+        break;
+      default:
+        ADD_FAILURE() << "Unexpected scalar type " << value.type();
+    }
+    events_ += ",";
+  }
+
+  const std::string& events() const { return events_; }
+
+ private:
+  std::string events_;
+
+  DISALLOW_COPY_AND_ASSIGN(RecordingHandler);
+};
+
+}  // namespace
+
 TEST(JSONReaderTest, Whitespace) {
   Optional<Value> root = JSONReader::Read("   null   ");
   ASSERT_TRUE(root);
@@ -666,6 +717,49 @@ TEST(JSONReaderTest, IllegalTrailingNull) {
   EXPECT_EQ(JSONReader::JSON_UNEXPECTED_DATA_AFTER_ROOT, reader.error_code());
 }
 
+TEST(JSONReaderTest, ReadWithHandler) {
+  JSONReader reader;
+  RecordingHandler handler;
+  EXPECT_TRUE(reader.ReadWithHandler(
+      R"({"a": [1, 2.5, "x\ny"], "b": {"c": null, "d": true}, "a": false})",
+      &handler));
+  EXPECT_EQ(JSONReader::JSON_NO_ERROR, reader.error_code());
+  // Duplicate keys are reported as they appear.
+  EXPECT_EQ(
+      "{a:[i1,d" + std::to_string(2.5) + ",'x\ny',]b:{c:null,d:true,}a:false,}",
+      handler.events());
+}
+
+TEST(JSONReaderTest, ReadWithHandlerScalarRoot) {
+  JSONReader reader;
+  RecordingHandler handler;
+  EXPECT_TRUE(reader.ReadWithHandler("\"foo\"", &handler));
+  EXPECT_EQ("'foo',", handler.events());
+}
+
+TEST(JSONReaderTest, ReadWithHandlerErrors) {
+  // The error is the same as the one reported by ReadToValue().
+  const char* const kInvalidJson[] = {
+      "[1, 2,]", "{\"a\": 1 \"b\": 2}", "{a: 1}", "[1] 2", "[1, ",
+  };
+  for (const char* json : kInvalidJson) {
+    SCOPED_TRACE(json);
+    JSONReader dom_reader;
+    EXPECT_FALSE(dom_reader.ReadToValue(json));
+
+    JSONReader reader;
+    RecordingHandler handler;
+    EXPECT_FALSE(reader.ReadWithHandler(json, &handler));
+    EXPECT_EQ(dom_reader.error_code(), reader.error_code());
+    EXPECT_EQ(dom_reader.GetErrorMessage(), reader.GetErrorMessage());
+  }
+
+  JSONReader reader(JSON_PARSE_RFC, 2);
+  RecordingHandler handler;
+  EXPECT_FALSE(reader.ReadWithHandler("[[[1]]]", &handler));
+  EXPECT_EQ(JSONReader::JSON_TOO_MUCH_NESTING, reader.error_code());
+}
+
 TEST(JSONReaderTest, MaxNesting) {
   std::string json(R"({"outer": { "inner": {"foo": true}}})");
   EXPECT_FALSE(JSONReader::Read(json, JSON_PARSE_RFC, 3));
@@ -6,13 +6,23 @@
 
 #include <stdint.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <limits>
+#include <utility>
+#include <vector>
 
+#include "base/bind.h"
 #include "base/json/string_escape.h"
 #include "base/logging.h"
+#include "base/memory/ref_counted.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/system/sys_info.h"
+#include "base/task/post_task.h"
+#include "base/task/task_scheduler/task_scheduler.h"
 #include "base/values.h"
 #include "build/build_config.h"
 
@@ -24,6 +34,58 @@ const char kPrettyPrintLineEnding[] = "\r\n";
 const char kPrettyPrintLineEnding[] = "\n";
 #endif
 
+// Values of a root dictionary serialized in parallel by the calling thread and
+// TaskScheduler workers. Each participant claims the next unclaimed value
+// until none is left. Helper tasks which run after all values were claimed
+// return without accessing |values|, which may be gone by then.
+class JSONWriter::ParallelSerialization
+    : public RefCountedThreadSafe<ParallelSerialization> {
+ public:
+  ParallelSerialization(int options, std::vector<const Value*> values)
+      : options_(options),
+        values_(std::move(values)),
+        results_(values_.size()),
+        succeeded_(values_.size()),
+        num_unfinished_(values_.size()) {}
+
+  // Serializes values until none is left to claim.
+  void Run() {
+    for (size_t index = next_index_.fetch_add(1); index < values_.size();
+         index = next_index_.fetch_add(1)) {
+      // Values are at depth 1 under the root.
+      succeeded_[index] =
+          JSONWriter::SerializeSubtree(*values_[index], options_, 1U,
+                                       &results_[index]);
+      if (num_unfinished_.fetch_sub(1) == 1)
+        all_finished_.Signal();
+    }
+  }
+
+  // Waits until every value has been serialized.
+  void Wait() {
+    if (num_unfinished_.load() != 0)
+      all_finished_.Wait();
+  }
+
+  const std::string& result(size_t index) const { return results_[index]; }
+  bool succeeded(size_t index) const { return succeeded_[index]; }
+
+ private:
+  friend class RefCountedThreadSafe<ParallelSerialization>;
+  ~ParallelSerialization() = default;
+
+  const int options_;
+  const std::vector<const Value*> values_;
+  std::vector<std::string> results_;
+  // Not std::vector<bool>, whose elements can't be written concurrently.
+  std::vector<char> succeeded_;
+  std::atomic<size_t> next_index_{0};
+  std::atomic<size_t> num_unfinished_;
+  WaitableEvent all_finished_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelSerialization);
+};
+
 // static
 bool JSONWriter::Write(const Value& node, std::string* json) {
   return WriteWithOptions(node, 0, json);
@@ -38,7 +100,10 @@ bool JSONWriter::WriteWithOptions(const Value& node,
   json->reserve(1024);
 
   JSONWriter writer(options, json);
-  bool result = writer.BuildJSONString(node, 0U);
+  bool result = (options & OPTIONS_PARALLEL_SERIALIZATION) &&
+                        node.is_dict() && TaskScheduler::GetInstance()
+                    ? writer.BuildRootDictionaryInParallel(node)
+                    : writer.BuildJSONString(node, 0U);
 
   if (options & OPTIONS_PRETTY_PRINT)
     json->append(kPrettyPrintLineEnding);
@@ -46,8 +111,18 @@ bool JSONWriter::WriteWithOptions(const Value& node,
   return result;
 }
 
+// static
+bool JSONWriter::SerializeSubtree(const Value& node,
+                                  int options,
+                                  size_t depth,
+                                  std::string* json) {
+  JSONWriter writer(options, json);
+  return writer.BuildJSONString(node, depth);
+}
+
 JSONWriter::JSONWriter(int options, std::string* json)
-    : omit_binary_values_((options & OPTIONS_OMIT_BINARY_VALUES) != 0),
+    : options_(options),
+      omit_binary_values_((options & OPTIONS_OMIT_BINARY_VALUES) != 0),
       omit_double_type_preservation_(
           (options & OPTIONS_OMIT_DOUBLE_TYPE_PRESERVATION) != 0),
       pretty_print_((options & OPTIONS_PRETTY_PRINT) != 0),
@@ -186,6 +261,69 @@ bool JSONWriter::BuildJSONString(const Value& node, size_t depth) {
   return false;
 }
 
+bool JSONWriter::BuildRootDictionaryInParallel(const Value& node) {
+  DCHECK(node.is_dict());
+
+  std::vector<const std::string*> keys;
+  std::vector<const Value*> values;
+  for (const auto& pair : node.DictItems()) {
+    if (omit_binary_values_ && pair.second.type() == Value::Type::BINARY)
+      continue;
+    keys.push_back(&pair.first);
+    values.push_back(&pair.second);
+  }
+  if (values.size() < 2)
+    return BuildJSONString(node, 0U);
+
+  auto serialization =
+      MakeRefCounted<ParallelSerialization>(options_, std::move(values));
+  const size_t num_helpers =
+      std::min(keys.size() - 1,
+               static_cast<size_t>(SysInfo::NumberOfProcessors() - 1));
+  for (size_t i = 0; i < num_helpers; ++i) {
+    PostTaskWithTraits(FROM_HERE,
+                       {TaskPriority::USER_BLOCKING,
+                        TaskShutdownBehavior::CONTINUE_ON_SHUTDOWN},
+                       BindOnce(&ParallelSerialization::Run, serialization));
+  }
+  serialization->Run();
+  serialization->Wait();
+
+  // Assemble the output exactly like the DICTIONARY case of BuildJSONString().
+  json_string_->push_back('{');
+  if (pretty_print_)
+    json_string_->append(kPrettyPrintLineEnding);
+
+  bool result = true;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    if (i > 0) {
+      json_string_->push_back(',');
+      if (pretty_print_)
+        json_string_->append(kPrettyPrintLineEnding);
+    }
+
+    if (pretty_print_)
+      IndentLine(1U);
+
+    EscapeJSONString(*keys[i], true, json_string_);
+    json_string_->push_back(':');
+    if (pretty_print_)
+      json_string_->push_back(' ');
+
+    json_string_->append(serialization->result(i));
+    if (!serialization->succeeded(i))
+      result = false;
+  }
+
+  if (pretty_print_) {
+    json_string_->append(kPrettyPrintLineEnding);
+    IndentLine(0U);
+  }
+
+  json_string_->push_back('}');
+  return result;
+}
+
 void JSONWriter::IndentLine(size_t depth) {
   json_string_->append(depth * 3U, ' ');
 }
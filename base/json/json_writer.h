@@ -34,6 +34,13 @@ class BASE_EXPORT JSONWriter {
     // Return a slightly nicer formatted json string (pads with whitespace to
     // help with readability).
     OPTIONS_PRETTY_PRINT = 1 << 2,
+
+    // If the root node is a dictionary, serializes its values in parallel on
+    // the TaskScheduler and concatenates the results. The output is identical
+    // to the serial one. This is only worth it for large trees and requires
+    // the calling thread to be allowed to wait on base sync primitives. It is
+    // ignored if there is no TaskScheduler.
+    OPTIONS_PARALLEL_SERIALIZATION = 1 << 3,
   };
 
   // Given a root node, generates a JSON string and puts it into |json|.
@@ -51,15 +58,28 @@ class BASE_EXPORT JSONWriter {
                                std::string* json);
 
  private:
+  class ParallelSerialization;
+
   JSONWriter(int options, std::string* json);
 
+  // Serializes |node| as if it was at |depth| in a tree, into |json|.
+  static bool SerializeSubtree(const Value& node,
+                               int options,
+                               size_t depth,
+                               std::string* json);
+
   // Called recursively to build the JSON string. When completed,
   // |json_string_| will contain the JSON.
   bool BuildJSONString(const Value& node, size_t depth);
 
+  // Same as BuildJSONString() for the root dictionary |node|, but serializes
+  // its values in parallel. See OPTIONS_PARALLEL_SERIALIZATION.
+  bool BuildRootDictionaryInParallel(const Value& node);
+
   // Adds space to json_string_ for the indent level.
   void IndentLine(size_t depth);
 
+  const int options_;
   bool omit_binary_values_;
   bool omit_double_type_preservation_;
   bool pretty_print_;
@@ -4,7 +4,11 @@
 
 #include "base/json/json_writer.h"
 
+#include <string>
+#include <utility>
+
 #include "base/memory/ptr_util.h"
+#include "base/test/scoped_task_environment.h"
 #include "base/values.h"
 #include "build/build_config.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -151,4 +155,39 @@ TEST(JSONWriterTest, DoublesAsInts) {
   EXPECT_EQ("10000000000", output_js);
 }
 
+TEST(JSONWriterTest, ParallelSerializationMatchesSerial) {
+  test::ScopedTaskEnvironment scoped_task_environment;
+
+  Value root(Value::Type::DICTIONARY);
+  for (int i = 0; i < 20; ++i) {
+    Value child(Value::Type::DICTIONARY);
+    child.SetKey("int", Value(i));
+    child.SetKey("double", Value(i / 4.0));
+    Value list(Value::Type::LIST);
+    list.GetList().emplace_back("string\n" + std::to_string(i));
+    list.GetList().emplace_back(Value::Type::DICTIONARY);
+    child.SetKey("list", std::move(list));
+    root.SetKey("key" + std::to_string(i), std::move(child));
+  }
+  root.SetKey("binary", Value(Value::BlobStorage({1, 2})));
+
+  for (int options :
+       {static_cast<int>(JSONWriter::OPTIONS_OMIT_BINARY_VALUES),
+        JSONWriter::OPTIONS_OMIT_BINARY_VALUES |
+            JSONWriter::OPTIONS_PRETTY_PRINT}) {
+    std::string serial;
+    EXPECT_TRUE(JSONWriter::WriteWithOptions(root, options, &serial));
+    std::string parallel;
+    EXPECT_TRUE(JSONWriter::WriteWithOptions(
+        root, options | JSONWriter::OPTIONS_PARALLEL_SERIALIZATION,
+        &parallel));
+    EXPECT_EQ(serial, parallel);
+  }
+
+  // Binary values still fail the serialization when not omitted.
+  std::string output_js;
+  EXPECT_FALSE(JSONWriter::WriteWithOptions(
+      root, JSONWriter::OPTIONS_PARALLEL_SERIALIZATION, &output_js));
+}
+
 }  // namespace base
@@ -0,0 +1,179 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/metrics/histogram_batcher.h"
+
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "base/metrics/histogram.h"
+#include "base/metrics/histogram_samples.h"
+#include "base/metrics/sample_map.h"
+#include "base/metrics/sample_vector.h"
+#include "base/no_destructor.h"
+#include "base/numerics/ranges.h"
+#include "base/synchronization/lock.h"
+#include "base/threading/thread_local_storage.h"
+
+namespace base {
+
+namespace {
+
+// Samples accumulated by one thread for one histogram.
+struct Shard {
+  std::unique_ptr<HistogramSamples> samples;
+  HistogramBase::Count count = 0;
+  // Whether |samples| buckets values like Histogram, which clamps them to
+  // [0, kSampleType_MAX - 1].
+  bool clamp = false;
+};
+
+// The shards of one thread. |lock| is only contended while FlushAllThreads()
+// merges them.
+struct ThreadShards {
+  Lock lock;
+  std::unordered_map<HistogramBase*, Shard> shards;
+};
+
+// Returns new samples to accumulate |histogram|'s samples in, or null if they
+// can't be batched.
+std::unique_ptr<HistogramSamples> CreateShardSamples(HistogramBase* histogram,
+                                                     bool* clamp) {
+  switch (histogram->GetHistogramType()) {
+    case HISTOGRAM:
+    case LINEAR_HISTOGRAM:
+    case BOOLEAN_HISTOGRAM:
+    case CUSTOM_HISTOGRAM:
+      *clamp = true;
+      return std::make_unique<SampleVector>(
+          histogram->name_hash(),
+          static_cast<Histogram*>(histogram)->bucket_ranges());
+    case SPARSE_HISTOGRAM:
+      *clamp = false;
+      return std::make_unique<SampleMap>(histogram->name_hash());
+    case DUMMY_HISTOGRAM:
+      return nullptr;
+  }
+  NOTREACHED();
+  return nullptr;
+}
+
+void MergeShard(HistogramBase* histogram, Shard* shard) {
+  if (!shard->count)
+    return;
+  histogram->AddSamples(*shard->samples);
+  shard->samples.reset();
+  shard->count = 0;
+}
+
+void MergeThreadShards(ThreadShards* thread_shards) {
+  AutoLock lock(thread_shards->lock);
+  for (auto& histogram_and_shard : thread_shards->shards)
+    MergeShard(histogram_and_shard.first, &histogram_and_shard.second);
+}
+
+// Keeps track of the shards of all threads.
+class ShardRegistry {
+ public:
+  static ShardRegistry* Get() {
+    static NoDestructor<ShardRegistry> registry;
+    return registry.get();
+  }
+
+  ShardRegistry() = default;
+
+  void AddThread(ThreadShards* thread_shards) {
+    AutoLock lock(lock_);
+    threads_.push_back(thread_shards);
+  }
+
+  void RemoveThread(ThreadShards* thread_shards) {
+    AutoLock lock(lock_);
+    threads_.erase(std::find(threads_.begin(), threads_.end(), thread_shards));
+  }
+
+  void MergeAll() {
+    AutoLock lock(lock_);
+    for (ThreadShards* thread_shards : threads_)
+      MergeThreadShards(thread_shards);
+  }
+
+ private:
+  // Protects |threads_|. Acquired before the lock of any ThreadShards.
+  Lock lock_;
+  std::vector<ThreadShards*> threads_;
+
+  DISALLOW_COPY_AND_ASSIGN(ShardRegistry);
+};
+
+void OnThreadExit(void* value) {
+  ThreadShards* thread_shards = static_cast<ThreadShards*>(value);
+  ShardRegistry::Get()->RemoveThread(thread_shards);
+  MergeThreadShards(thread_shards);
+  delete thread_shards;
+}
+
+ThreadLocalStorage::Slot& GetThreadShardsSlot() {
+  static NoDestructor<ThreadLocalStorage::Slot> slot(&OnThreadExit);
+  return *slot;
+}
+
+ThreadShards* GetCurrentThreadShards() {
+  ThreadLocalStorage::Slot& slot = GetThreadShardsSlot();
+  ThreadShards* thread_shards = static_cast<ThreadShards*>(slot.Get());
+  if (!thread_shards) {
+    thread_shards = new ThreadShards;
+    ShardRegistry::Get()->AddThread(thread_shards);
+    slot.Set(thread_shards);
+  }
+  return thread_shards;
+}
+
+}  // namespace
+
+// static
+constexpr HistogramBase::Count HistogramBatcher::kMaxBatchedSamples;
+
+// static
+void HistogramBatcher::Add(HistogramBase* histogram,
+                           HistogramBase::Sample value) {
+  if (histogram->flags() & HistogramBase::kCallbackExists) {
+    histogram->Add(value);
+    return;
+  }
+
+  ThreadShards* thread_shards = GetCurrentThreadShards();
+  AutoLock lock(thread_shards->lock);
+  Shard& shard = thread_shards->shards[histogram];
+  if (!shard.samples) {
+    shard.samples = CreateShardSamples(histogram, &shard.clamp);
+    if (!shard.samples) {
+      histogram->Add(value);
+      return;
+    }
+  }
+
+  if (shard.clamp)
+    value = ClampToRange(value, 0, HistogramBase::kSampleType_MAX - 1);
+  shard.samples->Accumulate(value, 1);
+  if (++shard.count >= kMaxBatchedSamples)
+    MergeShard(histogram, &shard);
+}
+
+// static
+void HistogramBatcher::FlushCurrentThread() {
+  ThreadShards* thread_shards =
+      static_cast<ThreadShards*>(GetThreadShardsSlot().Get());
+  if (thread_shards)
+    MergeThreadShards(thread_shards);
+}
+
+// static
+void HistogramBatcher::FlushAllThreads() {
+  ShardRegistry::Get()->MergeAll();
+}
+
+}  // namespace base
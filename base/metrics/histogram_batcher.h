@@ -0,0 +1,53 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_METRICS_HISTOGRAM_BATCHER_H_
+#define BASE_METRICS_HISTOGRAM_BATCHER_H_
+
+#include "base/base_export.h"
+#include "base/macros.h"
+#include "base/metrics/histogram_base.h"
+
+namespace base {
+
+// HistogramBatcher accumulates the samples of histograms recorded at a very
+// high rate (e.g. per frame or per packet) in per-thread shards, instead of
+// incrementing the shared bucket counts of the histogram for every sample.
+// This avoids contention on the histogram's cache lines when it is recorded
+// from many threads.
+//
+// A thread's shard for a histogram is merged into the histogram once it holds
+// kMaxBatchedSamples samples, when the thread exits, and when all shards are
+// flushed through FlushAllThreads(). The latter is also done by
+// StatisticsRecorder::ImportProvidedHistograms(), so batched samples are
+// included in the histogram snapshots taken for UMA uploads. Until a shard is
+// merged, its samples are not visible in the histogram.
+//
+// Histograms with a sample callback (see
+// StatisticsRecorder::SetCallback()) are not batched so that the callback runs
+// for every sample.
+//
+// Use it through the UMA_HISTOGRAM_CUSTOM_COUNTS_BATCHED() macro, or call Add()
+// directly with a cached histogram pointer.
+class BASE_EXPORT HistogramBatcher {
+ public:
+  // Number of samples of a histogram a thread accumulates before merging them.
+  static constexpr HistogramBase::Count kMaxBatchedSamples = 256;
+
+  // Records |value| in |histogram| on behalf of the current thread.
+  static void Add(HistogramBase* histogram, HistogramBase::Sample value);
+
+  // Merges the samples accumulated by the current thread.
+  static void FlushCurrentThread();
+
+  // Merges the samples accumulated by all threads.
+  static void FlushAllThreads();
+
+ private:
+  DISALLOW_IMPLICIT_CONSTRUCTORS(HistogramBatcher);
+};
+
+}  // namespace base
+
+#endif  // BASE_METRICS_HISTOGRAM_BATCHER_H_
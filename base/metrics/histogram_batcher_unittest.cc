@@ -0,0 +1,124 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/metrics/histogram_batcher.h"
+
+#include <memory>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/metrics/histogram.h"
+#include "base/metrics/histogram_macros.h"
+#include "base/metrics/histogram_samples.h"
+#include "base/metrics/sparse_histogram.h"
+#include "base/metrics/statistics_recorder.h"
+#include "base/strings/stringprintf.h"
+#include "base/threading/thread.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+namespace {
+
+void AddSamples(HistogramBase* histogram, int count) {
+  for (int i = 0; i < count; ++i)
+    HistogramBatcher::Add(histogram, i % 10);
+}
+
+}  // namespace
+
+class HistogramBatcherTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    statistics_recorder_ = StatisticsRecorder::CreateTemporaryForTesting();
+  }
+
+  void TearDown() override {
+    HistogramBatcher::FlushAllThreads();
+    statistics_recorder_.reset();
+  }
+
+ private:
+  std::unique_ptr<StatisticsRecorder> statistics_recorder_;
+};
+
+TEST_F(HistogramBatcherTest, MergesOnFlush) {
+  HistogramBase* histogram = Histogram::FactoryGet(
+      "Batched.Flush", 1, 100, 10, HistogramBase::kNoFlags);
+
+  AddSamples(histogram, 10);
+  EXPECT_EQ(0, histogram->SnapshotSamples()->TotalCount());
+
+  HistogramBatcher::FlushCurrentThread();
+  std::unique_ptr<HistogramSamples> samples = histogram->SnapshotSamples();
+  EXPECT_EQ(10, samples->TotalCount());
+  EXPECT_EQ(45, samples->sum());
+
+  // Once merged, samples are not merged again.
+  HistogramBatcher::FlushCurrentThread();
+  EXPECT_EQ(10, histogram->SnapshotSamples()->TotalCount());
+}
+
+TEST_F(HistogramBatcherTest, MergesFullShards) {
+  HistogramBase* histogram = Histogram::FactoryGet(
+      "Batched.Full", 1, 100, 10, HistogramBase::kNoFlags);
+
+  AddSamples(histogram, HistogramBatcher::kMaxBatchedSamples + 1);
+  EXPECT_EQ(HistogramBatcher::kMaxBatchedSamples,
+            histogram->SnapshotSamples()->TotalCount());
+}
+
+TEST_F(HistogramBatcherTest, SparseHistogram) {
+  HistogramBase* histogram =
+      SparseHistogram::FactoryGet("Batched.Sparse", HistogramBase::kNoFlags);
+
+  HistogramBatcher::Add(histogram, -5);
+  HistogramBatcher::Add(histogram, 1000);
+  HistogramBatcher::FlushCurrentThread();
+  std::unique_ptr<HistogramSamples> samples = histogram->SnapshotSamples();
+  EXPECT_EQ(1, samples->GetCount(-5));
+  EXPECT_EQ(1, samples->GetCount(1000));
+}
+
+// Samples recorded on several threads are all merged, whether by the thread
+// exiting or by ImportProvidedHistograms().
+TEST_F(HistogramBatcherTest, CrossThread) {
+  constexpr int kThreadCount = 8;
+  constexpr int kSamplesPerThread = 1000;
+  HistogramBase* histogram = Histogram::FactoryGet(
+      "Batched.CrossThread", 1, 100, 10, HistogramBase::kNoFlags);
+
+  std::vector<std::unique_ptr<Thread>> threads;
+  for (int i = 0; i < kThreadCount; ++i) {
+    threads.push_back(
+        std::make_unique<Thread>(StringPrintf("HistogramBatcher%d", i)));
+    ASSERT_TRUE(threads.back()->Start());
+    threads.back()->task_runner()->PostTask(
+        FROM_HERE, BindOnce(&AddSamples, histogram, kSamplesPerThread));
+  }
+  for (int i = 0; i < kThreadCount / 2; ++i)
+    threads[i]->Stop();
+  for (int i = kThreadCount / 2; i < kThreadCount; ++i)
+    threads[i]->FlushForTesting();
+
+  StatisticsRecorder::ImportProvidedHistograms();
+  EXPECT_EQ(kThreadCount * kSamplesPerThread,
+            histogram->SnapshotSamples()->TotalCount());
+
+  threads.clear();
+  EXPECT_EQ(kThreadCount * kSamplesPerThread,
+            histogram->SnapshotSamples()->TotalCount());
+}
+
+TEST_F(HistogramBatcherTest, Macro) {
+  for (int i = 0; i < 5; ++i)
+    UMA_HISTOGRAM_CUSTOM_COUNTS_BATCHED("Batched.Macro", 7, 1, 100, 10);
+  HistogramBatcher::FlushCurrentThread();
+
+  HistogramBase* histogram = StatisticsRecorder::FindHistogram("Batched.Macro");
+  ASSERT_TRUE(histogram);
+  EXPECT_EQ(5, histogram->SnapshotSamples()->GetCount(7));
+}
+
+}  // namespace base
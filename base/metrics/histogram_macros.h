@@ -191,6 +191,18 @@
         name, sample, min, max, bucket_count,                                  \
         base::HistogramBase::kUmaTargetedHistogramFlag)
 
+// Same as UMA_HISTOGRAM_CUSTOM_COUNTS, for histograms recorded at a very high
+// rate from several threads. Samples are accumulated per thread and only show
+// up in the histogram once merged; see base/metrics/histogram_batcher.h.
+
+// Sample usage:
+//   UMA_HISTOGRAM_CUSTOM_COUNTS_BATCHED("My.Histogram", sample, 1, 1000, 50);
+#define UMA_HISTOGRAM_CUSTOM_COUNTS_BATCHED(name, sample, min, max,            \
+                                            bucket_count)                      \
+  INTERNAL_HISTOGRAM_CUSTOM_COUNTS_BATCHED_WITH_FLAG(                          \
+      name, sample, min, max, bucket_count,                                    \
+      base::HistogramBase::kUmaTargetedHistogramFlag)
+
 //------------------------------------------------------------------------------
 // Timing histograms. These are used for collecting timing data (generally
 // latencies).
@@ -13,6 +13,7 @@
 #include "base/atomicops.h"
 #include "base/logging.h"
 #include "base/metrics/histogram.h"
+#include "base/metrics/histogram_batcher.h"
 #include "base/metrics/sparse_histogram.h"
 #include "base/time/time.h"
 
@@ -128,6 +129,29 @@ struct EnumSizeTraits<
         name, Add(sample),                                                     \
         base::Histogram::FactoryGet(name, min, max, bucket_count, flag))
 
+// This is a helper macro used by other macros and shouldn't be used directly.
+// Same as INTERNAL_HISTOGRAM_CUSTOM_COUNTS_WITH_FLAG, but records through
+// HistogramBatcher, which HISTOGRAM_POINTER_USE can't invoke as it only calls
+// methods of the histogram.
+#define INTERNAL_HISTOGRAM_CUSTOM_COUNTS_BATCHED_WITH_FLAG(                    \
+    name, sample, min, max, bucket_count, flag)                                \
+  do {                                                                         \
+    static base::subtle::AtomicWord atomic_histogram_pointer = 0;              \
+    base::HistogramBase* histogram_pointer(                                    \
+        reinterpret_cast<base::HistogramBase*>(                                \
+            base::subtle::Acquire_Load(&atomic_histogram_pointer)));           \
+    if (!histogram_pointer) {                                                  \
+      histogram_pointer =                                                      \
+          base::Histogram::FactoryGet(name, min, max, bucket_count, flag);     \
+      base::subtle::Release_Store(                                             \
+          &atomic_histogram_pointer,                                           \
+          reinterpret_cast<base::subtle::AtomicWord>(histogram_pointer));      \
+    }                                                                          \
+    if (DCHECK_IS_ON())                                                        \
+      histogram_pointer->CheckName(name);                                      \
+    base::HistogramBatcher::Add(histogram_pointer, sample);                    \
+  } while (0)
+
 // This is a helper macro used by other macros and shouldn't be used directly.
 // The bucketing scheme is linear with a bucket size of 1. For N items,
 // recording values in the range [0, N - 1] creates a linear histogram with N +
@@ -0,0 +1,151 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <stddef.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/logging.h"
+#include "base/metrics/histogram.h"
+#include "base/metrics/histogram_batcher.h"
+#include "base/metrics/statistics_recorder.h"
+#include "base/strings/stringprintf.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/threading/thread.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+
+namespace {
+
+constexpr int kSamplesPerThread = 1000000;
+
+// Records |kSamplesPerThread| samples in |histogram| once |start| is signaled,
+// directly or through HistogramBatcher, and stores the time it took in
+// |*elapsed|.
+void RecordSamples(HistogramBase* histogram,
+                   bool batched,
+                   WaitableEvent* start,
+                   TimeDelta* elapsed) {
+  start->Wait();
+  TimeTicks begin = TimeTicks::Now();
+  for (int i = 0; i < kSamplesPerThread; ++i) {
+    if (batched)
+      HistogramBatcher::Add(histogram, i & 63);
+    else
+      histogram->Add(i & 63);
+  }
+  if (batched)
+    HistogramBatcher::FlushCurrentThread();
+  *elapsed = TimeTicks::Now() - begin;
+}
+
+// Measures the average cost of recording a sample in a histogram shared by
+// |thread_count| threads recording concurrently.
+void RunAddTest(size_t thread_count, bool batched) {
+  std::unique_ptr<StatisticsRecorder> statistics_recorder =
+      StatisticsRecorder::CreateTemporaryForTesting();
+  HistogramBase* histogram = Histogram::FactoryGet(
+      "Perf.Histogram", 1, 64, 50, HistogramBase::kNoFlags);
+
+  std::vector<std::unique_ptr<Thread>> threads;
+  std::vector<TimeDelta> elapsed(thread_count);
+  WaitableEvent start;
+  for (size_t i = 0; i < thread_count; ++i) {
+    threads.push_back(
+        std::make_unique<Thread>(StringPrintf("HistogramPerfTest%zu", i)));
+    ASSERT_TRUE(threads.back()->Start());
+    threads.back()->task_runner()->PostTask(
+        FROM_HERE, BindOnce(&RecordSamples, histogram, batched,
+                            Unretained(&start), Unretained(&elapsed[i])));
+  }
+  start.Signal();
+  for (auto& thread : threads)
+    thread->Stop();
+
+  EXPECT_EQ(static_cast<int>(kSamplesPerThread * thread_count),
+            histogram->SnapshotSamples()->TotalCount());
+
+  TimeDelta total;
+  for (const TimeDelta& thread_elapsed : elapsed)
+    total += thread_elapsed;
+  perf_test::PrintResult(
+      batched ? "Histogram_AddBatched" : "Histogram_Add", "",
+      StringPrintf("%zu_threads", thread_count),
+      total.InNanoseconds() /
+          static_cast<double>(kSamplesPerThread * thread_count),
+      "ns/sample", true);
+}
+
+constexpr int kLookupsPerThread = 1000000;
+constexpr int kLookupHistogramCount = 100;
+
+// Looks up |kLookupsPerThread| of the histograms named |names| once |start| is
+// signaled.
+void LookUpHistograms(const std::vector<std::string>* names,
+                      WaitableEvent* start) {
+  start->Wait();
+  for (int i = 0; i < kLookupsPerThread; ++i) {
+    HistogramBase* histogram =
+        StatisticsRecorder::FindHistogram((*names)[i % names->size()]);
+    CHECK(histogram);
+  }
+}
+
+// Measures the rate at which |thread_count| threads can concurrently look up
+// histograms by name, as done by the base::UmaHistogram*() functions.
+void RunLookupTest(size_t thread_count) {
+  std::unique_ptr<StatisticsRecorder> statistics_recorder =
+      StatisticsRecorder::CreateTemporaryForTesting();
+  std::vector<std::string> names;
+  for (int i = 0; i < kLookupHistogramCount; ++i) {
+    names.push_back(StringPrintf("Perf.Lookup%d", i));
+    Histogram::FactoryGet(names.back(), 1, 64, 50, HistogramBase::kNoFlags);
+  }
+
+  std::vector<std::unique_ptr<Thread>> threads;
+  WaitableEvent start;
+  for (size_t i = 0; i < thread_count; ++i) {
+    threads.push_back(
+        std::make_unique<Thread>(StringPrintf("HistogramPerfTest%zu", i)));
+    ASSERT_TRUE(threads.back()->Start());
+    threads.back()->task_runner()->PostTask(
+        FROM_HERE, BindOnce(&LookUpHistograms, Unretained(&names),
+                            Unretained(&start)));
+  }
+  TimeTicks begin = TimeTicks::Now();
+  start.Signal();
+  for (auto& thread : threads)
+    thread->Stop();
+  TimeDelta wall_time = TimeTicks::Now() - begin;
+
+  perf_test::PrintResult(
+      "Histogram_Lookup", "", StringPrintf("%zu_threads", thread_count),
+      kLookupsPerThread * thread_count / wall_time.InSecondsF(), "lookups/s",
+      true);
+}
+
+}  // namespace
+
+TEST(HistogramPerfTest, Add) {
+  for (size_t thread_count : {1, 8, 32})
+    RunAddTest(thread_count, false);
+}
+
+TEST(HistogramPerfTest, AddBatched) {
+  for (size_t thread_count : {1, 8, 32})
+    RunAddTest(thread_count, true);
+}
+
+TEST(HistogramPerfTest, Lookup) {
+  for (size_t thread_count : {1, 8, 32})
+    RunLookupTest(thread_count);
+}
+
+}  // namespace base
@@ -12,6 +12,7 @@
 #include "base/logging.h"
 #include "base/memory/ptr_util.h"
 #include "base/metrics/histogram.h"
+#include "base/metrics/histogram_batcher.h"
 #include "base/metrics/histogram_snapshot_manager.h"
 #include "base/metrics/metrics_hashes.h"
 #include "base/metrics/persistent_histogram_allocator.h"
@@ -34,7 +35,7 @@ bool HistogramNameLesser(const base::HistogramBase* a,
 LazyInstance<Lock>::Leaky StatisticsRecorder::lock_;
 
 // static
-StatisticsRecorder* StatisticsRecorder::top_ = nullptr;
+std::atomic<StatisticsRecorder*> StatisticsRecorder::top_{nullptr};
 
 // static
 bool StatisticsRecorder::is_vlog_initialized_ = false;
@@ -52,28 +53,45 @@ bool StatisticsRecorder::BucketRangesEqual::operator()(
 
 StatisticsRecorder::~StatisticsRecorder() {
   const AutoLock auto_lock(lock_.Get());
-  DCHECK_EQ(this, top_);
-  top_ = previous_;
+  DCHECK_EQ(this, top_.load(std::memory_order_relaxed));
+  top_.store(previous_, std::memory_order_release);
 }
 
 // static
-void StatisticsRecorder::EnsureGlobalRecorderWhileLocked() {
+StatisticsRecorder* StatisticsRecorder::EnsureGlobalRecorderWhileLocked() {
   lock_.Get().AssertAcquired();
-  if (top_)
-    return;
+  StatisticsRecorder* const top = top_.load(std::memory_order_relaxed);
+  if (top)
+    return top;
 
-  const StatisticsRecorder* const p = new StatisticsRecorder;
+  StatisticsRecorder* const p = new StatisticsRecorder;
   // The global recorder is never deleted.
   ANNOTATE_LEAKING_OBJECT_PTR(p);
-  DCHECK_EQ(p, top_);
+  DCHECK_EQ(p, top_.load(std::memory_order_relaxed));
+  return p;
+}
+
+// static
+StatisticsRecorder* StatisticsRecorder::EnsureGlobalRecorder() {
+  StatisticsRecorder* const top = top_.load(std::memory_order_acquire);
+  if (top)
+    return top;
+
+  const AutoLock auto_lock(lock_.Get());
+  return EnsureGlobalRecorderWhileLocked();
+}
+
+StatisticsRecorder::HistogramShard& StatisticsRecorder::GetHistogramShard(
+    StringPiece name) {
+  return histogram_shards_[StringPieceHash()(name) % kHistogramShardCount];
 }
 
 // static
 void StatisticsRecorder::RegisterHistogramProvider(
     const WeakPtr<HistogramProvider>& provider) {
   const AutoLock auto_lock(lock_.Get());
-  EnsureGlobalRecorderWhileLocked();
-  top_->providers_.push_back(provider);
+  StatisticsRecorder* const top = EnsureGlobalRecorderWhileLocked();
+  top->providers_.push_back(provider);
 }
 
 // static
@@ -82,10 +100,12 @@ HistogramBase* StatisticsRecorder::RegisterOrDeleteDuplicate(
   // Declared before |auto_lock| to ensure correct destruction order.
   std::unique_ptr<HistogramBase> histogram_deleter;
   const AutoLock auto_lock(lock_.Get());
-  EnsureGlobalRecorderWhileLocked();
+  StatisticsRecorder* const top = EnsureGlobalRecorderWhileLocked();
 
   const char* const name = histogram->histogram_name();
-  HistogramBase*& registered = top_->histograms_[name];
+  HistogramShard& shard = top->GetHistogramShard(name);
+  const AutoLock shard_lock(shard.lock);
+  HistogramBase*& registered = shard.histograms[name];
 
   if (!registered) {
     // |name| is guaranteed to never change or be deallocated so long
@@ -94,8 +114,8 @@ HistogramBase* StatisticsRecorder::RegisterOrDeleteDuplicate(
     ANNOTATE_LEAKING_OBJECT_PTR(histogram);  // see crbug.com/79322
     // If there are callbacks for this histogram, we set the kCallbackExists
     // flag.
-    const auto callback_iterator = top_->callbacks_.find(name);
-    if (callback_iterator != top_->callbacks_.end()) {
+    const auto callback_iterator = top->callbacks_.find(name);
+    if (callback_iterator != top->callbacks_.end()) {
       if (!callback_iterator->second.is_null())
         histogram->SetFlags(HistogramBase::kCallbackExists);
       else
@@ -122,9 +142,9 @@ const BucketRanges* StatisticsRecorder::RegisterOrDeleteDuplicateRanges(
   // Declared before |auto_lock| to ensure correct destruction order.
   std::unique_ptr<const BucketRanges> ranges_deleter;
   const AutoLock auto_lock(lock_.Get());
-  EnsureGlobalRecorderWhileLocked();
+  StatisticsRecorder* const top = EnsureGlobalRecorderWhileLocked();
 
-  const BucketRanges* const registered = *top_->ranges_.insert(ranges).first;
+  const BucketRanges* const registered = *top->ranges_.insert(ranges).first;
   if (registered == ranges) {
     ANNOTATE_LEAKING_OBJECT_PTR(ranges);
   } else {
@@ -178,9 +198,9 @@ std::string StatisticsRecorder::ToJSON(JSONVerbosityLevel verbosity_level) {
 std::vector<const BucketRanges*> StatisticsRecorder::GetBucketRanges() {
   std::vector<const BucketRanges*> out;
   const AutoLock auto_lock(lock_.Get());
-  EnsureGlobalRecorderWhileLocked();
-  out.reserve(top_->ranges_.size());
-  out.assign(top_->ranges_.begin(), top_->ranges_.end());
+  StatisticsRecorder* const top = EnsureGlobalRecorderWhileLocked();
+  out.reserve(top->ranges_.size());
+  out.assign(top->ranges_.begin(), top->ranges_.end());
   return out;
 }
 
@@ -191,23 +211,27 @@ HistogramBase* StatisticsRecorder::FindHistogram(base::StringPiece name) {
   // will acquire the lock at that time.
   ImportGlobalPersistentHistograms();
 
-  const AutoLock auto_lock(lock_.Get());
-  EnsureGlobalRecorderWhileLocked();
-
-  const HistogramMap::const_iterator it = top_->histograms_.find(name);
-  return it != top_->histograms_.end() ? it->second : nullptr;
+  // Only the shard holding |name| is locked, so that lookups from different
+  // threads don't serialize on the global lock.
+  HistogramShard& shard = EnsureGlobalRecorder()->GetHistogramShard(name);
+  const AutoLock shard_lock(shard.lock);
+  const HistogramMap::const_iterator it = shard.histograms.find(name);
+  return it != shard.histograms.end() ? it->second : nullptr;
 }
 
 // static
 StatisticsRecorder::HistogramProviders
 StatisticsRecorder::GetHistogramProviders() {
   const AutoLock auto_lock(lock_.Get());
-  EnsureGlobalRecorderWhileLocked();
-  return top_->providers_;
+  StatisticsRecorder* const top = EnsureGlobalRecorderWhileLocked();
+  return top->providers_;
 }
 
 // static
 void StatisticsRecorder::ImportProvidedHistograms() {
+  // Merge the samples batched on other threads.
+  HistogramBatcher::FlushAllThreads();
+
   // Merge histogram data from each provider in turn.
   for (const WeakPtr<HistogramProvider>& provider : GetHistogramProviders()) {
     // Weak-pointer may be invalid if the provider was destructed, though they
@@ -242,13 +266,15 @@ bool StatisticsRecorder::SetCallback(
     const StatisticsRecorder::OnSampleCallback& cb) {
   DCHECK(!cb.is_null());
   const AutoLock auto_lock(lock_.Get());
-  EnsureGlobalRecorderWhileLocked();
+  StatisticsRecorder* const top = EnsureGlobalRecorderWhileLocked();
 
-  if (!top_->callbacks_.insert({name, cb}).second)
+  if (!top->callbacks_.insert({name, cb}).second)
     return false;
 
-  const HistogramMap::const_iterator it = top_->histograms_.find(name);
-  if (it != top_->histograms_.end())
+  HistogramShard& shard = top->GetHistogramShard(name);
+  const AutoLock shard_lock(shard.lock);
+  const HistogramMap::const_iterator it = shard.histograms.find(name);
+  if (it != shard.histograms.end())
     it->second->SetFlags(HistogramBase::kCallbackExists);
 
   return true;
@@ -257,13 +283,15 @@ bool StatisticsRecorder::SetCallback(
 // static
 void StatisticsRecorder::ClearCallback(const std::string& name) {
   const AutoLock auto_lock(lock_.Get());
-  EnsureGlobalRecorderWhileLocked();
+  StatisticsRecorder* const top = EnsureGlobalRecorderWhileLocked();
 
-  top_->callbacks_.erase(name);
+  top->callbacks_.erase(name);
 
   // We also clear the flag from the histogram (if it exists).
-  const HistogramMap::const_iterator it = top_->histograms_.find(name);
-  if (it != top_->histograms_.end())
+  HistogramShard& shard = top->GetHistogramShard(name);
+  const AutoLock shard_lock(shard.lock);
+  const HistogramMap::const_iterator it = shard.histograms.find(name);
+  if (it != shard.histograms.end())
     it->second->ClearFlags(HistogramBase::kCallbackExists);
 }
 
@@ -271,25 +299,32 @@ void StatisticsRecorder::ClearCallback(const std::string& name) {
 StatisticsRecorder::OnSampleCallback StatisticsRecorder::FindCallback(
     const std::string& name) {
   const AutoLock auto_lock(lock_.Get());
-  EnsureGlobalRecorderWhileLocked();
-  const auto it = top_->callbacks_.find(name);
-  return it != top_->callbacks_.end() ? it->second : OnSampleCallback();
+  StatisticsRecorder* const top = EnsureGlobalRecorderWhileLocked();
+  const auto it = top->callbacks_.find(name);
+  return it != top->callbacks_.end() ? it->second : OnSampleCallback();
 }
 
 // static
 size_t StatisticsRecorder::GetHistogramCount() {
   const AutoLock auto_lock(lock_.Get());
-  EnsureGlobalRecorderWhileLocked();
-  return top_->histograms_.size();
+  StatisticsRecorder* const top = EnsureGlobalRecorderWhileLocked();
+  size_t count = 0;
+  for (HistogramShard& shard : top->histogram_shards_) {
+    const AutoLock shard_lock(shard.lock);
+    count += shard.histograms.size();
+  }
+  return count;
 }
 
 // static
 void StatisticsRecorder::ForgetHistogramForTesting(base::StringPiece name) {
   const AutoLock auto_lock(lock_.Get());
-  EnsureGlobalRecorderWhileLocked();
+  StatisticsRecorder* const top = EnsureGlobalRecorderWhileLocked();
 
-  const HistogramMap::iterator found = top_->histograms_.find(name);
-  if (found == top_->histograms_.end())
+  HistogramShard& shard = top->GetHistogramShard(name);
+  const AutoLock shard_lock(shard.lock);
+  const HistogramMap::iterator found = shard.histograms.find(name);
+  if (found == shard.histograms.end())
     return;
 
   HistogramBase* const base = found->second;
@@ -301,7 +336,7 @@ void StatisticsRecorder::ForgetHistogramForTesting(base::StringPiece name) {
     static_cast<Histogram*>(base)->bucket_ranges()->set_persistent_reference(0);
   }
 
-  top_->histograms_.erase(found);
+  shard.histograms.erase(found);
 }
 
 // static
@@ -315,16 +350,16 @@ StatisticsRecorder::CreateTemporaryForTesting() {
 void StatisticsRecorder::SetRecordChecker(
     std::unique_ptr<RecordHistogramChecker> record_checker) {
   const AutoLock auto_lock(lock_.Get());
-  EnsureGlobalRecorderWhileLocked();
-  top_->record_checker_ = std::move(record_checker);
+  StatisticsRecorder* const top = EnsureGlobalRecorderWhileLocked();
+  top->record_checker_ = std::move(record_checker);
 }
 
 // static
 bool StatisticsRecorder::ShouldRecordHistogram(uint64_t histogram_hash) {
   const AutoLock auto_lock(lock_.Get());
-  EnsureGlobalRecorderWhileLocked();
-  return !top_->record_checker_ ||
-         top_->record_checker_->ShouldRecord(histogram_hash);
+  StatisticsRecorder* const top = EnsureGlobalRecorderWhileLocked();
+  return !top->record_checker_ ||
+         top->record_checker_->ShouldRecord(histogram_hash);
 }
 
 // static
@@ -337,11 +372,13 @@ StatisticsRecorder::Histograms StatisticsRecorder::GetHistograms() {
   Histograms out;
 
   const AutoLock auto_lock(lock_.Get());
-  EnsureGlobalRecorderWhileLocked();
+  StatisticsRecorder* const top = EnsureGlobalRecorderWhileLocked();
 
-  out.reserve(top_->histograms_.size());
-  for (const auto& entry : top_->histograms_)
-    out.push_back(entry.second);
+  for (HistogramShard& shard : top->histogram_shards_) {
+    const AutoLock shard_lock(shard.lock);
+    for (const auto& entry : shard.histograms)
+      out.push_back(entry.second);
+  }
 
   return out;
 }
@@ -394,8 +431,8 @@ void StatisticsRecorder::ImportGlobalPersistentHistograms() {
 // support for all future calls.
 StatisticsRecorder::StatisticsRecorder() {
   lock_.Get().AssertAcquired();
-  previous_ = top_;
-  top_ = this;
+  previous_ = top_.load(std::memory_order_relaxed);
+  top_.store(this, std::memory_order_release);
   InitLogOnShutdownWhileLocked();
 }
 
@@ -12,6 +12,7 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -63,7 +64,8 @@ class BASE_EXPORT StatisticsRecorder {
   // CreateTemporaryForTesting(), these recorders must be deleted in reverse
   // order of creation.
   //
-  // This method is thread safe.
+  // This method is thread safe, but no other thread may be looking up
+  // histograms during this call.
   //
   // Precondition: The recorder being deleted is the current global recorder.
   ~StatisticsRecorder();
@@ -128,7 +130,8 @@ class BASE_EXPORT StatisticsRecorder {
   // This method is thread safe.
   static HistogramBase* FindHistogram(base::StringPiece name);
 
-  // Imports histograms from providers.
+  // Imports histograms from providers, and merges the samples accumulated by
+  // HistogramBatcher.
   //
   // This method must be called on the UI thread.
   static void ImportProvidedHistograms();
@@ -226,6 +229,16 @@ class BASE_EXPORT StatisticsRecorder {
   typedef std::unordered_map<StringPiece, HistogramBase*, StringPieceHash>
       HistogramMap;
 
+  // Histograms are spread over several maps, each with its own lock, so that
+  // looking up histograms by name from many threads (e.g. through the
+  // base::UmaHistogram*() functions) doesn't contend on a single lock.
+  static constexpr size_t kHistogramShardCount = 16;
+
+  struct HistogramShard {
+    Lock lock;
+    HistogramMap histograms;
+  };
+
   // We keep a map of callbacks to histograms, so that as histograms are
   // created, we can set the callback properly.
   typedef std::unordered_map<std::string, OnSampleCallback> CallbackMap;
@@ -248,8 +261,21 @@ class BASE_EXPORT StatisticsRecorder {
   // Initializes the global recorder if it doesn't already exist. Safe to call
   // multiple times.
   //
+  // Returns the global recorder.
+  //
   // Precondition: The global lock is already acquired.
-  static void EnsureGlobalRecorderWhileLocked();
+  static StatisticsRecorder* EnsureGlobalRecorderWhileLocked();
+
+  // Same as above, but only acquires the global lock if the global recorder
+  // doesn't exist yet.
+  //
+  // Precondition: The global lock must not be held during this call.
+  static StatisticsRecorder* EnsureGlobalRecorder();
+
+  // Returns the shard holding the histogram named |name|. Its lock must be
+  // acquired to access the shard. When the global lock is also needed, it must
+  // be acquired first.
+  HistogramShard& GetHistogramShard(StringPiece name);
 
   // Gets histogram providers.
   //
@@ -273,7 +299,7 @@ class BASE_EXPORT StatisticsRecorder {
   // Precondition: The global lock is already acquired.
   static void InitLogOnShutdownWhileLocked();
 
-  HistogramMap histograms_;
+  HistogramShard histogram_shards_[kHistogramShardCount];
   CallbackMap callbacks_;
   RangesMap ranges_;
   HistogramProviders providers_;
@@ -287,8 +313,9 @@ class BASE_EXPORT StatisticsRecorder {
 
   // Current global recorder. This recorder is used by static methods. When a
   // new global recorder is created by CreateTemporaryForTesting(), then the
-  // previous global recorder is referenced by top_->previous_.
-  static StatisticsRecorder* top_;
+  // previous global recorder is referenced by top_->previous_. Only written
+  // while holding the global lock, but read without it by FindHistogram().
+  static std::atomic<StatisticsRecorder*> top_;
 
   // Tracks whether InitLogOnShutdownWhileLocked() has registered a logging
   // function that will be called when the program finishes.
@@ -207,6 +207,25 @@ bool PickleIterator::ReadBytes(const char** data, int length) {
   return true;
 }
 
+bool PickleIterator::ReadData(span<const uint8_t>* data) {
+  *data = span<const uint8_t>();
+
+  int length;
+  if (!ReadInt(&length))
+    return false;
+
+  return ReadBytes(data, length);
+}
+
+bool PickleIterator::ReadBytes(span<const uint8_t>* data, int length) {
+  const char* read_from = GetReadPointerAndAdvance(length);
+  if (!read_from)
+    return false;
+  *data = make_span(reinterpret_cast<const uint8_t*>(read_from),
+                    static_cast<size_t>(length));
+  return true;
+}
+
 Pickle::Attachment::Attachment() = default;
 
 Pickle::Attachment::~Attachment() = default;
@@ -254,6 +273,9 @@ Pickle::Pickle(const char* data, size_t data_len)
     header_ = nullptr;
 }
 
+Pickle::Pickle(span<const uint8_t> data)
+    : Pickle(reinterpret_cast<const char*>(data.data()), data.size()) {}
+
 Pickle::Pickle(const Pickle& other)
     : header_(nullptr),
       header_size_(other.header_size_),
@@ -12,6 +12,7 @@
 
 #include "base/base_export.h"
 #include "base/compiler_specific.h"
+#include "base/containers/span.h"
 #include "base/gtest_prod_util.h"
 #include "base/logging.h"
 #include "base/memory/ref_counted.h"
@@ -67,6 +68,12 @@ class BASE_EXPORT PickleIterator {
   // mutated). Do not keep the pointer around!
   bool ReadBytes(const char** data, int length) WARN_UNUSED_RESULT;
 
+  // Same as ReadData() and ReadBytes() above, but hand back a span over the
+  // message's buffer instead of a pointer. Nothing is copied and the same
+  // lifetime restrictions apply.
+  bool ReadData(span<const uint8_t>* data) WARN_UNUSED_RESULT;
+  bool ReadBytes(span<const uint8_t>* data, int length) WARN_UNUSED_RESULT;
+
   // A safer version of ReadInt() that checks for the result not being negative.
   // Use it for reading the object sizes.
   bool ReadLength(int* result) WARN_UNUSED_RESULT {
@@ -156,6 +163,10 @@ class BASE_EXPORT Pickle {
   // padding size is deduced from the data length.
   Pickle(const char* data, size_t data_len);
 
+  // Same as above, for a block of data held in a span, e.g. a mapping of a
+  // shared memory region. |data| must outlive this Pickle.
+  explicit Pickle(span<const uint8_t> data);
+
   // Initializes a Pickle as a deep copy of another Pickle.
   Pickle(const Pickle& other);
 
@@ -510,6 +510,39 @@ TEST(PickleTest, ReadBytes) {
   EXPECT_EQ(data, outdata);
 }
 
+// Checks that the span accessors point into the buffer of a Pickle which
+// borrows its data.
+TEST(PickleTest, ReadSpansFromBorrowedBuffer) {
+  Pickle source;
+  const uint8_t kData[] = {1, 2, 3, 4, 5};
+  const uint8_t kBytes[] = {6, 7, 8};
+  source.WriteData(reinterpret_cast<const char*>(kData), sizeof(kData));
+  source.WriteBytes(kBytes, sizeof(kBytes));
+
+  span<const uint8_t> buffer(static_cast<const uint8_t*>(source.data()),
+                             source.size());
+  Pickle pickle(buffer);
+  EXPECT_EQ(source.size(), pickle.size());
+  EXPECT_EQ(0u, pickle.GetTotalAllocatedSize());
+
+  PickleIterator iter(pickle);
+  span<const uint8_t> data;
+  ASSERT_TRUE(iter.ReadData(&data));
+  ASSERT_EQ(sizeof(kData), data.size());
+  EXPECT_EQ(0, memcmp(kData, data.data(), sizeof(kData)));
+  EXPECT_GE(data.data(), buffer.data());
+  EXPECT_LE(data.data() + data.size(), buffer.data() + buffer.size());
+
+  span<const uint8_t> bytes;
+  ASSERT_TRUE(iter.ReadBytes(&bytes, sizeof(kBytes)));
+  ASSERT_EQ(sizeof(kBytes), bytes.size());
+  EXPECT_EQ(0, memcmp(kBytes, bytes.data(), sizeof(kBytes)));
+
+  EXPECT_FALSE(iter.ReadBytes(&bytes, 1));
+  EXPECT_FALSE(iter.ReadData(&data));
+  EXPECT_TRUE(data.empty());
+}
+
 // Checks that when a pickle is deep-copied, the result is not larger than
 // needed.
 TEST(PickleTest, DeepCopyResize) {
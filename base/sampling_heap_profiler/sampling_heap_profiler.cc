@@ -169,18 +169,22 @@ void SamplingHeapProfiler::SampleAdded(
     PoissonAllocationSampler::AllocatorType type,
     const char* context) {
   DCHECK(PoissonAllocationSampler::ScopedMuteThreadSamples::IsMuted());
-  AutoLock lock(mutex_);
-  Sample sample(size, total, ++last_sample_ordinal_);
+  Sample sample(size, total, 0);
   sample.allocator = type;
   using CaptureMode = trace_event::AllocationContextTracker::CaptureMode;
   CaptureMode capture_mode =
       trace_event::AllocationContextTracker::capture_mode();
-  if (capture_mode == CaptureMode::PSEUDO_STACK ||
-      capture_mode == CaptureMode::MIXED_STACK) {
-    CaptureMixedStack(context, &sample);
-  } else {
+  bool mixed_stack = capture_mode == CaptureMode::PSEUDO_STACK ||
+                     capture_mode == CaptureMode::MIXED_STACK;
+  // Unwinding the native stack does not touch the profiler state, so do it
+  // before taking |mutex_| to keep threads sampling at the same time from
+  // serializing on the unwinder.
+  if (!mixed_stack)
     CaptureNativeStack(context, &sample);
-  }
+  AutoLock lock(mutex_);
+  if (mixed_stack)
+    CaptureMixedStack(context, &sample);
+  sample.ordinal = ++last_sample_ordinal_;
   RecordString(sample.context);
   samples_.emplace(address, std::move(sample));
 }
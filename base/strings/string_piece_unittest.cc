@@ -481,6 +481,27 @@ TYPED_TEST(CommonStringPieceTest, CheckFind) {
   ASSERT_EQ(d.substr(99, 99), e);
 }
 
+// Short sets of characters are searched a block at a time, so check matches
+// at every position of strings longer than a few blocks.
+TYPED_TEST(CommonStringPieceTest, FindFirstOfLongString) {
+  typedef BasicStringPiece<TypeParam> Piece;
+
+  const TypeParam filler(TestFixture::as_string(std::string(70, 'x')));
+  for (const char* set : {",;", "=; \t", ",;:=/ ?&", ",;:=/ ?&#@"}) {
+    const TypeParam one_of(TestFixture::as_string(set));
+    EXPECT_EQ(Piece::npos, Piece(filler).find_first_of(one_of));
+
+    for (size_t pos = 0; pos < filler.size(); ++pos) {
+      TypeParam str = filler;
+      str[pos] = one_of.back();
+      const Piece piece(str);
+      EXPECT_EQ(pos, piece.find_first_of(one_of));
+      EXPECT_EQ(pos, piece.find_first_of(one_of, pos));
+      EXPECT_EQ(Piece::npos, piece.find_first_of(one_of, pos + 1));
+    }
+  }
+}
+
 TYPED_TEST(CommonStringPieceTest, CheckCustom) {
   TypeParam foobar(TestFixture::as_string("foobar"));
   BasicStringPiece<TypeParam> a(foobar);
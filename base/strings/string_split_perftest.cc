@@ -0,0 +1,102 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/strings/string_split.h"
+
+#include <stddef.h>
+
+#include <string>
+#include <vector>
+
+#include "base/strings/string_piece.h"
+#include "base/strings/string_tokenizer.h"
+#include "base/strings/string_util.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+
+namespace {
+
+// Number of times each line is parsed.
+constexpr size_t kIterationCount = 100000;
+
+// Typical request headers: a cookie line, a list valued header and an
+// Accept header with parameters.
+const char kCookieLine[] =
+    "SID=31d4d96e407aad42; lang=en-US; _ga=GA1.2.1234567890.1550000000; "
+    "_gid=GA1.2.987654321.1550000000; session_token=a3fWa0b1c2d3e4f5g6h7; "
+    "prefs=theme%3Ddark%26layout%3Dcompact; consent=yes";
+const char kListHeader[] =
+    "gzip, deflate, br, compress, identity, x-gzip, x-custom-encoding-name";
+const char kAcceptHeader[] =
+    "text/html,application/xhtml+xml,application/xml;q=0.9,image/webp,"
+    "image/apng,*/*;q=0.8,application/signed-exchange;v=b3";
+
+void PrintResult(const char* measurement,
+                 const char* story,
+                 StringPiece line,
+                 TimeDelta elapsed) {
+  perf_test::PrintResult(
+      measurement, "", story,
+      elapsed.InNanoseconds() /
+          static_cast<double>(kIterationCount * line.size()),
+      "ns/byte", true);
+}
+
+void RunSplitTest(const char* story, StringPiece line, StringPiece delimiters) {
+  size_t total_count = 0;
+  TimeTicks begin = TimeTicks::Now();
+  for (size_t i = 0; i < kIterationCount; ++i) {
+    total_count += SplitStringPiece(line, delimiters, TRIM_WHITESPACE,
+                                    SPLIT_WANT_NONEMPTY)
+                       .size();
+  }
+  PrintResult("SplitStringPiece", story, line, TimeTicks::Now() - begin);
+  EXPECT_NE(0u, total_count);
+}
+
+void RunTokenizerTest(const char* story,
+                      const std::string& line,
+                      const std::string& delimiters) {
+  size_t total_count = 0;
+  TimeTicks begin = TimeTicks::Now();
+  for (size_t i = 0; i < kIterationCount; ++i) {
+    StringTokenizer tokenizer(line, delimiters);
+    while (tokenizer.GetNext())
+      ++total_count;
+  }
+  PrintResult("StringTokenizer", story, line, TimeTicks::Now() - begin);
+  EXPECT_NE(0u, total_count);
+}
+
+void RunReplaceCharsTest(const char* story,
+                         const std::string& line,
+                         StringPiece replace_chars) {
+  std::string output;
+  TimeTicks begin = TimeTicks::Now();
+  for (size_t i = 0; i < kIterationCount; ++i)
+    ReplaceChars(line, replace_chars, "_", &output);
+  PrintResult("ReplaceChars", story, line, TimeTicks::Now() - begin);
+  EXPECT_EQ(line.size(), output.size());
+}
+
+}  // namespace
+
+TEST(StringSplitPerfTest, Cookie) {
+  RunSplitTest("cookie", kCookieLine, ";");
+  RunSplitTest("cookie_pairs", kCookieLine, ";=");
+  RunTokenizerTest("cookie", kCookieLine, "; =");
+  RunReplaceCharsTest("cookie", kCookieLine, "\r\n\t");
+}
+
+TEST(StringSplitPerfTest, Header) {
+  RunSplitTest("list_header", kListHeader, ",");
+  RunSplitTest("accept_header", kAcceptHeader, ",;");
+  RunTokenizerTest("accept_header", kAcceptHeader, ",;=");
+  RunReplaceCharsTest("accept_header", kAcceptHeader, "\r\n\t");
+}
+
+}  // namespace base
@@ -12,6 +12,26 @@
 
 namespace base {
 
+namespace internal {
+
+// Returns the offset of the first character of [begin, end) that is in
+// |delims|, or end - begin if there is none. Narrow strings are searched with
+// StringPiece, which compares whole blocks of characters with short delimiter
+// sets.
+inline size_t FindDelimiter(const char* begin,
+                            const char* end,
+                            const std::string& delims) {
+  const size_t length = end - begin;
+  return std::min(StringPiece(begin, length).find_first_of(delims), length);
+}
+
+template <typename Char, typename Str>
+size_t FindDelimiter(const Char* begin, const Char* end, const Str& delims) {
+  return std::find_first_of(begin, end, delims.begin(), delims.end()) - begin;
+}
+
+}  // namespace internal
+
 // StringTokenizerT is a simple string tokenizer class.  It works like an
 // iterator that with each step (see the Advance method) updates members that
 // refer to the next token in the input string.  The user may optionally
@@ -185,8 +205,11 @@ class StringTokenizerT {
         break;
       // else skip over delimiter.
     }
-    while (token_end_ != end_ && delims_.find(*token_end_) == str::npos)
-      ++token_end_;
+    if (token_end_ != end_) {
+      const char_type* const chars = &*token_end_;
+      token_end_ += internal::FindDelimiter(
+          chars, chars + std::distance(token_end_, end_), delims_);
+    }
     return true;
   }
 
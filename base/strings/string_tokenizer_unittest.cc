@@ -253,6 +253,23 @@ TEST(StringTokenizerTest, ManyDelims) {
   EXPECT_FALSE(t.GetNext());
 }
 
+TEST(StringTokenizerTest, LongTokens) {
+  const string long_token(100, 'x');
+  string input = long_token + ", " + long_token + "x;" + long_token + "xx";
+  StringTokenizer t(input, ", ;");
+
+  EXPECT_TRUE(t.GetNext());
+  EXPECT_EQ(long_token, t.token());
+
+  EXPECT_TRUE(t.GetNext());
+  EXPECT_EQ(long_token + "x", t.token());
+
+  EXPECT_TRUE(t.GetNext());
+  EXPECT_EQ(long_token + "xx", t.token());
+
+  EXPECT_FALSE(t.GetNext());
+}
+
 TEST(StringTokenizerTest, ParseHeader) {
   string input = "Content-Type: text/html ; charset=UTF-8";
   StringTokenizer t(input, ": ;=");
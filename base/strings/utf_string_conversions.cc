@@ -16,6 +16,12 @@
 #include "base/third_party/icu/icu_utf.h"
 #include "build/build_config.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(ARCH_CPU_ARM64)
+#include <arm_neon.h>
+#endif
+
 namespace base {
 
 namespace {
@@ -85,6 +91,127 @@ void UnicodeAppendUnsafe(Char* out, int32_t* size, uint32_t code_point) {
   out[(*size)++] = code_point;
 }
 
+// ConvertASCIIPrefix ---------------------------------------------------------
+// Copies the longest ASCII prefix of [src, src + src_len) to dest, which has to
+// have enough room for it, and returns its length. Natural language text
+// usually has long runs of ASCII (markup, URLs, spaces and punctuation), which
+// this converts 16 code units at a time instead of going through the
+// code point decoding and encoding.
+
+// Number of code units converted at once by the block loops below.
+constexpr int32_t kASCIIBlockSize = 16;
+
+template <typename SrcChar, typename DestChar>
+int32_t ConvertASCIITail(const SrcChar* src,
+                         int32_t begin,
+                         int32_t src_len,
+                         DestChar* dest) {
+  int32_t i = begin;
+  while (i < src_len && static_cast<std::make_unsigned_t<SrcChar>>(src[i]) <
+                            0x80) {
+    dest[i] = static_cast<DestChar>(src[i]);
+    ++i;
+  }
+  return i;
+}
+
+// Portable version, testing 16 code units at a time for non-ASCII bits and
+// letting the compiler vectorize the copy.
+template <typename SrcChar, typename DestChar>
+int32_t ConvertASCIIPrefix(const SrcChar* src,
+                           int32_t src_len,
+                           DestChar* dest) {
+  using UnsignedSrcChar = std::make_unsigned_t<SrcChar>;
+  constexpr UnsignedSrcChar kNonASCIIMask =
+      static_cast<UnsignedSrcChar>(~UnsignedSrcChar(0x7F));
+  int32_t i = 0;
+  for (; i + kASCIIBlockSize <= src_len; i += kASCIIBlockSize) {
+    UnsignedSrcChar all_char_bits = 0;
+    for (int32_t j = 0; j < kASCIIBlockSize; ++j)
+      all_char_bits |= static_cast<UnsignedSrcChar>(src[i + j]);
+    if (all_char_bits & kNonASCIIMask)
+      break;
+    for (int32_t j = 0; j < kASCIIBlockSize; ++j)
+      dest[i + j] = static_cast<DestChar>(src[i + j]);
+  }
+  return ConvertASCIITail(src, i, src_len, dest);
+}
+
+#if defined(__SSE2__)
+
+// UTF-8 to UTF-16: zero-extends 16 bytes to 16 code units.
+template <>
+int32_t ConvertASCIIPrefix(const char* src, int32_t src_len, char16* dest) {
+  const __m128i zero = _mm_setzero_si128();
+  int32_t i = 0;
+  for (; i + kASCIIBlockSize <= src_len; i += kASCIIBlockSize) {
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    if (_mm_movemask_epi8(bytes))
+      break;
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i),
+                     _mm_unpacklo_epi8(bytes, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i + 8),
+                     _mm_unpackhi_epi8(bytes, zero));
+  }
+  return ConvertASCIITail(src, i, src_len, dest);
+}
+
+// UTF-16 to UTF-8: narrows 16 code units to 16 bytes.
+template <>
+int32_t ConvertASCIIPrefix(const char16* src, int32_t src_len, char* dest) {
+  const __m128i non_ascii_mask = _mm_set1_epi16(static_cast<int16_t>(0xFF80));
+  const __m128i zero = _mm_setzero_si128();
+  int32_t i = 0;
+  for (; i + kASCIIBlockSize <= src_len; i += kASCIIBlockSize) {
+    __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    __m128i high =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 8));
+    __m128i non_ascii_bits =
+        _mm_and_si128(_mm_or_si128(low, high), non_ascii_mask);
+    if (_mm_movemask_epi8(_mm_cmpeq_epi16(non_ascii_bits, zero)) != 0xFFFF)
+      break;
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i),
+                     _mm_packus_epi16(low, high));
+  }
+  return ConvertASCIITail(src, i, src_len, dest);
+}
+
+#elif defined(__ARM_NEON) && defined(ARCH_CPU_ARM64)
+
+// UTF-8 to UTF-16: zero-extends 16 bytes to 16 code units.
+template <>
+int32_t ConvertASCIIPrefix(const char* src, int32_t src_len, char16* dest) {
+  int32_t i = 0;
+  for (; i + kASCIIBlockSize <= src_len; i += kASCIIBlockSize) {
+    uint8x16_t bytes = vld1q_u8(reinterpret_cast<const uint8_t*>(src + i));
+    if (vmaxvq_u8(bytes) >= 0x80)
+      break;
+    vst1q_u16(reinterpret_cast<uint16_t*>(dest + i),
+              vmovl_u8(vget_low_u8(bytes)));
+    vst1q_u16(reinterpret_cast<uint16_t*>(dest + i + 8),
+              vmovl_high_u8(bytes));
+  }
+  return ConvertASCIITail(src, i, src_len, dest);
+}
+
+// UTF-16 to UTF-8: narrows 16 code units to 16 bytes.
+template <>
+int32_t ConvertASCIIPrefix(const char16* src, int32_t src_len, char* dest) {
+  int32_t i = 0;
+  for (; i + kASCIIBlockSize <= src_len; i += kASCIIBlockSize) {
+    uint16x8_t low = vld1q_u16(reinterpret_cast<const uint16_t*>(src + i));
+    uint16x8_t high =
+        vld1q_u16(reinterpret_cast<const uint16_t*>(src + i + 8));
+    if (vmaxvq_u16(vorrq_u16(low, high)) >= 0x80)
+      break;
+    vst1q_u8(reinterpret_cast<uint8_t*>(dest + i),
+             vcombine_u8(vmovn_u16(low), vmovn_u16(high)));
+  }
+  return ConvertASCIITail(src, i, src_len, dest);
+}
+
+#endif
+
 // DoUTFConversion ------------------------------------------------------------
 // Main driver of UTFConversion specialized for different Src encodings.
 // dest has to have enough room for the converted text.
@@ -97,6 +224,14 @@ bool DoUTFConversion(const char* src,
   bool success = true;
 
   for (int32_t i = 0; i < src_len;) {
+    if (CBU8_IS_SINGLE(src[i])) {
+      const int32_t ascii_len =
+          ConvertASCIIPrefix(src + i, src_len - i, dest + *dest_len);
+      i += ascii_len;
+      *dest_len += ascii_len;
+      continue;
+    }
+
     int32_t code_point;
     CBU8_NEXT(src, i, src_len, code_point);
 
@@ -131,6 +266,14 @@ bool DoUTFConversion(const char16* src,
   // Always have another symbol in order to avoid checking boundaries in the
   // middle of the surrogate pair.
   while (i < src_len - 1) {
+    if (src[i] < 0x80) {
+      const int32_t ascii_len =
+          ConvertASCIIPrefix(src + i, src_len - i, dest + *dest_len);
+      i += ascii_len;
+      *dest_len += ascii_len;
+      continue;
+    }
+
     int32_t code_point;
 
     if (CBU16_IS_LEAD(src[i]) && CBU16_IS_TRAIL(src[i + 1])) {
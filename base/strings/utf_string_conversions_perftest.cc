@@ -0,0 +1,87 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/strings/utf_string_conversions.h"
+
+#include <stddef.h>
+
+#include <string>
+
+#include "base/strings/string16.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+
+namespace {
+
+// Size, in UTF-8 bytes, of each corpus.
+constexpr size_t kCorpusSize = 1 << 16;
+
+// Number of times each corpus is converted.
+constexpr size_t kIterationCount = 1000;
+
+// Returns |pattern| repeated until the result is about |kCorpusSize| bytes.
+std::string MakeCorpus(const char* pattern) {
+  std::string corpus;
+  while (corpus.size() < kCorpusSize)
+    corpus += pattern;
+  return corpus;
+}
+
+void RunConversionTest(const std::string& corpus_name,
+                       const std::string& utf8) {
+  const string16 utf16 = UTF8ToUTF16(utf8);
+  const double megabytes = utf8.size() * kIterationCount / (1024.0 * 1024.0);
+
+  size_t total_size = 0;
+  TimeTicks begin = TimeTicks::Now();
+  for (size_t i = 0; i < kIterationCount; ++i)
+    total_size += UTF8ToUTF16(utf8).size();
+  TimeDelta elapsed = TimeTicks::Now() - begin;
+  EXPECT_EQ(utf16.size() * kIterationCount, total_size);
+  perf_test::PrintResult("UTF8ToUTF16", "", corpus_name,
+                         megabytes / elapsed.InSecondsF(), "MB/s", true);
+
+  total_size = 0;
+  begin = TimeTicks::Now();
+  for (size_t i = 0; i < kIterationCount; ++i)
+    total_size += UTF16ToUTF8(utf16).size();
+  elapsed = TimeTicks::Now() - begin;
+  EXPECT_EQ(utf8.size() * kIterationCount, total_size);
+  perf_test::PrintResult("UTF16ToUTF8", "", corpus_name,
+                         megabytes / elapsed.InSecondsF(), "MB/s", true);
+}
+
+}  // namespace
+
+TEST(UTFStringConversionsPerfTest, ASCII) {
+  RunConversionTest(
+      "ascii", MakeCorpus("<a href=\"https://www.example.com/\">The quick "
+                          "brown fox jumps over the lazy dog.</a>\n"));
+}
+
+TEST(UTFStringConversionsPerfTest, Latin) {
+  RunConversionTest("latin",
+                    MakeCorpus("Voix ambigu\xC3\xAB d'un c\xC5\x93ur qui, au "
+                               "z\xC3\xA9phyr, pr\xC3\xA9" "f\xC3\xA8re les "
+                               "jattes de kiwis. "));
+}
+
+TEST(UTFStringConversionsPerfTest, CJK) {
+  RunConversionTest("cjk",
+                    MakeCorpus("\xE6\x97\xA5\xE6\x9C\xAC\xE8\xAA\x9E\xE3\x81"
+                               "\xAE\xE6\x96\x87\xE7\xAB\xA0\xE4\xB8\xAD\xE6"
+                               "\x96\x87\xE5\xAD\x97\xE7\xAC\xA6"));
+}
+
+// Markup with CJK text, plus characters outside of the BMP.
+TEST(UTFStringConversionsPerfTest, Mixed) {
+  RunConversionTest("mixed",
+                    MakeCorpus("<p class=\"title\">\xE6\x97\xA5\xE6\x9C\xAC"
+                               "\xE8\xAA\x9E \xF0\x9F\x98\x80</p>\n"));
+}
+
+}  // namespace base
@@ -205,4 +205,38 @@ TEST(UTFStringConversionsTest, ConvertMultiString) {
   EXPECT_EQ(expected, converted);
 }
 
+// The conversions copy runs of ASCII in blocks, so check non-ASCII characters
+// at every position around the block boundaries.
+TEST(UTFStringConversionsTest, ConvertASCIIRuns) {
+  const std::string ascii = "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJ";
+  for (size_t pos = 0; pos <= ascii.size(); ++pos) {
+    // U+00E9, U+597D and U+1F600, which take 2, 3 and 4 bytes in UTF-8.
+    for (const char* non_ascii :
+         {"\xc3\xa9", "\xe5\xa5\xbd", "\xf0\x9f\x98\x80"}) {
+      std::string utf8 = ascii;
+      utf8.insert(pos, non_ascii);
+      utf8 += non_ascii;
+      utf8 += ascii;
+
+      string16 utf16;
+      EXPECT_TRUE(UTF8ToUTF16(utf8.data(), utf8.size(), &utf16));
+      EXPECT_EQ(ASCIIToUTF16(ascii.substr(0, pos)), utf16.substr(0, pos));
+      EXPECT_EQ(ASCIIToUTF16(ascii), utf16.substr(utf16.size() - ascii.size()));
+      EXPECT_EQ(UTF8ToWide(utf8), UTF16ToWide(utf16));
+
+      std::string converted;
+      EXPECT_TRUE(UTF16ToUTF8(utf16.data(), utf16.size(), &converted));
+      EXPECT_EQ(utf8, converted);
+    }
+
+    // Invalid sequences are still replaced after an ASCII run.
+    std::string invalid = ascii;
+    invalid.insert(pos, "\xff");
+    string16 utf16;
+    EXPECT_FALSE(UTF8ToUTF16(invalid.data(), invalid.size(), &utf16));
+    EXPECT_EQ(ascii.size() + 1, utf16.size());
+    EXPECT_EQ(0xFFFD, utf16[pos]);
+  }
+}
+
 }  // namespace base
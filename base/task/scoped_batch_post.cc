@@ -0,0 +1,36 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/task/scoped_batch_post.h"
+
+#include <utility>
+
+#include "base/logging.h"
+
+namespace base {
+
+ScopedBatchPost::ScopedBatchPost(const Location& from_here,
+                                 scoped_refptr<TaskRunner> task_runner)
+    : from_here_(from_here), task_runner_(std::move(task_runner)) {
+  DCHECK(task_runner_);
+}
+
+ScopedBatchPost::~ScopedBatchPost() {
+  Flush();
+}
+
+void ScopedBatchPost::Post(OnceClosure task) {
+  DCHECK(task);
+  tasks_.push_back(std::move(task));
+}
+
+bool ScopedBatchPost::Flush() {
+  if (tasks_.empty())
+    return true;
+  std::vector<OnceClosure> tasks;
+  tasks.swap(tasks_);
+  return task_runner_->PostTasks(from_here_, std::move(tasks));
+}
+
+}  // namespace base
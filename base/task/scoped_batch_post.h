@@ -0,0 +1,56 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_TASK_SCOPED_BATCH_POST_H_
+#define BASE_TASK_SCOPED_BATCH_POST_H_
+
+#include <vector>
+
+#include "base/base_export.h"
+#include "base/callback.h"
+#include "base/location.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/task_runner.h"
+
+namespace base {
+
+// Collects tasks and posts them to a TaskRunner as a single batch via
+// TaskRunner::PostTasks() when Flush() is called or when this goes out of
+// scope. Useful to fan out many tasks to the same sequence with one lock
+// round-trip and one wake-up. Not thread-safe.
+//
+// Example:
+//   {
+//     ScopedBatchPost batch(FROM_HERE, task_runner);
+//     for (auto& item : items)
+//       batch.Post(BindOnce(&Process, item));
+//   }  // All tasks are posted here.
+class BASE_EXPORT ScopedBatchPost {
+ public:
+  ScopedBatchPost(const Location& from_here,
+                  scoped_refptr<TaskRunner> task_runner);
+  ~ScopedBatchPost();
+
+  // Adds |task| to the batch. It won't be posted before Flush() or the
+  // destructor is called.
+  void Post(OnceClosure task);
+
+  // Posts all tasks added since the last flush. Returns false if at least one
+  // of them definitely won't run.
+  bool Flush();
+
+  size_t size() const { return tasks_.size(); }
+
+ private:
+  const Location from_here_;
+  const scoped_refptr<TaskRunner> task_runner_;
+  std::vector<OnceClosure> tasks_;
+
+  DISALLOW_COPY_AND_ASSIGN(ScopedBatchPost);
+};
+
+}  // namespace base
+
+#endif  // BASE_TASK_SCOPED_BATCH_POST_H_
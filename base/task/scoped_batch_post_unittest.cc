@@ -0,0 +1,56 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/task/scoped_batch_post.h"
+
+#include <vector>
+
+#include "base/bind.h"
+#include "base/test/test_simple_task_runner.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+namespace {
+
+void AppendValue(std::vector<int>* values, int value) {
+  values->push_back(value);
+}
+
+}  // namespace
+
+TEST(ScopedBatchPostTest, PostsOnDestruction) {
+  auto task_runner = MakeRefCounted<TestSimpleTaskRunner>();
+  std::vector<int> values;
+  {
+    ScopedBatchPost batch(FROM_HERE, task_runner);
+    batch.Post(BindOnce(&AppendValue, &values, 1));
+    batch.Post(BindOnce(&AppendValue, &values, 2));
+    EXPECT_EQ(2u, batch.size());
+    EXPECT_FALSE(task_runner->HasPendingTask());
+  }
+  EXPECT_EQ(2u, task_runner->NumPendingTasks());
+
+  task_runner->RunUntilIdle();
+  EXPECT_EQ(std::vector<int>({1, 2}), values);
+}
+
+TEST(ScopedBatchPostTest, Flush) {
+  auto task_runner = MakeRefCounted<TestSimpleTaskRunner>();
+  std::vector<int> values;
+  ScopedBatchPost batch(FROM_HERE, task_runner);
+  batch.Post(BindOnce(&AppendValue, &values, 1));
+  EXPECT_TRUE(batch.Flush());
+  EXPECT_EQ(0u, batch.size());
+  EXPECT_EQ(1u, task_runner->NumPendingTasks());
+
+  // Flushing an empty batch posts nothing.
+  EXPECT_TRUE(batch.Flush());
+  EXPECT_EQ(1u, task_runner->NumPendingTasks());
+
+  task_runner->RunUntilIdle();
+  EXPECT_EQ(std::vector<int>({1}), values);
+}
+
+}  // namespace base
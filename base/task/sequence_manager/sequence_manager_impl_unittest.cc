@@ -7,6 +7,7 @@
 #include <stddef.h>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "base/auto_reset.h"
 #include "base/bind.h"
@@ -593,6 +594,22 @@ TEST_P(SequenceManagerTest, SingleQueuePosting) {
   EXPECT_THAT(run_order, ElementsAre(1u, 2u, 3u));
 }
 
+TEST_P(SequenceManagerTest, SingleQueueBatchPosting) {
+  auto queue = CreateTaskQueue();
+
+  std::vector<EnqueueOrder> run_order;
+  queue->task_runner()->PostTask(FROM_HERE, BindOnce(&TestTask, 1, &run_order));
+  std::vector<OnceClosure> tasks;
+  tasks.push_back(BindOnce(&TestTask, 2, &run_order));
+  tasks.push_back(BindOnce(&TestTask, 3, &run_order));
+  tasks.push_back(BindOnce(&TestTask, 4, &run_order));
+  EXPECT_TRUE(queue->task_runner()->PostTasks(FROM_HERE, std::move(tasks)));
+  queue->task_runner()->PostTask(FROM_HERE, BindOnce(&TestTask, 5, &run_order));
+
+  RunLoop().RunUntilIdle();
+  EXPECT_THAT(run_order, ElementsAre(1u, 2u, 3u, 4u, 5u));
+}
+
 TEST_P(SequenceManagerTest, MultiQueuePosting) {
   auto queues = CreateTaskQueues(3u);
 
@@ -1456,6 +1473,54 @@ TEST_P(SequenceManagerTest, PostFromThread) {
   EXPECT_THAT(run_order, ElementsAre(1u));
 }
 
+void PostManyTasksToRunner(scoped_refptr<TestTaskQueue> runner,
+                           int thread_id,
+                           int num_tasks,
+                           std::vector<std::pair<int, int>>* run_order) {
+  for (int i = 0; i < num_tasks; i++) {
+    runner->task_runner()->PostTask(
+        FROM_HERE, BindOnce(
+                       [](std::vector<std::pair<int, int>>* run_order,
+                          int thread_id, int i) {
+                         run_order->emplace_back(thread_id, i);
+                       },
+                       run_order, thread_id, i));
+  }
+}
+
+TEST_P(SequenceManagerTest, PostFromManyThreadsConcurrently) {
+  auto queue = CreateTaskQueue();
+  constexpr int kNumThreads = 4;
+  constexpr int kNumTasksPerThread = 1000;
+
+  // Tasks only run on the main thread, so |run_order| needs no lock.
+  std::vector<std::pair<int, int>> run_order;
+  std::vector<std::unique_ptr<Thread>> threads;
+  for (int i = 0; i < kNumThreads; i++) {
+    threads.push_back(std::make_unique<Thread>("TestThread"));
+    threads.back()->Start();
+  }
+  for (int i = 0; i < kNumThreads; i++) {
+    threads[i]->task_runner()->PostTask(
+        FROM_HERE, BindOnce(&PostManyTasksToRunner, queue, i,
+                            kNumTasksPerThread, &run_order));
+  }
+  for (auto& thread : threads)
+    thread->Stop();
+
+  RunLoop().RunUntilIdle();
+
+  // All tasks must run, and tasks posted from the same thread must run in
+  // posting order.
+  ASSERT_EQ(static_cast<size_t>(kNumThreads * kNumTasksPerThread),
+            run_order.size());
+  std::vector<int> next_task(kNumThreads, 0);
+  for (const auto& thread_and_task : run_order) {
+    EXPECT_EQ(next_task[thread_and_task.first], thread_and_task.second);
+    next_task[thread_and_task.first]++;
+  }
+}
+
 void RePostingTestTask(scoped_refptr<TestTaskQueue> runner, int* run_count) {
   (*run_count)++;
   runner->task_runner()->PostTask(
@@ -5,6 +5,7 @@
 #include "base/task/sequence_manager/sequence_manager.h"
 
 #include <stddef.h>
+#include <atomic>
 #include <memory>
 
 #include "base/bind.h"
@@ -582,6 +583,81 @@ class TwoThreadTestCase : public TestCase {
   int done_count_ = 0;
 };
 
+// Posts tasks to a single queue from several threads and measures how long the
+// posting threads spend in PostTask().
+class ManyThreadsPostTestCase : public TestCase {
+ public:
+  ManyThreadsPostTestCase(PerfTestDelegate* delegate,
+                          scoped_refptr<TaskRunner> task_runner,
+                          size_t num_threads)
+      : TestCase(delegate),
+        task_runner_(std::move(task_runner)),
+        num_tasks_per_thread_(kNumTasks / num_threads),
+        task_closure_(BindRepeating(&ManyThreadsPostTestCase::TestTask,
+                                    Unretained(this))) {
+    for (size_t i = 0; i < num_threads; i++) {
+      posting_threads_.push_back(
+          std::make_unique<Thread>(StringPrintf("posting thread %zu", i)));
+      posting_threads_.back()->Start();
+    }
+  }
+
+  ~ManyThreadsPostTestCase() override {
+    for (auto& thread : posting_threads_)
+      thread->Stop();
+  }
+
+  void Start() override {
+    total_post_time_us_ = 0;
+    num_tasks_to_run_ = num_tasks_per_thread_ * posting_threads_.size();
+    num_tasks_in_flight_ = 0;
+    for (auto& thread : posting_threads_) {
+      thread->task_runner()->PostTask(
+          FROM_HERE, BindOnce(&ManyThreadsPostTestCase::PostTasks,
+                              Unretained(this)));
+    }
+  }
+
+  // Average time spent in PostTask() by a posting thread.
+  double GetPostLatencyInMicroseconds() const {
+    return total_post_time_us_ /
+           static_cast<double>(num_tasks_per_thread_ * posting_threads_.size());
+  }
+
+ private:
+  void PostTasks() {
+    TimeDelta post_time;
+    for (size_t i = 0; i < num_tasks_per_thread_; i++) {
+      while (num_tasks_in_flight_.load(std::memory_order_acquire) >
+             kMaxTasksInFlight) {
+        PlatformThread::YieldCurrentThread();
+      }
+      num_tasks_in_flight_++;
+      TimeTicks start = TimeTicks::Now();
+      task_runner_->PostTask(FROM_HERE, task_closure_);
+      post_time += TimeTicks::Now() - start;
+    }
+    total_post_time_us_ += post_time.InMicroseconds();
+  }
+
+  // Will be called on the main thread.
+  void TestTask() {
+    num_tasks_in_flight_--;
+    if (num_tasks_to_run_.fetch_sub(1) == 1)
+      delegate_->SignalDone();
+  }
+
+  static constexpr unsigned int kMaxTasksInFlight = 200;
+
+  const scoped_refptr<TaskRunner> task_runner_;
+  const size_t num_tasks_per_thread_;
+  const RepeatingClosure task_closure_;
+  std::vector<std::unique_ptr<Thread>> posting_threads_;
+  std::atomic<int64_t> total_post_time_us_{0};
+  std::atomic<unsigned int> num_tasks_in_flight_{0};
+  std::atomic<size_t> num_tasks_to_run_{0};
+};
+
 class SequenceManagerPerfTest : public testing::TestWithParam<PerfTestType> {
  public:
   SequenceManagerPerfTest() = default;
@@ -819,6 +895,18 @@ TEST_P(SequenceManagerPerfTest,
             &task_source);
 }
 
+TEST_P(SequenceManagerPerfTest, PostImmediateTasksFromFourThreads_OneQueue) {
+  ManyThreadsPostTestCase task_source(delegate_.get(),
+                                      delegate_->CreateTaskRunner(), 4);
+  Benchmark("post immediate tasks with one queue from four threads",
+            &task_source);
+  perf_test::PrintResult(
+      "post_latency", "",
+      std::string("post immediate tasks with one queue from four threads") +
+          delegate_->GetName(),
+      task_source.GetPostLatencyInMicroseconds(), "us/task", true);
+}
+
 // TODO(alexclarke): Add additional tests with different mixes of non-delayed vs
 // delayed tasks.
 
@@ -4,8 +4,10 @@
 
 #include "base/task/sequence_manager/task_queue_impl.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "base/strings/stringprintf.h"
 #include "base/task/sequence_manager/sequence_manager_impl.h"
@@ -57,6 +59,16 @@ bool TaskQueueImpl::GuardedTaskPoster::PostTask(PostedTask task) {
   return true;
 }
 
+bool TaskQueueImpl::GuardedTaskPoster::PostTasks(
+    std::vector<PostedTask> tasks) {
+  auto token = operations_controller_.TryBeginOperation();
+  if (!token)
+    return false;
+
+  outer_->PostTasks(std::move(tasks));
+  return true;
+}
+
 TaskQueueImpl::TaskRunner::TaskRunner(
     scoped_refptr<GuardedTaskPoster> task_poster,
     scoped_refptr<AssociatedThreadId> associated_thread,
@@ -82,6 +94,17 @@ bool TaskQueueImpl::TaskRunner::PostNonNestableDelayedTask(
                                            Nestable::kNonNestable, task_type_));
 }
 
+bool TaskQueueImpl::TaskRunner::PostTasks(const Location& location,
+                                          std::vector<OnceClosure> callbacks) {
+  std::vector<PostedTask> tasks;
+  tasks.reserve(callbacks.size());
+  for (OnceClosure& callback : callbacks) {
+    tasks.emplace_back(std::move(callback), location, TimeDelta(),
+                       Nestable::kNestable, task_type_);
+  }
+  return task_poster_->PostTasks(std::move(tasks));
+}
+
 bool TaskQueueImpl::TaskRunner::RunsTasksInCurrentSequence() const {
   return associated_thread_->IsBoundToCurrentThread();
 }
@@ -112,6 +135,7 @@ TaskQueueImpl::TaskQueueImpl(SequenceManagerImpl* sequence_manager,
 }
 
 TaskQueueImpl::~TaskQueueImpl() {
+  DCHECK(!posted_tasks_head_.load());
 #if DCHECK_IS_ON()
   AutoLock lock(any_thread_lock_);
   // NOTE this check shouldn't fire because |SequenceManagerImpl::queues_|
@@ -142,6 +166,12 @@ TaskQueueImpl::MainThreadOnly::MainThreadOnly(TaskQueueImpl* task_queue,
 
 TaskQueueImpl::MainThreadOnly::~MainThreadOnly() = default;
 
+TaskQueueImpl::PostedTaskNode::PostedTaskNode(Task task,
+                                              EnqueueOrder sequence_order)
+    : task(std::move(task)), sequence_order(sequence_order) {}
+
+TaskQueueImpl::PostedTaskNode::~PostedTaskNode() = default;
+
 scoped_refptr<SingleThreadTaskRunner> TaskQueueImpl::CreateTaskRunner(
     int task_type) const {
   return MakeRefCounted<TaskRunner>(task_poster_, associated_thread_,
@@ -173,7 +203,8 @@ void TaskQueueImpl::UnregisterTaskQueue() {
 
     main_thread_only().on_next_wake_up_changed_callback =
         OnNextWakeUpChangedCallback();
-    immediate_incoming_queue.swap(immediate_incoming_queue_);
+    MovePostedTasksToImmediateIncomingQueueLocked();
+    TakeImmediateIncomingQueueTasksForDeletionLocked(&immediate_incoming_queue);
 
     empty_queues_to_reload_handle_.ReleaseAtomicFlag();
   }
@@ -215,52 +246,167 @@ void TaskQueueImpl::PostTask(PostedTask task) {
   }
 }
 
+void TaskQueueImpl::PostTasks(std::vector<PostedTask> tasks) {
+  CurrentThread current_thread =
+      associated_thread_->IsBoundToCurrentThread()
+          ? TaskQueueImpl::CurrentThread::kMainThread
+          : TaskQueueImpl::CurrentThread::kNotMainThread;
+
+  std::vector<PostedTask> immediate_tasks;
+  immediate_tasks.reserve(tasks.size());
+  for (PostedTask& task : tasks) {
+    if (task.delay.is_zero())
+      immediate_tasks.push_back(std::move(task));
+    else
+      PostDelayedTaskImpl(std::move(task), current_thread);
+  }
+  if (!immediate_tasks.empty())
+    PostImmediateTasksImpl(std::move(immediate_tasks), current_thread);
+}
+
 void TaskQueueImpl::PostImmediateTaskImpl(PostedTask task,
                                           CurrentThread current_thread) {
   // Use CHECK instead of DCHECK to crash earlier. See http://crbug.com/711167
   // for details.
   CHECK(task.callback);
 
-  TimeTicks now;
-  bool add_queue_time_to_tasks = sequence_manager_->GetAddQueueTimeToTasks();
-  if (delayed_fence_allowed_ || add_queue_time_to_tasks) {
-    if (current_thread == CurrentThread::kMainThread) {
-      now = main_thread_only().time_domain->Now();
-    } else {
-      AutoLock lock(any_thread_lock_);
-      now = any_thread().time_domain->Now();
-    }
-    if (add_queue_time_to_tasks) {
-      task.queue_time = now;
-    }
+  std::unique_ptr<PostedTaskNode> node = CreatePostedTaskNode(
+      std::move(task), GetImmediateTaskPostTime(current_thread));
+
+  // If this queue was completely empty, then the SequenceManager needs to be
+  // informed so it can reload the work queue and add us to the
+  // TaskQueueSelector which can only be done from the main thread. In
+  // addition it may need to schedule a DoWork if this queue isn't blocked.
+  // UpdateCrossThreadQueueStateLocked() covers a race with the main thread
+  // emptying |immediate_work_queue|.
+  if (PushOntoPostedTaskStack(std::move(node)))
+    OnImmediateIncomingQueueBecameNonEmpty();
+
+  TraceQueueSize();
+}
+
+void TaskQueueImpl::PostImmediateTasksImpl(std::vector<PostedTask> tasks,
+                                           CurrentThread current_thread) {
+  DCHECK(!tasks.empty());
+  const TimeTicks now = GetImmediateTaskPostTime(current_thread);
+
+  // Link the nodes so that the whole batch is published with one CAS. The
+  // order of the chain doesn't matter since the stack is sorted by sequence
+  // number when drained.
+  PostedTaskNode* first = nullptr;
+  PostedTaskNode* last = nullptr;
+  for (PostedTask& task : tasks) {
+    CHECK(task.callback);
+    PostedTaskNode* node =
+        CreatePostedTaskNode(std::move(task), now).release();
+    node->next = first;
+    first = node;
+    if (!last)
+      last = node;
   }
 
-  {
-    // TODO(alexclarke): Maybe add a main thread only immediate_incoming_queue
-    // See https://crbug.com/901800
-    AutoLock lock(immediate_incoming_queue_lock_);
-    // The sequence number must be incremented atomically with pushing onto the
-    // incoming queue. Otherwise if there are several threads posting task we
-    // risk breaking the assumption that sequence numbers increase monotonically
-    // within a queue.
-    EnqueueOrder sequence_number = sequence_manager_->GetNextSequenceNumber();
-    bool was_immediate_incoming_queue_empty = immediate_incoming_queue_.empty();
-    immediate_incoming_queue_.push_back(
-        Task(std::move(task), now, sequence_number, sequence_number));
-    sequence_manager_->WillQueueTask(&immediate_incoming_queue_.back());
-
-    // If this queue was completely empty, then the SequenceManager needs to be
-    // informed so it can reload the work queue and add us to the
-    // TaskQueueSelector which can only be done from the main thread. In
-    // addition it may need to schedule a DoWork if this queue isn't blocked.
-    if (was_immediate_incoming_queue_empty && immediate_work_queue_empty_) {
-      empty_queues_to_reload_handle_.SetActive(true);
-      if (post_immediate_task_should_schedule_work_)
-        sequence_manager_->ScheduleWork();
+  if (PushOntoPostedTaskStack(first, last, tasks.size()))
+    OnImmediateIncomingQueueBecameNonEmpty();
+
+  TraceQueueSize();
+}
+
+TimeTicks TaskQueueImpl::GetImmediateTaskPostTime(
+    CurrentThread current_thread) {
+  if (!delayed_fence_allowed_ && !sequence_manager_->GetAddQueueTimeToTasks())
+    return TimeTicks();
+  if (current_thread == CurrentThread::kMainThread)
+    return main_thread_only().time_domain->Now();
+  AutoLock lock(any_thread_lock_);
+  return any_thread().time_domain->Now();
+}
+
+std::unique_ptr<TaskQueueImpl::PostedTaskNode>
+TaskQueueImpl::CreatePostedTaskNode(PostedTask task, TimeTicks now) {
+  if (sequence_manager_->GetAddQueueTimeToTasks())
+    task.queue_time = now;
+
+  // The enqueue order is set when the task is moved to
+  // |immediate_incoming_queue_|, see
+  // MovePostedTasksToImmediateIncomingQueueLocked().
+  EnqueueOrder sequence_number = sequence_manager_->GetNextSequenceNumber();
+  auto node = std::make_unique<PostedTaskNode>(
+      Task(std::move(task), now, sequence_number), sequence_number);
+  sequence_manager_->WillQueueTask(&node->task);
+  return node;
+}
+
+void TaskQueueImpl::OnImmediateIncomingQueueBecameNonEmpty() {
+  if (!immediate_work_queue_empty_)
+    return;
+  empty_queues_to_reload_handle_.SetActive(true);
+  if (post_immediate_task_should_schedule_work_)
+    sequence_manager_->ScheduleWork();
+}
+
+bool TaskQueueImpl::PushOntoPostedTaskStack(
+    std::unique_ptr<PostedTaskNode> node) {
+  PostedTaskNode* const raw_node = node.release();
+  return PushOntoPostedTaskStack(raw_node, raw_node, 1u);
+}
+
+bool TaskQueueImpl::PushOntoPostedTaskStack(PostedTaskNode* first,
+                                            PostedTaskNode* last,
+                                            size_t count) {
+  last->next = posted_tasks_head_.load(std::memory_order_relaxed);
+  while (!posted_tasks_head_.compare_exchange_weak(last->next, first,
+                                                   std::memory_order_release,
+                                                   std::memory_order_relaxed)) {
+  }
+
+  // The tasks are only counted once they are on the stack. The main thread
+  // may already have moved and uncounted them, in which case the count was
+  // negative and scheduling a reload is merely redundant.
+  return num_immediate_incoming_tasks_.fetch_add(
+             static_cast<int64_t>(count)) <= 0;
+}
+
+void TaskQueueImpl::MovePostedTasksToImmediateIncomingQueueLocked() {
+  PostedTaskNode* head =
+      posted_tasks_head_.exchange(nullptr, std::memory_order_acquire);
+  if (!head)
+    return;
+
+  std::vector<std::unique_ptr<PostedTaskNode>> nodes;
+  while (head) {
+    PostedTaskNode* next = head->next;
+    nodes.emplace_back(head);
+    head = next;
+  }
+
+  // The stack is LIFO and concurrent posters may have pushed in a different
+  // order than they obtained their sequence numbers.
+  std::sort(nodes.begin(), nodes.end(),
+            [](const std::unique_ptr<PostedTaskNode>& a,
+               const std::unique_ptr<PostedTaskNode>& b) {
+              return a->sequence_order < b->sequence_order;
+            });
+
+  for (std::unique_ptr<PostedTaskNode>& node : nodes) {
+    EnqueueOrder enqueue_order = node->sequence_order;
+    // A post that raced with a previous call is ordered as if it was posted
+    // now. This preserves monotonically increasing enqueue orders within the
+    // queue.
+    if (last_immediate_incoming_enqueue_order_ &&
+        enqueue_order <= last_immediate_incoming_enqueue_order_) {
+      enqueue_order = sequence_manager_->GetNextSequenceNumber();
     }
+    node->task.set_enqueue_order(enqueue_order);
+    last_immediate_incoming_enqueue_order_ = enqueue_order;
+    immediate_incoming_queue_.push_back(std::move(node->task));
   }
+}
 
-  TraceQueueSize();
+void TaskQueueImpl::TakeImmediateIncomingQueueTasksForDeletionLocked(
+    TaskDeque* queue) {
+  DCHECK(queue->empty());
+  queue->swap(immediate_incoming_queue_);
+  num_immediate_incoming_tasks_.fetch_sub(static_cast<int64_t>(queue->size()));
 }
 
 void TaskQueueImpl::PostDelayedTaskImpl(PostedTask task,
@@ -379,7 +525,10 @@ void TaskQueueImpl::TakeImmediateIncomingQueueTasks(TaskDeque* queue) {
 
   {
     AutoLock immediate_incoming_queue_lock(immediate_incoming_queue_lock_);
+    MovePostedTasksToImmediateIncomingQueueLocked();
     queue->swap(immediate_incoming_queue_);
+    num_immediate_incoming_tasks_.fetch_sub(
+        static_cast<int64_t>(queue->size()));
 
     // Since |immediate_incoming_queue| is empty, now is a good time to consider
     // reducing it's capacity if we're wasting memory.
@@ -419,8 +568,12 @@ bool TaskQueueImpl::IsEmpty() const {
     return false;
   }
 
-  AutoLock lock(immediate_incoming_queue_lock_);
-  return immediate_incoming_queue_.empty();
+  return GetNumberOfImmediateIncomingTasks() == 0;
+}
+
+size_t TaskQueueImpl::GetNumberOfImmediateIncomingTasks() const {
+  return static_cast<size_t>(
+      std::max<int64_t>(num_immediate_incoming_tasks_.load(), 0));
 }
 
 size_t TaskQueueImpl::GetNumberOfPendingTasks() const {
@@ -428,9 +581,7 @@ size_t TaskQueueImpl::GetNumberOfPendingTasks() const {
   task_count += main_thread_only().delayed_work_queue->Size();
   task_count += main_thread_only().delayed_incoming_queue.size();
   task_count += main_thread_only().immediate_work_queue->Size();
-
-  AutoLock lock(immediate_incoming_queue_lock_);
-  task_count += immediate_incoming_queue_.size();
+  task_count += GetNumberOfImmediateIncomingTasks();
   return task_count;
 }
 
@@ -450,8 +601,7 @@ bool TaskQueueImpl::HasTaskToRunImmediately() const {
   }
 
   // Finally tasks on |immediate_incoming_queue| count as immediate work.
-  AutoLock lock(immediate_incoming_queue_lock_);
-  return !immediate_incoming_queue_.empty();
+  return GetNumberOfImmediateIncomingTasks() != 0;
 }
 
 Optional<DelayedWakeUp> TaskQueueImpl::GetNextScheduledWakeUpImpl() {
@@ -510,9 +660,8 @@ void TaskQueueImpl::TraceQueueSize() const {
   if (!associated_thread_->IsBoundToCurrentThread())
     return;
 
-  AutoLock lock(immediate_incoming_queue_lock_);
   TRACE_COUNTER1(TRACE_DISABLED_BY_DEFAULT("sequence_manager"), GetName(),
-                 immediate_incoming_queue_.size() +
+                 GetNumberOfImmediateIncomingTasks() +
                      main_thread_only().immediate_work_queue->Size() +
                      main_thread_only().delayed_work_queue->Size() +
                      main_thread_only().delayed_incoming_queue.size());
@@ -555,7 +704,7 @@ void TaskQueueImpl::AsValueInto(TimeTicks now,
   state->SetString("time_domain_name",
                    main_thread_only().time_domain->GetName());
   state->SetInteger("immediate_incoming_queue_size",
-                    immediate_incoming_queue_.size());
+                    GetNumberOfImmediateIncomingTasks());
   state->SetInteger("delayed_incoming_queue_size",
                     main_thread_only().delayed_incoming_queue.size());
   state->SetInteger("immediate_work_queue_size",
@@ -593,6 +742,14 @@ void TaskQueueImpl::AsValueInto(TimeTicks now,
   if (verbose || force_verbose) {
     state->BeginArray("immediate_incoming_queue");
     QueueAsValueInto(immediate_incoming_queue_, now, state);
+    // Tasks that weren't moved to |immediate_incoming_queue_| yet, most
+    // recently posted first. Nodes are only popped with
+    // |immediate_incoming_queue_lock_| held, so the stack can be walked.
+    for (const PostedTaskNode* node =
+             posted_tasks_head_.load(std::memory_order_acquire);
+         node; node = node->next) {
+      TaskAsValueInto(node->task, now, state);
+    }
     state->EndArray();
     state->BeginArray("delayed_work_queue");
     main_thread_only().delayed_work_queue->AsValueInto(now, state);
@@ -688,6 +845,7 @@ void TaskQueueImpl::InsertFence(TaskQueue::InsertFencePosition position) {
 
   if (!task_unblocked && previous_fence && previous_fence < current_fence) {
     AutoLock lock(immediate_incoming_queue_lock_);
+    MovePostedTasksToImmediateIncomingQueueLocked();
     if (!immediate_incoming_queue_.empty() &&
         immediate_incoming_queue_.front().enqueue_order() > previous_fence &&
         immediate_incoming_queue_.front().enqueue_order() < current_fence) {
@@ -721,6 +879,7 @@ void TaskQueueImpl::RemoveFence() {
 
   if (!task_unblocked && previous_fence) {
     AutoLock lock(immediate_incoming_queue_lock_);
+    MovePostedTasksToImmediateIncomingQueueLocked();
     if (!immediate_incoming_queue_.empty() &&
         immediate_incoming_queue_.front().enqueue_order() > previous_fence) {
       task_unblocked = true;
@@ -743,11 +902,26 @@ bool TaskQueueImpl::BlockedByFence() const {
   }
 
   AutoLock lock(immediate_incoming_queue_lock_);
-  if (immediate_incoming_queue_.empty())
-    return true;
+  if (!immediate_incoming_queue_.empty() &&
+      immediate_incoming_queue_.front().enqueue_order() <=
+          main_thread_only().current_fence) {
+    return false;
+  }
 
-  return immediate_incoming_queue_.front().enqueue_order() >
-         main_thread_only().current_fence;
+  // Tasks that weren't moved to |immediate_incoming_queue_| yet keep their
+  // sequence number as enqueue order, unless it is lower than that of a task
+  // already moved, in which case they get a new one which is past the fence.
+  // Nodes are only popped with |immediate_incoming_queue_lock_| held, so the
+  // stack can be walked.
+  for (const PostedTaskNode* node =
+           posted_tasks_head_.load(std::memory_order_acquire);
+       node; node = node->next) {
+    if (node->sequence_order > last_immediate_incoming_enqueue_order_ &&
+        node->sequence_order <= main_thread_only().current_fence) {
+      return false;
+    }
+  }
+  return true;
 }
 
 bool TaskQueueImpl::HasActiveFence() {
@@ -853,6 +1027,16 @@ void TaskQueueImpl::UpdateCrossThreadQueueStateLocked() {
     post_immediate_task_should_schedule_work_ =
         IsQueueEnabled() && !main_thread_only().current_fence;
   }
+
+  // A task posted concurrently may have read a stale
+  // |immediate_work_queue_empty_| and skipped requesting a reload. Both sides
+  // use sequentially consistent accesses, so either the poster observed the
+  // store above or this observes its increment.
+  if (immediate_work_queue_empty_ && GetNumberOfImmediateIncomingTasks() != 0) {
+    empty_queues_to_reload_handle_.SetActive(true);
+    if (post_immediate_task_should_schedule_work_)
+      sequence_manager_->ScheduleWork();
+  }
 }
 
 void TaskQueueImpl::ReclaimMemory(TimeTicks now) {
@@ -875,7 +1059,10 @@ void TaskQueueImpl::ReclaimMemory(TimeTicks now) {
 
 void TaskQueueImpl::PushImmediateIncomingTaskForTest(Task&& task) {
   AutoLock lock(immediate_incoming_queue_lock_);
+  MovePostedTasksToImmediateIncomingQueueLocked();
+  last_immediate_incoming_enqueue_order_ = task.enqueue_order();
   immediate_incoming_queue_.push_back(std::move(task));
+  ++num_immediate_incoming_tasks_;
 }
 
 void TaskQueueImpl::RequeueDeferredNonNestableTask(
@@ -959,8 +1146,7 @@ bool TaskQueueImpl::HasPendingImmediateWork() {
   }
 
   // Finally tasks on |immediate_incoming_queue| count as immediate work.
-  AutoLock lock(immediate_incoming_queue_lock_);
-  return !immediate_incoming_queue_.empty();
+  return GetNumberOfImmediateIncomingTasks() != 0;
 }
 
 void TaskQueueImpl::SetOnTaskStartedHandler(
@@ -1023,7 +1209,8 @@ void TaskQueueImpl::DeletePendingTasks() {
     // Limit the scope of the lock to ensure that the deque is destroyed
     // outside of the lock to allow it to post tasks.
     base::AutoLock lock(immediate_incoming_queue_lock_);
-    deque.swap(immediate_incoming_queue_);
+    MovePostedTasksToImmediateIncomingQueueLocked();
+    TakeImmediateIncomingQueueTasksForDeletionLocked(&deque);
     immediate_work_queue_empty_ = true;
   }
 
@@ -1039,11 +1226,7 @@ bool TaskQueueImpl::HasTasks() const {
   if (!main_thread_only().delayed_incoming_queue.empty())
     return true;
 
-  base::AutoLock lock(immediate_incoming_queue_lock_);
-  if (!immediate_incoming_queue_.empty())
-    return true;
-
-  return false;
+  return GetNumberOfImmediateIncomingTasks() != 0;
 }
 
 TaskQueueImpl::DelayedIncomingQueue::DelayedIncomingQueue() = default;
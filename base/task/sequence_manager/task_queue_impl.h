@@ -6,10 +6,13 @@
 #define BASE_TASK_SEQUENCE_MANAGER_TASK_QUEUE_IMPL_H_
 
 #include <stddef.h>
+#include <stdint.h>
 
+#include <atomic>
 #include <memory>
 #include <queue>
 #include <set>
+#include <vector>
 
 #include "base/callback.h"
 #include "base/macros.h"
@@ -55,6 +58,10 @@ class WorkQueueSets;
 // |immediate_work_queue| is swapped with |immediate_incoming_queue| when
 // |immediate_work_queue| becomes empty.
 //
+// Posting an immediate task doesn't take a lock: PostTask pushes onto a
+// lock-free multi-producer stack (|posted_tasks_head_|), which is moved into
+// |immediate_incoming_queue| in enqueue order whenever the latter is accessed.
+//
 // Delayed tasks are initially posted to |delayed_incoming_queue| and a wake-up
 // is scheduled with the TimeDomain.  When the delay has elapsed, the TimeDomain
 // calls UpdateDelayedWorkQueue and ready delayed tasks are moved into the
@@ -237,6 +244,7 @@ class BASE_EXPORT TaskQueueImpl {
     explicit GuardedTaskPoster(TaskQueueImpl* outer);
 
     bool PostTask(PostedTask task);
+    bool PostTasks(std::vector<PostedTask> tasks);
 
     void StartAcceptingOperations() {
       operations_controller_.StartAcceptingOperations();
@@ -268,6 +276,8 @@ class BASE_EXPORT TaskQueueImpl {
     bool PostNonNestableDelayedTask(const Location& location,
                                     OnceClosure callback,
                                     TimeDelta delay) final;
+    bool PostTasks(const Location& location,
+                   std::vector<OnceClosure> callbacks) final;
     bool RunsTasksInCurrentSequence() const final;
 
    private:
@@ -359,7 +369,13 @@ class BASE_EXPORT TaskQueueImpl {
 
   void PostTask(PostedTask task);
 
+  // Posts all of |tasks|. Immediate tasks are pushed onto
+  // |posted_tasks_head_| at once and schedule work at most once.
+  void PostTasks(std::vector<PostedTask> tasks);
+
   void PostImmediateTaskImpl(PostedTask task, CurrentThread current_thread);
+  void PostImmediateTasksImpl(std::vector<PostedTask> tasks,
+                              CurrentThread current_thread);
   void PostDelayedTaskImpl(PostedTask task, CurrentThread current_thread);
 
   // Push the task onto the |delayed_incoming_queue|. Lock-free main thread
@@ -376,6 +392,52 @@ class BASE_EXPORT TaskQueueImpl {
 
   void MoveReadyImmediateTasksToImmediateWorkQueueLocked();
 
+  // A task posted with PostImmediateTaskImpl(), linked into the lock-free
+  // |posted_tasks_head_| stack.
+  struct PostedTaskNode {
+    PostedTaskNode(Task task, EnqueueOrder sequence_order);
+    ~PostedTaskNode();
+
+    Task task;
+    // Sequence number of |task| as generated by the SequenceManager.
+    EnqueueOrder sequence_order;
+    PostedTaskNode* next = nullptr;
+  };
+
+  // Pushes |node| onto |posted_tasks_head_|. Returns true if there were no
+  // pending immediate incoming tasks before this one. Can be called from any
+  // thread without holding a lock.
+  bool PushOntoPostedTaskStack(std::unique_ptr<PostedTaskNode> node);
+
+  // Same as above for the |count| nodes linked from |first| to |last|, which
+  // this takes ownership of.
+  bool PushOntoPostedTaskStack(PostedTaskNode* first,
+                               PostedTaskNode* last,
+                               size_t count);
+
+  // Returns the time to use as |now| for immediate tasks posted from
+  // |current_thread|, or a null TimeTicks if it isn't needed.
+  TimeTicks GetImmediateTaskPostTime(CurrentThread current_thread);
+
+  // Wraps |task| in a PostedTaskNode with a new sequence number.
+  std::unique_ptr<PostedTaskNode> CreatePostedTaskNode(PostedTask task,
+                                                       TimeTicks now);
+
+  // Called after immediate tasks were pushed onto |posted_tasks_head_| while
+  // there were no pending immediate incoming tasks.
+  void OnImmediateIncomingQueueBecameNonEmpty();
+
+  // Moves the tasks on |posted_tasks_head_| to the back of
+  // |immediate_incoming_queue_| in increasing enqueue order. A task whose
+  // sequence number is lower than that of a task already moved (i.e. its post
+  // raced with a previous call) is given a new enqueue order.
+  void MovePostedTasksToImmediateIncomingQueueLocked()
+      EXCLUSIVE_LOCKS_REQUIRED(immediate_incoming_queue_lock_);
+
+  // Returns the number of tasks on |posted_tasks_head_| and
+  // |immediate_incoming_queue_|.
+  size_t GetNumberOfImmediateIncomingTasks() const;
+
   // LazilyDeallocatedDeque use TimeTicks to figure out when to resize.  We
   // should use real time here always.
   using TaskDeque =
@@ -386,6 +448,11 @@ class BASE_EXPORT TaskQueueImpl {
   // Can be called from any thread.
   void TakeImmediateIncomingQueueTasks(TaskDeque* queue);
 
+  // Swaps |immediate_incoming_queue_| with |queue| (which must be empty) to
+  // discard its tasks and updates |num_immediate_incoming_tasks_|.
+  void TakeImmediateIncomingQueueTasksForDeletionLocked(TaskDeque* queue)
+      EXCLUSIVE_LOCKS_REQUIRED(immediate_incoming_queue_lock_);
+
   void TraceQueueSize() const;
   static void QueueAsValueInto(const TaskDeque& queue,
                                TimeTicks now,
@@ -440,14 +507,28 @@ class BASE_EXPORT TaskQueueImpl {
     return main_thread_only_;
   }
 
+  // Head of a lock-free stack of tasks posted by PostImmediateTaskImpl() that
+  // haven't been moved to |immediate_incoming_queue_| yet. Pushed from any
+  // thread, popped with |immediate_incoming_queue_lock_| held.
+  std::atomic<PostedTaskNode*> posted_tasks_head_{nullptr};
+
+  // Number of tasks on |posted_tasks_head_| and |immediate_incoming_queue_|.
+  // Tasks are counted after being pushed onto |posted_tasks_head_|, so this is
+  // briefly negative if the main thread takes them first.
+  std::atomic<int64_t> num_immediate_incoming_tasks_{0};
+
   mutable Lock immediate_incoming_queue_lock_;
   TaskDeque immediate_incoming_queue_
       GUARDED_BY(immediate_incoming_queue_lock_);
-  // True if main_thread_only().immediate_work_queue is empty.
-  bool immediate_work_queue_empty_ GUARDED_BY(immediate_incoming_queue_lock_) =
-      true;
-  bool post_immediate_task_should_schedule_work_
-      GUARDED_BY(immediate_incoming_queue_lock_) = true;
+
+  // Enqueue order of the last task moved to |immediate_incoming_queue_|.
+  EnqueueOrder last_immediate_incoming_enqueue_order_
+      GUARDED_BY(immediate_incoming_queue_lock_);
+
+  // True if main_thread_only().immediate_work_queue is empty. Written with
+  // |immediate_incoming_queue_lock_| held, read without by posting threads.
+  std::atomic<bool> immediate_work_queue_empty_{true};
+  std::atomic<bool> post_immediate_task_should_schedule_work_{true};
 
   // Handle to our entry within the SequenceManagers |empty_queues_to_reload_|
   // atomic flag set. Used to signal that this queue needs to be reloaded.
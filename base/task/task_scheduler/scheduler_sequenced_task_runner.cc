@@ -39,6 +39,24 @@ bool SchedulerSequencedTaskRunner::PostNonNestableDelayedTask(
   return PostDelayedTask(from_here, std::move(closure), delay);
 }
 
+bool SchedulerSequencedTaskRunner::PostTasks(
+    const Location& from_here,
+    std::vector<OnceClosure> closures) {
+  if (!SchedulerTaskRunnerDelegate::Exists())
+    return false;
+
+  std::vector<Task> tasks;
+  tasks.reserve(closures.size());
+  for (OnceClosure& closure : closures) {
+    tasks.emplace_back(from_here, std::move(closure), TimeDelta());
+    tasks.back().sequenced_task_runner_ref = this;
+  }
+
+  // Post all tasks as part of |sequence_|.
+  return scheduler_task_runner_delegate_->PostTasksWithSequence(
+      std::move(tasks), sequence_);
+}
+
 bool SchedulerSequencedTaskRunner::RunsTasksInCurrentSequence() const {
   return sequence_->token() == SequenceToken::GetForCurrentThread();
 }
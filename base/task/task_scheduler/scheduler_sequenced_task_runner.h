@@ -5,6 +5,8 @@
 #ifndef BASE_TASK_TASK_SCHEDULER_SCHEDULER_SEQUENCED_TASK_RUNNER_H_
 #define BASE_TASK_TASK_SCHEDULER_SCHEDULER_SEQUENCED_TASK_RUNNER_H_
 
+#include <vector>
+
 #include "base/base_export.h"
 #include "base/callback_forward.h"
 #include "base/location.h"
@@ -35,6 +37,9 @@ class BASE_EXPORT SchedulerSequencedTaskRunner
                                   OnceClosure closure,
                                   TimeDelta delay) override;
 
+  bool PostTasks(const Location& from_here,
+                 std::vector<OnceClosure> closures) override;
+
   bool RunsTasksInCurrentSequence() const override;
 
   void UpdatePriority(TaskPriority priority) override;
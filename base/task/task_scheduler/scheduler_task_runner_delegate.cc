@@ -4,6 +4,8 @@
 
 #include "base/task/task_scheduler/scheduler_task_runner_delegate.h"
 
+#include <utility>
+
 namespace base {
 namespace internal {
 
@@ -36,5 +38,14 @@ bool SchedulerTaskRunnerDelegate::Exists() {
   return g_exists;
 }
 
+bool SchedulerTaskRunnerDelegate::PostTasksWithSequence(
+    std::vector<Task> tasks,
+    scoped_refptr<Sequence> sequence) {
+  bool all_posted = true;
+  for (Task& task : tasks)
+    all_posted &= PostTaskWithSequence(std::move(task), sequence);
+  return all_posted;
+}
+
 }  // namespace internal
 }  // namespace base
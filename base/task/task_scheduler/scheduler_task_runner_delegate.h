@@ -5,6 +5,8 @@
 #ifndef BASE_TASK_TASK_SCHEDULER_SCHEDULER_TASK_RUNNER_DELEGATE_H_
 #define BASE_TASK_TASK_SCHEDULER_SCHEDULER_TASK_RUNNER_DELEGATE_H_
 
+#include <vector>
+
 #include "base/base_export.h"
 #include "base/task/task_scheduler/sequence.h"
 #include "base/task/task_scheduler/task.h"
@@ -32,6 +34,14 @@ class BASE_EXPORT SchedulerTaskRunnerDelegate {
   virtual bool PostTaskWithSequence(Task task,
                                     scoped_refptr<Sequence> sequence) = 0;
 
+  // Invoked when a batch of non-delayed |tasks| is posted to the
+  // SchedulerSequencedTaskRunner. Equivalent to calling PostTaskWithSequence()
+  // for each task, but implementations may enqueue all of |tasks| in a single
+  // Sequence::Transaction and schedule |sequence| at most once. Returns true if
+  // all tasks were successfully posted.
+  virtual bool PostTasksWithSequence(std::vector<Task> tasks,
+                                     scoped_refptr<Sequence> sequence);
+
   // Invoked when RunsTasksInCurrentSequence() is called on a
   // SchedulerParallelTaskRunner. Returns true if the worker pool used by the
   // SchedulerParallelTaskRunner (as determined by |traits|) is running on
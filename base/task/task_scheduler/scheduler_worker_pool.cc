@@ -60,17 +60,39 @@ void SchedulerWorkerPool::PostTaskWithSequenceNow(
 
   const bool sequence_was_empty =
       sequence_and_transaction.transaction.PushTask(std::move(task));
-  if (sequence_was_empty) {
-    // Try to schedule the Sequence locked by |sequence_transaction| if it was
-    // empty before |task| was inserted into it. Otherwise, one of these must be
-    // true:
-    // - The Sequence is already scheduled, or,
-    // - The pool is running a Task from the Sequence. The pool is expected to
-    //   reschedule the Sequence once it's done running the Task.
-    if (task_tracker_->WillScheduleSequence(
-            sequence_and_transaction.transaction, this)) {
-      OnCanScheduleSequence(std::move(sequence_and_transaction));
-    }
+  // Try to schedule the Sequence locked by |sequence_transaction| if it was
+  // empty before |task| was inserted into it. Otherwise, one of these must be
+  // true:
+  // - The Sequence is already scheduled, or,
+  // - The pool is running a Task from the Sequence. The pool is expected to
+  //   reschedule the Sequence once it's done running the Task.
+  if (sequence_was_empty)
+    ScheduleSequenceIfAllowed(std::move(sequence_and_transaction));
+}
+
+void SchedulerWorkerPool::PostTasksWithSequenceNow(
+    std::vector<Task> tasks,
+    SequenceAndTransaction sequence_and_transaction) {
+  if (tasks.empty())
+    return;
+
+  bool sequence_was_empty = false;
+  for (Task& task : tasks) {
+    DCHECK(task.task);
+    DCHECK_LE(task.delayed_run_time, TimeTicks::Now());
+    // Only the first push can find the Sequence empty.
+    sequence_was_empty |=
+        sequence_and_transaction.transaction.PushTask(std::move(task));
+  }
+  if (sequence_was_empty)
+    ScheduleSequenceIfAllowed(std::move(sequence_and_transaction));
+}
+
+void SchedulerWorkerPool::ScheduleSequenceIfAllowed(
+    SequenceAndTransaction sequence_and_transaction) {
+  if (task_tracker_->WillScheduleSequence(sequence_and_transaction.transaction,
+                                          this)) {
+    OnCanScheduleSequence(std::move(sequence_and_transaction));
   }
 }
 
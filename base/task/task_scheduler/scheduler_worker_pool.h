@@ -5,6 +5,8 @@
 #ifndef BASE_TASK_TASK_SCHEDULER_SCHEDULER_WORKER_POOL_H_
 #define BASE_TASK_TASK_SCHEDULER_SCHEDULER_WORKER_POOL_H_
 
+#include <vector>
+
 #include "base/base_export.h"
 #include "base/memory/ref_counted.h"
 #include "base/task/task_scheduler/can_schedule_sequence_observer.h"
@@ -46,6 +48,13 @@ class BASE_EXPORT SchedulerWorkerPool : public CanScheduleSequenceObserver {
   void PostTaskWithSequenceNow(Task task,
                                SequenceAndTransaction sequence_and_transaction);
 
+  // Same as PostTaskWithSequenceNow(), but pushes all of |tasks| within the
+  // single Transaction of |sequence_and_transaction| and schedules the Sequence
+  // at most once.
+  void PostTasksWithSequenceNow(
+      std::vector<Task> tasks,
+      SequenceAndTransaction sequence_and_transaction);
+
   // Registers the worker pool in TLS.
   void BindToCurrentThread();
 
@@ -91,6 +100,11 @@ class BASE_EXPORT SchedulerWorkerPool : public CanScheduleSequenceObserver {
   const TrackedRef<Delegate> delegate_;
 
  private:
+  // Schedules the Sequence in |sequence_and_transaction|, which just became
+  // non-empty, if TaskTracker allows it.
+  void ScheduleSequenceIfAllowed(
+      SequenceAndTransaction sequence_and_transaction);
+
   DISALLOW_COPY_AND_ASSIGN(SchedulerWorkerPool);
 };
 
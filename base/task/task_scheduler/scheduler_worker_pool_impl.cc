@@ -190,6 +190,12 @@ class SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl
   void MayBlockEntered();
   void WillBlockEntered();
 
+  // Moves the Sequences in this worker's local queue to |destination| and
+  // releases the running task slot each of them holds in
+  // |outer_->num_running_tasks_|. Only used in WorkerPoolMode::WORK_STEALING.
+  void MoveLocalSequencesLockRequired(PriorityQueue* destination)
+      EXCLUSIVE_LOCKS_REQUIRED(outer_->lock_);
+
   // Returns true iff the worker can get work. Cleans up the worker or puts it
   // on the idle stack if it can't get work.
   bool CanGetWorkLockRequired(SchedulerWorker* worker)
@@ -228,6 +234,21 @@ class SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl
   void OnWorkerBecomesIdleLockRequired(SchedulerWorker* worker)
       EXCLUSIVE_LOCKS_REQUIRED(outer_->lock_);
 
+  // Returns a Sequence from the local queue if this worker can run a task from
+  // it without acquiring |outer_->lock_|, or nullptr otherwise. Only used in
+  // WorkerPoolMode::WORK_STEALING.
+  scoped_refptr<Sequence> TryGetLocalWork();
+
+  // Pushes the Sequence in |sequence_and_transaction| to the local queue and
+  // returns true if it can be kept there instead of being reenqueued in the
+  // pool's PriorityQueue. Only used in WorkerPoolMode::WORK_STEALING.
+  bool TryKeepSequenceInLocalQueue(
+      SequenceAndTransaction* sequence_and_transaction);
+
+  // Moves the Sequence kept by TryKeepSequenceInLocalQueue(), unless it was
+  // stolen since, to the pool's PriorityQueue.
+  void ReturnLocalWorkLockRequired() EXCLUSIVE_LOCKS_REQUIRED(outer_->lock_);
+
   // Accessed only from the worker thread.
   struct WorkerOnly {
     // Number of tasks executed since the last time the
@@ -242,6 +263,15 @@ class SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl
     // returned a non-empty sequence and DidRunTask() hasn't been called yet).
     bool is_running_task = false;
 
+    // Whether the worker kept a Sequence in its local queue in DidRunTask().
+    // The Sequence holds a slot in |outer_->num_running_tasks_| until it is
+    // run from the local queue or moved to the pool's PriorityQueue.
+    bool kept_local_sequence = false;
+
+    // Whether the next call to GetWork() must acquire |outer_->lock_|, e.g.
+    // because |outer_->max_tasks_| was decremented while running a task.
+    bool must_get_work_from_pool = false;
+
 #if defined(OS_WIN)
     std::unique_ptr<win::ScopedWindowsThreadEnvironment> win_thread_environment;
 #endif  // defined(OS_WIN)
@@ -280,6 +310,13 @@ class SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl
 
   const TrackedRef<SchedulerWorkerPoolImpl> outer_;
 
+  // Local queue from which this worker runs the Sequence it just ran a task
+  // from without acquiring |outer_->lock_|. Contains at most one Sequence.
+  // |outer_->lock_| is a predecessor so that other workers can steal from it.
+  // Only used in WorkerPoolMode::WORK_STEALING.
+  SchedulerLock local_queue_lock_;
+  PriorityQueue local_priority_queue_ GUARDED_BY(local_queue_lock_);
+
   // Whether |outer_->max_tasks_| was incremented due to a ScopedBlockingCall on
   // the thread.
   bool incremented_max_tasks_since_blocked_ GUARDED_BY(outer_->lock_) = false;
@@ -388,6 +425,9 @@ void SchedulerWorkerPoolImpl::Start(
   max_best_effort_tasks_ = max_best_effort_tasks;
   in_start().suggested_reclaim_time = params.suggested_reclaim_time();
   in_start().backward_compatibility = params.backward_compatibility();
+  in_start().work_stealing =
+      params.worker_pool_mode() ==
+      SchedulerWorkerPoolParams::WorkerPoolMode::WORK_STEALING;
   in_start().worker_environment = worker_environment;
   in_start().service_thread_task_runner = std::move(service_thread_task_runner);
   in_start().scheduler_worker_observer = scheduler_worker_observer;
@@ -426,6 +466,7 @@ void SchedulerWorkerPoolImpl::PushSequenceAndWakeUpWorkers(
     AutoSchedulerLock auto_lock(lock_);
     priority_queue_.Push(std::move(sequence_and_transaction.sequence),
                          sequence_and_transaction.transaction.GetSortKey());
+    UpdateSharedQueueTopPriorityLockRequired();
     EnsureEnoughWorkersLockRequired(&executor);
     must_schedule_adjust_max_tasks = MustScheduleAdjustMaxTasksLockRequired();
     // Terminate the Sequence transaction at the end of this scope to avoid
@@ -541,17 +582,23 @@ void SchedulerWorkerPoolImpl::UpdateSortKey(
   // BEST_EFFORT task is increased and |num_running_best_effort_tasks_| is
   // equal to |max_best_effort_tasks_|.
   AutoSchedulerLock auto_lock(lock_);
+  StealFromLocalQueuesLockRequired(nullptr);
   priority_queue_.UpdateSortKey(std::move(sequence_and_transaction));
+  UpdateSharedQueueTopPriorityLockRequired();
 }
 
 bool SchedulerWorkerPoolImpl::RemoveSequence(scoped_refptr<Sequence> sequence) {
   AutoSchedulerLock auto_lock(lock_);
-  return priority_queue_.RemoveSequence(std::move(sequence));
+  StealFromLocalQueuesLockRequired(nullptr);
+  const bool sequence_removed =
+      priority_queue_.RemoveSequence(std::move(sequence));
+  UpdateSharedQueueTopPriorityLockRequired();
+  return sequence_removed;
 }
 
 SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl::
     SchedulerWorkerDelegateImpl(TrackedRef<SchedulerWorkerPoolImpl> outer)
-    : outer_(std::move(outer)) {
+    : outer_(std::move(outer)), local_queue_lock_(&outer_->lock_) {
   // Bound in OnMainEntry().
   DETACH_FROM_THREAD(worker_thread_checker_);
 }
@@ -612,14 +659,29 @@ SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl::GetWork(
   DCHECK(!worker_only().is_running_task);
   DCHECK(!read_worker().is_running_best_effort_task);
 
+  if (outer_->after_start().work_stealing) {
+    scoped_refptr<Sequence> local_sequence = TryGetLocalWork();
+    if (local_sequence)
+      return local_sequence;
+  }
+
   SchedulerWorkerActionExecutor executor(outer_.get());
   AutoSchedulerLock auto_lock(outer_->lock_);
 
   DCHECK(ContainsWorker(outer_->workers_, worker));
 
+  if (worker_only().kept_local_sequence)
+    ReturnLocalWorkLockRequired();
+  worker_only().must_get_work_from_pool = false;
+
   if (!CanGetWorkLockRequired(worker))
     return nullptr;
 
+  if (outer_->after_start().work_stealing &&
+      outer_->priority_queue_.IsEmpty()) {
+    outer_->StealFromLocalQueuesLockRequired(worker);
+  }
+
   if (outer_->priority_queue_.IsEmpty()) {
     OnWorkerBecomesIdleLockRequired(worker);
     return nullptr;
@@ -652,6 +714,7 @@ SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl::GetWork(
 
   // Pop the Sequence from which to run a task from the PriorityQueue.
   scoped_refptr<Sequence> sequence = outer_->priority_queue_.PopSequence();
+  outer_->UpdateSharedQueueTopPriorityLockRequired();
 
   // Sanity check: A worker should not get work if the number of awake workers
   // is more than the *desired* number of awake workers. It should instead be
@@ -678,6 +741,14 @@ void SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl::DidRunTask(
   if (sequence) {
     sequence_to_reenqueue_and_transaction.emplace(
         SequenceAndTransaction::FromSequence(std::move(sequence)));
+
+    // Keep running tasks from the same Sequence without acquiring
+    // |outer_->lock_| when possible.
+    if (outer_->after_start().work_stealing &&
+        TryKeepSequenceInLocalQueue(
+            &sequence_to_reenqueue_and_transaction.value())) {
+      return;
+    }
   }
 
   // The pool in which to reenqueue the Sequence. Initialized below and used
@@ -715,6 +786,7 @@ void SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl::DidRunTask(
       outer_->priority_queue_.Push(
           std::move(sequence_to_reenqueue_and_transaction->sequence),
           sequence_to_reenqueue_and_transaction->transaction.GetSortKey());
+      outer_->UpdateSharedQueueTopPriorityLockRequired();
       return;
     }
   }
@@ -820,6 +892,12 @@ void SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl::OnMainExit(
     SchedulerWorker* worker) {
   DCHECK_CALLED_ON_VALID_THREAD(worker_thread_checker_);
 
+  // Don't strand a Sequence in the local queue of an exiting worker.
+  if (worker_only().kept_local_sequence) {
+    AutoSchedulerLock auto_lock(outer_->lock_);
+    ReturnLocalWorkLockRequired();
+  }
+
 #if DCHECK_IS_ON()
   {
     bool shutdown_complete = outer_->task_tracker_->IsShutdownComplete();
@@ -899,6 +977,8 @@ void SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl::BlockingEnded() {
   if (incremented_max_tasks_since_blocked_) {
     outer_->DecrementMaxTasksLockRequired(
         read_worker().is_running_best_effort_task);
+    // The worker may now be in excess; let GetWork() verify it.
+    worker_only().must_get_work_from_pool = true;
   } else {
     DCHECK(!read_worker().may_block_start_time.is_null());
     --outer_->num_unresolved_may_block_;
@@ -976,6 +1056,96 @@ bool SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl::
   return true;
 }
 
+void SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl::
+    MoveLocalSequencesLockRequired(PriorityQueue* destination) {
+  AutoSchedulerLock auto_lock(local_queue_lock_);
+  while (!local_priority_queue_.IsEmpty()) {
+    const SequenceSortKey sort_key = local_priority_queue_.PeekSortKey();
+    destination->Push(local_priority_queue_.PopSequence(), sort_key);
+    DCHECK_GT(outer_->num_running_tasks_, 0U);
+    --outer_->num_running_tasks_;
+  }
+}
+
+scoped_refptr<Sequence>
+SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl::TryGetLocalWork() {
+  DCHECK_CALLED_ON_VALID_THREAD(worker_thread_checker_);
+
+  if (!worker_only().kept_local_sequence ||
+      worker_only().must_get_work_from_pool) {
+    return nullptr;
+  }
+
+  AutoSchedulerLock auto_lock(local_queue_lock_);
+
+  // The Sequence may have been stolen by another worker, which released its
+  // running task slot.
+  if (local_priority_queue_.IsEmpty()) {
+    worker_only().kept_local_sequence = false;
+    return nullptr;
+  }
+
+  // Defer to the pool's PriorityQueue if it has more important work. Between
+  // Sequences of the same TaskPriority, keeping the one whose caches are warm
+  // is worth more than strict SequenceSortKey ordering.
+  const int local_priority =
+      static_cast<int>(local_priority_queue_.PeekSortKey().priority());
+  if (local_priority <
+      outer_->shared_queue_top_priority_.load(std::memory_order_relaxed)) {
+    return nullptr;
+  }
+
+  // The running task slot held by the Sequence is reused for the next task.
+  worker_only().kept_local_sequence = false;
+  worker_only().is_running_task = true;
+  return local_priority_queue_.PopSequence();
+}
+
+bool SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl::
+    TryKeepSequenceInLocalQueue(
+        SequenceAndTransaction* sequence_and_transaction) {
+  DCHECK_CALLED_ON_VALID_THREAD(worker_thread_checker_);
+
+  // BEST_EFFORT bookkeeping requires |outer_->lock_|.
+  if (worker_only().must_get_work_from_pool ||
+      read_worker().is_running_best_effort_task) {
+    return false;
+  }
+
+  const SequenceSortKey sort_key =
+      sequence_and_transaction->transaction.GetSortKey();
+  if (sort_key.priority() == TaskPriority::BEST_EFFORT)
+    return false;
+
+  if (outer_->delegate_->GetWorkerPoolForTraits(
+          sequence_and_transaction->transaction.traits()) != outer_.get()) {
+    return false;
+  }
+
+  {
+    AutoSchedulerLock auto_lock(local_queue_lock_);
+    DCHECK(local_priority_queue_.IsEmpty());
+    local_priority_queue_.Push(std::move(sequence_and_transaction->sequence),
+                               sort_key);
+  }
+
+  // Keep the slot in |outer_->num_running_tasks_| for the next task.
+  worker_only().is_running_task = false;
+  worker_only().kept_local_sequence = true;
+  return true;
+}
+
+void SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl::
+    ReturnLocalWorkLockRequired() {
+  DCHECK_CALLED_ON_VALID_THREAD(worker_thread_checker_);
+  DCHECK(worker_only().kept_local_sequence);
+  DCHECK(!worker_only().is_running_task);
+
+  worker_only().kept_local_sequence = false;
+  MoveLocalSequencesLockRequired(&outer_->priority_queue_);
+  outer_->UpdateSharedQueueTopPriorityLockRequired();
+}
+
 bool SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl::
     MustIncrementMaxTasksLockRequired() {
   if (!incremented_max_tasks_since_blocked_ &&
@@ -1003,6 +1173,32 @@ void SchedulerWorkerPoolImpl::WaitForWorkersIdleLockRequiredForTesting(
     idle_workers_stack_cv_for_testing_->Wait();
 }
 
+void SchedulerWorkerPoolImpl::UpdateSharedQueueTopPriorityLockRequired() {
+  shared_queue_top_priority_.store(
+      priority_queue_.IsEmpty()
+          ? -1
+          : static_cast<int>(priority_queue_.PeekSortKey().priority()),
+      std::memory_order_relaxed);
+}
+
+void SchedulerWorkerPoolImpl::StealFromLocalQueuesLockRequired(
+    const SchedulerWorker* stealing_worker) {
+  if (!after_start().work_stealing)
+    return;
+
+  for (const scoped_refptr<SchedulerWorker>& worker : workers_) {
+    if (worker.get() == stealing_worker)
+      continue;
+    // The delegates of workers inside a SchedulerWorkerPoolImpl should be
+    // SchedulerWorkerDelegateImpls.
+    SchedulerWorkerDelegateImpl* delegate =
+        static_cast<SchedulerWorkerDelegateImpl*>(worker->delegate());
+    AnnotateAcquiredLockAlias annotate(lock_, delegate->lock());
+    delegate->MoveLocalSequencesLockRequired(&priority_queue_);
+  }
+  UpdateSharedQueueTopPriorityLockRequired();
+}
+
 void SchedulerWorkerPoolImpl::MaintainAtLeastOneIdleWorkerLockRequired(
     SchedulerWorkerActionExecutor* executor) {
   if (workers_.size() == kMaxNumberOfWorkers)
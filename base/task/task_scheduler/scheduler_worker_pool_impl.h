@@ -7,6 +7,7 @@
 
 #include <stddef.h>
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <vector>
@@ -176,6 +177,18 @@ class BASE_EXPORT SchedulerWorkerPoolImpl : public SchedulerWorkerPool {
   void OnCanScheduleSequence(
       SequenceAndTransaction sequence_and_transaction) override;
 
+  // Updates |shared_queue_top_priority_| to reflect the current state of
+  // |priority_queue_|. Must be called after every modification of
+  // |priority_queue_|.
+  void UpdateSharedQueueTopPriorityLockRequired()
+      EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  // Moves the Sequences in the local queues of all workers other than
+  // |stealing_worker| to |priority_queue_|, where they are ordered with the
+  // rest of the pool's work. Only used in WorkerPoolMode::WORK_STEALING.
+  void StealFromLocalQueuesLockRequired(const SchedulerWorker* stealing_worker)
+      EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
   // Pushes the Sequence in |sequence_and_transaction| to |priority_queue_| and
   // wakes up workers as appropriate.
   void PushSequenceAndWakeUpWorkers(
@@ -267,6 +280,10 @@ class BASE_EXPORT SchedulerWorkerPoolImpl : public SchedulerWorkerPool {
 
     SchedulerBackwardCompatibility backward_compatibility;
 
+    // Whether workers keep the Sequence they just ran a task from in a local
+    // queue (WorkerPoolMode::WORK_STEALING).
+    bool work_stealing = false;
+
     // Environment to be initialized per worker.
     WorkerEnvironment worker_environment = WorkerEnvironment::NONE;
 
@@ -321,6 +338,12 @@ class BASE_EXPORT SchedulerWorkerPoolImpl : public SchedulerWorkerPool {
   int num_unresolved_may_block_ GUARDED_BY(lock_) = 0;
   int num_unresolved_best_effort_may_block_ GUARDED_BY(lock_) = 0;
 
+  // Highest TaskPriority in |priority_queue_|, or -1 if it is empty. Written
+  // with |lock_| held and read without it by workers that decide whether they
+  // can run a task from their local queue without acquiring |lock_|
+  // (WorkerPoolMode::WORK_STEALING).
+  std::atomic<int> shared_queue_top_priority_{-1};
+
   // Stack of idle workers. Initially, all workers are on this stack. A worker
   // is removed from the stack before its WakeUp() function is called and when
   // it receives work from GetWork() (a worker calls GetWork() when its sleep
@@ -330,6 +330,91 @@ INSTANTIATE_TEST_SUITE_P(Sequenced,
                          TaskSchedulerWorkerPoolImplTestParam,
                          ::testing::Values(test::ExecutionMode::SEQUENCED));
 
+namespace {
+
+class TaskSchedulerWorkerPoolImplWorkStealingTest
+    : public TaskSchedulerWorkerPoolImplTestBase,
+      public testing::Test {
+ protected:
+  TaskSchedulerWorkerPoolImplWorkStealingTest() = default;
+
+  void SetUp() override { CreateWorkerPool(); }
+
+  void StartWorkStealingWorkerPool(size_t max_tasks) {
+    worker_pool_->Start(
+        SchedulerWorkerPoolParams(
+            max_tasks, TimeDelta::Max(),
+            SchedulerBackwardCompatibility::DISABLED,
+            SchedulerWorkerPoolParams::WorkerPoolMode::WORK_STEALING),
+        max_tasks, service_thread_.task_runner(), nullptr,
+        SchedulerWorkerPoolImpl::WorkerEnvironment::NONE);
+  }
+
+  void TearDown() override {
+    TaskSchedulerWorkerPoolImplTestBase::CommonTearDown();
+  }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(TaskSchedulerWorkerPoolImplWorkStealingTest);
+};
+
+}  // namespace
+
+// Verify that tasks posted to sequences all run, in posting order and without
+// overlap within a sequence, when workers keep sequences in local queues.
+TEST_F(TaskSchedulerWorkerPoolImplWorkStealingTest, PostSequencedTasks) {
+  StartWorkStealingWorkerPool(kMaxTasks);
+
+  std::vector<std::unique_ptr<test::TestTaskFactory>> factories;
+  for (size_t i = 0; i < kNumThreadsPostingTasks; ++i) {
+    factories.push_back(std::make_unique<test::TestTaskFactory>(
+        CreateTaskRunnerWithExecutionMode(
+            test::ExecutionMode::SEQUENCED,
+            &mock_scheduler_task_runner_delegate_),
+        test::ExecutionMode::SEQUENCED));
+  }
+  for (size_t i = 0; i < kNumTasksPostedPerThread; ++i) {
+    for (auto& factory : factories)
+      EXPECT_TRUE(factory->PostTask(PostNestedTask::NO, Closure()));
+  }
+  for (auto& factory : factories)
+    factory->WaitForAllTasksToRun();
+
+  // Workers must release their local sequences and become idle once there is
+  // no more work.
+  worker_pool_->WaitForAllWorkersIdleForTesting();
+}
+
+// Verify that a USER_BLOCKING task posted while the only worker repeatedly runs
+// USER_VISIBLE tasks from its local queue gets to run.
+TEST_F(TaskSchedulerWorkerPoolImplWorkStealingTest,
+       HigherPriorityTaskPreemptsLocalSequence) {
+  StartWorkStealingWorkerPool(1);
+
+  AtomicFlag stop;
+  WaitableEvent user_blocking_task_ran;
+  scoped_refptr<SequencedTaskRunner> user_visible_runner =
+      test::CreateSequencedTaskRunnerWithTraits(
+          {TaskPriority::USER_VISIBLE}, &mock_scheduler_task_runner_delegate_);
+
+  // Keep the user visible sequence busy by reposting to it.
+  RepeatingClosure repost;
+  repost = BindLambdaForTesting([&]() {
+    if (!stop.IsSet())
+      user_visible_runner->PostTask(FROM_HERE, repost);
+  });
+  user_visible_runner->PostTask(FROM_HERE, repost);
+
+  test::CreateTaskRunnerWithTraits({TaskPriority::USER_BLOCKING},
+                                   &mock_scheduler_task_runner_delegate_)
+      ->PostTask(FROM_HERE,
+                 BindOnce(&WaitableEvent::Signal,
+                          Unretained(&user_blocking_task_ran)));
+  user_blocking_task_ran.Wait();
+  stop.Set();
+  task_tracker_.FlushForTesting();
+}
+
 #if defined(OS_WIN)
 
 namespace {
@@ -12,17 +12,30 @@ namespace base {
 
 class BASE_EXPORT SchedulerWorkerPoolParams final {
  public:
+  // Determines how the workers of a pool get work.
+  enum class WorkerPoolMode {
+    // All workers get work from a single PriorityQueue shared by the pool.
+    SHARED_QUEUE,
+    // Each worker keeps the Sequence it just ran a task from in a local queue
+    // and runs its next task from it without acquiring the pool lock, as long
+    // as no Sequence with a higher TaskPriority is queued in the shared
+    // PriorityQueue. Other workers steal from local queues when the shared
+    // PriorityQueue is empty.
+    WORK_STEALING,
+  };
+
   // Constructs a set of params used to initialize a pool. The pool will run
   // concurrently at most |max_tasks| that aren't blocked (ScopedBlockingCall).
   // |suggested_reclaim_time| sets a suggestion on when to reclaim idle threads.
   // The pool is free to ignore this value for performance or correctness
   // reasons. |backward_compatibility| indicates whether backward compatibility
-  // is enabled.
+  // is enabled. |worker_pool_mode| determines how workers get work.
   SchedulerWorkerPoolParams(
       int max_tasks,
       TimeDelta suggested_reclaim_time,
       SchedulerBackwardCompatibility backward_compatibility =
-          SchedulerBackwardCompatibility::DISABLED);
+          SchedulerBackwardCompatibility::DISABLED,
+      WorkerPoolMode worker_pool_mode = WorkerPoolMode::SHARED_QUEUE);
 
   SchedulerWorkerPoolParams(const SchedulerWorkerPoolParams& other);
   SchedulerWorkerPoolParams& operator=(const SchedulerWorkerPoolParams& other);
@@ -32,11 +45,13 @@ class BASE_EXPORT SchedulerWorkerPoolParams final {
   SchedulerBackwardCompatibility backward_compatibility() const {
     return backward_compatibility_;
   }
+  WorkerPoolMode worker_pool_mode() const { return worker_pool_mode_; }
 
  private:
   int max_tasks_;
   TimeDelta suggested_reclaim_time_;
   SchedulerBackwardCompatibility backward_compatibility_;
+  WorkerPoolMode worker_pool_mode_;
 };
 
 }  // namespace base
@@ -282,6 +282,34 @@ bool TaskSchedulerImpl::PostTaskWithSequence(Task task,
   return true;
 }
 
+bool TaskSchedulerImpl::PostTasksWithSequence(
+    std::vector<Task> tasks,
+    scoped_refptr<Sequence> sequence) {
+  DCHECK(sequence);
+
+  bool all_posted = true;
+  std::vector<Task> tasks_to_post;
+  tasks_to_post.reserve(tasks.size());
+  for (Task& task : tasks) {
+    CHECK(task.task);
+    DCHECK(task.delayed_run_time.is_null());
+    if (task_tracker_->WillPostTask(&task, sequence->shutdown_behavior()))
+      tasks_to_post.push_back(std::move(task));
+    else
+      all_posted = false;
+  }
+
+  if (!tasks_to_post.empty()) {
+    auto sequence_and_transaction =
+        SequenceAndTransaction::FromSequence(std::move(sequence));
+    const TaskTraits traits = sequence_and_transaction.transaction.traits();
+    GetWorkerPoolForTraits(traits)->PostTasksWithSequenceNow(
+        std::move(tasks_to_post), std::move(sequence_and_transaction));
+  }
+
+  return all_posted;
+}
+
 bool TaskSchedulerImpl::IsRunningPoolWithTraits(
     const TaskTraits& traits) const {
   return GetWorkerPoolImplForTraits(traits)->IsBoundToCurrentThread();
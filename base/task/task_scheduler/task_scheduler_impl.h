@@ -121,6 +121,8 @@ class BASE_EXPORT TaskSchedulerImpl : public TaskScheduler,
   // SchedulerTaskRunnerDelegate:
   bool PostTaskWithSequence(Task task,
                             scoped_refptr<Sequence> sequence) override;
+  bool PostTasksWithSequence(std::vector<Task> tasks,
+                             scoped_refptr<Sequence> sequence) override;
   bool IsRunningPoolWithTraits(const TaskTraits& traits) const override;
   void UpdatePriority(scoped_refptr<Sequence> sequence,
                       TaskPriority priority) override;
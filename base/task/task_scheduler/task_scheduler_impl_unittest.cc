@@ -497,6 +497,32 @@ TEST_F(TaskSchedulerImplTest,
                    {MayBlock(), TaskPriority::USER_BLOCKING}));
 }
 
+// Verify that a batch posted with PostTasks() runs in order, sequenced with
+// tasks posted individually to the same SequencedTaskRunner.
+TEST_F(TaskSchedulerImplTest, SequencedPostTasksRunInOrder) {
+  StartTaskScheduler();
+  auto sequenced_task_runner =
+      scheduler_.CreateSequencedTaskRunnerWithTraits(TaskTraits());
+
+  std::vector<int> run_order;
+  auto append = [](std::vector<int>* run_order, int value) {
+    run_order->push_back(value);
+  };
+  sequenced_task_runner->PostTask(FROM_HERE,
+                                  BindOnce(append, Unretained(&run_order), 0));
+  std::vector<OnceClosure> tasks;
+  for (int i = 1; i < 4; ++i)
+    tasks.push_back(BindOnce(append, Unretained(&run_order), i));
+  EXPECT_TRUE(sequenced_task_runner->PostTasks(FROM_HERE, std::move(tasks)));
+
+  WaitableEvent task_ran;
+  sequenced_task_runner->PostTask(
+      FROM_HERE,
+      BindOnce(&WaitableEvent::Signal, Unretained(&task_ran)));
+  task_ran.Wait();
+  EXPECT_EQ(std::vector<int>({0, 1, 2, 3}), run_order);
+}
+
 // Verify that the RunsTasksInCurrentSequence() method of a SequencedTaskRunner
 // returns false when called from a task that isn't part of the sequence.
 TEST_F(TaskSchedulerImplTest, SequencedRunsTasksInCurrentSequence) {
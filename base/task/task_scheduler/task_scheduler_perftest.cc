@@ -5,6 +5,7 @@
 #include <stddef.h>
 #include <atomic>
 #include <memory>
+#include <tuple>
 #include <vector>
 
 #include "base/barrier_closure.h"
@@ -12,8 +13,10 @@
 #include "base/bind_helpers.h"
 #include "base/callback.h"
 #include "base/optional.h"
+#include "base/strings/stringprintf.h"
 #include "base/synchronization/waitable_event.h"
 #include "base/task/post_task.h"
+#include "base/task/task_scheduler/scheduler_worker_pool_params.h"
 #include "base/task/task_scheduler/task_scheduler.h"
 #include "base/threading/simple_thread.h"
 #include "base/time/time.h"
@@ -94,6 +97,22 @@ class TaskSchedulerPerfTest : public testing::Test {
     }
   }
 
+  void ContinuouslyPostNoOpTasksToSequences(size_t num_sequences,
+                                          size_t num_tasks_per_sequence) {
+    base::RepeatingClosure closure = base::BindRepeating(
+        [](std::atomic_size_t* num_task_pending) { (*num_task_pending)--; },
+        &num_tasks_pending_);
+    for (size_t i = 0; i < num_sequences; ++i) {
+      scoped_refptr<SequencedTaskRunner> task_runner =
+          CreateSequencedTaskRunnerWithTraits({});
+      for (size_t j = 0; j < num_tasks_per_sequence; ++j) {
+        ++num_tasks_pending_;
+        ++num_posted_tasks_;
+        task_runner->PostTask(FROM_HERE, closure);
+      }
+    }
+  }
+
   void ContinuouslyPostBusyWaitTasks(size_t num_tasks,
                                      base::TimeDelta duration) {
     scoped_refptr<TaskRunner> task_runner = CreateTaskRunnerWithTraits({});
@@ -117,15 +136,19 @@ class TaskSchedulerPerfTest : public testing::Test {
 
   ~TaskSchedulerPerfTest() override { TaskScheduler::SetInstance(nullptr); }
 
-  void StartTaskScheduler(size_t num_running_threads,
-                          size_t num_posting_threads,
-                          base::RepeatingClosure post_action) {
+  void StartTaskScheduler(
+      size_t num_running_threads,
+      size_t num_posting_threads,
+      base::RepeatingClosure post_action,
+      SchedulerWorkerPoolParams::WorkerPoolMode worker_pool_mode =
+          SchedulerWorkerPoolParams::WorkerPoolMode::SHARED_QUEUE) {
     constexpr TimeDelta kSuggestedReclaimTime = TimeDelta::FromSeconds(30);
     constexpr int kMaxNumBackgroundThreads = 1;
 
     TaskScheduler::GetInstance()->Start(
         {{kMaxNumBackgroundThreads, kSuggestedReclaimTime},
-         {num_running_threads, kSuggestedReclaimTime}},
+         {num_running_threads, kSuggestedReclaimTime,
+          SchedulerBackwardCompatibility::DISABLED, worker_pool_mode}},
         nullptr);
 
     base::RepeatingClosure done = BarrierClosure(
@@ -194,6 +217,33 @@ class TaskSchedulerPerfTest : public testing::Test {
   DISALLOW_COPY_AND_ASSIGN(TaskSchedulerPerfTest);
 };
 
+// Runs a benchmark with a number of worker threads and a WorkerPoolMode.
+class TaskSchedulerWorkerPoolModePerfTest
+    : public TaskSchedulerPerfTest,
+      public testing::WithParamInterface<
+          std::tuple<size_t, SchedulerWorkerPoolParams::WorkerPoolMode>> {
+ public:
+  TaskSchedulerWorkerPoolModePerfTest() = default;
+
+  size_t num_running_threads() const { return std::get<0>(GetParam()); }
+
+  SchedulerWorkerPoolParams::WorkerPoolMode worker_pool_mode() const {
+    return std::get<1>(GetParam());
+  }
+
+  std::string GetTrace(const std::string& description) const {
+    return StringPrintf(
+        "%s %zu threads %s", description.c_str(), num_running_threads(),
+        worker_pool_mode() ==
+                SchedulerWorkerPoolParams::WorkerPoolMode::WORK_STEALING
+            ? "work stealing"
+            : "shared queue");
+  }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(TaskSchedulerWorkerPoolModePerfTest);
+};
+
 }  // namespace
 
 TEST_F(TaskSchedulerPerfTest, BindPostThenRunNoOpTasks) {
@@ -256,5 +306,36 @@ TEST_F(TaskSchedulerPerfTest, PostRunBusyTasksManyThreads) {
   Benchmark("Post/run busy tasks many threads", ExecutionMode::kPostAndRun);
 }
 
+TEST_P(TaskSchedulerWorkerPoolModePerfTest, PostThenRunNoOpSequencedTasks) {
+  StartTaskScheduler(
+      num_running_threads(), num_running_threads(),
+      BindRepeating(
+          &TaskSchedulerPerfTest::ContinuouslyPostNoOpTasksToSequences,
+          Unretained(this), 100, 100),
+      worker_pool_mode());
+  Benchmark(GetTrace("Post-then-run no-op sequenced tasks"),
+            ExecutionMode::kPostThenRun);
+}
+
+TEST_P(TaskSchedulerWorkerPoolModePerfTest, PostRunNoOpSequencedTasks) {
+  StartTaskScheduler(
+      num_running_threads(), num_running_threads(),
+      BindRepeating(
+          &TaskSchedulerPerfTest::ContinuouslyPostNoOpTasksToSequences,
+          Unretained(this), 100, 100),
+      worker_pool_mode());
+  Benchmark(GetTrace("Post/run no-op sequenced tasks"),
+            ExecutionMode::kPostAndRun);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    ,
+    TaskSchedulerWorkerPoolModePerfTest,
+    testing::Combine(
+        testing::Values(1, 4, 16, 64),
+        testing::Values(
+            SchedulerWorkerPoolParams::WorkerPoolMode::SHARED_QUEUE,
+            SchedulerWorkerPoolParams::WorkerPoolMode::WORK_STEALING)));
+
 }  // namespace internal
 }  // namespace base
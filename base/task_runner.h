@@ -7,6 +7,8 @@
 
 #include <stddef.h>
 
+#include <vector>
+
 #include "base/base_export.h"
 #include "base/callback.h"
 #include "base/location.h"
@@ -70,6 +72,16 @@ class BASE_EXPORT TaskRunner
                                OnceClosure task,
                                base::TimeDelta delay) = 0;
 
+  // Posts all of |tasks| to be run without delay, in order for sequenced
+  // TaskRunners. Returns true if all tasks may be run at some point in the
+  // future, and false if at least one of them definitely will not be run.
+  //
+  // The default implementation calls PostTask() for each task.
+  // Implementations that can enqueue the whole batch with a single lock
+  // acquisition and a single wake-up should override this.
+  virtual bool PostTasks(const Location& from_here,
+                         std::vector<OnceClosure> tasks);
+
   // Returns true iff tasks posted to this TaskRunner are sequenced
   // with this call.
   //
@@ -40,6 +40,7 @@ class MallocDumpProvider;
 
 namespace internal {
 
+class BindStateAllocator;
 class ThreadLocalStorageTestInternal;
 
 // WARNING: You should *NOT* use this class directly.
@@ -162,6 +163,7 @@ class BASE_EXPORT ThreadLocalStorage {
   // disallowed and will hit a DCHECK. Any code that relies on TLS during thread
   // destruction must first check this method before calling Slot::Get().
   friend class base::SamplingHeapProfiler;
+  friend class base::internal::BindStateAllocator;
   friend class base::internal::ThreadLocalStorageTestInternal;
   friend class base::trace_event::MallocDumpProvider;
   friend class debug::GlobalActivityTracker;
@@ -0,0 +1,215 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/trace_event/trace_event_binary_writer.h"
+
+#include <string.h>
+
+#include "base/logging.h"
+#include "base/trace_event/trace_event.h"
+#include "base/trace_event/trace_log.h"
+
+namespace base {
+namespace trace_event {
+
+namespace {
+
+void AppendString(StringPiece str, std::string* out) {
+  TraceEventBinaryWriter::AppendVarint(str.size(), out);
+  out->append(str.data(), str.size());
+}
+
+}  // namespace
+
+constexpr char TraceEventBinaryWriter::kMagic[];
+
+TraceEventBinaryWriter::TraceEventBinaryWriter() = default;
+
+TraceEventBinaryWriter::~TraceEventBinaryWriter() = default;
+
+void TraceEventBinaryWriter::AppendHeader(int process_id, std::string* out) {
+  out->append(kMagic, sizeof(kMagic) - 1);
+  AppendVarint(kVersion, out);
+  AppendSignedVarint(process_id, out);
+}
+
+void TraceEventBinaryWriter::AppendEvent(
+    const TraceEvent& event,
+    const ArgumentFilterPredicate& argument_filter_predicate,
+    std::string* out) {
+  const char* category_group_name =
+      TraceLog::GetCategoryGroupName(event.category_group_enabled());
+  bool is_copy = event.flags() & TRACE_EVENT_FLAG_COPY;
+
+  // Strings are interned up front so that their records precede the event.
+  uint32_t category_id = InternString(category_group_name, true, out);
+  uint32_t name_id = InternString(event.name(), !is_copy, out);
+
+  // Same argument filtering as TraceEvent::AppendAsJSON().
+  ArgumentNameFilterPredicate argument_name_filter_predicate;
+  bool strip_args = event.arg_size() > 0 && event.arg_name(0) &&
+                    !argument_filter_predicate.is_null() &&
+                    !argument_filter_predicate.Run(
+                        category_group_name, event.name(),
+                        &argument_name_filter_predicate);
+  size_t arg_count = 0;
+  uint32_t arg_name_ids[TraceArguments::kMaxSize];
+  if (!strip_args) {
+    for (; arg_count < event.arg_size() && event.arg_name(arg_count);
+         ++arg_count) {
+      arg_name_ids[arg_count] =
+          InternString(event.arg_name(arg_count), !is_copy, out);
+    }
+  }
+
+  uint32_t fields = 0;
+  if (!event.thread_timestamp().is_null())
+    fields |= kHasThreadTimestamp;
+  if (event.phase() == TRACE_EVENT_PHASE_COMPLETE) {
+    if (event.duration().ToInternalValue() != -1)
+      fields |= kHasDuration;
+    if (!event.thread_timestamp().is_null() &&
+        event.thread_duration().ToInternalValue() != -1) {
+      fields |= kHasThreadDuration;
+    }
+  }
+  uint32_t scope_id = 0;
+  if (event.flags() & (TRACE_EVENT_FLAG_HAS_ID | TRACE_EVENT_FLAG_HAS_LOCAL_ID |
+                       TRACE_EVENT_FLAG_HAS_GLOBAL_ID)) {
+    fields |= kHasId;
+    if (event.scope() != trace_event_internal::kGlobalScope) {
+      fields |= kHasScope;
+      scope_id = InternString(event.scope(), true, out);
+    }
+  }
+  if (event.flags() & (TRACE_EVENT_FLAG_FLOW_IN | TRACE_EVENT_FLAG_FLOW_OUT))
+    fields |= kHasBindId;
+  if (strip_args)
+    fields |= kArgsStripped;
+
+  out->push_back(kEventRecord);
+  out->push_back(event.phase());
+  AppendVarint(fields, out);
+  AppendVarint(event.flags(), out);
+  AppendVarint(category_id, out);
+  AppendVarint(name_id, out);
+  // Like in the JSON format, events with TRACE_EVENT_FLAG_HAS_PROCESS_ID carry
+  // a process id instead of a thread id.
+  AppendSignedVarint(event.thread_id(), out);
+
+  int64_t timestamp = event.timestamp().ToInternalValue();
+  AppendSignedVarint(timestamp - last_timestamp_, out);
+  last_timestamp_ = timestamp;
+  if (fields & kHasThreadTimestamp) {
+    int64_t thread_timestamp = event.thread_timestamp().ToInternalValue();
+    AppendSignedVarint(thread_timestamp - last_thread_timestamp_, out);
+    last_thread_timestamp_ = thread_timestamp;
+  }
+  if (fields & kHasDuration)
+    AppendSignedVarint(event.duration().ToInternalValue(), out);
+  if (fields & kHasThreadDuration)
+    AppendSignedVarint(event.thread_duration().ToInternalValue(), out);
+  if (fields & kHasScope)
+    AppendVarint(scope_id, out);
+  if (fields & kHasId)
+    AppendVarint(event.id(), out);
+  if (fields & kHasBindId)
+    AppendVarint(event.bind_id(), out);
+
+  AppendVarint(arg_count, out);
+  for (size_t i = 0; i < arg_count; ++i) {
+    AppendVarint(arg_name_ids[i], out);
+    if (argument_name_filter_predicate.is_null() ||
+        argument_name_filter_predicate.Run(event.arg_name(i))) {
+      AppendArg(event.arg_type(i), event.arg_value(i), out);
+    } else {
+      out->push_back(static_cast<char>(kStrippedArgType));
+    }
+  }
+}
+
+// static
+void TraceEventBinaryWriter::AppendVarint(uint64_t value, std::string* out) {
+  while (value >= 0x80) {
+    out->push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  out->push_back(static_cast<char>(value));
+}
+
+// static
+void TraceEventBinaryWriter::AppendSignedVarint(int64_t value,
+                                                std::string* out) {
+  AppendVarint((static_cast<uint64_t>(value) << 1) ^
+                   static_cast<uint64_t>(value >> 63),
+               out);
+}
+
+uint32_t TraceEventBinaryWriter::InternString(const char* str,
+                                              bool is_static,
+                                              std::string* out) {
+  if (is_static) {
+    auto it = interned_addresses_.find(str);
+    if (it != interned_addresses_.end())
+      return it->second;
+  }
+
+  auto result = interned_strings_.emplace(
+      str, static_cast<uint32_t>(interned_strings_.size()));
+  uint32_t id = result.first->second;
+  if (result.second) {
+    out->push_back(kStringRecord);
+    AppendVarint(id, out);
+    AppendString(result.first->first, out);
+  }
+  if (is_static)
+    interned_addresses_.emplace(str, id);
+  return id;
+}
+
+void TraceEventBinaryWriter::AppendArg(unsigned char type,
+                                       const TraceValue& value,
+                                       std::string* out) {
+  out->push_back(static_cast<char>(type));
+  switch (type) {
+    case TRACE_VALUE_TYPE_BOOL:
+      out->push_back(value.as_bool ? 1 : 0);
+      break;
+    case TRACE_VALUE_TYPE_UINT:
+      AppendVarint(value.as_uint, out);
+      break;
+    case TRACE_VALUE_TYPE_INT:
+      AppendSignedVarint(value.as_int, out);
+      break;
+    case TRACE_VALUE_TYPE_DOUBLE: {
+      uint64_t bits;
+      static_assert(sizeof(bits) == sizeof(value.as_double),
+                    "double must be 64-bit");
+      memcpy(&bits, &value.as_double, sizeof(bits));
+      for (int i = 0; i < 8; ++i)
+        out->push_back(static_cast<char>(bits >> (i * 8)));
+      break;
+    }
+    case TRACE_VALUE_TYPE_POINTER:
+      AppendVarint(reinterpret_cast<uintptr_t>(value.as_pointer), out);
+      break;
+    case TRACE_VALUE_TYPE_STRING:
+    case TRACE_VALUE_TYPE_COPY_STRING:
+      AppendString(value.as_string ? value.as_string : "NULL", out);
+      break;
+    case TRACE_VALUE_TYPE_CONVERTABLE: {
+      std::string json;
+      value.as_convertable->AppendAsTraceFormat(&json);
+      AppendString(json, out);
+      break;
+    }
+    default:
+      NOTREACHED() << "Don't know how to serialize trace value type " << type;
+      AppendString(StringPiece(), out);
+      break;
+  }
+}
+
+}  // namespace trace_event
+}  // namespace base
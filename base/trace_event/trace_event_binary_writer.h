@@ -0,0 +1,110 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_TRACE_EVENT_TRACE_EVENT_BINARY_WRITER_H_
+#define BASE_TRACE_EVENT_TRACE_EVENT_BINARY_WRITER_H_
+
+#include <stdint.h>
+
+#include <string>
+#include <unordered_map>
+
+#include "base/base_export.h"
+#include "base/macros.h"
+#include "base/strings/string_piece.h"
+#include "base/trace_event/trace_event_impl.h"
+
+namespace base {
+namespace trace_event {
+
+// Serializes TraceEvents into a compact binary stream, as an alternative to
+// TraceEvent::AppendAsJSON() for large traces. The stream is produced
+// incrementally: its pieces can be written out (e.g. to a file or a data pipe)
+// as they're produced, as long as they're concatenated in order.
+//
+// The stream starts with a header, followed by a sequence of records each
+// starting with a one byte tag. All integers are encoded as LEB128 varints;
+// signed integers are zigzag-encoded first.
+//
+//   header: "CTRB" version:varint process_id:signed
+//   kStringRecord: id:varint size:varint bytes[size]
+//   kEventRecord: phase:byte fields:varint flags:varint category:string_id
+//                 name:string_id tid:signed ts_delta:signed
+//                 [tts_delta:signed] [dur:signed] [tdur:signed]
+//                 [scope:string_id] [id:varint] [bind_id:varint]
+//                 arg_count:varint (arg_name:string_id arg)*
+//
+// Strings (event names, categories, scopes and argument names) are interned:
+// each is sent once in a kStringRecord and referred to by id afterwards.
+// Timestamps are sent as the difference to the timestamp of the previous event
+// in the stream, in microseconds. The optional event fields are present when
+// the corresponding EventField bit is set in |fields|. An argument is its
+// TRACE_VALUE_TYPE_* byte followed by its value: a byte for booleans, a varint
+// for unsigned integers and pointers, a signed varint for integers, 8 little
+// endian bytes for doubles and a size-prefixed string for strings and
+// convertables (in their JSON trace format). Arguments removed by the argument
+// filter use kStrippedArgType and have no value.
+class BASE_EXPORT TraceEventBinaryWriter {
+ public:
+  static constexpr char kMagic[] = "CTRB";
+  static constexpr uint32_t kVersion = 1;
+
+  enum RecordTag : uint8_t {
+    kStringRecord = 1,
+    kEventRecord = 2,
+  };
+
+  enum EventField : uint32_t {
+    kHasThreadTimestamp = 1 << 0,
+    kHasDuration = 1 << 1,
+    kHasThreadDuration = 1 << 2,
+    kHasScope = 1 << 3,
+    kHasId = 1 << 4,
+    kHasBindId = 1 << 5,
+    // All arguments were removed by the argument filter.
+    kArgsStripped = 1 << 6,
+  };
+
+  static constexpr uint8_t kStrippedArgType = 0xff;
+
+  TraceEventBinaryWriter();
+  ~TraceEventBinaryWriter();
+
+  // Appends the stream header to |out|. Must be called once, before the first
+  // AppendEvent().
+  void AppendHeader(int process_id, std::string* out);
+
+  // Appends |event| to |out|, along with any string it refers to which hasn't
+  // been interned in this stream yet.
+  void AppendEvent(const TraceEvent& event,
+                   const ArgumentFilterPredicate& argument_filter_predicate,
+                   std::string* out);
+
+  // Appends |value| to |out| as an (unsigned) varint, or as a zigzag-encoded
+  // varint for signed values.
+  static void AppendVarint(uint64_t value, std::string* out);
+  static void AppendSignedVarint(int64_t value, std::string* out);
+
+ private:
+  // Returns the id of |str| in this stream, appending a kStringRecord for it to
+  // |out| first if it wasn't interned yet. Strings which live as long as the
+  // trace (i.e. not copied into the event) are looked up by address first,
+  // which avoids hashing them.
+  uint32_t InternString(const char* str, bool is_static, std::string* out);
+
+  void AppendArg(unsigned char type, const TraceValue& value, std::string* out);
+
+  std::unordered_map<const void*, uint32_t> interned_addresses_;
+  std::unordered_map<std::string, uint32_t> interned_strings_;
+
+  int64_t last_timestamp_ = 0;
+  int64_t last_thread_timestamp_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(TraceEventBinaryWriter);
+};
+
+}  // namespace trace_event
+}  // namespace base
+
+#endif  // BASE_TRACE_EVENT_TRACE_EVENT_BINARY_WRITER_H_
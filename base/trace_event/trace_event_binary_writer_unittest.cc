@@ -0,0 +1,251 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/trace_event/trace_event_binary_writer.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/memory/ref_counted_memory.h"
+#include "base/trace_event/trace_event.h"
+#include "base/trace_event/trace_log.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+namespace trace_event {
+
+namespace {
+
+// Minimal decoder for the parts of the stream checked by the tests below.
+class StreamReader {
+ public:
+  explicit StreamReader(const std::string& data) : data_(data) {}
+
+  bool AtEnd() const { return pos_ >= data_.size(); }
+  bool failed() const { return failed_; }
+
+  uint8_t ReadByte() {
+    if (AtEnd()) {
+      failed_ = true;
+      return 0;
+    }
+    return static_cast<uint8_t>(data_[pos_++]);
+  }
+
+  uint64_t ReadVarint() {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      uint8_t byte = ReadByte();
+      value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if (!(byte & 0x80))
+        break;
+    }
+    return value;
+  }
+
+  int64_t ReadSignedVarint() {
+    uint64_t value = ReadVarint();
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+  }
+
+  std::string ReadString(size_t size) {
+    if (pos_ + size > data_.size()) {
+      failed_ = true;
+      return std::string();
+    }
+    std::string result = data_.substr(pos_, size);
+    pos_ += size;
+    return result;
+  }
+
+ private:
+  const std::string& data_;
+  size_t pos_ = 0;
+  bool failed_ = false;
+};
+
+struct DecodedEvent {
+  char phase;
+  std::string category;
+  std::string name;
+  int64_t timestamp;
+  std::map<std::string, int64_t> int_args;
+};
+
+// Decodes |data|, keeping only the integer arguments of the events. Returns
+// false if it is malformed. |string_record_count| receives the number of
+// interned strings.
+bool DecodeStream(const std::string& data,
+                  std::vector<DecodedEvent>* events,
+                  size_t* string_record_count) {
+  StreamReader reader(data);
+  if (reader.ReadString(4) != TraceEventBinaryWriter::kMagic ||
+      reader.ReadVarint() != TraceEventBinaryWriter::kVersion) {
+    return false;
+  }
+  reader.ReadSignedVarint();  // Process id.
+
+  std::map<uint64_t, std::string> strings;
+  int64_t timestamp = 0;
+  while (!reader.AtEnd() && !reader.failed()) {
+    uint8_t tag = reader.ReadByte();
+    if (tag == TraceEventBinaryWriter::kStringRecord) {
+      uint64_t id = reader.ReadVarint();
+      if (strings.count(id))
+        return false;
+      strings[id] = reader.ReadString(reader.ReadVarint());
+      continue;
+    }
+    if (tag != TraceEventBinaryWriter::kEventRecord)
+      return false;
+
+    DecodedEvent event;
+    event.phase = static_cast<char>(reader.ReadByte());
+    uint64_t fields = reader.ReadVarint();
+    reader.ReadVarint();  // Flags.
+    event.category = strings[reader.ReadVarint()];
+    event.name = strings[reader.ReadVarint()];
+    reader.ReadSignedVarint();  // Thread id.
+    timestamp += reader.ReadSignedVarint();
+    event.timestamp = timestamp;
+    if (fields & TraceEventBinaryWriter::kHasThreadTimestamp)
+      reader.ReadSignedVarint();
+    if (fields & TraceEventBinaryWriter::kHasDuration)
+      reader.ReadSignedVarint();
+    if (fields & TraceEventBinaryWriter::kHasThreadDuration)
+      reader.ReadSignedVarint();
+    if (fields & TraceEventBinaryWriter::kHasScope)
+      reader.ReadVarint();
+    if (fields & TraceEventBinaryWriter::kHasId)
+      reader.ReadVarint();
+    if (fields & TraceEventBinaryWriter::kHasBindId)
+      reader.ReadVarint();
+    uint64_t arg_count = reader.ReadVarint();
+    for (uint64_t i = 0; i < arg_count; ++i) {
+      std::string arg_name = strings[reader.ReadVarint()];
+      switch (reader.ReadByte()) {
+        case TRACE_VALUE_TYPE_INT:
+          event.int_args[arg_name] = reader.ReadSignedVarint();
+          break;
+        case TRACE_VALUE_TYPE_BOOL:
+          reader.ReadByte();
+          break;
+        case TRACE_VALUE_TYPE_UINT:
+        case TRACE_VALUE_TYPE_POINTER:
+          reader.ReadVarint();
+          break;
+        case TRACE_VALUE_TYPE_DOUBLE:
+          reader.ReadString(8);
+          break;
+        case TRACE_VALUE_TYPE_STRING:
+        case TRACE_VALUE_TYPE_COPY_STRING:
+        case TRACE_VALUE_TYPE_CONVERTABLE:
+          reader.ReadString(reader.ReadVarint());
+          break;
+        case TraceEventBinaryWriter::kStrippedArgType:
+          break;
+        default:
+          return false;
+      }
+    }
+    events->push_back(event);
+  }
+  *string_record_count = strings.size();
+  return !reader.failed();
+}
+
+void AppendToString(std::string* out,
+                    const scoped_refptr<RefCountedString>& events_str,
+                    bool has_more_events) {
+  out->append(events_str->data());
+}
+
+}  // namespace
+
+TEST(TraceEventBinaryWriterTest, Varints) {
+  std::string out;
+  TraceEventBinaryWriter::AppendVarint(0, &out);
+  TraceEventBinaryWriter::AppendVarint(300, &out);
+  TraceEventBinaryWriter::AppendSignedVarint(-1, &out);
+  TraceEventBinaryWriter::AppendSignedVarint(INT64_MIN, &out);
+  TraceEventBinaryWriter::AppendVarint(UINT64_MAX, &out);
+  EXPECT_EQ(std::string("\x00\xac\x02\x01", 4), out.substr(0, 4));
+
+  StreamReader reader(out);
+  EXPECT_EQ(0u, reader.ReadVarint());
+  EXPECT_EQ(300u, reader.ReadVarint());
+  EXPECT_EQ(-1, reader.ReadSignedVarint());
+  EXPECT_EQ(INT64_MIN, reader.ReadSignedVarint());
+  EXPECT_EQ(UINT64_MAX, reader.ReadVarint());
+  EXPECT_TRUE(reader.AtEnd());
+  EXPECT_FALSE(reader.failed());
+}
+
+TEST(TraceEventBinaryWriterTest, InternsStringsAndEncodesDeltas) {
+  const unsigned char* category =
+      TraceLog::GetCategoryGroupEnabled("binary_writer_test");
+  TraceEventBinaryWriter writer;
+  std::string out;
+  writer.AppendHeader(1, &out);
+
+  for (int i = 0; i < 3; ++i) {
+    TraceArguments args("value", i);
+    TraceEvent event(1, TimeTicks() + TimeDelta::FromMicroseconds(1000 + i),
+                     ThreadTicks(), TRACE_EVENT_PHASE_INSTANT, category,
+                     "Event", trace_event_internal::kGlobalScope,
+                     trace_event_internal::kNoId,
+                     trace_event_internal::kNoId, &args,
+                     TRACE_EVENT_SCOPE_THREAD);
+    writer.AppendEvent(event, ArgumentFilterPredicate(), &out);
+  }
+
+  std::vector<DecodedEvent> events;
+  size_t string_record_count = 0;
+  ASSERT_TRUE(DecodeStream(out, &events, &string_record_count));
+  // The category, event name and argument name.
+  EXPECT_EQ(3u, string_record_count);
+  ASSERT_EQ(3u, events.size());
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(TRACE_EVENT_PHASE_INSTANT, events[i].phase);
+    EXPECT_EQ("binary_writer_test", events[i].category);
+    EXPECT_EQ("Event", events[i].name);
+    EXPECT_EQ(1000 + i, events[i].timestamp);
+    EXPECT_EQ(i, events[i].int_args["value"]);
+  }
+}
+
+TEST(TraceEventBinaryWriterTest, FlushBinary) {
+  TraceLog::ResetForTesting();
+  TraceLog::GetInstance()->SetEnabled(TraceConfig("binary_writer_test", ""),
+                                      TraceLog::RECORDING_MODE);
+  for (int i = 0; i < 1000; ++i)
+    TRACE_EVENT_INSTANT1("binary_writer_test", "Event",
+                         TRACE_EVENT_SCOPE_THREAD, "value", i);
+  TraceLog::GetInstance()->SetDisabled();
+
+  std::string out;
+  TraceLog::GetInstance()->FlushBinary(
+      BindRepeating(&AppendToString, Unretained(&out)));
+
+  std::vector<DecodedEvent> events;
+  size_t string_record_count = 0;
+  ASSERT_TRUE(DecodeStream(out, &events, &string_record_count));
+  int count = 0;
+  for (const DecodedEvent& event : events) {
+    if (event.name != "Event")
+      continue;
+    EXPECT_EQ("binary_writer_test", event.category);
+    EXPECT_EQ(count, event.int_args["value"]);
+    ++count;
+  }
+  EXPECT_EQ(1000, count);
+}
+
+}  // namespace trace_event
+}  // namespace base
@@ -42,6 +42,7 @@
 #include "base/trace_event/process_memory_dump.h"
 #include "base/trace_event/trace_buffer.h"
 #include "base/trace_event/trace_event.h"
+#include "base/trace_event/trace_event_binary_writer.h"
 #include "build/build_config.h"
 
 #if defined(OS_WIN)
@@ -79,6 +80,21 @@ const size_t kTraceEventRingBufferChunks = kTraceEventVectorBufferChunks / 4;
 // ECHO_TO_CONSOLE needs a small buffer to hold the unfinished COMPLETE events.
 const size_t kEchoToConsoleTraceEventBufferChunks = 256;
 
+// Number of chunks a ThreadLocalEventBuffer takes from the TraceBuffer at once.
+// Full chunks are held by the thread until the last of them fills up and are
+// then all handed back, along with taking the next batch, under a single
+// acquisition of TraceLog's lock. Buffers with fewer chunks than
+// kTraceEventRingBufferChunks (i.e. ECHO_TO_CONSOLE) refill one chunk at a
+// time so that a large number of threads can't exhaust them.
+const size_t kChunksPerThreadLocalRefill = 4;
+
+size_t GetThreadLocalRefillChunkCount(const TraceBuffer* buffer) {
+  size_t capacity_in_chunks = buffer->Capacity() / kTraceBufferChunkSize;
+  return capacity_in_chunks >= kTraceEventRingBufferChunks
+             ? kChunksPerThreadLocalRefill
+             : 1;
+}
+
 const size_t kTraceEventBufferSizeInBytes = 100 * 1024;
 const int kThreadFlushTimeoutMs = 3000;
 
@@ -202,12 +218,13 @@ class TraceLog::ThreadLocalEventBuffer
   TraceEvent* AddTraceEvent(TraceEventHandle* handle);
 
   TraceEvent* GetEventByHandle(TraceEventHandle handle) {
-    if (!chunk_ || handle.chunk_seq != chunk_->seq() ||
-        handle.chunk_index != chunk_index_) {
-      return nullptr;
+    for (size_t i = 0; i < chunk_count_; ++i) {
+      if (chunks_[i].chunk && handle.chunk_seq == chunks_[i].chunk->seq() &&
+          handle.chunk_index == chunks_[i].index) {
+        return chunks_[i].chunk->GetEventAt(handle.event_index);
+      }
     }
-
-    return chunk_->GetEventAt(handle.event_index);
+    return nullptr;
   }
 
   int generation() const { return generation_; }
@@ -220,8 +237,12 @@ class TraceLog::ThreadLocalEventBuffer
   bool OnMemoryDump(const MemoryDumpArgs& args,
                     ProcessMemoryDump* pmd) override;
 
+  // Returns all chunks held by this buffer to the TraceBuffer.
   void FlushWhileLocked();
 
+  // Flushes the held chunks and takes a new batch from the TraceBuffer.
+  void RefillWhileLocked();
+
   void CheckThisIsCurrentBuffer() const {
     DCHECK(trace_log_->thread_local_event_buffer_.Get() == this);
   }
@@ -229,17 +250,25 @@ class TraceLog::ThreadLocalEventBuffer
   // Since TraceLog is a leaky singleton, trace_log_ will always be valid
   // as long as the thread exists.
   TraceLog* trace_log_;
-  std::unique_ptr<TraceBufferChunk> chunk_;
-  size_t chunk_index_;
+
+  // The chunks taken from the TraceBuffer by the last refill. Events are added
+  // to |chunks_[current_chunk_]|; the chunks before it are full and those after
+  // it are still empty. None of them are visible to the TraceBuffer until
+  // they're returned by FlushWhileLocked().
+  struct HeldChunk {
+    std::unique_ptr<TraceBufferChunk> chunk;
+    size_t index = 0;
+  };
+  HeldChunk chunks_[kChunksPerThreadLocalRefill];
+  size_t chunk_count_ = 0;
+  size_t current_chunk_ = 0;
   int generation_;
 
   DISALLOW_COPY_AND_ASSIGN(ThreadLocalEventBuffer);
 };
 
 TraceLog::ThreadLocalEventBuffer::ThreadLocalEventBuffer(TraceLog* trace_log)
-    : trace_log_(trace_log),
-      chunk_index_(0),
-      generation_(trace_log->generation()) {
+    : trace_log_(trace_log), generation_(trace_log->generation()) {
   // ThreadLocalEventBuffer is created only if the thread has a message loop, so
   // the following message_loop won't be NULL.
   MessageLoopCurrent::Get()->AddDestructionObserver(this);
@@ -273,23 +302,23 @@ TraceEvent* TraceLog::ThreadLocalEventBuffer::AddTraceEvent(
     TraceEventHandle* handle) {
   CheckThisIsCurrentBuffer();
 
-  if (chunk_ && chunk_->IsFull()) {
-    AutoLock lock(trace_log_->lock_);
-    FlushWhileLocked();
-    chunk_.reset();
+  // Move on to the next held chunk without locking while there is one.
+  if (current_chunk_ < chunk_count_ && chunks_[current_chunk_].chunk &&
+      chunks_[current_chunk_].chunk->IsFull()) {
+    ++current_chunk_;
   }
-  if (!chunk_) {
+  if (current_chunk_ >= chunk_count_) {
     AutoLock lock(trace_log_->lock_);
-    chunk_ = trace_log_->logged_events_->GetChunk(&chunk_index_);
-    trace_log_->CheckIfBufferIsFullWhileLocked();
+    RefillWhileLocked();
   }
-  if (!chunk_)
+  if (current_chunk_ >= chunk_count_)
     return nullptr;
 
+  HeldChunk& current = chunks_[current_chunk_];
   size_t event_index;
-  TraceEvent* trace_event = chunk_->AddTraceEvent(&event_index);
+  TraceEvent* trace_event = current.chunk->AddTraceEvent(&event_index);
   if (trace_event && handle)
-    MakeHandle(chunk_->seq(), chunk_index_, event_index, handle);
+    MakeHandle(current.chunk->seq(), current.index, event_index, handle);
 
   return trace_event;
 }
@@ -300,27 +329,57 @@ void TraceLog::ThreadLocalEventBuffer::WillDestroyCurrentMessageLoop() {
 
 bool TraceLog::ThreadLocalEventBuffer::OnMemoryDump(const MemoryDumpArgs& args,
                                                     ProcessMemoryDump* pmd) {
-  if (!chunk_)
+  if (!chunk_count_)
     return true;
   std::string dump_base_name = StringPrintf(
       "tracing/thread_%d", static_cast<int>(PlatformThread::CurrentId()));
   TraceEventMemoryOverhead overhead;
-  chunk_->EstimateTraceMemoryOverhead(&overhead);
+  for (size_t i = 0; i < chunk_count_; ++i) {
+    if (chunks_[i].chunk)
+      chunks_[i].chunk->EstimateTraceMemoryOverhead(&overhead);
+  }
   overhead.DumpInto(dump_base_name.c_str(), pmd);
   return true;
 }
 
 void TraceLog::ThreadLocalEventBuffer::FlushWhileLocked() {
-  if (!chunk_)
+  if (!chunk_count_)
     return;
 
   trace_log_->lock_.AssertAcquired();
   if (trace_log_->CheckGeneration(generation_)) {
-    // Return the chunk to the buffer only if the generation matches.
-    trace_log_->logged_events_->ReturnChunk(chunk_index_, std::move(chunk_));
+    // Return the chunks to the buffer only if the generation matches.
+    for (size_t i = 0; i < chunk_count_; ++i) {
+      trace_log_->logged_events_->ReturnChunk(chunks_[i].index,
+                                              std::move(chunks_[i].chunk));
+    }
   }
   // Otherwise this method may be called from the destructor, or TraceLog will
   // find the generation mismatch and delete this buffer soon.
+  for (size_t i = 0; i < chunk_count_; ++i)
+    chunks_[i].chunk.reset();
+  chunk_count_ = 0;
+  current_chunk_ = 0;
+}
+
+void TraceLog::ThreadLocalEventBuffer::RefillWhileLocked() {
+  trace_log_->lock_.AssertAcquired();
+  FlushWhileLocked();
+
+  size_t refill_count =
+      GetThreadLocalRefillChunkCount(trace_log_->logged_events_.get());
+  for (size_t i = 0; i < refill_count; ++i) {
+    HeldChunk& held = chunks_[chunk_count_];
+    held.chunk = trace_log_->logged_events_->GetChunk(&held.index);
+    if (!held.chunk)
+      break;
+    ++chunk_count_;
+    // Stop taking chunks once the buffer fills up, as recording is about to
+    // be disabled.
+    if (trace_log_->logged_events_->IsFull())
+      break;
+  }
+  trace_log_->CheckIfBufferIsFullWhileLocked();
 }
 
 void TraceLog::SetAddTraceEventOverrides(
@@ -856,6 +915,11 @@ void TraceLog::Flush(const TraceLog::OutputCallback& cb,
   FlushInternal(cb, use_worker_thread, false);
 }
 
+void TraceLog::FlushBinary(const TraceLog::OutputCallback& cb,
+                           bool use_worker_thread) {
+  FlushInternal(cb, use_worker_thread, false, FlushFormat::kBinary);
+}
+
 void TraceLog::CancelTracing(const OutputCallback& cb) {
   SetDisabled();
   FlushInternal(cb, false, true);
@@ -863,7 +927,8 @@ void TraceLog::CancelTracing(const OutputCallback& cb) {
 
 void TraceLog::FlushInternal(const TraceLog::OutputCallback& cb,
                              bool use_worker_thread,
-                             bool discard_events) {
+                             bool discard_events,
+                             FlushFormat format) {
   use_worker_thread_ = use_worker_thread;
   if (IsEnabled()) {
     // Can't flush when tracing is enabled because otherwise PostTask would
@@ -888,6 +953,7 @@ void TraceLog::FlushInternal(const TraceLog::OutputCallback& cb,
                              : nullptr;
     DCHECK(thread_task_runners_.empty() || flush_task_runner_);
     flush_output_callback_ = cb;
+    flush_format_ = format;
 
     if (thread_shared_chunk_) {
       logged_events_->ReturnChunk(thread_shared_chunk_index_,
@@ -946,10 +1012,39 @@ void TraceLog::ConvertTraceEventsToTraceFormat(
   flush_output_callback.Run(json_events_str_ptr, false);
 }
 
+void TraceLog::ConvertTraceEventsToBinaryFormat(
+    std::unique_ptr<TraceBuffer> logged_events,
+    int process_id,
+    const OutputCallback& flush_output_callback,
+    const ArgumentFilterPredicate& argument_filter_predicate) {
+  if (flush_output_callback.is_null())
+    return;
+
+  HEAP_PROFILER_SCOPED_IGNORE;
+  TraceEventBinaryWriter writer;
+  scoped_refptr<RefCountedString> events_str_ptr = new RefCountedString();
+  const size_t kReserveCapacity = kTraceEventBufferSizeInBytes * 5 / 4;
+  events_str_ptr->data().reserve(kReserveCapacity);
+  writer.AppendHeader(process_id, &events_str_ptr->data());
+  while (const TraceBufferChunk* chunk = logged_events->NextChunk()) {
+    for (size_t j = 0; j < chunk->size(); ++j) {
+      if (events_str_ptr->size() > kTraceEventBufferSizeInBytes) {
+        flush_output_callback.Run(events_str_ptr, true);
+        events_str_ptr = new RefCountedString();
+        events_str_ptr->data().reserve(kReserveCapacity);
+      }
+      writer.AppendEvent(*chunk->GetEventAt(j), argument_filter_predicate,
+                         &events_str_ptr->data());
+    }
+  }
+  flush_output_callback.Run(events_str_ptr, false);
+}
+
 void TraceLog::FinishFlush(int generation, bool discard_events) {
   std::unique_ptr<TraceBuffer> previous_logged_events;
   OutputCallback flush_output_callback;
   ArgumentFilterPredicate argument_filter_predicate;
+  FlushFormat flush_format;
 
   if (!CheckGeneration(generation))
     return;
@@ -964,6 +1059,7 @@ void TraceLog::FinishFlush(int generation, bool discard_events) {
     flush_task_runner_ = nullptr;
     flush_output_callback = flush_output_callback_;
     flush_output_callback_.Reset();
+    flush_format = flush_format_;
 
     if (trace_options() & kInternalEnableArgumentFilter) {
       // If argument filtering is activated and there is no filtering predicate,
@@ -985,20 +1081,26 @@ void TraceLog::FinishFlush(int generation, bool discard_events) {
     return;
   }
 
+  OnceClosure convert_task;
+  if (flush_format == FlushFormat::kBinary) {
+    convert_task = BindOnce(&TraceLog::ConvertTraceEventsToBinaryFormat,
+                            std::move(previous_logged_events), process_id(),
+                            flush_output_callback, argument_filter_predicate);
+  } else {
+    convert_task = BindOnce(&TraceLog::ConvertTraceEventsToTraceFormat,
+                            std::move(previous_logged_events),
+                            flush_output_callback, argument_filter_predicate);
+  }
+
   if (use_worker_thread_) {
-    base::PostTaskWithTraits(
-        FROM_HERE,
-        {MayBlock(), TaskPriority::BEST_EFFORT,
-         TaskShutdownBehavior::CONTINUE_ON_SHUTDOWN},
-        BindOnce(&TraceLog::ConvertTraceEventsToTraceFormat,
-                 std::move(previous_logged_events), flush_output_callback,
-                 argument_filter_predicate));
+    base::PostTaskWithTraits(FROM_HERE,
+                             {MayBlock(), TaskPriority::BEST_EFFORT,
+                              TaskShutdownBehavior::CONTINUE_ON_SHUTDOWN},
+                             std::move(convert_task));
     return;
   }
 
-  ConvertTraceEventsToTraceFormat(std::move(previous_logged_events),
-                                  flush_output_callback,
-                                  argument_filter_predicate);
+  std::move(convert_task).Run();
 }
 
 // Run in each thread holding a local event buffer.
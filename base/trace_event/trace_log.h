@@ -185,6 +185,12 @@ class BASE_EXPORT TraceLog : public MemoryDumpProvider {
                               bool has_more_events)> OutputCallback;
   void Flush(const OutputCallback& cb, bool use_worker_thread = false);
 
+  // Same as Flush(), but the events are serialized in the compact binary format
+  // described in trace_event_binary_writer.h instead of JSON. Concatenating the
+  // strings passed to |cb| gives the complete stream, so they can be written to
+  // a file or a data pipe as they come.
+  void FlushBinary(const OutputCallback& cb, bool use_worker_thread = false);
+
   // Cancels tracing and discards collected data.
   void CancelTracing(const OutputCallback& cb);
 
@@ -422,9 +428,11 @@ class BASE_EXPORT TraceLog : public MemoryDumpProvider {
   TraceEvent* GetEventByHandleInternal(TraceEventHandle handle,
                                        OptionalAutoLock* lock);
 
+  enum class FlushFormat { kJSON, kBinary };
   void FlushInternal(const OutputCallback& cb,
                      bool use_worker_thread,
-                     bool discard_events);
+                     bool discard_events,
+                     FlushFormat format = FlushFormat::kJSON);
 
   // |generation| is used in the following callbacks to check if the callback
   // is called for the flush of the current |logged_events_|.
@@ -434,6 +442,11 @@ class BASE_EXPORT TraceLog : public MemoryDumpProvider {
       std::unique_ptr<TraceBuffer> logged_events,
       const TraceLog::OutputCallback& flush_output_callback,
       const ArgumentFilterPredicate& argument_filter_predicate);
+  static void ConvertTraceEventsToBinaryFormat(
+      std::unique_ptr<TraceBuffer> logged_events,
+      int process_id,
+      const TraceLog::OutputCallback& flush_output_callback,
+      const ArgumentFilterPredicate& argument_filter_predicate);
   void FinishFlush(int generation, bool discard_events);
   void OnFlushTimeout(int generation, bool discard_events);
 
@@ -529,6 +542,7 @@ class BASE_EXPORT TraceLog : public MemoryDumpProvider {
   ArgumentFilterPredicate argument_filter_predicate_;
   subtle::AtomicWord generation_;
   bool use_worker_thread_;
+  FlushFormat flush_format_ = FlushFormat::kJSON;
   std::atomic<AddTraceEventOverrideCallback> add_trace_event_override_;
   std::atomic<OnFlushCallback> on_flush_callback_;
   std::atomic<UpdateDurationCallback> update_duration_callback_;
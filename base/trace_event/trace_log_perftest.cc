@@ -0,0 +1,93 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/trace_event/trace_log.h"
+
+#include <stddef.h>
+
+#include <memory>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/strings/stringprintf.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/threading/thread.h"
+#include "base/time/time.h"
+#include "base/trace_event/trace_config.h"
+#include "base/trace_event/trace_event.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+namespace trace_event {
+
+namespace {
+
+constexpr int kEventsPerThread = 100000;
+
+// Emits |kEventsPerThread| trace events once |start| is signaled and stores
+// the time it took in |*elapsed|.
+void EmitEvents(WaitableEvent* start, TimeDelta* elapsed) {
+  start->Wait();
+  TimeTicks begin = TimeTicks::Now();
+  for (int i = 0; i < kEventsPerThread; ++i)
+    TRACE_EVENT_INSTANT1("perf", "Event", TRACE_EVENT_SCOPE_THREAD, "i", i);
+  *elapsed = TimeTicks::Now() - begin;
+}
+
+// Measures the average cost of recording one trace event while |thread_count|
+// threads are recording concurrently. The threads have message loops, so the
+// events go through the thread-local event buffers.
+void RunAddTraceEventTest(size_t thread_count) {
+  // Record continuously so that the buffer never fills up and disables
+  // recording partway through.
+  TraceLog::GetInstance()->SetEnabled(
+      TraceConfig("perf", RECORD_CONTINUOUSLY), TraceLog::RECORDING_MODE);
+
+  std::vector<std::unique_ptr<Thread>> threads;
+  std::vector<TimeDelta> elapsed(thread_count);
+  WaitableEvent start;
+  for (size_t i = 0; i < thread_count; ++i) {
+    threads.push_back(
+        std::make_unique<Thread>(StringPrintf("TraceLogPerfTest%zu", i)));
+    ASSERT_TRUE(threads.back()->Start());
+    threads.back()->task_runner()->PostTask(
+        FROM_HERE, BindOnce(&EmitEvents, Unretained(&start),
+                            Unretained(&elapsed[i])));
+  }
+
+  start.Signal();
+  // Stopping the threads waits for their events and hands their thread-local
+  // chunks back to the TraceBuffer.
+  for (auto& thread : threads)
+    thread->Stop();
+
+  TraceLog::GetInstance()->SetDisabled();
+
+  TimeDelta total;
+  for (const TimeDelta& thread_elapsed : elapsed)
+    total += thread_elapsed;
+  perf_test::PrintResult(
+      "TraceLog_AddTraceEvent", "", StringPrintf("%zu_threads", thread_count),
+      total.InNanoseconds() /
+          static_cast<double>(kEventsPerThread * thread_count),
+      "ns/event", true);
+}
+
+}  // namespace
+
+TEST(TraceLogPerfTest, AddTraceEvent1Thread) {
+  RunAddTraceEventTest(1);
+}
+
+TEST(TraceLogPerfTest, AddTraceEvent8Threads) {
+  RunAddTraceEventTest(8);
+}
+
+TEST(TraceLogPerfTest, AddTraceEvent32Threads) {
+  RunAddTraceEventTest(32);
+}
+
+}  // namespace trace_event
+}  // namespace base
@@ -0,0 +1,88 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/values.h"
+
+#include <string>
+#include <utility>
+
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+
+namespace {
+
+// Builds a pref-like dictionary with |count| entries, each holding a small
+// dictionary of scalars and a short list, one key at a time.
+Value BuildPrefLikeDictionary(int count) {
+  Value root(Value::Type::DICTIONARY);
+  for (int i = 0; i < count; ++i) {
+    Value entry(Value::Type::DICTIONARY);
+    entry.SetKey("enabled", Value(i % 2 == 0));
+    entry.SetKey("count", Value(i));
+    entry.SetKey("ratio", Value(i / 3.0));
+    entry.SetKey("name", Value("entry_name_" + std::to_string(i)));
+    Value list(Value::Type::LIST);
+    for (int j = 0; j < 3; ++j)
+      list.GetList().emplace_back(j);
+    entry.SetKey("list", std::move(list));
+    root.SetKey("entry" + std::to_string(i), std::move(entry));
+  }
+  return root;
+}
+
+// Returns the number of Values in |value|, including itself.
+size_t CountValues(const Value& value) {
+  size_t count = 1;
+  if (value.is_dict()) {
+    for (const auto& item : value.DictItems())
+      count += CountValues(item.second);
+  } else if (value.is_list()) {
+    for (const Value& item : value.GetList())
+      count += CountValues(item);
+  }
+  return count;
+}
+
+void PrintMemoryUsage(const std::string& trace, const Value& value) {
+  const size_t num_values = CountValues(value);
+  perf_test::PrintResult("ValueMemoryUsage", "", trace,
+                         value.EstimateMemoryUsage(), "bytes", true);
+  perf_test::PrintResult(
+      "ValueMemoryUsagePerValue", "", trace,
+      static_cast<double>(value.EstimateMemoryUsage()) / num_values,
+      "bytes/value", true);
+}
+
+}  // namespace
+
+// Reports the fixed costs of the dictionary layout: every child is a
+// separately allocated Value owned by a (key, std::unique_ptr<Value>) entry.
+TEST(ValuesPerfTest, LayoutSizes) {
+  perf_test::PrintResult("sizeof", "", "Value", sizeof(Value), "bytes", true);
+  perf_test::PrintResult("sizeof", "", "DictStorage::value_type",
+                         sizeof(Value::DictStorage::value_type), "bytes",
+                         true);
+}
+
+// Compares the memory held by a dictionary built incrementally with the same
+// dictionary parsed from JSON, whose containers are allocated to fit.
+TEST(ValuesPerfTest, DictionaryMemoryUsage) {
+  for (int count : {100, 10000, 100000}) {
+    const Value built = BuildPrefLikeDictionary(count);
+    PrintMemoryUsage("built_" + std::to_string(count), built);
+
+    std::string json;
+    ASSERT_TRUE(JSONWriter::Write(built, &json));
+    Optional<Value> parsed = JSONReader::Read(json);
+    ASSERT_TRUE(parsed);
+    EXPECT_EQ(CountValues(built), CountValues(*parsed));
+    PrintMemoryUsage("parsed_" + std::to_string(count), *parsed);
+  }
+}
+
+}  // namespace base
@@ -118,6 +118,12 @@ class RTree {
                            const gfx::Rect& query,
                            std::vector<const T*>* results) const;
 
+  // Append every element under |root|, for subtrees that are entirely inside
+  // the query rect, without testing their bounds.
+  void AppendAllRecursive(Node<T>* root, std::vector<T>* results) const;
+  void AppendAllRefsRecursive(Node<T>* root,
+                              std::vector<const T*>* results) const;
+
   // Consumes the input array.
   Branch<T> BuildRecursive(std::vector<Branch<T>>* branches, int level);
   Node<T>* AllocateNodeAtLevel(int level);
@@ -310,6 +316,8 @@ void RTree<T>::SearchRecursive(Node<T>* node,
     if (query.Intersects(node->children[i].bounds)) {
       if (node->level == 0)
         results->push_back(node->children[i].payload);
+      else if (query.Contains(node->children[i].bounds))
+        AppendAllRecursive(node->children[i].subtree, results);
       else
         SearchRecursive(node->children[i].subtree, query, results);
     }
@@ -324,12 +332,36 @@ void RTree<T>::SearchRefsRecursive(Node<T>* node,
     if (query.Intersects(node->children[i].bounds)) {
       if (node->level == 0)
         results->push_back(&node->children[i].payload);
+      else if (query.Contains(node->children[i].bounds))
+        AppendAllRefsRecursive(node->children[i].subtree, results);
       else
         SearchRefsRecursive(node->children[i].subtree, query, results);
     }
   }
 }
 
+template <typename T>
+void RTree<T>::AppendAllRecursive(Node<T>* node,
+                                  std::vector<T>* results) const {
+  for (uint16_t i = 0; i < node->num_children; ++i) {
+    if (node->level == 0)
+      results->push_back(node->children[i].payload);
+    else
+      AppendAllRecursive(node->children[i].subtree, results);
+  }
+}
+
+template <typename T>
+void RTree<T>::AppendAllRefsRecursive(Node<T>* node,
+                                      std::vector<const T*>* results) const {
+  for (uint16_t i = 0; i < node->num_children; ++i) {
+    if (node->level == 0)
+      results->push_back(&node->children[i].payload);
+    else
+      AppendAllRefsRecursive(node->children[i].subtree, results);
+  }
+}
+
 template <typename T>
 gfx::Rect RTree<T>::GetBounds() const {
   return root_.bounds;
@@ -113,6 +113,40 @@ TEST(RTreeTest, SortedResults) {
   }
 }
 
+TEST(RTreeTest, LargeQueries) {
+  // Queries that contain whole subtrees have to find the same elements as a
+  // linear scan, in the same order.
+  std::vector<gfx::Rect> rects;
+  for (int y = 0; y < 40; ++y) {
+    for (int x = 0; x < 40; ++x)
+      rects.push_back(gfx::Rect(x * 10, y * 10, 5 + x % 7, 5 + y % 11));
+  }
+
+  RTree<size_t> rtree;
+  rtree.Build(rects);
+
+  const gfx::Rect queries[] = {gfx::Rect(0, 0, 400, 400),
+                               gfx::Rect(15, 25, 200, 100),
+                               gfx::Rect(100, 0, 256, 256),
+                               gfx::Rect(-50, 300, 1000, 50)};
+  for (const gfx::Rect& query : queries) {
+    std::vector<size_t> expected;
+    for (size_t i = 0; i < rects.size(); ++i) {
+      if (query.Intersects(rects[i]))
+        expected.push_back(i);
+    }
+    std::vector<size_t> results;
+    rtree.Search(query, &results);
+    EXPECT_EQ(expected, results);
+
+    std::vector<const size_t*> refs;
+    rtree.SearchRefs(query, &refs);
+    ASSERT_EQ(expected.size(), refs.size());
+    for (size_t i = 0; i < refs.size(); ++i)
+      EXPECT_EQ(expected[i], *refs[i]);
+  }
+}
+
 TEST(RTreeTest, GetBoundsEmpty) {
   RTree<size_t> rtree;
   EXPECT_EQ(gfx::Rect(), rtree.GetBounds());
@@ -327,7 +327,15 @@ void OneCopyRasterBufferProvider::PlaybackToStagingBuffer(
   if (staging_buffer->gpu_memory_buffer) {
     gfx::GpuMemoryBuffer* buffer = staging_buffer->gpu_memory_buffer.get();
     DCHECK_EQ(1u, gfx::NumberOfPlanesForBufferFormat(buffer->GetFormat()));
-    bool rv = buffer->Map();
+    // Buffers with persistent CPU access stay mapped for the lifetime of the
+    // staging buffer, which saves a map and unmap for every raster into it.
+    bool rv = true;
+    if (!staging_buffer->is_persistently_mapped) {
+      rv = buffer->Map();
+      staging_buffer->is_persistently_mapped =
+          rv && StagingBufferUsage() ==
+                    gfx::BufferUsage::GPU_READ_CPU_READ_WRITE_PERSISTENT;
+    }
     DCHECK(rv);
     DCHECK(buffer->memory(0));
     // RasterBufferProvider::PlaybackToMemory only supports unsigned strides.
@@ -350,7 +358,8 @@ void OneCopyRasterBufferProvider::PlaybackToStagingBuffer(
         buffer->memory(0), format, staging_buffer->size, buffer->stride(0),
         raster_source, raster_full_rect, playback_rect, transform,
         dst_color_space, /*gpu_compositing=*/true, playback_settings);
-    buffer->Unmap();
+    if (!staging_buffer->is_persistently_mapped)
+      buffer->Unmap();
     staging_buffer->content_id = new_content_id;
   }
 }
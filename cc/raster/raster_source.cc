@@ -24,6 +24,9 @@
 namespace cc {
 namespace {
 
+// The number of solid color analysis results that are kept.
+const size_t kMaxSolidColorAnalysisResults = 256;
+
 // These enum values are persisted to logs and must never by renumbered or
 // reused.
 enum class RasterSourceClearType {
@@ -207,7 +210,32 @@ bool RasterSource::PerformSolidColorAnalysis(gfx::Rect layer_rect,
 
   layer_rect.Intersect(gfx::Rect(size_));
   layer_rect = gfx::ScaleToRoundedRect(layer_rect, recording_scale_factor_);
-  return display_list_->GetColorIfSolidInRect(layer_rect, color);
+
+  base::AutoLock lock(solid_color_analysis_lock_);
+  auto it = solid_color_analysis_results_.find(layer_rect);
+  if (it == solid_color_analysis_results_.end()) {
+    // A rect inside one that was found to be solid has the same color, which
+    // is common for the tiles of a tiling at a higher scale than another.
+    base::Optional<SkColor> result;
+    for (const auto& entry : solid_color_analysis_results_) {
+      if (entry.second && entry.first.Contains(layer_rect)) {
+        result = entry.second;
+        break;
+      }
+    }
+    SkColor solid_color = SK_ColorTRANSPARENT;
+    if (!result &&
+        display_list_->GetColorIfSolidInRect(layer_rect, &solid_color)) {
+      result = solid_color;
+    }
+    if (solid_color_analysis_results_.size() == kMaxSolidColorAnalysisResults)
+      solid_color_analysis_results_.clear();
+    it = solid_color_analysis_results_.emplace(layer_rect, result).first;
+  }
+  if (!it->second)
+    return false;
+  *color = *it->second;
+  return true;
 }
 
 void RasterSource::GetDiscardableImagesInRect(
@@ -7,10 +7,13 @@
 
 #include <stddef.h>
 
+#include <map>
 #include <memory>
 #include <vector>
 
 #include "base/macros.h"
+#include "base/optional.h"
+#include "base/synchronization/lock.h"
 #include "cc/cc_export.h"
 #include "cc/debug/rendering_stats_instrumentation.h"
 #include "cc/layers/recording_source.h"
@@ -149,6 +152,13 @@ class CC_EXPORT RasterSource : public base::RefCountedThreadSafe<RasterSource> {
   const int slow_down_raster_scale_factor_for_debug_;
   const float recording_scale_factor_;
 
+  // The results of PerformSolidColorAnalysis for the rects it was given, as
+  // tiles covering the same rect are analyzed again when their tilings are
+  // recreated, and tiles inside a solid rect share its color.
+  mutable base::Lock solid_color_analysis_lock_;
+  mutable std::map<gfx::Rect, base::Optional<SkColor>>
+      solid_color_analysis_results_;
+
   DISALLOW_COPY_AND_ASSIGN(RasterSource);
 };
 
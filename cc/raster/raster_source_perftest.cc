@@ -0,0 +1,107 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/raster/raster_source.h"
+
+#include <memory>
+
+#include "cc/base/lap_timer.h"
+#include "cc/paint/paint_flags.h"
+#include "cc/test/fake_recording_source.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "ui/gfx/geometry/axis_transform2d.h"
+#include "ui/gfx/geometry/rect.h"
+
+namespace cc {
+namespace {
+
+static const int kTimeLimitMillis = 2000;
+static const int kWarmupRuns = 5;
+static const int kTimeCheckInterval = 1;
+
+// A large layer with many small items, rastered in tiles of the usual size.
+static const int kLayerSize = 4096;
+static const int kTileSize = 256;
+static const int kItemSpacing = 32;
+
+class RasterSourcePerfTest : public testing::Test {
+ public:
+  RasterSourcePerfTest()
+      : timer_(kWarmupRuns,
+               base::TimeDelta::FromMilliseconds(kTimeLimitMillis),
+               kTimeCheckInterval) {
+    gfx::Size layer_bounds(kLayerSize, kLayerSize);
+    std::unique_ptr<FakeRecordingSource> recording_source =
+        FakeRecordingSource::CreateFilledRecordingSource(layer_bounds);
+    PaintFlags flags;
+    for (int y = 0; y < kLayerSize; y += kItemSpacing) {
+      for (int x = 0; x < kLayerSize; x += kItemSpacing) {
+        flags.setColor(SkColorSetARGB(255, x % 256, y % 256, 0));
+        recording_source->add_draw_rect_with_flags(
+            gfx::Rect(x, y, kItemSpacing / 2, kItemSpacing / 2), flags);
+      }
+    }
+    recording_source->Rerecord();
+    raster_source_ = recording_source->CreateRasterSource();
+  }
+
+ protected:
+  LapTimer timer_;
+  scoped_refptr<RasterSource> raster_source_;
+};
+
+// Rasters one tile at a time, going over the whole layer.
+TEST_F(RasterSourcePerfTest, RasterTiles) {
+  SkBitmap bitmap;
+  bitmap.allocPixels(SkImageInfo::MakeN32Premul(kTileSize, kTileSize));
+  RasterSource::PlaybackSettings settings;
+  gfx::Size content_size = raster_source_->GetContentSize(1.f);
+  int tile_index = 0;
+  const int tiles_per_row = kLayerSize / kTileSize;
+
+  timer_.Reset();
+  do {
+    gfx::Rect tile_rect((tile_index % tiles_per_row) * kTileSize,
+                        (tile_index / tiles_per_row % tiles_per_row) *
+                            kTileSize,
+                        kTileSize, kTileSize);
+    SkCanvas canvas(bitmap);
+    raster_source_->PlaybackToCanvas(
+        &canvas, gfx::ColorSpace(), content_size, tile_rect, tile_rect,
+        gfx::AxisTransform2d(), settings);
+    ++tile_index;
+    timer_.NextLap();
+  } while (!timer_.HasTimeLimitExpired());
+
+  perf_test::PrintResult("raster_source_raster_tile", "", "256x256",
+                         timer_.LapsPerSecond(), "runs/s", true);
+}
+
+// Analyzes tiles for solid color, as the TileManager does before it rasters
+// them.
+TEST_F(RasterSourcePerfTest, AnalyzeTiles) {
+  int tile_index = 0;
+  const int tiles_per_row = kLayerSize / kTileSize;
+
+  timer_.Reset();
+  do {
+    gfx::Rect tile_rect((tile_index % tiles_per_row) * kTileSize,
+                        (tile_index / tiles_per_row % tiles_per_row) *
+                            kTileSize,
+                        kTileSize, kTileSize);
+    SkColor color;
+    raster_source_->PerformSolidColorAnalysis(tile_rect, &color);
+    ++tile_index;
+    timer_.NextLap();
+  } while (!timer_.HasTimeLimitExpired());
+
+  perf_test::PrintResult("raster_source_analyze_tile", "", "256x256",
+                         timer_.LapsPerSecond(), "runs/s", true);
+}
+
+}  // namespace
+}  // namespace cc
@@ -103,6 +103,80 @@ TEST(RasterSourceTest, AnalyzeIsSolidUnscaled) {
   EXPECT_EQ(solid_color, color);
 }
 
+TEST(RasterSourceTest, AnalyzeSameRectAgain) {
+  gfx::Size layer_bounds(400, 400);
+
+  std::unique_ptr<FakeRecordingSource> recording_source =
+      FakeRecordingSource::CreateFilledRecordingSource(layer_bounds);
+
+  PaintFlags solid_flags;
+  SkColor solid_color = SkColorSetARGB(255, 12, 23, 34);
+  solid_flags.setColor(solid_color);
+  PaintFlags non_solid_flags;
+  non_solid_flags.setColor(SkColorSetARGB(128, 45, 56, 67));
+
+  recording_source->add_draw_rect_with_flags(gfx::Rect(layer_bounds),
+                                             solid_flags);
+  recording_source->add_draw_rect_with_flags(gfx::Rect(50, 50, 1, 1),
+                                             non_solid_flags);
+  recording_source->Rerecord();
+  scoped_refptr<RasterSource> raster = recording_source->CreateRasterSource();
+
+  // The results that are kept for a rect have to be the ones it got the first
+  // time.
+  for (int i = 0; i < 2; ++i) {
+    SkColor color = SK_ColorTRANSPARENT;
+    EXPECT_FALSE(
+        raster->PerformSolidColorAnalysis(gfx::Rect(0, 0, 100, 100), &color));
+    EXPECT_EQ(SK_ColorTRANSPARENT, color);
+
+    EXPECT_TRUE(
+        raster->PerformSolidColorAnalysis(gfx::Rect(100, 0, 100, 100), &color));
+    EXPECT_EQ(solid_color, color);
+  }
+}
+
+TEST(RasterSourceTest, AnalyzeRectInsideSolidRect) {
+  gfx::Size layer_bounds(400, 400);
+
+  std::unique_ptr<FakeRecordingSource> recording_source =
+      FakeRecordingSource::CreateFilledRecordingSource(layer_bounds);
+
+  PaintFlags solid_flags;
+  SkColor solid_color = SkColorSetARGB(255, 12, 23, 34);
+  solid_flags.setColor(solid_color);
+  PaintFlags non_solid_flags;
+  non_solid_flags.setColor(SkColorSetARGB(128, 45, 56, 67));
+
+  recording_source->add_draw_rect_with_flags(gfx::Rect(layer_bounds),
+                                             solid_flags);
+  recording_source->add_draw_rect_with_flags(gfx::Rect(250, 250, 1, 1),
+                                             non_solid_flags);
+  recording_source->Rerecord();
+  scoped_refptr<RasterSource> raster = recording_source->CreateRasterSource();
+
+  // A large tile of a low resolution tiling.
+  SkColor color = SK_ColorTRANSPARENT;
+  EXPECT_TRUE(
+      raster->PerformSolidColorAnalysis(gfx::Rect(0, 0, 200, 200), &color));
+  EXPECT_EQ(solid_color, color);
+
+  // Smaller tiles inside it have the same color.
+  color = SK_ColorTRANSPARENT;
+  EXPECT_TRUE(
+      raster->PerformSolidColorAnalysis(gfx::Rect(100, 100, 100, 100), &color));
+  EXPECT_EQ(solid_color, color);
+
+  // Tiles that aren't inside it are still analyzed.
+  color = SK_ColorTRANSPARENT;
+  EXPECT_FALSE(
+      raster->PerformSolidColorAnalysis(gfx::Rect(150, 150, 200, 200), &color));
+  EXPECT_EQ(SK_ColorTRANSPARENT, color);
+  EXPECT_TRUE(
+      raster->PerformSolidColorAnalysis(gfx::Rect(300, 0, 100, 100), &color));
+  EXPECT_EQ(solid_color, color);
+}
+
 TEST(RasterSourceTest, AnalyzeIsSolidScaled) {
   gfx::Size layer_bounds(400, 400);
   const std::vector<float> recording_scales = {1.25f, 1.33f, 1.5f,  1.6f,
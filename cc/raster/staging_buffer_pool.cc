@@ -73,6 +73,8 @@ StagingBuffer::StagingBuffer(const gfx::Size& size, viz::ResourceFormat format)
 StagingBuffer::~StagingBuffer() {
   DCHECK(mailbox.IsZero());
   DCHECK_EQ(query_id, 0u);
+  if (is_persistently_mapped)
+    gpu_memory_buffer->Unmap();
 }
 
 void StagingBuffer::DestroyGLResources(gpu::raster::RasterInterface* ri,
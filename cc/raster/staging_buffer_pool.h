@@ -62,6 +62,10 @@ struct StagingBuffer {
   // GpuMemoryBuffer.
   std::unique_ptr<gfx::GpuMemoryBuffer> gpu_memory_buffer;
 
+  // True if |gpu_memory_buffer| is kept mapped between rasters, which is done
+  // for buffers with persistent CPU access, and unmapped on destruction.
+  bool is_persistently_mapped = false;
+
   // Mailbox for the shared image bound to the GpuMemoryBuffer.
   gpu::Mailbox mailbox;
 
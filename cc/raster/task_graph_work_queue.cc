@@ -11,6 +11,7 @@
 #include <map>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "base/stl_util.h"
 #include "base/trace_event/trace_event.h"
@@ -45,60 +46,25 @@ class CompareTaskNamespacePriority {
   uint16_t category_;
 };
 
-// Helper class for iterating over all dependents of a task.
-class DependentIterator {
- public:
-  DependentIterator(TaskGraph* graph, const Task* task)
-      : graph_(graph),
-        task_(task),
-        current_index_(static_cast<size_t>(-1)),
-        current_node_(nullptr) {
-    ++(*this);
-  }
-
-  TaskGraph::Node& operator->() const {
-    DCHECK_LT(current_index_, graph_->edges.size());
-    DCHECK_EQ(graph_->edges[current_index_].task, task_);
-    DCHECK(current_node_);
-    return *current_node_;
-  }
-
-  TaskGraph::Node& operator*() const {
-    DCHECK_LT(current_index_, graph_->edges.size());
-    DCHECK_EQ(graph_->edges[current_index_].task, task_);
-    DCHECK(current_node_);
-    return *current_node_;
-  }
-
-  // Note: Performance can be improved by keeping edges sorted.
-  DependentIterator& operator++() {
-    // Find next dependency edge for |task_|.
-    do {
-      ++current_index_;
-      if (current_index_ == graph_->edges.size())
-        return *this;
-    } while (graph_->edges[current_index_].task != task_);
-
-    // Now find the node for the dependent of this edge.
-    auto it = std::find_if(graph_->nodes.begin(), graph_->nodes.end(),
-                           [this](const TaskGraph::Node& node) {
-                             return node.task ==
-                                    graph_->edges[current_index_].dependent;
-                           });
-    DCHECK(it != graph_->nodes.end());
-    current_node_ = &(*it);
-
-    return *this;
+// Returns the indices in |graph->nodes| of the dependents of each task of
+// |graph|, so that they can be found without going through all the edges and
+// nodes for each completed task.
+std::unordered_map<const Task*, std::vector<size_t>> GetDependentIndices(
+    const TaskGraph* graph) {
+  std::unordered_map<const Task*, size_t> node_indices;
+  node_indices.reserve(graph->nodes.size());
+  for (size_t i = 0; i < graph->nodes.size(); ++i)
+    node_indices[graph->nodes[i].task.get()] = i;
+
+  std::unordered_map<const Task*, std::vector<size_t>> dependent_indices;
+  for (const TaskGraph::Edge& edge : graph->edges) {
+    auto it = node_indices.find(edge.dependent);
+    DCHECK(it != node_indices.end());
+    if (it != node_indices.end())
+      dependent_indices[edge.task].push_back(it->second);
   }
-
-  operator bool() const { return current_index_ < graph_->edges.size(); }
-
- private:
-  TaskGraph* graph_;
-  const Task* task_;
-  size_t current_index_;
-  TaskGraph::Node* current_node_;
-};
+  return dependent_indices;
+}
 
 }  // namespace
 
@@ -134,11 +100,16 @@ NamespaceToken TaskGraphWorkQueue::GenerateNamespaceToken() {
 
 void TaskGraphWorkQueue::ScheduleTasks(NamespaceToken token, TaskGraph* graph) {
   TaskNamespace& task_namespace = namespaces_[token];
+  std::unordered_map<const Task*, std::vector<size_t>> dependent_indices =
+      GetDependentIndices(graph);
 
   // First adjust number of dependencies to reflect completed tasks.
   for (const scoped_refptr<Task>& task : task_namespace.completed_tasks) {
-    for (DependentIterator node_it(graph, task.get()); node_it; ++node_it) {
-      TaskGraph::Node& node = *node_it;
+    auto dependents_it = dependent_indices.find(task.get());
+    if (dependents_it == dependent_indices.end())
+      continue;
+    for (size_t index : dependents_it->second) {
+      TaskGraph::Node& node = graph->nodes[index];
       DCHECK_LT(0u, node.dependencies);
       node.dependencies--;
     }
@@ -198,6 +169,7 @@ void TaskGraphWorkQueue::ScheduleTasks(NamespaceToken token, TaskGraph* graph) {
 
   // Swap task graph.
   task_namespace.graph.Swap(graph);
+  task_namespace.dependent_indices.swap(dependent_indices);
 
   // Determine what tasks in old graph need to be canceled.
   for (auto it = graph->nodes.begin(); it != graph->nodes.end(); ++it) {
@@ -301,8 +273,14 @@ void TaskGraphWorkQueue::CompleteTask(PrioritizedTask completed_task) {
   // Now iterate over all dependents to decrement dependencies and check if they
   // are ready to run.
   bool ready_to_run_namespaces_has_heap_properties = true;
-  for (DependentIterator it(&task_namespace->graph, task.get()); it; ++it) {
-    TaskGraph::Node& dependent_node = *it;
+  auto dependents_it = task_namespace->dependent_indices.find(task.get());
+  const std::vector<size_t> no_dependents;
+  const std::vector<size_t>& dependents =
+      dependents_it == task_namespace->dependent_indices.end()
+          ? no_dependents
+          : dependents_it->second;
+  for (size_t index : dependents) {
+    TaskGraph::Node& dependent_node = task_namespace->graph.nodes[index];
 
     DCHECK_LT(0u, dependent_node.dependencies);
     dependent_node.dependencies--;
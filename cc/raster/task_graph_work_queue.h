@@ -9,6 +9,7 @@
 
 #include <algorithm>
 #include <map>
+#include <unordered_map>
 #include <vector>
 
 #include "cc/cc_export.h"
@@ -62,6 +63,10 @@ class CC_EXPORT TaskGraphWorkQueue {
     // Current task graph.
     TaskGraph graph;
 
+    // The indices in |graph.nodes| of the dependents of each task of |graph|
+    // that has any, in the order of |graph.edges|.
+    std::unordered_map<const Task*, std::vector<size_t>> dependent_indices;
+
     // Map from category to a vector of tasks that are ready to run for that
     // category.
     std::map<uint16_t, PrioritizedTask::Vector> ready_to_run_tasks;
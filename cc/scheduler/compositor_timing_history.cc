@@ -463,6 +463,28 @@ void CompositorTimingHistory::AsValueInto(
                    ActivateDurationEstimate().InMillisecondsF());
   state->SetDouble("draw_estimate_ms",
                    DrawDurationEstimate().InMillisecondsF());
+
+  if (frame_timings_.CurrentIndex() == 0)
+    return;
+  const FrameTiming& last_frame =
+      frame_timings_.ReadBuffer(frame_timings_.BufferSize() - 1);
+  state->BeginDictionary("last_frame_timing");
+  state->SetDouble(
+      "begin_main_frame_queue_ms",
+      last_frame.begin_main_frame_queue_duration.InMillisecondsF());
+  state->SetDouble(
+      "begin_main_frame_start_to_commit_ms",
+      last_frame.begin_main_frame_start_to_commit_duration.InMillisecondsF());
+  state->SetDouble("commit_ms", last_frame.commit_duration.InMillisecondsF());
+  state->SetDouble(
+      "commit_to_ready_to_activate_ms",
+      last_frame.commit_to_ready_to_activate_duration.InMillisecondsF());
+  state->SetDouble("activate_ms",
+                   last_frame.activate_duration.InMillisecondsF());
+  state->SetDouble("draw_ms", last_frame.draw_duration.InMillisecondsF());
+  state->SetDouble("submit_to_ack_ms",
+                   last_frame.submit_to_ack_duration.InMillisecondsF());
+  state->EndDictionary();
 }
 
 base::TimeTicks CompositorTimingHistory::Now() const {
@@ -648,6 +670,9 @@ void CompositorTimingHistory::DidCommit() {
   DidBeginMainFrame(begin_main_frame_end_time);
   commit_duration_history_.InsertSample(begin_main_frame_end_time -
                                         commit_start_time_);
+  pending_tree_frame_timing_ = main_frame_timing_;
+  pending_tree_frame_timing_.commit_duration =
+      begin_main_frame_end_time - commit_start_time_;
 
   pending_tree_is_impl_side_ = false;
   pending_tree_creation_time_ = begin_main_frame_end_time;
@@ -689,6 +714,11 @@ void CompositorTimingHistory::DidBeginMainFrame(
 
   uma_reporter_->AddBeginMainFrameStartToCommitDuration(
       begin_main_frame_start_to_commit_duration);
+  main_frame_timing_ = FrameTiming();
+  main_frame_timing_.begin_main_frame_queue_duration =
+      begin_main_frame_queue_duration;
+  main_frame_timing_.begin_main_frame_start_to_commit_duration =
+      begin_main_frame_start_to_commit_duration;
 
   if (enabled_) {
     begin_main_frame_queue_duration_history_.InsertSample(
@@ -724,6 +754,7 @@ void CompositorTimingHistory::WillInvalidateOnImplSide() {
 
   pending_tree_is_impl_side_ = true;
   pending_tree_creation_time_ = base::TimeTicks::Now();
+  pending_tree_frame_timing_ = FrameTiming();
 }
 
 void CompositorTimingHistory::WillPrepareTiles() {
@@ -766,6 +797,8 @@ void CompositorTimingHistory::ReadyToActivate() {
                                                       tree_priority_);
     rendering_stats_instrumentation_->AddCommitToActivateDuration(
         time_since_commit, commit_to_ready_to_activate_estimate);
+    pending_tree_frame_timing_.commit_to_ready_to_activate_duration =
+        time_since_commit;
 
     if (enabled_) {
       commit_to_ready_to_activate_duration_history_.InsertSample(
@@ -806,6 +839,9 @@ void CompositorTimingHistory::DidActivate() {
   if (!using_synchronous_renderer_compositor_)
     DCHECK_EQ(base::TimeTicks(), active_tree_main_frame_time_);
   active_tree_main_frame_time_ = pending_tree_main_frame_time_;
+  active_tree_frame_timing_ = pending_tree_frame_timing_;
+  active_tree_frame_timing_.activate_duration = activate_duration;
+  pending_tree_frame_timing_ = FrameTiming();
 
   activate_start_time_ = base::TimeTicks();
   pending_tree_main_frame_time_ = base::TimeTicks();
@@ -844,6 +880,15 @@ void CompositorTimingHistory::DidDraw(
     draw_duration_history_.InsertSample(draw_duration);
   }
 
+  FrameTiming frame_timing;
+  if (used_new_active_tree) {
+    frame_timing = active_tree_frame_timing_;
+    active_tree_frame_timing_ = FrameTiming();
+  }
+  frame_timing.frame_time = impl_frame_time;
+  frame_timing.draw_duration = draw_duration;
+  frame_timings_.SaveToBuffer(frame_timing);
+
   SetCompositorDrawingContinuously(true);
   if (!draw_end_time_prev_.is_null()) {
     base::TimeDelta draw_interval = draw_end_time - draw_end_time_prev_;
@@ -915,6 +960,10 @@ void CompositorTimingHistory::DidReceiveCompositorFrameAck() {
   DCHECK_NE(base::TimeTicks(), submit_start_time_);
   base::TimeDelta submit_to_ack_duration = Now() - submit_start_time_;
   uma_reporter_->AddSubmitToAckLatency(submit_to_ack_duration);
+  if (frame_timings_.CurrentIndex() > 0) {
+    frame_timings_.MutableReadBuffer(frame_timings_.BufferSize() - 1)
+        ->submit_to_ack_duration = submit_to_ack_duration;
+  }
   if (submit_ack_watchdog_enabled_)
     submit_ack_watchdog_enabled_ = false;
   submit_start_time_ = base::TimeTicks();
@@ -936,6 +985,7 @@ void CompositorTimingHistory::ClearHistory() {
   prepare_tiles_duration_history_.Clear();
   activate_duration_history_.Clear();
   draw_duration_history_.Clear();
+  frame_timings_.Clear();
 }
 
 }  // namespace cc
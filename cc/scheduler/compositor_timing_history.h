@@ -7,7 +7,9 @@
 
 #include <memory>
 
+#include "base/containers/ring_buffer.h"
 #include "base/macros.h"
+#include "base/time/time.h"
 #include "cc/base/rolling_time_delta_history.h"
 #include "cc/cc_export.h"
 #include "cc/tiles/tile_priority.h"
@@ -32,6 +34,21 @@ class CC_EXPORT CompositorTimingHistory {
   };
   class UMAReporter;
 
+  // The time spent in each stage of the pipeline for a drawn frame. The main
+  // thread stages are only set for frames that drew a new active tree that
+  // came from a commit.
+  struct FrameTiming {
+    base::TimeTicks frame_time;
+    base::TimeDelta begin_main_frame_queue_duration;
+    base::TimeDelta begin_main_frame_start_to_commit_duration;
+    base::TimeDelta commit_duration;
+    base::TimeDelta commit_to_ready_to_activate_duration;
+    base::TimeDelta activate_duration;
+    base::TimeDelta draw_duration;
+    base::TimeDelta submit_to_ack_duration;
+  };
+  typedef base::RingBuffer<FrameTiming, 60> FrameTimingRingBuffer;
+
   CompositorTimingHistory(
       bool using_synchronous_renderer_compositor,
       UMACategory uma_category,
@@ -102,6 +119,9 @@ class CC_EXPORT CompositorTimingHistory {
     return commit_to_ready_to_activate_duration_history_.sample_count();
   }
 
+  // The timings of the most recently drawn frames.
+  const FrameTimingRingBuffer& frame_timings() const { return frame_timings_; }
+
  protected:
   void DidBeginMainFrame(base::TimeTicks begin_main_frame_end_time);
 
@@ -137,6 +157,13 @@ class CC_EXPORT CompositorTimingHistory {
   RollingTimeDeltaHistory prepare_tiles_duration_history_;
   RollingTimeDeltaHistory activate_duration_history_;
   RollingTimeDeltaHistory draw_duration_history_;
+  FrameTimingRingBuffer frame_timings_;
+
+  // The stages of the frames that the last BeginMainFrame, the pending tree
+  // and the active tree are part of, until the frame is drawn.
+  FrameTiming main_frame_timing_;
+  FrameTiming pending_tree_frame_timing_;
+  FrameTiming active_tree_frame_timing_;
 
   bool begin_main_frame_on_critical_path_;
   base::TimeTicks begin_main_frame_frame_time_;
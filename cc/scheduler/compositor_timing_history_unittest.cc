@@ -190,6 +190,79 @@ TEST_F(CompositorTimingHistoryTest, AllSequential_BeginMainFrameAborted) {
   EXPECT_EQ(draw_duration, timing_history_.DrawDurationEstimate());
 }
 
+TEST_F(CompositorTimingHistoryTest, FrameTimings) {
+  base::TimeDelta one_second = base::TimeDelta::FromSeconds(1);
+  base::TimeDelta begin_main_frame_queue_duration =
+      base::TimeDelta::FromMilliseconds(1);
+  base::TimeDelta begin_main_frame_start_to_ready_to_commit_duration =
+      base::TimeDelta::FromMilliseconds(2);
+  base::TimeDelta commit_duration = base::TimeDelta::FromMilliseconds(3);
+  base::TimeDelta commit_to_ready_to_activate_duration =
+      base::TimeDelta::FromMilliseconds(4);
+  base::TimeDelta activate_duration = base::TimeDelta::FromMilliseconds(5);
+  base::TimeDelta draw_duration = base::TimeDelta::FromMilliseconds(6);
+  base::TimeDelta submit_to_ack_duration = base::TimeDelta::FromMilliseconds(7);
+
+  EXPECT_EQ(0u, timing_history_.frame_timings().CurrentIndex());
+
+  timing_history_.WillBeginMainFrame(true, Now());
+  AdvanceNowBy(begin_main_frame_queue_duration);
+  timing_history_.BeginMainFrameStarted(Now());
+  AdvanceNowBy(begin_main_frame_start_to_ready_to_commit_duration);
+  timing_history_.NotifyReadyToCommit();
+  timing_history_.WillCommit();
+  AdvanceNowBy(commit_duration);
+  timing_history_.DidCommit();
+  AdvanceNowBy(commit_to_ready_to_activate_duration);
+  timing_history_.ReadyToActivate();
+  AdvanceNowBy(one_second);
+  timing_history_.WillActivate();
+  AdvanceNowBy(activate_duration);
+  timing_history_.DidActivate();
+  AdvanceNowBy(one_second);
+  base::TimeTicks frame_time = Now();
+  timing_history_.WillDraw();
+  AdvanceNowBy(draw_duration);
+  timing_history_.DidDraw(true, frame_time, 0, 0, false, false);
+  timing_history_.DidSubmitCompositorFrame();
+  AdvanceNowBy(submit_to_ack_duration);
+  timing_history_.DidReceiveCompositorFrameAck();
+
+  // All the stages of the frame are recorded.
+  const CompositorTimingHistory::FrameTimingRingBuffer& frame_timings =
+      timing_history_.frame_timings();
+  ASSERT_EQ(1u, frame_timings.CurrentIndex());
+  const CompositorTimingHistory::FrameTiming& main_frame =
+      frame_timings.ReadBuffer(frame_timings.BufferSize() - 1);
+  EXPECT_EQ(frame_time, main_frame.frame_time);
+  EXPECT_EQ(begin_main_frame_queue_duration,
+            main_frame.begin_main_frame_queue_duration);
+  EXPECT_EQ(begin_main_frame_start_to_ready_to_commit_duration +
+                commit_duration,
+            main_frame.begin_main_frame_start_to_commit_duration);
+  EXPECT_EQ(commit_duration, main_frame.commit_duration);
+  EXPECT_EQ(commit_to_ready_to_activate_duration,
+            main_frame.commit_to_ready_to_activate_duration);
+  EXPECT_EQ(activate_duration, main_frame.activate_duration);
+  EXPECT_EQ(draw_duration, main_frame.draw_duration);
+  EXPECT_EQ(submit_to_ack_duration, main_frame.submit_to_ack_duration);
+
+  // A frame that draws the same active tree only has a draw duration.
+  timing_history_.WillDraw();
+  AdvanceNowBy(draw_duration);
+  timing_history_.DidDraw(false, Now(), 0, 0, false, false);
+  ASSERT_EQ(2u, frame_timings.CurrentIndex());
+  const CompositorTimingHistory::FrameTiming& impl_frame =
+      frame_timings.ReadBuffer(frame_timings.BufferSize() - 1);
+  EXPECT_EQ(base::TimeDelta(), impl_frame.begin_main_frame_queue_duration);
+  EXPECT_EQ(base::TimeDelta(), impl_frame.commit_duration);
+  EXPECT_EQ(base::TimeDelta(), impl_frame.activate_duration);
+  EXPECT_EQ(draw_duration, impl_frame.draw_duration);
+
+  timing_history_.ClearHistory();
+  EXPECT_EQ(0u, frame_timings.CurrentIndex());
+}
+
 TEST_F(CompositorTimingHistoryTest, BeginMainFrame_CriticalFaster) {
   // Critical BeginMainFrames are faster than non critical ones.
   base::TimeDelta begin_main_frame_queue_duration_critical =
@@ -177,6 +177,21 @@ void ImageController::ConvertDataImagesToTasks(
     std::vector<scoped_refptr<TileTask>>* tasks,
     bool* has_at_raster_images,
     const ImageDecodeCache::TracingInfo& tracing_info) {
+  if (!unused_predecoded_image_ids_.empty()) {
+    for (const DrawImage& image : *sync_decoded_images) {
+      if (unused_predecoded_image_ids_.erase(image.paint_image().stable_id()))
+        ++predecode_hit_count_;
+    }
+  }
+  GetTasksForDataImages(sync_decoded_images, tasks, has_at_raster_images,
+                        tracing_info);
+}
+
+void ImageController::GetTasksForDataImages(
+    std::vector<DrawImage>* sync_decoded_images,
+    std::vector<scoped_refptr<TileTask>>* tasks,
+    bool* has_at_raster_images,
+    const ImageDecodeCache::TracingInfo& tracing_info) {
   DCHECK(cache_);
   *has_at_raster_images = false;
   for (auto it = sync_decoded_images->begin();
@@ -212,10 +227,31 @@ std::vector<scoped_refptr<TileTask>> ImageController::SetPredecodeImages(
     const ImageDecodeCache::TracingInfo& tracing_info) {
   std::vector<scoped_refptr<TileTask>> new_tasks;
   bool has_at_raster_images = false;
-  ConvertDataImagesToTasks(&images, &new_tasks, &has_at_raster_images,
-                           tracing_info);
+  GetTasksForDataImages(&images, &new_tasks, &has_at_raster_images,
+                        tracing_info);
   UnrefImages(predecode_locked_images_);
   predecode_locked_images_ = std::move(images);
+
+  // Images that are no longer predecoded without having been needed were
+  // mispredicted. Images that stay predecoded after being needed aren't
+  // counted again.
+  std::vector<PaintImage::Id> ids;
+  std::vector<PaintImage::Id> unused_ids;
+  for (const DrawImage& image : predecode_locked_images_) {
+    PaintImage::Id id = image.paint_image().stable_id();
+    ids.push_back(id);
+    if (!predecoded_image_ids_.count(id) ||
+        unused_predecoded_image_ids_.count(id)) {
+      unused_ids.push_back(id);
+    }
+  }
+  base::flat_set<PaintImage::Id> new_unused_ids(std::move(unused_ids));
+  for (PaintImage::Id id : unused_predecoded_image_ids_) {
+    if (!new_unused_ids.count(id))
+      ++predecode_miss_count_;
+  }
+  predecoded_image_ids_ = base::flat_set<PaintImage::Id>(std::move(ids));
+  unused_predecoded_image_ids_ = std::move(new_unused_ids);
   return new_tasks;
 }
 
@@ -10,6 +10,7 @@
 
 #include "base/callback.h"
 #include "base/containers/flat_map.h"
+#include "base/containers/flat_set.h"
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
@@ -69,6 +70,12 @@ class CC_EXPORT ImageController {
       std::vector<DrawImage> predecode_images,
       const ImageDecodeCache::TracingInfo& tracing_info);
 
+  // The number of images predecoded by SetPredecodeImages that a tile then
+  // needed for raster, and the number that stopped being predecoded before any
+  // tile needed them.
+  size_t predecode_hit_count() const { return predecode_hit_count_; }
+  size_t predecode_miss_count() const { return predecode_miss_count_; }
+
   // Virtual for testing.
   virtual void UnlockImageDecode(ImageDecodeRequestId id);
 
@@ -117,6 +124,13 @@ class CC_EXPORT ImageController {
 
   void StopWorkerTasks();
 
+  // Does the work of ConvertDataImagesToTasks, without counting predecode hits.
+  void GetTasksForDataImages(
+      std::vector<DrawImage>* sync_decoded_images,
+      std::vector<scoped_refptr<TileTask>>* tasks,
+      bool* has_at_raster_images,
+      const ImageDecodeCache::TracingInfo& tracing_info);
+
   // Called from the worker thread.
   void ProcessNextImageDecodeOnWorkerThread();
 
@@ -129,6 +143,13 @@ class CC_EXPORT ImageController {
   PaintWorkletImageCache paint_worklet_image_cache_;
   std::vector<DrawImage> predecode_locked_images_;
 
+  // The images of |predecode_locked_images_|, and those that no tile has
+  // needed yet.
+  base::flat_set<PaintImage::Id> predecoded_image_ids_;
+  base::flat_set<PaintImage::Id> unused_predecoded_image_ids_;
+  size_t predecode_hit_count_ = 0u;
+  size_t predecode_miss_count_ = 0u;
+
   static ImageDecodeRequestId s_next_image_decode_queue_id_;
   base::flat_map<ImageDecodeRequestId, DrawImage> requested_locked_images_;
 
@@ -351,6 +351,36 @@ TEST_F(ImageControllerTest, NullControllerUnrefsImages) {
   EXPECT_EQ(0, cache()->number_of_refs());
 }
 
+TEST_F(ImageControllerTest, PredecodeHitAndMissCounts) {
+  DrawImage used_image = CreateDiscardableDrawImage(gfx::Size(1, 1));
+  DrawImage unused_image = CreateDiscardableDrawImage(gfx::Size(1, 1));
+  ImageDecodeCache::TracingInfo tracing_info;
+
+  controller()->SetPredecodeImages({used_image, unused_image}, tracing_info);
+
+  // A tile needs one of the predecoded images, twice.
+  for (int i = 0; i < 2; ++i) {
+    std::vector<DrawImage> images = {used_image};
+    std::vector<scoped_refptr<TileTask>> tasks;
+    bool has_at_raster_images = false;
+    controller()->ConvertDataImagesToTasks(&images, &tasks,
+                                           &has_at_raster_images, tracing_info);
+    controller()->UnrefImages(images);
+  }
+  EXPECT_EQ(1u, controller()->predecode_hit_count());
+  EXPECT_EQ(0u, controller()->predecode_miss_count());
+
+  // Keeping both images predecoded doesn't count them again.
+  controller()->SetPredecodeImages({used_image, unused_image}, tracing_info);
+  EXPECT_EQ(1u, controller()->predecode_hit_count());
+  EXPECT_EQ(0u, controller()->predecode_miss_count());
+
+  // The other one goes away without being needed.
+  controller()->SetPredecodeImages(std::vector<DrawImage>(), tracing_info);
+  EXPECT_EQ(1u, controller()->predecode_hit_count());
+  EXPECT_EQ(1u, controller()->predecode_miss_count());
+}
+
 TEST_F(ImageControllerTest, QueueImageDecode) {
   base::RunLoop run_loop;
   DecodeClient decode_client;
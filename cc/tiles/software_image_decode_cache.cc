@@ -6,6 +6,9 @@
 
 #include <stdint.h>
 
+#include <algorithm>
+#include <vector>
+
 #include "base/bind.h"
 #include "base/format_macros.h"
 #include "base/macros.h"
@@ -480,31 +483,34 @@ SoftwareImageDecodeCache::FindCachedCandidate(const CacheKey& key) {
   // won't be empty.
   DCHECK(image_keys_it != frame_key_to_image_keys_.end());
 
-  auto& available_keys = image_keys_it->second;
-  std::sort(available_keys.begin(), available_keys.end(),
-            [](const CacheKey& one, const CacheKey& two) {
-              // Return true if |one| scale is less than |two| scale.
-              return one.target_size().width() < two.target_size().width() &&
-                     one.target_size().height() < two.target_size().height();
-            });
-
-  for (auto& available_key : available_keys) {
-    // Only consider keys coming from the same src rect, since otherwise the
-    // resulting image was extracted using a different src.
+  // Only consider keys coming from the same src rect, since otherwise the
+  // resulting image was extracted using a different src, and that are at
+  // least as big as the required |key|.
+  std::vector<const CacheKey*> candidate_keys;
+  for (const auto& available_key : image_keys_it->second) {
     if (available_key.src_rect() != key.src_rect())
       continue;
-
-    // That are at least as big as the required |key|.
     if (available_key.target_size().width() < key.target_size().width() ||
         available_key.target_size().height() < key.target_size().height()) {
       continue;
     }
-    auto image_it = decoded_images_.Peek(available_key);
+    candidate_keys.push_back(&available_key);
+  }
+
+  // Prefer the smallest candidate, which is the closest mip level above the
+  // required one, since scaling from it touches the fewest pixels.
+  std::sort(candidate_keys.begin(), candidate_keys.end(),
+            [](const CacheKey* one, const CacheKey* two) {
+              return one->target_size().GetArea() <
+                     two->target_size().GetArea();
+            });
+
+  for (const CacheKey* candidate_key : candidate_keys) {
+    auto image_it = decoded_images_.Peek(*candidate_key);
     DCHECK(image_it != decoded_images_.end());
     auto* available_entry = image_it->second.get();
-    if (available_entry->is_locked || available_entry->Lock()) {
-      return available_key;
-    }
+    if (available_entry->is_locked || available_entry->Lock())
+      return *candidate_key;
   }
 
   return base::nullopt;
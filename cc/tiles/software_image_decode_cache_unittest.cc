@@ -1811,6 +1811,61 @@ TEST(SoftwareImageDecodeCacheTest, DecodeToScale) {
   cache.DrawWithImageFinished(draw_image2, decoded_image2);
 }
 
+TEST(SoftwareImageDecodeCacheTest, ScaleFromClosestMipLevel) {
+  TestSoftwareImageDecodeCache cache;
+  bool is_decomposable = true;
+  SkFilterQuality quality = kMedium_SkFilterQuality;
+
+  SkISize full_size = SkISize::Make(100, 100);
+  std::vector<SkISize> supported_sizes = {SkISize::Make(50, 50)};
+  std::vector<FrameMetadata> frames = {FrameMetadata()};
+  sk_sp<FakePaintImageGenerator> generator =
+      sk_make_sp<FakePaintImageGenerator>(
+          SkImageInfo::MakeN32Premul(full_size.width(), full_size.height(),
+                                     DefaultColorSpace().ToSkColorSpace()),
+          frames, true, supported_sizes);
+  PaintImage paint_image = PaintImageBuilder::WithDefault()
+                               .set_id(PaintImage::GetNextId())
+                               .set_paint_image_generator(generator)
+                               .TakePaintImage();
+
+  // Decode mip level 1 to scale, and then the original.
+  DrawImage level1_draw_image(
+      paint_image, SkIRect::MakeWH(paint_image.width(), paint_image.height()),
+      quality, CreateMatrix(SkSize::Make(0.5, 0.5), is_decomposable),
+      PaintImage::kDefaultFrameIndex);
+  DecodedDrawImage level1_image =
+      cache.GetDecodedImageForDraw(level1_draw_image);
+  ASSERT_TRUE(level1_image.image());
+  DrawImage original_draw_image(
+      paint_image, SkIRect::MakeWH(paint_image.width(), paint_image.height()),
+      quality, CreateMatrix(SkSize::Make(1.f, 1.f), is_decomposable),
+      PaintImage::kDefaultFrameIndex);
+  DecodedDrawImage original_image =
+      cache.GetDecodedImageForDraw(original_draw_image);
+  ASSERT_TRUE(original_image.image());
+  EXPECT_EQ(cache.GetNumCacheEntriesForTesting(), 2u);
+  ASSERT_EQ(generator->decode_infos().size(), 2u);
+
+  // Mip level 3 is generated from one of the cached decodes, with both the
+  // original and mip level 1 available, and doesn't decode again.
+  DrawImage level3_draw_image(
+      paint_image, SkIRect::MakeWH(paint_image.width(), paint_image.height()),
+      quality, CreateMatrix(SkSize::Make(0.125, 0.125), is_decomposable),
+      PaintImage::kDefaultFrameIndex);
+  DecodedDrawImage level3_image =
+      cache.GetDecodedImageForDraw(level3_draw_image);
+  ASSERT_TRUE(level3_image.image());
+  EXPECT_EQ(level3_image.image()->width(), 13);
+  EXPECT_EQ(level3_image.image()->height(), 13);
+  EXPECT_EQ(cache.GetNumCacheEntriesForTesting(), 3u);
+  EXPECT_EQ(generator->decode_infos().size(), 2u);
+
+  cache.DrawWithImageFinished(level1_draw_image, level1_image);
+  cache.DrawWithImageFinished(original_draw_image, original_image);
+  cache.DrawWithImageFinished(level3_draw_image, level3_image);
+}
+
 TEST(SoftwareImageDecodeCacheTest, DecodeToScaleSubrect) {
   TestSoftwareImageDecodeCache cache;
   bool is_decomposable = true;
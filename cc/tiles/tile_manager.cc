@@ -629,6 +629,12 @@ void TileManager::BasicStateAsValueInto(
     base::trace_event::TracedValue* state) const {
   state->SetInteger("tile_count", base::saturated_cast<int>(tiles_.size()));
   state->SetBoolean("did_oom_on_last_assign", did_oom_on_last_assign_);
+  state->SetInteger(
+      "predecode_hit_count",
+      base::saturated_cast<int>(image_controller_.predecode_hit_count()));
+  state->SetInteger(
+      "predecode_miss_count",
+      base::saturated_cast<int>(image_controller_.predecode_miss_count()));
   state->BeginDictionary("global_state");
   global_state_.AsValueInto(state);
   state->EndDictionary();
@@ -788,9 +788,16 @@ void FindLayersThatNeedUpdates(LayerTreeImpl* layer_tree_impl,
 void ComputeTransforms(TransformTree* transform_tree) {
   if (!transform_tree->needs_update())
     return;
+  bool only_animations_need_update =
+      transform_tree->only_animations_need_update();
   for (int i = TransformTree::kContentsRootNodeId;
-       i < static_cast<int>(transform_tree->size()); ++i)
+       i < static_cast<int>(transform_tree->size()); ++i) {
+    if (only_animations_need_update &&
+        !transform_tree->NeedsUpdateForAnimations(i)) {
+      continue;
+    }
     transform_tree->UpdateTransforms(i);
+  }
   transform_tree->set_needs_update(false);
 }
 
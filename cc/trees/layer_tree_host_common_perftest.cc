@@ -4,6 +4,7 @@
 
 #include <stddef.h>
 
+#include <limits>
 #include <memory>
 #include <sstream>
 
@@ -21,6 +22,7 @@
 #include "cc/test/layer_tree_test.h"
 #include "cc/trees/layer_tree_host_common.h"
 #include "cc/trees/layer_tree_impl.h"
+#include "cc/trees/property_tree.h"
 #include "cc/trees/transform_node.h"
 #include "components/viz/test/paths.h"
 #include "testing/perf/perf_test.h"
@@ -120,6 +122,37 @@ class CalcDrawPropsTest : public LayerTreeHostCommonPerfTest {
   }
 };
 
+// Animates the transform of one layer before each computation, so that only
+// the transforms of that layer and its subtree need to be updated.
+class CalcDrawPropsTransformAnimationTest : public CalcDrawPropsTest {
+ public:
+  void DrawLayersOnThread(LayerTreeHostImpl* host_impl) override {
+    LayerTreeImpl* active_tree = host_impl->active_tree();
+    PropertyTrees* property_trees = active_tree->property_trees();
+    TransformTree& transform_tree = property_trees->transform_tree;
+    int animated_node_id = static_cast<int>(transform_tree.size()) - 1;
+    ElementId animated_element_id(std::numeric_limits<uint64_t>::max());
+    transform_tree.Node(animated_node_id)->element_id = animated_element_id;
+    property_trees->element_id_to_transform_node_index[animated_element_id] =
+        animated_node_id;
+
+    timer_.Reset();
+    int lap = 0;
+    do {
+      gfx::Transform transform;
+      transform.Translate(lap++ % 2, 0);
+      transform_tree.OnTransformAnimated(animated_element_id, transform);
+
+      int max_texture_size = 8096;
+      DoCalcDrawPropertiesImpl(max_texture_size, active_tree, host_impl);
+
+      timer_.NextLap();
+    } while (!timer_.HasTimeLimitExpired());
+
+    EndTest();
+  }
+};
+
 TEST_F(CalcDrawPropsTest, TenTen) {
   SetTestName("10_10");
   ReadTestFile("10_10_layer_tree");
@@ -144,5 +177,11 @@ TEST_F(CalcDrawPropsTest, TouchRegionHeavy) {
   RunCalcDrawProps();
 }
 
+TEST_F(CalcDrawPropsTransformAnimationTest, HeavyPage) {
+  SetTestName("heavy_page_transform_animation");
+  ReadTestFile("heavy_layer_tree");
+  RunCalcDrawProps();
+}
+
 }  // namespace
 }  // namespace cc
@@ -124,6 +124,7 @@ void TransformTree::clear() {
   cached_data_.clear();
   cached_data_.push_back(TransformCachedNodeData());
   sticky_position_data_.clear();
+  only_animations_need_update_ = false;
 
 #if DCHECK_IS_ON()
   TransformTree tree;
@@ -138,6 +139,7 @@ void TransformTree::set_needs_update(bool needs_update) {
   if (needs_update && !PropertyTree<TransformNode>::needs_update())
     property_trees()->UpdateTransformTreeUpdateNumber();
   PropertyTree<TransformNode>::set_needs_update(needs_update);
+  only_animations_need_update_ = false;
 }
 
 bool TransformTree::ComputeTranslation(int source_id,
@@ -199,7 +201,10 @@ bool TransformTree::OnTransformAnimated(ElementId element_id,
   node->needs_local_transform_update = true;
   node->transform_changed = true;
   property_trees()->changed = true;
+  bool only_animations_need_update =
+      !needs_update() || only_animations_need_update_;
   set_needs_update(true);
+  only_animations_need_update_ = only_animations_need_update;
   return true;
 }
 
@@ -236,6 +241,23 @@ void TransformTree::UpdateTransforms(int id) {
   UpdateNodeAndAncestorsAreAnimatedOrInvertible(node, parent_node);
 }
 
+bool TransformTree::NeedsUpdateForAnimations(int id) {
+  TransformNode* node = Node(id);
+  TransformNode* parent_node = parent(node);
+  DCHECK(parent_node);
+  // The animated nodes have a local transform to update, and the nodes below
+  // them see the change through their parent or source. Sticky and source to
+  // parent offsets are always recomputed by UpdateTransforms, so those nodes
+  // are updated as well.
+  if (node->needs_local_transform_update || parent_node->transform_changed ||
+      node->sticky_position_constraint_id >= 0 ||
+      NeedsSourceToParentUpdate(node)) {
+    return true;
+  }
+  TransformNode* source_node = Node(node->source_node_id);
+  return source_node && source_node->transform_changed;
+}
+
 bool TransformTree::IsDescendant(int desc_id, int source_id) const {
   while (desc_id != source_id) {
     if (desc_id == kInvalidNodeId)
@@ -727,7 +749,8 @@ bool TransformTree::operator==(const TransformTree& other) const {
              other.device_transform_scale_factor() &&
          nodes_affected_by_outer_viewport_bounds_delta_ ==
              other.nodes_affected_by_outer_viewport_bounds_delta() &&
-         cached_data_ == other.cached_data();
+         cached_data_ == other.cached_data() &&
+         only_animations_need_update_ == other.only_animations_need_update();
 }
 
 StickyPositionNodeData* TransformTree::StickyPositionData(int node_id) {
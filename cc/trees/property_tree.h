@@ -151,6 +151,10 @@ class CC_EXPORT TransformTree final : public PropertyTree<TransformNode> {
   void ResetChangeTracking();
   // Updates the parent, target, and screen space transforms and snapping.
   void UpdateTransforms(int id);
+  // Returns true if the node at |id| needs UpdateTransforms when
+  // only_animations_need_update() is true, i.e. if it was animated or depends
+  // on a node that was updated.
+  bool NeedsUpdateForAnimations(int id);
   void UpdateTransformChanged(TransformNode* node,
                               TransformNode* parent_node,
                               TransformNode* source_node);
@@ -160,6 +164,13 @@ class CC_EXPORT TransformTree final : public PropertyTree<TransformNode> {
 
   void set_needs_update(bool needs_update) final;
 
+  // True if the only changes since the last update came through
+  // OnTransformAnimated, so that the nodes outside the animated subtrees can
+  // keep their transforms.
+  bool only_animations_need_update() const {
+    return only_animations_need_update_;
+  }
+
   // A TransformNode's source_to_parent value is used to account for the fact
   // that fixed-position layers are positioned by Blink wrt to their layer tree
   // parent (their "source"), but are parented in the transform tree by their
@@ -263,6 +274,7 @@ class CC_EXPORT TransformTree final : public PropertyTree<TransformNode> {
   std::vector<int> nodes_affected_by_outer_viewport_bounds_delta_;
   std::vector<TransformCachedNodeData> cached_data_;
   std::vector<StickyPositionNodeData> sticky_position_data_;
+  bool only_animations_need_update_ = false;
 };
 
 struct StickyPositionNodeData {
@@ -136,6 +136,64 @@ TEST(PropertyTreeTest, ComputeTransformSibling) {
   EXPECT_TRANSFORMATION_MATRIX_EQ(expected, transform);
 }
 
+TEST(PropertyTreeTest, TransformAnimationUpdatesAnimatedSubtree) {
+  PropertyTrees property_trees;
+  TransformTree& tree = property_trees.transform_tree;
+  tree.set_source_to_parent_updates_allowed(false);
+  TransformNode contents_root;
+  contents_root.source_node_id = 0;
+  contents_root.local.Translate(2, 2);
+  contents_root.id = tree.Insert(contents_root, 0);
+
+  TransformNode animated;
+  animated.source_node_id = 1;
+  animated.local.Translate(3, 3);
+  animated.element_id = ElementId(1);
+  animated.id = tree.Insert(animated, 1);
+  property_trees.element_id_to_transform_node_index[animated.element_id] =
+      animated.id;
+
+  TransformNode child;
+  child.source_node_id = 2;
+  child.local.Translate(1, 1);
+  child.id = tree.Insert(child, 2);
+
+  TransformNode sibling;
+  sibling.source_node_id = 1;
+  sibling.local.Translate(7, 7);
+  sibling.id = tree.Insert(sibling, 1);
+
+  tree.set_needs_update(true);
+  draw_property_utils::ComputeTransforms(&tree);
+  tree.ResetChangeTracking();
+
+  gfx::Transform animated_transform;
+  animated_transform.Translate(5, 5);
+  EXPECT_TRUE(tree.OnTransformAnimated(animated.element_id,
+                                       animated_transform));
+  EXPECT_TRUE(tree.needs_update());
+  EXPECT_TRUE(tree.only_animations_need_update());
+  EXPECT_TRUE(tree.NeedsUpdateForAnimations(animated.id));
+  EXPECT_TRUE(tree.NeedsUpdateForAnimations(child.id));
+  EXPECT_FALSE(tree.NeedsUpdateForAnimations(sibling.id));
+
+  draw_property_utils::ComputeTransforms(&tree);
+  EXPECT_FALSE(tree.needs_update());
+  EXPECT_FALSE(tree.only_animations_need_update());
+
+  gfx::Transform expected;
+  expected.Translate(8, 8);
+  EXPECT_TRANSFORMATION_MATRIX_EQ(expected, tree.ToScreen(child.id));
+  expected.MakeIdentity();
+  expected.Translate(9, 9);
+  EXPECT_TRANSFORMATION_MATRIX_EQ(expected, tree.ToScreen(sibling.id));
+
+  // Any other change updates the whole tree.
+  EXPECT_TRUE(tree.OnTransformAnimated(animated.element_id, gfx::Transform()));
+  tree.set_needs_update(true);
+  EXPECT_FALSE(tree.only_animations_need_update());
+}
+
 TEST(PropertyTreeTest, ComputeTransformSiblingSingularAncestor) {
   // In this test, we have the following tree:
   // root
@@ -6,6 +6,9 @@
 
 #include <stdint.h>
 
+#include <utility>
+#include <vector>
+
 #include "base/i18n/case_conversion.h"
 #include "base/i18n/unicodestring.h"
 #include "base/logging.h"
@@ -201,23 +204,22 @@ bool TitledUrlIndex::GetResultsMatchingTerm(
     }
     base::EraseIf(*matches, base::IsNotIn<TitledUrlNodeSet>(i->second));
   } else {
-    // Loop through index adding all entries that start with term to
-    // |prefix_matches|.
-    TitledUrlNodeSet tmp_prefix_matches;
-    // If this is the first term, then store the result directly in |matches|
-    // to avoid calling stl intersection (which requires a copy).
-    TitledUrlNodeSet* prefix_matches =
-        first_term ? matches : &tmp_prefix_matches;
+    // Loop through index gathering all entries that start with term. Inserting
+    // into a flat_set one node at a time shifts the set on every insert, so
+    // collect the nodes first and let the set sort and dedupe them once.
+    std::vector<const TitledUrlNode*> prefix_nodes;
     while (i != index_.end() &&
            i->first.size() >= term.size() &&
            term.compare(0, term.size(), i->first, 0, term.size()) == 0) {
-      for (auto n = i->second.begin(); n != i->second.end(); ++n) {
-        prefix_matches->insert(prefix_matches->end(), *n);
-      }
+      prefix_nodes.insert(prefix_nodes.end(), i->second.begin(),
+                          i->second.end());
       ++i;
     }
-    if (!first_term) {
-      base::EraseIf(*matches, base::IsNotIn<TitledUrlNodeSet>(*prefix_matches));
+    TitledUrlNodeSet prefix_matches(std::move(prefix_nodes));
+    if (first_term) {
+      *matches = std::move(prefix_matches);
+    } else {
+      base::EraseIf(*matches, base::IsNotIn<TitledUrlNodeSet>(prefix_matches));
     }
   }
   return !matches->empty();
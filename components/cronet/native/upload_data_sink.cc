@@ -207,7 +207,12 @@ void Cronet_UploadDataSinkImpl::Read(net::IOBuffer* buffer, int buf_len) {
     in_which_user_callback_ = READ;
     upload_data_provider = upload_data_provider_;
   }
-  buffer_ = std::make_unique<Cronet_BufferWithIOBuffer>(buffer, buf_len);
+  // The upload stream often reads into the same IOBuffer for every chunk,
+  // so keep the wrapper instead of allocating a new one per read.
+  if (!buffer_ || buffer_->io_buffer() != buffer ||
+      buffer_->io_buffer_len() != static_cast<size_t>(buf_len)) {
+    buffer_ = std::make_unique<Cronet_BufferWithIOBuffer>(buffer, buf_len);
+  }
   Cronet_UploadDataProvider_Read(upload_data_provider, this,
                                  buffer_->cronet_buffer());
 }
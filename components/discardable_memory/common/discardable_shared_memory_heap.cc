@@ -8,6 +8,7 @@
 #include <memory>
 #include <utility>
 
+#include "base/bits.h"
 #include "base/format_macros.h"
 #include "base/memory/discardable_shared_memory.h"
 #include "base/memory/ptr_util.h"
@@ -26,6 +27,8 @@ bool IsInFreeList(DiscardableSharedMemoryHeap::Span* span) {
   return span->previous() || span->next();
 }
 
+constexpr size_t kBitsPerWord = 64;
+
 }  // namespace
 
 DiscardableSharedMemoryHeap::Span::Span(
@@ -192,22 +195,25 @@ std::unique_ptr<DiscardableSharedMemoryHeap::Span>
 DiscardableSharedMemoryHeap::SearchFreeLists(size_t blocks, size_t slack) {
   DCHECK(blocks);
 
-  size_t length = blocks;
   size_t max_length = blocks + slack;
+  const size_t overflow_index = base::size(free_spans_) - 1;
 
   // Search array of free lists for a suitable span.
-  while (length - 1 < base::size(free_spans_) - 1) {
-    const base::LinkedList<Span>& free_spans = free_spans_[length - 1];
-    if (!free_spans.empty()) {
-      // Return the most recently used span located in tail.
-      return Carve(free_spans.tail()->value(), blocks);
-    }
-
-    // Return early after surpassing |max_length|.
-    if (++length > max_length)
+  size_t index = NextNonEmptyFreeList(std::min(blocks - 1, overflow_index));
+  if (index < overflow_index) {
+    // Return early if the shortest available span surpasses |max_length|.
+    // Spans in the overflow free list are even longer.
+    if (index + 1 > max_length)
       return nullptr;
+
+    // Return the most recently used span located in tail.
+    return Carve(free_spans_[index].tail()->value(), blocks);
   }
 
+  // Only spans of at least base::size(free_spans_) blocks are left.
+  if (max_length < base::size(free_spans_))
+    return nullptr;
+
   const base::LinkedList<Span>& overflow_free_spans =
       free_spans_[base::size(free_spans_) - 1];
 
@@ -267,15 +273,34 @@ void DiscardableSharedMemoryHeap::InsertIntoFreeList(
   DCHECK(!IsInFreeList(span.get()));
   size_t index = std::min(span->length_, base::size(free_spans_)) - 1;
   free_spans_[index].Append(span.release());
+  non_empty_free_lists_[index / kBitsPerWord] |= uint64_t{1}
+                                                 << (index % kBitsPerWord);
 }
 
 std::unique_ptr<DiscardableSharedMemoryHeap::Span>
 DiscardableSharedMemoryHeap::RemoveFromFreeList(Span* span) {
   DCHECK(IsInFreeList(span));
   span->RemoveFromList();
+  size_t index = std::min(span->length_, base::size(free_spans_)) - 1;
+  if (free_spans_[index].empty()) {
+    non_empty_free_lists_[index / kBitsPerWord] &=
+        ~(uint64_t{1} << (index % kBitsPerWord));
+  }
   return base::WrapUnique(span);
 }
 
+size_t DiscardableSharedMemoryHeap::NextNonEmptyFreeList(size_t index) const {
+  size_t word = index / kBitsPerWord;
+  uint64_t bits = non_empty_free_lists_[word] &
+                  (~uint64_t{0} << (index % kBitsPerWord));
+  while (!bits) {
+    if (++word == base::size(non_empty_free_lists_))
+      return base::size(free_spans_);
+    bits = non_empty_free_lists_[word];
+  }
+  return word * kBitsPerWord + base::bits::CountTrailingZeroBits(bits);
+}
+
 std::unique_ptr<DiscardableSharedMemoryHeap::Span>
 DiscardableSharedMemoryHeap::Carve(Span* span, size_t blocks) {
   std::unique_ptr<Span> serving = RemoveFromFreeList(span);
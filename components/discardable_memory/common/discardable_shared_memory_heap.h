@@ -140,6 +140,9 @@ class DISCARDABLE_MEMORY_EXPORT DiscardableSharedMemoryHeap {
 
   void InsertIntoFreeList(std::unique_ptr<Span> span);
   std::unique_ptr<Span> RemoveFromFreeList(Span* span);
+  // Returns the index of the first non-empty free list at or after |index|,
+  // or the number of free lists if there is none.
+  size_t NextNonEmptyFreeList(size_t index) const;
   std::unique_ptr<Span> Carve(Span* span, size_t blocks);
   void RegisterSpan(Span* span);
   void UnregisterSpan(Span* span);
@@ -172,6 +175,10 @@ class DISCARDABLE_MEMORY_EXPORT DiscardableSharedMemoryHeap {
   // free list of runs that have length >= 256 blocks.
   base::LinkedList<Span> free_spans_[256];
 
+  // Bitmap with one bit per entry of |free_spans_|, set when that free list is
+  // not empty. Lets SearchFreeLists() skip runs of empty lists.
+  uint64_t non_empty_free_lists_[256 / 64] = {};
+
   DISALLOW_COPY_AND_ASSIGN(DiscardableSharedMemoryHeap);
 };
 
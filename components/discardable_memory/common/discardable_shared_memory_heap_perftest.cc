@@ -9,6 +9,7 @@
 #include <cmath>
 #include <cstdlib>
 #include <memory>
+#include <string>
 #include <utility>
 
 #include "base/bind.h"
@@ -26,7 +27,10 @@ const int kTimeCheckInterval = 8192;
 
 void NullTask() {}
 
-TEST(DiscardableSharedMemoryHeapTest, SearchFreeLists) {
+// Allocates and frees spans with an exponentially distributed number of blocks
+// whose mean is proportional to |span_scale|, and reports the rate under the
+// |trace| name.
+void RunSearchFreeLists(size_t span_scale, const std::string& trace) {
   size_t block_size = base::GetPageSize();
   DiscardableSharedMemoryHeap heap(block_size);
 
@@ -56,7 +60,7 @@ TEST(DiscardableSharedMemoryHeapTest, SearchFreeLists) {
     // Exponentially distributed block size.
     const double kLambda = 2.0;
     double v = static_cast<double>(std::rand()) / RAND_MAX;
-    random_blocks[i] = 1 + log(1.0 - v) / -kLambda * kBlocks;
+    random_blocks[i] = 1 + log(1.0 - v) / -kLambda * span_scale;
   }
 
   std::vector<std::unique_ptr<base::ScopedClosureRunner>> spans;
@@ -92,9 +96,19 @@ TEST(DiscardableSharedMemoryHeapTest, SearchFreeLists) {
 
   spans.clear();
 
-  perf_test::PrintResult("search_free_list", "", "",
+  perf_test::PrintResult("search_free_list", "", trace,
                          count / accumulator.InSecondsF(), "runs/s", true);
 }
 
+TEST(DiscardableSharedMemoryHeapTest, SearchFreeLists) {
+  RunSearchFreeLists(4096, "");
+}
+
+// Small spans, like glyph and image cache entries, searched with a large
+// slack so that most of the exact-size free lists are empty.
+TEST(DiscardableSharedMemoryHeapTest, SearchFreeListsSmallSpans) {
+  RunSearchFreeLists(4, "small_spans");
+}
+
 }  // namespace
 }  // namespace discardable_memory
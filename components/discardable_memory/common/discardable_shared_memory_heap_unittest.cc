@@ -281,6 +281,49 @@ TEST(DiscardableSharedMemoryHeapTest, Slack) {
   heap.MergeIntoFreeLists(std::move(span));
 }
 
+TEST(DiscardableSharedMemoryHeapTest, SearchAcrossEmptyFreeLists) {
+  size_t block_size = base::GetPageSize();
+  DiscardableSharedMemoryHeap heap(block_size);
+
+  const size_t kBlocks = 200;
+  size_t memory_size = block_size * kBlocks;
+  int next_discardable_shared_memory_id = 0;
+
+  std::unique_ptr<base::DiscardableSharedMemory> memory(
+      new base::DiscardableSharedMemory);
+  ASSERT_TRUE(memory->CreateAndMap(memory_size));
+  heap.MergeIntoFreeLists(heap.Grow(std::move(memory), memory_size,
+                                    next_discardable_shared_memory_id++,
+                                    base::Bind(NullTask)));
+
+  // The only free span has 200 blocks.
+  std::unique_ptr<DiscardableSharedMemoryHeap::Span> span1 =
+      heap.SearchFreeLists(1, kBlocks);
+  ASSERT_TRUE(span1);
+  EXPECT_EQ(1u, span1->length());
+
+  // No free span that is less or equal to 1 + 197.
+  EXPECT_FALSE(heap.SearchFreeLists(1, 197));
+
+  std::unique_ptr<DiscardableSharedMemoryHeap::Span> span2 =
+      heap.SearchFreeLists(100, 99);
+  ASSERT_TRUE(span2);
+  EXPECT_EQ(100u, span2->length());
+
+  // Only a 99 block span is left.
+  EXPECT_FALSE(heap.SearchFreeLists(100, 1000));
+
+  std::unique_ptr<DiscardableSharedMemoryHeap::Span> span3 =
+      heap.SearchFreeLists(99, 0);
+  ASSERT_TRUE(span3);
+  EXPECT_EQ(99u, span3->length());
+  EXPECT_FALSE(heap.SearchFreeLists(1, 1000));
+
+  heap.MergeIntoFreeLists(std::move(span1));
+  heap.MergeIntoFreeLists(std::move(span2));
+  heap.MergeIntoFreeLists(std::move(span3));
+}
+
 void OnDeleted(bool* deleted) {
   *deleted = true;
 }
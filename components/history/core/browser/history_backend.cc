@@ -2341,6 +2341,7 @@ void HistoryBackend::Commit() {
   // could optimize more for this case (we may get two extra commits in
   // some cases) but it hasn't been important yet.
   CancelScheduledCommit();
+  changes_since_commit_ = 0;
 
   db_->CommitTransaction();
   DCHECK_EQ(db_->transaction_nesting(), 0)
@@ -2356,6 +2357,11 @@ void HistoryBackend::Commit() {
 }
 
 void HistoryBackend::ScheduleCommit() {
+  if (++changes_since_commit_ >= kMaxChangesPerCommit) {
+    Commit();
+    return;
+  }
+
   // Non-cancelled means there's an already scheduled commit. Note that
   // CancelableClosure starts cancelled with the default constructor.
   if (!scheduled_commit_.IsCancelled())
@@ -522,6 +522,7 @@ class HistoryBackend : public base::RefCountedThreadSafe<HistoryBackend>,
   FRIEND_TEST_ALL_PREFIXES(HistoryBackendTest, ImportedFaviconsTest);
   FRIEND_TEST_ALL_PREFIXES(HistoryBackendTest, URLsNoLongerBookmarked);
   FRIEND_TEST_ALL_PREFIXES(HistoryBackendTest, StripUsernamePasswordTest);
+  FRIEND_TEST_ALL_PREFIXES(HistoryBackendTest, ScheduleCommitBatchesChanges);
   FRIEND_TEST_ALL_PREFIXES(HistoryBackendTest, DeleteThumbnailsDatabaseTest);
   FRIEND_TEST_ALL_PREFIXES(HistoryBackendTest, AddPageVisitSource);
   FRIEND_TEST_ALL_PREFIXES(HistoryBackendTest, AddPageVisitBackForward);
@@ -677,7 +678,9 @@ class HistoryBackend : public base::RefCountedThreadSafe<HistoryBackend>,
 
   // Schedules a commit to happen in the future. We do this so that many
   // operations over a period of time will be batched together. If there is
-  // already a commit scheduled for the future, this will do nothing.
+  // already a commit scheduled for the future, this will do nothing, unless
+  // kMaxChangesPerCommit changes have piled up in the open transaction, in
+  // which case they are committed right away.
   void ScheduleCommit();
 
   // Cancels the scheduled commit, if any. If there is no scheduled commit,
@@ -883,6 +886,13 @@ class HistoryBackend : public base::RefCountedThreadSafe<HistoryBackend>,
   // scheduled commit at a time (see ScheduleCommit).
   base::CancelableClosure scheduled_commit_;
 
+  // The number of ScheduleCommit() calls since the last Commit(). Bounds how
+  // much work a single batched transaction can accumulate under heavy write
+  // load, which keeps SQLite from spilling large numbers of dirty pages and
+  // limits what an unclean shutdown can lose.
+  static constexpr size_t kMaxChangesPerCommit = 1000;
+  size_t changes_since_commit_ = 0;
+
   // Maps recent redirect destination pages to the chain of redirects that
   // brought us to there. Pages that did not have redirects or were not the
   // final redirect in a chain will not be in this list, as well as pages that
@@ -1240,6 +1240,29 @@ TEST_F(HistoryBackendTest, StripUsernamePasswordTest) {
   ASSERT_EQ(1U, visits.size());
 }
 
+TEST_F(HistoryBackendTest, ScheduleCommitBatchesChanges) {
+  ASSERT_TRUE(backend_.get());
+  backend_->Commit();
+  EXPECT_TRUE(backend_->scheduled_commit_.IsCancelled());
+
+  // Visits are batched into the open transaction behind a single delayed
+  // commit.
+  HistoryAddPageArgs request(GURL("http://www.google.com/"), base::Time::Now(),
+                             nullptr, 0, GURL(), history::RedirectList(),
+                             ui::PAGE_TRANSITION_TYPED, false,
+                             history::SOURCE_BROWSED, false, true);
+  backend_->AddPage(request);
+  EXPECT_FALSE(backend_->scheduled_commit_.IsCancelled());
+  EXPECT_EQ(1u, backend_->changes_since_commit_);
+
+  // Once enough changes pile up they are committed without waiting for the
+  // timer.
+  while (backend_->changes_since_commit_ != 0)
+    backend_->ScheduleCommit();
+  EXPECT_TRUE(backend_->scheduled_commit_.IsCancelled());
+  EXPECT_EQ(1, backend_->db_->transaction_nesting());
+}
+
 TEST_F(HistoryBackendTest, AddPageVisitBackForward) {
   ASSERT_TRUE(backend_.get());
 
@@ -91,7 +91,8 @@ PersistedLogs::PersistedLogs(std::unique_ptr<PersistedLogsMetrics> metrics,
       min_log_bytes_(min_log_bytes),
       max_log_size_(max_log_size != 0 ? max_log_size : static_cast<size_t>(-1)),
       signing_key_(signing_key),
-      staged_log_index_(-1) {
+      staged_log_index_(-1),
+      needs_persist_(true) {
   DCHECK(local_state_);
   // One of the limit arguments must be non-zero.
   DCHECK(min_log_count_ > 0 || min_log_bytes_ > 0);
@@ -148,18 +149,24 @@ void PersistedLogs::DiscardStagedLog() {
   DCHECK_LT(static_cast<size_t>(staged_log_index_), list_.size());
   list_.erase(list_.begin() + staged_log_index_);
   staged_log_index_ = -1;
+  needs_persist_ = true;
 }
 
 void PersistedLogs::PersistUnsentLogs() const {
+  if (!needs_persist_)
+    return;
   ListPrefUpdate update(local_state_, pref_name_);
   // TODO(crbug.com/859477): Verify that the preference has been properly
   // registered.
   CHECK(update.Get());
   WriteLogsToPrefList(update.Get());
+  needs_persist_ = false;
 }
 
 void PersistedLogs::LoadPersistedUnsentLogs() {
   ReadLogsFromPrefList(*local_state_->GetList(pref_name_));
+  // Persisting may still drop oversized or excess logs that were read back.
+  needs_persist_ = true;
 }
 
 void PersistedLogs::StoreLog(const std::string& log_data) {
@@ -167,6 +174,7 @@ void PersistedLogs::StoreLog(const std::string& log_data) {
   list_.back().Init(metrics_.get(), log_data,
                     base::NumberToString(base::Time::Now().ToTimeT()),
                     signing_key_);
+  needs_persist_ = true;
 }
 
 void PersistedLogs::Purge() {
@@ -175,6 +183,7 @@ void PersistedLogs::Purge() {
   }
   list_.clear();
   local_state_->ClearPref(pref_name_);
+  needs_persist_ = false;
 }
 
 void PersistedLogs::ReadLogsFromPrefList(const base::ListValue& list_value) {
@@ -142,6 +142,12 @@ class PersistedLogs : public LogStore {
   // staged, the index will be -1.
   int staged_log_index_;
 
+  // True if |list_| may differ from what was last written to the preference.
+  // PersistUnsentLogs() is called after every upload and on shutdown, and
+  // rewriting an unchanged list re-encodes every log and schedules a needless
+  // Local State write.
+  mutable bool needs_persist_;
+
   DISALLOW_COPY_AND_ASSIGN(PersistedLogs);
 };
 
@@ -7,11 +7,13 @@
 #include <stddef.h>
 
 #include "base/base64.h"
+#include "base/bind.h"
 #include "base/macros.h"
 #include "base/rand_util.h"
 #include "base/sha1.h"
 #include "base/values.h"
 #include "components/metrics/persisted_logs_metrics_impl.h"
+#include "components/prefs/pref_change_registrar.h"
 #include "components/prefs/pref_registry_simple.h"
 #include "components/prefs/scoped_user_pref_update.h"
 #include "components/prefs/testing_pref_service.h"
@@ -133,6 +135,36 @@ TEST_F(PersistedLogsTest, SingleElementLogList) {
             result_persisted_logs.staged_log_timestamp());
 }
 
+// Persisting an unchanged log list should not rewrite the preference.
+TEST_F(PersistedLogsTest, UnchangedLogListIsNotRewritten) {
+  int pref_change_count = 0;
+  PrefChangeRegistrar registrar;
+  registrar.Init(&prefs_);
+  registrar.Add(kTestPrefName,
+                base::BindRepeating([](int* count) { ++*count; },
+                                    &pref_change_count));
+
+  TestPersistedLogs persisted_logs(&prefs_, kLogByteLimit);
+  persisted_logs.StoreLog("Hello world!");
+  persisted_logs.PersistUnsentLogs();
+  EXPECT_EQ(1, pref_change_count);
+
+  // Staging a log does not change the set of logs to persist.
+  persisted_logs.StageNextLog();
+  persisted_logs.PersistUnsentLogs();
+  EXPECT_EQ(1, pref_change_count);
+
+  persisted_logs.DiscardStagedLog();
+  persisted_logs.PersistUnsentLogs();
+  EXPECT_EQ(2, pref_change_count);
+  EXPECT_EQ(0U, prefs_.GetList(kTestPrefName)->GetSize());
+
+  persisted_logs.StoreLog("Goodbye world!");
+  persisted_logs.PersistUnsentLogs();
+  EXPECT_EQ(3, pref_change_count);
+  EXPECT_EQ(1U, prefs_.GetList(kTestPrefName)->GetSize());
+}
+
 // Store a set of logs over the length limit, but smaller than the min number of
 // bytes.
 TEST_F(PersistedLogsTest, LongButTinyLogList) {
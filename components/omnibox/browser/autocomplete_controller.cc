@@ -18,6 +18,7 @@
 #include "base/format_macros.h"
 #include "base/logging.h"
 #include "base/metrics/histogram.h"
+#include "base/metrics/histogram_functions.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/stringprintf.h"
 #include "base/strings/utf_string_conversions.h"
@@ -348,18 +349,39 @@ void AutocompleteController::Start(const AutocompleteInput& input) {
   // Start the new query.
   in_start_ = true;
   base::TimeTicks start_time = base::TimeTicks::Now();
+  // Most synchronous passes finish well under a millisecond, which the
+  // millisecond histograms below cannot resolve. Where the clock allows it,
+  // also report microsecond timings so it is clear which providers dominate
+  // keystroke-to-suggestion latency.
+  const bool record_micros = base::TimeTicks::IsHighResolution();
   for (auto i(providers_.begin()); i != providers_.end(); ++i) {
+    TRACE_EVENT1("omnibox", "AutocompleteProvider::Start", "provider",
+                 (*i)->GetName());
     // TODO(mpearson): Remove timing code once bug 178705 is resolved.
     base::TimeTicks provider_start_time = base::TimeTicks::Now();
     (*i)->Start(input_, minimal_changes);
     if (!input.want_asynchronous_matches())
       DCHECK((*i)->done());
     base::TimeTicks provider_end_time = base::TimeTicks::Now();
+    const base::TimeDelta provider_time =
+        provider_end_time - provider_start_time;
     std::string name = std::string("Omnibox.ProviderTime2.") + (*i)->GetName();
     base::HistogramBase* counter = base::Histogram::FactoryGet(
         name, 1, 5000, 20, base::Histogram::kUmaTargetedHistogramFlag);
-    counter->Add(static_cast<int>(
-        (provider_end_time - provider_start_time).InMilliseconds()));
+    counter->Add(static_cast<int>(provider_time.InMilliseconds()));
+    if (record_micros) {
+      base::UmaHistogramCustomMicrosecondsTimes(
+          std::string("Omnibox.ProviderTimeMicros.") + (*i)->GetName(),
+          provider_time, base::TimeDelta::FromMicroseconds(1),
+          base::TimeDelta::FromSeconds(1), 50);
+    }
+  }
+  if (record_micros) {
+    base::UmaHistogramCustomMicrosecondsTimes(
+        "Omnibox.SynchronousProvidersTimeMicros",
+        base::TimeTicks::Now() - start_time,
+        base::TimeDelta::FromMicroseconds(1), base::TimeDelta::FromSeconds(1),
+        50);
   }
   if (input.want_asynchronous_matches() && (input.text().length() < 6)) {
     base::TimeTicks end_time = base::TimeTicks::Now();
@@ -8,20 +8,26 @@
 #include <random>
 #include <string>
 
+#include "base/files/file_path.h"
+#include "base/files/scoped_temp_dir.h"
 #include "base/no_destructor.h"
 #include "base/run_loop.h"
 #include "base/stl_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/test/scoped_task_environment.h"
+#include "base/timer/elapsed_timer.h"
 #include "components/history/core/browser/history_backend.h"
 #include "components/history/core/browser/history_database.h"
 #include "components/history/core/browser/history_service.h"
 #include "components/history/core/test/history_service_test_util.h"
 #include "components/omnibox/browser/fake_autocomplete_provider_client.h"
 #include "components/omnibox/browser/history_test_util.h"
+#include "components/omnibox/browser/in_memory_url_index.h"
 #include "components/omnibox/browser/in_memory_url_index_test_util.h"
+#include "components/omnibox/browser/url_index_private_data.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "testing/perf/perf_test.h"
+#include "ui/base/page_transition_types.h"
 
 namespace history {
 
@@ -96,6 +102,13 @@ class HQPPerfTestOnePopularURL : public testing::Test {
     return client_->GetHistoryService()->history_backend_.get();
   }
 
+  URLIndexPrivateData* private_data() {
+    return client_->GetInMemoryURLIndex()->private_data_.get();
+  }
+
+  // Feeds |row| to the index the same way a history visit notification does.
+  void NotifyURLVisited(const URLRow& row);
+
  private:
   base::TimeDelta RunTest(const base::string16& text);
 
@@ -162,6 +175,12 @@ void HQPPerfTestOnePopularURL::PrintMeasurements(
                              trace_name, durations, "ms", true);
 }
 
+void HQPPerfTestOnePopularURL::NotifyURLVisited(const URLRow& row) {
+  client_->GetInMemoryURLIndex()->OnURLVisited(
+      client_->GetHistoryService(), ui::PAGE_TRANSITION_TYPED, row,
+      RedirectList(), row.last_visit());
+}
+
 base::TimeDelta HQPPerfTestOnePopularURL::RunTest(const base::string16& text) {
   base::RunLoop().RunUntilIdle();
   AutocompleteInput input(text, metrics::OmniboxEventProto::OTHER,
@@ -213,4 +232,47 @@ TEST_F(HQPPerfTestOnePopularURL, Backspacing) {
   RunAllTests(prefixes.rbegin(), prefixes.rend());
 }
 
+// Measures the footprint of the index along with the cost of keeping it warm
+// across restarts (cache snapshot and restore) and of keeping it current
+// (incremental updates from visit notifications).
+TEST_F(HQPPerfTestOnePopularURL, IndexMaintenance) {
+  auto* test_info = ::testing::UnitTest::GetInstance()->current_test_info();
+  const std::string test_case_name = test_info->test_case_name();
+
+  perf_test::PrintResult(test_case_name, test_info->name(), "index_memory",
+                         private_data()->EstimateMemoryUsage(), "bytes", true);
+
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  const base::FilePath cache_path =
+      temp_dir.GetPath().AppendASCII("History Provider Cache");
+
+  {
+    base::ElapsedTimer timer;
+    ASSERT_TRUE(URLIndexPrivateData::WritePrivateDataToCacheFileTask(
+        private_data(), cache_path));
+    PrintMeasurements("save_cache", {timer.Elapsed()});
+  }
+
+  {
+    base::ElapsedTimer timer;
+    scoped_refptr<URLIndexPrivateData> restored =
+        URLIndexPrivateData::RestoreFromFile(cache_path);
+    PrintMeasurements("restore_cache", {timer.Elapsed()});
+    ASSERT_TRUE(restored);
+    EXPECT_FALSE(restored->Empty());
+  }
+
+  constexpr size_t kNumUpdates = 100;
+  constexpr URLID kFirstNewURLID = 1000000;
+  base::ElapsedTimer timer;
+  for (size_t i = 0; i < kNumUpdates; ++i) {
+    URLRow row = GeneratePopularURLRow();
+    row.set_id(kFirstNewURLID + i);
+    NotifyURLVisited(row);
+  }
+  PrintMeasurements("incremental_update_x" + std::to_string(kNumUpdates),
+                    {timer.Elapsed()});
+}
+
 }  // namespace history
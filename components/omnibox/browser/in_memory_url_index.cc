@@ -289,8 +289,11 @@ void InMemoryURLIndex::Shutdown() {
   }
   cache_reader_tracker_.TryCancelAll();
   shutdown_ = true;
+  // The history observer keeps |private_data_| current incrementally, so the
+  // cache file on disk only falls behind once an update has actually changed
+  // the index. Skip rewriting an identical snapshot on every shutdown.
   base::FilePath path;
-  if (!GetCacheFilePath(&path))
+  if (!needs_to_be_cached_ || !GetCacheFilePath(&path))
     return;
   private_data_tracker_.TryCancelAll();
   task_runner_->PostTask(
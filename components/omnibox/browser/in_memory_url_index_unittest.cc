@@ -37,6 +37,7 @@
 #include "components/search_engines/template_url_service.h"
 #include "sql/transaction.h"
 #include "testing/gtest/include/gtest/gtest.h"
+#include "ui/base/page_transition_types.h"
 
 using base::ASCIIToUTF16;
 
@@ -1212,6 +1213,39 @@ TEST_F(InMemoryURLIndexTest, CacheSaveRestore) {
   ExpectPrivateDataEqual(*old_data, new_data);
 }
 
+TEST_F(InMemoryURLIndexTest, ShutdownSkipsCacheWriteWhenUnchanged) {
+  base::ScopedTempDir temp_directory;
+  ASSERT_TRUE(temp_directory.CreateUniqueTempDir());
+  set_history_dir(temp_directory.GetPath());
+  base::FilePath cache_path;
+  ASSERT_TRUE(GetCacheFilePath(&cache_path));
+
+  // Nothing has changed since the index was built, so there is nothing new to
+  // write out.
+  url_index_->Shutdown();
+  scoped_task_environment_.RunUntilIdle();
+  EXPECT_FALSE(base::PathExists(cache_path));
+}
+
+TEST_F(InMemoryURLIndexTest, ShutdownWritesCacheAfterIncrementalUpdate) {
+  base::ScopedTempDir temp_directory;
+  ASSERT_TRUE(temp_directory.CreateUniqueTempDir());
+  set_history_dir(temp_directory.GetPath());
+  base::FilePath cache_path;
+  ASSERT_TRUE(GetCacheFilePath(&cache_path));
+
+  history::URLRow new_row(GURL("http://www.brokeandaloneinmanitoba.com/"),
+                          87654321);
+  new_row.set_last_visit(base::Time::Now());
+  url_index_->OnURLVisited(history_service_.get(), ui::PAGE_TRANSITION_TYPED,
+                           new_row, history::RedirectList(),
+                           base::Time::Now());
+
+  url_index_->Shutdown();
+  scoped_task_environment_.RunUntilIdle();
+  EXPECT_TRUE(base::PathExists(cache_path));
+}
+
 TEST_F(InMemoryURLIndexTest, RebuildFromHistoryIfCacheOld) {
   base::ScopedTempDir temp_directory;
   ASSERT_TRUE(temp_directory.CreateUniqueTempDir());
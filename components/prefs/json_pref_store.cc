@@ -12,10 +12,13 @@
 #include "base/bind.h"
 #include "base/bind_helpers.h"
 #include "base/callback.h"
+#include "base/files/file.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
 #include "base/json/json_file_value_serializer.h"
+#include "base/json/json_reader.h"
 #include "base/json/json_string_value_serializer.h"
+#include "base/json/json_writer.h"
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
 #include "base/metrics/histogram.h"
@@ -37,6 +40,12 @@ struct JsonPrefStore::ReadResult {
   std::unique_ptr<base::Value> value;
   PrefReadError error;
   bool no_dir;
+  // Size of the JSON file read into |value|.
+  size_t file_size = 0;
+  // Size of the journal replayed into |value| and whether every record in it
+  // could be replayed.
+  size_t journal_size = 0;
+  bool journal_intact = true;
 
  private:
   DISALLOW_COPY_AND_ASSIGN(ReadResult);
@@ -53,6 +62,17 @@ namespace {
 
 // Some extensions we'll tack on to copies of the Preferences files.
 const base::FilePath::CharType kBadExtension[] = FILE_PATH_LITERAL("bad");
+const base::FilePath::CharType kJournalExtension[] =
+    FILE_PATH_LITERAL("journal");
+
+// Keys of a journal record: {"k": <pref path>, "v": <new value>}. A record
+// without a value removes the pref.
+const char kJournalKeyKey[] = "k";
+const char kJournalValueKey[] = "v";
+
+// The journal is compacted into the JSON file once it grows larger than the
+// JSON file itself, but never below this size.
+const size_t kMinJournalCompactionSize = 64 * 1024;
 
 PersistentPrefStore::PrefReadError HandleReadErrors(
     const base::Value* value,
@@ -112,8 +132,88 @@ void RecordJsonDataSizeHistogram(const base::FilePath& path, size_t size) {
   histogram->Add(static_cast<int>(size) / 1024);
 }
 
+// Records a sample for |size| in the Settings.JsonPrefStoreCommitBytes.|type|
+// histogram suffixed with the base name of the JSON file under |path|. |type|
+// is "Full" for full writes of the JSON file and "Journal" for journal appends.
+void RecordCommitBytesHistogram(const base::FilePath& path,
+                                const char* type,
+                                size_t size) {
+  std::string spaceless_basename;
+  base::ReplaceChars(path.BaseName().MaybeAsASCII(), " ", "_",
+                     &spaceless_basename);
+
+  // See RecordJsonDataSizeHistogram() above.
+  base::HistogramBase* histogram = base::Histogram::FactoryGet(
+      std::string("Settings.JsonPrefStoreCommitBytes.") + type + "." +
+          spaceless_basename,
+      1, 10 * 1024 * 1024, 50, base::HistogramBase::kUmaTargetedHistogramFlag);
+  histogram->Add(static_cast<int>(size));
+}
+
+// Applies the records of the journal under |journal_path| to |prefs|, in
+// order. Replay stops at the first record which is incomplete (e.g. torn by a
+// crash mid-append) or can't be parsed; returns false in that case.
+bool ReplayJournal(const base::FilePath& journal_path,
+                   base::DictionaryValue* prefs,
+                   size_t* journal_size) {
+  std::string journal;
+  if (!base::ReadFileToString(journal_path, &journal)) {
+    *journal_size = 0;
+    return !base::PathExists(journal_path);
+  }
+  *journal_size = journal.size();
+
+  size_t record_begin = 0;
+  while (record_begin < journal.size()) {
+    size_t record_end = journal.find('\n', record_begin);
+    if (record_end == std::string::npos)
+      return false;
+
+    std::unique_ptr<base::Value> record = base::JSONReader::Read(
+        base::StringPiece(journal).substr(record_begin,
+                                          record_end - record_begin));
+    if (!record || !record->is_dict())
+      return false;
+    const base::Value* key =
+        record->FindKeyOfType(kJournalKeyKey, base::Value::Type::STRING);
+    if (!key)
+      return false;
+    base::Value* value = record->FindKey(kJournalValueKey);
+    if (value) {
+      prefs->Set(key->GetString(),
+                 base::Value::ToUniquePtrValue(std::move(*value)));
+    } else {
+      prefs->RemovePath(key->GetString(), nullptr);
+    }
+
+    record_begin = record_end + 1;
+  }
+  return true;
+}
+
+// Appends |records| to the journal under |journal_path| and flushes it.
+bool AppendToJournal(const base::FilePath& journal_path,
+                     const std::string& records) {
+  base::File journal(journal_path,
+                     base::File::FLAG_OPEN_ALWAYS | base::File::FLAG_APPEND);
+  if (!journal.IsValid())
+    return false;
+  int size = static_cast<int>(records.size());
+  return journal.WriteAtCurrentPos(records.data(), size) == size &&
+         journal.Flush();
+}
+
+// Deletes the journal under |journal_path| once the JSON file was written
+// successfully, since its records are now part of the file.
+void DeleteJournalAfterWrite(const base::FilePath& journal_path,
+                             bool write_success) {
+  if (write_success)
+    base::DeleteFile(journal_path, false);
+}
+
 std::unique_ptr<JsonPrefStore::ReadResult> ReadPrefsFromDisk(
-    const base::FilePath& path) {
+    const base::FilePath& path,
+    const base::FilePath& journal_path) {
   int error_code;
   std::string error_msg;
   std::unique_ptr<JsonPrefStore::ReadResult> read_result(
@@ -124,8 +224,24 @@ std::unique_ptr<JsonPrefStore::ReadResult> ReadPrefsFromDisk(
       HandleReadErrors(read_result->value.get(), path, error_code, error_msg);
   read_result->no_dir = !base::PathExists(path.DirName());
 
-  if (read_result->error == PersistentPrefStore::PREF_READ_ERROR_NONE)
-    RecordJsonDataSizeHistogram(path, deserializer.get_last_read_size());
+  if (read_result->error == PersistentPrefStore::PREF_READ_ERROR_NONE) {
+    read_result->file_size = deserializer.get_last_read_size();
+    RecordJsonDataSizeHistogram(path, read_result->file_size);
+  }
+
+  if (!journal_path.empty()) {
+    if (read_result->error == PersistentPrefStore::PREF_READ_ERROR_NONE) {
+      read_result->journal_intact = ReplayJournal(
+          journal_path,
+          static_cast<base::DictionaryValue*>(read_result->value.get()),
+          &read_result->journal_size);
+    } else {
+      // A journal is only meaningful on top of the JSON file it was written
+      // against.
+      base::DeleteFile(journal_path, false);
+      read_result->journal_intact = false;
+    }
+  }
 
   return read_result;
 }
@@ -222,6 +338,8 @@ void JsonPrefStore::SetValueSilently(const std::string& key,
   prefs_->Get(key, &old_value);
   if (!old_value || !value->Equals(old_value)) {
     prefs_->Set(key, std::move(value));
+    if (journal_enabled_)
+      journal_pending_keys_.insert(key);
     ScheduleWrite(flags);
   }
 }
@@ -238,6 +356,8 @@ void JsonPrefStore::RemoveValueSilently(const std::string& key,
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
   prefs_->RemovePath(key, nullptr);
+  if (journal_enabled_)
+    journal_pending_keys_.insert(key);
   ScheduleWrite(flags);
 }
 
@@ -256,7 +376,7 @@ PersistentPrefStore::PrefReadError JsonPrefStore::GetReadError() const {
 PersistentPrefStore::PrefReadError JsonPrefStore::ReadPrefs() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
-  OnFileRead(ReadPrefsFromDisk(path_));
+  OnFileRead(ReadPrefsFromDisk(path_, journal_path_));
   return filtering_in_progress_ ? PREF_READ_ERROR_ASYNCHRONOUS_TASK_INCOMPLETE
                                 : read_error_;
 }
@@ -269,7 +389,8 @@ void JsonPrefStore::ReadPrefsAsync(ReadErrorDelegate* error_delegate) {
 
   // Weakly binds the read task so that it doesn't kick in during shutdown.
   base::PostTaskAndReplyWithResult(
-      file_task_runner_.get(), FROM_HERE, base::Bind(&ReadPrefsFromDisk, path_),
+      file_task_runner_.get(), FROM_HERE,
+      base::Bind(&ReadPrefsFromDisk, path_, journal_path_),
       base::Bind(&JsonPrefStore::OnFileRead, AsWeakPtr()));
 }
 
@@ -285,6 +406,11 @@ void JsonPrefStore::CommitPendingWrite(
   if (writer_.HasPendingWrite() && !read_only_)
     writer_.DoScheduledWrite();
 
+  if (journal_timer_.IsRunning() && !read_only_) {
+    journal_timer_.Stop();
+    CommitJournal();
+  }
+
   // Since disk operations occur on |file_task_runner_|, the reply of a task
   // posted to |file_task_runner_| will run after currently pending disk
   // operations. Also, by definition of PostTaskAndReply(), the reply (in the
@@ -302,7 +428,12 @@ void JsonPrefStore::CommitPendingWrite(
 }
 
 void JsonPrefStore::SchedulePendingLossyWrites() {
-  if (pending_lossy_write_)
+  if (!pending_lossy_write_)
+    return;
+
+  if (journal_enabled_)
+    ScheduleWrite(DEFAULT_PREF_WRITE_FLAGS);
+  else
     writer_.ScheduleWrite(this);
 }
 
@@ -315,6 +446,8 @@ void JsonPrefStore::ReportValueChanged(const std::string& key, uint32_t flags) {
   for (PrefStore::Observer& observer : observers_)
     observer.OnPrefValueChanged(key);
 
+  if (journal_enabled_)
+    journal_pending_keys_.insert(key);
   ScheduleWrite(flags);
 }
 
@@ -336,10 +469,14 @@ void JsonPrefStore::RunOrScheduleNextSuccessfulWriteCallback(
 
 // static
 void JsonPrefStore::PostWriteCallback(
+    const base::FilePath& journal_path,
     const base::Callback<void(bool success)>& on_next_write_callback,
     const base::Callback<void(bool success)>& on_next_write_reply,
     scoped_refptr<base::SequencedTaskRunner> reply_task_runner,
     bool write_success) {
+  if (!journal_path.empty())
+    DeleteJournalAfterWrite(journal_path, write_success);
+
   if (!on_next_write_callback.is_null())
     on_next_write_callback.Run(write_success);
 
@@ -361,10 +498,12 @@ void JsonPrefStore::RegisterOnNextSuccessfulWriteReply(
   // an empty callback.
   if (!has_pending_write_reply_) {
     has_pending_write_reply_ = true;
+    has_next_write_callbacks_ = true;
     writer_.RegisterOnNextWriteCallbacks(
         base::Closure(),
         base::Bind(
-            &PostWriteCallback, base::Callback<void(bool success)>(),
+            &PostWriteCallback, journal_path_,
+            base::Callback<void(bool success)>(),
             base::Bind(&JsonPrefStore::RunOrScheduleNextSuccessfulWriteCallback,
                        AsWeakPtr()),
             base::SequencedTaskRunnerHandle::Get()));
@@ -376,11 +515,12 @@ void JsonPrefStore::RegisterOnNextWriteSynchronousCallbacks(
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
   has_pending_write_reply_ = true;
+  has_next_write_callbacks_ = true;
 
   writer_.RegisterOnNextWriteCallbacks(
       callbacks.first,
       base::Bind(
-          &PostWriteCallback, callbacks.second,
+          &PostWriteCallback, journal_path_, callbacks.second,
           base::Bind(&JsonPrefStore::RunOrScheduleNextSuccessfulWriteCallback,
                      AsWeakPtr()),
           base::SequencedTaskRunnerHandle::Get()));
@@ -395,6 +535,14 @@ void JsonPrefStore::OnStoreDeletionFromDisk() {
     pref_filter_->OnStoreDeletionFromDisk();
 }
 
+void JsonPrefStore::EnableJournal() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  DCHECK(!initialized_);
+
+  journal_enabled_ = true;
+  journal_path_ = path_.AddExtension(kJournalExtension);
+}
+
 void JsonPrefStore::OnFileRead(std::unique_ptr<ReadResult> read_result) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
@@ -404,6 +552,10 @@ void JsonPrefStore::OnFileRead(std::unique_ptr<ReadResult> read_result) {
       new base::DictionaryValue);
 
   read_error_ = read_result->error;
+  journal_size_ = read_result->journal_size;
+  last_full_write_size_ = read_result->file_size;
+  compaction_required_ =
+      read_error_ != PREF_READ_ERROR_NONE || !read_result->journal_intact;
 
   bool initialization_successful = !read_result->no_dir;
 
@@ -475,6 +627,8 @@ bool JsonPrefStore::SerializeData(std::string* output) {
   serializer.set_pretty_print(false);
   bool success = serializer.Serialize(*prefs_);
   DCHECK(success);
+  if (success)
+    RecordCommitBytesHistogram(path_, "Full", output->size());
   return success;
 }
 
@@ -512,8 +666,84 @@ void JsonPrefStore::ScheduleWrite(uint32_t flags) {
   if (read_only_)
     return;
 
-  if (flags & LOSSY_PREF_WRITE_FLAG)
+  if (flags & LOSSY_PREF_WRITE_FLAG) {
     pending_lossy_write_ = true;
-  else
+  } else if (journal_enabled_) {
+    if (!journal_timer_.IsRunning()) {
+      journal_timer_.Start(FROM_HERE, writer_.commit_interval(),
+                           base::BindOnce(&JsonPrefStore::CommitJournal,
+                                          base::Unretained(this)));
+    }
+  } else {
     writer_.ScheduleWrite(this);
+  }
+}
+
+void JsonPrefStore::CommitJournal() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  DCHECK(journal_enabled_);
+
+  if (ShouldCompactJournal()) {
+    journal_pending_keys_.clear();
+    std::unique_ptr<std::string> data = std::make_unique<std::string>();
+    if (!SerializeData(data.get()))
+      return;
+    last_full_write_size_ = data->size();
+
+    // The journal is deleted right after the JSON file is written, in the same
+    // task, so that a crash in between can't replay it on top of the new file.
+    // Callbacks already registered on |writer_| take care of it.
+    if (!has_next_write_callbacks_) {
+      writer_.RegisterOnNextWriteCallbacks(
+          base::OnceClosure(),
+          base::BindOnce(&DeleteJournalAfterWrite, journal_path_));
+    }
+    writer_.WriteNow(std::move(data));
+    has_next_write_callbacks_ = false;
+    journal_size_ = 0;
+    compaction_required_ = false;
+    return;
+  }
+
+  pending_lossy_write_ = false;
+  if (journal_pending_keys_.empty())
+    return;
+
+  std::string records;
+  for (const std::string& key : journal_pending_keys_) {
+    base::DictionaryValue record;
+    record.SetKey(kJournalKeyKey, base::Value(key));
+    const base::Value* value = nullptr;
+    if (prefs_->Get(key, &value))
+      record.SetKey(kJournalValueKey, value->Clone());
+
+    std::string serialized_record;
+    bool success = base::JSONWriter::Write(record, &serialized_record);
+    DCHECK(success);
+    records += serialized_record;
+    records += '\n';
+  }
+  journal_pending_keys_.clear();
+
+  journal_size_ += records.size();
+  RecordCommitBytesHistogram(path_, "Journal", records.size());
+  base::PostTaskAndReplyWithResult(
+      file_task_runner_.get(), FROM_HERE,
+      base::BindOnce(&AppendToJournal, journal_path_, std::move(records)),
+      base::BindOnce(&JsonPrefStore::OnJournalAppended, AsWeakPtr()));
+}
+
+bool JsonPrefStore::ShouldCompactJournal() const {
+  // Callbacks registered on |writer_| are only run by a full write, and so is
+  // |pref_filter_|'s serialization hook.
+  return compaction_required_ || pref_filter_ || has_pending_write_reply_ ||
+         journal_size_ > std::max(kMinJournalCompactionSize,
+                                  last_full_write_size_);
+}
+
+void JsonPrefStore::OnJournalAppended(bool success) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  if (!success)
+    compaction_required_ = true;
 }
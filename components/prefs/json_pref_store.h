@@ -5,6 +5,7 @@
 #ifndef COMPONENTS_PREFS_JSON_PREF_STORE_H_
 #define COMPONENTS_PREFS_JSON_PREF_STORE_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include <memory>
@@ -21,6 +22,7 @@
 #include "base/observer_list.h"
 #include "base/sequence_checker.h"
 #include "base/task/post_task.h"
+#include "base/timer/timer.h"
 #include "components/prefs/persistent_pref_store.h"
 #include "components/prefs/pref_filter.h"
 #include "components/prefs/prefs_export.h"
@@ -118,6 +120,16 @@ class COMPONENTS_PREFS_EXPORT JsonPrefStore
 
   void OnStoreDeletionFromDisk() override;
 
+  // Switches this store to journaled commits: instead of rewriting the whole
+  // JSON file on every commit, only the prefs changed since the last commit
+  // are appended to a journal file next to it (|pref_filename| with a
+  // ".journal" extension). The journal is replayed on top of the JSON file on
+  // the next read and is folded back into it (compacted) once it grows larger
+  // than the JSON file itself. Must be called before ReadPrefs() or
+  // ReadPrefsAsync(). Stores with a |pref_filter| always perform full writes,
+  // as the filter needs to see the complete dictionary on serialization.
+  void EnableJournal();
+
  private:
   friend class base::JsonPrefStoreCallbackTest;
   friend class base::JsonPrefStoreLossyWriteTest;
@@ -129,10 +141,12 @@ class COMPONENTS_PREFS_EXPORT JsonPrefStore
   // Otherwise, re-registers |on_next_successful_write_|.
   void RunOrScheduleNextSuccessfulWriteCallback(bool write_success);
 
-  // Handles the result of a write with result |write_success|. Runs
+  // Handles the result of a write with result |write_success|. Deletes the
+  // journal under |journal_path|, if any, once the write succeeded, runs
   // |on_next_write_callback| on the current thread and posts
   // |on_next_write_reply| on |reply_task_runner|.
   static void PostWriteCallback(
+      const base::FilePath& journal_path,
       const base::Callback<void(bool success)>& on_next_write_callback,
       const base::Callback<void(bool success)>& on_next_write_reply,
       scoped_refptr<base::SequencedTaskRunner> reply_task_runner,
@@ -169,6 +183,19 @@ class COMPONENTS_PREFS_EXPORT JsonPrefStore
   // WriteablePrefStore::LOSSY_PREF_WRITE_FLAG.
   void ScheduleWrite(uint32_t flags);
 
+  // Commits the changes to the keys in |journal_pending_keys_|, either by
+  // appending them to the journal or, if ShouldCompactJournal(), by writing the
+  // full JSON file and deleting the journal.
+  void CommitJournal();
+
+  // Returns true if the next journaled commit must rewrite the full JSON file.
+  bool ShouldCompactJournal() const;
+
+  // Invoked on the reply of a journal append. A failed append may have left a
+  // partial record behind which would stop replay, so |success| being false
+  // forces the next commit to compact.
+  void OnJournalAppended(bool success);
+
   const base::FilePath path_;
   const scoped_refptr<base::SequencedTaskRunner> file_task_runner_;
 
@@ -194,6 +221,24 @@ class COMPONENTS_PREFS_EXPORT JsonPrefStore
   bool has_pending_write_reply_ = true;
   base::Closure on_next_successful_write_reply_;
 
+  // Whether callbacks are registered on |writer_| for its next write.
+  bool has_next_write_callbacks_ = false;
+
+  // State of the journal, see EnableJournal(). |journal_pending_keys_| holds
+  // the keys changed since the last commit, |journal_size_| the size of the
+  // journal on disk (including appends still in flight) and
+  // |last_full_write_size_| the size of the last full JSON file written or
+  // read. |compaction_required_| is set when the journal on disk can't be
+  // trusted (e.g. it doesn't match the JSON file it was read with) and must be
+  // replaced by a full write.
+  bool journal_enabled_ = false;
+  base::FilePath journal_path_;
+  std::set<std::string> journal_pending_keys_;
+  size_t journal_size_ = 0;
+  size_t last_full_write_size_ = 0;
+  bool compaction_required_ = true;
+  base::OneShotTimer journal_timer_;
+
   SEQUENCE_CHECKER(sequence_checker_);
 
   DISALLOW_COPY_AND_ASSIGN(JsonPrefStore);
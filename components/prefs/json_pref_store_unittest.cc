@@ -538,6 +538,125 @@ TEST_P(JsonPrefStoreTest, ReadAsyncWithInterceptor) {
                             &scoped_task_environment_);
 }
 
+// Tests that journaled commits append only the changed prefs after the first
+// full write and that they are replayed when the store is read back.
+TEST_P(JsonPrefStoreTest, JournalAppendAndReplay) {
+  base::FilePath pref_file = temp_dir_.GetPath().AppendASCII("write.json");
+  base::FilePath journal_file =
+      temp_dir_.GetPath().AppendASCII("write.json.journal");
+
+  {
+    auto pref_store = base::MakeRefCounted<JsonPrefStore>(pref_file);
+    pref_store->EnableJournal();
+    ASSERT_EQ(PersistentPrefStore::PREF_READ_ERROR_NO_FILE,
+              pref_store->ReadPrefs());
+
+    // The first commit has nothing to build a journal on and writes the full
+    // file.
+    pref_store->SetValue("a", std::make_unique<base::Value>(1),
+                         WriteablePrefStore::DEFAULT_PREF_WRITE_FLAGS);
+    pref_store->SetValue("b.c", std::make_unique<base::Value>("x"),
+                         WriteablePrefStore::DEFAULT_PREF_WRITE_FLAGS);
+    CommitPendingWrite(pref_store.get(), GetParam(),
+                       &scoped_task_environment_);
+    ASSERT_TRUE(PathExists(pref_file));
+    EXPECT_FALSE(PathExists(journal_file));
+
+    std::string full_contents;
+    ASSERT_TRUE(base::ReadFileToString(pref_file, &full_contents));
+
+    pref_store->SetValue("a", std::make_unique<base::Value>(2),
+                         WriteablePrefStore::DEFAULT_PREF_WRITE_FLAGS);
+    pref_store->RemoveValue("b.c",
+                            WriteablePrefStore::DEFAULT_PREF_WRITE_FLAGS);
+    CommitPendingWrite(pref_store.get(), GetParam(),
+                       &scoped_task_environment_);
+
+    std::string contents;
+    ASSERT_TRUE(base::ReadFileToString(pref_file, &contents));
+    EXPECT_EQ(full_contents, contents);
+    std::string journal_contents;
+    ASSERT_TRUE(base::ReadFileToString(journal_file, &journal_contents));
+    EXPECT_EQ("{\"k\":\"a\",\"v\":2}\n{\"k\":\"b.c\"}\n", journal_contents);
+  }
+
+  auto pref_store = base::MakeRefCounted<JsonPrefStore>(pref_file);
+  pref_store->EnableJournal();
+  ASSERT_EQ(PersistentPrefStore::PREF_READ_ERROR_NONE,
+            pref_store->ReadPrefs());
+  const base::Value* value = nullptr;
+  ASSERT_TRUE(pref_store->GetValue("a", &value));
+  EXPECT_EQ(base::Value(2), *value);
+  EXPECT_FALSE(pref_store->GetValue("b.c", nullptr));
+}
+
+// Tests that a journal record torn by a crash is dropped on replay, along with
+// anything after it, and that the next commit compacts the journal.
+TEST_P(JsonPrefStoreTest, JournalTornRecord) {
+  base::FilePath pref_file = temp_dir_.GetPath().AppendASCII("write.json");
+  base::FilePath journal_file =
+      temp_dir_.GetPath().AppendASCII("write.json.journal");
+  const char kPrefs[] = "{\"a\":1,\"b\":1}";
+  const char kJournal[] = "{\"k\":\"a\",\"v\":2}\n{\"k\":\"b\",\"v\":";
+  ASSERT_LT(0, base::WriteFile(pref_file, kPrefs, base::size(kPrefs) - 1));
+  ASSERT_LT(0,
+            base::WriteFile(journal_file, kJournal, base::size(kJournal) - 1));
+
+  auto pref_store = base::MakeRefCounted<JsonPrefStore>(pref_file);
+  pref_store->EnableJournal();
+  ASSERT_EQ(PersistentPrefStore::PREF_READ_ERROR_NONE,
+            pref_store->ReadPrefs());
+  const base::Value* value = nullptr;
+  ASSERT_TRUE(pref_store->GetValue("a", &value));
+  EXPECT_EQ(base::Value(2), *value);
+  ASSERT_TRUE(pref_store->GetValue("b", &value));
+  EXPECT_EQ(base::Value(1), *value);
+
+  pref_store->SetValue("c", std::make_unique<base::Value>(3),
+                       WriteablePrefStore::DEFAULT_PREF_WRITE_FLAGS);
+  CommitPendingWrite(pref_store.get(), GetParam(), &scoped_task_environment_);
+
+  EXPECT_FALSE(PathExists(journal_file));
+  std::string contents;
+  ASSERT_TRUE(base::ReadFileToString(pref_file, &contents));
+  EXPECT_EQ("{\"a\":2,\"b\":1,\"c\":3}", contents);
+}
+
+// Tests that the journal is folded back into the JSON file once it outgrows
+// it.
+TEST_P(JsonPrefStoreTest, JournalCompaction) {
+  base::FilePath pref_file = temp_dir_.GetPath().AppendASCII("write.json");
+  base::FilePath journal_file =
+      temp_dir_.GetPath().AppendASCII("write.json.journal");
+
+  auto pref_store = base::MakeRefCounted<JsonPrefStore>(pref_file);
+  pref_store->EnableJournal();
+  ASSERT_EQ(PersistentPrefStore::PREF_READ_ERROR_NO_FILE,
+            pref_store->ReadPrefs());
+  pref_store->SetValue("a", std::make_unique<base::Value>(0),
+                       WriteablePrefStore::DEFAULT_PREF_WRITE_FLAGS);
+  CommitPendingWrite(pref_store.get(), GetParam(), &scoped_task_environment_);
+
+  // Each commit appends a ~1KB record, so the journal crosses the 64KB floor
+  // well before the last one.
+  const std::string kPadding(1024, 'x');
+  bool compacted = false;
+  for (int i = 1; i <= 100 && !compacted; ++i) {
+    pref_store->SetValue("a",
+                         std::make_unique<base::Value>(
+                             kPadding + base::NumberToString(i)),
+                         WriteablePrefStore::DEFAULT_PREF_WRITE_FLAGS);
+    CommitPendingWrite(pref_store.get(), GetParam(),
+                       &scoped_task_environment_);
+    compacted = i > 1 && !PathExists(journal_file);
+  }
+  EXPECT_TRUE(compacted);
+
+  std::string contents;
+  ASSERT_TRUE(base::ReadFileToString(pref_file, &contents));
+  EXPECT_NE(std::string::npos, contents.find(kPadding));
+}
+
 INSTANTIATE_TEST_SUITE_P(
     WithoutCallback,
     JsonPrefStoreTest,
@@ -825,6 +944,7 @@ class JsonPrefStoreCallbackTest : public testing::Test {
 
   void TriggerFakeWriteForCallback(JsonPrefStore* pref_store, bool success) {
     JsonPrefStore::PostWriteCallback(
+        base::FilePath(),
         base::Bind(&JsonPrefStore::RunOrScheduleNextSuccessfulWriteCallback,
                    pref_store->AsWeakPtr()),
         base::Bind(&WriteCallbacksObserver::OnPostWrite,
@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <vector>
 
+#include "base/bits.h"
 #include "base/logging.h"
 #include "base/numerics/safe_math.h"
 #include "base/strings/stringprintf.h"
@@ -181,14 +182,29 @@ V4DecodeResult V4RiceDecoder::GetNextValue(uint32_t* value) {
 
   V4DecodeResult result;
   uint32_t q = 0;
-  uint32_t bit;
-  do {
-    result = GetNextBits(1, &bit);
-    if (result != DECODE_SUCCESS) {
-      return result;
+  // The quotient is unary-coded as a run of one bits ended by a zero bit.
+  // Count the run a word at a time instead of reading it bit by bit.
+  while (true) {
+    if (current_word_bit_index_ == kMaxBitIndex) {
+      result = GetNextWord(&current_word_);
+      if (result != DECODE_SUCCESS) {
+        return result;
+      }
     }
-    q += bit;
-  } while (bit);
+
+    unsigned int num_bits_left_in_current_word =
+        kMaxBitIndex - current_word_bit_index_;
+    // Consumed bits are shifted out of |current_word_|, so the bits above
+    // the unread ones are zero and end the run at the word boundary.
+    unsigned int num_ones = base::bits::CountTrailingZeroBits(~current_word_);
+    if (num_ones < num_bits_left_in_current_word) {
+      q += num_ones;
+      SkipBitsFromCurrentWord(num_ones + 1);
+      break;
+    }
+    q += num_bits_left_in_current_word;
+    SkipBitsFromCurrentWord(num_bits_left_in_current_word);
+  }
   uint32_t r = 0;
   result = GetNextBits(rice_parameter_, &r);
   if (result != DECODE_SUCCESS) {
@@ -275,6 +291,13 @@ uint32_t V4RiceDecoder::GetBitsFromCurrentWord(
   return x;
 }
 
+void V4RiceDecoder::SkipBitsFromCurrentWord(unsigned int num_bits) {
+  DCHECK_LE(num_bits, kMaxBitIndex - current_word_bit_index_);
+  // Shifting a 32-bit value by 32 is undefined, so handle that separately.
+  current_word_ = num_bits < kMaxBitIndex ? current_word_ >> num_bits : 0;
+  current_word_bit_index_ += num_bits;
+}
+
 std::string V4RiceDecoder::DebugString() const {
   // Calculates the total number of bits that we have read from the buffer,
   // excluding those that have been read into current_word_ but not yet
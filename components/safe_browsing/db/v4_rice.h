@@ -132,6 +132,9 @@ class V4RiceDecoder {
   // Reads |num_requested_bits| from |current_word_|.
   uint32_t GetBitsFromCurrentWord(unsigned int num_requested_bits);
 
+  // Discards the next |num_bits| bits of |current_word_|.
+  void SkipBitsFromCurrentWord(unsigned int num_bits);
+
   // The Rice parameter, which is the exponent of two for calculating 'M'. 'M'
   // is used as the base to calculate the quotient and remainder in the
   // algorithm.
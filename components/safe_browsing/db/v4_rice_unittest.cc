@@ -153,6 +153,21 @@ TEST_F(V4RiceTest, TestDecoderGetNextValueWithInterestingValues) {
   }
 }
 
+TEST_F(V4RiceTest, TestDecoderGetNextValueWithLongQuotients) {
+  std::vector<RiceDecodingTestInfo> test_inputs = {
+      // A quotient of 40 spans more than one 32-bit word: 40 one bits, a zero
+      // bit, and a remainder of 3.
+      RiceDecodingTestInfo(2, {163}, "\xff\xff\xff\xff\xff\x06"),
+      // A quotient of 31 ends on the last bit of the first word.
+      RiceDecodingTestInfo(2, {125, 1}, "\xff\xff\xff\x7f\x09"),
+  };
+
+  for (size_t i = 0; i < test_inputs.size(); i++) {
+    DVLOG(1) << "Running test case: " << i;
+    VerifyRiceDecoding(test_inputs[i]);
+  }
+}
+
 #if defined(NDEBUG) && !defined(DCHECK_ALWAYS_ON)
 // This test hits a NOTREACHED so it is a release mode only test.
 TEST_F(V4RiceTest, TestDecoderIntegersWithNoData) {
@@ -4,6 +4,8 @@
 
 #include "components/safe_browsing/db/v4_store.h"
 
+#include <string.h>
+
 #include <algorithm>
 #include <utility>
 
@@ -14,7 +16,6 @@
 #include "base/metrics/histogram_macros.h"
 #include "base/stl_util.h"
 #include "base/strings/stringprintf.h"
-#include "components/safe_browsing/db/prefix_iterator.h"
 #include "components/safe_browsing/db/v4_rice.h"
 #include "components/safe_browsing/db/v4_store.pb.h"
 #include "components/safe_browsing/proto/webui.pb.h"
@@ -802,9 +803,24 @@ HashPrefix V4Store::GetMatchingHashPrefix(base::StringPiece full_hash) {
 bool V4Store::HashPrefixMatches(base::StringPiece prefix,
                                 const HashPrefixes& prefixes,
                                 const PrefixSize& size) {
-  return std::binary_search(
-      PrefixIterator(prefixes, 0, size),
-      PrefixIterator(prefixes, prefixes.size() / size, size), prefix);
+  if (prefix.size() != size)
+    return false;
+
+  // Lower-bound search over the fixed-width prefixes, comparing raw bytes in
+  // place rather than through iterators and StringPiece temporaries. There is
+  // no early exit, so the loop body reduces to selects the compiler can make
+  // branchless.
+  const char* data = prefixes.data();
+  size_t low = 0;
+  size_t count = prefixes.size() / size;
+  while (count > 0) {
+    size_t half = count / 2;
+    bool is_less = memcmp(data + (low + half) * size, prefix.data(), size) < 0;
+    low = is_less ? low + half + 1 : low;
+    count = is_less ? count - half - 1 : half;
+  }
+  return low < prefixes.size() / size &&
+         memcmp(data + low * size, prefix.data(), size) == 0;
 }
 
 bool V4Store::VerifyChecksum() {
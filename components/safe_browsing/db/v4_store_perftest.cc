@@ -66,4 +66,46 @@ TEST_F(V4StorePerftest, StressTest) {
   EXPECT_EQ(kNumPrefixes, matches);
 }
 
+// Most lookups in practice miss the store, so measure that case separately.
+TEST_F(V4StorePerftest, StressTestMisses) {
+#if defined(NDEBUG)
+  const size_t kNumPrefixes = 2000000;
+#else
+  const size_t kNumPrefixes = 20000;
+#endif
+
+  CHECK(base::IsValidForType<size_t>(
+      base::CheckMul(kNumPrefixes, kMaxHashPrefixLength)));
+
+  std::string full_hashes(kNumPrefixes * kMaxHashPrefixLength, 0);
+  base::StringPiece full_hashes_piece = base::StringPiece(full_hashes);
+  std::vector<std::string> prefixes;
+  for (size_t i = 0; i < kNumPrefixes; i++) {
+    size_t index = i * kMaxHashPrefixLength;
+    std::string stored_hash = crypto::SHA256HashString(
+        base::StringPrintf("stored_%zu", i));
+    prefixes.push_back(stored_hash.substr(0, kMinHashPrefixLength));
+    crypto::SHA256HashString(base::StringPrintf("lookup_%zu", i),
+                             &full_hashes[index], kMaxHashPrefixLength);
+  }
+
+  auto store = std::make_unique<TestV4Store>(
+      base::MakeRefCounted<base::TestSimpleTaskRunner>(), base::FilePath());
+  store->SetPrefixes(std::move(prefixes), kMinHashPrefixLength);
+
+  size_t matches = 0;
+  base::ElapsedTimer timer;
+  for (size_t i = 0; i < kNumPrefixes; i++) {
+    size_t index = i * kMaxHashPrefixLength;
+    base::StringPiece full_hash =
+        full_hashes_piece.substr(index, kMaxHashPrefixLength);
+    matches += !store->GetMatchingHashPrefix(full_hash).empty();
+  }
+  perf_test::PrintResult("GetMatchingHashPrefixMisses", "", "",
+                         timer.Elapsed().InMillisecondsF(), "ms", true);
+
+  // Random 4-byte prefixes occasionally collide; nearly all lookups miss.
+  EXPECT_LT(matches, kNumPrefixes / 100);
+}
+
 }  // namespace safe_browsing
@@ -625,6 +625,12 @@ TEST_F(V4StoreTest, TestHashPrefixDoesNotExistInConcatenatedList) {
   EXPECT_FALSE(V4Store::HashPrefixMatches(hash_prefix, hash_prefixes, 5));
 }
 
+TEST_F(V4StoreTest, TestHashPrefixOfDifferentSizeDoesNotMatch) {
+  HashPrefixes hash_prefixes = "abcdebbbbb";
+  HashPrefix hash_prefix = "abcd";
+  EXPECT_FALSE(V4Store::HashPrefixMatches(hash_prefix, hash_prefixes, 5));
+}
+
 TEST_F(V4StoreTest, TestFullHashExistsInMapWithSingleSize) {
   V4Store store(task_runner_, store_path_);
   store.hash_prefix_map_[32] =
@@ -6,6 +6,7 @@
 
 #include <stdint.h>
 #include <limits>
+#include <string>
 #include <utility>
 
 #include "base/files/file.h"
@@ -192,7 +193,11 @@ static const char* kCurrentSessionFileName = "Current Session";
 static const char* kLastSessionFileName = "Last Session";
 
 // static
-const int SessionBackend::kFileReadBufferSize = 1024;
+const int SessionBackend::kFileReadBufferSize = 16 * 1024;
+
+// Commands are serialized into a buffer of about this size before being
+// written, so that a batch of commands does not cost one write per field.
+static const size_t kFileWriteBufferSize = 16 * 1024;
 
 SessionBackend::SessionBackend(sessions::BaseSessionService::SessionType type,
                                const base::FilePath& path_to_dir)
@@ -287,32 +292,34 @@ bool SessionBackend::ReadCurrentSessionCommandsImpl(
 bool SessionBackend::AppendCommandsToFile(
     base::File* file,
     const std::vector<std::unique_ptr<sessions::SessionCommand>>& commands) {
-  for (auto i = commands.begin(); i != commands.end(); ++i) {
-    int wrote;
-    const size_type content_size = static_cast<size_type>((*i)->size());
-    const size_type total_size =  content_size + sizeof(id_type);
-    wrote = file->WriteAtCurrentPos(reinterpret_cast<const char*>(&total_size),
-                                    sizeof(total_size));
-    if (wrote != sizeof(total_size)) {
-      NOTREACHED() << "error writing";
-      return false;
-    }
-    id_type command_id = (*i)->id();
-    wrote = file->WriteAtCurrentPos(reinterpret_cast<char*>(&command_id),
-                                    sizeof(command_id));
-    if (wrote != sizeof(command_id)) {
+  std::string buffer;
+  auto write_buffer = [file, &buffer]() {
+    const int size = static_cast<int>(buffer.size());
+    if (file->WriteAtCurrentPos(buffer.data(), size) != size) {
       NOTREACHED() << "error writing";
       return false;
     }
+    buffer.clear();
+    return true;
+  };
+
+  for (auto i = commands.begin(); i != commands.end(); ++i) {
+    const size_type content_size = static_cast<size_type>((*i)->size());
+    const size_type total_size = content_size + sizeof(id_type);
+    buffer.append(reinterpret_cast<const char*>(&total_size),
+                  sizeof(total_size));
+    const id_type command_id = (*i)->id();
+    buffer.append(reinterpret_cast<const char*>(&command_id),
+                  sizeof(command_id));
     if (content_size > 0) {
-      wrote = file->WriteAtCurrentPos(reinterpret_cast<char*>((*i)->contents()),
-                                      content_size);
-      if (wrote != content_size) {
-        NOTREACHED() << "error writing";
-        return false;
-      }
+      buffer.append(reinterpret_cast<const char*>((*i)->contents()),
+                    content_size);
     }
+    if (buffer.size() >= kFileWriteBufferSize && !write_buffer())
+      return false;
   }
+  if (!buffer.empty() && !write_buffer())
+    return false;
 #if defined(OS_CHROMEOS)
   file->Flush();
 #endif
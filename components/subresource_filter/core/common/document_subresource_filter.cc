@@ -17,13 +17,22 @@
 
 namespace subresource_filter {
 
+namespace {
+
+// Bounds the memory held by the per-document match cache.
+constexpr size_t kMatchCacheSize = 256;
+constexpr size_t kMaxCachedUrlLength = 2048;
+
+}  // namespace
+
 DocumentSubresourceFilter::DocumentSubresourceFilter(
     url::Origin document_origin,
     mojom::ActivationState activation_state,
     scoped_refptr<const MemoryMappedRuleset> ruleset)
     : activation_state_(activation_state),
       ruleset_(std::move(ruleset)),
-      ruleset_matcher_(ruleset_->data(), ruleset_->length()) {
+      ruleset_matcher_(ruleset_->data(), ruleset_->length()),
+      match_cache_(kMatchCacheSize) {
   DCHECK_NE(activation_state_.activation_level,
             mojom::ActivationLevel::kDisabled);
   if (!activation_state_.filtering_disabled_for_document)
@@ -65,9 +74,7 @@ LoadPolicy DocumentSubresourceFilter::GetLoadPolicy(
 
   ++statistics_.num_loads_evaluated;
   DCHECK(document_origin_);
-  if (ruleset_matcher_.ShouldDisallowResourceLoad(
-          subresource_url, *document_origin_, subresource_type,
-          activation_state_.generic_blocking_rules_disabled)) {
+  if (ShouldDisallowResourceLoad(subresource_url, subresource_type)) {
     ++statistics_.num_loads_matching_rules;
     if (activation_state_.activation_level ==
         mojom::ActivationLevel::kEnabled) {
@@ -81,6 +88,28 @@ LoadPolicy DocumentSubresourceFilter::GetLoadPolicy(
   return LoadPolicy::ALLOW;
 }
 
+bool DocumentSubresourceFilter::ShouldDisallowResourceLoad(
+    const GURL& subresource_url,
+    url_pattern_index::proto::ElementType subresource_type) {
+  const std::string& spec = subresource_url.possibly_invalid_spec();
+  if (spec.size() > kMaxCachedUrlLength) {
+    return ruleset_matcher_.ShouldDisallowResourceLoad(
+        subresource_url, *document_origin_, subresource_type,
+        activation_state_.generic_blocking_rules_disabled);
+  }
+
+  auto key = std::make_pair(spec, subresource_type);
+  auto it = match_cache_.Get(key);
+  if (it != match_cache_.end())
+    return it->second;
+
+  bool disallow = ruleset_matcher_.ShouldDisallowResourceLoad(
+      subresource_url, *document_origin_, subresource_type,
+      activation_state_.generic_blocking_rules_disabled);
+  match_cache_.Put(std::move(key), disallow);
+  return disallow;
+}
+
 const url_pattern_index::flat::UrlRule*
 DocumentSubresourceFilter::FindMatchingUrlRule(
     const GURL& subresource_url,
@@ -8,8 +8,11 @@
 #include <stddef.h>
 
 #include <memory>
+#include <string>
+#include <utility>
 #include <vector>
 
+#include "base/containers/mru_cache.h"
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
 #include "components/subresource_filter/core/common/indexed_ruleset.h"
@@ -68,9 +71,16 @@ class DocumentSubresourceFilter {
   // subresources.
   void set_activation_state(const mojom::ActivationState& state) {
     activation_state_ = state;
+    match_cache_.Clear();
   }
 
  private:
+  // Returns whether |subresource_url| is disallowed by the ruleset, consulting
+  // |match_cache_| first.
+  bool ShouldDisallowResourceLoad(
+      const GURL& subresource_url,
+      url_pattern_index::proto::ElementType subresource_type);
+
   mojom::ActivationState activation_state_;
   const scoped_refptr<const MemoryMappedRuleset> ruleset_;
   const IndexedRulesetMatcher ruleset_matcher_;
@@ -80,6 +90,14 @@ class DocumentSubresourceFilter {
 
   mojom::DocumentLoadStatistics statistics_;
 
+  // Ruleset match results for recently evaluated (URL spec, element type)
+  // pairs. Documents often load the same URL many times, and the result only
+  // depends on inputs that are fixed for this filter between calls to
+  // set_activation_state().
+  base::MRUCache<std::pair<std::string, url_pattern_index::proto::ElementType>,
+                 bool>
+      match_cache_;
+
   DISALLOW_COPY_AND_ASSIGN(DocumentSubresourceFilter);
 };
 
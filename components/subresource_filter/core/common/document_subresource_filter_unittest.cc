@@ -152,6 +152,28 @@ TEST_F(DocumentSubresourceFilterTest, Enabled) {
   test_impl(false /* measure_performance */);
 }
 
+TEST_F(DocumentSubresourceFilterTest, RepeatedLoadsAndActivationChange) {
+  mojom::ActivationState activation_state;
+  activation_state.activation_level = kEnabled;
+  DocumentSubresourceFilter filter(url::Origin(), activation_state, ruleset());
+
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(LoadPolicy::DISALLOW,
+              filter.GetLoadPolicy(GURL(kTestAlphaURL), kImageType));
+    EXPECT_EQ(LoadPolicy::ALLOW,
+              filter.GetLoadPolicy(GURL(kTestBetaURL), kImageType));
+  }
+  EXPECT_EQ(6, filter.statistics().num_loads_evaluated);
+  EXPECT_EQ(3, filter.statistics().num_loads_matching_rules);
+
+  // The test rule is generic, so disabling generic blocking rules must not
+  // return a result remembered from before the change.
+  activation_state.generic_blocking_rules_disabled = true;
+  filter.set_activation_state(activation_state);
+  EXPECT_EQ(LoadPolicy::ALLOW,
+            filter.GetLoadPolicy(GURL(kTestAlphaURL), kImageType));
+}
+
 TEST_F(DocumentSubresourceFilterTest, MatchingRuleEnabled) {
   mojom::ActivationState activation_state;
   activation_state.activation_level = kEnabled;
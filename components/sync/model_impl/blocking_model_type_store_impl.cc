@@ -80,9 +80,11 @@ class LevelDbMetadataChangeList : public MetadataChangeList {
   }
 
  private:
-  // Format key for metadata records with given id.
-  std::string FormatMetadataKey(const std::string& id) const {
-    return metadata_prefix_ + id;
+  // Format key for metadata records with given id. The returned reference is
+  // only valid until the next call; the write batch copies the key.
+  const std::string& FormatMetadataKey(const std::string& id) {
+    key_buffer_.assign(metadata_prefix_).append(id);
+    return key_buffer_;
   }
 
   leveldb::WriteBatch* const leveldb_write_batch_;
@@ -91,6 +93,9 @@ class LevelDbMetadataChangeList : public MetadataChangeList {
   const std::string metadata_prefix_;
   const std::string global_metadata_key_;
 
+  // Reused across calls to avoid allocating a new key for every record.
+  std::string key_buffer_;
+
   SEQUENCE_CHECKER(sequence_checker_);
 };
 
@@ -128,9 +133,11 @@ class LevelDbWriteBatch : public BlockingModelTypeStoreImpl::WriteBatch {
   }
 
  private:
-  // Format key for data records with given id.
-  std::string FormatDataKey(const std::string& id) const {
-    return data_prefix_ + id;
+  // Format key for data records with given id. The returned reference is
+  // only valid until the next call; the write batch copies the key.
+  const std::string& FormatDataKey(const std::string& id) {
+    key_buffer_.assign(data_prefix_).append(id);
+    return key_buffer_;
   }
 
   const ModelType type_;
@@ -138,6 +145,9 @@ class LevelDbWriteBatch : public BlockingModelTypeStoreImpl::WriteBatch {
   // Key prefix for data records of this model type.
   const std::string data_prefix_;
 
+  // Reused across calls to avoid allocating a new key for every record.
+  std::string key_buffer_;
+
   std::unique_ptr<leveldb::WriteBatch> leveldb_write_batch_;
   LevelDbMetadataChangeList metadata_change_list_;
 
@@ -162,7 +162,7 @@ base::Optional<ModelError> ModelTypeStoreBackend::ReadRecordsWithPrefix(
   std::string key;
   std::string value;
   for (const std::string& id : id_list) {
-    key = prefix + id;
+    key.assign(prefix).append(id);
     leveldb::Status status = db_->Get(read_options, key, &value);
     if (status.ok()) {
       record_list->emplace_back(id, value);
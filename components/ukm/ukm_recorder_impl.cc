@@ -572,6 +572,18 @@ void UkmRecorderImpl::AddEntry(mojom::UkmEntryPtr entry) {
     return;
   }
 
+  // Decide whether the entry is kept before updating the aggregates so that
+  // each metric's aggregate is looked up only once, even for dropped entries.
+  DroppedDataReason dropped_reason = DroppedDataReason::NOT_DROPPED;
+  if (ShouldRestrictToWhitelistedEntries() &&
+      !base::ContainsKey(whitelisted_entry_hashes_, entry->event_hash)) {
+    dropped_reason = DroppedDataReason::NOT_WHITELISTED;
+  } else if (!IsEntrySampledIn(*entry)) {
+    dropped_reason = DroppedDataReason::SAMPLED_OUT;
+  } else if (recordings_.entries.size() >= GetMaxEntries()) {
+    dropped_reason = DroppedDataReason::MAX_HIT;
+  }
+
   EventAggregate& event_aggregate =
       recordings_.event_aggregations[entry->event_hash];
   event_aggregate.total_count++;
@@ -581,24 +593,50 @@ void UkmRecorderImpl::AddEntry(mojom::UkmEntryPtr entry) {
     aggregate.total_count++;
     aggregate.value_sum += value;
     aggregate.value_square_sum += value * value;
+    switch (dropped_reason) {
+      case DroppedDataReason::NOT_WHITELISTED:
+        aggregate.dropped_due_to_whitelist++;
+        break;
+      case DroppedDataReason::SAMPLED_OUT:
+        aggregate.dropped_due_to_sampling++;
+        break;
+      case DroppedDataReason::MAX_HIT:
+        aggregate.dropped_due_to_limits++;
+        break;
+      default:
+        break;
+    }
   }
 
-  if (ShouldRestrictToWhitelistedEntries() &&
-      !base::ContainsKey(whitelisted_entry_hashes_, entry->event_hash)) {
-    RecordDroppedEntry(DroppedDataReason::NOT_WHITELISTED);
-    event_aggregate.dropped_due_to_whitelist++;
-    for (auto& metric : entry->metrics)
-      event_aggregate.metrics[metric.first].dropped_due_to_whitelist++;
+  switch (dropped_reason) {
+    case DroppedDataReason::NOT_WHITELISTED:
+      event_aggregate.dropped_due_to_whitelist++;
+      break;
+    case DroppedDataReason::SAMPLED_OUT:
+      event_aggregate.dropped_due_to_sampling++;
+      break;
+    case DroppedDataReason::MAX_HIT:
+      event_aggregate.dropped_due_to_limits++;
+      break;
+    default:
+      break;
+  }
+  if (dropped_reason != DroppedDataReason::NOT_DROPPED) {
+    RecordDroppedEntry(dropped_reason);
     return;
   }
 
+  recordings_.entries.push_back(std::move(entry));
+}
+
+bool UkmRecorderImpl::IsEntrySampledIn(const mojom::UkmEntry& entry) {
   if (default_sampling_rate_ == 0)
     LoadExperimentSamplingInfo();
 
   bool sampled_in = true;  // Overwritten by Find(...) if it returns True.
-  PageSampling* page_sampling = &source_event_sampling_[entry->source_id];
-  if (!page_sampling->Find(entry->event_hash, &sampled_in)) {
-    auto found = event_sampling_rates_.find(entry->event_hash);
+  PageSampling* page_sampling = &source_event_sampling_[entry.source_id];
+  if (!page_sampling->Find(entry.event_hash, &sampled_in)) {
+    auto found = event_sampling_rates_.find(entry.event_hash);
     int sampling_rate = (found != event_sampling_rates_.end())
                             ? found->second
                             : default_sampling_rate_;
@@ -607,26 +645,10 @@ void UkmRecorderImpl::AddEntry(mojom::UkmEntryPtr entry) {
     // Remember the decision for this event for this page so all such events
     // on this page are sampled-in or sampled-out together making it possible
     // to correlate between events and within a page.
-    page_sampling->Set(entry->event_hash, sampled_in);
-  }
-
-  if (!sampled_in && sampling_enabled_) {
-    RecordDroppedEntry(DroppedDataReason::SAMPLED_OUT);
-    event_aggregate.dropped_due_to_sampling++;
-    for (auto& metric : entry->metrics)
-      event_aggregate.metrics[metric.first].dropped_due_to_sampling++;
-    return;
+    page_sampling->Set(entry.event_hash, sampled_in);
   }
 
-  if (recordings_.entries.size() >= GetMaxEntries()) {
-    RecordDroppedEntry(DroppedDataReason::MAX_HIT);
-    event_aggregate.dropped_due_to_limits++;
-    for (auto& metric : entry->metrics)
-      event_aggregate.metrics[metric.first].dropped_due_to_limits++;
-    return;
-  }
-
-  recordings_.entries.push_back(std::move(entry));
+  return sampled_in || !sampling_enabled_;
 }
 
 void UkmRecorderImpl::LoadExperimentSamplingInfo() {
@@ -179,6 +179,11 @@ class UkmRecorderImpl : public UkmRecorder {
   // Load sampling configurations from field-trial information.
   void LoadExperimentSamplingInfo();
 
+  // Returns true if |entry| should be kept under the per-page sampling
+  // decision for its event, making that decision if this is the first such
+  // event on the page.
+  bool IsEntrySampledIn(const mojom::UkmEntry& entry);
+
   // Whether recording new data is currently allowed.
   bool recording_enabled_ = false;
 
@@ -94,7 +94,7 @@ void DeltaUpdateOp::Run(const base::DictionaryValue* command_args,
 }
 
 void DeltaUpdateOp::DoneRunning(UnpackerError error, int extended_error) {
-  if (error == UnpackerError::kNone)
+  if (error == UnpackerError::kNone && !output_hash_verified_)
     error = CheckHash();
   base::SequencedTaskRunnerHandle::Get()->PostTask(
       FROM_HERE, base::BindOnce(std::move(callback_), error, extended_error));
@@ -129,10 +129,19 @@ UnpackerError DeltaUpdateOpCopy::DoParseArguments(
 }
 
 void DeltaUpdateOpCopy::DoRun(ComponentPatcher::Callback callback) {
-  if (!base::CopyFile(input_abs_path_, output_abs_path_))
+  // The output is a byte-for-byte copy of the input, so hash the installed
+  // file once up front instead of reading the copy back afterwards. This also
+  // avoids writing a copy that would fail verification.
+  if (!VerifyFileHash256(input_abs_path_, output_sha256_)) {
+    std::move(callback).Run(UnpackerError::kDeltaVerificationFailure, 0);
+    return;
+  }
+  if (!base::CopyFile(input_abs_path_, output_abs_path_)) {
     std::move(callback).Run(UnpackerError::kDeltaOperationFailure, 0);
-  else
-    std::move(callback).Run(UnpackerError::kNone, 0);
+    return;
+  }
+  output_hash_verified_ = true;
+  std::move(callback).Run(UnpackerError::kNone, 0);
 }
 
 DeltaUpdateOpCreate::DeltaUpdateOpCreate() {
@@ -51,6 +51,10 @@ class DeltaUpdateOp : public base::RefCountedThreadSafe<DeltaUpdateOp> {
   std::string output_sha256_;
   base::FilePath output_abs_path_;
 
+  // Set by subclasses that have already verified that the output matches
+  // |output_sha256_|, so DoneRunning() does not read the output back.
+  bool output_hash_verified_ = false;
+
  private:
   friend class base::RefCountedThreadSafe<DeltaUpdateOp>;
 
@@ -133,6 +133,34 @@ TEST_F(ComponentPatcherOperationTest, CheckCopyOperation) {
       test_file("binary_output.bin")));
 }
 
+// Verify that a 'copy' delta update operation of an installed file that does
+// not match the expected hash fails without writing the output.
+TEST_F(ComponentPatcherOperationTest, CheckCopyOperationHashMismatch) {
+  EXPECT_TRUE(base::CopyFile(
+      test_file("binary_input.bin"),
+      installed_dir_.GetPath().Append(FILE_PATH_LITERAL("binary_output.bin"))));
+
+  std::unique_ptr<base::DictionaryValue> command_args =
+      std::make_unique<base::DictionaryValue>();
+  command_args->SetString("output", "output.bin");
+  command_args->SetString("sha256", binary_output_hash);
+  command_args->SetString("op", "copy");
+  command_args->SetString("input", "binary_output.bin");
+
+  TestCallback callback;
+  scoped_refptr<DeltaUpdateOp> op = base::MakeRefCounted<DeltaUpdateOpCopy>();
+  op->Run(command_args.get(), input_dir_.GetPath(), unpack_dir_.GetPath(),
+          installer_.get(),
+          base::BindOnce(&TestCallback::Set, base::Unretained(&callback)));
+  scoped_task_environment_.RunUntilIdle();
+
+  EXPECT_EQ(true, callback.called_);
+  EXPECT_EQ(UnpackerError::kDeltaVerificationFailure, callback.error_);
+  EXPECT_EQ(0, callback.extra_code_);
+  EXPECT_FALSE(base::PathExists(
+      unpack_dir_.GetPath().Append(FILE_PATH_LITERAL("output.bin"))));
+}
+
 // Verify that a 'courgette' delta update operation works correctly.
 TEST_F(ComponentPatcherOperationTest, CheckCourgetteOperation) {
   EXPECT_TRUE(base::CopyFile(
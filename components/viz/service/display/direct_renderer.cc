@@ -80,6 +80,12 @@ namespace viz {
 DirectRenderer::DrawingFrame::DrawingFrame() = default;
 DirectRenderer::DrawingFrame::~DrawingFrame() = default;
 
+DirectRenderer::CachedBspTree::CachedBspTree() = default;
+DirectRenderer::CachedBspTree::CachedBspTree(CachedBspTree&& other) = default;
+DirectRenderer::CachedBspTree::~CachedBspTree() = default;
+DirectRenderer::CachedBspTree& DirectRenderer::CachedBspTree::operator=(
+    CachedBspTree&& other) = default;
+
 DirectRenderer::DirectRenderer(const RendererSettings* settings,
                                OutputSurface* output_surface,
                                DisplayResourceProvider* resource_provider)
@@ -417,6 +423,16 @@ void DirectRenderer::DrawFrame(RenderPassList* render_passes_in_draw_order,
   render_pass_backdrop_filters_.clear();
   render_pass_backdrop_filter_bounds_.clear();
 
+  // Drop the BSP trees of sorting contexts that were not drawn this frame.
+  for (auto it = cached_bsp_trees_.begin(); it != cached_bsp_trees_.end();) {
+    if (it->second.used_this_frame) {
+      it->second.used_this_frame = false;
+      ++it;
+    } else {
+      it = cached_bsp_trees_.erase(it);
+    }
+  }
+
   current_frame_valid_ = false;
 }
 
@@ -517,16 +533,47 @@ const gfx::RRectF* DirectRenderer::BackgroundFilterBoundsForPass(
 
 void DirectRenderer::FlushPolygons(
     base::circular_deque<std::unique_ptr<DrawPolygon>>* poly_list,
+    int sorting_context_id,
     const gfx::Rect& render_pass_scissor,
     bool use_render_pass_scissor) {
   if (poly_list->empty()) {
     return;
   }
 
-  BspTree bsp_tree(poly_list);
+  std::vector<std::pair<gfx::Transform, gfx::Rect>> polygon_geometry;
+  polygon_geometry.reserve(poly_list->size());
+  for (const auto& polygon : *poly_list) {
+    const DrawQuad* quad = polygon->original_ref();
+    polygon_geometry.emplace_back(
+        quad->shared_quad_state->quad_to_target_transform, quad->visible_rect);
+  }
+
   BspWalkActionDrawPolygon action_handler(this, render_pass_scissor,
                                           use_render_pass_scissor);
-  bsp_tree.TraverseWithActionHandler(&action_handler);
+  CachedBspTree& cached = cached_bsp_trees_[std::make_pair(
+      current_frame()->current_render_pass->id, sorting_context_id)];
+  cached.used_this_frame = true;
+  if (cached.tree && cached.polygon_geometry == polygon_geometry) {
+    // The polygons split and sort the same way as last frame, so only point
+    // the tree's polygons at this frame's quads.
+    base::flat_map<int, const DrawQuad*> quads_by_order_index;
+    for (size_t i = 0; i < poly_list->size(); ++i) {
+      quads_by_order_index.emplace(cached.order_indices[i],
+                                   (*poly_list)[i]->original_ref());
+    }
+    auto update_quad = [&quads_by_order_index](DrawPolygon* polygon) {
+      polygon->set_original_ref(quads_by_order_index[polygon->order_index()]);
+    };
+    cached.tree->TraverseWithActionHandler(&update_quad);
+    poly_list->clear();
+  } else {
+    cached.polygon_geometry = std::move(polygon_geometry);
+    cached.order_indices.clear();
+    for (const auto& polygon : *poly_list)
+      cached.order_indices.push_back(polygon->order_index());
+    cached.tree = std::make_unique<BspTree>(poly_list);
+  }
+  cached.tree->TraverseWithActionHandler(&action_handler);
   DCHECK(poly_list->empty());
 }
 
@@ -653,9 +700,10 @@ void DirectRenderer::DrawRenderPass(const RenderPass* render_pass) {
     }
 
     if (last_sorting_context_id != quad.shared_quad_state->sorting_context_id) {
-      last_sorting_context_id = quad.shared_quad_state->sorting_context_id;
-      FlushPolygons(&poly_list, render_pass_scissor_in_draw_space,
+      FlushPolygons(&poly_list, last_sorting_context_id,
+                    render_pass_scissor_in_draw_space,
                     render_pass_requires_scissor);
+      last_sorting_context_id = quad.shared_quad_state->sorting_context_id;
     }
 
     // This layer is in a 3D sorting context so we add it to the list of
@@ -678,7 +726,8 @@ void DirectRenderer::DrawRenderPass(const RenderPass* render_pass) {
 
     DoDrawQuad(&quad, nullptr);
   }
-  FlushPolygons(&poly_list, render_pass_scissor_in_draw_space,
+  FlushPolygons(&poly_list, last_sorting_context_id,
+                render_pass_scissor_in_draw_space,
                 render_pass_requires_scissor);
   FinishDrawingQuadList();
 
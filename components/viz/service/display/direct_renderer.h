@@ -6,6 +6,7 @@
 #define COMPONENTS_VIZ_SERVICE_DISPLAY_DIRECT_RENDERER_H_
 
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "base/callback.h"
@@ -21,6 +22,7 @@
 #include "gpu/command_buffer/common/texture_in_use_response.h"
 #include "ui/gfx/geometry/quad_f.h"
 #include "ui/gfx/geometry/rect.h"
+#include "ui/gfx/transform.h"
 #include "ui/latency/latency_info.h"
 
 namespace cc {
@@ -33,6 +35,7 @@ class RRectF;
 }  // namespace gfx
 
 namespace viz {
+class BspTree;
 class BspWalkActionDrawPolygon;
 class DrawPolygon;
 class OutputSurface;
@@ -140,6 +143,7 @@ class VIZ_SERVICE_EXPORT DirectRenderer {
 
   void FlushPolygons(
       base::circular_deque<std::unique_ptr<DrawPolygon>>* poly_list,
+      int sorting_context_id,
       const gfx::Rect& render_pass_scissor,
       bool use_render_pass_scissor);
   void DrawRenderPassAndExecuteCopyRequests(RenderPass* render_pass);
@@ -236,6 +240,27 @@ class VIZ_SERVICE_EXPORT DirectRenderer {
   // RenderPass.
   base::flat_map<RenderPassId, TileDrawQuad> render_pass_bypass_quads_;
 
+  // The BSP tree built for a 3D sorting context, which is drawn again for the
+  // next frame if the polygons given to the context keep their geometry.
+  struct CachedBspTree {
+    CachedBspTree();
+    CachedBspTree(CachedBspTree&& other);
+    ~CachedBspTree();
+    CachedBspTree& operator=(CachedBspTree&& other);
+
+    // The transform and visible rect of the quad of each polygon the tree was
+    // built from, and the order index of the polygon.
+    std::vector<std::pair<gfx::Transform, gfx::Rect>> polygon_geometry;
+    std::vector<int> order_indices;
+    std::unique_ptr<BspTree> tree;
+    bool used_this_frame = true;
+  };
+  // A map from RenderPass and sorting context ids to the BSP tree last drawn
+  // for the sorting context. Entries are removed when a frame doesn't use
+  // them.
+  base::flat_map<std::pair<RenderPassId, int>, CachedBspTree>
+      cached_bsp_trees_;
+
   // A map from RenderPass id to the filters used when drawing the RenderPass.
   base::flat_map<RenderPassId, cc::FilterOperations*> render_pass_filters_;
   base::flat_map<RenderPassId, cc::FilterOperations*>
@@ -517,6 +517,10 @@ bool Display::DrawAndSwap() {
     }
   }
 
+  // The renderer is done with the passes, so hand them back to be reused by the
+  // next aggregation.
+  aggregator_->RecycleRenderPasses(std::move(frame.render_pass_list));
+
   client_->DisplayDidDrawAndSwap();
 
   // Garbage collection can lead to sync IPCs to the GPU service to verify sync
@@ -4,6 +4,7 @@
 
 #include "components/viz/service/display/display_scheduler.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "base/auto_reset.h"
@@ -16,6 +17,16 @@
 
 namespace viz {
 
+namespace {
+
+// A surface that has not responded to its BeginFrame by the deadline this many
+// times in a row is not waited for anymore, since drawing without it is not
+// going to drop an update it would otherwise have made. It is waited for again
+// once it acknowledges a BeginFrame in time.
+constexpr int kMaxMissedDeadlinesToWaitFor = 3;
+
+}  // namespace
+
 DisplayScheduler::DisplayScheduler(BeginFrameSource* begin_frame_source,
                                    base::SingleThreadTaskRunner* task_runner,
                                    int max_pending_swaps,
@@ -141,6 +152,10 @@ void DisplayScheduler::ProcessSurfaceDamage(const SurfaceId& surface_id,
         (it->second.last_ack.source_id != ack.source_id ||
          it->second.last_ack.sequence_number < ack.sequence_number)) {
       it->second.last_ack = ack;
+      if (ack.source_id == current_begin_frame_args_.source_id &&
+          ack.sequence_number == current_begin_frame_args_.sequence_number) {
+        it->second.consecutive_missed_deadlines = 0;
+      }
     } else {
       valid_ack = false;
     }
@@ -167,27 +182,16 @@ bool DisplayScheduler::UpdateHasPendingSurfaces() {
     const SurfaceId& surface_id = entry.first;
     const SurfaceBeginFrameState& state = entry.second;
 
-    // Surface is ready if it hasn't received the current BeginFrame or receives
-    // BeginFrames from a different source and thus likely belongs to a
-    // different surface hierarchy.
-    uint64_t source_id = current_begin_frame_args_.source_id;
-    uint64_t sequence_number = current_begin_frame_args_.sequence_number;
-    if (!state.last_args.IsValid() || state.last_args.source_id != source_id ||
-        state.last_args.sequence_number != sequence_number) {
+    if (!IsSurfacePending(surface_id, state))
       continue;
-    }
 
-    // Surface is ready if it has acknowledged the current BeginFrame.
-    if (state.last_ack.source_id == source_id &&
-        state.last_ack.sequence_number == sequence_number) {
+    // Don't wait for a surface that keeps missing its deadlines, unless we are
+    // required to wait for all surfaces.
+    if (!wait_for_all_surfaces_before_draw_ &&
+        state.consecutive_missed_deadlines >= kMaxMissedDeadlinesToWaitFor) {
       continue;
     }
 
-    // Surface is ready if there is an unacked active CompositorFrame, because
-    // its producer is CompositorFrameAck throttled.
-    if (client_->SurfaceHasUnackedFrame(entry.first))
-      continue;
-
     has_pending_surfaces_ = true;
     TRACE_EVENT_INSTANT2("viz", "DisplayScheduler::UpdateHasPendingSurfaces",
                          TRACE_EVENT_SCOPE_THREAD, "has_pending_surfaces",
@@ -202,6 +206,37 @@ bool DisplayScheduler::UpdateHasPendingSurfaces() {
   return has_pending_surfaces_ != old_value;
 }
 
+bool DisplayScheduler::IsSurfacePending(
+    const SurfaceId& surface_id,
+    const SurfaceBeginFrameState& state) const {
+  // Surface is ready if it hasn't received the current BeginFrame or receives
+  // BeginFrames from a different source and thus likely belongs to a
+  // different surface hierarchy.
+  uint64_t source_id = current_begin_frame_args_.source_id;
+  uint64_t sequence_number = current_begin_frame_args_.sequence_number;
+  if (!state.last_args.IsValid() || state.last_args.source_id != source_id ||
+      state.last_args.sequence_number != sequence_number) {
+    return false;
+  }
+
+  // Surface is ready if it has acknowledged the current BeginFrame.
+  if (state.last_ack.source_id == source_id &&
+      state.last_ack.sequence_number == sequence_number) {
+    return false;
+  }
+
+  // Surface is ready if there is an unacked active CompositorFrame, because
+  // its producer is CompositorFrameAck throttled.
+  return !client_->SurfaceHasUnackedFrame(surface_id);
+}
+
+void DisplayScheduler::UpdateMissedDeadlines() {
+  for (auto& entry : surface_states_) {
+    if (IsSurfacePending(entry.first, entry.second))
+      entry.second.consecutive_missed_deadlines++;
+  }
+}
+
 void DisplayScheduler::OutputSurfaceLost() {
   TRACE_EVENT0("viz", "DisplayScheduler::OutputSurfaceLost");
   output_surface_lost_ = true;
@@ -500,7 +535,18 @@ void DisplayScheduler::OnBeginFrameDeadline() {
   TRACE_EVENT0("viz", "DisplayScheduler::OnBeginFrameDeadline");
   DCHECK(inside_begin_frame_deadline_interval_);
 
+  UpdateMissedDeadlines();
+  base::TimeDelta deadline_slack =
+      current_begin_frame_args_.deadline - base::TimeTicks::Now();
   bool did_draw = AttemptDrawAndSwap();
+  if (did_draw) {
+    // How much earlier than the regular deadline the frame was drawn.
+    UMA_HISTOGRAM_CUSTOM_MICROSECONDS_TIMES(
+        "Compositing.Display.DisplayScheduler.DeadlineSlack",
+        std::max(base::TimeDelta(), deadline_slack),
+        base::TimeDelta::FromMicroseconds(1),
+        base::TimeDelta::FromMilliseconds(100), 50);
+  }
   DidFinishFrame(did_draw);
 }
 
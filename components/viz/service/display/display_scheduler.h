@@ -88,6 +88,15 @@ class VIZ_SERVICE_EXPORT DisplayScheduler : public BeginFrameObserverBase,
                                const BeginFrameArgs& args) override;
 
  protected:
+  struct SurfaceBeginFrameState {
+    BeginFrameArgs last_args;
+    BeginFrameAck last_ack;
+    // The number of deadlines in a row at which the surface had not responded
+    // to its BeginFrame yet. Reset when it acknowledges a BeginFrame before
+    // the next one starts.
+    int consecutive_missed_deadlines = 0;
+  };
+
   // These values inidicate how a response to the BeginFrame should be
   // scheduled.
   enum class BeginFrameDeadlineMode {
@@ -126,6 +135,12 @@ class VIZ_SERVICE_EXPORT DisplayScheduler : public BeginFrameObserverBase,
   void DidFinishFrame(bool did_draw);
   // Updates |has_pending_surfaces_| and returns whether its value changed.
   bool UpdateHasPendingSurfaces();
+  // Returns whether the surface has been sent the current BeginFrame and is
+  // not ready for it yet.
+  bool IsSurfacePending(const SurfaceId& surface_id,
+                        const SurfaceBeginFrameState& state) const;
+  // Counts a missed deadline for each surface that is still pending.
+  void UpdateMissedDeadlines();
 
   DisplaySchedulerClient* client_;
   BeginFrameSource* begin_frame_source_;
@@ -148,10 +163,6 @@ class VIZ_SERVICE_EXPORT DisplayScheduler : public BeginFrameObserverBase,
   bool expecting_root_surface_damage_because_of_resize_;
   bool has_pending_surfaces_;
 
-  struct SurfaceBeginFrameState {
-    BeginFrameArgs last_args;
-    BeginFrameAck last_ack;
-  };
   base::flat_map<SurfaceId, SurfaceBeginFrameState> surface_states_;
 
   int next_swap_id_;
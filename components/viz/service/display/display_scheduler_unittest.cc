@@ -701,6 +701,53 @@ TEST_F(DisplaySchedulerTest, DidSwapBuffers) {
   EXPECT_EQ(2, client_.draw_and_swap_count());
 }
 
+// Surfaces that keep missing their deadlines are not waited for, until they
+// respond to a BeginFrame in time again.
+TEST_F(DisplaySchedulerTest, StopWaitingForSurfaceThatMissesDeadlines) {
+  SurfaceId root_surface_id(
+      kArbitraryFrameSinkId,
+      LocalSurfaceId(1, base::UnguessableToken::Create()));
+  SurfaceId sid1(kArbitraryFrameSinkId,
+                 LocalSurfaceId(2, base::UnguessableToken::Create()));
+  SurfaceId sid2(kArbitraryFrameSinkId,
+                 LocalSurfaceId(3, base::UnguessableToken::Create()));
+
+  scheduler_.SetVisible(true);
+  scheduler_.SetNewRootSurface(root_surface_id);
+
+  // Surface 2 doesn't respond to three BeginFrames in a row, so each of them
+  // waits for the regular deadline.
+  for (int i = 0; i < 3; ++i) {
+    AdvanceTimeAndBeginFrameForTest({sid1, sid2});
+    SurfaceDamaged(sid1);
+    EXPECT_TRUE(scheduler_.has_pending_surfaces());
+    EXPECT_LT(now_src().NowTicks(),
+              scheduler_.DesiredBeginFrameDeadlineTimeForTest());
+    scheduler_.BeginFrameDeadlineForTest();
+  }
+
+  // Now the deadline triggers as soon as surface 1 is ready.
+  AdvanceTimeAndBeginFrameForTest({sid1, sid2});
+  SurfaceDamaged(sid1);
+  EXPECT_FALSE(scheduler_.has_pending_surfaces());
+  EXPECT_GE(now_src().NowTicks(),
+            scheduler_.DesiredBeginFrameDeadlineTimeForTest());
+  scheduler_.BeginFrameDeadlineForTest();
+
+  // Once surface 2 responds to a BeginFrame, it is waited for again.
+  AdvanceTimeAndBeginFrameForTest({sid1, sid2});
+  SurfaceDamaged(sid2);
+  SurfaceDamaged(sid1);
+  scheduler_.BeginFrameDeadlineForTest();
+
+  AdvanceTimeAndBeginFrameForTest({sid1, sid2});
+  SurfaceDamaged(sid1);
+  EXPECT_TRUE(scheduler_.has_pending_surfaces());
+  EXPECT_LT(now_src().NowTicks(),
+            scheduler_.DesiredBeginFrameDeadlineTimeForTest());
+  scheduler_.BeginFrameDeadlineForTest();
+}
+
 // This test verfies that we try to reschedule the deadline
 // after any event that may change what deadline we want.
 TEST_F(DisplaySchedulerTest, ScheduleBeginFrameDeadline) {
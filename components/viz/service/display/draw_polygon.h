@@ -51,6 +51,9 @@ class VIZ_SERVICE_EXPORT DrawPolygon {
   const std::vector<gfx::Point3F>& points() const { return points_; }
   const gfx::Vector3dF& normal() const { return normal_; }
   const DrawQuad* original_ref() const { return original_ref_; }
+  void set_original_ref(const DrawQuad* original_ref) {
+    original_ref_ = original_ref;
+  }
   int order_index() const { return order_index_; }
   bool is_split() const { return is_split_; }
   std::unique_ptr<DrawPolygon> CreateCopy();
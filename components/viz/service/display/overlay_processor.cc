@@ -146,6 +146,8 @@ void OverlayProcessor::ProcessForOverlays(
   previous_frame_underlay_was_unoccluded_ = false;
 
   RenderPass* render_pass = render_passes->back().get();
+  Strategy* last_successful_strategy = last_successful_strategy_;
+  last_successful_strategy_ = nullptr;
 
   // If we have any copy requests, we can't remove any quads for overlays or
   // CALayers because the framebuffer would be missing the removed quads'
@@ -175,18 +177,34 @@ void OverlayProcessor::ProcessForOverlays(
 
   // Only if that fails, attempt hardware overlay strategies.
   Strategy* successful_strategy = nullptr;
-  for (const auto& strategy : strategies_) {
-    if (strategy->Attempt(output_color_matrix, render_pass_backdrop_filters,
-                          resource_provider, render_passes, candidates,
-                          content_bounds)) {
-      successful_strategy = strategy.get();
-
-      UpdateDamageRect(candidates, previous_frame_underlay_rect,
-                       previous_frame_underlay_was_unoccluded,
-                       &render_pass->quad_list, damage_rect);
-      break;
+  auto attempt_strategy = [&](Strategy* strategy) {
+    return strategy->Attempt(output_color_matrix, render_pass_backdrop_filters,
+                             resource_provider, render_passes, candidates,
+                             content_bounds);
+  };
+  // Overlay content, such as a playing video, usually keeps its geometry from
+  // frame to frame. Try the strategy that worked for the previous frame first,
+  // so that the ones that failed are not attempted again each frame, and the
+  // overlay doesn't switch between strategies.
+  if (last_successful_strategy &&
+      attempt_strategy(last_successful_strategy)) {
+    successful_strategy = last_successful_strategy;
+  } else {
+    for (const auto& strategy : strategies_) {
+      if (strategy.get() != last_successful_strategy &&
+          attempt_strategy(strategy.get())) {
+        successful_strategy = strategy.get();
+        break;
+      }
     }
   }
+  last_successful_strategy_ = successful_strategy;
+
+  if (successful_strategy) {
+    UpdateDamageRect(candidates, previous_frame_underlay_rect,
+                     previous_frame_underlay_was_unoccluded,
+                     &render_pass->quad_list, damage_rect);
+  }
 
   if (!successful_strategy && !previous_frame_underlay_rect.IsEmpty())
     damage_rect->Union(previous_frame_underlay_rect);
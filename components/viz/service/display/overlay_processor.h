@@ -90,6 +90,9 @@ class VIZ_SERVICE_EXPORT OverlayProcessor {
   gfx::Rect overlay_damage_rect_;
   gfx::Rect previous_frame_underlay_rect_;
   bool previous_frame_underlay_was_unoccluded_ = false;
+  // The strategy that was used for the previous frame, if any. It is attempted
+  // first for the next frame.
+  Strategy* last_successful_strategy_ = nullptr;
 
  private:
   bool ProcessForCALayers(
@@ -562,6 +562,7 @@ class OverlayTest : public testing::Test {
 };
 
 using FullscreenOverlayTest = OverlayTest<FullscreenOverlayValidator>;
+using SingleOverlayTest = OverlayTest<SingleOverlayValidator>;
 using SingleOverlayOnTopTest = OverlayTest<SingleOnTopOverlayValidator>;
 using UnderlayTest = OverlayTest<UnderlayOverlayValidator>;
 using TransparentUnderlayTest =
@@ -1561,6 +1562,53 @@ TEST_F(SingleOverlayOnTopTest, RejectTransparentColorOnTopWithoutBlending) {
   EXPECT_EQ(0U, candidate_list.size());
 }
 
+// The strategy used for the previous frame is kept while it still works, even
+// if a strategy that is attempted before it would work too.
+TEST_F(SingleOverlayTest, PreviousStrategyAttemptedFirst) {
+  OverlayProcessor::FilterOperationsMap render_pass_filters;
+  OverlayProcessor::FilterOperationsMap render_pass_backdrop_filters;
+
+  // The candidate is occluded, so only the underlay strategy works.
+  {
+    std::unique_ptr<RenderPass> pass = CreateRenderPass();
+    CreateFullscreenOpaqueQuad(resource_provider_.get(),
+                               pass->shared_quad_state_list.back(), pass.get());
+    CreateFullscreenCandidateQuad(
+        resource_provider_.get(), child_resource_provider_.get(),
+        child_provider_.get(), pass->shared_quad_state_list.back(), pass.get());
+
+    OverlayCandidateList candidate_list;
+    RenderPassList pass_list;
+    pass_list.push_back(std::move(pass));
+    overlay_processor_->ProcessForOverlays(
+        resource_provider_.get(), &pass_list, GetIdentityColorMatrix(),
+        render_pass_filters, render_pass_backdrop_filters, &candidate_list,
+        nullptr, nullptr, &damage_rect_, &content_bounds_);
+    ASSERT_EQ(1U, candidate_list.size());
+    EXPECT_EQ(-1, candidate_list[0].plane_z_order);
+  }
+
+  // The candidate is on top now, but it stays an underlay.
+  {
+    std::unique_ptr<RenderPass> pass = CreateRenderPass();
+    CreateFullscreenCandidateQuad(
+        resource_provider_.get(), child_resource_provider_.get(),
+        child_provider_.get(), pass->shared_quad_state_list.back(), pass.get());
+    CreateFullscreenOpaqueQuad(resource_provider_.get(),
+                               pass->shared_quad_state_list.back(), pass.get());
+
+    OverlayCandidateList candidate_list;
+    RenderPassList pass_list;
+    pass_list.push_back(std::move(pass));
+    overlay_processor_->ProcessForOverlays(
+        resource_provider_.get(), &pass_list, GetIdentityColorMatrix(),
+        render_pass_filters, render_pass_backdrop_filters, &candidate_list,
+        nullptr, nullptr, &damage_rect_, &content_bounds_);
+    ASSERT_EQ(1U, candidate_list.size());
+    EXPECT_EQ(-1, candidate_list[0].plane_z_order);
+  }
+}
+
 TEST_F(UnderlayTest, OverlayLayerUnderMainLayer) {
   output_surface_->GetOverlayCandidateValidator()->AddExpectedRect(
       gfx::RectF(kOverlayBottomRightRect));
@@ -1294,6 +1294,26 @@ TYPED_TEST(IntersectingQuadPixelTest, SolidColorQuads) {
       FILE_PATH_LITERAL("intersecting_blue_green.png"));
 }
 
+// The second frame draws the same sorting context as the first one, so it
+// reuses the BSP tree built for it.
+TYPED_TEST(IntersectingQuadPixelTest, SolidColorQuadsDrawnTwice) {
+  for (int i = 0; i < 2; ++i) {
+    SCOPED_TRACE(i);
+    this->SetupQuadStateAndRenderPass();
+
+    auto* quad = this->template CreateAndAppendDrawQuad<SolidColorDrawQuad>();
+    auto* quad2 = this->template CreateAndAppendDrawQuad<SolidColorDrawQuad>();
+
+    quad->SetNew(this->front_quad_state_, this->quad_rect_, this->quad_rect_,
+                 SK_ColorBLUE, false);
+    quad2->SetNew(this->back_quad_state_, this->quad_rect_, this->quad_rect_,
+                  SK_ColorGREEN, false);
+    this->AppendBackgroundAndRunTest(
+        cc::FuzzyPixelComparator(false, 2.f, 0.f, 256.f, 256, 0.f),
+        FILE_PATH_LITERAL("intersecting_blue_green.png"));
+  }
+}
+
 static inline uint32_t GetSkiaOrGLColor(const SkColor& color) {
   return SkColorSetARGB(SkColorGetA(color), SkColorGetB(color),
                         SkColorGetG(color), SkColorGetR(color));
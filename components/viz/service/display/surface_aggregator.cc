@@ -133,6 +133,32 @@ RenderPassId SurfaceAggregator::RemapPassId(RenderPassId surface_local_pass_id,
   return render_pass_info.id;
 }
 
+bool SurfaceAggregator::IsRenderPassOutsideRootDamage(
+    const RenderPass& source,
+    const RenderPass& copy_pass) const {
+  // These are the same conditions under which CopyQuadsToPass skips the
+  // undamaged quads.
+  if (!aggregate_only_damaged_ || has_copy_requests_ ||
+      has_cached_render_passes_ || moved_pixel_passes_.count(copy_pass.id)) {
+    return false;
+  }
+  // CopyQuadsToPass visits every SurfaceDrawQuad even when it is outside of
+  // the damage, so that the embedded surfaces stay in |contained_surfaces_|
+  // and get their draw callbacks, acks and resources. Passes embedding
+  // surfaces must therefore still be walked.
+  for (const DrawQuad* quad : source.quad_list) {
+    if (quad->material == DrawQuad::SURFACE_CONTENT)
+      return false;
+  }
+  gfx::Rect damage_rect_in_render_pass_space;
+  if (!CalculateQuadSpaceDamageRect(
+          gfx::Transform(), copy_pass.transform_to_root_target,
+          root_damage_rect_, &damage_rect_in_render_pass_space)) {
+    return false;
+  }
+  return !damage_rect_in_render_pass_space.Intersects(copy_pass.output_rect);
+}
+
 int SurfaceAggregator::ChildIdForSurface(Surface* surface) {
   auto it = surface_id_to_resource_child_id_.find(surface->surface_id());
   if (it == surface_id_to_resource_child_id_.end()) {
@@ -328,12 +354,12 @@ void SurfaceAggregator::EmitSurfaceContent(
   for (size_t j = 0; j < passes_to_copy; ++j) {
     const RenderPass& source = *referenced_passes[j];
 
+    RenderPassId remapped_pass_id = RemapPassId(source.id, surface_id);
+
     size_t sqs_size = source.shared_quad_state_list.size();
     size_t dq_size = source.quad_list.size();
-    std::unique_ptr<RenderPass> copy_pass(
-        RenderPass::Create(sqs_size, dq_size));
-
-    RenderPassId remapped_pass_id = RemapPassId(source.id, surface_id);
+    std::unique_ptr<RenderPass> copy_pass =
+        CreateRenderPass(remapped_pass_id, sqs_size, dq_size);
 
     copy_pass->SetAll(remapped_pass_id, source.output_rect, source.output_rect,
                       source.transform_to_root_target, source.filters,
@@ -354,10 +380,14 @@ void SurfaceAggregator::EmitSurfaceContent(
     copy_pass->transform_to_root_target.ConcatTransform(
         dest_pass->transform_to_root_target);
 
-    CopyQuadsToPass(source.quad_list, source.shared_quad_state_list,
-                    surface->GetActiveFrame().device_scale_factor(),
-                    child_to_parent_map, gfx::Transform(), ClipData(),
-                    copy_pass.get(), surface_id, has_surface_damage);
+    // None of the quads of a pass outside of the damage would be drawn, so
+    // don't spend time copying them.
+    if (!IsRenderPassOutsideRootDamage(source, *copy_pass)) {
+      CopyQuadsToPass(source.quad_list, source.shared_quad_state_list,
+                      surface->GetActiveFrame().device_scale_factor(),
+                      child_to_parent_map, gfx::Transform(), ClipData(),
+                      copy_pass.get(), surface_id, has_surface_damage);
+    }
 
     // If the render pass has copy requests, or should be cached, or has
     // moving-pixel filters, or in a moving-pixel surface, we should damage the
@@ -712,6 +742,31 @@ void SurfaceAggregator::CopyQuadsToPass(
   }
 }
 
+std::unique_ptr<RenderPass> SurfaceAggregator::CreateRenderPass(
+    RenderPassId remapped_pass_id,
+    size_t sqs_size,
+    size_t dq_size) {
+  auto it = recycled_render_passes_.find(remapped_pass_id);
+  if (it == recycled_render_passes_.end())
+    return RenderPass::Create(sqs_size, dq_size);
+  std::unique_ptr<RenderPass> render_pass = std::move(it->second);
+  recycled_render_passes_.erase(it);
+  return render_pass;
+}
+
+void SurfaceAggregator::RecycleRenderPasses(RenderPassList render_pass_list) {
+  recycled_render_passes_.clear();
+  for (auto& render_pass : render_pass_list) {
+    // Clearing the lists keeps their first allocation, which was sized for the
+    // pass when it was created. All the other fields are replaced by SetAll().
+    render_pass->quad_list.clear();
+    render_pass->shared_quad_state_list.clear();
+    render_pass->copy_requests.clear();
+    RenderPassId id = render_pass->id;
+    recycled_render_passes_[id] = std::move(render_pass);
+  }
+}
+
 void SurfaceAggregator::CopyPasses(const CompositorFrame& frame,
                                    Surface* surface) {
   // The root surface is allowed to have copy output requests, so grab them
@@ -737,15 +792,15 @@ void SurfaceAggregator::CopyPasses(const CompositorFrame& frame,
   for (size_t i = 0; i < source_pass_list.size(); ++i) {
     const auto& source = *source_pass_list[i];
 
+    RenderPassId remapped_pass_id =
+        RemapPassId(source.id, surface->surface_id());
+
     size_t sqs_size = source.shared_quad_state_list.size();
     size_t dq_size = source.quad_list.size();
-    auto copy_pass = RenderPass::Create(sqs_size, dq_size);
+    auto copy_pass = CreateRenderPass(remapped_pass_id, sqs_size, dq_size);
 
     MoveMatchingRequests(source.id, &copy_requests, &copy_pass->copy_requests);
 
-    RenderPassId remapped_pass_id =
-        RemapPassId(source.id, surface->surface_id());
-
     copy_pass->SetAll(remapped_pass_id, source.output_rect, source.output_rect,
                       source.transform_to_root_target, source.filters,
                       source.backdrop_filters, source.backdrop_filter_bounds,
@@ -754,10 +809,12 @@ void SurfaceAggregator::CopyPasses(const CompositorFrame& frame,
                       source.has_damage_from_contributing_content,
                       source.generate_mipmap);
 
-    CopyQuadsToPass(source.quad_list, source.shared_quad_state_list,
-                    frame.device_scale_factor(), child_to_parent_map,
-                    gfx::Transform(), ClipData(), copy_pass.get(),
-                    surface->surface_id(), has_surface_damage);
+    if (!IsRenderPassOutsideRootDamage(source, *copy_pass)) {
+      CopyQuadsToPass(source.quad_list, source.shared_quad_state_list,
+                      frame.device_scale_factor(), child_to_parent_map,
+                      gfx::Transform(), ClipData(), copy_pass.get(),
+                      surface->surface_id(), has_surface_damage);
+    }
 
     // If the render pass has copy requests, or should be cached, or has
     // moving-pixel filters, or in a moving-pixel surface, we should damage the
@@ -1180,6 +1237,7 @@ CompositorFrame SurfaceAggregator::Aggregate(
   copy_request_passes_.clear();
   contributing_content_damaged_passes_.clear();
   render_pass_dependencies_.clear();
+  recycled_render_passes_.clear();
 
   // Remove all render pass mappings that weren't used in the current frame.
   for (auto it = render_pass_allocator_map_.begin();
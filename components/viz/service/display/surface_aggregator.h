@@ -58,6 +58,11 @@ class VIZ_SERVICE_EXPORT SurfaceAggregator {
 
   bool NotifySurfaceDamageAndCheckForDisplayDamage(const SurfaceId& surface_id);
 
+  // Takes back the render passes of an aggregated frame once it has been drawn.
+  // The next Aggregate call reuses their quad and shared quad state storage for
+  // the passes with the same ids, instead of allocating it again.
+  void RecycleRenderPasses(RenderPassList render_pass_list);
+
  private:
   struct ClipData {
     ClipData() : is_clipped(false) {}
@@ -162,6 +167,13 @@ class VIZ_SERVICE_EXPORT SurfaceAggregator {
   void CopyPasses(const CompositorFrame& frame, Surface* surface);
   void AddColorConversionPass();
 
+  // Returns the recycled render pass with |remapped_pass_id| if there is one,
+  // or a new render pass with room for the given number of shared quad states
+  // and quads otherwise.
+  std::unique_ptr<RenderPass> CreateRenderPass(RenderPassId remapped_pass_id,
+                                               size_t sqs_size,
+                                               size_t dq_size);
+
   // Remove Surfaces that were referenced before but aren't currently
   // referenced from the ResourceProvider.
   // Also notifies SurfaceAggregatorClient of newly added and removed
@@ -170,6 +182,12 @@ class VIZ_SERVICE_EXPORT SurfaceAggregator {
 
   void PropagateCopyRequestPasses();
 
+  // Returns true if |copy_pass| is entirely outside of the root damage while
+  // only damaged quads are aggregated, and |source| embeds no surfaces, so
+  // that none of its quads need to be copied.
+  bool IsRenderPassOutsideRootDamage(const RenderPass& source,
+                                     const RenderPass& copy_pass) const;
+
   int ChildIdForSurface(Surface* surface);
   bool IsSurfaceFrameIndexSameAsPrevious(const Surface* surface) const;
   gfx::Rect DamageRectForSurface(const Surface* surface,
@@ -204,6 +222,13 @@ class VIZ_SERVICE_EXPORT SurfaceAggregator {
 
   base::flat_map<SurfaceId, int> surface_id_to_resource_child_id_;
 
+  // The cleared render passes of the last drawn frame, keyed by their id. A
+  // pass usually keeps its id and about the same number of quads from frame to
+  // frame. Whatever is not reused by the next aggregation is released at its
+  // end.
+  base::flat_map<RenderPassId, std::unique_ptr<RenderPass>>
+      recycled_render_passes_;
+
   // The following state is only valid for the duration of one Aggregate call
   // and is only stored on the class to avoid having to pass through every
   // function call.
@@ -188,5 +188,10 @@ TEST_F(SurfaceAggregatorPerfTest, FewSurfacesAggregateDamaged) {
   RunTest(3, 1000, 1.f, true, false, "few_surfaces_aggregate_damaged");
 }
 
+TEST_F(SurfaceAggregatorPerfTest, ManySurfacesTransparentAggregateDamaged) {
+  RunTest(20, 100, .5f, true, false,
+          "many_surfaces_transparent_aggregate_damaged");
+}
+
 }  // namespace
 }  // namespace viz
@@ -536,6 +536,39 @@ TEST_F(SurfaceAggregatorValidSurfaceTest, SimpleFrame) {
   testing::Mock::VerifyAndClearExpectations(&aggregated_damage_callback);
 }
 
+// Test that the render passes of a drawn frame are reused by the next
+// aggregation, with only the new frame's quads in them.
+TEST_F(SurfaceAggregatorValidSurfaceTest, RecycleRenderPasses) {
+  constexpr float device_scale_factor = 1.0f;
+  SurfaceId root_surface_id(root_sink_->frame_sink_id(),
+                            root_local_surface_id_);
+
+  std::vector<Quad> quads = {
+      Quad::SolidColorQuad(SK_ColorRED, gfx::Rect(5, 5)),
+      Quad::SolidColorQuad(SK_ColorBLUE, gfx::Rect(5, 5))};
+  std::vector<Pass> passes = {Pass(quads, SurfaceSize())};
+  SubmitCompositorFrame(root_sink_.get(), passes, root_local_surface_id_,
+                        device_scale_factor);
+
+  CompositorFrame aggregated_frame =
+      aggregator_.Aggregate(root_surface_id, GetNextDisplayTimeAndIncrement());
+  ASSERT_EQ(1u, aggregated_frame.render_pass_list.size());
+  RenderPass* first_pass = aggregated_frame.render_pass_list[0].get();
+  aggregator_.RecycleRenderPasses(std::move(aggregated_frame.render_pass_list));
+
+  std::vector<Quad> new_quads = {
+      Quad::SolidColorQuad(SK_ColorGREEN, gfx::Rect(5, 5))};
+  std::vector<Pass> new_passes = {Pass(new_quads, SurfaceSize())};
+  SubmitCompositorFrame(root_sink_.get(), new_passes, root_local_surface_id_,
+                        device_scale_factor);
+
+  aggregated_frame =
+      aggregator_.Aggregate(root_surface_id, GetNextDisplayTimeAndIncrement());
+  ASSERT_EQ(1u, aggregated_frame.render_pass_list.size());
+  EXPECT_EQ(first_pass, aggregated_frame.render_pass_list[0].get());
+  TestPassesMatchExpectations(new_passes, &aggregated_frame.render_pass_list);
+}
+
 // Test that when surface is translucent and we need the render surface to apply
 // the opacity, we would keep the render surface.
 TEST_F(SurfaceAggregatorValidSurfaceTest, OpacityCopied) {
@@ -3656,6 +3689,144 @@ TEST_F(SurfaceAggregatorPartialSwapTest, IgnoreOutside) {
   }
 }
 
+// A render pass of a child surface that is entirely outside of the damage is
+// aggregated without its quads.
+TEST_F(SurfaceAggregatorPartialSwapTest, IgnoreRenderPassOutsideDamage) {
+  ParentLocalSurfaceIdAllocator allocator;
+  allocator.GenerateId();
+  LocalSurfaceId child_local_surface_id =
+      allocator.GetCurrentLocalSurfaceIdAllocation().local_surface_id();
+  SurfaceId child_surface_id(child_sink_->frame_sink_id(),
+                             child_local_surface_id);
+  constexpr float device_scale_factor = 1.0f;
+
+  {
+    int child_pass_ids[] = {1, 2};
+    std::vector<Quad> child_quads1 = {
+        Quad::SolidColorQuad(SK_ColorGREEN, gfx::Rect(5, 5))};
+    std::vector<Quad> child_quads2 = {Quad::RenderPassQuad(child_pass_ids[0])};
+    std::vector<Pass> child_passes = {
+        Pass(child_quads1, child_pass_ids[0], gfx::Size(5, 5)),
+        Pass(child_quads2, child_pass_ids[1], SurfaceSize())};
+
+    RenderPassList child_pass_list;
+    std::vector<SurfaceRange> referenced_surfaces;
+    AddPasses(&child_pass_list, child_passes, &referenced_surfaces);
+
+    SubmitPassListAsFrame(child_sink_.get(), child_local_surface_id,
+                          &child_pass_list, std::move(referenced_surfaces),
+                          device_scale_factor);
+  }
+
+  SurfaceId root_surface_id(root_sink_->frame_sink_id(),
+                            root_local_surface_id_);
+  for (const gfx::Rect& damage_rect :
+       {gfx::Rect(SurfaceSize()), gfx::Rect(50, 50, 1, 1)}) {
+    std::vector<Quad> root_quads = {Quad::SurfaceQuad(
+        SurfaceRange(base::nullopt, child_surface_id), SK_ColorWHITE,
+        gfx::Rect(SurfaceSize()), /*stretch_content_to_fill_bounds=*/false,
+        /*ignores_input_event=*/false)};
+    std::vector<Pass> root_passes = {Pass(root_quads, SurfaceSize())};
+
+    RenderPassList root_pass_list;
+    std::vector<SurfaceRange> referenced_surfaces;
+    AddPasses(&root_pass_list, root_passes, &referenced_surfaces);
+    root_pass_list[0]->damage_rect = damage_rect;
+    SubmitPassListAsFrame(root_sink_.get(), root_local_surface_id_,
+                          &root_pass_list, std::move(referenced_surfaces),
+                          device_scale_factor);
+
+    CompositorFrame aggregated_frame = aggregator_.Aggregate(
+        root_surface_id, GetNextDisplayTimeAndIncrement());
+    const auto& aggregated_pass_list = aggregated_frame.render_pass_list;
+    ASSERT_EQ(2u, aggregated_pass_list.size());
+
+    // The child pass and the quad that draws it are only kept while they are
+    // damaged.
+    size_t expected_quads = damage_rect == gfx::Rect(SurfaceSize()) ? 1u : 0u;
+    EXPECT_EQ(expected_quads, aggregated_pass_list[0]->quad_list.size());
+    EXPECT_EQ(expected_quads, aggregated_pass_list[1]->quad_list.size());
+  }
+}
+
+// A render pass outside of the damage that embeds another surface is still
+// walked, so the embedded surface keeps being reported as contained.
+TEST_F(SurfaceAggregatorPartialSwapTest,
+       RenderPassOutsideDamageKeepsEmbeddedSurfaces) {
+  constexpr float device_scale_factor = 1.0f;
+  auto grandchild_sink = std::make_unique<CompositorFrameSinkSupport>(
+      nullptr, &manager_, kArbitraryFrameSinkId2, kChildIsRoot,
+      kNeedsSyncPoints);
+  ParentLocalSurfaceIdAllocator grandchild_allocator;
+  grandchild_allocator.GenerateId();
+  LocalSurfaceId grandchild_local_surface_id =
+      grandchild_allocator.GetCurrentLocalSurfaceIdAllocation()
+          .local_surface_id();
+  SurfaceId grandchild_surface_id(grandchild_sink->frame_sink_id(),
+                                  grandchild_local_surface_id);
+  {
+    std::vector<Quad> grandchild_quads = {
+        Quad::SolidColorQuad(SK_ColorGREEN, gfx::Rect(5, 5))};
+    std::vector<Pass> grandchild_passes = {
+        Pass(grandchild_quads, gfx::Size(5, 5))};
+
+    RenderPassList grandchild_pass_list;
+    std::vector<SurfaceRange> referenced_surfaces;
+    AddPasses(&grandchild_pass_list, grandchild_passes, &referenced_surfaces);
+    SubmitPassListAsFrame(grandchild_sink.get(), grandchild_local_surface_id,
+                          &grandchild_pass_list,
+                          std::move(referenced_surfaces), device_scale_factor);
+  }
+
+  ParentLocalSurfaceIdAllocator allocator;
+  allocator.GenerateId();
+  LocalSurfaceId child_local_surface_id =
+      allocator.GetCurrentLocalSurfaceIdAllocation().local_surface_id();
+  SurfaceId child_surface_id(child_sink_->frame_sink_id(),
+                             child_local_surface_id);
+  {
+    int child_pass_ids[] = {1, 2};
+    std::vector<Quad> child_quads1 = {Quad::SurfaceQuad(
+        SurfaceRange(base::nullopt, grandchild_surface_id), SK_ColorWHITE,
+        gfx::Rect(5, 5), /*stretch_content_to_fill_bounds=*/false,
+        /*ignores_input_event=*/false)};
+    std::vector<Quad> child_quads2 = {Quad::RenderPassQuad(child_pass_ids[0])};
+    std::vector<Pass> child_passes = {
+        Pass(child_quads1, child_pass_ids[0], gfx::Size(5, 5)),
+        Pass(child_quads2, child_pass_ids[1], SurfaceSize())};
+
+    RenderPassList child_pass_list;
+    std::vector<SurfaceRange> referenced_surfaces;
+    AddPasses(&child_pass_list, child_passes, &referenced_surfaces);
+    SubmitPassListAsFrame(child_sink_.get(), child_local_surface_id,
+                          &child_pass_list, std::move(referenced_surfaces),
+                          device_scale_factor);
+  }
+
+  SurfaceId root_surface_id(root_sink_->frame_sink_id(),
+                            root_local_surface_id_);
+  for (const gfx::Rect& damage_rect :
+       {gfx::Rect(SurfaceSize()), gfx::Rect(50, 50, 1, 1)}) {
+    std::vector<Quad> root_quads = {Quad::SurfaceQuad(
+        SurfaceRange(base::nullopt, child_surface_id), SK_ColorWHITE,
+        gfx::Rect(SurfaceSize()), /*stretch_content_to_fill_bounds=*/false,
+        /*ignores_input_event=*/false)};
+    std::vector<Pass> root_passes = {Pass(root_quads, SurfaceSize())};
+
+    RenderPassList root_pass_list;
+    std::vector<SurfaceRange> referenced_surfaces;
+    AddPasses(&root_pass_list, root_passes, &referenced_surfaces);
+    root_pass_list[0]->damage_rect = damage_rect;
+    SubmitPassListAsFrame(root_sink_.get(), root_local_surface_id_,
+                          &root_pass_list, std::move(referenced_surfaces),
+                          device_scale_factor);
+
+    aggregator_.Aggregate(root_surface_id, GetNextDisplayTimeAndIncrement());
+    EXPECT_TRUE(base::ContainsKey(aggregator_.previous_contained_surfaces(),
+                                  grandchild_surface_id));
+  }
+}
+
 class SurfaceAggregatorWithResourcesTest : public testing::Test,
                                            public DisplayTimeSource {
  public:
@@ -564,8 +564,22 @@ SkCanvas* SkiaOutputSurfaceImpl::BeginPaintRenderPass(
 
   current_render_pass_id_ = id;
 
-  SkSurfaceCharacterization characterization = CreateSkSurfaceCharacterization(
-      surface_size, format, mipmap, std::move(color_space));
+  // Most render passes are drawn with the same parameters every frame, so
+  // reuse their characterization instead of creating one for each draw.
+  SkSurfaceCharacterization& characterization =
+      render_pass_characterizations_[id];
+  if (!characterization.isValid() ||
+      characterization.width() != surface_size.width() ||
+      characterization.height() != surface_size.height() ||
+      characterization.imageInfo().colorType() !=
+          ResourceFormatToClosestSkColorType(true /* gpu_compositing */,
+                                             format) ||
+      characterization.isMipMapped() != mipmap ||
+      !SkColorSpace::Equals(characterization.colorSpace(),
+                            color_space.get())) {
+    characterization = CreateSkSurfaceCharacterization(
+        surface_size, format, mipmap, std::move(color_space));
+  }
   recorder_.emplace(characterization);
   return recorder_->getCanvas();
 }
@@ -631,6 +645,9 @@ void SkiaOutputSurfaceImpl::RemoveRenderPassResource(
     std::vector<RenderPassId> ids) {
   DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
   DCHECK(!ids.empty());
+  for (const auto& id : ids)
+    render_pass_characterizations_.erase(id);
+
   // impl_on_gpu_ is released on the GPU thread by a posted task from
   // SkiaOutputSurfaceImpl::dtor. So it is safe to use base::Unretained.
   auto callback =
@@ -187,20 +187,23 @@ class InducedSuffixSort {
     }
 
     // Apply induced sort from |lms_indices| to |suffix_array| associated with
-    // the string |str|.
+    // the string |str|. |bucket_bounds_storage| is scratch space at least as
+    // large as |buckets|, so callers can reuse it across calls.
     template <class StrIt, class SAIt>
     static void InducedSort(StrIt str,
                             size_type length,
                             const std::vector<SLType>& sl_partition,
                             const std::vector<size_type>& lms_indices,
                             const std::vector<size_type>& buckets,
+                            std::vector<size_type>* bucket_bounds_storage,
                             SAIt suffix_array) {
       // All indices are first marked as unset with the illegal value |length|.
       std::fill(suffix_array, suffix_array + length, length);
 
       // Used to mark bucket boundaries (head or end) as indices in str.
       DCHECK(!buckets.empty());
-      std::vector<size_type> bucket_bounds(buckets.size());
+      DCHECK_GE(bucket_bounds_storage->size(), buckets.size());
+      std::vector<size_type>& bucket_bounds = *bucket_bounds_storage;
 
       // Step 1: Assign indices for LMS suffixes, populating the end of
       // respective buckets but keeping relative order.
@@ -373,12 +376,15 @@ class InducedSuffixSort {
       std::vector<size_type> lms_indices(lms_count);
       FindLmsSuffixes(sl_partition, lms_indices.begin());
       std::vector<size_type> buckets = MakeBucketCount(str, length, key_bound);
+      // Shared by both InducedSort() passes below. |buckets| has one entry per
+      // key, which can be large for encoded views with many labels.
+      std::vector<size_type> bucket_bounds(buckets.size());
 
       if (lms_indices.size() > 1) {
         // Given |lms_indices| in the same order they appear in |str|, induce
         // LMS substrings relative order and write result to |suffix_array|.
         InducedSort(str, length, sl_partition, lms_indices, buckets,
-                    suffix_array);
+                    &bucket_bounds, suffix_array);
         std::vector<size_type> lms_str(lms_indices.size());
 
         // Given LMS substrings in relative order found in |suffix_array|,
@@ -422,7 +428,7 @@ class InducedSuffixSort {
       // Given |lms_indices| where LMS suffixes are sorted, induce the full
       // order of suffixes in |str|.
       InducedSort(str, length, sl_partition, lms_indices, buckets,
-                  suffix_array);
+                  &bucket_bounds, suffix_array);
     }
 
    private:
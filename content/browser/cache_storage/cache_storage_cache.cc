@@ -260,6 +260,15 @@ GURL RemoveQueryParam(const GURL& url) {
   return url.ReplaceComponents(replacements);
 }
 
+// Returns the spec of |url| up to, but not including, its query and ref. Every
+// URL that matches |url| with the query ignored has a spec starting with this.
+std::string GetSpecBeforeQuery(const GURL& url) {
+  url::Replacements<char> replacements;
+  replacements.ClearQuery();
+  replacements.ClearRef();
+  return url.ReplaceComponents(replacements).spec();
+}
+
 void ReadMetadata(disk_cache::Entry* entry, MetadataCallback callback) {
   DCHECK(entry);
 
@@ -458,6 +467,12 @@ struct CacheStorageCache::QueryCacheContext {
   QueryTypes query_types = 0;
   size_t estimated_out_bytes = 0;
 
+  // For ignore_search queries, the request URL without its query and the
+  // prefix every matching entry key must start with. Computed once up front
+  // so the scan over every entry in the backend is cheap.
+  GURL request_url_without_query;
+  std::string request_spec_before_query;
+
   // Iteration state
   std::unique_ptr<disk_cache::Backend::Iterator> backend_iterator;
   disk_cache::Entry* enumerated_entry = nullptr;
@@ -992,6 +1007,13 @@ void CacheStorageCache::QueryCache(blink::mojom::FetchAPIRequestPtr request,
     return;
   }
 
+  if (query_cache_context->request &&
+      !query_cache_context->request->url.is_empty()) {
+    const GURL& url = query_cache_context->request->url;
+    query_cache_context->request_url_without_query = RemoveQueryParam(url);
+    query_cache_context->request_spec_before_query = GetSpecBeforeQuery(url);
+  }
+
   query_cache_context->backend_iterator = backend_->CreateIterator();
   QueryCacheOpenNextEntry(std::move(query_cache_context));
 }
@@ -1087,16 +1109,22 @@ void CacheStorageCache::QueryCacheFilterEntry(
 
   if (query_cache_context->request &&
       !query_cache_context->request->url.is_empty()) {
-    GURL requestURL = query_cache_context->request->url;
-    GURL cachedURL = GURL(entry->GetKey());
-
+    bool matches;
     if (query_cache_context->options &&
         query_cache_context->options->ignore_search) {
-      requestURL = RemoveQueryParam(requestURL);
-      cachedURL = RemoveQueryParam(cachedURL);
+      // Reject most entries with a string prefix check before paying for URL
+      // parsing.
+      const std::string& key = entry->GetKey();
+      matches =
+          base::StartsWith(key, query_cache_context->request_spec_before_query,
+                           base::CompareCase::SENSITIVE) &&
+          RemoveQueryParam(GURL(key)) ==
+              query_cache_context->request_url_without_query;
+    } else {
+      matches = GURL(entry->GetKey()) == query_cache_context->request->url;
     }
 
-    if (cachedURL != requestURL) {
+    if (!matches) {
       QueryCacheOpenNextEntry(std::move(query_cache_context));
       return;
     }
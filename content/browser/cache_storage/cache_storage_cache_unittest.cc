@@ -1263,6 +1263,26 @@ TEST_P(CacheStorageCacheTestP, Keys_IgnoreSearch) {
   EXPECT_EQ(1u, callback_strings_.size());
 }
 
+TEST_P(CacheStorageCacheTestP, Keys_IgnoreSearchSharedPathPrefix) {
+  const GURL kLongerPathUrl("http://example.com/body.html2?query=test");
+  blink::mojom::FetchAPIRequestPtr longer_path_request = CreateFetchAPIRequest(
+      kLongerPathUrl, "GET", kHeaders, blink::mojom::Referrer::New(), false);
+  blink::mojom::FetchAPIResponsePtr longer_path_response =
+      CreateBlobBodyResponse();
+  longer_path_response->url_list = {kLongerPathUrl};
+  EXPECT_TRUE(Put(longer_path_request, std::move(longer_path_response)));
+  EXPECT_TRUE(Put(body_request_with_query_, CreateBlobBodyResponseWithQuery()));
+
+  // Only the entry whose path matches exactly should be returned, even though
+  // the other entry's key starts with the same characters.
+  blink::mojom::CacheQueryOptionsPtr match_options =
+      blink::mojom::CacheQueryOptions::New();
+  match_options->ignore_search = true;
+  EXPECT_TRUE(Keys(body_request_, std::move(match_options)));
+  ASSERT_EQ(1u, callback_strings_.size());
+  EXPECT_EQ(kBodyUrlWithQuery.spec(), callback_strings_[0]);
+}
+
 TEST_P(CacheStorageCacheTestP, Keys_IgnoreMethod) {
   EXPECT_TRUE(Put(body_request_, CreateBlobBodyResponse()));
 
@@ -518,6 +518,7 @@ void StorageAreaImpl::GetAll(
   }
 
   std::vector<blink::mojom::KeyValuePtr> all;
+  all.reserve(keys_values_map_.size());
   for (const auto& it : keys_values_map_) {
     auto kv = blink::mojom::KeyValue::New();
     kv->key = it.first;
@@ -4,6 +4,8 @@
 
 #include "content/browser/frame_host/navigation_throttle_runner.h"
 
+#include "base/metrics/histogram_macros.h"
+#include "base/trace_event/trace_event.h"
 #include "content/browser/devtools/devtools_instrumentation.h"
 #include "content/browser/frame_host/ancestor_throttle.h"
 #include "content/browser/frame_host/blocked_scheme_navigation_throttle.h"
@@ -59,10 +61,13 @@ NavigationThrottleRunner::NavigationThrottleRunner(Delegate* delegate,
                                                    NavigationHandle* handle)
     : delegate_(delegate), handle_(handle), weak_factory_(this) {}
 
-NavigationThrottleRunner::~NavigationThrottleRunner() = default;
+NavigationThrottleRunner::~NavigationThrottleRunner() {
+  EndDeferral();
+}
 
 void NavigationThrottleRunner::ProcessNavigationEvent(Event event) {
   DCHECK_NE(Event::NoEvent, event);
+  EndDeferral();
   current_event_ = event;
   next_index_ = 0;
   ProcessInternal();
@@ -71,10 +76,12 @@ void NavigationThrottleRunner::ProcessNavigationEvent(Event event) {
 void NavigationThrottleRunner::ResumeProcessingNavigationEvent(
     NavigationThrottle* deferring_throttle) {
   DCHECK_EQ(GetDeferringThrottle(), deferring_throttle);
+  EndDeferral();
   ProcessInternal();
 }
 
 void NavigationThrottleRunner::CallResumeForTesting() {
+  EndDeferral();
   ProcessInternal();
 }
 
@@ -169,6 +176,11 @@ void NavigationThrottleRunner::ProcessInternal() {
 
       case NavigationThrottle::DEFER:
         next_index_ = i + 1;
+        defer_start_time_ = base::TimeTicks::Now();
+        TRACE_EVENT_ASYNC_BEGIN2("navigation", "NavigationThrottle::Defer",
+                                 this, "event", GetEventName(current_event_),
+                                 "throttle",
+                                 throttles_[i]->GetNameForLogging());
         return;
     }
   }
@@ -190,4 +202,13 @@ void NavigationThrottleRunner::InformDelegate(
   // deleted by the previous call.
 }
 
+void NavigationThrottleRunner::EndDeferral() {
+  if (defer_start_time_.is_null())
+    return;
+  UMA_HISTOGRAM_TIMES("Navigation.ThrottleDeferralTime",
+                      base::TimeTicks::Now() - defer_start_time_);
+  TRACE_EVENT_ASYNC_END0("navigation", "NavigationThrottle::Defer", this);
+  defer_start_time_ = base::TimeTicks();
+}
+
 }  // namespace content
@@ -8,6 +8,7 @@
 #include <stddef.h>
 
 #include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
 #include "content/public/browser/navigation_throttle.h"
 
 namespace content {
@@ -70,6 +71,10 @@ class CONTENT_EXPORT NavigationThrottleRunner {
   void ProcessInternal();
   void InformDelegate(const NavigationThrottle::ThrottleCheckResult& result);
 
+  // Records how long the navigation was deferred by the throttle at
+  // |next_index_ - 1|, if a deferral is in progress.
+  void EndDeferral();
+
   Delegate* delegate_;
 
   // The NavigationHandle associated with the NavigationThrottles this
@@ -88,6 +93,10 @@ class CONTENT_EXPORT NavigationThrottleRunner {
 
   // The event currently being processed.
   Event current_event_ = Event::NoEvent;
+
+  // When the current deferral started, or null if no throttle is deferring.
+  base::TimeTicks defer_start_time_;
+
   base::WeakPtrFactory<NavigationThrottleRunner> weak_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(NavigationThrottleRunner);
@@ -7,6 +7,7 @@
 #include "base/bind.h"
 #include "base/macros.h"
 #include "base/optional.h"
+#include "base/test/metrics/histogram_tester.h"
 #include "content/public/browser/navigation_throttle.h"
 #include "content/public/common/url_constants.h"
 #include "content/public/test/mock_navigation_handle.h"
@@ -233,6 +234,21 @@ TEST_P(NavigationThrottleRunnerTestWithEvent, ResumeDeferred) {
   EXPECT_EQ(event(), observer_last_event());
 }
 
+// Checks that the time a NavigationThrottle defers the navigation is recorded
+// once the navigation is resumed.
+TEST_P(NavigationThrottleRunnerTestWithEvent, RecordsDeferralTime) {
+  base::HistogramTester histogram_tester;
+  CreateTestNavigationThrottle(NavigationThrottle::DEFER);
+
+  SimulateEvent(event());
+  EXPECT_TRUE(is_deferring());
+  histogram_tester.ExpectTotalCount("Navigation.ThrottleDeferralTime", 0);
+
+  Resume();
+  EXPECT_FALSE(is_deferring());
+  histogram_tester.ExpectTotalCount("Navigation.ThrottleDeferralTime", 1);
+}
+
 // Checks that a NavigationThrottleRunner can be safely deleted by the execution
 // of one of its NavigationThrottle.
 TEST_P(NavigationThrottleRunnerTestWithEvent, DeletionByNavigationThrottle) {
@@ -267,15 +267,15 @@ leveldb::Status IndexedDBCursor::CursorPrefetchIterationOperation(
     found_keys.push_back(cursor_->key());
     found_primary_keys.push_back(cursor_->primary_key());
 
+    // IndexedDBValue has no move constructor, so swap the value into place
+    // rather than copying what may be megabytes of serialized bits.
+    found_values.emplace_back();
     switch (cursor_type_) {
       case indexed_db::CURSOR_KEY_ONLY:
-        found_values.push_back(IndexedDBValue());
         break;
       case indexed_db::CURSOR_KEY_AND_VALUE: {
-        IndexedDBValue value;
-        value.swap(*cursor_->value());
-        size_estimate += value.SizeEstimate();
-        found_values.push_back(value);
+        found_values.back().swap(*cursor_->value());
+        size_estimate += found_values.back().SizeEstimate();
         break;
       }
       default:
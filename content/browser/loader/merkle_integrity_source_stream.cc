@@ -83,12 +83,10 @@ std::string MerkleIntegritySourceStream::GetTypeAsString() const {
 bool MerkleIntegritySourceStream::FilterDataImpl(base::span<char>* output,
                                                  base::span<const char>* input,
                                                  bool upstream_eof_reached) {
-  std::string storage;
-
   // Process the record size in front, if we haven't yet.
   if (record_size_ == 0) {
     base::span<const char> bytes;
-    if (!ConsumeBytes(input, 8, &bytes, &storage)) {
+    if (!ConsumeBytes(input, 8, &bytes, &reassembled_input_)) {
       if (!upstream_eof_reached) {
         return true;  // Wait for more data later.
       }
@@ -125,7 +123,7 @@ bool MerkleIntegritySourceStream::FilterDataImpl(base::span<char>* output,
   while (!output->empty() && !final_record_done_) {
     base::span<const char> record;
     if (!ConsumeBytes(input, record_size_ + SHA256_DIGEST_LENGTH, &record,
-                      &storage)) {
+                      &reassembled_input_)) {
       DCHECK(input->empty());
       if (!upstream_eof_reached) {
         return true;  // Wait for more data later.
@@ -189,7 +187,9 @@ bool MerkleIntegritySourceStream::ConsumeBytes(base::span<const char>* input,
   if (partial_input_.size() < len) {
     return false;
   }
-  *storage = std::move(partial_input_);
+  // Swap rather than move, so that |partial_input_| keeps a buffer for the
+  // next block.
+  storage->swap(partial_input_);
   partial_input_.clear();
   *result = *storage;
   return true;
@@ -52,7 +52,7 @@ class CONTENT_EXPORT MerkleIntegritySourceStream
 
   // Consumes the next |len| bytes of data from |partial_input_| and |input|
   // and, if available, points |result| to it and returns true. |result| will
-  // point into either |input| or data copied to |storage|. |input| is advanced
+  // point into either |input| or data moved to |storage|. |input| is advanced
   // past any consumed bytes. If |len| bytes are not available, returns false
   // and fully consumes |input| |partial_input_| for a future call.
   bool ConsumeBytes(base::span<const char>* input,
@@ -70,6 +70,10 @@ class CONTENT_EXPORT MerkleIntegritySourceStream
 
   // The partial input block, if the previous input buffer was too small.
   std::string partial_input_;
+  // A block reassembled from |partial_input_| and the input, while it's
+  // processed. It swaps buffers with |partial_input_|, so that neither is
+  // reallocated for each record that spans several input buffers.
+  std::string reassembled_input_;
   // The partial output block, if the previous output buffer was too small.
   std::string partial_output_;
   // The index of |partial_output_| that has not been returned yet.
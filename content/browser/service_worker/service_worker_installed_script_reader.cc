@@ -118,6 +118,7 @@ void ServiceWorkerInstalledScriptReader::OnReadInfoComplete(
   mojo::ScopedDataPipeConsumerHandle meta_data_consumer;
   DCHECK_GE(http_info->response_data_size, 0);
   uint64_t body_size = http_info->response_data_size;
+  body_size_ = body_size;
   uint64_t meta_data_size = 0;
 
   MojoCreateDataPipeOptions options;
@@ -240,7 +241,10 @@ void ServiceWorkerInstalledScriptReader::OnResponseDataRead(int read_bytes) {
   DCHECK(body_handle_.is_valid());
   body_pending_write_ = nullptr;
   ServiceWorkerMetrics::CountReadResponseResult(ServiceWorkerMetrics::READ_OK);
-  if (read_bytes == 0) {
+  body_bytes_read_ += read_bytes;
+  // Stop once the recorded body size has been read, saving an extra read of
+  // the disk cache entry just to observe the end of the data.
+  if (read_bytes == 0 || body_bytes_read_ >= body_size_) {
     // All data has been read.
     body_watcher_.Cancel();
     body_handle_.reset();
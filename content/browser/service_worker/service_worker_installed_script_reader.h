@@ -5,6 +5,8 @@
 #ifndef CONTENT_BROWSER_SERVICE_WORKER_SERVICE_WORKER_INSTALLED_SCRIPT_READER_H_
 #define CONTENT_BROWSER_SERVICE_WORKER_SERVICE_WORKER_INSTALLED_SCRIPT_READER_H_
 
+#include <stdint.h>
+
 #include <memory>
 #include <string>
 
@@ -91,6 +93,11 @@ class ServiceWorkerInstalledScriptReader {
   mojo::ScopedDataPipeProducerHandle body_handle_;
   scoped_refptr<network::NetToMojoPendingBuffer> body_pending_write_;
   mojo::SimpleWatcher body_watcher_;
+  // The body size recorded with the script, and how much has been read so
+  // far. Once they match, the body is done without waiting for an
+  // end-of-data read.
+  uint64_t body_size_ = 0;
+  uint64_t body_bytes_read_ = 0;
 
   base::WeakPtrFactory<ServiceWorkerInstalledScriptReader> weak_factory_;
 };
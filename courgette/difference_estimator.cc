@@ -12,6 +12,7 @@
 #include <stdint.h>
 #include <string.h>
 
+#include <limits>
 #include <unordered_set>
 
 #include "base/macros.h"
@@ -103,6 +104,12 @@ DifferenceEstimator::Subject* DifferenceEstimator::MakeSubject(
 }
 
 size_t DifferenceEstimator::Measure(Base* base, Subject* subject) {
+  return MeasureWithBound(base, subject, std::numeric_limits<size_t>::max());
+}
+
+size_t DifferenceEstimator::MeasureWithBound(Base* base,
+                                             Subject* subject,
+                                             size_t bound) {
   size_t mismatches = 0;
   if (subject->region().length() >= kTupleSize) {
     const uint8_t* start = subject->region().start();
@@ -113,6 +120,9 @@ size_t DifferenceEstimator::Measure(Base* base, Subject* subject) {
       size_t hash = HashTuple(p);
       if (base->hashes_.find(hash) == base->hashes_.end()) {
         ++mismatches;
+        // The final result is |mismatches| + 1 or more, see below.
+        if (mismatches + 1 >= bound)
+          return mismatches + 1;
       }
       p += 1;
     }
@@ -50,6 +50,12 @@ class DifferenceEstimator {
   // are bytewise identical.
   size_t Measure(Base* base,  Subject* subject);
 
+  // Like Measure(), but stops as soon as the difference is known to be at
+  // least |bound|, returning some value >= |bound| in that case. Useful when
+  // searching for the best match, where only differences below the current
+  // best matter.
+  size_t MeasureWithBound(Base* base, Subject* subject, size_t bound);
+
  private:
   std::vector<Base*> owned_bases_;
   std::vector<Subject*> owned_subjects_;
@@ -56,3 +56,25 @@ TEST(DifferenceEstimatorTest, TestDifferentSubstring) {
       difference_estimator.MakeSubject(Region(kString2, sizeof(kString2)-1));
   EXPECT_EQ(1U, difference_estimator.Measure(base, subject));
 }
+
+TEST(DifferenceEstimatorTest, TestMeasureWithBound) {
+  static const char kString1[] = "Hello world";
+  static const char kString2[] = "Hello universe";
+  DifferenceEstimator difference_estimator;
+  DifferenceEstimator::Base* base =
+      difference_estimator.MakeBase(Region(kString1, sizeof(kString1)));
+  DifferenceEstimator::Subject* subject =
+      difference_estimator.MakeSubject(Region(kString2, sizeof(kString2)));
+  // A bound above the actual difference gives the exact result.
+  EXPECT_EQ(10U, difference_estimator.MeasureWithBound(base, subject, 11));
+  // Otherwise the search stops early with a result of at least the bound.
+  size_t bounded = difference_estimator.MeasureWithBound(base, subject, 4);
+  EXPECT_GE(bounded, 4U);
+  EXPECT_LE(bounded, 10U);
+
+  // Identical regions are still reported as zero.
+  const char kString3[] = "Hello world";
+  DifferenceEstimator::Subject* same =
+      difference_estimator.MakeSubject(Region(kString3, sizeof(kString3)));
+  EXPECT_EQ(0U, difference_estimator.MeasureWithBound(base, same, 1));
+}
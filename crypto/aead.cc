@@ -36,6 +36,9 @@ void Aead::Init(const std::string* key) {
   DCHECK(!key_);
   DCHECK_EQ(KeyLength(), key->size());
   key_ = key;
+  ctx_.reset(EVP_AEAD_CTX_new(aead_,
+                              reinterpret_cast<const uint8_t*>(key_->data()),
+                              key_->size(), EVP_AEAD_DEFAULT_TAG_LENGTH));
 }
 
 bool Aead::Seal(base::StringPiece plaintext,
@@ -44,13 +47,8 @@ bool Aead::Seal(base::StringPiece plaintext,
                 std::string* ciphertext) const {
   DCHECK(key_);
   DCHECK_EQ(NonceLength(), nonce.size());
-  EVP_AEAD_CTX ctx;
-
-  if (!EVP_AEAD_CTX_init(&ctx, aead_,
-                         reinterpret_cast<const uint8_t*>(key_->data()),
-                         key_->size(), EVP_AEAD_DEFAULT_TAG_LENGTH, nullptr)) {
+  if (!ctx_)
     return false;
-  }
 
   std::string result;
   const size_t max_output_length =
@@ -60,12 +58,11 @@ bool Aead::Seal(base::StringPiece plaintext,
       base::WriteInto(&result, max_output_length + 1));
 
   if (!EVP_AEAD_CTX_seal(
-          &ctx, out_ptr, &output_length, max_output_length,
+          ctx_.get(), out_ptr, &output_length, max_output_length,
           reinterpret_cast<const uint8_t*>(nonce.data()), nonce.size(),
           reinterpret_cast<const uint8_t*>(plaintext.data()), plaintext.size(),
           reinterpret_cast<const uint8_t*>(additional_data.data()),
           additional_data.size())) {
-    EVP_AEAD_CTX_cleanup(&ctx);
     return false;
   }
 
@@ -73,7 +70,6 @@ bool Aead::Seal(base::StringPiece plaintext,
   result.resize(output_length);
 
   ciphertext->swap(result);
-  EVP_AEAD_CTX_cleanup(&ctx);
 
   return true;
 }
@@ -83,13 +79,8 @@ bool Aead::Open(base::StringPiece ciphertext,
                 base::StringPiece additional_data,
                 std::string* plaintext) const {
   DCHECK(key_);
-  EVP_AEAD_CTX ctx;
-
-  if (!EVP_AEAD_CTX_init(&ctx, aead_,
-                         reinterpret_cast<const uint8_t*>(key_->data()),
-                         key_->size(), EVP_AEAD_DEFAULT_TAG_LENGTH, nullptr)) {
+  if (!ctx_)
     return false;
-  }
 
   std::string result;
   const size_t max_output_length = ciphertext.size();
@@ -98,13 +89,12 @@ bool Aead::Open(base::StringPiece ciphertext,
       base::WriteInto(&result, max_output_length + 1));
 
   if (!EVP_AEAD_CTX_open(
-          &ctx, out_ptr, &output_length, max_output_length,
+          ctx_.get(), out_ptr, &output_length, max_output_length,
           reinterpret_cast<const uint8_t*>(nonce.data()), nonce.size(),
           reinterpret_cast<const uint8_t*>(ciphertext.data()),
           ciphertext.size(),
           reinterpret_cast<const uint8_t*>(additional_data.data()),
           additional_data.size())) {
-    EVP_AEAD_CTX_cleanup(&ctx);
     return false;
   }
 
@@ -112,7 +102,6 @@ bool Aead::Open(base::StringPiece ciphertext,
   result.resize(output_length);
 
   plaintext->swap(result);
-  EVP_AEAD_CTX_cleanup(&ctx);
 
   return true;
 }
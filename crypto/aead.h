@@ -11,8 +11,7 @@
 
 #include "base/strings/string_piece.h"
 #include "crypto/crypto_export.h"
-
-struct evp_aead_st;
+#include "third_party/boringssl/src/include/openssl/base.h"
 
 namespace crypto {
 
@@ -25,6 +24,8 @@ class CRYPTO_EXPORT Aead {
 
   ~Aead();
 
+  // Sets the key used by Seal() and Open(). The key schedule is computed here
+  // once, rather than on every call.
   void Init(const std::string* key);
 
   bool Seal(base::StringPiece plaintext,
@@ -43,7 +44,10 @@ class CRYPTO_EXPORT Aead {
 
  private:
   const std::string* key_;
-  const evp_aead_st* aead_;
+  const EVP_AEAD* aead_;
+  // Set up from |key_| by Init(). Null if that failed, in which case Seal()
+  // and Open() fail.
+  bssl::UniquePtr<EVP_AEAD_CTX> ctx_;
 };
 
 }  // namespace crypto
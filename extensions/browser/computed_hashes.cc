@@ -4,6 +4,7 @@
 
 #include "extensions/browser/computed_hashes.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 
@@ -13,10 +14,8 @@
 #include "base/json/json_reader.h"
 #include "base/json/json_writer.h"
 #include "base/metrics/histogram_macros.h"
-#include "base/stl_util.h"
 #include "base/timer/elapsed_timer.h"
 #include "base/values.h"
-#include "crypto/secure_hash.h"
 #include "crypto/sha2.h"
 
 namespace extensions {
@@ -216,20 +215,17 @@ void ComputedHashes::ComputeHashesForContent(const std::string& contents,
                                              size_t block_size,
                                              std::vector<std::string>* hashes) {
   size_t offset = 0;
+  hashes->reserve(hashes->size() +
+                  std::max<size_t>(1, (contents.size() + block_size - 1) /
+                                          block_size));
   // Even when the contents is empty, we want to output at least one hash
   // block (the hash of the empty string).
   do {
-    const char* block_start = contents.data() + offset;
     DCHECK(offset <= contents.size());
     size_t bytes_to_read = std::min(contents.size() - offset, block_size);
-    std::unique_ptr<crypto::SecureHash> hash(
-        crypto::SecureHash::Create(crypto::SecureHash::SHA256));
-    hash->Update(block_start, bytes_to_read);
-
-    hashes->push_back(std::string());
-    std::string* buffer = &(hashes->back());
-    buffer->resize(crypto::kSHA256Length);
-    hash->Finish(base::data(*buffer), buffer->size());
+    // Hash each block in one shot rather than allocating a SecureHash for it.
+    hashes->push_back(crypto::SHA256HashString(
+        base::StringPiece(contents.data() + offset, bytes_to_read)));
 
     // If |contents| is empty, then we want to just exit here.
     if (bytes_to_read == 0)
@@ -312,8 +312,13 @@ std::set<const EventListener*> EventListenerMap::GetEventListeners(
       interested_listeners.insert(listener);
     }
   } else {
-    for (const auto& listener : listeners_[event.event_name])
-      interested_listeners.insert(listener.get());
+    // Use find() so that events nobody listens to do not add empty entries
+    // to |listeners_|.
+    auto it = listeners_.find(event.event_name);
+    if (it != listeners_.end()) {
+      for (const auto& listener : it->second)
+        interested_listeners.insert(listener.get());
+    }
   }
 
   return interested_listeners;
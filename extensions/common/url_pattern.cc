@@ -451,14 +451,18 @@ bool URLPattern::MatchesURL(const GURL& test) const {
   if (match_all_urls_)
     return true;
 
+  // Check the host and port before building the path, which allocates. Sets
+  // with many patterns reject most of them here.
+  if (!MatchesSecurityOriginHelper(*test_url))
+    return false;
+
   std::string path_for_request = test.PathForRequest();
   if (has_inner_url) {
     path_for_request = base::StringPrintf("%s%s", test_url->path_piece().data(),
                                           path_for_request.c_str());
   }
 
-  return MatchesSecurityOriginHelper(*test_url) &&
-         MatchesPath(path_for_request);
+  return MatchesPath(path_for_request);
 }
 
 bool URLPattern::MatchesSecurityOrigin(const GURL& test) const {
@@ -788,10 +792,11 @@ bool URLPattern::MatchesSecurityOriginHelper(const GURL& test) const {
   if (scheme_ != url::kFileScheme && !MatchesHost(test))
     return false;
 
-  if (!MatchesPortPattern(base::NumberToString(test.EffectiveIntPort())))
-    return false;
+  // Skip formatting the port when any port matches.
+  if (port_ == "*")
+    return true;
 
-  return true;
+  return MatchesPortPattern(base::NumberToString(test.EffectiveIntPort()));
 }
 
 bool URLPattern::MatchesPortPattern(base::StringPiece port) const {
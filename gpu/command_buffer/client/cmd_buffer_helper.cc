@@ -196,6 +196,11 @@ void CommandBufferHelper::OrderingBarrier() {
   if (put_ == total_entry_count_)
     put_ = 0;
 
+  // Nothing was added since the last barrier or flush, so the service already
+  // knows about every command up to put_.
+  if (put_ == last_ordering_barrier_put_)
+    return;
+
   if (HaveRingBuffer()) {
     last_ordering_barrier_put_ = put_;
     command_buffer_->OrderingBarrier(put_);
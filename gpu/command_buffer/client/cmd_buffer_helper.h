@@ -79,7 +79,8 @@ class GPU_EXPORT CommandBufferHelper {
 
   // Ensures that commands up to the put pointer will be processed in the
   // command buffer service before any future commands on other command buffers
-  // sharing a channel.
+  // sharing a channel. Does nothing if no commands were added since the last
+  // ordering barrier or flush.
   void OrderingBarrier();
 
   // Waits until all the commands have been executed. Returns whether it
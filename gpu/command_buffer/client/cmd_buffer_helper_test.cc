@@ -730,12 +730,13 @@ TEST_F(CommandBufferHelperTest, TestFlushToCommandBuffer) {
   EXPECT_EQ(flush_count3, flush_count2 + 1);
 }
 
-// Expect OrderingBarrier() to always call CommandBuffer::OrderingBarrier().
+// Expect OrderingBarrier() to call CommandBuffer::OrderingBarrier() only when
+// commands were added since the last barrier or flush.
 TEST_F(CommandBufferHelperTest, TestOrderingBarrierToCommandBuffer) {
   // Explicit flushing only.
   helper_->SetAutomaticFlushes(false);
 
-  int flush_count1, flush_count2, flush_count3;
+  int flush_count1, flush_count2, flush_count3, flush_count4, flush_count5;
 
   flush_count1 = command_buffer_->FlushCount();
   AddUniqueCommandWithExpect(error::kNoError, 2);
@@ -743,9 +744,34 @@ TEST_F(CommandBufferHelperTest, TestOrderingBarrierToCommandBuffer) {
   flush_count2 = command_buffer_->FlushCount();
   helper_->OrderingBarrier();
   flush_count3 = command_buffer_->FlushCount();
+  AddUniqueCommandWithExpect(error::kNoError, 2);
+  helper_->OrderingBarrier();
+  flush_count4 = command_buffer_->FlushCount();
+  helper_->Flush();
+  helper_->OrderingBarrier();
+  flush_count5 = command_buffer_->FlushCount();
 
   EXPECT_EQ(flush_count2, flush_count1 + 1);
-  EXPECT_EQ(flush_count3, flush_count2 + 1);
+  EXPECT_EQ(flush_count3, flush_count2);
+  EXPECT_EQ(flush_count4, flush_count3 + 1);
+  EXPECT_EQ(flush_count5, flush_count4 + 1);
+}
+
+// Expect redundant ordering barriers to leave the flush generation alone.
+TEST_F(CommandBufferHelperTest, TestRedundantOrderingBarrierFlushGeneration) {
+  // Explicit flushing only.
+  helper_->SetAutomaticFlushes(false);
+
+  AddUniqueCommandWithExpect(error::kNoError, 2);
+  helper_->OrderingBarrier();
+  uint32_t gen1 = GetHelperFlushGeneration();
+  helper_->OrderingBarrier();
+  uint32_t gen2 = GetHelperFlushGeneration();
+  EXPECT_EQ(gen2, gen1);
+
+  helper_->Finish();
+  Mock::VerifyAndClearExpectations(api_mock_.get());
+  EXPECT_EQ(error::kNoError, GetError());
 }
 
 TEST_F(CommandBufferHelperTest, TestWrapAroundAfterOrderingBarrier) {
@@ -34,6 +34,7 @@ FencedAllocator::FencedAllocator(uint32_t size, CommandBufferHelper* helper)
     : helper_(helper), bytes_in_use_(0) {
   Block block = { FREE, 0, RoundDown(size), kUnusedToken };
   blocks_.push_back(block);
+  free_blocks_.insert(std::make_pair(block.size, block.offset));
 }
 
 FencedAllocator::~FencedAllocator() {
@@ -44,8 +45,9 @@ FencedAllocator::~FencedAllocator() {
 }
 
 // Looks for a non-allocated block that is big enough. Search in the FREE
-// blocks first (for direct usage), first-fit, then in the FREE_PENDING_TOKEN
-// blocks, waiting for them. The current implementation isn't smart about
+// blocks first (for direct usage), best-fit, then reclaim the
+// FREE_PENDING_TOKEN blocks whose token has already passed, and only then wait
+// for the remaining ones. The current implementation isn't smart about
 // optimizing what to wait for, just looks inside the block in order (first-fit
 // as well).
 FencedAllocator::Offset FencedAllocator::Alloc(uint32_t size) {
@@ -62,12 +64,15 @@ FencedAllocator::Offset FencedAllocator::Alloc(uint32_t size) {
   }
 
   // Try first to allocate in a free block.
-  for (uint32_t i = 0; i < blocks_.size(); ++i) {
-    Block &block = blocks_[i];
-    if (block.state == FREE && block.size >= aligned_size) {
-      return AllocInBlock(i, aligned_size);
-    }
-  }
+  Offset offset = AllocInSmallestFreeBlock(aligned_size);
+  if (offset != kInvalidOffset)
+    return offset;
+
+  // Then in the blocks that don't need waiting anymore.
+  FreeUnused();
+  offset = AllocInSmallestFreeBlock(aligned_size);
+  if (offset != kInvalidOffset)
+    return offset;
 
   // No free block is available. Look for blocks pending tokens, and wait for
   // them to be re-usable.
@@ -111,13 +116,7 @@ void FencedAllocator::FreePendingToken(FencedAllocator::Offset offset,
 // Gets the max of the size of the blocks marked as free.
 uint32_t FencedAllocator::GetLargestFreeSize() {
   FreeUnused();
-  uint32_t max_size = 0;
-  for (uint32_t i = 0; i < blocks_.size(); ++i) {
-    Block &block = blocks_[i];
-    if (block.state == FREE)
-      max_size = std::max(max_size, block.size);
-  }
-  return max_size;
+  return free_blocks_.empty() ? 0 : free_blocks_.rbegin()->first;
 }
 
 // Gets the size of the largest segment of blocks that are either FREE or
@@ -154,8 +153,19 @@ uint32_t FencedAllocator::GetFreeSize() {
 // - there is at least one block.
 // - there are no contiguous FREE blocks (they should have been collapsed).
 // - the successive offsets match the block sizes, and they are in order.
+// - the FREE blocks are exactly the ones in the free block set.
 bool FencedAllocator::CheckConsistency() {
   if (blocks_.size() < 1) return false;
+  size_t free_block_count = 0;
+  for (const Block& block : blocks_) {
+    if (block.state != FREE)
+      continue;
+    if (!free_blocks_.count(std::make_pair(block.size, block.offset)))
+      return false;
+    ++free_block_count;
+  }
+  if (free_block_count != free_blocks_.size())
+    return false;
   for (uint32_t i = 0; i < blocks_.size() - 1; ++i) {
     Block &current = blocks_[i];
     Block &next = blocks_[i + 1];
@@ -193,6 +203,7 @@ FencedAllocator::BlockIndex FencedAllocator::CollapseFreeBlock(
   if (index + 1 < blocks_.size()) {
     Block &next = blocks_[index + 1];
     if (next.state == FREE) {
+      free_blocks_.erase(std::make_pair(next.size, next.offset));
       blocks_[index].size += next.size;
       blocks_.erase(blocks_.begin() + index + 1);
     }
@@ -200,11 +211,14 @@ FencedAllocator::BlockIndex FencedAllocator::CollapseFreeBlock(
   if (index > 0) {
     Block &prev = blocks_[index - 1];
     if (prev.state == FREE) {
+      free_blocks_.erase(std::make_pair(prev.size, prev.offset));
       prev.size += blocks_[index].size;
       blocks_.erase(blocks_.begin() + index);
       --index;
     }
   }
+  free_blocks_.insert(
+      std::make_pair(blocks_[index].size, blocks_[index].offset));
   return index;
 }
 
@@ -241,6 +255,7 @@ FencedAllocator::Offset FencedAllocator::AllocInBlock(BlockIndex index,
   DCHECK_EQ(block.state, FREE);
   Offset offset = block.offset;
   bytes_in_use_ += size;
+  free_blocks_.erase(std::make_pair(block.size, offset));
   if (block.size == size) {
     block.state = IN_USE;
     return offset;
@@ -248,11 +263,24 @@ FencedAllocator::Offset FencedAllocator::AllocInBlock(BlockIndex index,
   Block newblock = { FREE, offset + size, block.size - size, kUnusedToken};
   block.state = IN_USE;
   block.size = size;
+  free_blocks_.insert(std::make_pair(newblock.size, newblock.offset));
   // this is the last thing being done because it may invalidate block;
   blocks_.insert(blocks_.begin() + index + 1, newblock);
   return offset;
 }
 
+// The free block set is ordered by size, then offset, so the first entry that
+// is not smaller than |size| is the smallest block that fits, and the lowest
+// one among blocks of that size.
+FencedAllocator::Offset FencedAllocator::AllocInSmallestFreeBlock(
+    uint32_t size) {
+  FreeBlockSet::const_iterator it =
+      free_blocks_.lower_bound(std::make_pair(size, Offset(0)));
+  if (it == free_blocks_.end())
+    return kInvalidOffset;
+  return AllocInBlock(GetBlockByOffset(it->second), size);
+}
+
 // The blocks are in offset order, so we can do a binary search.
 FencedAllocator::BlockIndex FencedAllocator::GetBlockByOffset(Offset offset) {
   Block templ = { IN_USE, offset, 0, kUnusedToken };
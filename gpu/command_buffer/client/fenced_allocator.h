@@ -10,6 +10,8 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <set>
+#include <utility>
 #include <vector>
 
 #include "base/bind.h"
@@ -121,14 +123,18 @@ class GPU_EXPORT FencedAllocator {
 
   typedef std::vector<Block> Container;
   typedef uint32_t BlockIndex;
+  // (size, offset) of the FREE blocks, so that the smallest block that fits an
+  // allocation can be found without going over all the blocks.
+  typedef std::set<std::pair<uint32_t, Offset>> FreeBlockSet;
 
   static const int32_t kUnusedToken = 0;
 
   // Gets the index of a memory block, given its offset.
   BlockIndex GetBlockByOffset(Offset offset);
 
-  // Collapse a free block with its neighbours if they are free. Returns the
-  // index of the collapsed block.
+  // Collapse a block that was just marked FREE with its neighbours if they are
+  // free, and adds the result to the free block set. Returns the index of the
+  // collapsed block.
   // NOTE: this will invalidate block indices.
   BlockIndex CollapseFreeBlock(BlockIndex index);
 
@@ -144,8 +150,14 @@ class GPU_EXPORT FencedAllocator {
   // the other functions that return a block index).
   Offset AllocInBlock(BlockIndex index, uint32_t size);
 
+  // Allocates a block of memory inside the smallest FREE block that is big
+  // enough. Returns kInvalidOffset if there is no such block.
+  // NOTE: this will invalidate block indices.
+  Offset AllocInSmallestFreeBlock(uint32_t size);
+
   CommandBufferHelper *helper_;
   Container blocks_;
+  FreeBlockSet free_blocks_;
   uint32_t bytes_in_use_;
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(FencedAllocator);
@@ -7,6 +7,7 @@
 #include <stdint.h>
 
 #include <memory>
+#include <vector>
 
 #include "base/bind.h"
 #include "base/bind_helpers.h"
@@ -286,8 +287,8 @@ TEST_F(FencedAllocatorTest, TestGetLargestFreeSize) {
   EXPECT_EQ(kBufferSize - kSize, allocator_->GetLargestFreeSize());
 
   // Allocate 2 more buffers (now 3), and then free the first two. This is to
-  // ensure a hole. Note that this is dependent on the first-fit current
-  // implementation.
+  // ensure a hole. Note that this is dependent on the current implementation
+  // carving allocations from the start of the block it picks.
   FencedAllocator::Offset offset1 = allocator_->Alloc(kSize);
   ASSERT_NE(FencedAllocator::kInvalidOffset, offset1);
   FencedAllocator::Offset offset2 = allocator_->Alloc(kSize);
@@ -329,8 +330,8 @@ TEST_F(FencedAllocatorTest, TestGetLargestFreeOrPendingSize) {
   EXPECT_EQ(kBufferSize - kSize, allocator_->GetLargestFreeOrPendingSize());
 
   // Allocate 2 more buffers (now 3), and then free the first two. This is to
-  // ensure a hole. Note that this is dependent on the first-fit current
-  // implementation.
+  // ensure a hole. Note that this is dependent on the current implementation
+  // carving allocations from the start of the block it picks.
   FencedAllocator::Offset offset1 = allocator_->Alloc(kSize);
   ASSERT_NE(FencedAllocator::kInvalidOffset, offset1);
   FencedAllocator::Offset offset2 = allocator_->Alloc(kSize);
@@ -368,6 +369,103 @@ TEST_F(FencedAllocatorTest, TestGetLargestFreeOrPendingSize) {
   EXPECT_EQ(kBufferSize, allocator_->GetLargestFreeSize());
 }
 
+// Checks that allocations go to the smallest hole that fits, leaving the
+// larger holes of a fragmented buffer for larger allocations.
+TEST_F(FencedAllocatorTest, TestBestFitInFragmentedBuffer) {
+  const unsigned int kSize = 64;
+  const unsigned int kAllocCount = kBufferSize / kSize;
+  FencedAllocator::Offset offsets[kAllocCount];
+  for (unsigned int i = 0; i < kAllocCount; ++i) {
+    offsets[i] = allocator_->Alloc(kSize);
+    ASSERT_NE(FencedAllocator::kInvalidOffset, offsets[i]);
+  }
+
+  // Make a hole of 2 * kSize followed by a hole of kSize.
+  allocator_->Free(offsets[1]);
+  allocator_->Free(offsets[2]);
+  allocator_->Free(offsets[5]);
+  EXPECT_TRUE(allocator_->CheckConsistency());
+  EXPECT_EQ(2 * kSize, allocator_->GetLargestFreeSize());
+
+  // The small allocation fills the small hole, so that the large one still
+  // fits.
+  FencedAllocator::Offset small_offset = allocator_->Alloc(kSize);
+  EXPECT_EQ(offsets[5], small_offset);
+  FencedAllocator::Offset large_offset = allocator_->Alloc(2 * kSize);
+  EXPECT_EQ(offsets[1], large_offset);
+  EXPECT_EQ(0u, allocator_->GetLargestFreeSize());
+  EXPECT_TRUE(allocator_->CheckConsistency());
+
+  allocator_->Free(small_offset);
+  allocator_->Free(large_offset);
+  for (unsigned int i = 0; i < kAllocCount; ++i) {
+    if (i != 1 && i != 2 && i != 5)
+      allocator_->Free(offsets[i]);
+  }
+  EXPECT_FALSE(allocator_->InUseOrFreePending());
+}
+
+// Checks that blocks whose token has already passed are reused before waiting
+// for the other pending blocks.
+TEST_F(FencedAllocatorTest, TestAllocReclaimsPassedTokens) {
+  const unsigned int kSize = kBufferSize / 2;
+  FencedAllocator::Offset offset1 = allocator_->Alloc(kSize);
+  ASSERT_NE(FencedAllocator::kInvalidOffset, offset1);
+  FencedAllocator::Offset offset2 = allocator_->Alloc(kSize);
+  ASSERT_NE(FencedAllocator::kInvalidOffset, offset2);
+
+  // The second block waits for a token that has already passed, the first one
+  // for a token that isn't processed before the allocation.
+  int32_t token1 = helper_->InsertToken();
+  allocator_->FreePendingToken(offset2, token1);
+  helper_->Finish();
+  EXPECT_LE(token1, GetToken());
+  int32_t token2 = helper_->InsertToken();
+  allocator_->FreePendingToken(offset1, token2);
+
+  EXPECT_EQ(offset2, allocator_->Alloc(kSize));
+  EXPECT_GT(token2, GetToken());
+  EXPECT_EQ(FencedAllocator::FREE_PENDING_TOKEN,
+            allocator_->GetBlockStatusForTest(offset1, nullptr));
+  EXPECT_TRUE(allocator_->CheckConsistency());
+
+  allocator_->Free(offset1);
+  allocator_->Free(offset2);
+}
+
+// Interleaves allocations and frees of varying sizes, to fragment the buffer,
+// and checks that the book-keeping stays consistent.
+TEST_F(FencedAllocatorTest, TestFragmentation) {
+  const unsigned int kMaxAllocCount = kBufferSize / kAllocAlignment;
+  std::vector<FencedAllocator::Offset> offsets;
+  uint32_t seed = 1;
+  for (int i = 0; i < 1000; ++i) {
+    seed = seed * 1103515245 + 12345;
+    if (offsets.size() == kMaxAllocCount || (seed >> 16) % 3 == 0) {
+      if (offsets.empty())
+        continue;
+      size_t index = (seed >> 8) % offsets.size();
+      allocator_->Free(offsets[index]);
+      offsets.erase(offsets.begin() + index);
+    } else {
+      uint32_t size = 1 + (seed >> 12) % (4 * kAllocAlignment);
+      uint32_t largest_free_size = allocator_->GetLargestFreeSize();
+      FencedAllocator::Offset offset = allocator_->Alloc(size);
+      if (size <= largest_free_size) {
+        EXPECT_NE(FencedAllocator::kInvalidOffset, offset);
+        offsets.push_back(offset);
+      } else {
+        EXPECT_EQ(FencedAllocator::kInvalidOffset, offset);
+      }
+    }
+    ASSERT_TRUE(allocator_->CheckConsistency());
+  }
+
+  for (FencedAllocator::Offset offset : offsets)
+    allocator_->Free(offset);
+  EXPECT_FALSE(allocator_->InUseOrFreePending());
+}
+
 // Test fixture for FencedAllocatorWrapper test - Creates a
 // FencedAllocatorWrapper, using a CommandBufferHelper with a mock
 // AsyncAPIInterface for its interface (calling it directly, not through the
@@ -1100,7 +1100,20 @@ void RasterImplementation::RasterCHROMIUM(const cc::DisplayItemList* list,
 
   // TODO(enne): Tune these numbers
   static constexpr uint32_t kMinAlloc = 16 * 1024;
-  uint32_t free_size = std::max(GetTransferBufferFreeSize(), kMinAlloc);
+  static constexpr size_t kMaxEstimatedAlloc = 512 * 1024;
+  // Map enough space for the ops that will be serialized, going by their size
+  // in the record, so that a large record doesn't run out of space partway and
+  // get split over several RasterCHROMIUM commands.
+  const cc::PaintOpBuffer& buffer = list->paint_op_buffer_;
+  size_t estimated_size = 0u;
+  if (buffer.size()) {
+    estimated_size = std::min(
+        buffer.bytes_used() / buffer.size() * temp_raster_offsets_.size(),
+        kMaxEstimatedAlloc);
+  }
+  uint32_t free_size =
+      std::max({GetTransferBufferFreeSize(), kMinAlloc,
+                static_cast<uint32_t>(estimated_size)});
 
   // This section duplicates RasterSource::PlaybackToCanvas setup preamble.
   cc::PaintOpBufferSerializer::Preamble preamble;
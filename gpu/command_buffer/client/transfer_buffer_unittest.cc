@@ -117,7 +117,7 @@ TEST_F(TransferBufferTest, Free) {
       .Times(1)
       .RetiresOnSaturation();
   EXPECT_CALL(*command_buffer(), OrderingBarrier(_))
-      .Times(1)
+      .Times(AtMost(1))
       .RetiresOnSaturation();
   transfer_buffer_->Free();
   // See it's freed.
@@ -133,7 +133,7 @@ TEST_F(TransferBufferTest, Free) {
       .Times(1)
       .RetiresOnSaturation();
   EXPECT_CALL(*command_buffer(), OrderingBarrier(_))
-      .Times(1)
+      .Times(AtMost(1))
       .RetiresOnSaturation();
   transfer_buffer_->Free();
   // See it's freed.
@@ -151,7 +151,7 @@ TEST_F(TransferBufferTest, Free) {
       .Times(1)
       .RetiresOnSaturation();
   EXPECT_CALL(*command_buffer(), OrderingBarrier(_))
-      .Times(1)
+      .Times(AtMost(1))
       .RetiresOnSaturation();
   transfer_buffer_->Free();
   // See it's freed.
@@ -194,7 +194,7 @@ TEST_F(TransferBufferTest, Free) {
       .Times(1)
       .RetiresOnSaturation();
   EXPECT_CALL(*command_buffer(), OrderingBarrier(_))
-      .Times(1)
+      .Times(AtMost(1))
       .RetiresOnSaturation();
   transfer_buffer_->Free();
   transfer_buffer_->Free();
@@ -303,7 +303,7 @@ void TransferBufferExpandContractTest::TearDown() {
         .Times(1)
         .RetiresOnSaturation();
     EXPECT_CALL(*command_buffer(), OrderingBarrier(_))
-        .Times(1)
+        .Times(AtMost(1))
         .RetiresOnSaturation();
   }
   // For command buffer.
@@ -311,7 +311,7 @@ void TransferBufferExpandContractTest::TearDown() {
       .Times(1)
       .RetiresOnSaturation();
   EXPECT_CALL(*command_buffer(), OrderingBarrier(_))
-      .Times(1)
+      .Times(AtMost(1))
       .RetiresOnSaturation();
   EXPECT_CALL(*command_buffer(), Flush(_)).Times(1).RetiresOnSaturation();
   transfer_buffer_.reset();
@@ -337,7 +337,7 @@ TEST_F(TransferBufferExpandContractTest, ExpandWithSmallAllocations) {
         .Times(1)
         .RetiresOnSaturation();
     EXPECT_CALL(*command_buffer(), OrderingBarrier(_))
-        .Times(1)
+        .Times(AtMost(1))
         .RetiresOnSaturation();
     EXPECT_CALL(*command_buffer(), CreateTransferBuffer(size, _))
         .WillOnce(
@@ -434,7 +434,7 @@ TEST_F(TransferBufferExpandContractTest, ExpandWithLargeAllocations) {
         .Times(1)
         .RetiresOnSaturation();
     EXPECT_CALL(*command_buffer(), OrderingBarrier(_))
-        .Times(1)
+        .Times(AtMost(1))
         .RetiresOnSaturation();
     EXPECT_CALL(*command_buffer(), CreateTransferBuffer(size, _))
         .WillOnce(
@@ -484,7 +484,7 @@ TEST_F(TransferBufferExpandContractTest, ShrinkRingBuffer) {
         .Times(1)
         .RetiresOnSaturation();
     EXPECT_CALL(*command_buffer(), OrderingBarrier(_))
-        .Times(1)
+        .Times(AtMost(1))
         .RetiresOnSaturation();
     EXPECT_CALL(*command_buffer(), CreateTransferBuffer(size, _))
         .WillOnce(
@@ -526,7 +526,7 @@ TEST_F(TransferBufferExpandContractTest, Contract) {
       .Times(1)
       .RetiresOnSaturation();
   EXPECT_CALL(*command_buffer(), OrderingBarrier(_))
-      .Times(1)
+      .Times(AtMost(1))
       .RetiresOnSaturation();
   transfer_buffer_->Free();
   // See it's freed.
@@ -559,7 +559,7 @@ TEST_F(TransferBufferExpandContractTest, Contract) {
       .Times(1)
       .RetiresOnSaturation();
   EXPECT_CALL(*command_buffer(), OrderingBarrier(_))
-      .Times(1)
+      .Times(AtMost(1))
       .RetiresOnSaturation();
   transfer_buffer_->Free();
   // See it's freed.
@@ -586,7 +586,7 @@ TEST_F(TransferBufferExpandContractTest, OutOfMemory) {
       .Times(1)
       .RetiresOnSaturation();
   EXPECT_CALL(*command_buffer(), OrderingBarrier(_))
-      .Times(1)
+      .Times(AtMost(1))
       .RetiresOnSaturation();
   transfer_buffer_->Free();
   // See it's freed.
@@ -615,7 +615,7 @@ TEST_F(TransferBufferExpandContractTest, ReallocsToDefault) {
       .Times(1)
       .RetiresOnSaturation();
   EXPECT_CALL(*command_buffer(), OrderingBarrier(_))
-      .Times(1)
+      .Times(AtMost(1))
       .RetiresOnSaturation();
   transfer_buffer_->Free();
   // See it's freed.
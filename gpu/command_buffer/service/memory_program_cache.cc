@@ -496,6 +496,14 @@ void MemoryProgramCache::LoadProgram(const std::string& key,
   std::unique_ptr<GpuProgramProto> proto(
       GpuProgramProto::default_instance().New());
   if (proto->ParseFromString(program)) {
+    // A program that was linked or loaded since the cache was populated is at
+    // least as fresh as the one from the disk cache, and already has its place
+    // in the MRU order.
+    if (store_.Peek(proto->sha()) != store_.end())
+      return;
+    if (proto->program().length() > max_size_bytes())
+      return;
+
     AttributeMap vertex_attribs;
     UniformMap vertex_uniforms;
     VaryingMap vertex_varyings;
@@ -553,6 +561,10 @@ void MemoryProgramCache::LoadProgram(const std::string& key,
     std::vector<uint8_t> binary(proto->program().length());
     memcpy(binary.data(), proto->program().c_str(), proto->program().length());
 
+    // Like SaveLinkedProgram, keep the cache under its limit, so that loading
+    // a large disk cache doesn't grow it unbounded.
+    Trim(max_size_bytes() - binary.size());
+
     store_.Put(
         proto->sha(),
         new ProgramCacheValue(
@@ -8,6 +8,7 @@
 
 #include "base/bind.h"
 #include "base/callback.h"
+#include "base/metrics/histogram_macros.h"
 #include "base/single_thread_task_runner.h"
 #include "base/stl_util.h"
 #include "base/trace_event/trace_event.h"
@@ -37,6 +38,10 @@ Scheduler::SchedulingState::AsValue() const {
       new base::trace_event::TracedValue());
   state->SetInteger("sequence_id", sequence_id.GetUnsafeValue());
   state->SetString("priority", SchedulingPriorityToString(priority));
+  if (!deadline.is_max()) {
+    state->SetDouble("deadline_ms",
+                     (deadline - base::TimeTicks()).InMillisecondsF());
+  }
   state->SetInteger("order_num", order_num);
   return std::move(state);
 }
@@ -105,7 +110,8 @@ void Scheduler::Sequence::UpdateSchedulingPriority() {
 
 bool Scheduler::Sequence::NeedsRescheduling() const {
   return (running_state_ != IDLE &&
-          scheduling_state_.priority != current_priority()) ||
+          (scheduling_state_.priority != current_priority() ||
+           scheduling_state_.deadline != deadline_)) ||
          (running_state_ == SCHEDULED && !IsRunnable());
 }
 
@@ -139,10 +145,15 @@ Scheduler::SchedulingState Scheduler::Sequence::SetScheduled() {
   DCHECK(IsRunnable());
   DCHECK_NE(running_state_, RUNNING);
 
+  // The queue can be rebuilt while the sequence is scheduled, which shouldn't
+  // reset how long it has been waiting.
+  if (running_state_ == IDLE)
+    scheduled_time_ = base::TimeTicks::Now();
   running_state_ = SCHEDULED;
 
   scheduling_state_.sequence_id = sequence_id_;
   scheduling_state_.priority = current_priority();
+  scheduling_state_.deadline = deadline_;
   scheduling_state_.order_num = tasks_.front().order_num;
 
   return scheduling_state_;
@@ -151,6 +162,14 @@ Scheduler::SchedulingState Scheduler::Sequence::SetScheduled() {
 void Scheduler::Sequence::UpdateRunningPriority() {
   DCHECK_EQ(running_state_, RUNNING);
   scheduling_state_.priority = current_priority();
+  scheduling_state_.deadline = deadline_;
+}
+
+void Scheduler::Sequence::SetDeadline(base::TimeTicks deadline) {
+  if (deadline_ == deadline)
+    return;
+  deadline_ = deadline;
+  scheduler_->TryScheduleSequence(this);
 }
 
 void Scheduler::Sequence::ContinueTask(base::OnceClosure closure) {
@@ -166,12 +185,15 @@ uint32_t Scheduler::Sequence::ScheduleTask(base::OnceClosure closure) {
   return order_num;
 }
 
-uint32_t Scheduler::Sequence::BeginTask(base::OnceClosure* closure) {
+uint32_t Scheduler::Sequence::BeginTask(base::OnceClosure* closure,
+                                        base::TimeDelta* wait_time) {
   DCHECK(closure);
+  DCHECK(wait_time);
   DCHECK(!tasks_.empty());
   DCHECK_EQ(running_state_, SCHEDULED);
 
   running_state_ = RUNNING;
+  *wait_time = base::TimeTicks::Now() - scheduled_time_;
 
   *closure = std::move(tasks_.front().closure);
   uint32_t order_num = tasks_.front().order_num;
@@ -368,6 +390,15 @@ void Scheduler::ResetPriorityForClientWait(SequenceId sequence_id,
   sequence->RemoveClientWait(command_buffer_id);
 }
 
+void Scheduler::SetSequenceDeadline(SequenceId sequence_id,
+                                    base::TimeTicks deadline) {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  base::AutoLock auto_lock(lock_);
+  Sequence* sequence = GetSequence(sequence_id);
+  DCHECK(sequence);
+  sequence->SetDeadline(deadline);
+}
+
 void Scheduler::ScheduleTask(Task task) {
   base::AutoLock auto_lock(lock_);
   ScheduleTaskHelper(std::move(task));
@@ -517,8 +548,18 @@ void Scheduler::RunNextTask() {
   DCHECK(sequence);
 
   base::OnceClosure closure;
-  uint32_t order_num = sequence->BeginTask(&closure);
+  base::TimeDelta wait_time;
+  uint32_t order_num = sequence->BeginTask(&closure, &wait_time);
   DCHECK_EQ(order_num, state.order_num);
+  // How long the sequence was runnable but waited behind other sequences.
+  UMA_HISTOGRAM_CUSTOM_MICROSECONDS_TIMES(
+      "GPU.Scheduler.RunnableWaitTime", wait_time,
+      base::TimeDelta::FromMicroseconds(10), base::TimeDelta::FromSeconds(1),
+      50);
+  if (!state.deadline.is_max() && base::TimeTicks::Now() > state.deadline) {
+    TRACE_EVENT_INSTANT0("gpu", "Scheduler::MissedDeadline",
+                         TRACE_EVENT_SCOPE_THREAD);
+  }
 
   // Begin/FinishProcessingOrderNumber must be called with the lock released
   // because they can renter the scheduler in Enable/DisableSequence.
@@ -17,6 +17,7 @@
 #include "base/memory/weak_ptr.h"
 #include "base/synchronization/lock.h"
 #include "base/threading/thread_checker.h"
+#include "base/time/time.h"
 #include "gpu/command_buffer/common/command_buffer_id.h"
 #include "gpu/command_buffer/common/scheduling_priority.h"
 #include "gpu/command_buffer/common/sync_token.h"
@@ -76,6 +77,12 @@ class GPU_EXPORT Scheduler {
   void ResetPriorityForClientWait(SequenceId sequence_id,
                                   CommandBufferId command_buffer_id);
 
+  // Sets the time by which the tasks of the sequence should have run, e.g. the
+  // next frame deadline of the display compositor. Among sequences of the same
+  // priority, the one with the earliest deadline runs first, and running
+  // sequences yield to it. Pass base::TimeTicks::Max() to clear the deadline.
+  void SetSequenceDeadline(SequenceId sequence_id, base::TimeTicks deadline);
+
   // Schedules task (closure) to run on the sequence. The task is blocked until
   // the sync token fences are released or determined to be invalid. Tasks are
   // run in the order in which they are submitted.
@@ -103,8 +110,8 @@ class GPU_EXPORT Scheduler {
     ~SchedulingState();
 
     bool RunsBefore(const SchedulingState& other) const {
-      return std::tie(priority, order_num) <
-             std::tie(other.priority, other.order_num);
+      return std::tie(priority, deadline, order_num) <
+             std::tie(other.priority, other.deadline, other.order_num);
     }
 
     std::unique_ptr<base::trace_event::ConvertableToTraceFormat> AsValue()
@@ -112,6 +119,7 @@ class GPU_EXPORT Scheduler {
 
     SequenceId sequence_id;
     SchedulingPriority priority = SchedulingPriority::kLow;
+    base::TimeTicks deadline = base::TimeTicks::Max();
     uint32_t order_num = 0;
   };
 
@@ -155,11 +163,12 @@ class GPU_EXPORT Scheduler {
     // sequence used for inserting in the scheduling queue.
     SchedulingState SetScheduled();
 
-    // Update cached scheduling priority while running.
+    // Update cached scheduling priority and deadline while running.
     void UpdateRunningPriority();
 
     // Returns the next order number and closure. Sets running state to RUNNING.
-    uint32_t BeginTask(base::OnceClosure* closure);
+    // |wait_time| is set to how long the sequence was runnable before that.
+    uint32_t BeginTask(base::OnceClosure* closure, base::TimeDelta* wait_time);
 
     // Called after running the closure returned by BeginTask. Sets running
     // state to IDLE.
@@ -189,6 +198,9 @@ class GPU_EXPORT Scheduler {
 
     SchedulingPriority current_priority() const { return current_priority_; }
 
+    // Sets the deadline used for scheduling, see |SetSequenceDeadline|.
+    void SetDeadline(base::TimeTicks deadline);
+
    private:
     enum RunningState { IDLE, SCHEDULED, RUNNING };
 
@@ -275,6 +287,11 @@ class GPU_EXPORT Scheduler {
     const SchedulingPriority default_priority_;
     SchedulingPriority current_priority_;
 
+    base::TimeTicks deadline_ = base::TimeTicks::Max();
+
+    // When the sequence last went from IDLE to SCHEDULED.
+    base::TimeTicks scheduled_time_;
+
     scoped_refptr<SyncPointOrderData> order_data_;
 
     // Deque of tasks. Tasks are inserted at the back with increasing order
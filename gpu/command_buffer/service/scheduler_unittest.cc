@@ -7,6 +7,7 @@
 #include <algorithm>
 
 #include "base/bind.h"
+#include "base/test/metrics/histogram_tester.h"
 #include "base/test/test_simple_task_runner.h"
 #include "gpu/command_buffer/service/sync_point_manager.h"
 #include "testing/gmock/include/gmock/gmock.h"
@@ -396,6 +397,61 @@ TEST_F(SchedulerTest, ReleaseSequenceShouldYield) {
   release_state->Destroy();
 }
 
+TEST_F(SchedulerTest, SequencesOfSamePriorityRunInDeadlineOrder) {
+  base::HistogramTester histogram_tester;
+  base::TimeTicks now = base::TimeTicks::Now();
+  std::vector<int> tasks_executed;
+  SequenceId sequence_ids[3];
+  for (int i = 0; i < 3; ++i) {
+    sequence_ids[i] = scheduler()->CreateSequence(SchedulingPriority::kNormal);
+    scheduler()->ScheduleTask(Scheduler::Task(
+        sequence_ids[i], GetClosure([&, i] { tasks_executed.push_back(i); }),
+        std::vector<SyncToken>()));
+  }
+  // Sequences without a deadline run last, in order.
+  scheduler()->SetSequenceDeadline(sequence_ids[2],
+                                   now + base::TimeDelta::FromMilliseconds(8));
+  scheduler()->SetSequenceDeadline(sequence_ids[1],
+                                   now + base::TimeDelta::FromMilliseconds(16));
+
+  while (task_runner()->HasPendingTask())
+    task_runner()->RunPendingTasks();
+
+  EXPECT_THAT(tasks_executed, testing::ElementsAre(2, 1, 0));
+  histogram_tester.ExpectTotalCount("GPU.Scheduler.RunnableWaitTime", 3);
+}
+
+TEST_F(SchedulerTest, SequenceWithDeadlineShouldYield) {
+  SequenceId sequence_id1 =
+      scheduler()->CreateSequence(SchedulingPriority::kNormal);
+  SequenceId sequence_id2 =
+      scheduler()->CreateSequence(SchedulingPriority::kNormal);
+
+  bool ran1 = false;
+  scheduler()->ScheduleTask(Scheduler::Task(
+      sequence_id1, GetClosure([&] {
+        EXPECT_FALSE(scheduler()->ShouldYield(sequence_id1));
+        scheduler()->SetSequenceDeadline(
+            sequence_id2,
+            base::TimeTicks::Now() + base::TimeDelta::FromMilliseconds(16));
+        EXPECT_TRUE(scheduler()->ShouldYield(sequence_id1));
+        ran1 = true;
+      }),
+      std::vector<SyncToken>()));
+
+  bool ran2 = false;
+  scheduler()->ScheduleTask(Scheduler::Task(
+      sequence_id2, GetClosure([&] { ran2 = true; }),
+      std::vector<SyncToken>()));
+
+  task_runner()->RunPendingTasks();
+  EXPECT_TRUE(ran1);
+  EXPECT_FALSE(ran2);
+
+  task_runner()->RunPendingTasks();
+  EXPECT_TRUE(ran2);
+}
+
 TEST_F(SchedulerTest, ReentrantEnableSequenceShouldNotDeadlock) {
   SequenceId sequence_id1 =
       scheduler()->CreateSequence(SchedulingPriority::kHigh);
@@ -168,6 +168,15 @@ IPC_MESSAGE_ROUTED2(
     GpuChannelMsg_ScheduleImageDecode_Params /* decode_params */,
     uint64_t /* decode_release_count */)
 
+// Schedules a batch of hardware-accelerated image decodes with a single IPC.
+// The i-th decode in |decode_params| releases the decode sync token with
+// release count |first_decode_release_count| + i, so the batch must have been
+// allocated consecutive release counts on the client side.
+IPC_MESSAGE_ROUTED2(
+    GpuChannelMsg_ScheduleImageDecodeBatch,
+    std::vector<GpuChannelMsg_ScheduleImageDecode_Params> /* decode_params */,
+    uint64_t /* first_decode_release_count */)
+
 // Crash the GPU process in similar way to how chrome://gpucrash does.
 // This is only supported in testing environments, and is otherwise ignored.
 IPC_MESSAGE_CONTROL0(GpuChannelMsg_CrashForTesting)
@@ -11,6 +11,8 @@
 #include "base/feature_list.h"
 #include "base/location.h"
 #include "base/logging.h"
+#include "base/metrics/histogram_macros.h"
+#include "base/numerics/checked_math.h"
 #include "base/single_thread_task_runner.h"
 #include "gpu/command_buffer/common/constants.h"
 #include "gpu/command_buffer/common/context_result.h"
@@ -68,6 +70,8 @@ bool ImageDecodeAcceleratorStub::OnMessageReceived(const IPC::Message& msg) {
   IPC_BEGIN_MESSAGE_MAP(ImageDecodeAcceleratorStub, msg)
     IPC_MESSAGE_HANDLER(GpuChannelMsg_ScheduleImageDecode,
                         OnScheduleImageDecode)
+    IPC_MESSAGE_HANDLER(GpuChannelMsg_ScheduleImageDecodeBatch,
+                        OnScheduleImageDecodeBatch)
     IPC_MESSAGE_UNHANDLED(handled = false)
   IPC_END_MESSAGE_MAP()
   return handled;
@@ -94,13 +98,55 @@ void ImageDecodeAcceleratorStub::OnScheduleImageDecode(
     // The channel is no longer available, so don't do anything.
     return;
   }
+  UMA_HISTOGRAM_COUNTS_100("GPU.ImageDecodeAccelerator.BatchSize", 1);
+  ScheduleImageDecode(decode_params, release_count);
+}
+
+void ImageDecodeAcceleratorStub::OnScheduleImageDecodeBatch(
+    const std::vector<GpuChannelMsg_ScheduleImageDecode_Params>& decode_params,
+    uint64_t first_release_count) {
+  DCHECK(io_task_runner_->BelongsToCurrentThread());
+  base::AutoLock lock(lock_);
+  if (!channel_ || destroying_channel_) {
+    // The channel is no longer available, so don't do anything.
+    return;
+  }
+
+  if (decode_params.empty()) {
+    DLOG(ERROR) << "Empty decode batch";
+    OnError();
+    return;
+  }
+  base::CheckedNumeric<uint64_t> last_release_count = first_release_count;
+  last_release_count += decode_params.size() - 1u;
+  if (!last_release_count.IsValid()) {
+    DLOG(ERROR) << "Decode sync token release count overflow";
+    OnError();
+    return;
+  }
+
+  UMA_HISTOGRAM_COUNTS_100("GPU.ImageDecodeAccelerator.BatchSize",
+                           decode_params.size());
+  for (size_t i = 0; i < decode_params.size(); i++) {
+    if (!ScheduleImageDecode(decode_params[i], first_release_count + i))
+      return;
+  }
+}
+
+bool ImageDecodeAcceleratorStub::ScheduleImageDecode(
+    GpuChannelMsg_ScheduleImageDecode_Params decode_params,
+    uint64_t release_count) {
+  DCHECK(io_task_runner_->BelongsToCurrentThread());
+  lock_.AssertAcquired();
+  DCHECK(channel_);
+  DCHECK(!destroying_channel_);
 
   // Make sure the decode sync token is ordered with respect to the last decode
   // request.
   if (release_count <= last_release_count_) {
     DLOG(ERROR) << "Out-of-order decode sync token";
     OnError();
-    return;
+    return false;
   }
   last_release_count_ = release_count;
 
@@ -108,7 +154,7 @@ void ImageDecodeAcceleratorStub::OnScheduleImageDecode(
   if (decode_params.output_size.IsEmpty()) {
     DLOG(ERROR) << "Output dimensions are too small";
     OnError();
-    return;
+    return false;
   }
 
   // Start the actual decode.
@@ -128,13 +174,15 @@ void ImageDecodeAcceleratorStub::OnScheduleImageDecode(
       sequence_,
       base::BindOnce(&ImageDecodeAcceleratorStub::ProcessCompletedDecode,
                      base::WrapRefCounted(this), std::move(decode_params),
-                     release_count),
+                     release_count, base::TimeTicks::Now()),
       {discardable_handle_sync_token} /* sync_token_fences */));
+  return true;
 }
 
 void ImageDecodeAcceleratorStub::ProcessCompletedDecode(
     GpuChannelMsg_ScheduleImageDecode_Params params,
-    uint64_t decode_release_count) {
+    uint64_t decode_release_count,
+    base::TimeTicks schedule_time) {
   DCHECK(main_task_runner_->BelongsToCurrentThread());
   base::AutoLock lock(lock_);
   if (!channel_ || destroying_channel_) {
@@ -214,6 +262,8 @@ void ImageDecodeAcceleratorStub::ProcessCompletedDecode(
   // All done! The decoded image can now be used for rasterization, so we can
   // release the decode sync token.
   sync_point_client_state_->ReleaseFenceSync(decode_release_count);
+  UMA_HISTOGRAM_TIMES("GPU.ImageDecodeAccelerator.EndToEndTime",
+                      base::TimeTicks::Now() - schedule_time);
 
   // If there are no more completed decodes to be processed, we can disable the
   // sequence: when the next decode is completed, the sequence will be
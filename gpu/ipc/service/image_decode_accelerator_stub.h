@@ -17,6 +17,7 @@
 #include "base/memory/scoped_refptr.h"
 #include "base/synchronization/lock.h"
 #include "base/thread_annotations.h"
+#include "base/time/time.h"
 #include "gpu/command_buffer/service/sequence_id.h"
 #include "gpu/ipc/common/gpu_messages.h"
 #include "third_party/skia/include/core/SkImageInfo.h"
@@ -74,10 +75,27 @@ class ImageDecodeAcceleratorStub
       const GpuChannelMsg_ScheduleImageDecode_Params& params,
       uint64_t release_count);
 
+  // Handles a GpuChannelMsg_ScheduleImageDecodeBatch: all the decodes in
+  // |params| are validated and handed to the |worker_| under a single
+  // acquisition of |lock_|. The i-th decode uses release count
+  // |first_release_count| + i.
+  void OnScheduleImageDecodeBatch(
+      const std::vector<GpuChannelMsg_ScheduleImageDecode_Params>& params,
+      uint64_t first_release_count);
+
+  // Validates |params| and |release_count|, starts the decode and schedules
+  // the task that releases the decode sync token. Returns false (after calling
+  // OnError()) if the request is invalid.
+  bool ScheduleImageDecode(GpuChannelMsg_ScheduleImageDecode_Params params,
+                           uint64_t release_count)
+      EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
   // Creates the service-side cache entry for a completed decode and releases
-  // the decode sync token.
+  // the decode sync token. |schedule_time| is when the decode request was
+  // received and is used to record the end-to-end decode latency.
   void ProcessCompletedDecode(GpuChannelMsg_ScheduleImageDecode_Params params,
-                              uint64_t decode_release_count);
+                              uint64_t decode_release_count,
+                              base::TimeTicks schedule_time);
 
   // The |worker_| calls this when a decode is completed. If the decode is
   // successful (i.e., |output| is not empty), |sequence_| will be enabled so
@@ -16,6 +16,7 @@
 #include "base/memory/scoped_refptr.h"
 #include "base/memory/weak_ptr.h"
 #include "base/numerics/checked_math.h"
+#include "base/test/metrics/histogram_tester.h"
 #include "base/test/scoped_feature_list.h"
 #include "base/test/test_simple_task_runner.h"
 #include "cc/paint/image_transfer_cache_entry.h"
@@ -323,6 +324,60 @@ class ImageDecodeAcceleratorStubTest : public GpuChannelTestCommon {
     return decode_sync_token;
   }
 
+  // Like SendDecodeRequest() but sends a single
+  // GpuChannelMsg_ScheduleImageDecodeBatch with one decode per entry in
+  // |output_sizes|. The i-th decode uses |first_decode_release_count| + i,
+  // |first_transfer_cache_entry_id| + i, and |first_handle_release_count| + i.
+  // Returns the decode sync tokens, or an empty vector if the channel does not
+  // exist or a discardable handle can't be created.
+  std::vector<SyncToken> SendDecodeBatchRequest(
+      const std::vector<gfx::Size>& output_sizes,
+      uint64_t first_decode_release_count,
+      uint32_t first_transfer_cache_entry_id,
+      uint64_t first_handle_release_count) {
+    GpuChannel* channel = channel_manager()->LookupChannel(kChannelId);
+    if (!channel)
+      return std::vector<SyncToken>();
+
+    std::vector<SyncToken> decode_sync_tokens;
+    std::vector<GpuChannelMsg_ScheduleImageDecode_Params> batch_params;
+    for (size_t i = 0; i < output_sizes.size(); i++) {
+      decode_sync_tokens.emplace_back(
+          CommandBufferNamespace::GPU_IO,
+          CommandBufferIdFromChannelAndRoute(
+              kChannelId,
+              static_cast<int32_t>(
+                  GpuChannelReservedRoutes::kImageDecodeAccelerator)),
+          first_decode_release_count + i);
+
+      const uint64_t handle_release_count = first_handle_release_count + i;
+      ClientDiscardableHandle handle =
+          CreateDiscardableHandle(handle_release_count);
+      if (!handle.IsValid())
+        return std::vector<SyncToken>();
+
+      GpuChannelMsg_ScheduleImageDecode_Params decode_params;
+      decode_params.encoded_data = std::vector<uint8_t>();
+      decode_params.output_size = output_sizes[i];
+      decode_params.raster_decoder_route_id = kCommandBufferRouteId;
+      decode_params.transfer_cache_entry_id =
+          first_transfer_cache_entry_id + i;
+      decode_params.discardable_handle_shm_id = handle.shm_id();
+      decode_params.discardable_handle_shm_offset = handle.byte_offset();
+      decode_params.discardable_handle_release_count = handle_release_count;
+      decode_params.target_color_space = gfx::ColorSpace();
+      decode_params.needs_mips = false;
+      batch_params.push_back(std::move(decode_params));
+    }
+
+    HandleMessage(channel,
+                  new GpuChannelMsg_ScheduleImageDecodeBatch(
+                      static_cast<int32_t>(
+                          GpuChannelReservedRoutes::kImageDecodeAccelerator),
+                      batch_params, first_decode_release_count));
+    return decode_sync_tokens;
+  }
+
   void RunTasksUntilIdle() {
     while (task_runner()->HasPendingTask() ||
            io_task_runner()->HasPendingTask()) {
@@ -541,6 +596,90 @@ TEST_F(ImageDecodeAcceleratorStubTest, OutOfOrderDecodeSyncTokens) {
   CheckTransferCacheEntries({});
 }
 
+// Tests that all the decodes in a batch are started and that their sync tokens
+// are released in order as the decodes complete. Also checks that the batch
+// size and the end-to-end decode time are recorded.
+TEST_F(ImageDecodeAcceleratorStubTest, BatchedDecodes) {
+  base::HistogramTester histogram_tester;
+  {
+    InSequence call_sequence;
+    EXPECT_CALL(image_decode_accelerator_worker_, DoDecode(gfx::Size(100, 100)))
+        .Times(1);
+    EXPECT_CALL(image_decode_accelerator_worker_, DoDecode(gfx::Size(200, 200)))
+        .Times(1);
+    EXPECT_CALL(image_decode_accelerator_worker_, DoDecode(gfx::Size(300, 300)))
+        .Times(1);
+  }
+  const std::vector<SyncToken> decode_sync_tokens = SendDecodeBatchRequest(
+      {gfx::Size(100, 100), gfx::Size(200, 200), gfx::Size(300, 300)},
+      1u /* first_decode_release_count */,
+      1u /* first_transfer_cache_entry_id */,
+      1u /* first_handle_release_count */);
+  ASSERT_EQ(3u, decode_sync_tokens.size());
+  histogram_tester.ExpectUniqueSample("GPU.ImageDecodeAccelerator.BatchSize",
+                                      3, 1);
+
+  // A decode sync token should not be released before a decode is finished.
+  RunTasksUntilIdle();
+  for (const auto& sync_token : decode_sync_tokens)
+    EXPECT_FALSE(sync_point_manager()->IsSyncTokenReleased(sync_token));
+
+  // Only the first decode sync token should be released after the first decode
+  // is finished.
+  image_decode_accelerator_worker_.FinishOneDecode(true);
+  RunTasksUntilIdle();
+  EXPECT_TRUE(sync_point_manager()->IsSyncTokenReleased(decode_sync_tokens[0]));
+  EXPECT_FALSE(
+      sync_point_manager()->IsSyncTokenReleased(decode_sync_tokens[1]));
+  EXPECT_FALSE(
+      sync_point_manager()->IsSyncTokenReleased(decode_sync_tokens[2]));
+
+  // The remaining decodes can complete together.
+  image_decode_accelerator_worker_.FinishOneDecode(true);
+  image_decode_accelerator_worker_.FinishOneDecode(true);
+  RunTasksUntilIdle();
+  for (const auto& sync_token : decode_sync_tokens)
+    EXPECT_TRUE(sync_point_manager()->IsSyncTokenReleased(sync_token));
+  histogram_tester.ExpectTotalCount("GPU.ImageDecodeAccelerator.EndToEndTime",
+                                    3);
+
+  // The channel should still exist at the end.
+  EXPECT_TRUE(channel_manager()->LookupChannel(kChannelId));
+
+  // Check that the decoded images are in the transfer cache.
+  CheckTransferCacheEntries({SkISize::Make(100, 100), SkISize::Make(200, 200),
+                             SkISize::Make(300, 300)});
+}
+
+// Tests that a batch whose release counts overlap an earlier decode destroys
+// the channel.
+TEST_F(ImageDecodeAcceleratorStubTest, OutOfOrderBatchedDecodeSyncTokens) {
+  EXPECT_CALL(image_decode_accelerator_worker_, DoDecode(gfx::Size(100, 100)))
+      .Times(1);
+  const SyncToken decode1_sync_token = SendDecodeRequest(
+      gfx::Size(100, 100) /* output_size */, 2u /* decode_release_count */,
+      1u /* transfer_cache_entry_id */, 1u /* handle_release_count */);
+  ASSERT_TRUE(decode1_sync_token.HasData());
+
+  const std::vector<SyncToken> decode_sync_tokens = SendDecodeBatchRequest(
+      {gfx::Size(200, 200), gfx::Size(300, 300)},
+      1u /* first_decode_release_count */,
+      2u /* first_transfer_cache_entry_id */,
+      2u /* first_handle_release_count */);
+  ASSERT_EQ(2u, decode_sync_tokens.size());
+
+  // We expect the destruction of the ImageDecodeAcceleratorStub, which also
+  // implies that all decode sync tokens should be released.
+  RunTasksUntilIdle();
+  EXPECT_FALSE(channel_manager()->LookupChannel(kChannelId));
+  EXPECT_TRUE(sync_point_manager()->IsSyncTokenReleased(decode1_sync_token));
+  for (const auto& sync_token : decode_sync_tokens)
+    EXPECT_TRUE(sync_point_manager()->IsSyncTokenReleased(sync_token));
+
+  // We expect no entries in the transfer cache.
+  CheckTransferCacheEntries({});
+}
+
 TEST_F(ImageDecodeAcceleratorStubTest, ZeroReleaseCountDecodeSyncToken) {
   const SyncToken decode_sync_token = SendDecodeRequest(
       gfx::Size(100, 100) /* output_size */, 0u /* decode_release_count */,
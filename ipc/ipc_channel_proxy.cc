@@ -231,6 +231,22 @@ void ChannelProxy::Context::OnSendMessage(std::unique_ptr<Message> message) {
     OnChannelError();
 }
 
+// Called on the IPC::Channel thread
+void ChannelProxy::Context::FlushOutgoingMessages() {
+  std::vector<std::unique_ptr<Message>> messages;
+  {
+    base::AutoLock l(outgoing_messages_lock_);
+    DCHECK(!outgoing_message_batches_.empty());
+    messages = std::move(outgoing_message_batches_.front());
+    outgoing_message_batches_.pop_front();
+    if (outgoing_message_batches_.empty())
+      outgoing_batch_open_ = false;
+  }
+
+  for (auto& message : messages)
+    OnSendMessage(std::move(message));
+}
+
 // Called on the IPC::Channel thread
 void ChannelProxy::Context::OnAddFilter() {
   // Our OnChannelConnected method has not yet been called, so we can't be
@@ -296,8 +312,7 @@ void ChannelProxy::Context::OnRemoveFilter(MessageFilter* filter) {
 void ChannelProxy::Context::AddFilter(MessageFilter* filter) {
   base::AutoLock auto_lock(pending_filters_lock_);
   pending_filters_.push_back(base::WrapRefCounted(filter));
-  ipc_task_runner_->PostTask(FROM_HERE,
-                             base::BindOnce(&Context::OnAddFilter, this));
+  PostIPCTask(base::BindOnce(&Context::OnAddFilter, this));
 }
 
 // Called on the listener's thread
@@ -384,9 +399,30 @@ void ChannelProxy::Context::AddGenericAssociatedInterfaceForIOThread(
 }
 
 void ChannelProxy::Context::Send(Message* message) {
-  ipc_task_runner()->PostTask(
-      FROM_HERE, base::BindOnce(&ChannelProxy::Context::OnSendMessage, this,
-                                base::WrapUnique(message)));
+  bool needs_flush = false;
+  {
+    base::AutoLock l(outgoing_messages_lock_);
+    if (!outgoing_batch_open_) {
+      outgoing_message_batches_.emplace_back();
+      outgoing_batch_open_ = true;
+      needs_flush = true;
+    }
+    outgoing_message_batches_.back().push_back(base::WrapUnique(message));
+  }
+
+  if (needs_flush) {
+    ipc_task_runner()->PostTask(
+        FROM_HERE,
+        base::BindOnce(&ChannelProxy::Context::FlushOutgoingMessages, this));
+  }
+}
+
+void ChannelProxy::Context::PostIPCTask(base::OnceClosure task) {
+  {
+    base::AutoLock l(outgoing_messages_lock_);
+    outgoing_batch_open_ = false;
+  }
+  ipc_task_runner()->PostTask(FROM_HERE, std::move(task));
 }
 
 //-----------------------------------------------------------------------------
@@ -483,18 +519,16 @@ void ChannelProxy::Init(std::unique_ptr<ChannelFactory> factory,
 }
 
 void ChannelProxy::Pause() {
-  context_->ipc_task_runner()->PostTask(
-      FROM_HERE, base::BindOnce(&Context::PauseChannel, context_));
+  context_->PostIPCTask(base::BindOnce(&Context::PauseChannel, context_));
 }
 
 void ChannelProxy::Unpause(bool flush) {
-  context_->ipc_task_runner()->PostTask(
-      FROM_HERE, base::BindOnce(&Context::UnpauseChannel, context_, flush));
+  context_->PostIPCTask(
+      base::BindOnce(&Context::UnpauseChannel, context_, flush));
 }
 
 void ChannelProxy::Flush() {
-  context_->ipc_task_runner()->PostTask(
-      FROM_HERE, base::BindOnce(&Context::FlushChannel, context_));
+  context_->PostIPCTask(base::BindOnce(&Context::FlushChannel, context_));
 }
 
 void ChannelProxy::Close() {
@@ -506,8 +540,7 @@ void ChannelProxy::Close() {
   context_->Clear();
 
   if (context_->ipc_task_runner()) {
-    context_->ipc_task_runner()->PostTask(
-        FROM_HERE, base::BindOnce(&Context::OnChannelClosed, context_));
+    context_->PostIPCTask(base::BindOnce(&Context::OnChannelClosed, context_));
   }
 }
 
@@ -547,9 +580,8 @@ void ChannelProxy::AddFilter(MessageFilter* filter) {
 void ChannelProxy::RemoveFilter(MessageFilter* filter) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
-  context_->ipc_task_runner()->PostTask(
-      FROM_HERE, base::BindOnce(&Context::OnRemoveFilter, context_,
-                                base::RetainedRef(filter)));
+  context_->PostIPCTask(base::BindOnce(&Context::OnRemoveFilter, context_,
+                                       base::RetainedRef(filter)));
 }
 
 void ChannelProxy::AddGenericAssociatedInterfaceForIOThread(
@@ -15,6 +15,7 @@
 #include "base/bind.h"
 #include "base/callback.h"
 #include "base/component_export.h"
+#include "base/containers/circular_deque.h"
 #include "base/memory/ref_counted.h"
 #include "base/sequence_checker.h"
 #include "base/synchronization/lock.h"
@@ -272,6 +273,10 @@ class COMPONENT_EXPORT(IPC) ChannelProxy : public Sender {
     // Sends |message| from appropriate thread.
     void Send(Message* message);
 
+    // Posts |task| to the IPC thread such that it runs after every message
+    // previously passed to Send() has been handed to the channel.
+    void PostIPCTask(base::OnceClosure task);
+
    protected:
     friend class base::RefCountedThreadSafe<Context>;
     ~Context() override;
@@ -313,6 +318,7 @@ class COMPONENT_EXPORT(IPC) ChannelProxy : public Sender {
 
     // Methods called on the IO thread.
     void OnSendMessage(std::unique_ptr<Message> message_ptr);
+    void FlushOutgoingMessages();
     void OnAddFilter();
     void OnRemoveFilter(MessageFilter* filter);
 
@@ -379,6 +385,17 @@ class COMPONENT_EXPORT(IPC) ChannelProxy : public Sender {
     base::Lock pending_io_thread_interfaces_lock_;
     std::vector<std::pair<std::string, GenericAssociatedInterfaceFactory>>
         pending_io_thread_interfaces_;
+
+    // Messages passed to Send() which have not yet reached the IPC thread.
+    // Each batch is drained by a single FlushOutgoingMessages() task, so a
+    // burst of Send() calls costs one thread hop instead of one per message.
+    // The last batch stays open for new messages until its flush task runs or
+    // PostIPCTask() closes it, which keeps messages ordered with respect to
+    // other tasks posted to the IPC thread.
+    base::Lock outgoing_messages_lock_;
+    base::circular_deque<std::vector<std::unique_ptr<Message>>>
+        outgoing_message_batches_;
+    bool outgoing_batch_open_ = false;
   };
 
   Context* context() { return context_.get(); }
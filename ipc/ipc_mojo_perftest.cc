@@ -41,6 +41,7 @@ class PerformanceChannelListener : public Listener {
         msg_count_(0),
         msg_size_(0),
         sync_(false),
+        burst_(false),
         count_down_(0) {
     VLOG(1) << "Server listener up";
   }
@@ -62,6 +63,9 @@ class PerformanceChannelListener : public Listener {
     payload_ = std::string(msg_size_, 'a');
   }
 
+  // When set, all pings are sent at once on hello rather than one per pong.
+  void set_burst(bool burst) { burst_ = burst; }
+
   bool OnMessageReceived(const Message& message) override {
     CHECK(sender_);
 
@@ -89,6 +93,9 @@ class PerformanceChannelListener : public Listener {
       }
       perf_logger_.reset();
       base::RunLoop::QuitCurrentWhenIdleDeprecated();
+    } else if (burst_) {
+      for (int i = 0; i < count_down_; ++i)
+        SendPong();
     } else {
       SendPong();
     }
@@ -106,7 +113,8 @@ class PerformanceChannelListener : public Listener {
       return;
     }
 
-    SendPong();
+    if (!burst_)
+      SendPong();
   }
 
   void SendPong() { sender_->Send(new TestMsg_Ping(payload_)); }
@@ -117,6 +125,7 @@ class PerformanceChannelListener : public Listener {
   int msg_count_;
   size_t msg_size_;
   bool sync_;
+  bool burst_;
 
   int count_down_;
   std::string payload_;
@@ -183,11 +192,13 @@ class MojoChannelPerfTest : public IPCChannelMojoTestBase {
   MojoChannelPerfTest() = default;
   ~MojoChannelPerfTest() override = default;
 
-  void RunTestChannelProxyPingPong() {
+  void RunTestChannelProxyPingPong(bool burst) {
     Init("MojoPerfTestClient");
 
     // Set up IPC channel and start client.
-    PerformanceChannelListener listener("ChannelProxy");
+    PerformanceChannelListener listener(burst ? "ChannelProxyBurst"
+                                              : "ChannelProxy");
+    listener.set_burst(burst);
     auto channel_proxy = IPC::ChannelProxy::Create(
         TakeHandle().release(), IPC::Channel::MODE_SERVER, &listener,
         GetIOThreadTaskRunner(), base::ThreadTaskRunnerHandle::Get());
@@ -249,7 +260,16 @@ class MojoChannelPerfTest : public IPCChannelMojoTestBase {
 };
 
 TEST_F(MojoChannelPerfTest, ChannelProxyPingPong) {
-  RunTestChannelProxyPingPong();
+  RunTestChannelProxyPingPong(false);
+
+  base::RunLoop run_loop;
+  run_loop.RunUntilIdle();
+}
+
+// Sends every ping back-to-back, so that ChannelProxy can forward many
+// messages to the IO thread per task.
+TEST_F(MojoChannelPerfTest, ChannelProxyBurstPingPong) {
+  RunTestChannelProxyPingPong(true);
 
   base::RunLoop run_loop;
   run_loop.RunUntilIdle();
@@ -79,6 +79,23 @@ AudioRendererMixer::~AudioRendererMixer() {
 
 void AudioRendererMixer::AddMixerInput(const AudioParameters& input_params,
                                        AudioConverter::InputCallback* input) {
+  const int input_sample_rate = input_params.sample_rate();
+
+  // Creating a resampler allocates and initializes its kernels, so do it
+  // before taking |lock_| to keep Render() from waiting on it. A racing
+  // AddMixerInput() for the same sample rate may win; the loser's converter is
+  // destroyed after |auto_lock| below goes out of scope.
+  std::unique_ptr<LoopbackAudioConverter> new_converter;
+  if (!is_master_sample_rate(input_sample_rate)) {
+    bool has_converter;
+    {
+      base::AutoLock auto_lock(lock_);
+      has_converter = converters_.find(input_sample_rate) != converters_.end();
+    }
+    if (!has_converter)
+      new_converter = CreateConverter(input_params);
+  }
+
   base::AutoLock auto_lock(lock_);
   if (!playing_) {
     playing_ = true;
@@ -86,20 +103,18 @@ void AudioRendererMixer::AddMixerInput(const AudioParameters& input_params,
     audio_sink_->Play();
   }
 
-  int input_sample_rate = input_params.sample_rate();
   if (is_master_sample_rate(input_sample_rate)) {
     master_converter_.AddInput(input);
   } else {
     auto converter = converters_.find(input_sample_rate);
     if (converter == converters_.end()) {
-      std::pair<AudioConvertersMap::iterator, bool> result =
-          converters_.insert(std::make_pair(
-              input_sample_rate, std::make_unique<LoopbackAudioConverter>(
-                                     // We expect all InputCallbacks to be
-                                     // capable of handling arbitrary buffer
-                                     // size requests, disabling FIFO.
-                                     input_params, output_params_, true)));
-      converter = result.first;
+      // The converter we saw above may have been removed since; this is rare
+      // enough that creating one under |lock_| is fine.
+      if (!new_converter)
+        new_converter = CreateConverter(input_params);
+      converter =
+          converters_.emplace(input_sample_rate, std::move(new_converter))
+              .first;
 
       // Add newly-created resampler as an input to the master mixer.
       master_converter_.AddInput(converter->second.get());
@@ -113,6 +128,10 @@ void AudioRendererMixer::AddMixerInput(const AudioParameters& input_params,
 void AudioRendererMixer::RemoveMixerInput(
     const AudioParameters& input_params,
     AudioConverter::InputCallback* input) {
+  // Declared before |auto_lock| so an emptied converter is destroyed after
+  // |lock_| is released.
+  std::unique_ptr<LoopbackAudioConverter> removed_converter;
+
   base::AutoLock auto_lock(lock_);
 
   int input_sample_rate = input_params.sample_rate();
@@ -125,6 +144,7 @@ void AudioRendererMixer::RemoveMixerInput(
     if (converter->second->empty()) {
       // Remove converter when it's empty.
       master_converter_.RemoveInput(converter->second.get());
+      removed_converter = std::move(converter->second);
       converters_.erase(converter);
     }
   }
@@ -133,15 +153,23 @@ void AudioRendererMixer::RemoveMixerInput(
 }
 
 void AudioRendererMixer::AddErrorCallback(AudioRendererMixerInput* input) {
-  base::AutoLock auto_lock(lock_);
+  base::AutoLock auto_lock(error_callbacks_lock_);
   error_callbacks_.insert(input);
 }
 
 void AudioRendererMixer::RemoveErrorCallback(AudioRendererMixerInput* input) {
-  base::AutoLock auto_lock(lock_);
+  base::AutoLock auto_lock(error_callbacks_lock_);
   error_callbacks_.erase(input);
 }
 
+std::unique_ptr<LoopbackAudioConverter> AudioRendererMixer::CreateConverter(
+    const AudioParameters& input_params) const {
+  // We expect all InputCallbacks to be capable of handling arbitrary buffer
+  // size requests, disabling FIFO.
+  return std::make_unique<LoopbackAudioConverter>(input_params, output_params_,
+                                                  true);
+}
+
 bool AudioRendererMixer::CurrentThreadIsRenderingThread() {
   return audio_sink_->CurrentThreadIsRenderingThread();
 }
@@ -177,7 +205,7 @@ int AudioRendererMixer::Render(base::TimeDelta delay,
 
 void AudioRendererMixer::OnRenderError() {
   // Call each mixer input and signal an error.
-  base::AutoLock auto_lock(lock_);
+  base::AutoLock auto_lock(error_callbacks_lock_);
   for (auto* input : error_callbacks_)
     input->OnRenderError();
 }
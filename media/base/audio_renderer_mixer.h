@@ -66,6 +66,10 @@ class MEDIA_EXPORT AudioRendererMixer
              AudioBus* audio_bus) override;
   void OnRenderError() override;
 
+  // Creates a converter resampling |input_params| to |output_params_|.
+  std::unique_ptr<LoopbackAudioConverter> CreateConverter(
+      const AudioParameters& input_params) const;
+
   bool is_master_sample_rate(int sample_rate) const {
     return sample_rate == output_params_.sample_rate();
   }
@@ -76,11 +80,18 @@ class MEDIA_EXPORT AudioRendererMixer
   // Output sink for this mixer.
   const scoped_refptr<AudioRendererSink> audio_sink_;
 
-  // ---------------[ All variables below protected by |lock_| ]---------------
-  base::Lock lock_;
+  // Error callbacks have their own lock so that registering them never
+  // contends with Render() on the realtime audio thread.
+  base::Lock error_callbacks_lock_;
 
   // List of error callbacks used by this mixer.
-  base::flat_set<AudioRendererMixerInput*> error_callbacks_ GUARDED_BY(lock_);
+  base::flat_set<AudioRendererMixerInput*> error_callbacks_
+      GUARDED_BY(error_callbacks_lock_);
+
+  // ---------------[ All variables below protected by |lock_| ]---------------
+  // |lock_| is taken by Render() on the realtime audio thread, so anything
+  // expensive (e.g. creating or destroying resamplers) must happen outside it.
+  base::Lock lock_;
 
   // Maps input sample rate to the dedicated converter.
   using AudioConvertersMap =
@@ -0,0 +1,110 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <memory>
+
+#include "base/bind_helpers.h"
+#include "base/macros.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/synchronization/atomic_flag.h"
+#include "base/threading/simple_thread.h"
+#include "base/time/time.h"
+#include "media/base/audio_renderer_mixer.h"
+#include "media/base/fake_audio_render_callback.h"
+#include "media/base/mock_audio_renderer_sink.h"
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace media {
+
+static const int kBenchmarkIterations = 2000;
+static const int kOutputSampleRate = 48000;
+static const int kOutputBufferSize = 480;
+
+// Renders continuously on a separate thread, like the realtime audio thread
+// would, and tracks how long each render took.
+class RenderLoopThread : public base::SimpleThread {
+ public:
+  RenderLoopThread(AudioRendererSink::RenderCallback* callback,
+                   const AudioParameters& params)
+      : base::SimpleThread("RenderLoopThread"),
+        callback_(callback),
+        audio_bus_(AudioBus::Create(params)),
+        buffer_duration_(params.GetBufferDuration()) {}
+
+  void Run() override {
+    while (!stop_.IsSet()) {
+      const base::TimeTicks start = base::TimeTicks::Now();
+      callback_->Render(base::TimeDelta(), start, 0, audio_bus_.get());
+      const base::TimeDelta elapsed = base::TimeTicks::Now() - start;
+      if (elapsed > buffer_duration_)
+        ++overruns_;
+      if (elapsed > max_render_time_)
+        max_render_time_ = elapsed;
+      ++renders_;
+    }
+  }
+
+  void Stop() {
+    stop_.Set();
+    Join();
+  }
+
+  int overruns() const { return overruns_; }
+  int renders() const { return renders_; }
+  base::TimeDelta max_render_time() const { return max_render_time_; }
+
+ private:
+  AudioRendererSink::RenderCallback* const callback_;
+  const std::unique_ptr<AudioBus> audio_bus_;
+  const base::TimeDelta buffer_duration_;
+  base::AtomicFlag stop_;
+  int overruns_ = 0;
+  int renders_ = 0;
+  base::TimeDelta max_render_time_;
+
+  DISALLOW_COPY_AND_ASSIGN(RenderLoopThread);
+};
+
+// Adds and removes inputs which need their own resampler while another thread
+// renders. Creating and destroying resamplers should not stall rendering.
+TEST(AudioRendererMixerPerfTest, AddRemoveInputsWhileRendering) {
+  const AudioParameters output_params(
+      AudioParameters::AUDIO_PCM_LOW_LATENCY, CHANNEL_LAYOUT_STEREO,
+      kOutputSampleRate, kOutputBufferSize);
+  const AudioParameters input_params(AudioParameters::AUDIO_PCM_LINEAR,
+                                     CHANNEL_LAYOUT_STEREO,
+                                     kOutputSampleRate / 2, 4096);
+  FakeAudioRenderCallback input(0.1, input_params.sample_rate());
+
+  auto sink = base::MakeRefCounted<testing::NiceMock<MockAudioRendererSink>>();
+  AudioRendererMixer mixer(output_params, sink, base::DoNothing());
+
+  RenderLoopThread render_thread(sink->callback(), output_params);
+  render_thread.Start();
+
+  base::TimeTicks start = base::TimeTicks::Now();
+  for (int i = 0; i < kBenchmarkIterations; ++i) {
+    mixer.AddMixerInput(input_params, &input);
+    mixer.RemoveMixerInput(input_params, &input);
+  }
+  double runs_per_second =
+      kBenchmarkIterations / (base::TimeTicks::Now() - start).InSecondsF();
+
+  render_thread.Stop();
+
+  perf_test::PrintResult("audio_renderer_mixer", "", "add_remove_input",
+                         runs_per_second, "runs/s", true);
+  perf_test::PrintResult("audio_renderer_mixer", "", "max_render_time",
+                         render_thread.max_render_time().InMicrosecondsF(),
+                         "us", true);
+  perf_test::PrintResult(
+      "audio_renderer_mixer", "", "overran_renders",
+      100.0 * render_thread.overruns() / std::max(render_thread.renders(), 1),
+      "%", true);
+}
+
+}  // namespace media
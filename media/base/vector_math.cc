@@ -25,15 +25,20 @@
 #define FMUL_FUNC FMUL_C
 #endif
 #define EWMAAndMaxPower_FUNC EWMAAndMaxPower_SSE
+// Floating point reductions are never auto-vectorized since doing so changes
+// the order of additions, so always use the intrinsic version.
+#define DotProduct_FUNC DotProduct_SSE
 #elif defined(ARCH_CPU_ARM_FAMILY) && defined(USE_NEON)
 #include <arm_neon.h>
 #define FMAC_FUNC FMAC_NEON
 #define FMUL_FUNC FMUL_NEON
 #define EWMAAndMaxPower_FUNC EWMAAndMaxPower_NEON
+#define DotProduct_FUNC DotProduct_NEON
 #else
 #define FMAC_FUNC FMAC_C
 #define FMUL_FUNC FMUL_C
 #define EWMAAndMaxPower_FUNC EWMAAndMaxPower_C
+#define DotProduct_FUNC DotProduct_C
 #endif
 
 namespace media {
@@ -63,6 +68,17 @@ void FMUL_C(const float src[], float scale, int len, float dest[]) {
     dest[i] = src[i] * scale;
 }
 
+float DotProduct(const float a[], const float b[], int len) {
+  return DotProduct_FUNC(a, b, len);
+}
+
+float DotProduct_C(const float a[], const float b[], int len) {
+  float sum = 0.0f;
+  for (int i = 0; i < len; ++i)
+    sum += a[i] * b[i];
+  return sum;
+}
+
 void Crossfade(const float src[], int len, float dest[]) {
   float cf_ratio = 0;
   const float cf_increment = 1.0f / len;
@@ -118,6 +134,33 @@ void FMAC_SSE(const float src[], float scale, int len, float dest[]) {
     dest[i] += src[i] * scale;
 }
 
+float DotProduct_SSE(const float a[], const float b[], int len) {
+  const int rem = len % 8;
+  const int last_index = len - rem;
+
+  // Use two accumulators so consecutive multiply-adds don't serialize on the
+  // latency of a single add.
+  __m128 m_sum0 = _mm_setzero_ps();
+  __m128 m_sum1 = _mm_setzero_ps();
+  for (int i = 0; i < last_index; i += 8) {
+    m_sum0 = _mm_add_ps(
+        m_sum0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    m_sum1 = _mm_add_ps(
+        m_sum1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+  }
+
+  // Reduce to a single float. SSE1 doesn't have a horizontal sum function, so
+  // we have to condense manually.
+  __m128 m_sum = _mm_add_ps(m_sum0, m_sum1);
+  m_sum = _mm_add_ps(_mm_movehl_ps(m_sum, m_sum), m_sum);
+  float sum = _mm_cvtss_f32(_mm_add_ss(m_sum, _mm_shuffle_ps(m_sum, m_sum, 1)));
+
+  // Handle any remaining values that wouldn't fit in an SSE pass.
+  for (int i = last_index; i < len; ++i)
+    sum += a[i] * b[i];
+  return sum;
+}
+
 // Convenience macro to extract float 0 through 3 from the vector |a|.  This is
 // needed because compilers other than clang don't support access via
 // operator[]().
@@ -223,6 +266,30 @@ void FMUL_NEON(const float src[], float scale, int len, float dest[]) {
     dest[i] = src[i] * scale;
 }
 
+float DotProduct_NEON(const float a[], const float b[], int len) {
+  const int rem = len % 8;
+  const int last_index = len - rem;
+
+  // Use two accumulators so consecutive multiply-adds don't serialize on the
+  // latency of a single add.
+  float32x4_t m_sum0 = vdupq_n_f32(0.0f);
+  float32x4_t m_sum1 = vdupq_n_f32(0.0f);
+  for (int i = 0; i < last_index; i += 8) {
+    m_sum0 = vmlaq_f32(m_sum0, vld1q_f32(a + i), vld1q_f32(b + i));
+    m_sum1 = vmlaq_f32(m_sum1, vld1q_f32(a + i + 4), vld1q_f32(b + i + 4));
+  }
+
+  // Reduce to a single float.
+  const float32x4_t m_sum = vaddq_f32(m_sum0, m_sum1);
+  float32x2_t m_half = vadd_f32(vget_high_f32(m_sum), vget_low_f32(m_sum));
+  float sum = vget_lane_f32(vpadd_f32(m_half, m_half), 0);
+
+  // Handle any remaining values that wouldn't fit in an NEON pass.
+  for (int i = last_index; i < len; ++i)
+    sum += a[i] * b[i];
+  return sum;
+}
+
 std::pair<float, float> EWMAAndMaxPower_NEON(
     float initial_value, const float src[], int len, float smoothing_factor) {
   // When the recurrence is unrolled, we see that we can split it into 4
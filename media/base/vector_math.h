@@ -42,6 +42,11 @@ MEDIA_SHMEM_EXPORT std::pair<float, float> EWMAAndMaxPower(
     int len,
     float smoothing_factor);
 
+// Returns the sum of |a[i]| * |b[i]| for |i| in [0, |len|).  Unlike the other
+// functions in this file, |a| and |b| need not be aligned, since callers such
+// as WSOLA correlate blocks at arbitrary frame offsets.
+MEDIA_SHMEM_EXPORT float DotProduct(const float a[], const float b[], int len);
+
 MEDIA_SHMEM_EXPORT void Crossfade(const float src[], int len, float dest[]);
 
 }  // namespace vector_math
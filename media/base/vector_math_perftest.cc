@@ -75,6 +75,31 @@ class VectorMathPerfTest : public testing::Test {
                            true);
   }
 
+  void RunBenchmark(float (*fn)(const float[], const float[], int),
+                    bool aligned,
+                    const std::string& test_name,
+                    const std::string& trace_name) {
+    // Offset one input so unaligned loads are exercised like they are when
+    // WSOLA correlates blocks at arbitrary frame offsets.
+    const int offset = aligned ? 0 : 1;
+    float sum = 0.0f;
+    TimeTicks start = TimeTicks::Now();
+    for (int i = 0; i < kBenchmarkIterations; ++i) {
+      sum += fn(input_vector_.get() + offset, output_vector_.get(),
+                kVectorSize - offset);
+    }
+    double total_time_milliseconds =
+        (TimeTicks::Now() - start).InMillisecondsF();
+    // Use |sum| so the calls can't be optimized away.
+    EXPECT_EQ(0.0f, sum);
+    perf_test::PrintResult(test_name,
+                           "",
+                           trace_name,
+                           kBenchmarkIterations / total_time_milliseconds,
+                           "runs/ms",
+                           true);
+  }
+
  protected:
   std::unique_ptr<float, base::AlignedFreeDeleter> input_vector_;
   std::unique_ptr<float, base::AlignedFreeDeleter> output_vector_;
@@ -87,10 +112,12 @@ class VectorMathPerfTest : public testing::Test {
 #define FMAC_FUNC FMAC_SSE
 #define FMUL_FUNC FMUL_SSE
 #define EWMAAndMaxPower_FUNC EWMAAndMaxPower_SSE
+#define DotProduct_FUNC DotProduct_SSE
 #elif defined(ARCH_CPU_ARM_FAMILY) && defined(USE_NEON)
 #define FMAC_FUNC FMAC_NEON
 #define FMUL_FUNC FMUL_NEON
 #define EWMAAndMaxPower_FUNC EWMAAndMaxPower_NEON
+#define DotProduct_FUNC DotProduct_NEON
 #endif
 
 // Benchmarks for each optimized vector_math::FMAC() method.
@@ -174,4 +201,25 @@ TEST_F(VectorMathPerfTest, EWMAAndMaxPower_optimized_aligned) {
 }
 #endif
 
+// Benchmarks for each optimized vector_math::DotProduct() method.
+// Benchmark DotProduct_C().
+TEST_F(VectorMathPerfTest, DotProduct_unoptimized) {
+  RunBenchmark(vector_math::DotProduct_C, true, "vector_math_dot_product",
+               "unoptimized");
+}
+
+#if defined(DotProduct_FUNC)
+// Benchmark DotProduct_FUNC() with unaligned inputs.
+TEST_F(VectorMathPerfTest, DotProduct_optimized_unaligned) {
+  RunBenchmark(vector_math::DotProduct_FUNC, false, "vector_math_dot_product",
+               "optimized_unaligned");
+}
+
+// Benchmark DotProduct_FUNC() with aligned inputs.
+TEST_F(VectorMathPerfTest, DotProduct_optimized_aligned) {
+  RunBenchmark(vector_math::DotProduct_FUNC, true, "vector_math_dot_product",
+               "optimized_aligned");
+}
+#endif
+
 } // namespace media
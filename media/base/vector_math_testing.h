@@ -27,6 +27,9 @@ MEDIA_SHMEM_EXPORT std::pair<float, float> EWMAAndMaxPower_C(
     const float src[],
     int len,
     float smoothing_factor);
+MEDIA_SHMEM_EXPORT float DotProduct_C(const float a[],
+                                      const float b[],
+                                      int len);
 
 #if defined(ARCH_CPU_X86_FAMILY) && !defined(OS_NACL)
 MEDIA_SHMEM_EXPORT void FMAC_SSE(const float src[],
@@ -42,6 +45,9 @@ MEDIA_SHMEM_EXPORT std::pair<float, float> EWMAAndMaxPower_SSE(
     const float src[],
     int len,
     float smoothing_factor);
+MEDIA_SHMEM_EXPORT float DotProduct_SSE(const float a[],
+                                        const float b[],
+                                        int len);
 #endif
 
 #if defined(ARCH_CPU_ARM_FAMILY) && defined(USE_NEON)
@@ -58,6 +64,9 @@ MEDIA_SHMEM_EXPORT std::pair<float, float> EWMAAndMaxPower_NEON(
     const float src[],
     int len,
     float smoothing_factor);
+MEDIA_SHMEM_EXPORT float DotProduct_NEON(const float a[],
+                                         const float b[],
+                                         int len);
 #endif
 
 }  // namespace vector_math
@@ -145,6 +145,34 @@ TEST_F(VectorMathTest, Crossfade) {
   }
 }
 
+// Ensure each optimized vector_math::DotProduct() method returns the same
+// value, including for unaligned inputs and lengths.
+TEST_F(VectorMathTest, DotProduct) {
+  for (int i = 0; i < kVectorSize; ++i) {
+    input_vector_[i] = (i % 7) * 0.25f - 0.5f;
+    output_vector_[i] = (i % 5) * 0.5f - 1.0f;
+  }
+
+  for (int offset = 0; offset < 4; ++offset) {
+    SCOPED_TRACE(offset);
+    const float* a = input_vector_.get() + offset;
+    const float* b = output_vector_.get() + 3 - offset;
+    const int len = kVectorSize - 8 + offset;
+    const float expected = vector_math::DotProduct_C(a, b, len);
+
+    EXPECT_FLOAT_EQ(expected, vector_math::DotProduct(a, b, len));
+#if defined(ARCH_CPU_X86_FAMILY)
+    EXPECT_FLOAT_EQ(expected, vector_math::DotProduct_SSE(a, b, len));
+#endif
+#if defined(ARCH_CPU_ARM_FAMILY) && defined(USE_NEON)
+    EXPECT_FLOAT_EQ(expected, vector_math::DotProduct_NEON(a, b, len));
+#endif
+  }
+
+  EXPECT_EQ(0.0f, vector_math::DotProduct(input_vector_.get(),
+                                          output_vector_.get(), 0));
+}
+
 class EWMATestScenario {
  public:
   EWMATestScenario(float initial_value, const float src[], int len,
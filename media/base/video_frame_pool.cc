@@ -4,10 +4,13 @@
 
 #include "media/base/video_frame_pool.h"
 
+#include <iterator>
+
 #include "base/bind.h"
 #include "base/containers/circular_deque.h"
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
+#include "base/metrics/histogram_macros.h"
 #include "base/synchronization/lock.h"
 #include "base/thread_annotations.h"
 #include "base/time/default_tick_clock.h"
@@ -29,7 +32,7 @@ class VideoFramePool::PoolImpl
 
   // Shuts down the frame pool and releases all frames in |frames_|.
   // Once this is called frames will no longer be inserted back into
-  // |frames_|.
+  // |frames_|. Records the pool hit rate if any frames were requested.
   void Shutdown();
 
   size_t get_pool_size_for_testing() {
@@ -37,6 +40,11 @@ class VideoFramePool::PoolImpl
     return frames_.size();
   }
 
+  void set_max_pooled_bytes_for_testing(size_t max_pooled_bytes) {
+    base::AutoLock auto_lock(lock_);
+    max_pooled_bytes_ = max_pooled_bytes;
+  }
+
   void set_tick_clock_for_testing(const base::TickClock* tick_clock) {
     tick_clock_ = tick_clock;
   }
@@ -52,24 +60,52 @@ class VideoFramePool::PoolImpl
   // least recently used entry.
   void FrameReleased(scoped_refptr<VideoFrame> frame);
 
+  // Releases the least recently used frames which don't match the most
+  // recently requested format and coded size until |pooled_bytes_| is at most
+  // |max_pooled_bytes_|. Frames matching the current request are only released
+  // once stale, as before.
+  void EnforceMemoryLimit() EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
   base::Lock lock_;
   bool is_shutdown_ GUARDED_BY(lock_) = false;
 
   struct FrameEntry {
     base::TimeTicks last_use_time;
     scoped_refptr<VideoFrame> frame;
+    size_t bytes;
   };
 
   base::circular_deque<FrameEntry> frames_ GUARDED_BY(lock_);
 
+  // Total allocation size of the frames in |frames_|.
+  size_t pooled_bytes_ GUARDED_BY(lock_) = 0;
+
+  // Frames for formats other than the most recent request are kept, so that
+  // streams switching back and forth between resolutions can reuse them, but
+  // only while the pool holds at most this many bytes.
+  size_t max_pooled_bytes_ GUARDED_BY(lock_);
+
+  // Format and coded size given to the most recent CreateFrame() call.
+  VideoPixelFormat last_format_ GUARDED_BY(lock_) = PIXEL_FORMAT_UNKNOWN;
+  gfx::Size last_coded_size_ GUARDED_BY(lock_);
+
+  // Number of CreateFrame() calls, and how many were served from |frames_|.
+  int num_requests_ GUARDED_BY(lock_) = 0;
+  int num_hits_ GUARDED_BY(lock_) = 0;
+
   // |tick_clock_| is always a DefaultTickClock outside of testing.
   const base::TickClock* tick_clock_;
 
   DISALLOW_COPY_AND_ASSIGN(PoolImpl);
 };
 
+// Default value for |max_pooled_bytes_|; enough for a handful of 1080p frames
+// in each of a few formats.
+constexpr size_t kDefaultMaxPooledBytes = 64 * 1024 * 1024;
+
 VideoFramePool::PoolImpl::PoolImpl()
-    : tick_clock_(base::DefaultTickClock::GetInstance()) {}
+    : max_pooled_bytes_(kDefaultMaxPooledBytes),
+      tick_clock_(base::DefaultTickClock::GetInstance()) {}
 
 VideoFramePool::PoolImpl::~PoolImpl() {
   DCHECK(is_shutdown_);
@@ -81,28 +117,42 @@ scoped_refptr<VideoFrame> VideoFramePool::PoolImpl::CreateFrame(
     const gfx::Rect& visible_rect,
     const gfx::Size& natural_size,
     base::TimeDelta timestamp) {
+  // Reused frames may be wrapped with a different visible rect and natural
+  // size than they were created with, so validate those up front.
+  if (!VideoFrame::IsValidConfig(format, VideoFrame::STORAGE_OWNED_MEMORY,
+                                 coded_size, visible_rect, natural_size)) {
+    LOG(ERROR) << "Invalid video frame parameters";
+    return nullptr;
+  }
+
   base::AutoLock auto_lock(lock_);
   DCHECK(!is_shutdown_);
 
+  ++num_requests_;
+  last_format_ = format;
+  last_coded_size_ = coded_size;
+
+  // Pooled frames are always created with a visible rect covering the whole
+  // coded size, so any frame with a matching format and coded size can be
+  // handed out with the requested |visible_rect| and |natural_size|. Search
+  // from the back so that the most recently used frame is reused first.
   scoped_refptr<VideoFrame> frame;
-  while (!frame && !frames_.empty()) {
-    scoped_refptr<VideoFrame> pool_frame = std::move(frames_.back().frame);
-    frames_.pop_back();
-
-    if (pool_frame->format() == format &&
-        pool_frame->coded_size() == coded_size &&
-        pool_frame->visible_rect() == visible_rect &&
-        pool_frame->natural_size() == natural_size) {
-      frame = pool_frame;
+  for (auto it = frames_.rbegin(); it != frames_.rend(); ++it) {
+    if (it->frame->format() == format &&
+        it->frame->coded_size() == coded_size) {
+      frame = std::move(it->frame);
+      pooled_bytes_ -= it->bytes;
+      frames_.erase(std::next(it).base());
       frame->set_timestamp(timestamp);
       frame->metadata()->Clear();
+      ++num_hits_;
       break;
     }
   }
 
   if (!frame) {
     frame = VideoFrame::CreateZeroInitializedFrame(
-        format, coded_size, visible_rect, natural_size, timestamp);
+        format, coded_size, gfx::Rect(coded_size), coded_size, timestamp);
     // This can happen if the arguments are not valid.
     if (!frame) {
       LOG(ERROR) << "Failed to create a video frame";
@@ -110,8 +160,16 @@ scoped_refptr<VideoFrame> VideoFramePool::PoolImpl::CreateFrame(
     }
   }
 
-  scoped_refptr<VideoFrame> wrapped_frame = VideoFrame::WrapVideoFrame(
-      frame, frame->format(), frame->visible_rect(), frame->natural_size());
+  // Requesting a new format may have left the pool over its limit.
+  EnforceMemoryLimit();
+
+  scoped_refptr<VideoFrame> wrapped_frame =
+      VideoFrame::WrapVideoFrame(frame, frame->format(), visible_rect,
+                                 natural_size);
+  if (!wrapped_frame) {
+    LOG(ERROR) << "Failed to wrap a video frame";
+    return nullptr;
+  }
   wrapped_frame->AddDestructionObserver(base::Bind(
       &VideoFramePool::PoolImpl::FrameReleased, this, std::move(frame)));
   return wrapped_frame;
@@ -121,6 +179,12 @@ void VideoFramePool::PoolImpl::Shutdown() {
   base::AutoLock auto_lock(lock_);
   is_shutdown_ = true;
   frames_.clear();
+  pooled_bytes_ = 0;
+
+  if (num_requests_) {
+    UMA_HISTOGRAM_PERCENTAGE("Media.VideoFramePool.HitRate",
+                             100 * num_hits_ / num_requests_);
+  }
 }
 
 void VideoFramePool::PoolImpl::FrameReleased(scoped_refptr<VideoFrame> frame) {
@@ -129,7 +193,10 @@ void VideoFramePool::PoolImpl::FrameReleased(scoped_refptr<VideoFrame> frame) {
     return;
 
   const base::TimeTicks now = tick_clock_->NowTicks();
-  frames_.push_back({now, std::move(frame)});
+  const size_t bytes =
+      VideoFrame::AllocationSize(frame->format(), frame->coded_size());
+  pooled_bytes_ += bytes;
+  frames_.push_back({now, std::move(frame), bytes});
 
   // After this loop, |stale_index| is the index of the oldest non-stale frame.
   // Such an index must exist because |frame| is never stale.
@@ -140,8 +207,25 @@ void VideoFramePool::PoolImpl::FrameReleased(scoped_refptr<VideoFrame> frame) {
     DCHECK_LE(static_cast<size_t>(stale_index), frames_.size());
   }
 
+  for (int i = 0; i < stale_index; ++i)
+    pooled_bytes_ -= frames_[i].bytes;
   if (stale_index)
     frames_.erase(frames_.begin(), frames_.begin() + stale_index);
+
+  EnforceMemoryLimit();
+}
+
+void VideoFramePool::PoolImpl::EnforceMemoryLimit() {
+  for (auto it = frames_.begin();
+       pooled_bytes_ > max_pooled_bytes_ && it != frames_.end();) {
+    if (it->frame->format() == last_format_ &&
+        it->frame->coded_size() == last_coded_size_) {
+      ++it;
+      continue;
+    }
+    pooled_bytes_ -= it->bytes;
+    it = frames_.erase(it);
+  }
 }
 
 VideoFramePool::VideoFramePool() : pool_(new PoolImpl()) {}
@@ -168,4 +252,8 @@ void VideoFramePool::SetTickClockForTesting(const base::TickClock* tick_clock) {
   pool_->set_tick_clock_for_testing(tick_clock);
 }
 
+void VideoFramePool::SetMaxPooledBytesForTesting(size_t max_pooled_bytes) {
+  pool_->set_max_pooled_bytes_for_testing(max_pooled_bytes);
+}
+
 }  // namespace media
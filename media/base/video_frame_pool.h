@@ -22,17 +22,18 @@ namespace media {
 // returned by CreateFrame(). When one of these VideoFrames is destroyed,
 // the memory is returned to the pool for use by a subsequent CreateFrame()
 // call. The memory in the pool is retained for the life of the
-// VideoFramePool object. If the parameters passed to CreateFrame() change
-// during the life of this object, then the memory used by frames with the old
-// parameter values will be purged from the pool.
+// VideoFramePool object, though frames unused for some time are released.
+// Frames with a different format or coded size than the latest CreateFrame()
+// call are kept for reuse only while the pool stays under a memory limit; the
+// least recently used of them are released first.
 class MEDIA_EXPORT VideoFramePool {
  public:
   VideoFramePool();
   ~VideoFramePool();
 
-  // Returns a frame from the pool that matches the specified
-  // parameters or creates a new frame if no suitable frame exists in
-  // the pool. The pool is drained if no matching frame is found.
+  // Returns a frame from the pool that matches the specified format and coded
+  // size, or creates a new frame if no suitable frame exists in the pool. The
+  // returned frame has the given |visible_rect| and |natural_size| either way.
   // The buffer for the new frame will be zero initialized.  Reused frames will
   // not be zero initialized.
   scoped_refptr<VideoFrame> CreateFrame(VideoPixelFormat format,
@@ -50,6 +51,9 @@ class MEDIA_EXPORT VideoFramePool {
   // Allows injection of a base::SimpleTestClock for testing.
   void SetTickClockForTesting(const base::TickClock* tick_clock);
 
+  // Overrides the memory limit for frames of other formats for testing.
+  void SetMaxPooledBytesForTesting(size_t max_pooled_bytes);
+
  private:
   class PoolImpl;
   scoped_refptr<PoolImpl> pool_;
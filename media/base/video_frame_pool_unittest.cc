@@ -6,6 +6,7 @@
 #include <stdint.h>
 #include <memory>
 
+#include "base/test/metrics/histogram_tester.h"
 #include "base/test/simple_test_tick_clock.h"
 #include "media/base/video_frame_pool.h"
 #include "testing/gmock/include/gmock/gmock.h"
@@ -87,10 +88,65 @@ TEST_F(VideoFramePoolTest, SimpleFormatChange) {
   // Verify that both frames are in the pool.
   CheckPoolSize(2u);
 
-  // Verify that requesting a frame with a different format causes the pool
-  // to get drained.
+  // Verify that requesting a frame with a different format keeps the old
+  // frames around while under the memory limit.
   scoped_refptr<VideoFrame> new_frame = CreateFrame(PIXEL_FORMAT_I420A, 10);
-  CheckPoolSize(0u);
+  CheckPoolSize(2u);
+
+  // Switching back to the old format reuses those frames.
+  scoped_refptr<VideoFrame> old_format_frame =
+      CreateFrame(PIXEL_FORMAT_I420, 20);
+  CheckPoolSize(1u);
+}
+
+TEST_F(VideoFramePoolTest, OtherFormatsReleasedOverMemoryLimit) {
+  scoped_refptr<VideoFrame> frame_a = CreateFrame(PIXEL_FORMAT_I420, 10);
+  scoped_refptr<VideoFrame> frame_b = CreateFrame(PIXEL_FORMAT_I420, 10);
+  frame_a = nullptr;
+  frame_b = nullptr;
+  CheckPoolSize(2u);
+
+  // With room for only one frame, requesting a new format releases the least
+  // recently used frame of the old format.
+  pool_->SetMaxPooledBytesForTesting(VideoFrame::AllocationSize(
+      PIXEL_FORMAT_I420, gfx::Size(320, 240)));
+  scoped_refptr<VideoFrame> new_frame = CreateFrame(PIXEL_FORMAT_NV12, 10);
+  CheckPoolSize(1u);
+
+  // Frames of the current format are not released for the limit.
+  scoped_refptr<VideoFrame> new_frame_2 = CreateFrame(PIXEL_FORMAT_NV12, 10);
+  new_frame = nullptr;
+  new_frame_2 = nullptr;
+  CheckPoolSize(2u);
+}
+
+TEST_F(VideoFramePoolTest, VisibleRectChangeReusesFrame) {
+  const gfx::Size coded_size(320, 240);
+  scoped_refptr<VideoFrame> frame = CreateFrame(PIXEL_FORMAT_I420, 10);
+  const uint8_t* old_y_data = frame->data(VideoFrame::kYPlane);
+  frame = nullptr;
+
+  const gfx::Rect visible_rect(0, 0, 300, 200);
+  const gfx::Size natural_size(600, 400);
+  scoped_refptr<VideoFrame> new_frame =
+      pool_->CreateFrame(PIXEL_FORMAT_I420, coded_size, visible_rect,
+                         natural_size, base::TimeDelta());
+  EXPECT_EQ(old_y_data, new_frame->data(VideoFrame::kYPlane));
+  EXPECT_EQ(coded_size, new_frame->coded_size());
+  EXPECT_EQ(visible_rect, new_frame->visible_rect());
+  EXPECT_EQ(natural_size, new_frame->natural_size());
+}
+
+TEST_F(VideoFramePoolTest, HitRateRecorded) {
+  base::HistogramTester histogram_tester;
+  CreateFrame(PIXEL_FORMAT_I420, 10);
+  CreateFrame(PIXEL_FORMAT_I420, 20);
+  CreateFrame(PIXEL_FORMAT_NV12, 30);
+  CreateFrame(PIXEL_FORMAT_I420, 40);
+
+  // The first request of each format misses; the other two hit.
+  pool_.reset();
+  histogram_tester.ExpectUniqueSample("Media.VideoFramePool.HitRate", 50, 1);
 }
 
 TEST_F(VideoFramePoolTest, FrameValidAfterPoolDestruction) {
@@ -422,10 +422,14 @@ void FrameSender::OnReceivedCastFeedback(const RtcpCastMessage& cast_feedback) {
       // This is a good place to match the trace for frame ids
       // since this ensures we not only track frame ids that are
       // implicitly ACKed, but also handles duplicate ACKs
-      TRACE_EVENT_ASYNC_END1(
+      // The end-to-end latency covers capture, encode and transport up to the
+      // receiver's ACK for the frame.
+      TRACE_EVENT_ASYNC_END2(
           "cast.stream", is_audio_ ? "Audio Transport" : "Video Transport",
           latest_acked_frame_id_.lower_32_bits(), "RTT_usecs",
-          current_round_trip_time_.InMicroseconds());
+          current_round_trip_time_.InMicroseconds(), "end_to_end_usecs",
+          (now - GetRecordedReferenceTime(latest_acked_frame_id_))
+              .InMicroseconds());
     } while (latest_acked_frame_id_ < cast_feedback.ack_frame_id);
     transport_sender_->CancelSendingFrames(ssrc_, frames_to_cancel);
     OnCancelSendingFrames();
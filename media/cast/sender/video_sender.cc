@@ -46,6 +46,12 @@ const int kTargetUtilizationPercentage = 75;
 // frame or receiving multiple Pli messages in a short period.
 const int64_t kMinKeyFrameRequestOnPliIntervalMs = 500;
 
+// In low latency mode, frames are dropped before reaching the encoder once the
+// oldest frame in the encoder has been waiting for longer than this many frame
+// intervals. This keeps encoder queueing from adding to the end-to-end latency
+// during bursts, before the in-flight duration limits kick in.
+const int kMaxEncoderQueueDelayInFramesForLowLatency = 1;
+
 // Extract capture begin/end timestamps from |video_frame|'s metadata and log
 // it.
 void LogVideoCaptureTimestamps(CastEnvironment* cast_environment,
@@ -234,6 +240,23 @@ void VideoSender::InsertRawVideoFrame(
     return;
   }
 
+  if (low_latency_mode_ && !encoder_enqueue_times_.empty()) {
+    const base::TimeDelta encoder_queue_delay =
+        cast_environment_->Clock()->NowTicks() -
+        encoder_enqueue_times_.front();
+    if (encoder_queue_delay >
+        base::TimeDelta::FromSecondsD(
+            kMaxEncoderQueueDelayInFramesForLowLatency / max_frame_rate_)) {
+      VLOG(1) << "Dropping video frame: encoder queue delay is "
+              << encoder_queue_delay.InMilliseconds() << " ms.";
+      TRACE_EVENT_INSTANT2("cast.stream", "Video Frame Drop",
+                           TRACE_EVENT_SCOPE_THREAD,
+                           "rtp_timestamp", rtp_timestamp.lower_32_bits(),
+                           "reason", "encoder queue delay");
+      return;
+    }
+  }
+
   if (video_frame->visible_rect().IsEmpty()) {
     VLOG(1) << "Rejecting empty video frame.";
     return;
@@ -261,6 +284,7 @@ void VideoSender::InsertRawVideoFrame(
                              frame_to_encode.get(), "rtp_timestamp",
                              rtp_timestamp.lower_32_bits());
     frames_in_encoder_++;
+    encoder_enqueue_times_.push_back(cast_environment_->Clock()->NowTicks());
     duration_in_encoder_ += duration_added_by_next_frame;
     last_enqueued_frame_rtp_timestamp_ = rtp_timestamp;
     last_enqueued_frame_reference_time_ = reference_time;
@@ -302,6 +326,10 @@ void VideoSender::OnEncodedVideoFrame(
 
   frames_in_encoder_--;
   DCHECK_GE(frames_in_encoder_, 0);
+  DCHECK(!encoder_enqueue_times_.empty());
+  const base::TimeDelta encode_latency =
+      cast_environment_->Clock()->NowTicks() - encoder_enqueue_times_.front();
+  encoder_enqueue_times_.pop_front();
 
   // Encoding was exited with errors.
   if (!encoded_frame)
@@ -317,6 +345,10 @@ void VideoSender::OnEncodedVideoFrame(
                          "encoder_utilization",
                          last_reported_encoder_utilization_,
                          "lossy_utilization", last_reported_lossy_utilization_);
+  TRACE_EVENT_INSTANT2("cast.stream", "Video Encode Latency",
+                       TRACE_EVENT_SCOPE_THREAD, "rtp_timestamp",
+                       encoded_frame->rtp_timestamp.lower_32_bits(),
+                       "encode_latency_usecs", encode_latency.InMicroseconds());
 
   // Report the resource utilization for processing this frame.  Take the
   // greater of the two utilization values and attenuate them such that the
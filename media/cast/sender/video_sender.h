@@ -8,6 +8,7 @@
 #include <memory>
 
 #include "base/callback.h"
+#include "base/containers/circular_deque.h"
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
@@ -83,6 +84,11 @@ class VideoSender : public FrameSender {
   // The duration of video queued for encoding, but not yet sent.
   base::TimeDelta duration_in_encoder_;
 
+  // The times at which the frames currently in |video_encoder_| were enqueued,
+  // oldest first. In low latency mode, this is used to drop input frames when
+  // the encoder falls behind rather than letting them queue up.
+  base::circular_deque<base::TimeTicks> encoder_enqueue_times_;
+
   // The timestamp of the frame that was last enqueued in |video_encoder_|.
   RtpTimeTicks last_enqueued_frame_rtp_timestamp_;
   base::TimeTicks last_enqueued_frame_reference_time_;
@@ -125,6 +125,7 @@ class PeerVideoSender : public VideoSender {
                     create_video_encode_mem_cb,
                     transport_sender,
                     base::Bind(&IgnorePlayoutDelayChanges)) {}
+  using VideoSender::GetNumberOfFramesInEncoder;
   using VideoSender::OnReceivedCastFeedback;
   using VideoSender::OnReceivedPli;
 };
@@ -637,5 +638,50 @@ TEST_F(VideoSenderTest, CancelSendingOnReceivingPli) {
   EXPECT_EQ(2, transport_->number_of_rtp_packets());
 }
 
+// Tests that in low latency mode, frames are dropped before reaching the
+// encoder once the encoder is more than a frame interval behind, and accepted
+// again once it has caught up.
+TEST_F(VideoSenderTest, LowLatencyModeDropsFramesWhenEncoderFallsBehind) {
+  InitEncoder(false, true);
+  ASSERT_EQ(STATUS_INITIALIZED, operational_status_);
+
+  scoped_refptr<media::VideoFrame> video_frame = GetNewVideoFrame();
+  video_frame->metadata()->SetBoolean(
+      media::VideoFrameMetadata::INTERACTIVE_CONTENT, true);
+  video_sender_->InsertRawVideoFrame(video_frame, testing_clock_.NowTicks());
+  EXPECT_EQ(1, video_sender_->GetNumberOfFramesInEncoder());
+
+  // Let more than one frame interval pass without running the encoder.
+  testing_clock_.Advance(base::TimeDelta::FromMilliseconds(40));
+  video_frame = GetNewVideoFrame();
+  video_frame->metadata()->SetBoolean(
+      media::VideoFrameMetadata::INTERACTIVE_CONTENT, true);
+  video_sender_->InsertRawVideoFrame(video_frame, testing_clock_.NowTicks());
+  EXPECT_EQ(1, video_sender_->GetNumberOfFramesInEncoder());
+
+  // Once the encoder catches up, frames are accepted again.
+  RunTasks(33);
+  EXPECT_EQ(0, video_sender_->GetNumberOfFramesInEncoder());
+  video_frame = GetNewVideoFrame();
+  video_frame->metadata()->SetBoolean(
+      media::VideoFrameMetadata::INTERACTIVE_CONTENT, true);
+  video_sender_->InsertRawVideoFrame(video_frame, testing_clock_.NowTicks());
+  EXPECT_EQ(1, video_sender_->GetNumberOfFramesInEncoder());
+}
+
+// Tests that outside of low latency mode the encoder queue delay alone does
+// not cause frames to be dropped.
+TEST_F(VideoSenderTest, EncoderQueueDelayIgnoredOutsideLowLatencyMode) {
+  InitEncoder(false, true);
+  ASSERT_EQ(STATUS_INITIALIZED, operational_status_);
+
+  video_sender_->InsertRawVideoFrame(GetNewVideoFrame(),
+                                     testing_clock_.NowTicks());
+  testing_clock_.Advance(base::TimeDelta::FromMilliseconds(40));
+  video_sender_->InsertRawVideoFrame(GetNewVideoFrame(),
+                                     testing_clock_.NowTicks());
+  EXPECT_EQ(2, video_sender_->GetNumberOfFramesInEncoder());
+}
+
 }  // namespace cast
 }  // namespace media
@@ -5,15 +5,17 @@
 #ifndef MEDIA_FILTERS_DAV1D_VIDEO_DECODER_H_
 #define MEDIA_FILTERS_DAV1D_VIDEO_DECODER_H_
 
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "base/callback_forward.h"
 #include "base/macros.h"
-#include "base/threading/thread_checker.h"
-#include "media/base/video_decoder.h"
+#include "base/sequence_checker.h"
 #include "media/base/video_decoder_config.h"
 #include "media/base/video_frame.h"
 #include "media/base/video_frame_pool.h"
+#include "media/filters/offloading_video_decoder.h"
 
 struct Dav1dContext;
 struct Dav1dPicture;
@@ -21,9 +23,21 @@ struct Dav1dPicture;
 namespace media {
 class MediaLog;
 
-class MEDIA_EXPORT Dav1dVideoDecoder : public VideoDecoder {
+class MEDIA_EXPORT Dav1dVideoDecoder : public OffloadableVideoDecoder {
  public:
-  explicit Dav1dVideoDecoder(MediaLog* media_log);
+  enum class OffloadState {
+    kOffloaded,  // Indicates Dav1dVideoDecoder is being used with
+                 // OffloadVideoDecoder and that callbacks provided to
+                 // VideoDecoder methods should not be bound to the current
+                 // loop.
+
+    kNormal,  // Indicates Dav1dVideoDecoder is being used as a normal
+              // VideoDecoder, meaning callbacks should always be asynchronous.
+  };
+
+  explicit Dav1dVideoDecoder(
+      MediaLog* media_log,
+      OffloadState offload_state = OffloadState::kNormal);
   ~Dav1dVideoDecoder() override;
 
   // VideoDecoder implementation.
@@ -38,6 +52,9 @@ class MEDIA_EXPORT Dav1dVideoDecoder : public VideoDecoder {
               const DecodeCB& decode_cb) override;
   void Reset(const base::RepeatingClosure& reset_cb) override;
 
+  // OffloadableVideoDecoder implementation.
+  void Detach() override;
+
  private:
   enum class DecoderState {
     kUninitialized,
@@ -55,7 +72,11 @@ class MEDIA_EXPORT Dav1dVideoDecoder : public VideoDecoder {
 
   scoped_refptr<VideoFrame> CopyImageToVideoFrame(const Dav1dPicture* img);
 
-  THREAD_CHECKER(thread_checker_);
+  SEQUENCE_CHECKER(sequence_checker_);
+
+  // Indicates if the decoder is being wrapped by OffloadVideoDecoder; controls
+  // whether callbacks are bound to the current loop on calls.
+  const bool bind_callbacks_;
 
   // Used to report error messages to the client.
   MediaLog* const media_log_ = nullptr;
@@ -77,6 +98,19 @@ class MEDIA_EXPORT Dav1dVideoDecoder : public VideoDecoder {
   DISALLOW_COPY_AND_ASSIGN(Dav1dVideoDecoder);
 };
 
+// Helper class for creating a Dav1dVideoDecoder which will offload all AV1
+// content from the media thread.
+class OffloadingDav1dVideoDecoder : public OffloadingVideoDecoder {
+ public:
+  explicit OffloadingDav1dVideoDecoder(MediaLog* media_log)
+      : OffloadingVideoDecoder(
+            0,
+            std::vector<VideoCodec>(1, kCodecAV1),
+            std::make_unique<Dav1dVideoDecoder>(
+                media_log,
+                Dav1dVideoDecoder::OffloadState::kOffloaded)) {}
+};
+
 }  // namespace media
 
 #endif  // MEDIA_FILTERS_DAV1D_VIDEO_DECODER_H_
@@ -9,8 +9,8 @@
 
 #include "base/bind.h"
 #include "base/bind_helpers.h"
-#include "base/message_loop/message_loop.h"
 #include "base/run_loop.h"
+#include "base/test/scoped_task_environment.h"
 #include "build/build_config.h"
 #include "media/base/decoder_buffer.h"
 #include "media/base/limits.h"
@@ -172,8 +172,8 @@ class Dav1dVideoDecoderTest : public testing::Test {
 
   testing::StrictMock<MockMediaLog> media_log_;
 
-  base::MessageLoop message_loop_;
-  std::unique_ptr<Dav1dVideoDecoder> decoder_;
+  base::test::ScopedTaskEnvironment task_env_;
+  std::unique_ptr<VideoDecoder> decoder_;
 
   scoped_refptr<DecoderBuffer> i_frame_buffer_;
   OutputFrames output_frames_;
@@ -212,6 +212,25 @@ TEST_F(Dav1dVideoDecoderTest, DecodeFrame_Normal) {
   ASSERT_EQ(1U, output_frames_.size());
 }
 
+TEST_F(Dav1dVideoDecoderTest, Offloaded_DecodeFrame_Normal) {
+  decoder_.reset(new OffloadingDav1dVideoDecoder(&media_log_));
+  Initialize();
+
+  // Simulate decoding a single frame.
+  EXPECT_EQ(DecodeStatus::OK, DecodeSingleFrame(i_frame_buffer_));
+  ASSERT_EQ(1U, output_frames_.size());
+}
+
+// Test resetting an offloaded decoder which has decoded a single frame; the
+// reset must be serialized after the decode on the offload sequence.
+TEST_F(Dav1dVideoDecoderTest, Offloaded_Reset_Decoding) {
+  decoder_.reset(new OffloadingDav1dVideoDecoder(&media_log_));
+  Initialize();
+  ExpectDecodingState();
+  Reset();
+  Reinitialize();
+}
+
 // Decode |i_frame_buffer_| and then a frame with a larger width and verify
 // the output size was adjusted.
 // TODO(dalecurtis): Get an I-frame from a larger video.
@@ -209,22 +209,35 @@ std::unique_ptr<SourceBufferRangeByDts> SourceBufferRangeByDts::SplitRange(
       new_beginning_keyframe->second - keyframe_map_index_base_;
   DCHECK_LT(keyframe_index, static_cast<int>(buffers_.size()));
   BufferQueue::iterator starting_point = buffers_.begin() + keyframe_index;
-  BufferQueue removed_buffers(starting_point, buffers_.end());
 
   DecodeTimestamp new_range_start_decode_timestamp =
       std::max(timestamp, GetStartTimestamp());
   DCHECK(new_range_start_decode_timestamp <=
-         removed_buffers.front()->GetDecodeTimestamp());
-
-  keyframe_map_.erase(new_beginning_keyframe, keyframe_map_.end());
-  FreeBufferRange(starting_point, buffers_.end());
-  UpdateEndTimeUsingLastGOP();
-
-  // Create a new range with |removed_buffers|.
-  std::unique_ptr<SourceBufferRangeByDts> split_range =
-      std::make_unique<SourceBufferRangeByDts>(gap_policy_, removed_buffers,
-                                               new_range_start_decode_timestamp,
-                                               interbuffer_distance_cb_);
+         (*starting_point)->GetDecodeTimestamp());
+
+  std::unique_ptr<SourceBufferRangeByDts> split_range;
+  if (static_cast<size_t>(keyframe_index) < buffers_.size() / 2) {
+    // Splitting near the front, as when old media is removed from a long
+    // range: hand all buffers to the new range and move back only the few
+    // before |starting_point|, so the cost doesn't grow with the range.
+    split_range = std::make_unique<SourceBufferRangeByDts>(
+        gap_policy_, BufferQueue(1, *starting_point),
+        new_range_start_decode_timestamp, interbuffer_distance_cb_);
+    TransferTailTo(keyframe_index, new_beginning_keyframe, split_range.get());
+  } else {
+    // Remove the data beginning at |keyframe_index| from |buffers_| and save
+    // it into |removed_buffers|.
+    BufferQueue removed_buffers(starting_point, buffers_.end());
+
+    keyframe_map_.erase(new_beginning_keyframe, keyframe_map_.end());
+    FreeBufferRange(starting_point, buffers_.end());
+    UpdateEndTimeUsingLastGOP();
+
+    // Create a new range with |removed_buffers|.
+    split_range = std::make_unique<SourceBufferRangeByDts>(
+        gap_policy_, removed_buffers, new_range_start_decode_timestamp,
+        interbuffer_distance_cb_);
+  }
 
   // If the next buffer position is now in |split_range|, update the state of
   // this range and |split_range| accordingly.
@@ -244,6 +257,41 @@ std::unique_ptr<SourceBufferRangeByDts> SourceBufferRangeByDts::SplitRange(
   return split_range;
 }
 
+void SourceBufferRangeByDts::TransferTailTo(
+    int keyframe_index,
+    KeyframeMap::const_iterator tail_keyframe,
+    SourceBufferRangeByDts* split_range) {
+  DCHECK_GT(static_cast<int>(buffers_.size()), keyframe_index);
+  DCHECK(tail_keyframe != keyframe_map_.end());
+
+  // Keep copies of the buffers and keyframes before the split point.
+  BufferQueue head_buffers(buffers_.begin(), buffers_.begin() + keyframe_index);
+  KeyframeMap head_keyframes(keyframe_map_.cbegin(), tail_keyframe);
+  size_t head_size_in_bytes = 0;
+  for (const auto& buffer : head_buffers)
+    head_size_in_bytes += buffer->data_size();
+
+  // Give everything to |split_range|, then drop the head from it. Erasing
+  // from the front of a deque and a map costs only the erased elements.
+  DCHECK_EQ(1u, split_range->buffers_.size());
+  split_range->buffers_.swap(buffers_);
+  split_range->buffers_.erase(split_range->buffers_.begin(),
+                              split_range->buffers_.begin() + keyframe_index);
+  split_range->keyframe_map_.swap(keyframe_map_);
+  split_range->keyframe_map_.erase(split_range->keyframe_map_.begin(),
+                                   tail_keyframe);
+  split_range->keyframe_map_index_base_ =
+      keyframe_map_index_base_ + keyframe_index;
+  DCHECK_GE(size_in_bytes_, head_size_in_bytes);
+  split_range->size_in_bytes_ = size_in_bytes_ - head_size_in_bytes;
+  split_range->UpdateEndTimeUsingLastGOP();
+
+  buffers_.swap(head_buffers);
+  keyframe_map_.swap(head_keyframes);
+  size_in_bytes_ = head_size_in_bytes;
+  UpdateEndTimeUsingLastGOP();
+}
+
 bool SourceBufferRangeByDts::TruncateAt(DecodeTimestamp timestamp,
                                         BufferQueue* deleted_buffers,
                                         bool is_exclusive) {
@@ -228,6 +228,15 @@ class MEDIA_EXPORT SourceBufferRangeByPts : public SourceBufferRange {
   KeyframeMap::const_iterator GetFirstKeyframeAtOrBefore(
       base::TimeDelta timestamp) const;
 
+  // Helper for SplitRange(). Moves the buffers from |keyframe_index| onward,
+  // and |keyframe_map_| entries from |tail_keyframe| onward, into
+  // |split_range|, which must hold only a copy of the buffer at
+  // |keyframe_index|. Costs time proportional to the buffers kept in this
+  // range rather than those moved.
+  void TransferTailTo(int keyframe_index,
+                      KeyframeMap::const_iterator tail_keyframe,
+                      SourceBufferRangeByPts* split_range);
+
   // Helper method to delete buffers in |buffers_| starting at
   // |starting_point|, an index in |buffers_|.
   // Returns true if everything in the range was removed. Returns
@@ -0,0 +1,104 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/time/time.h"
+#include "media/base/media_util.h"
+#include "media/base/stream_parser_buffer.h"
+#include "media/base/test_helpers.h"
+#include "media/filters/source_buffer_range_by_dts.h"
+#include "media/filters/source_buffer_range_by_pts.h"
+#include "media/filters/source_buffer_stream.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace media {
+
+namespace {
+
+// Simulates a live stream at 30 frames per second with one keyframe per
+// second, keeping two hours of media buffered while appending new GOPs at the
+// end and removing the oldest ones, as a 24/7 player would.
+const int kFramesPerSecond = 30;
+const int kFramesPerGop = kFramesPerSecond;
+const int kBufferedGops = 2 * 60 * 60;
+const int kBenchmarkIterations = 1000;
+const uint8_t kData[] = {0x00};
+
+base::TimeDelta FrameDuration() {
+  return base::TimeDelta::FromSeconds(1) / kFramesPerSecond;
+}
+
+base::TimeDelta GopStart(int gop) {
+  return FrameDuration() * (gop * kFramesPerGop);
+}
+
+StreamParser::BufferQueue CreateGop(int gop) {
+  StreamParser::BufferQueue buffers;
+  for (int i = 0; i < kFramesPerGop; ++i) {
+    scoped_refptr<StreamParserBuffer> buffer = StreamParserBuffer::CopyFrom(
+        kData, sizeof(kData), i == 0, DemuxerStream::VIDEO, 0);
+    base::TimeDelta timestamp = GopStart(gop) + FrameDuration() * i;
+    buffer->set_timestamp(timestamp);
+    buffer->SetDecodeTimestamp(
+        DecodeTimestamp::FromPresentationTime(timestamp));
+    buffer->set_duration(FrameDuration());
+    buffers.push_back(buffer);
+  }
+  return buffers;
+}
+
+template <typename RangeClass>
+void RunSlidingWindowBench(const std::string& trace_name) {
+  NullMediaLog media_log;
+  SourceBufferStream<RangeClass> stream(TestVideoConfig::Normal(), &media_log);
+  stream.OnStartOfCodedFrameGroup(
+      DecodeTimestamp::FromPresentationTime(base::TimeDelta()),
+      base::TimeDelta());
+  for (int gop = 0; gop < kBufferedGops; ++gop)
+    ASSERT_TRUE(stream.Append(CreateGop(gop)));
+  stream.Seek(GopStart(kBufferedGops - 1));
+
+  // Pre-create the buffers so that only stream operations are timed.
+  std::vector<StreamParser::BufferQueue> new_gops;
+  for (int i = 0; i < kBenchmarkIterations; ++i)
+    new_gops.push_back(CreateGop(kBufferedGops + i));
+
+  base::TimeDelta append_time;
+  base::TimeDelta remove_time;
+  for (int i = 0; i < kBenchmarkIterations; ++i) {
+    base::TimeTicks start = base::TimeTicks::Now();
+    ASSERT_TRUE(stream.Append(new_gops[i]));
+    append_time += base::TimeTicks::Now() - start;
+
+    start = base::TimeTicks::Now();
+    stream.Remove(GopStart(i), GopStart(i + 1),
+                  GopStart(kBufferedGops + i + 1));
+    remove_time += base::TimeTicks::Now() - start;
+  }
+
+  perf_test::PrintResult("source_buffer_stream_append", "", trace_name,
+                         append_time.InMillisecondsF() / kBenchmarkIterations,
+                         "ms", true);
+  perf_test::PrintResult("source_buffer_stream_remove", "", trace_name,
+                         remove_time.InMillisecondsF() / kBenchmarkIterations,
+                         "ms", true);
+}
+
+}  // namespace
+
+// Benchmarks Append() and Remove() of single GOPs against hours of buffered
+// media, the work ChunkDemuxer::AppendData() and SourceBuffer.remove() drive.
+TEST(SourceBufferStreamPerfTest, SlidingWindow) {
+  RunSlidingWindowBench<SourceBufferRangeByDts>("by_dts");
+  RunSlidingWindowBench<SourceBufferRangeByPts>("by_pts");
+}
+
+}  // namespace media
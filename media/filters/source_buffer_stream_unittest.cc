@@ -4205,6 +4205,26 @@ TEST_P(SourceBufferStreamTest, Remove_BeforeCurrentPosition) {
   CheckExpectedBuffers("150 180K 210 240 270K 300 330");
 }
 
+// Test removing GOPs from the front of a long range, which moves the rest of
+// the range's buffers rather than copying them.
+TEST_P(SourceBufferStreamTest, Remove_FrontOfLongRange) {
+  Seek(0);
+  NewCodedFrameGroupAppend(0, 100);
+  CheckExpectedRanges("{ [0,99) }");
+  CheckExpectedBuffers(0, 12);
+
+  // Remove the first two GOPs, which are before the current position.
+  Remove(base::TimeDelta(), frame_duration() * 10, frame_duration() * 100);
+  CheckExpectedRanges("{ [10,99) }");
+  EXPECT_EQ(90u * kDataSize, STREAM_OP(GetBufferedSize()));
+
+  // Appends continue to extend the remaining range.
+  AppendBuffers(100, 10);
+  CheckExpectedRanges("{ [10,109) }");
+  CheckExpectedBuffers(13, 109);
+  CheckNoNextBuffer();
+}
+
 // Test removing the preliminary portion for the current coded frame group being
 // appended.
 TEST_P(SourceBufferStreamTest, Remove_MidGroup) {
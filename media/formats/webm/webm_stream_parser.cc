@@ -78,14 +78,39 @@ bool WebMStreamParser::Parse(const uint8_t* buf, int size) {
   if (state_ == kError)
     return false;
 
+  const uint8_t* cur = NULL;
+  int cur_size = 0;
+  byte_queue_.Peek(&cur, &cur_size);
+
+  // If nothing is left over from a previous append, parse straight out of
+  // |buf| and queue only the trailing bytes of an incomplete element. Appends
+  // usually hold whole clusters, so this avoids copying them into
+  // |byte_queue_| only to parse and pop them right away.
+  if (cur_size == 0) {
+    int bytes_parsed = ParseBuffer(buf, size);
+    if (bytes_parsed < 0)
+      return false;
+    if (bytes_parsed < size)
+      byte_queue_.Push(buf + bytes_parsed, size - bytes_parsed);
+    return true;
+  }
+
   byte_queue_.Push(buf, size);
+  byte_queue_.Peek(&cur, &cur_size);
+  int bytes_parsed = ParseBuffer(cur, cur_size);
+  if (bytes_parsed < 0)
+    return false;
 
+  byte_queue_.Pop(bytes_parsed);
+  return true;
+}
+
+int WebMStreamParser::ParseBuffer(const uint8_t* data, int size) {
   int result = 0;
   int bytes_parsed = 0;
-  const uint8_t* cur = NULL;
-  int cur_size = 0;
+  const uint8_t* cur = data;
+  int cur_size = size;
 
-  byte_queue_.Peek(&cur, &cur_size);
   while (cur_size > 0) {
     State oldState = state_;
     switch (state_) {
@@ -99,12 +124,12 @@ bool WebMStreamParser::Parse(const uint8_t* buf, int size) {
 
       case kWaitingForInit:
       case kError:
-        return false;
+        return -1;
     }
 
     if (result < 0) {
       ChangeState(kError);
-      return false;
+      return -1;
     }
 
     if (state_ == oldState && result == 0)
@@ -116,8 +141,7 @@ bool WebMStreamParser::Parse(const uint8_t* buf, int size) {
     bytes_parsed += result;
   }
 
-  byte_queue_.Pop(bytes_parsed);
-  return true;
+  return bytes_parsed;
 }
 
 void WebMStreamParser::ChangeState(State new_state) {
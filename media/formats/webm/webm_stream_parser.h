@@ -69,6 +69,11 @@ class MEDIA_EXPORT WebMStreamParser : public StreamParser {
   // Returning > 0 indicates success & the number of bytes parsed.
   int ParseCluster(const uint8_t* data, int size);
 
+  // Parses as much of |data| as possible, dispatching to ParseInfoAndTracks()
+  // and ParseCluster() as |state_| changes. Returns the number of bytes which
+  // were parsed, or < 0 if the parse fails.
+  int ParseBuffer(const uint8_t* data, int size);
+
   // Fire the encrypted event through the |encrypted_media_init_data_cb_|.
   void OnEncryptedMediaInitData(const std::string& key_id);
 
@@ -4,6 +4,7 @@
 
 #include "media/formats/webm/webm_stream_parser.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "base/bind.h"
@@ -27,8 +28,11 @@ class WebMStreamParserTest : public testing::Test {
   WebMStreamParserTest() = default;
 
  protected:
+  // Parses |filename|, passing it to the parser |append_size| bytes at a time,
+  // or all at once if |append_size| is 0.
   void ParseWebMFile(const std::string& filename,
-                     const StreamParser::InitParameters& expected_params) {
+                     const StreamParser::InitParameters& expected_params,
+                     int append_size = 0) {
     scoped_refptr<DecoderBuffer> buffer = ReadTestDataFile(filename);
     parser_.reset(new WebMStreamParser());
     Demuxer::EncryptedMediaInitDataCB encrypted_media_init_data_cb =
@@ -40,7 +44,8 @@ class WebMStreamParserTest : public testing::Test {
     EXPECT_CALL(*this, EndMediaSegmentCB()).Times(testing::AnyNumber());
     EXPECT_CALL(*this, NewBuffersCB(_))
         .Times(testing::AnyNumber())
-        .WillRepeatedly(testing::Return(true));
+        .WillRepeatedly(
+            testing::Invoke(this, &WebMStreamParserTest::CountBuffers));
     parser_->Init(base::BindOnce(&WebMStreamParserTest::InitF,
                                  base::Unretained(this), expected_params),
                   base::BindRepeating(&WebMStreamParserTest::NewConfigCB,
@@ -54,8 +59,14 @@ class WebMStreamParserTest : public testing::Test {
                   base::BindRepeating(&WebMStreamParserTest::EndMediaSegmentCB,
                                       base::Unretained(this)),
                   &media_log_);
-    bool result = parser_->Parse(buffer->data(), buffer->data_size());
-    EXPECT_TRUE(result);
+    const int size = buffer->data_size();
+    if (append_size == 0)
+      append_size = size;
+    for (int offset = 0; offset < size; offset += append_size) {
+      bool result = parser_->Parse(buffer->data() + offset,
+                                   std::min(append_size, size - offset));
+      EXPECT_TRUE(result);
+    }
   }
 
   // Verifies only the detected track counts by track type, then chains to the
@@ -81,6 +92,12 @@ class WebMStreamParserTest : public testing::Test {
   }
 
   MOCK_METHOD1(NewBuffersCB, bool(const StreamParser::BufferQueueMap&));
+
+  bool CountBuffers(const StreamParser::BufferQueueMap& buffer_queue_map) {
+    for (const auto& entry : buffer_queue_map)
+      num_buffers_ += entry.second.size();
+    return true;
+  }
   MOCK_METHOD2(OnEncryptedMediaInitData,
                void(EmeInitDataType init_data_type,
                     const std::vector<uint8_t>& init_data));
@@ -90,6 +107,7 @@ class WebMStreamParserTest : public testing::Test {
   testing::StrictMock<MockMediaLog> media_log_;
   std::unique_ptr<WebMStreamParser> parser_;
   std::unique_ptr<MediaTracks> media_tracks_;
+  size_t num_buffers_ = 0;
 };
 
 TEST_F(WebMStreamParserTest, VerifyMediaTrackMetadata) {
@@ -119,6 +137,25 @@ TEST_F(WebMStreamParserTest, VerifyMediaTrackMetadata) {
   EXPECT_EQ(audio_track.language(), "und");
 }
 
+TEST_F(WebMStreamParserTest, SplitAppendsEmitSameBuffers) {
+  EXPECT_MEDIA_LOG(WebMSimpleBlockDurationEstimatedAny())
+      .Times(testing::AnyNumber());
+  StreamParser::InitParameters params(kInfiniteDuration);
+  params.detected_audio_track_count = 1;
+  params.detected_video_track_count = 1;
+  params.detected_text_track_count = 0;
+
+  ParseWebMFile("bear.webm", params);
+  const size_t whole_file_buffers = num_buffers_;
+  EXPECT_GT(whole_file_buffers, 0u);
+
+  // An odd append size leaves elements straddling appends, so parsing
+  // alternates between the caller's buffer and the internal queue.
+  num_buffers_ = 0;
+  ParseWebMFile("bear.webm", params, 997);
+  EXPECT_EQ(whole_file_buffers, num_buffers_);
+}
+
 TEST_F(WebMStreamParserTest, VerifyDetectedTrack_AudioOnly) {
   EXPECT_MEDIA_LOG(WebMSimpleBlockDurationEstimatedAny())
       .Times(testing::AnyNumber());
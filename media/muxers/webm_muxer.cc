@@ -53,6 +53,9 @@ static double GetFrameRate(const WebmMuxer::VideoParameters& params) {
   return frame_rate;
 }
 
+// Upper bound for the video frames held while waiting for the audio track.
+constexpr size_t kMaxEncodedFramesQueueBytes = 16 * 1024 * 1024;
+
 static const char kH264CodecId[] = "V_MPEG4/ISO/AVC";
 static const char kPcmCodecId[] = "A_PCM/FLOAT/IEEE";
 
@@ -95,7 +98,10 @@ WebmMuxer::WebmMuxer(VideoCodec video_codec,
       has_audio_(has_audio),
       write_data_callback_(write_data_callback),
       position_(0),
-      force_one_libwebm_error_(false) {
+      force_one_libwebm_error_(false),
+      encoded_frames_queue_bytes_(0),
+      max_encoded_frames_queue_bytes_(kMaxEncodedFramesQueueBytes),
+      drop_video_until_key_frame_(false) {
   DCHECK(has_video_ || has_audio_);
   DCHECK(!write_data_callback_.is_null());
   DCHECK(video_codec == kCodecVP8 || video_codec == kCodecVP9 ||
@@ -145,12 +151,35 @@ bool WebmMuxer::OnEncodedVideo(const VideoParameters& params,
       first_frame_timestamp_video_ = timestamp;
   }
 
+  if (is_key_frame) {
+    drop_video_until_key_frame_ = false;
+  } else if (drop_video_until_key_frame_) {
+    DVLOG(1) << __func__ << ": dropping frame until next key frame.";
+    return true;
+  }
+
   // TODO(ajose): Support multiple tracks: http://crbug.com/528523
   if (has_audio_ && !audio_track_index_) {
     DVLOG(1) << __func__ << ": delaying until audio track ready.";
-    if (is_key_frame)  // Upon Key frame reception, empty the encoded queue.
+    if (is_key_frame) {  // Upon Key frame reception, empty the encoded queue.
       encoded_frames_queue_.clear();
-
+      encoded_frames_queue_bytes_ = 0;
+    }
+
+    const size_t frame_bytes =
+        encoded_data->size() + (encoded_alpha ? encoded_alpha->size() : 0u);
+    if (encoded_frames_queue_bytes_ + frame_bytes >
+        max_encoded_frames_queue_bytes_) {
+      DLOG(WARNING) << __func__ << ": too much video queued, dropping it.";
+      encoded_frames_queue_.clear();
+      encoded_frames_queue_bytes_ = 0;
+      if (!is_key_frame) {
+        drop_video_until_key_frame_ = true;
+        return true;
+      }
+    }
+
+    encoded_frames_queue_bytes_ += frame_bytes;
     encoded_frames_queue_.push_back(std::make_unique<EncodedVideoFrame>(
         std::move(encoded_data), std::move(encoded_alpha), timestamp,
         is_key_frame));
@@ -197,8 +226,14 @@ bool WebmMuxer::OnEncodedAudio(const media::AudioParameters& params,
         encoded_frames_queue_.front()->is_keyframe);
     if (!res)
       return false;
+    encoded_frames_queue_bytes_ -=
+        encoded_frames_queue_.front()->data->size() +
+        (encoded_frames_queue_.front()->alpha_data
+             ? encoded_frames_queue_.front()->alpha_data->size()
+             : 0u);
     encoded_frames_queue_.pop_front();
   }
+  DCHECK_EQ(0u, encoded_frames_queue_bytes_);
   return AddFrame(std::move(encoded_data), nullptr, audio_track_index_,
                   timestamp - first_frame_timestamp_audio_,
                   true /* is_key_frame -- always true for audio */);
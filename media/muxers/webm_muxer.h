@@ -84,6 +84,9 @@ class MEDIA_EXPORT WebmMuxer : public mkvmuxer::IMkvWriter {
   void Resume();
 
   void ForceOneLibWebmErrorForTesting() { force_one_libwebm_error_ = true; }
+  void SetMaxEncodedFramesQueueBytesForTesting(size_t max_bytes) {
+    max_encoded_frames_queue_bytes_ = max_bytes;
+  }
 
  private:
   friend class WebmMuxerTest;
@@ -168,6 +171,14 @@ class MEDIA_EXPORT WebmMuxer : public mkvmuxer::IMkvWriter {
   base::circular_deque<std::unique_ptr<EncodedVideoFrame>>
       encoded_frames_queue_;
 
+  // Sum of the sizes of the frames in |encoded_frames_queue_|. When it would
+  // go over |max_encoded_frames_queue_bytes_|, e.g. because audio takes a long
+  // time to arrive and key frames are rare, the queue is dropped and video is
+  // discarded until the next key frame so that memory stays bounded.
+  size_t encoded_frames_queue_bytes_;
+  size_t max_encoded_frames_queue_bytes_;
+  bool drop_video_until_key_frame_;
+
   DISALLOW_COPY_AND_ASSIGN(WebmMuxer);
 };
 
@@ -79,6 +79,15 @@ class WebmMuxerTest : public TestWithParam<TestParams> {
     return webm_muxer_.Write(buf, len);
   }
 
+  size_t GetEncodedFramesQueueBytes() const {
+    return webm_muxer_.encoded_frames_queue_bytes_;
+  }
+
+  bool IsFirstQueuedFrameKeyFrame() const {
+    return !webm_muxer_.encoded_frames_queue_.empty() &&
+           webm_muxer_.encoded_frames_queue_.front()->is_keyframe;
+  }
+
   WebmMuxer webm_muxer_;
 
   size_t last_encoded_length_;
@@ -313,6 +322,37 @@ TEST_P(WebmMuxerTest, VideoIsStoredWhileWaitingForAudio) {
       base::TimeTicks::Now()));
 }
 
+// This test simulates a long recording where audio never shows up and key
+// frames are rare, and verifies that the video queued while waiting for audio
+// stays under the configured limit and always starts with a key frame.
+TEST_P(WebmMuxerTest, LongRecordingWaitingForAudioHasBoundedMemory) {
+  // This test is only relevant if we have both kinds of tracks.
+  if (GetParam().num_video_tracks == 0 || GetParam().num_audio_tracks == 0)
+    return;
+
+  const size_t kMaxQueueBytes = 10 * 1024;
+  webm_muxer_.SetMaxEncodedFramesQueueBytesForTesting(kMaxQueueBytes);
+
+  const gfx::Size frame_size(160, 80);
+  const scoped_refptr<VideoFrame> video_frame =
+      VideoFrame::CreateBlackFrame(frame_size);
+  const std::string encoded_video(1000, 'v');
+  // One hour of 30 fps video with a key frame every 20 seconds.
+  const int kNumFrames = 30 * 60 * 60;
+  const int kKeyFrameInterval = 30 * 20;
+  base::TimeTicks timestamp = base::TimeTicks::Now();
+  for (int i = 0; i < kNumFrames; ++i) {
+    EXPECT_TRUE(webm_muxer_.OnEncodedVideo(
+        WebmMuxer::VideoParameters(video_frame),
+        std::make_unique<std::string>(encoded_video), nullptr, timestamp,
+        i % kKeyFrameInterval == 0 /* keyframe */));
+    timestamp += base::TimeDelta::FromMilliseconds(33);
+    ASSERT_LE(GetEncodedFramesQueueBytes(), kMaxQueueBytes);
+    if (GetEncodedFramesQueueBytes() > 0u)
+      ASSERT_TRUE(IsFirstQueuedFrameKeyFrame());
+  }
+}
+
 const TestParams kTestCases[] = {
     {kCodecVP8, kCodecOpus, 1 /* num_video_tracks */, 0 /*num_audio_tracks*/},
     {kCodecVP8, kCodecOpus, 0, 1},
@@ -124,7 +124,8 @@ void DefaultDecoderFactory::CreateVideoDecoders(
 
 #if BUILDFLAG(ENABLE_DAV1D_DECODER)
   if (base::FeatureList::IsEnabled(kDav1dVideoDecoder))
-    video_decoders->push_back(std::make_unique<Dav1dVideoDecoder>(media_log));
+    video_decoders->push_back(
+        std::make_unique<OffloadingDav1dVideoDecoder>(media_log));
   else
     video_decoders->push_back(std::make_unique<AomVideoDecoder>(media_log));
 #elif BUILDFLAG(ENABLE_AV1_DECODER)
@@ -5,11 +5,17 @@
 #include "media/renderers/paint_canvas_video_renderer.h"
 
 #include <GLES3/gl3.h>
+#include <algorithm>
 #include <limits>
 
+#include "base/barrier_closure.h"
 #include "base/bind.h"
 #include "base/macros.h"
 #include "base/memory/ptr_util.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/system/sys_info.h"
+#include "base/task/post_task.h"
+#include "base/threading/thread_restrictions.h"
 #include "cc/paint/paint_canvas.h"
 #include "cc/paint/paint_flags.h"
 #include "cc/paint/paint_image.h"
@@ -775,132 +781,136 @@ void TextureSubImageUsingIntermediate(unsigned target,
   gl->DeleteTextures(1, &temp_texture);
 }
 
-}  // anonymous namespace
-
-// static
-void PaintCanvasVideoRenderer::ConvertVideoFrameToRGBPixels(
-    const VideoFrame* video_frame,
-    void* rgb_pixels,
-    size_t row_bytes) {
-  if (!video_frame->IsMappable()) {
-    NOTREACHED() << "Cannot extract pixels from non-CPU frame formats.";
-    return;
+// Converts rows [|task_index| * rows / |n_tasks|, (|task_index| + 1) * rows /
+// |n_tasks|) of the visible area of |video_frame| to RGB, rounded to even rows
+// so that subsampled chroma planes split cleanly, then runs |done| if set.
+void ConvertVideoFrameToRGBPixelsTask(const VideoFrame* video_frame,
+                                      void* rgb_pixels,
+                                      size_t row_bytes,
+                                      SkYUVColorSpace color_space,
+                                      size_t task_index,
+                                      size_t n_tasks,
+                                      base::RepeatingClosure done) {
+  const VideoPixelFormat format = video_frame->format();
+  const int width = video_frame->visible_rect().width();
+  const size_t height = video_frame->visible_rect().height();
+
+  const size_t row_begin = (height * task_index / n_tasks) & ~1;
+  const size_t row_end = task_index + 1 == n_tasks
+                             ? height
+                             : (height * (task_index + 1) / n_tasks) & ~1;
+  const int rows = row_end - row_begin;
+
+  const uint8_t* plane_data[VideoFrame::kMaxPlanes] = {};
+  for (size_t plane = 0; plane < VideoFrame::NumPlanes(format); ++plane) {
+    plane_data[plane] =
+        video_frame->visible_data(plane) +
+        video_frame->stride(plane) *
+            (row_begin / VideoFrame::SampleSize(format, plane).height());
   }
+  uint8_t* pixels = static_cast<uint8_t*>(rgb_pixels) + row_bytes * row_begin;
 
-  // TODO(hubbe): This should really default to the rec709 colorspace.
-  // https://crbug.com/828599
-  SkYUVColorSpace color_space = kRec601_SkYUVColorSpace;
-  video_frame->ColorSpace().ToSkYUVColorSpace(&color_space);
-
-  switch (video_frame->format()) {
+  switch (format) {
     case PIXEL_FORMAT_YV12:
     case PIXEL_FORMAT_I420:
       switch (color_space) {
         case kJPEG_SkYUVColorSpace:
-          LIBYUV_J420_TO_ARGB(video_frame->visible_data(VideoFrame::kYPlane),
+          LIBYUV_J420_TO_ARGB(plane_data[VideoFrame::kYPlane],
                               video_frame->stride(VideoFrame::kYPlane),
-                              video_frame->visible_data(VideoFrame::kUPlane),
+                              plane_data[VideoFrame::kUPlane],
                               video_frame->stride(VideoFrame::kUPlane),
-                              video_frame->visible_data(VideoFrame::kVPlane),
+                              plane_data[VideoFrame::kVPlane],
                               video_frame->stride(VideoFrame::kVPlane),
-                              static_cast<uint8_t*>(rgb_pixels), row_bytes,
-                              video_frame->visible_rect().width(),
-                              video_frame->visible_rect().height());
+                              pixels, row_bytes, width, rows);
           break;
         case kRec709_SkYUVColorSpace:
-          LIBYUV_H420_TO_ARGB(video_frame->visible_data(VideoFrame::kYPlane),
+          LIBYUV_H420_TO_ARGB(plane_data[VideoFrame::kYPlane],
                               video_frame->stride(VideoFrame::kYPlane),
-                              video_frame->visible_data(VideoFrame::kUPlane),
+                              plane_data[VideoFrame::kUPlane],
                               video_frame->stride(VideoFrame::kUPlane),
-                              video_frame->visible_data(VideoFrame::kVPlane),
+                              plane_data[VideoFrame::kVPlane],
                               video_frame->stride(VideoFrame::kVPlane),
-                              static_cast<uint8_t*>(rgb_pixels), row_bytes,
-                              video_frame->visible_rect().width(),
-                              video_frame->visible_rect().height());
+                              pixels, row_bytes, width, rows);
           break;
         case kRec601_SkYUVColorSpace:
-          LIBYUV_I420_TO_ARGB(video_frame->visible_data(VideoFrame::kYPlane),
+          LIBYUV_I420_TO_ARGB(plane_data[VideoFrame::kYPlane],
                               video_frame->stride(VideoFrame::kYPlane),
-                              video_frame->visible_data(VideoFrame::kUPlane),
+                              plane_data[VideoFrame::kUPlane],
                               video_frame->stride(VideoFrame::kUPlane),
-                              video_frame->visible_data(VideoFrame::kVPlane),
+                              plane_data[VideoFrame::kVPlane],
                               video_frame->stride(VideoFrame::kVPlane),
-                              static_cast<uint8_t*>(rgb_pixels), row_bytes,
-                              video_frame->visible_rect().width(),
-                              video_frame->visible_rect().height());
+                              pixels, row_bytes, width, rows);
           break;
       }
       break;
     case PIXEL_FORMAT_I422:
-      LIBYUV_I422_TO_ARGB(video_frame->visible_data(VideoFrame::kYPlane),
+      LIBYUV_I422_TO_ARGB(plane_data[VideoFrame::kYPlane],
                           video_frame->stride(VideoFrame::kYPlane),
-                          video_frame->visible_data(VideoFrame::kUPlane),
+                          plane_data[VideoFrame::kUPlane],
                           video_frame->stride(VideoFrame::kUPlane),
-                          video_frame->visible_data(VideoFrame::kVPlane),
+                          plane_data[VideoFrame::kVPlane],
                           video_frame->stride(VideoFrame::kVPlane),
-                          static_cast<uint8_t*>(rgb_pixels), row_bytes,
-                          video_frame->visible_rect().width(),
-                          video_frame->visible_rect().height());
+                          pixels, row_bytes, width, rows);
       break;
 
     case PIXEL_FORMAT_I420A:
       LIBYUV_I420ALPHA_TO_ARGB(
-          video_frame->visible_data(VideoFrame::kYPlane),
+          plane_data[VideoFrame::kYPlane],
           video_frame->stride(VideoFrame::kYPlane),
-          video_frame->visible_data(VideoFrame::kUPlane),
+          plane_data[VideoFrame::kUPlane],
           video_frame->stride(VideoFrame::kUPlane),
-          video_frame->visible_data(VideoFrame::kVPlane),
+          plane_data[VideoFrame::kVPlane],
           video_frame->stride(VideoFrame::kVPlane),
-          video_frame->visible_data(VideoFrame::kAPlane),
+          plane_data[VideoFrame::kAPlane],
           video_frame->stride(VideoFrame::kAPlane),
-          static_cast<uint8_t*>(rgb_pixels), row_bytes,
-          video_frame->visible_rect().width(),
-          video_frame->visible_rect().height(),
+          pixels, row_bytes, width, rows,
           1);  // 1 = enable RGB premultiplication by Alpha.
       break;
 
     case PIXEL_FORMAT_I444:
-      LIBYUV_I444_TO_ARGB(video_frame->visible_data(VideoFrame::kYPlane),
+      LIBYUV_I444_TO_ARGB(plane_data[VideoFrame::kYPlane],
                           video_frame->stride(VideoFrame::kYPlane),
-                          video_frame->visible_data(VideoFrame::kUPlane),
+                          plane_data[VideoFrame::kUPlane],
                           video_frame->stride(VideoFrame::kUPlane),
-                          video_frame->visible_data(VideoFrame::kVPlane),
+                          plane_data[VideoFrame::kVPlane],
                           video_frame->stride(VideoFrame::kVPlane),
-                          static_cast<uint8_t*>(rgb_pixels), row_bytes,
-                          video_frame->visible_rect().width(),
-                          video_frame->visible_rect().height());
+                          pixels, row_bytes, width, rows);
       break;
 
     case PIXEL_FORMAT_YUV420P10:
       if (color_space == kRec709_SkYUVColorSpace) {
         LIBYUV_H010_TO_ARGB(reinterpret_cast<const uint16_t*>(
-                                video_frame->visible_data(VideoFrame::kYPlane)),
+                                plane_data[VideoFrame::kYPlane]),
                             video_frame->stride(VideoFrame::kYPlane) / 2,
                             reinterpret_cast<const uint16_t*>(
-                                video_frame->visible_data(VideoFrame::kUPlane)),
+                                plane_data[VideoFrame::kUPlane]),
                             video_frame->stride(VideoFrame::kUPlane) / 2,
                             reinterpret_cast<const uint16_t*>(
-                                video_frame->visible_data(VideoFrame::kVPlane)),
+                                plane_data[VideoFrame::kVPlane]),
                             video_frame->stride(VideoFrame::kVPlane) / 2,
-                            static_cast<uint8_t*>(rgb_pixels), row_bytes,
-                            video_frame->visible_rect().width(),
-                            video_frame->visible_rect().height());
+                            pixels, row_bytes, width, rows);
       } else {
         LIBYUV_I010_TO_ARGB(reinterpret_cast<const uint16_t*>(
-                                video_frame->visible_data(VideoFrame::kYPlane)),
+                                plane_data[VideoFrame::kYPlane]),
                             video_frame->stride(VideoFrame::kYPlane) / 2,
                             reinterpret_cast<const uint16_t*>(
-                                video_frame->visible_data(VideoFrame::kUPlane)),
+                                plane_data[VideoFrame::kUPlane]),
                             video_frame->stride(VideoFrame::kUPlane) / 2,
                             reinterpret_cast<const uint16_t*>(
-                                video_frame->visible_data(VideoFrame::kVPlane)),
+                                plane_data[VideoFrame::kVPlane]),
                             video_frame->stride(VideoFrame::kVPlane) / 2,
-                            static_cast<uint8_t*>(rgb_pixels), row_bytes,
-                            video_frame->visible_rect().width(),
-                            video_frame->visible_rect().height());
+                            pixels, row_bytes, width, rows);
       }
       break;
 
+    case PIXEL_FORMAT_NV12:
+      LIBYUV_NV12_TO_ARGB(plane_data[VideoFrame::kYPlane],
+                          video_frame->stride(VideoFrame::kYPlane),
+                          plane_data[VideoFrame::kUVPlane],
+                          video_frame->stride(VideoFrame::kUVPlane),
+                          pixels, row_bytes, width, rows);
+      break;
+
     case PIXEL_FORMAT_YUV420P9:
     case PIXEL_FORMAT_YUV422P9:
     case PIXEL_FORMAT_YUV444P9:
@@ -908,29 +918,9 @@ void PaintCanvasVideoRenderer::ConvertVideoFrameToRGBPixels(
     case PIXEL_FORMAT_YUV444P10:
     case PIXEL_FORMAT_YUV420P12:
     case PIXEL_FORMAT_YUV422P12:
-    case PIXEL_FORMAT_YUV444P12: {
-      scoped_refptr<VideoFrame> temporary_frame =
-          DownShiftHighbitVideoFrame(video_frame);
-      ConvertVideoFrameToRGBPixels(temporary_frame.get(), rgb_pixels,
-                                   row_bytes);
-      break;
-    }
-
+    case PIXEL_FORMAT_YUV444P12:
     case PIXEL_FORMAT_Y16:
-      // Since it is grayscale conversion, we disregard SK_PMCOLOR_BYTE_ORDER
-      // and always use GL_RGBA.
-      FlipAndConvertY16(video_frame, static_cast<uint8_t*>(rgb_pixels), GL_RGBA,
-                        GL_UNSIGNED_BYTE, false /*flip_y*/, row_bytes);
-      break;
-
-    case PIXEL_FORMAT_NV12:
-      LIBYUV_NV12_TO_ARGB(video_frame->visible_data(VideoFrame::kYPlane),
-                          video_frame->stride(VideoFrame::kYPlane),
-                          video_frame->visible_data(VideoFrame::kUVPlane),
-                          video_frame->stride(VideoFrame::kUVPlane),
-                          static_cast<uint8_t*>(rgb_pixels), row_bytes,
-                          video_frame->visible_rect().width(),
-                          video_frame->visible_rect().height());
+      NOTREACHED() << "Handled by ConvertVideoFrameToRGBPixels().";
       break;
 
     case PIXEL_FORMAT_NV21:
@@ -949,6 +939,91 @@ void PaintCanvasVideoRenderer::ConvertVideoFrameToRGBPixels(
       NOTREACHED() << "Only YUV formats and Y16 are supported, got: "
                    << media::VideoPixelFormatToString(video_frame->format());
   }
+
+  if (done)
+    done.Run();
+}
+
+}  // anonymous namespace
+
+// static
+void PaintCanvasVideoRenderer::ConvertVideoFrameToRGBPixels(
+    const VideoFrame* video_frame,
+    void* rgb_pixels,
+    size_t row_bytes) {
+  if (!video_frame->IsMappable()) {
+    NOTREACHED() << "Cannot extract pixels from non-CPU frame formats.";
+    return;
+  }
+
+  switch (video_frame->format()) {
+    case PIXEL_FORMAT_YUV420P9:
+    case PIXEL_FORMAT_YUV422P9:
+    case PIXEL_FORMAT_YUV444P9:
+    case PIXEL_FORMAT_YUV422P10:
+    case PIXEL_FORMAT_YUV444P10:
+    case PIXEL_FORMAT_YUV420P12:
+    case PIXEL_FORMAT_YUV422P12:
+    case PIXEL_FORMAT_YUV444P12: {
+      scoped_refptr<VideoFrame> temporary_frame =
+          DownShiftHighbitVideoFrame(video_frame);
+      ConvertVideoFrameToRGBPixels(temporary_frame.get(), rgb_pixels,
+                                   row_bytes);
+      return;
+    }
+
+    case PIXEL_FORMAT_Y16:
+      // Since it is grayscale conversion, we disregard SK_PMCOLOR_BYTE_ORDER
+      // and always use GL_RGBA.
+      FlipAndConvertY16(video_frame, static_cast<uint8_t*>(rgb_pixels), GL_RGBA,
+                        GL_UNSIGNED_BYTE, false /*flip_y*/, row_bytes);
+      return;
+
+    default:
+      break;
+  }
+
+  // TODO(hubbe): This should really default to the rec709 colorspace.
+  // https://crbug.com/828599
+  SkYUVColorSpace color_space = kRec601_SkYUVColorSpace;
+  video_frame->ColorSpace().ToSkYUVColorSpace(&color_space);
+
+  // Large frames are converted in horizontal stripes on the task scheduler,
+  // with the calling thread converting the first stripe. Each task handles at
+  // least |kTaskBytes| of input so that small frames stay on this thread.
+  constexpr size_t kTaskBytes = 1024 * 1024;
+  const size_t n_tasks = std::max<size_t>(
+      1, std::min<size_t>(
+             {VideoFrame::AllocationSize(video_frame->format(),
+                                         video_frame->visible_rect().size()) /
+                  kTaskBytes,
+              static_cast<size_t>(base::SysInfo::NumberOfProcessors()),
+              static_cast<size_t>(video_frame->visible_rect().height() / 2)}));
+  if (n_tasks == 1) {
+    ConvertVideoFrameToRGBPixelsTask(video_frame, rgb_pixels, row_bytes,
+                                     color_space, 0, 1,
+                                     base::RepeatingClosure());
+    return;
+  }
+
+  base::WaitableEvent event;
+  base::RepeatingClosure barrier = base::BarrierClosure(
+      n_tasks,
+      base::BindOnce(&base::WaitableEvent::Signal, base::Unretained(&event)));
+  for (size_t i = 1; i < n_tasks; ++i) {
+    base::PostTaskWithTraits(
+        FROM_HERE, {base::TaskPriority::USER_BLOCKING},
+        base::BindOnce(&ConvertVideoFrameToRGBPixelsTask,
+                       base::Unretained(video_frame), rgb_pixels, row_bytes,
+                       color_space, i, n_tasks, barrier));
+  }
+  ConvertVideoFrameToRGBPixelsTask(video_frame, rgb_pixels, row_bytes,
+                                   color_space, 0, n_tasks, barrier);
+
+  // The other stripes are short CPU-bound tasks, so waiting for them here is
+  // cheaper than making every caller asynchronous.
+  base::ScopedAllowBaseSyncPrimitivesOutsideBlockingScope allow_wait;
+  event.Wait();
 }
 
 // static
@@ -0,0 +1,68 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/test/scoped_task_environment.h"
+#include "base/time/time.h"
+#include "media/base/video_frame.h"
+#include "media/renderers/paint_canvas_video_renderer.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace media {
+
+static const int kBenchmarkIterations = 50;
+
+class PaintCanvasVideoRendererPerfTest
+    : public testing::TestWithParam<VideoPixelFormat> {
+ public:
+  PaintCanvasVideoRendererPerfTest() = default;
+
+  void RunConvertBenchmark(const gfx::Size& size,
+                           const std::string& trace_name) {
+    scoped_refptr<VideoFrame> frame = VideoFrame::CreateZeroInitializedFrame(
+        GetParam(), size, gfx::Rect(size), size, base::TimeDelta());
+    ASSERT_TRUE(frame);
+
+    const size_t row_bytes = size.width() * 4;
+    std::vector<uint8_t> pixels(row_bytes * size.height());
+
+    base::TimeTicks start = base::TimeTicks::Now();
+    for (int i = 0; i < kBenchmarkIterations; ++i) {
+      PaintCanvasVideoRenderer::ConvertVideoFrameToRGBPixels(
+          frame.get(), pixels.data(), row_bytes);
+    }
+    double total_time_seconds =
+        (base::TimeTicks::Now() - start).InSecondsF();
+    perf_test::PrintResult("paint_canvas_video_renderer_convert",
+                           VideoPixelFormatToString(GetParam()), trace_name,
+                           kBenchmarkIterations / total_time_seconds,
+                           "frames/s", true);
+  }
+
+ private:
+  base::test::ScopedTaskEnvironment task_environment_;
+
+  DISALLOW_COPY_AND_ASSIGN(PaintCanvasVideoRendererPerfTest);
+};
+
+TEST_P(PaintCanvasVideoRendererPerfTest, Convert1080p) {
+  RunConvertBenchmark(gfx::Size(1920, 1080), "1080p");
+}
+
+TEST_P(PaintCanvasVideoRendererPerfTest, Convert4K) {
+  RunConvertBenchmark(gfx::Size(3840, 2160), "4k");
+}
+
+INSTANTIATE_TEST_SUITE_P(,
+                         PaintCanvasVideoRendererPerfTest,
+                         testing::Values(PIXEL_FORMAT_I420,
+                                         PIXEL_FORMAT_NV12));
+
+}  // namespace media
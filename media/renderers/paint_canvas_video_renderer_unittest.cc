@@ -5,10 +5,13 @@
 #include <GLES3/gl3.h>
 #include <stdint.h>
 
+#include <algorithm>
+#include <vector>
+
 #include "base/bind.h"
 #include "base/macros.h"
 #include "base/memory/aligned_memory.h"
-#include "base/message_loop/message_loop.h"
+#include "base/test/scoped_task_environment.h"
 #include "cc/paint/paint_flags.h"
 #include "cc/paint/skia_paint_canvas.h"
 #include "gpu/GLES2/gl2extchromium.h"
@@ -110,7 +113,7 @@ class PaintCanvasVideoRendererTest : public testing::Test {
 
   SkBitmap bitmap_;
   cc::SkiaPaintCanvas target_canvas_;
-  base::MessageLoop message_loop_;
+  base::test::ScopedTaskEnvironment task_environment_;
 
   DISALLOW_COPY_AND_ASSIGN(PaintCanvasVideoRendererTest);
 };
@@ -639,6 +642,43 @@ void MailboxHoldersReleased(const gpu::SyncToken& sync_token) {}
 
 // Test that PaintCanvasVideoRendererTest::Paint doesn't crash when GrContext is
 // abandoned.
+// Frames large enough to be converted in parallel stripes must produce the
+// same pixels as converting each part of the frame separately.
+TEST_F(PaintCanvasVideoRendererTest, ConvertLargeFrameToRGBPixels) {
+  const gfx::Size size(1920, 1080);
+  for (VideoPixelFormat format : {PIXEL_FORMAT_I420, PIXEL_FORMAT_NV12}) {
+    SCOPED_TRACE(VideoPixelFormatToString(format));
+    scoped_refptr<VideoFrame> frame = VideoFrame::CreateFrame(
+        format, size, gfx::Rect(size), size, base::TimeDelta());
+    for (size_t plane = 0; plane < VideoFrame::NumPlanes(format); ++plane) {
+      for (int row = 0; row < frame->rows(plane); ++row) {
+        uint8_t* data = frame->data(plane) + row * frame->stride(plane);
+        for (int i = 0; i < frame->row_bytes(plane); ++i)
+          data[i] = static_cast<uint8_t>(i + 3 * row + 64 * plane);
+      }
+    }
+
+    const size_t row_bytes = size.width() * 4;
+    std::vector<uint8_t> pixels(row_bytes * size.height());
+    PaintCanvasVideoRenderer::ConvertVideoFrameToRGBPixels(
+        frame.get(), pixels.data(), row_bytes);
+
+    // Each 64 row slice is small enough to be converted on this thread alone.
+    constexpr int kSliceRows = 64;
+    std::vector<uint8_t> expected_pixels(pixels.size());
+    for (int y = 0; y < size.height(); y += kSliceRows) {
+      const gfx::Rect slice(0, y, size.width(),
+                            std::min(kSliceRows, size.height() - y));
+      scoped_refptr<VideoFrame> slice_frame = VideoFrame::WrapVideoFrame(
+          frame, format, slice, slice.size());
+      PaintCanvasVideoRenderer::ConvertVideoFrameToRGBPixels(
+          slice_frame.get(), expected_pixels.data() + y * row_bytes,
+          row_bytes);
+    }
+    EXPECT_EQ(expected_pixels, pixels);
+  }
+}
+
 TEST_F(PaintCanvasVideoRendererTest, ContextLost) {
   sk_sp<const GrGLInterface> null_interface(GrGLCreateNullInterface());
   sk_sp<GrContext> gr_context = GrContext::MakeGL(std::move(null_interface));
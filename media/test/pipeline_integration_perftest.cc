@@ -6,6 +6,7 @@
 #include "media/media_buildflags.h"
 #include "media/test/pipeline_integration_test_base.h"
 #include "testing/perf/perf_test.h"
+#include "third_party/libaom/av1_buildflags.h"
 
 namespace media {
 
@@ -17,6 +18,7 @@ static void RunPlaybackBenchmark(const std::string& filename,
                                  int iterations,
                                  bool audio_only) {
   double time_seconds = 0.0;
+  uint32_t video_frames_decoded = 0;
 
   for (int i = 0; i < iterations; ++i) {
     PipelineIntegrationTestBase pipeline;
@@ -27,6 +29,7 @@ static void RunPlaybackBenchmark(const std::string& filename,
     pipeline.Play();
 
     ASSERT_TRUE(pipeline.WaitUntilOnEnded());
+    video_frames_decoded += pipeline.GetStatistics().video_frames_decoded;
 
     // Call Stop() to ensure that the rendering is complete.
     pipeline.Stop();
@@ -40,6 +43,11 @@ static void RunPlaybackBenchmark(const std::string& filename,
 
   perf_test::PrintResult(name, "", filename, iterations / time_seconds,
                          "runs/s", true);
+  if (!audio_only) {
+    perf_test::PrintResult(name + "_decode_fps", "", filename,
+                           video_frames_decoded / time_seconds, "frames/s",
+                           true);
+  }
 }
 
 static void RunVideoPlaybackBenchmark(const std::string& filename,
@@ -81,6 +89,12 @@ TEST(PipelineIntegrationPerfTest, VP9PlaybackBenchmark) {
   RunVideoPlaybackBenchmark("bear-vp9.webm", "clockless_video_playback_vp9");
 }
 
+#if BUILDFLAG(ENABLE_AV1_DECODER)
+TEST(PipelineIntegrationPerfTest, AV1PlaybackBenchmark) {
+  RunVideoPlaybackBenchmark("bear-av1.webm", "clockless_video_playback_av1");
+}
+#endif
+
 #if BUILDFLAG(USE_PROPRIETARY_CODECS) && BUILDFLAG(ENABLE_FFMPEG_VIDEO_DECODERS)
 TEST(PipelineIntegrationPerfTest, MP4PlaybackBenchmark) {
   RunVideoPlaybackBenchmark("bear_silent.mp4", "clockless_video_playback_mp4");
@@ -75,7 +75,8 @@ static std::vector<std::unique_ptr<VideoDecoder>> CreateVideoDecodersForTest(
 
 #if BUILDFLAG(ENABLE_DAV1D_DECODER)
   if (base::FeatureList::IsEnabled(kDav1dVideoDecoder))
-    video_decoders.push_back(std::make_unique<Dav1dVideoDecoder>(media_log));
+    video_decoders.push_back(
+        std::make_unique<OffloadingDav1dVideoDecoder>(media_log));
   else
     video_decoders.push_back(std::make_unique<AomVideoDecoder>(media_log));
 #elif BUILDFLAG(ENABLE_AV1_DECODER)
@@ -586,6 +587,10 @@ base::TimeDelta PipelineIntegrationTestBase::GetAudioTime() {
   return clockless_audio_sink_->render_time();
 }
 
+PipelineStatistics PipelineIntegrationTestBase::GetStatistics() const {
+  return pipeline_->GetStatistics();
+}
+
 PipelineStatus PipelineIntegrationTestBase::StartPipelineWithMediaSource(
     TestMediaSource* source) {
   return StartPipelineWithMediaSource(source, kNormal, nullptr);
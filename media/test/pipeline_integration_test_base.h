@@ -133,6 +133,9 @@ class PipelineIntegrationTestBase : public Pipeline::Client {
   // Pipeline must have been started with clockless playback enabled.
   base::TimeDelta GetAudioTime();
 
+  // Returns the pipeline's decode and render statistics so far.
+  PipelineStatistics GetStatistics() const;
+
   // Sets a callback to handle EME "encrypted" event. Must be called to test
   // potentially encrypted media.
   void set_encrypted_media_init_data_cb(
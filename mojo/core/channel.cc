@@ -305,29 +305,36 @@ size_t Channel::Message::capacity() const {
 void Channel::Message::ExtendPayload(size_t new_payload_size) {
   size_t capacity_without_header = capacity();
   size_t header_size = capacity_ - capacity_without_header;
-  if (new_payload_size > capacity_without_header) {
-    size_t new_capacity =
-        std::max(capacity_without_header * 2, new_payload_size) + header_size;
-    void* new_data = base::AlignedAlloc(new_capacity, kChannelMessageAlignment);
-    memcpy(new_data, data_, capacity_);
-    base::AlignedFree(data_);
-    data_ = static_cast<char*>(new_data);
-    capacity_ = new_capacity;
+  if (new_payload_size > capacity_without_header)
+    ReserveCapacity(std::max(capacity_without_header * 2, new_payload_size));
+  size_ = header_size + new_payload_size;
+  DCHECK(base::IsValueInRangeForNumericType<uint32_t>(size_));
+  legacy_header()->num_bytes = static_cast<uint32_t>(size_);
+}
 
-    if (max_handles_ > 0) {
+void Channel::Message::ReserveCapacity(size_t payload_capacity) {
+  size_t capacity_without_header = capacity();
+  if (payload_capacity <= capacity_without_header)
+    return;
+
+  size_t header_size = capacity_ - capacity_without_header;
+  size_t new_capacity = payload_capacity + header_size;
+  void* new_data = base::AlignedAlloc(new_capacity, kChannelMessageAlignment);
+  memcpy(new_data, data_, capacity_);
+  base::AlignedFree(data_);
+  data_ = static_cast<char*>(new_data);
+  capacity_ = new_capacity;
+
+  if (max_handles_ > 0) {
 // We also need to update the cached extra header addresses in case the
 // payload buffer has been relocated.
 #if defined(OS_WIN)
-      handles_ = reinterpret_cast<HandleEntry*>(mutable_extra_header());
+    handles_ = reinterpret_cast<HandleEntry*>(mutable_extra_header());
 #elif defined(OS_MACOSX) && !defined(OS_IOS)
-      mach_ports_header_ =
-          reinterpret_cast<MachPortsExtraHeader*>(mutable_extra_header());
+    mach_ports_header_ =
+        reinterpret_cast<MachPortsExtraHeader*>(mutable_extra_header());
 #endif
-    }
   }
-  size_ = header_size + new_payload_size;
-  DCHECK(base::IsValueInRangeForNumericType<uint32_t>(size_));
-  legacy_header()->num_bytes = static_cast<uint32_t>(size_);
 }
 
 const void* Channel::Message::extra_header() const {
@@ -174,6 +174,11 @@ class MOJO_SYSTEM_IMPL_EXPORT Channel
     // new payload size, it will be reallocated accordingly.
     void ExtendPayload(size_t new_payload_size);
 
+    // Ensures that the message has storage capacity for at least
+    // |payload_capacity| bytes of payload, reallocating if necessary. The
+    // size of the meaningful payload is not changed.
+    void ReserveCapacity(size_t payload_capacity);
+
     const void* extra_header() const;
     void* mutable_extra_header();
     size_t extra_header_size() const;
@@ -21,6 +21,7 @@
 #include "base/synchronization/lock.h"
 #include "base/task_runner.h"
 #include "build/build_config.h"
+#include "mojo/core/configuration.h"
 #include "mojo/core/core.h"
 #include "mojo/public/cpp/platform/socket_utils_posix.h"
 
@@ -39,6 +40,10 @@ namespace {
 
 const size_t kMaxBatchReadCapacity = 256 * 1024;
 
+// The maximum number of queued messages written with a single writev(). Well
+// below the IOV_MAX of all supported platforms.
+const size_t kMaxBatchWriteMessages = 64;
+
 // A view over a Channel::Message object. The write queue uses these since
 // large messages may need to be sent in chunks.
 class MessageView {
@@ -76,6 +81,8 @@ class MessageView {
     }
   }
 
+  bool has_handles() const { return !handles_.empty(); }
+
   std::vector<PlatformHandleInTransit> TakeHandles() {
     return std::move(handles_);
   }
@@ -176,6 +183,10 @@ class ChannelPosix : public Channel,
       base::AutoLock lock(write_lock_);
       if (reject_writes_)
         return;
+      if (GetConfiguration().coalesce_channel_writes) {
+        CoalesceWriteNoLock(std::move(message));
+        return;
+      }
       if (outgoing_messages_.empty()) {
         if (!WriteNoLock(MessageView(std::move(message), 0)))
           reject_writes_ = write_error = true;
@@ -344,6 +355,46 @@ class ChannelPosix : public Channel,
     }
   }
 
+  // Queues |message| to be written along with the other messages written
+  // before the I/O thread gets to flush them, or immediately once there are
+  // enough of them to fill a batch.
+  void CoalesceWriteNoLock(MessagePtr message) {
+    outgoing_messages_.emplace_back(std::move(message), 0);
+    if (pending_write_)
+      return;
+    if (outgoing_messages_.size() >= kMaxBatchWriteMessages) {
+      if (!FlushOutgoingMessagesNoLock()) {
+        reject_writes_ = true;
+        io_task_runner_->PostTask(
+            FROM_HERE, base::BindOnce(&ChannelPosix::OnWriteError, this,
+                                      Error::kDisconnected));
+      }
+      return;
+    }
+    if (coalesced_flush_scheduled_)
+      return;
+    coalesced_flush_scheduled_ = true;
+    io_task_runner_->PostTask(
+        FROM_HERE,
+        base::BindOnce(&ChannelPosix::FlushCoalescedWritesOnIOThread, this));
+  }
+
+  void FlushCoalescedWritesOnIOThread() {
+    bool write_error = false;
+    {
+      base::AutoLock lock(write_lock_);
+      coalesced_flush_scheduled_ = false;
+      // Nothing to do if the socket isn't connected yet or is waiting to be
+      // writable, it will be flushed then.
+      if (reject_writes_ || pending_write_ || !write_watcher_)
+        return;
+      if (!FlushOutgoingMessagesNoLock())
+        reject_writes_ = write_error = true;
+    }
+    if (write_error)
+      OnWriteError(Error::kDisconnected);
+  }
+
   void ShutDownOnIOThread() {
     base::MessageLoopCurrent::Get()->RemoveDestructionObserver(this);
 
@@ -611,28 +662,78 @@ class ChannelPosix : public Channel,
     return FlushOutgoingMessagesNoLock();
   }
 
+  // Writes the leading messages of |messages| which have no handles attached
+  // with a single writev(), and removes the ones fully written. Sets
+  // |would_block| if nothing could be written. Returns false on error.
+  bool WriteBatchNoLock(base::circular_deque<MessageView>* messages,
+                        bool* would_block) {
+    iovec iov[kMaxBatchWriteMessages];
+    size_t num_iov = 0;
+    while (num_iov < messages->size() && num_iov < kMaxBatchWriteMessages &&
+           !(*messages)[num_iov].has_handles()) {
+      const MessageView& message_view = (*messages)[num_iov];
+      iov[num_iov].iov_base = const_cast<void*>(message_view.data());
+      iov[num_iov].iov_len = message_view.data_num_bytes();
+      ++num_iov;
+    }
+    DCHECK_GT(num_iov, 1u);
+
+    ssize_t result = SocketWritev(socket_.get(), iov, num_iov);
+    if (result < 0 && errno != EAGAIN && errno != EWOULDBLOCK)
+      return false;
+    if (result <= 0) {
+      *would_block = true;
+      return true;
+    }
+
+    size_t bytes_written = static_cast<size_t>(result);
+    while (bytes_written > 0) {
+      MessageView& message_view = messages->front();
+      if (bytes_written < message_view.data_num_bytes()) {
+        message_view.advance_data_offset(bytes_written);
+        break;
+      }
+      bytes_written -= message_view.data_num_bytes();
+      messages->pop_front();
+    }
+    return true;
+  }
+
   bool FlushOutgoingMessagesNoLock() {
     base::circular_deque<MessageView> messages;
     std::swap(outgoing_messages_, messages);
 
     while (!messages.empty()) {
-      if (!WriteNoLock(std::move(messages.front())))
-        return false;
+      // Messages that queued up while the socket was full are written
+      // together, one syscall for the batch rather than one per message.
+      if (!server_.is_valid() && messages.size() > 1 &&
+          !messages[0].has_handles() && !messages[1].has_handles()) {
+        bool would_block = false;
+        if (!WriteBatchNoLock(&messages, &would_block))
+          return false;
+        if (!would_block)
+          continue;
+        WaitForWriteOnIOThreadNoLock();
+      } else {
+        if (!WriteNoLock(std::move(messages.front())))
+          return false;
 
-      messages.pop_front();
-      if (!outgoing_messages_.empty()) {
-        // The message was requeued by WriteNoLock(), so we have to wait for
-        // pipe to become writable again. Repopulate the message queue and exit.
-        // If sending the message triggered any control messages, they may be
-        // in |outgoing_messages_| in addition to or instead of the message
-        // being sent.
-        std::swap(messages, outgoing_messages_);
-        while (!messages.empty()) {
-          outgoing_messages_.push_front(std::move(messages.back()));
-          messages.pop_back();
-        }
-        return true;
+        messages.pop_front();
+        if (outgoing_messages_.empty())
+          continue;
       }
+
+      // The message was requeued by WriteNoLock() or the batch didn't fit, so
+      // we have to wait for pipe to become writable again. Repopulate the
+      // message queue and exit. If sending the message triggered any control
+      // messages, they may be in |outgoing_messages_| in addition to or
+      // instead of the message being sent.
+      std::swap(messages, outgoing_messages_);
+      while (!messages.empty()) {
+        outgoing_messages_.push_front(std::move(messages.back()));
+        messages.pop_back();
+      }
+      return true;
     }
 
     return true;
@@ -742,10 +843,14 @@ class ChannelPosix : public Channel,
 
   base::circular_deque<base::ScopedFD> incoming_fds_;
 
-  // Protects |pending_write_| and |outgoing_messages_|.
+  // Protects |pending_write_|, |coalesced_flush_scheduled_| and
+  // |outgoing_messages_|.
   base::Lock write_lock_;
   bool pending_write_ = false;
   bool reject_writes_ = false;
+  // Whether FlushCoalescedWritesOnIOThread() is posted, when writes are
+  // coalesced.
+  bool coalesced_flush_scheduled_ = false;
   base::circular_deque<MessageView> outgoing_messages_;
 
   bool leak_handle_ = false;
@@ -5,12 +5,14 @@
 #include "mojo/core/channel.h"
 
 #include "base/bind.h"
+#include "base/bind_helpers.h"
 #include "base/memory/ptr_util.h"
 #include "base/message_loop/message_loop.h"
 #include "base/optional.h"
 #include "base/process/process_handle.h"
 #include "base/run_loop.h"
 #include "base/threading/thread.h"
+#include "mojo/core/configuration.h"
 #include "mojo/core/platform_handle_utils.h"
 #include "mojo/public/cpp/platform/platform_channel.h"
 #include "testing/gmock/include/gmock/gmock.h"
@@ -341,6 +343,117 @@ TEST(ChannelTest, RejectHandles) {
   EXPECT_EQ(0u, receiver_delegate.num_messages());
 }
 
+class OrderCheckingDelegate : public Channel::Delegate {
+ public:
+  OrderCheckingDelegate(size_t num_expected_messages,
+                        base::OnceClosure quit_closure)
+      : num_expected_messages_(num_expected_messages),
+        quit_closure_(std::move(quit_closure)) {}
+
+  size_t num_messages() const { return num_messages_; }
+
+  // Channel::Delegate:
+  void OnChannelMessage(const void* payload,
+                        size_t payload_size,
+                        std::vector<PlatformHandle> handles) override {
+    ASSERT_GE(payload_size, sizeof(uint32_t));
+    EXPECT_EQ(num_messages_, *static_cast<const uint32_t*>(payload));
+    if (++num_messages_ == num_expected_messages_)
+      std::move(quit_closure_).Run();
+  }
+
+  void OnChannelError(Channel::Error error) override {}
+
+ private:
+  const size_t num_expected_messages_;
+  size_t num_messages_ = 0;
+  base::OnceClosure quit_closure_;
+
+  DISALLOW_COPY_AND_ASSIGN(OrderCheckingDelegate);
+};
+
+// Writes more messages than the socket can buffer, so that they queue up and
+// are flushed once it is writable again.
+TEST(ChannelTest, QueuedMessagesArriveInOrder) {
+  base::MessageLoop message_loop(base::MessageLoop::TYPE_IO);
+  PlatformChannel platform_channel;
+  const size_t kNumMessages = 2000;
+  const size_t kPayloadSize = 4096;
+
+  base::RunLoop run_loop;
+  OrderCheckingDelegate receiver_delegate(kNumMessages,
+                                          run_loop.QuitClosure());
+  scoped_refptr<Channel> receiver = Channel::Create(
+      &receiver_delegate,
+      ConnectionParams(platform_channel.TakeLocalEndpoint()),
+      Channel::HandlePolicy::kAcceptHandles, message_loop.task_runner());
+  receiver->Start();
+
+  OrderCheckingDelegate sender_delegate(0, base::DoNothing());
+  scoped_refptr<Channel> sender = Channel::Create(
+      &sender_delegate, ConnectionParams(platform_channel.TakeRemoteEndpoint()),
+      Channel::HandlePolicy::kAcceptHandles, message_loop.task_runner());
+  sender->Start();
+
+  for (size_t i = 0; i < kNumMessages; ++i) {
+    auto message = std::make_unique<Channel::Message>(kPayloadSize, 0);
+    memset(message->mutable_payload(), 0, kPayloadSize);
+    *static_cast<uint32_t*>(message->mutable_payload()) =
+        static_cast<uint32_t>(i);
+    sender->Write(std::move(message));
+  }
+
+  run_loop.Run();
+  EXPECT_EQ(kNumMessages, receiver_delegate.num_messages());
+
+  sender->ShutDown();
+  receiver->ShutDown();
+  base::RunLoop().RunUntilIdle();
+}
+
+TEST(ChannelTest, CoalescedWritesArriveInOrder) {
+  base::MessageLoop message_loop(base::MessageLoop::TYPE_IO);
+  Configuration old_configuration = GetConfiguration();
+  Configuration configuration = old_configuration;
+  configuration.coalesce_channel_writes = true;
+  internal::g_configuration = configuration;
+
+  PlatformChannel platform_channel;
+  // Not a multiple of the batch size, so that the last messages wait for the
+  // flush task.
+  const size_t kNumMessages = 1000;
+
+  base::RunLoop run_loop;
+  OrderCheckingDelegate receiver_delegate(kNumMessages,
+                                          run_loop.QuitClosure());
+  scoped_refptr<Channel> receiver = Channel::Create(
+      &receiver_delegate,
+      ConnectionParams(platform_channel.TakeLocalEndpoint()),
+      Channel::HandlePolicy::kAcceptHandles, message_loop.task_runner());
+  receiver->Start();
+
+  OrderCheckingDelegate sender_delegate(0, base::DoNothing());
+  scoped_refptr<Channel> sender = Channel::Create(
+      &sender_delegate, ConnectionParams(platform_channel.TakeRemoteEndpoint()),
+      Channel::HandlePolicy::kAcceptHandles, message_loop.task_runner());
+  sender->Start();
+
+  for (size_t i = 0; i < kNumMessages; ++i) {
+    auto message = std::make_unique<Channel::Message>(sizeof(uint32_t), 0);
+    *static_cast<uint32_t*>(message->mutable_payload()) =
+        static_cast<uint32_t>(i);
+    sender->Write(std::move(message));
+  }
+
+  run_loop.Run();
+  EXPECT_EQ(kNumMessages, receiver_delegate.num_messages());
+
+  sender->ShutDown();
+  receiver->ShutDown();
+  base::RunLoop().RunUntilIdle();
+  internal::g_configuration = old_configuration;
+}
+
 TEST(ChannelTest, DeserializeMessage_BadExtraHeaderSize) {
   // Verifies that a message payload is rejected when the extra header chunk
   // size not properly aligned.
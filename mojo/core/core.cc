@@ -158,7 +158,8 @@ NodeController* Core::GetNodeController() {
 }
 
 scoped_refptr<Dispatcher> Core::GetDispatcher(MojoHandle handle) {
-  base::AutoLock lock(handles_->GetLock());
+  // Lookups are internally synchronized and deliberately avoid the table-wide
+  // lock, since this is on the path of nearly every Mojo API call.
   return handles_->GetDispatcher(handle);
 }
 
@@ -423,8 +424,15 @@ MojoResult Core::AppendMessageData(MojoMessageHandle message_handle,
   RequestContext request_context;
   auto* message = reinterpret_cast<ports::UserMessageEvent*>(message_handle)
                       ->GetMessage<UserMessageImpl>();
-  MojoResult rv =
-      message->AppendData(additional_payload_size, handles, num_handles);
+  MojoResult rv;
+  if (options &&
+      (options->flags & MOJO_APPEND_MESSAGE_DATA_FLAG_RESERVE_CAPACITY)) {
+    if (num_handles)
+      return MOJO_RESULT_INVALID_ARGUMENT;
+    rv = message->ReserveCapacity(additional_payload_size);
+  } else {
+    rv = message->AppendData(additional_payload_size, handles, num_handles);
+  }
   if (rv != MOJO_RESULT_OK)
     return rv;
 
@@ -662,10 +670,10 @@ MojoResult Core::CreateDataPipe(const MojoCreateDataPipeOptions* options,
   create_options.struct_size = sizeof(MojoCreateDataPipeOptions);
   create_options.flags = options ? options->flags : 0;
   create_options.element_num_bytes = options ? options->element_num_bytes : 1;
-  // TODO(rockot): Use Configuration to get default data pipe capacity.
-  create_options.capacity_num_bytes = options && options->capacity_num_bytes
-                                          ? options->capacity_num_bytes
-                                          : 64 * 1024;
+  create_options.capacity_num_bytes =
+      options && options->capacity_num_bytes
+          ? options->capacity_num_bytes
+          : GetConfiguration().default_data_pipe_capacity_num_bytes;
   if (!create_options.element_num_bytes || !create_options.capacity_num_bytes ||
       create_options.capacity_num_bytes < create_options.element_num_bytes) {
     return MOJO_RESULT_INVALID_ARGUMENT;
@@ -7,11 +7,13 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <algorithm>
 #include <utility>
 
 #include "base/bind.h"
 #include "base/logging.h"
 #include "base/memory/ref_counted.h"
+#include "base/metrics/histogram_macros.h"
 #include "mojo/core/configuration.h"
 #include "mojo/core/core.h"
 #include "mojo/core/data_pipe_control_message.h"
@@ -118,11 +120,14 @@ MojoResult DataPipeProducerDispatcher::WriteData(
       (*num_bytes > available_capacity_)) {
     // Don't return "should wait" since you can't wait for a specified amount of
     // data.
+    ++num_full_pipe_writes_;
     return MOJO_RESULT_OUT_OF_RANGE;
   }
 
   DCHECK_LE(available_capacity_, options_.capacity_num_bytes);
   uint32_t num_bytes_to_write = std::min(*num_bytes, available_capacity_);
+  if (num_bytes_to_write < *num_bytes)
+    ++num_full_pipe_writes_;
   if (num_bytes_to_write == 0)
     return MOJO_RESULT_SHOULD_WAIT;
 
@@ -149,6 +154,7 @@ MojoResult DataPipeProducerDispatcher::WriteData(
   available_capacity_ -= num_bytes_to_write;
   write_offset_ =
       (write_offset_ + num_bytes_to_write) % options_.capacity_num_bytes;
+  UpdatePeakFillNoLock();
 
   watchers_.NotifyState(GetHandleSignalsStateNoLock());
 
@@ -171,6 +177,7 @@ MojoResult DataPipeProducerDispatcher::BeginWriteData(
     return MOJO_RESULT_FAILED_PRECONDITION;
 
   if (available_capacity_ == 0) {
+    ++num_full_pipe_writes_;
     return peer_closed_ ? MOJO_RESULT_FAILED_PRECONDITION
                         : MOJO_RESULT_SHOULD_WAIT;
   }
@@ -208,6 +215,7 @@ MojoResult DataPipeProducerDispatcher::EndWriteData(
     available_capacity_ -= num_bytes_written;
     write_offset_ =
         (write_offset_ + num_bytes_written) % options_.capacity_num_bytes;
+    UpdatePeakFillNoLock();
 
     base::AutoUnlock unlock(lock_);
     NotifyWrite(num_bytes_written);
@@ -429,6 +437,7 @@ MojoResult DataPipeProducerDispatcher::CloseNoLock() {
 
   watchers_.NotifyClosed();
   if (!transferred_) {
+    RecordFillMetricsNoLock();
     base::AutoUnlock unlock(lock_);
     node_controller_->ClosePort(control_port_);
   }
@@ -464,6 +473,26 @@ void DataPipeProducerDispatcher::NotifyWrite(uint32_t num_bytes) {
                              DataPipeCommand::DATA_WAS_WRITTEN, num_bytes);
 }
 
+void DataPipeProducerDispatcher::UpdatePeakFillNoLock() {
+  lock_.AssertAcquired();
+  peak_fill_num_bytes_ =
+      std::max(peak_fill_num_bytes_,
+               options_.capacity_num_bytes - available_capacity_);
+}
+
+void DataPipeProducerDispatcher::RecordFillMetricsNoLock() {
+  lock_.AssertAcquired();
+  UMA_HISTOGRAM_CUSTOM_COUNTS("Mojo.DataPipe.CapacityKB",
+                              options_.capacity_num_bytes / 1024, 1,
+                              1024 * 1024, 50);
+  UMA_HISTOGRAM_PERCENTAGE(
+      "Mojo.DataPipe.PeakFillPercent",
+      static_cast<int>(static_cast<uint64_t>(peak_fill_num_bytes_) * 100 /
+                       options_.capacity_num_bytes));
+  UMA_HISTOGRAM_COUNTS_10000("Mojo.DataPipe.FullPipeWrites",
+                             num_full_pipe_writes_);
+}
+
 void DataPipeProducerDispatcher::OnPortStatusChanged() {
   DCHECK(RequestContext::current());
 
@@ -84,6 +84,13 @@ class MOJO_SYSTEM_IMPL_EXPORT DataPipeProducerDispatcher final
   MojoResult CloseNoLock();
   HandleSignalsState GetHandleSignalsStateNoLock() const;
   void NotifyWrite(uint32_t num_bytes);
+
+  // Updates |peak_fill_num_bytes_| after |available_capacity_| shrinks.
+  void UpdatePeakFillNoLock();
+
+  // Reports how full this pipe ran over its lifetime, so that default pipe
+  // capacities can be tuned to real usage.
+  void RecordFillMetricsNoLock();
   void OnPortStatusChanged();
   void UpdateSignalsStateNoLock();
 
@@ -110,6 +117,11 @@ class MOJO_SYSTEM_IMPL_EXPORT DataPipeProducerDispatcher final
   uint32_t write_offset_ = 0;
   uint32_t available_capacity_;
 
+  // The largest number of unread bytes observed in the pipe, and the number
+  // of writes which were cut short or refused because the pipe was full.
+  uint32_t peak_fill_num_bytes_ = 0;
+  uint32_t num_full_pipe_writes_ = 0;
+
   DISALLOW_COPY_AND_ASSIGN(DataPipeProducerDispatcher);
 };
 
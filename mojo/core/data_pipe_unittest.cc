@@ -13,6 +13,7 @@
 #include "base/message_loop/message_loop.h"
 #include "base/run_loop.h"
 #include "base/stl_util.h"
+#include "base/test/metrics/histogram_tester.h"
 #include "build/build_config.h"
 #include "mojo/core/embedder/embedder.h"
 #include "mojo/core/test/mojo_test_base.h"
@@ -1113,6 +1114,36 @@ TEST_F(DataPipeTest, WrapAround) {
   ASSERT_EQ(0, memcmp(read_buffer, &test_data[10], 100u));
 }
 
+// Tests that closing a producer reports how full its pipe ran.
+TEST_F(DataPipeTest, FillMetrics) {
+  const MojoCreateDataPipeOptions options = {
+      kSizeOfOptions,                   // |struct_size|.
+      MOJO_CREATE_DATA_PIPE_FLAG_NONE,  // |flags|.
+      1u,                               // |element_num_bytes|.
+      100u                              // |capacity_num_bytes|.
+  };
+  ASSERT_EQ(MOJO_RESULT_OK, Create(&options));
+
+  base::HistogramTester histogram_tester;
+  uint8_t test_data[100] = {};
+
+  // Fill half the pipe, then attempt to write more than what remains.
+  uint32_t num_bytes = 50u;
+  ASSERT_EQ(MOJO_RESULT_OK, WriteData(test_data, &num_bytes));
+  num_bytes = 100u;
+  ASSERT_EQ(MOJO_RESULT_OK, WriteData(test_data, &num_bytes));
+  EXPECT_EQ(50u, num_bytes);
+
+  // The pipe is now full.
+  num_bytes = 1u;
+  EXPECT_EQ(MOJO_RESULT_SHOULD_WAIT, WriteData(test_data, &num_bytes));
+
+  ASSERT_EQ(MOJO_RESULT_OK, CloseProducer());
+  histogram_tester.ExpectUniqueSample("Mojo.DataPipe.PeakFillPercent", 100, 1);
+  histogram_tester.ExpectUniqueSample("Mojo.DataPipe.FullPipeWrites", 2, 1);
+  histogram_tester.ExpectTotalCount("Mojo.DataPipe.CapacityKB", 1);
+}
+
 // Tests the behavior of writing (simple and two-phase), closing the producer,
 // then reading (simple and two-phase).
 TEST_F(DataPipeTest, WriteCloseProducerRead) {
@@ -39,6 +39,17 @@ struct Configuration {
 
   // Maximum size of a single shared memory segment, in bytes.
   size_t max_shared_memory_num_bytes = 1024 * 1024 * 1024;
+
+  // Capacity of data pipes created without an explicit |capacity_num_bytes|,
+  // in bytes. Processes which create many mostly-idle pipes may want a smaller
+  // value, while those streaming large bodies over fast links may want more.
+  uint32_t default_data_pipe_capacity_num_bytes = 64 * 1024;
+
+  // If |true|, messages written to a Channel are queued and written together
+  // from a task on its I/O thread, rather than each with its own syscall. This
+  // trades some latency for throughput when many small messages are sent in
+  // bursts. Only supported on POSIX platforms; ignored elsewhere.
+  bool coalesce_channel_writes = false;
 };
 
 }  // namespace core
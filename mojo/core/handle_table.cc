@@ -40,6 +40,8 @@ const char* GetNameForDispatcherType(Dispatcher::Type type) {
 
 }  // namespace
 
+constexpr size_t HandleTable::kNumShards;
+
 HandleTable::HandleTable() {}
 
 HandleTable::~HandleTable() {}
@@ -49,21 +51,22 @@ base::Lock& HandleTable::GetLock() {
 }
 
 MojoHandle HandleTable::AddDispatcher(scoped_refptr<Dispatcher> dispatcher) {
+  lock_.AssertAcquired();
+
   // Oops, we're out of handles.
   if (next_available_handle_ == MOJO_HANDLE_INVALID)
     return MOJO_HANDLE_INVALID;
 
   MojoHandle handle = next_available_handle_++;
-  auto result =
-      handles_.insert(std::make_pair(handle, Entry(std::move(dispatcher))));
-  DCHECK(result.second);
-
+  InsertDispatcher(handle, std::move(dispatcher));
   return handle;
 }
 
 bool HandleTable::AddDispatchersFromTransit(
     const std::vector<Dispatcher::DispatcherInTransit>& dispatchers,
     MojoHandle* handles) {
+  lock_.AssertAcquired();
+
   // Oops, we're out of handles.
   if (next_available_handle_ == MOJO_HANDLE_INVALID)
     return false;
@@ -77,9 +80,7 @@ bool HandleTable::AddDispatchersFromTransit(
     MojoHandle handle = MOJO_HANDLE_INVALID;
     if (dispatchers[i].dispatcher) {
       handle = next_available_handle_++;
-      auto result = handles_.insert(
-          std::make_pair(handle, Entry(dispatchers[i].dispatcher)));
-      DCHECK(result.second);
+      InsertDispatcher(handle, dispatchers[i].dispatcher);
     }
     handles[i] = handle;
   }
@@ -88,8 +89,10 @@ bool HandleTable::AddDispatchersFromTransit(
 }
 
 scoped_refptr<Dispatcher> HandleTable::GetDispatcher(MojoHandle handle) const {
-  auto it = handles_.find(handle);
-  if (it == handles_.end())
+  const Shard& shard = GetShard(handle);
+  base::AutoLock lock(shard.lock);
+  auto it = shard.handles.find(handle);
+  if (it == shard.handles.end())
     return nullptr;
   return it->second.dispatcher;
 }
@@ -97,14 +100,18 @@ scoped_refptr<Dispatcher> HandleTable::GetDispatcher(MojoHandle handle) const {
 MojoResult HandleTable::GetAndRemoveDispatcher(
     MojoHandle handle,
     scoped_refptr<Dispatcher>* dispatcher) {
-  auto it = handles_.find(handle);
-  if (it == handles_.end())
+  lock_.AssertAcquired();
+
+  Shard& shard = GetShard(handle);
+  base::AutoLock lock(shard.lock);
+  auto it = shard.handles.find(handle);
+  if (it == shard.handles.end())
     return MOJO_RESULT_INVALID_ARGUMENT;
   if (it->second.busy)
     return MOJO_RESULT_BUSY;
 
   *dispatcher = std::move(it->second.dispatcher);
-  handles_.erase(it);
+  shard.handles.erase(it);
   return MOJO_RESULT_OK;
 }
 
@@ -112,10 +119,14 @@ MojoResult HandleTable::BeginTransit(
     const MojoHandle* handles,
     size_t num_handles,
     std::vector<Dispatcher::DispatcherInTransit>* dispatchers) {
+  lock_.AssertAcquired();
+
   dispatchers->reserve(dispatchers->size() + num_handles);
   for (size_t i = 0; i < num_handles; ++i) {
-    auto it = handles_.find(handles[i]);
-    if (it == handles_.end())
+    Shard& shard = GetShard(handles[i]);
+    base::AutoLock lock(shard.lock);
+    auto it = shard.handles.find(handles[i]);
+    if (it == shard.handles.end())
       return MOJO_RESULT_INVALID_ARGUMENT;
     if (it->second.busy)
       return MOJO_RESULT_BUSY;
@@ -133,28 +144,54 @@ MojoResult HandleTable::BeginTransit(
 
 void HandleTable::CompleteTransitAndClose(
     const std::vector<Dispatcher::DispatcherInTransit>& dispatchers) {
+  lock_.AssertAcquired();
+
   for (const auto& dispatcher : dispatchers) {
-    auto it = handles_.find(dispatcher.local_handle);
-    DCHECK(it != handles_.end() && it->second.busy);
-    handles_.erase(it);
+    {
+      Shard& shard = GetShard(dispatcher.local_handle);
+      base::AutoLock lock(shard.lock);
+      auto it = shard.handles.find(dispatcher.local_handle);
+      DCHECK(it != shard.handles.end() && it->second.busy);
+      shard.handles.erase(it);
+    }
     dispatcher.dispatcher->CompleteTransitAndClose();
   }
 }
 
 void HandleTable::CancelTransit(
     const std::vector<Dispatcher::DispatcherInTransit>& dispatchers) {
+  lock_.AssertAcquired();
+
   for (const auto& dispatcher : dispatchers) {
-    auto it = handles_.find(dispatcher.local_handle);
-    DCHECK(it != handles_.end() && it->second.busy);
-    it->second.busy = false;
+    {
+      Shard& shard = GetShard(dispatcher.local_handle);
+      base::AutoLock lock(shard.lock);
+      auto it = shard.handles.find(dispatcher.local_handle);
+      DCHECK(it != shard.handles.end() && it->second.busy);
+      it->second.busy = false;
+    }
     dispatcher.dispatcher->CancelTransit();
   }
 }
 
 void HandleTable::GetActiveHandlesForTest(std::vector<MojoHandle>* handles) {
+  lock_.AssertAcquired();
+
   handles->clear();
-  for (const auto& entry : handles_)
-    handles->push_back(entry.first);
+  for (const auto& shard : shards_) {
+    base::AutoLock lock(shard.lock);
+    for (const auto& entry : shard.handles)
+      handles->push_back(entry.first);
+  }
+}
+
+void HandleTable::InsertDispatcher(MojoHandle handle,
+                                   scoped_refptr<Dispatcher> dispatcher) {
+  Shard& shard = GetShard(handle);
+  base::AutoLock lock(shard.lock);
+  auto result = shard.handles.insert(
+      std::make_pair(handle, Entry(std::move(dispatcher))));
+  DCHECK(result.second);
 }
 
 // MemoryDumpProvider implementation.
@@ -174,8 +211,10 @@ bool HandleTable::OnMemoryDump(const base::trace_event::MemoryDumpArgs& args,
   // Count the number of each dispatcher type.
   {
     base::AutoLock lock(GetLock());
-    for (const auto& entry : handles_) {
-      ++handle_count[entry.second.dispatcher->GetType()];
+    for (const auto& shard : shards_) {
+      base::AutoLock shard_lock(shard.lock);
+      for (const auto& entry : shard.handles)
+        ++handle_count[entry.second.dispatcher->GetType()];
     }
   }
 
@@ -200,5 +239,9 @@ HandleTable::Entry::Entry(const Entry& other) = default;
 
 HandleTable::Entry::~Entry() {}
 
+HandleTable::Shard::Shard() = default;
+
+HandleTable::Shard::~Shard() = default;
+
 }  // namespace core
 }  // namespace mojo
@@ -7,6 +7,7 @@
 
 #include <stdint.h>
 
+#include <array>
 #include <unordered_map>
 #include <vector>
 
@@ -27,7 +28,10 @@ class MOJO_SYSTEM_IMPL_EXPORT HandleTable
   HandleTable();
   ~HandleTable() override;
 
-  // HandleTable is thread-hostile. All access should be gated by GetLock().
+  // Any call which adds, removes, or changes the transit state of handles must
+  // be gated by GetLock(). GetDispatcher() may be called without it: handles
+  // are sharded across several maps, and a lookup only takes the lock of the
+  // shard holding the handle, so lookups on different threads rarely contend.
   base::Lock& GetLock();
 
   MojoHandle AddDispatcher(scoped_refptr<Dispatcher> dispatcher);
@@ -76,7 +80,31 @@ class MOJO_SYSTEM_IMPL_EXPORT HandleTable
 
   using HandleMap = std::unordered_map<MojoHandle, Entry>;
 
-  HandleMap handles_;
+  // Handles are allocated sequentially, so striping them by value spreads
+  // concurrently used handles evenly across shards.
+  static constexpr size_t kNumShards = 16;
+
+  struct Shard {
+    Shard();
+    ~Shard();
+
+    // Guards |handles|. Always acquired after |lock_| if both are held.
+    mutable base::Lock lock;
+    HandleMap handles;
+  };
+
+  Shard& GetShard(MojoHandle handle) { return shards_[handle % kNumShards]; }
+  const Shard& GetShard(MojoHandle handle) const {
+    return shards_[handle % kNumShards];
+  }
+
+  // Inserts a new entry for |handle|. |lock_| must be held.
+  void InsertDispatcher(MojoHandle handle,
+                        scoped_refptr<Dispatcher> dispatcher);
+
+  std::array<Shard, kNumShards> shards_;
+
+  // Serializes all changes to the table, including handle allocation.
   base::Lock lock_;
 
   uint32_t next_available_handle_ = 1;
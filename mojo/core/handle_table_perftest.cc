@@ -0,0 +1,104 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/strings/stringprintf.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/test/perf_time_logger.h"
+#include "base/threading/simple_thread.h"
+#include "mojo/core/core.h"
+#include "mojo/core/dispatcher.h"
+#include "mojo/core/test/mojo_test_base.h"
+#include "mojo/public/c/system/types.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace mojo {
+namespace core {
+namespace {
+
+const int kLookupsPerThread = 1000000;
+const size_t kNumHandles = 64;
+
+// Repeatedly resolves handles through Core::GetDispatcher(), which every Mojo
+// API call does before touching its dispatcher.
+class LookupThread : public base::SimpleThread {
+ public:
+  LookupThread(const std::vector<MojoHandle>& handles,
+               base::WaitableEvent* start_event)
+      : base::SimpleThread("LookupThread"),
+        handles_(handles),
+        start_event_(start_event) {}
+  ~LookupThread() override = default;
+
+  void Run() override {
+    Core* core = Core::Get();
+    start_event_->Wait();
+    for (int i = 0; i < kLookupsPerThread; ++i) {
+      CHECK(core->GetDispatcher(handles_[i % handles_.size()]));
+    }
+  }
+
+ private:
+  const std::vector<MojoHandle>& handles_;
+  base::WaitableEvent* const start_event_;
+
+  DISALLOW_COPY_AND_ASSIGN(LookupThread);
+};
+
+class HandleTablePerfTest : public test::MojoTestBase {
+ public:
+  HandleTablePerfTest() = default;
+  ~HandleTablePerfTest() override = default;
+
+ protected:
+  void MeasureLookups(size_t num_threads) {
+    std::vector<MojoHandle> handles;
+    for (size_t i = 0; i < kNumHandles / 2; ++i) {
+      MojoHandle a, b;
+      CreateMessagePipe(&a, &b);
+      handles.push_back(a);
+      handles.push_back(b);
+    }
+
+    base::WaitableEvent start_event(
+        base::WaitableEvent::ResetPolicy::MANUAL,
+        base::WaitableEvent::InitialState::NOT_SIGNALED);
+    std::vector<std::unique_ptr<LookupThread>> threads;
+    for (size_t i = 0; i < num_threads; ++i) {
+      threads.push_back(std::make_unique<LookupThread>(handles, &start_event));
+      threads.back()->Start();
+    }
+
+    std::string test_name = base::StringPrintf(
+        "HandleTable_GetDispatcher_%zuThreads_%dx", num_threads,
+        kLookupsPerThread);
+    {
+      base::PerfTimeLogger logger(test_name.c_str());
+      start_event.Signal();
+      for (auto& thread : threads)
+        thread->Join();
+    }
+
+    for (MojoHandle handle : handles)
+      CloseHandle(handle);
+  }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(HandleTablePerfTest);
+};
+
+TEST_F(HandleTablePerfTest, ConcurrentLookups) {
+  for (size_t num_threads : {1, 2, 4, 8, 16})
+    MeasureLookups(num_threads);
+}
+
+}  // namespace
+}  // namespace core
+}  // namespace mojo
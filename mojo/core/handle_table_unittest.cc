@@ -5,6 +5,7 @@
 #include "mojo/core/handle_table.h"
 
 #include <memory>
+#include <vector>
 
 #include "base/synchronization/lock.h"
 #include "base/trace_event/memory_allocator_dump.h"
@@ -69,5 +70,48 @@ TEST(HandleTableTest, OnMemoryDump) {
   CheckNameAndValue(&pmd, "mojo/data_pipe_consumer", 0);
 }
 
+TEST(HandleTableTest, LookupsSpanShards) {
+  HandleTable ht;
+
+  // Add enough handles to populate every shard several times over.
+  constexpr size_t kNumHandles = 100;
+  std::vector<scoped_refptr<Dispatcher>> dispatchers;
+  std::vector<MojoHandle> handles;
+  {
+    base::AutoLock auto_lock(ht.GetLock());
+    for (size_t i = 0; i < kNumHandles; ++i) {
+      dispatchers.push_back(new FakeMessagePipeDispatcher);
+      handles.push_back(ht.AddDispatcher(dispatchers.back()));
+      ASSERT_NE(MOJO_HANDLE_INVALID, handles.back());
+    }
+  }
+
+  // Lookups don't need the table lock.
+  for (size_t i = 0; i < kNumHandles; ++i)
+    EXPECT_EQ(dispatchers[i], ht.GetDispatcher(handles[i]));
+
+  {
+    base::AutoLock auto_lock(ht.GetLock());
+    std::vector<MojoHandle> active_handles;
+    ht.GetActiveHandlesForTest(&active_handles);
+    EXPECT_EQ(kNumHandles, active_handles.size());
+
+    // Remove every other handle.
+    for (size_t i = 0; i < kNumHandles; i += 2) {
+      scoped_refptr<Dispatcher> dispatcher;
+      EXPECT_EQ(MOJO_RESULT_OK,
+                ht.GetAndRemoveDispatcher(handles[i], &dispatcher));
+      EXPECT_EQ(dispatchers[i], dispatcher);
+    }
+  }
+
+  for (size_t i = 0; i < kNumHandles; ++i) {
+    if (i % 2)
+      EXPECT_EQ(dispatchers[i], ht.GetDispatcher(handles[i]));
+    else
+      EXPECT_FALSE(ht.GetDispatcher(handles[i]));
+  }
+}
+
 }  // namespace core
 }  // namespace mojo
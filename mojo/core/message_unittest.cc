@@ -639,6 +639,67 @@ TEST_F(MessageTest, ExtendMessagePayload) {
   EXPECT_EQ(MOJO_RESULT_OK, MojoDestroyMessage(message));
 }
 
+TEST_F(MessageTest, ReserveMessageCapacity) {
+  MojoMessageHandle message;
+  EXPECT_EQ(MOJO_RESULT_OK, MojoCreateMessage(nullptr, &message));
+
+  MojoAppendMessageDataOptions reserve_options;
+  reserve_options.struct_size = sizeof(reserve_options);
+  reserve_options.flags = MOJO_APPEND_MESSAGE_DATA_FLAG_RESERVE_CAPACITY;
+
+  // Capacity can only be reserved once the message has some data.
+  EXPECT_EQ(MOJO_RESULT_FAILED_PRECONDITION,
+            MojoAppendMessageData(message, 1024, nullptr, 0, &reserve_options,
+                                  nullptr, nullptr));
+
+  const std::string kTestMessagePart1("hello i am message.");
+  void* buffer;
+  uint32_t buffer_size;
+  EXPECT_EQ(MOJO_RESULT_OK,
+            MojoAppendMessageData(
+                message, static_cast<uint32_t>(kTestMessagePart1.size()),
+                nullptr, 0, nullptr, &buffer, &buffer_size));
+  memcpy(buffer, kTestMessagePart1.data(), kTestMessagePart1.size());
+
+  constexpr uint32_t kReservedCapacity = 64 * 1024;
+  EXPECT_EQ(MOJO_RESULT_OK,
+            MojoAppendMessageData(message, kReservedCapacity, nullptr, 0,
+                                  &reserve_options, &buffer, &buffer_size));
+  EXPECT_GE(buffer_size, kTestMessagePart1.size() + kReservedCapacity);
+  EXPECT_EQ(0, memcmp(buffer, kTestMessagePart1.data(),
+                      kTestMessagePart1.size()));
+
+  // Appending within the reserved capacity must not move the buffer.
+  void* reserved_buffer = buffer;
+  std::vector<uint8_t> test_payload(kReservedCapacity);
+  base::RandBytes(test_payload.data(), test_payload.size());
+  EXPECT_EQ(MOJO_RESULT_OK,
+            MojoAppendMessageData(message, kReservedCapacity, nullptr, 0,
+                                  nullptr, &buffer, &buffer_size));
+  EXPECT_EQ(reserved_buffer, buffer);
+  memcpy(static_cast<uint8_t*>(buffer) + kTestMessagePart1.size(),
+         test_payload.data(), test_payload.size());
+
+  MojoAppendMessageDataOptions commit_options;
+  commit_options.struct_size = sizeof(commit_options);
+  commit_options.flags = MOJO_APPEND_MESSAGE_DATA_FLAG_COMMIT_SIZE;
+  EXPECT_EQ(MOJO_RESULT_OK, MojoAppendMessageData(message, 0, nullptr, 0,
+                                                  &commit_options, nullptr,
+                                                  nullptr));
+
+  // Reserved but unused capacity is not part of the payload.
+  void* payload;
+  uint32_t payload_size;
+  EXPECT_EQ(MOJO_RESULT_OK,
+            MojoGetMessageData(message, nullptr, &payload, &payload_size,
+                               nullptr, nullptr));
+  EXPECT_EQ(kTestMessagePart1.size() + kReservedCapacity, payload_size);
+  EXPECT_EQ(0, memcmp(static_cast<uint8_t*>(payload) + kTestMessagePart1.size(),
+                      test_payload.data(), test_payload.size()));
+
+  EXPECT_EQ(MOJO_RESULT_OK, MojoDestroyMessage(message));
+}
+
 TEST_F(MessageTest, ExtendMessageWithHandlesPayload) {
   MojoMessageHandle message;
   EXPECT_EQ(MOJO_RESULT_OK, MojoCreateMessage(nullptr, &message));
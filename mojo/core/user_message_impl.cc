@@ -517,6 +517,25 @@ MojoResult UserMessageImpl::AppendData(uint32_t additional_payload_size,
   return MOJO_RESULT_OK;
 }
 
+MojoResult UserMessageImpl::ReserveCapacity(uint32_t additional_capacity) {
+  if (HasContext() || !IsSerialized())
+    return MOJO_RESULT_FAILED_PRECONDITION;
+
+  size_t header_offset =
+      static_cast<uint8_t*>(header_) -
+      static_cast<const uint8_t*>(channel_message_->payload());
+  size_t user_payload_offset =
+      static_cast<uint8_t*>(user_payload_) -
+      static_cast<const uint8_t*>(channel_message_->payload());
+  channel_message_->ReserveCapacity(user_payload_offset + user_payload_size_ +
+                                    additional_capacity);
+  header_ = static_cast<uint8_t*>(channel_message_->mutable_payload()) +
+            header_offset;
+  user_payload_ = static_cast<uint8_t*>(channel_message_->mutable_payload()) +
+                  user_payload_offset;
+  return MOJO_RESULT_OK;
+}
+
 MojoResult UserMessageImpl::CommitSize() {
   if (!IsSerialized())
     return MOJO_RESULT_FAILED_PRECONDITION;
@@ -123,6 +123,7 @@ class MOJO_SYSTEM_IMPL_EXPORT UserMessageImpl : public ports::UserMessage {
   MojoResult AppendData(uint32_t additional_payload_size,
                         const MojoHandle* handles,
                         uint32_t num_handles);
+  MojoResult ReserveCapacity(uint32_t additional_capacity);
   MojoResult CommitSize();
 
   // If this message is not already serialized, this serializes it.
@@ -138,6 +138,14 @@ typedef uint32_t MojoAppendMessageDataFlags;
 #define MOJO_APPEND_MESSAGE_DATA_FLAG_COMMIT_SIZE \
   ((MojoAppendMessageDataFlags)1)
 
+// If set, |additional_payload_size| is treated as an amount of storage capacity
+// to reserve beyond the current end of the message payload, rather than as a
+// number of bytes to append to it. The payload size is not changed, but
+// subsequent appends which fit within the reserved capacity will not need to
+// reallocate the message. May not be combined with handle attachment.
+#define MOJO_APPEND_MESSAGE_DATA_FLAG_RESERVE_CAPACITY \
+  ((MojoAppendMessageDataFlags)2)
+
 // Options passed to |MojoAppendMessageData()|.
 struct MOJO_ALIGNAS(8) MojoAppendMessageDataOptions {
   // The size of this structure, used for versioning.
@@ -435,11 +443,14 @@ MojoSerializeMessage(MojoMessageHandle message,
 //       |MOJO_APPEND_MESSAGE_DATA_FLAG_COMMIT_SIZE| was set in
 //       |options->flags|, the message is ready for transmission.
 //   |MOJO_RESULT_INVALID_ARGUMENT| if |message| is not a valid message object;
-//       if |num_handles| is non-zero but |handles| is null; or if any handle in
-//       |handles| is invalid.
+//       if |num_handles| is non-zero but |handles| is null; if any handle in
+//       |handles| is invalid; or if |num_handles| is non-zero and
+//       |MOJO_APPEND_MESSAGE_DATA_FLAG_RESERVE_CAPACITY| was set.
 //   |MOJO_RESULT_RESOURCE_EXHAUSTED| if |additional_payload_size| or
 //       |num_handles| exceeds some implementation- or embedder-defined maximum.
-//   |MOJO_RESULT_FAILED_PRECONDITION| if |message| has a context attached.
+//   |MOJO_RESULT_FAILED_PRECONDITION| if |message| has a context attached, or
+//       if |MOJO_APPEND_MESSAGE_DATA_FLAG_RESERVE_CAPACITY| was set but no data
+//       has yet been appended to |message|.
 //   |MOJO_RESULT_BUSY| if one or more handles in |handles| is currently busy
 //       and unable to be serialized.
 MOJO_SYSTEM_EXPORT MojoResult
@@ -58,6 +58,30 @@ BigBuffer::BigBuffer(base::span<const uint8_t> data) {
 BigBuffer::BigBuffer(const std::vector<uint8_t>& data)
     : BigBuffer(base::make_span(data)) {}
 
+BigBuffer::BigBuffer(size_t size) {
+  if (size > kMaxInlineBytes) {
+    auto buffer = mojo::SharedBufferHandle::Create(size);
+    if (buffer.is_valid()) {
+      internal::BigBufferSharedMemoryRegion shared_memory(std::move(buffer),
+                                                          size);
+      if (shared_memory.memory()) {
+        storage_type_ = StorageType::kSharedMemory;
+        shared_memory_.emplace(std::move(shared_memory));
+        return;
+      }
+    }
+
+    if (size > kMaxFallbackInlineBytes) {
+      storage_type_ = StorageType::kInvalidBuffer;
+      return;
+    }
+  }
+
+  // Either the buffer is small enough or shared memory allocation failed.
+  storage_type_ = StorageType::kBytes;
+  bytes_.resize(size);
+}
+
 BigBuffer::BigBuffer(internal::BigBufferSharedMemoryRegion shared_memory)
     : storage_type_(StorageType::kSharedMemory),
       shared_memory_(std::move(shared_memory)) {}
@@ -84,6 +84,12 @@ class COMPONENT_EXPORT(MOJO_BASE) BigBuffer {
   // Helper for implicit conversion from byte vectors.
   BigBuffer(const std::vector<uint8_t>& data);
 
+  // Constructs a BigBuffer with |size| bytes of zero-initialized storage, to be
+  // filled in through |data()|. Buffers above |kMaxInlineBytes| are allocated
+  // directly in shared memory, so producers which write their output in place
+  // avoid the copy made when constructing from an existing span.
+  explicit BigBuffer(size_t size);
+
   // Constructs a BigBuffer from an existing shared memory region. Not intended
   // for general-purpose use.
   explicit BigBuffer(internal::BigBufferSharedMemoryRegion shared_memory);
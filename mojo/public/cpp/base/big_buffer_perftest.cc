@@ -0,0 +1,94 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "base/strings/stringprintf.h"
+#include "base/time/time.h"
+#include "mojo/public/cpp/base/big_buffer.h"
+#include "mojo/public/cpp/base/big_buffer_mojom_traits.h"
+#include "mojo/public/cpp/test_support/test_support.h"
+#include "mojo/public/cpp/test_support/test_utils.h"
+#include "mojo/public/mojom/base/big_buffer.mojom.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace mojo_base {
+namespace {
+
+constexpr size_t kPayloadSizes[] = {
+    64 * 1024,        256 * 1024,       1024 * 1024,
+    4 * 1024 * 1024,  16 * 1024 * 1024, 64 * 1024 * 1024,
+};
+
+// Each payload size moves roughly this many bytes in total, so that small
+// payloads run enough iterations to be measured.
+constexpr size_t kBytesPerPayloadSize = 512 * 1024 * 1024;
+
+size_t GetIterations(size_t payload_size) {
+  return std::max<size_t>(kBytesPerPayloadSize / payload_size, 4);
+}
+
+std::string GetSubTestName(size_t payload_size) {
+  if (payload_size >= 1024 * 1024)
+    return base::StringPrintf("%zuMB", payload_size / (1024 * 1024));
+  return base::StringPrintf("%zuKB", payload_size / 1024);
+}
+
+void LogThroughput(const char* test_name,
+                   size_t payload_size,
+                   size_t iterations,
+                   base::TimeDelta elapsed) {
+  const double megabytes =
+      static_cast<double>(payload_size) * iterations / (1024 * 1024);
+  mojo::test::LogPerfResult(test_name, GetSubTestName(payload_size).c_str(),
+                            megabytes / elapsed.InSecondsF(), "MB/s");
+}
+
+// Measures serialization and deserialization of a BigBuffer constructed from
+// an existing span, which copies the span into the buffer's storage.
+TEST(BigBufferPerfTest, FromSpan) {
+  for (const size_t payload_size : kPayloadSizes) {
+    std::vector<uint8_t> data(payload_size, 'x');
+    const size_t iterations = GetIterations(payload_size);
+    const base::TimeTicks start = base::TimeTicks::Now();
+    for (size_t i = 0; i < iterations; ++i) {
+      BigBuffer in(data);
+      BigBuffer out;
+      ASSERT_TRUE(
+          mojo::test::SerializeAndDeserialize<mojom::BigBuffer>(&in, &out));
+      ASSERT_EQ(payload_size, out.size());
+    }
+    LogThroughput("BigBufferFromSpan", payload_size, iterations,
+                  base::TimeTicks::Now() - start);
+  }
+}
+
+// Measures serialization and deserialization of a BigBuffer whose contents are
+// written in place, as a producer of large output would do.
+TEST(BigBufferPerfTest, InPlace) {
+  for (const size_t payload_size : kPayloadSizes) {
+    const size_t iterations = GetIterations(payload_size);
+    const base::TimeTicks start = base::TimeTicks::Now();
+    for (size_t i = 0; i < iterations; ++i) {
+      BigBuffer in(payload_size);
+      ASSERT_EQ(payload_size, in.size());
+      memset(in.data(), 'x', payload_size);
+      BigBuffer out;
+      ASSERT_TRUE(
+          mojo::test::SerializeAndDeserialize<mojom::BigBuffer>(&in, &out));
+      ASSERT_EQ(payload_size, out.size());
+    }
+    LogThroughput("BigBufferInPlace", payload_size, iterations,
+                  base::TimeTicks::Now() - start);
+  }
+}
+
+}  // namespace
+}  // namespace mojo_base
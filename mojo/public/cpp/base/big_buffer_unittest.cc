@@ -65,6 +65,29 @@ TEST(BigBufferTest, LargeDataSize) {
   EXPECT_TRUE(BufferEquals(data, out));
 }
 
+TEST(BigBufferTest, AllocateInPlace) {
+  BigBuffer small_buffer(BigBuffer::kMaxInlineBytes);
+  EXPECT_EQ(BigBuffer::StorageType::kBytes, small_buffer.storage_type());
+  EXPECT_EQ(BigBuffer::kMaxInlineBytes, small_buffer.size());
+
+  constexpr size_t kLargeDataSize = BigBuffer::kMaxInlineBytes * 2;
+  std::vector<uint8_t> data(kLargeDataSize);
+  base::RandBytes(data.data(), kLargeDataSize);
+
+  BigBuffer in(kLargeDataSize);
+  EXPECT_EQ(BigBuffer::StorageType::kSharedMemory, in.storage_type());
+  ASSERT_EQ(kLargeDataSize, in.size());
+  EXPECT_TRUE(std::all_of(in.data(), in.data() + in.size(),
+                          [](uint8_t byte) { return byte == 0; }));
+  std::copy(data.begin(), data.end(), in.data());
+
+  BigBuffer out;
+  ASSERT_TRUE(mojo::test::SerializeAndDeserialize<mojom::BigBuffer>(&in, &out));
+
+  EXPECT_EQ(BigBuffer::StorageType::kSharedMemory, out.storage_type());
+  EXPECT_TRUE(BufferEquals(data, out));
+}
+
 TEST(BigBufferTest, InvalidBuffer) {
   // Verifies that deserializing invalid BigBuffers and BigBufferViews always
   // fails.
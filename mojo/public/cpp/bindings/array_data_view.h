@@ -5,6 +5,9 @@
 #ifndef MOJO_PUBLIC_CPP_BINDINGS_ARRAY_DATA_VIEW_H_
 #define MOJO_PUBLIC_CPP_BINDINGS_ARRAY_DATA_VIEW_H_
 
+#include <stddef.h>
+
+#include <iterator>
 #include <type_traits>
 
 #include "mojo/public/cpp/bindings/lib/array_internal.h"
@@ -18,6 +21,45 @@ namespace internal {
 template <typename T, typename EnableType = void>
 class ArrayDataViewImpl;
 
+// Iterates over an array of object or union elements, yielding a DataView for
+// each element. The DataViews point directly into the serialized message, so
+// no element is deserialized until the caller reads it.
+template <typename T, typename ArrayImpl>
+class ArrayDataViewElementIterator {
+ public:
+  using iterator_category = std::input_iterator_tag;
+  using value_type = T;
+  using difference_type = ptrdiff_t;
+  using pointer = void;
+  using reference = T;
+
+  ArrayDataViewElementIterator(ArrayImpl* array, size_t index)
+      : array_(array), index_(index) {}
+
+  T operator*() const {
+    T output;
+    array_->GetDataView(index_, &output);
+    return output;
+  }
+
+  ArrayDataViewElementIterator& operator++() {
+    ++index_;
+    return *this;
+  }
+
+  bool operator==(const ArrayDataViewElementIterator& other) const {
+    return array_ == other.array_ && index_ == other.index_;
+  }
+
+  bool operator!=(const ArrayDataViewElementIterator& other) const {
+    return !(*this == other);
+  }
+
+ private:
+  ArrayImpl* array_;
+  size_t index_;
+};
+
 template <typename T>
 class ArrayDataViewImpl<
     T,
@@ -33,6 +75,9 @@ class ArrayDataViewImpl<
 
   const T* data() const { return data_->storage(); }
 
+  const T* begin() const { return data(); }
+  const T* end() const { return data() + data_->size(); }
+
  protected:
   Data_* data_;
   SerializationContext* context_;
@@ -73,6 +118,9 @@ class ArrayDataViewImpl<
 
   const T* data() const { return reinterpret_cast<const T*>(data_->storage()); }
 
+  const T* begin() const { return data(); }
+  const T* end() const { return data() + data_->size(); }
+
   template <typename U>
   bool Read(size_t index, U* output) {
     return Deserialize<T>(data_->at(index), output);
@@ -147,10 +195,15 @@ class ArrayDataViewImpl<T,
   ArrayDataViewImpl(Data_* data, SerializationContext* context)
       : data_(data), context_(context) {}
 
+  using Iterator = ArrayDataViewElementIterator<T, ArrayDataViewImpl>;
+
   void GetDataView(size_t index, T* output) {
     *output = T(data_->at(index).Get(), context_);
   }
 
+  Iterator begin() { return Iterator(this, 0); }
+  Iterator end() { return Iterator(this, data_->size()); }
+
   template <typename U>
   bool Read(size_t index, U* output) {
     return Deserialize<T>(data_->at(index).Get(), output, context_);
@@ -172,10 +225,15 @@ class ArrayDataViewImpl<
   ArrayDataViewImpl(Data_* data, SerializationContext* context)
       : data_(data), context_(context) {}
 
+  using Iterator = ArrayDataViewElementIterator<T, ArrayDataViewImpl>;
+
   void GetDataView(size_t index, T* output) {
     *output = T(&data_->at(index), context_);
   }
 
+  Iterator begin() { return Iterator(this, 0); }
+  Iterator end() { return Iterator(this, data_->size()); }
+
   template <typename U>
   bool Read(size_t index, U* output) {
     return Deserialize<T>(&data_->at(index), output, context_);
@@ -212,6 +270,8 @@ class ArrayDataView : public internal::ArrayDataViewImpl<T> {
   // POD types except boolean and enums:
   //   T operator[](size_t index) const;
   //   const T* data() const;
+  //   const T* begin() const;
+  //   const T* end() const;
 
   // Boolean:
   //   bool operator[](size_t index) const;
@@ -219,6 +279,8 @@ class ArrayDataView : public internal::ArrayDataViewImpl<T> {
   // Enums:
   //   T operator[](size_t index) const;
   //   const T* data() const;
+  //   const T* begin() const;
+  //   const T* end() const;
   //   template <typename U>
   //   bool Read(size_t index, U* output);
 
@@ -229,10 +291,17 @@ class ArrayDataView : public internal::ArrayDataViewImpl<T> {
   //   template <typename U>
   //   U Take(size_t index);
 
-  // Object types:
+  // Object types and unions:
   //   void GetDataView(size_t index, T* output);
   //   template <typename U>
   //   bool Read(size_t index, U* output);
+  //   Iterator begin();
+  //   Iterator end();
+  //
+  // Iterating an object or union array yields a DataView per element without
+  // deserializing anything, e.g.:
+  //   for (NestedStructDataView element : array_data_view)
+  //     total += element.f_int32();
 
  private:
   template <typename K, typename V>
@@ -84,6 +84,14 @@ class COMPONENT_EXPORT(MOJO_CPP_BINDINGS) InterfaceEndpointClient
   // before dispatch.
   void AddFilter(std::unique_ptr<MessageReceiver> filter);
 
+  // Sets the interface name under which dispatched messages are reported to
+  // MessageStats. |name| must outlive this object; generated interface names
+  // are string literals.
+  void set_interface_name(const char* name) {
+    DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+    interface_name_ = name;
+  }
+
   // After this call the object is in an invalid state and shouldn't be reused.
   ScopedInterfaceEndpointHandle PassHandle();
 
@@ -166,6 +174,7 @@ class COMPONENT_EXPORT(MOJO_CPP_BINDINGS) InterfaceEndpointClient
       ScopedInterfaceEndpointHandle::AssociationEvent event);
 
   bool HandleValidatedMessage(Message* message);
+  bool DispatchValidatedMessage(Message* message);
 
   const bool expect_sync_requests_ = false;
 
@@ -191,6 +200,8 @@ class COMPONENT_EXPORT(MOJO_CPP_BINDINGS) InterfaceEndpointClient
   internal::ControlMessageProxy control_message_proxy_;
   internal::ControlMessageHandler control_message_handler_;
 
+  const char* interface_name_ = "unknown interface";
+
 #if DCHECK_IS_ON()
   // The code location of the the most recent call into a method on this
   // interface endpoint. This is set *after* the call but *before* any message
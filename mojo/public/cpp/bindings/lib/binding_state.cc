@@ -118,6 +118,7 @@ void BindingStateBase::BindInternal(
       router_->CreateLocalEndpointHandle(kMasterInterfaceId), stub,
       std::move(request_validator), has_sync_methods,
       std::move(sequenced_runner), interface_version));
+  endpoint_client_->set_interface_name(interface_name);
 
 #if BUILDFLAG(MOJO_RANDOM_DELAYS_ENABLED)
   MakeBindingRandomlyPaused(base::SequencedTaskRunnerHandle::Get(),
@@ -86,6 +86,32 @@ size_t Buffer::Allocate(size_t num_bytes) {
   return block_start;
 }
 
+void Buffer::Reserve(size_t num_bytes) {
+  if (!message_.is_valid())
+    return;
+
+  const size_t new_cursor = cursor_ + Align(num_bytes);
+  if (new_cursor < cursor_ || new_cursor <= size_)
+    return;
+
+  DCHECK_LE(message_payload_size_, new_cursor);
+  size_t additional_capacity = new_cursor - message_payload_size_;
+  if (!base::IsValueInRangeForNumericType<uint32_t>(additional_capacity))
+    return;
+
+  MojoAppendMessageDataOptions options;
+  options.struct_size = sizeof(options);
+  options.flags = MOJO_APPEND_MESSAGE_DATA_FLAG_RESERVE_CAPACITY;
+  uint32_t new_size;
+  MojoResult rv = MojoAppendMessageData(
+      message_.value(), static_cast<uint32_t>(additional_capacity), nullptr, 0,
+      &options, &data_, &new_size);
+  if (rv != MOJO_RESULT_OK)
+    return;
+
+  size_ = new_size;
+}
+
 void Buffer::AttachHandles(std::vector<ScopedHandle>* handles) {
   DCHECK(message_.is_valid());
 
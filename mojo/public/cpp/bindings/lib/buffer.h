@@ -69,6 +69,12 @@ class COMPONENT_EXPORT(MOJO_CPP_BINDINGS_BASE) Buffer {
   // resolved to an address using Get<T>() below.
   size_t Allocate(size_t num_bytes);
 
+  // Ensures that at least |num_bytes| more bytes can be Allocate()d without
+  // growing the underlying message storage. This is only a hint: it has no
+  // effect on Buffers which are not backed by a message object, and it does not
+  // change the size of the serialized payload.
+  void Reserve(size_t num_bytes);
+
   // Returns a typed address within the Buffer corresponding to |index|. Note
   // that this address is NOT stable across calls to |Allocate()| and thus must
   // not be cached accordingly.
@@ -20,6 +20,7 @@
 #include "mojo/public/cpp/bindings/features.h"
 #include "mojo/public/cpp/bindings/lib/may_auto_lock.h"
 #include "mojo/public/cpp/bindings/lib/tracing_helper.h"
+#include "mojo/public/cpp/bindings/message_stats.h"
 #include "mojo/public/cpp/bindings/mojo_buildflags.h"
 #include "mojo/public/cpp/bindings/sync_handle_watcher.h"
 #include "mojo/public/cpp/system/wait.h"
@@ -492,6 +493,9 @@ MojoResult Connector::ReadMessage(Message* message) {
     return MOJO_RESULT_ABORTED;
   }
 
+  if (MessageStats::IsEnabled())
+    message->set_receive_time(base::TimeTicks::Now());
+
   return MOJO_RESULT_OK;
 }
 
@@ -18,6 +18,7 @@
 #include "mojo/public/cpp/bindings/interface_endpoint_controller.h"
 #include "mojo/public/cpp/bindings/lib/task_runner_helper.h"
 #include "mojo/public/cpp/bindings/lib/validation_util.h"
+#include "mojo/public/cpp/bindings/message_stats.h"
 #include "mojo/public/cpp/bindings/sync_call_restrictions.h"
 
 namespace mojo {
@@ -385,6 +386,31 @@ void InterfaceEndpointClient::OnAssociationEvent(
 }
 
 bool InterfaceEndpointClient::HandleValidatedMessage(Message* message) {
+  if (!MessageStats::IsEnabled() ||
+      mojo::internal::ControlMessageHandler::IsControlMessage(message)) {
+    return DispatchValidatedMessage(message);
+  }
+
+  // The handler may delete |this| or consume |*message|, so everything that is
+  // reported below is captured before dispatch.
+  const char* interface_name = interface_name_;
+  const uint32_t message_name = message->name();
+  const size_t payload_bytes =
+      message->is_serialized() ? message->data_num_bytes() : 0;
+  const base::TimeTicks dispatch_time = base::TimeTicks::Now();
+  const base::TimeDelta queue_time =
+      message->receive_time().is_null()
+          ? base::TimeDelta()
+          : dispatch_time - message->receive_time();
+
+  bool result = DispatchValidatedMessage(message);
+  MessageStats::RecordDispatch(interface_name, message_name, payload_bytes,
+                               queue_time,
+                               base::TimeTicks::Now() - dispatch_time);
+  return result;
+}
+
+bool InterfaceEndpointClient::DispatchValidatedMessage(Message* message) {
   DCHECK_EQ(handle_.id(), message->interface_id());
 
   if (encountered_error_) {
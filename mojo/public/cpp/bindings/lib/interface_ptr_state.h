@@ -230,6 +230,7 @@ class InterfacePtrState : public InterfacePtrStateBase {
             Interface::PassesAssociatedKinds_, Interface::HasSyncMethods_,
             std::make_unique<typename Interface::ResponseValidator_>())) {
       router()->SetMasterInterfaceName(Interface::Name_);
+      endpoint_client()->set_interface_name(Interface::Name_);
       proxy_ = std::make_unique<Proxy>(endpoint_client());
     }
   }
@@ -9,6 +9,7 @@
 #include <stdlib.h>
 
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <utility>
 
@@ -18,6 +19,7 @@
 #include "base/numerics/safe_math.h"
 #include "base/strings/stringprintf.h"
 #include "base/threading/sequence_local_storage_slot.h"
+#include "base/threading/thread_local.h"
 #include "base/trace_event/trace_event.h"
 #include "mojo/public/cpp/bindings/associated_group_controller.h"
 #include "mojo/public/cpp/bindings/lib/array_internal.h"
@@ -36,6 +38,29 @@ base::LazyInstance<
     base::SequenceLocalStorageSlot<SyncMessageResponseContext*>>::Leaky
     g_sls_sync_response_context = LAZY_INSTANCE_INITIALIZER;
 
+// Messages built without a known payload size reserve as much storage as the
+// last message of the same name built on the same thread, so steady-state
+// traffic can be serialized without reallocating the message buffer. Names are
+// hashed into a small fixed table; colliding names just share a hint.
+constexpr size_t kNumPayloadSizeHints = 64;
+
+// Larger payloads are not remembered, so one unusually large message does not
+// inflate the allocation of every later message sharing its hint.
+constexpr size_t kMaxPayloadSizeHint = 64 * 1024;
+
+using PayloadSizeHints = std::array<uint32_t, kNumPayloadSizeHints>;
+
+base::LazyInstance<base::ThreadLocalOwnedPointer<PayloadSizeHints>>::Leaky
+    g_tls_payload_size_hints = LAZY_INSTANCE_INITIALIZER;
+
+uint32_t& GetPayloadSizeHint(uint32_t name) {
+  base::ThreadLocalOwnedPointer<PayloadSizeHints>& hints =
+      g_tls_payload_size_hints.Get();
+  if (!hints.Get())
+    hints.Set(std::make_unique<PayloadSizeHints>());
+  return (*hints.Get())[name % kNumPayloadSizeHints];
+}
+
 void DoNotifyBadMessage(Message message, const std::string& error) {
   message.NotifyBadMessage(error);
 }
@@ -137,6 +162,12 @@ void CreateSerializedMessageObject(uint32_t name,
   WriteMessageHeader(name, flags, trace_id, payload_interface_id_count,
                      &payload_buffer);
 
+  if (!payload_size) {
+    const size_t size_hint = GetPayloadSizeHint(name);
+    if (size_hint > payload_buffer.cursor())
+      payload_buffer.Reserve(size_hint - payload_buffer.cursor());
+  }
+
   *out_handle = std::move(handle);
   *out_buffer = std::move(payload_buffer);
 }
@@ -218,7 +249,8 @@ Message::Message(Message&& other)
       associated_endpoint_handles_(
           std::move(other.associated_endpoint_handles_)),
       transferable_(other.transferable_),
-      serialized_(other.serialized_) {
+      serialized_(other.serialized_),
+      receive_time_(other.receive_time_) {
   other.transferable_ = false;
   other.serialized_ = false;
 #if defined(ENABLE_IPC_FUZZER)
@@ -302,6 +334,7 @@ Message& Message::operator=(Message&& other) {
   other.transferable_ = false;
   serialized_ = other.serialized_;
   other.serialized_ = false;
+  receive_time_ = other.receive_time_;
 #if defined(ENABLE_IPC_FUZZER)
   interface_name_ = other.interface_name_;
   method_name_ = other.method_name_;
@@ -316,6 +349,7 @@ void Message::Reset() {
   associated_endpoint_handles_.clear();
   transferable_ = false;
   serialized_ = false;
+  receive_time_ = base::TimeTicks();
 }
 
 const uint8_t* Message::payload() const {
@@ -394,6 +428,12 @@ ScopedMessageHandle Message::TakeMojoMessage() {
   // SerializeAssociatedEndpointHandles() must be called before this method.
   DCHECK(associated_endpoint_handles_.empty());
   DCHECK(transferable_);
+  if (payload_buffer_.data() &&
+      payload_buffer_.cursor() >= sizeof(internal::MessageHeader) &&
+      payload_buffer_.cursor() <= kMaxPayloadSizeHint) {
+    GetPayloadSizeHint(name()) =
+        static_cast<uint32_t>(payload_buffer_.cursor());
+  }
   payload_buffer_.Seal();
   auto handle = std::move(handle_);
   Reset();
@@ -0,0 +1,86 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "mojo/public/cpp/bindings/message_stats.h"
+
+#include <atomic>
+
+#include "base/metrics/histogram_macros.h"
+#include "base/no_destructor.h"
+#include "base/synchronization/lock.h"
+#include "base/trace_event/trace_event.h"
+
+namespace mojo {
+
+namespace {
+
+std::atomic<bool> g_enabled{false};
+
+struct GlobalStats {
+  base::Lock lock;
+  MessageStats::Snapshot entries;
+};
+
+GlobalStats& GetGlobalStats() {
+  static base::NoDestructor<GlobalStats> stats;
+  return *stats;
+}
+
+}  // namespace
+
+// static
+void MessageStats::SetEnabled(bool enabled) {
+  g_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+// static
+bool MessageStats::IsEnabled() {
+  return g_enabled.load(std::memory_order_relaxed);
+}
+
+// static
+void MessageStats::RecordDispatch(const char* interface_name,
+                                  uint32_t message_name,
+                                  size_t payload_bytes,
+                                  base::TimeDelta queue_time,
+                                  base::TimeDelta handler_time) {
+  UMA_HISTOGRAM_CUSTOM_MICROSECONDS_TIMES(
+      "Mojo.Bindings.MessageQueueTime", queue_time,
+      base::TimeDelta::FromMicroseconds(1), base::TimeDelta::FromSeconds(10),
+      50);
+  UMA_HISTOGRAM_CUSTOM_MICROSECONDS_TIMES(
+      "Mojo.Bindings.MessageHandlerTime", handler_time,
+      base::TimeDelta::FromMicroseconds(1), base::TimeDelta::FromSeconds(10),
+      50);
+
+  uint64_t message_count;
+  {
+    GlobalStats& stats = GetGlobalStats();
+    base::AutoLock lock(stats.lock);
+    Entry& entry = stats.entries[Key(interface_name, message_name)];
+    ++entry.message_count;
+    entry.payload_bytes += payload_bytes;
+    entry.total_queue_time += queue_time;
+    entry.total_handler_time += handler_time;
+    message_count = entry.message_count;
+  }
+
+  TRACE_COUNTER_ID1("mojom", interface_name, message_name, message_count);
+}
+
+// static
+MessageStats::Snapshot MessageStats::GetSnapshot() {
+  GlobalStats& stats = GetGlobalStats();
+  base::AutoLock lock(stats.lock);
+  return stats.entries;
+}
+
+// static
+void MessageStats::Reset() {
+  GlobalStats& stats = GetGlobalStats();
+  base::AutoLock lock(stats.lock);
+  stats.entries.clear();
+}
+
+}  // namespace mojo
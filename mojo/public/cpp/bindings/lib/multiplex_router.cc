@@ -6,6 +6,7 @@
 
 #include <stdint.h>
 
+#include <algorithm>
 #include <utility>
 
 #include "base/bind.h"
@@ -23,6 +24,15 @@
 namespace mojo {
 namespace internal {
 
+namespace {
+
+// The maximum number of queued tasks that a task for a high-priority endpoint
+// may be dispatched ahead of, and the maximum number of tasks dispatched ahead
+// of the front of the queue before the front task must be dispatched.
+constexpr size_t kMaxPriorityReordering = 64;
+
+}  // namespace
+
 // InterfaceEndpoint stores the information of an interface endpoint registered
 // with the router.
 // No one other than the router's |endpoints_| and |tasks_| should hold refs to
@@ -298,6 +308,16 @@ struct MultiplexRouter::Task {
   bool IsMessageTask() const { return type == MESSAGE; }
   bool IsNotifyErrorTask() const { return type == NOTIFY_ERROR; }
 
+  // Returns the ID of the endpoint this task targets, or kInvalidInterfaceId
+  // for messages which have already been processed.
+  InterfaceId target_interface_id() const {
+    if (IsNotifyErrorTask())
+      return endpoint_to_notify->id();
+    if (message_wrapper.value().IsNull())
+      return kInvalidInterfaceId;
+    return message_wrapper.value().interface_id();
+  }
+
   MessageWrapper message_wrapper;
   scoped_refptr<InterfaceEndpoint> endpoint_to_notify;
 
@@ -496,6 +516,17 @@ void MultiplexRouter::RaiseError() {
   }
 }
 
+void MultiplexRouter::SetEndpointPriority(InterfaceId id,
+                                          EndpointPriority priority) {
+  DCHECK(IsValidInterfaceId(id));
+
+  MayAutoLock locker(&lock_);
+  if (priority == EndpointPriority::kHigh)
+    high_priority_endpoints_.insert(id);
+  else
+    high_priority_endpoints_.erase(id);
+}
+
 bool MultiplexRouter::PrefersSerializedMessages() {
   MayAutoLock locker(&lock_);
   return connector_.PrefersSerializedMessages();
@@ -591,9 +622,14 @@ bool MultiplexRouter::Accept(Message* message) {
           : ALLOW_DIRECT_CLIENT_CALLS;
 
   MessageWrapper message_wrapper(this, std::move(*message));
-  bool processed = tasks_.empty() && ProcessIncomingMessage(
-                                         &message_wrapper, client_call_behavior,
-                                         connector_.task_runner());
+  const bool dispatch_ahead =
+      !tasks_.empty() && CanDispatchAheadOfQueuedTasks(message_wrapper.value());
+  bool processed =
+      (tasks_.empty() || dispatch_ahead) &&
+      ProcessIncomingMessage(&message_wrapper, client_call_behavior,
+                             connector_.task_runner());
+  if (processed && dispatch_ahead)
+    ++num_reordered_tasks_;
 
   if (!processed) {
     // Either the task queue is not empty or we cannot process the message
@@ -686,9 +722,14 @@ void MultiplexRouter::ProcessTasks(
   if (posted_to_process_tasks_)
     return;
 
+  // High-priority endpoints whose tasks couldn't be delivered during this call.
+  // Their tasks are skipped so that the front of the queue still makes
+  // progress.
+  std::set<InterfaceId> undeliverable_endpoints;
   while (!tasks_.empty() && !paused_) {
-    std::unique_ptr<Task> task(std::move(tasks_.front()));
-    tasks_.pop_front();
+    const size_t index = GetNextTaskIndex(undeliverable_endpoints);
+    std::unique_ptr<Task> task(std::move(tasks_[index]));
+    tasks_.erase(tasks_.begin() + index);
 
     InterfaceId id = kInvalidInterfaceId;
     bool sync_message =
@@ -713,18 +754,72 @@ void MultiplexRouter::ProcessTasks(
         auto& sync_message_queue = sync_message_tasks_[id];
         sync_message_queue.push_front(task.get());
       }
-      tasks_.push_front(std::move(task));
-      break;
+      const InterfaceId target_id = task->target_interface_id();
+      tasks_.insert(tasks_.begin() + std::min(index, tasks_.size()),
+                    std::move(task));
+      if (index == 0)
+        break;
+      undeliverable_endpoints.insert(target_id);
     } else {
       if (sync_message) {
         auto iter = sync_message_tasks_.find(id);
         if (iter != sync_message_tasks_.end() && iter->second.empty())
           sync_message_tasks_.erase(iter);
       }
+      num_reordered_tasks_ = index == 0 ? 0 : num_reordered_tasks_ + 1;
     }
   }
 }
 
+size_t MultiplexRouter::GetNextTaskIndex(
+    const std::set<InterfaceId>& skipped_endpoints) const {
+  AssertLockAcquired();
+  DCHECK(!tasks_.empty());
+
+  if (high_priority_endpoints_.empty() ||
+      num_reordered_tasks_ >= kMaxPriorityReordering) {
+    return 0;
+  }
+
+  const size_t limit = std::min(tasks_.size(), kMaxPriorityReordering + 1);
+  for (size_t i = 0; i < limit; ++i) {
+    if (IsHighPriorityTask(*tasks_[i]) &&
+        !base::ContainsKey(skipped_endpoints,
+                           tasks_[i]->target_interface_id())) {
+      return i;
+    }
+  }
+  return 0;
+}
+
+bool MultiplexRouter::CanDispatchAheadOfQueuedTasks(
+    const Message& message) const {
+  AssertLockAcquired();
+
+  if (high_priority_endpoints_.empty() ||
+      tasks_.size() > kMaxPriorityReordering ||
+      num_reordered_tasks_ >= kMaxPriorityReordering ||
+      PipeControlMessageHandler::IsPipeControlMessage(&message)) {
+    return false;
+  }
+
+  const InterfaceId id = message.interface_id();
+  if (!base::ContainsKey(high_priority_endpoints_, id))
+    return false;
+
+  // Never dispatch ahead of an earlier task for the same endpoint.
+  for (const auto& task : tasks_) {
+    if (task->target_interface_id() == id)
+      return false;
+  }
+  return true;
+}
+
+bool MultiplexRouter::IsHighPriorityTask(const Task& task) const {
+  return base::ContainsKey(high_priority_endpoints_,
+                           task.target_interface_id());
+}
+
 bool MultiplexRouter::ProcessFirstSyncMessageForEndpoint(InterfaceId id) {
   AssertLockAcquired();
 
@@ -912,8 +1007,10 @@ void MultiplexRouter::UpdateEndpointStateMayRemove(
     // it is notified and eventually exits the sync watch.
     endpoint->SignalSyncMessageEvent();
   }
-  if (endpoint->closed() && endpoint->peer_closed())
+  if (endpoint->closed() && endpoint->peer_closed()) {
+    high_priority_endpoints_.erase(endpoint->id());
     endpoints_.erase(endpoint->id());
+  }
 }
 
 void MultiplexRouter::RaiseErrorInNonTestingMode() {
@@ -9,6 +9,7 @@
 
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 
 #include "base/compiler_specific.h"
@@ -57,6 +58,14 @@ class COMPONENT_EXPORT(MOJO_CPP_BINDINGS) MultiplexRouter
       public AssociatedGroupController,
       public PipeControlMessageHandlerDelegate {
  public:
+  // Dispatch priority of an interface endpoint. Queued messages and error
+  // notifications for kHigh endpoints may be dispatched ahead of tasks queued
+  // earlier for other endpoints on the same pipe, so that latency-sensitive
+  // associated interfaces don't wait behind bulk traffic. Tasks for any single
+  // endpoint are always dispatched in order, and reordering is bounded so that
+  // kNormal endpoints are never starved.
+  enum class EndpointPriority { kNormal, kHigh };
+
   enum Config {
     // There is only the master interface running on this router. Please note
     // that because of interface versioning, the other side of the message pipe
@@ -107,6 +116,10 @@ class COMPONENT_EXPORT(MOJO_CPP_BINDINGS) MultiplexRouter
   void RaiseError() override;
   bool PrefersSerializedMessages() override;
 
+  // Sets the dispatch priority of the endpoint identified by |id|. Endpoints
+  // have kNormal priority by default.
+  void SetEndpointPriority(InterfaceId id, EndpointPriority priority);
+
   // ---------------------------------------------------------------------------
   // The following public methods are called on the creating sequence.
 
@@ -218,6 +231,17 @@ class COMPONENT_EXPORT(MOJO_CPP_BINDINGS) MultiplexRouter
                               ClientCallBehavior client_call_behavior,
                               base::SequencedTaskRunner* current_task_runner);
 
+  // Returns the index in |tasks_| of the next task to process: the first task
+  // for a high-priority endpoint not in |skipped_endpoints| within bounds, or
+  // the front task otherwise.
+  size_t GetNextTaskIndex(const std::set<InterfaceId>& skipped_endpoints) const;
+
+  // Returns true if |message| targets a high-priority endpoint with no tasks in
+  // |tasks_|, so that it may be dispatched ahead of the queued tasks.
+  bool CanDispatchAheadOfQueuedTasks(const Message& message) const;
+
+  bool IsHighPriorityTask(const Task& task) const;
+
   void MaybePostToProcessTasks(base::SequencedTaskRunner* task_runner);
   void LockAndCallProcessTasks();
 
@@ -269,6 +293,12 @@ class COMPONENT_EXPORT(MOJO_CPP_BINDINGS) MultiplexRouter
   // It refers to tasks in |tasks_| and doesn't own any of them.
   std::map<InterfaceId, base::circular_deque<Task*>> sync_message_tasks_;
 
+  // Endpoints with EndpointPriority::kHigh.
+  std::set<InterfaceId> high_priority_endpoints_;
+  // The number of tasks dispatched ahead of the front of |tasks_| since the
+  // front task was last dispatched.
+  size_t num_reordered_tasks_ = 0;
+
   bool posted_to_process_tasks_ = false;
   scoped_refptr<base::SequencedTaskRunner> posted_to_task_runner_;
 
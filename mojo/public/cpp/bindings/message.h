@@ -18,6 +18,7 @@
 #include "base/component_export.h"
 #include "base/logging.h"
 #include "base/memory/ptr_util.h"
+#include "base/time/time.h"
 #include "mojo/public/cpp/bindings/lib/buffer.h"
 #include "mojo/public/cpp/bindings/lib/message_internal.h"
 #include "mojo/public/cpp/bindings/lib/unserialized_message_context.h"
@@ -164,6 +165,14 @@ class COMPONENT_EXPORT(MOJO_CPP_BINDINGS_BASE) Message {
 
   internal::Buffer* payload_buffer() { return &payload_buffer_; }
 
+  // The time at which this message was read from its message pipe by a
+  // Connector. Only set while MessageStats collection is enabled; null
+  // otherwise.
+  base::TimeTicks receive_time() const { return receive_time_; }
+  void set_receive_time(base::TimeTicks receive_time) {
+    receive_time_ = receive_time;
+  }
+
   // Access the handles of a received message. Note that these are unused on
   // outgoing messages.
   const std::vector<ScopedHandle>* handles() const { return &handles_; }
@@ -257,6 +266,8 @@ class COMPONENT_EXPORT(MOJO_CPP_BINDINGS_BASE) Message {
   // Indicates whether this Message object is serialized.
   bool serialized_ = false;
 
+  base::TimeTicks receive_time_;
+
 #if defined(ENABLE_IPC_FUZZER)
   const char* interface_name_ = nullptr;
   const char* method_name_ = nullptr;
@@ -0,0 +1,75 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MOJO_PUBLIC_CPP_BINDINGS_MESSAGE_STATS_H_
+#define MOJO_PUBLIC_CPP_BINDINGS_MESSAGE_STATS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <map>
+#include <string>
+#include <utility>
+
+#include "base/component_export.h"
+#include "base/macros.h"
+#include "base/time/time.h"
+
+namespace mojo {
+
+// MessageStats collects process-wide statistics about the messages dispatched
+// by InterfaceEndpointClient, broken down by interface and message name. It is
+// disabled by default; while disabled, dispatch does no extra work.
+//
+// For each (interface, message name) pair the following are recorded:
+//   - the number of messages dispatched and their total payload size;
+//   - the total time messages spent between being read from their pipe by a
+//     Connector and being dispatched to the endpoint, which includes any time
+//     spent queued in the Connector or in a MultiplexRouter;
+//   - the total time spent in the receiving handler.
+//
+// The queueing and handler times are also reported to UMA, and the per-key
+// message counts are emitted as trace counters in the "mojom" category.
+//
+// This class is thread-safe.
+class COMPONENT_EXPORT(MOJO_CPP_BINDINGS) MessageStats {
+ public:
+  struct Entry {
+    uint64_t message_count = 0;
+    uint64_t payload_bytes = 0;
+    base::TimeDelta total_queue_time;
+    base::TimeDelta total_handler_time;
+  };
+
+  // Keyed by interface name and message name. Interface names which are not
+  // known to the receiving endpoint are reported as "unknown interface".
+  using Key = std::pair<std::string, uint32_t>;
+  using Snapshot = std::map<Key, Entry>;
+
+  // Enables or disables collection for the whole process. Disabling does not
+  // clear statistics which have already been collected.
+  static void SetEnabled(bool enabled);
+  static bool IsEnabled();
+
+  // Records the dispatch of a single message. |interface_name| must be a
+  // string literal or otherwise outlive the process.
+  static void RecordDispatch(const char* interface_name,
+                             uint32_t message_name,
+                             size_t payload_bytes,
+                             base::TimeDelta queue_time,
+                             base::TimeDelta handler_time);
+
+  // Returns a copy of all statistics collected so far.
+  static Snapshot GetSnapshot();
+
+  // Clears all collected statistics.
+  static void Reset();
+
+ private:
+  DISALLOW_IMPLICIT_CONSTRUCTORS(MessageStats);
+};
+
+}  // namespace mojo
+
+#endif  // MOJO_PUBLIC_CPP_BINDINGS_MESSAGE_STATS_H_
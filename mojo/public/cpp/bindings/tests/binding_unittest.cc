@@ -11,11 +11,13 @@
 #include <utility>
 
 #include "base/bind.h"
+#include "base/bind_helpers.h"
 #include "base/macros.h"
 #include "base/memory/ptr_util.h"
 #include "base/memory/weak_ptr.h"
 #include "base/run_loop.h"
 #include "mojo/core/embedder/embedder.h"
+#include "mojo/public/cpp/bindings/message_stats.h"
 #include "mojo/public/cpp/bindings/strong_binding.h"
 #include "mojo/public/cpp/bindings/tests/bindings_test_base.h"
 #include "mojo/public/interfaces/bindings/tests/ping_service.mojom.h"
@@ -390,6 +392,45 @@ TEST_P(BindingTest, FlushForTesting) {
   EXPECT_TRUE(called);
 }
 
+TEST_P(BindingTest, MessageStats) {
+  MessageStats::Reset();
+  MessageStats::SetEnabled(true);
+
+  sample::ServicePtr ptr;
+  ServiceImpl impl;
+  Binding<sample::Service> binding(&impl, MakeRequest(&ptr));
+
+  base::RunLoop run_loop;
+  ptr->Frobinate(nullptr, sample::Service::BazOptions::REGULAR, nullptr,
+                 base::BindOnce([](const base::Closure& quit,
+                                   int32_t result) { quit.Run(); },
+                                run_loop.QuitClosure()));
+  run_loop.Run();
+  MessageStats::SetEnabled(false);
+
+  // Both the request and its response are attributed to the interface, but
+  // control messages are not.
+  uint64_t message_count = 0;
+  for (const auto& entry : MessageStats::GetSnapshot()) {
+    EXPECT_EQ(sample::Service::Name_, entry.first.first);
+    message_count += entry.second.message_count;
+    EXPECT_GE(entry.second.total_queue_time, base::TimeDelta());
+    EXPECT_GE(entry.second.total_handler_time, base::TimeDelta());
+  }
+  EXPECT_EQ(2u, message_count);
+
+  // Nothing more is recorded once collection is disabled.
+  ptr->Frobinate(nullptr, sample::Service::BazOptions::REGULAR, nullptr,
+                 base::DoNothing());
+  ptr.FlushForTesting();
+  binding.FlushForTesting();
+  message_count = 0;
+  for (const auto& entry : MessageStats::GetSnapshot())
+    message_count += entry.second.message_count;
+  EXPECT_EQ(2u, message_count);
+  MessageStats::Reset();
+}
+
 TEST_P(BindingTest, FlushForTestingWithClosedPeer) {
   bool called = false;
   sample::ServicePtr ptr;
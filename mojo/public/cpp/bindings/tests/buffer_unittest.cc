@@ -8,6 +8,7 @@
 
 #include "mojo/public/cpp/bindings/lib/fixed_buffer.h"
 #include "mojo/public/cpp/bindings/lib/serialization_util.h"
+#include "mojo/public/cpp/bindings/message.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 namespace mojo {
@@ -28,6 +29,24 @@ TEST(FixedBufferTest, Alignment) {
   // Any more allocations would result in an assert, but we can't test that.
 }
 
+// Tests that allocations within reserved capacity don't move a message-backed
+// Buffer's storage.
+TEST(BufferTest, ReserveAvoidsReallocation) {
+  constexpr size_t kPayloadSize = 16 * 1024;
+  Message message(0, 0, 0, 0, nullptr);
+  internal::Buffer* buffer = message.payload_buffer();
+  const size_t header_size = buffer->cursor();
+
+  buffer->Reserve(kPayloadSize);
+  EXPECT_GE(buffer->size(), header_size + kPayloadSize);
+
+  void* data = buffer->data();
+  for (size_t i = 0; i < kPayloadSize / 64; ++i)
+    buffer->Allocate(64);
+  EXPECT_EQ(data, buffer->data());
+  EXPECT_EQ(header_size + kPayloadSize, buffer->cursor());
+}
+
 }  // namespace
 }  // namespace test
 }  // namespace mojo
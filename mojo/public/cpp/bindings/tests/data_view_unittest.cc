@@ -141,6 +141,9 @@ TEST_F(DataViewTest, IntegerArray) {
   EXPECT_EQ(1024, array_data_view[0]);
   EXPECT_EQ(128, array_data_view[1]);
   EXPECT_EQ(1024, *array_data_view.data());
+
+  std::vector<int32_t> values(array_data_view.begin(), array_data_view.end());
+  EXPECT_EQ(std::vector<int32_t>({1024, 128}), values);
 }
 
 TEST_F(DataViewTest, EnumArray) {
@@ -159,6 +162,10 @@ TEST_F(DataViewTest, EnumArray) {
   EXPECT_EQ(TestEnum::VALUE_0, array_data_view[1]);
   EXPECT_EQ(TestEnum::VALUE_0, *(array_data_view.data() + 1));
 
+  std::vector<TestEnum> values(array_data_view.begin(), array_data_view.end());
+  EXPECT_EQ(std::vector<TestEnum>({TestEnum::VALUE_1, TestEnum::VALUE_0}),
+            values);
+
   TestEnum output;
   ASSERT_TRUE(array_data_view.Read(0, &output));
   EXPECT_EQ(TestEnum::VALUE_1, output);
@@ -239,6 +246,29 @@ TEST_F(DataViewTest, StructArray) {
   EXPECT_EQ(42, nested_struct2->f_int32);
 }
 
+TEST_F(DataViewTest, IterateStructArray) {
+  TestStructPtr obj(TestStruct::New());
+  for (int32_t i = 0; i < 3; ++i) {
+    NestedStructPtr nested_struct(NestedStruct::New());
+    nested_struct->f_int32 = i + 1;
+    obj->f_struct_array.push_back(std::move(nested_struct));
+  }
+
+  auto data_view_holder = SerializeTestStruct(std::move(obj));
+  auto& data_view = *data_view_holder->data_view;
+
+  ArrayDataView<NestedStructDataView> array_data_view;
+  data_view.GetFStructArrayDataView(&array_data_view);
+  ASSERT_FALSE(array_data_view.is_null());
+
+  std::vector<int32_t> values;
+  for (NestedStructDataView struct_data_view : array_data_view) {
+    ASSERT_FALSE(struct_data_view.is_null());
+    values.push_back(struct_data_view.f_int32());
+  }
+  EXPECT_EQ(std::vector<int32_t>({1, 2, 3}), values);
+}
+
 TEST_F(DataViewTest, Map) {
   TestStructPtr obj(TestStruct::New());
   obj->f_map["1"] = 1;
@@ -312,6 +312,66 @@ TEST_F(MultiplexRouterTest, LateResponse) {
   generator.CompleteWithResponse();  // This should end up doing nothing.
 }
 
+TEST_F(MultiplexRouterTest, HighPriorityEndpointDispatchesAheadOfQueue) {
+  // Set up a second associated endpoint pair whose |router1_| side has high
+  // priority.
+  ScopedInterfaceEndpointHandle endpoint2;
+  ScopedInterfaceEndpointHandle endpoint3;
+  ScopedInterfaceEndpointHandle::CreatePairPendingAssociation(&endpoint2,
+                                                              &endpoint3);
+  InterfaceId id = router0_->AssociateInterface(std::move(endpoint3));
+  endpoint3 = router1_->CreateLocalEndpointHandle(id);
+  router1_->SetEndpointPriority(id, MultiplexRouter::EndpointPriority::kHigh);
+
+  InterfaceEndpointClient client0(std::move(endpoint0_), nullptr,
+                                  std::make_unique<PassThroughFilter>(), false,
+                                  base::ThreadTaskRunnerHandle::Get(), 0u);
+  InterfaceEndpointClient client2(std::move(endpoint2), nullptr,
+                                  std::make_unique<PassThroughFilter>(), false,
+                                  base::ThreadTaskRunnerHandle::Get(), 0u);
+  ResponseGenerator generator3;
+  InterfaceEndpointClient client3(std::move(endpoint3), &generator3,
+                                  std::make_unique<PassThroughFilter>(), false,
+                                  base::ThreadTaskRunnerHandle::Get(), 0u);
+
+  // |endpoint1_| has no client yet, so this request stays queued by
+  // |router1_|.
+  Message request;
+  AllocRequestMessage(1, "hello", &request);
+  MessageQueue message_queue;
+  client0.AcceptWithResponder(
+      &request, std::make_unique<MessageAccumulator>(&message_queue));
+
+  // The request to the high-priority endpoint must not wait behind it.
+  Message request2;
+  AllocRequestMessage(1, "hello again", &request2);
+  MessageQueue message_queue2;
+  base::RunLoop run_loop;
+  client2.AcceptWithResponder(
+      &request2, std::make_unique<MessageAccumulator>(&message_queue2,
+                                                      run_loop.QuitClosure()));
+  run_loop.Run();
+
+  EXPECT_TRUE(message_queue.IsEmpty());
+  ASSERT_FALSE(message_queue2.IsEmpty());
+  Message response;
+  message_queue2.Pop(&response);
+  EXPECT_EQ(std::string("hello again world!"),
+            std::string(reinterpret_cast<const char*>(response.payload())));
+
+  // Once |endpoint1_| has a client, its queued request is dispatched too.
+  ResponseGenerator generator1;
+  InterfaceEndpointClient client1(std::move(endpoint1_), &generator1,
+                                  std::make_unique<PassThroughFilter>(), false,
+                                  base::ThreadTaskRunnerHandle::Get(), 0u);
+  PumpMessages();
+
+  ASSERT_FALSE(message_queue.IsEmpty());
+  message_queue.Pop(&response);
+  EXPECT_EQ(std::string("hello world!"),
+            std::string(reinterpret_cast<const char*>(response.payload())));
+}
+
 // TODO(yzshen): add more tests.
 
 }  // namespace
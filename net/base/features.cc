@@ -31,5 +31,17 @@ const base::Feature kTLS13KeyUpdate{"TLS13KeyUpdate",
 const base::Feature kPostQuantumCECPQ2{"PostQuantumCECPQ2",
                                        base::FEATURE_DISABLED_BY_DEFAULT};
 
+const base::Feature kHttpCacheHotTier{"HttpCacheHotTier",
+                                      base::FEATURE_DISABLED_BY_DEFAULT};
+
+const base::Feature kQuicBatchedUdpIO{"QuicBatchedUdpIO",
+                                      base::FEATURE_DISABLED_BY_DEFAULT};
+
+const base::Feature kDnsHedgedQueries{"DnsHedgedQueries",
+                                      base::FEATURE_DISABLED_BY_DEFAULT};
+
+const base::Feature kSocketPoolWarming{"SocketPoolWarming",
+                                       base::FEATURE_DISABLED_BY_DEFAULT};
+
 }  // namespace features
 }  // namespace net
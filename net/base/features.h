@@ -36,6 +36,23 @@ NET_EXPORT extern const base::Feature kTLS13KeyUpdate;
 // Enables CECPQ2, a post-quantum key-agreement, in TLS 1.3 connections.
 NET_EXPORT extern const base::Feature kPostQuantumCECPQ2;
 
+// Keeps small, frequently used HttpCache entries in memory in front of the
+// disk cache, see disk_cache::HotTierBackend.
+NET_EXPORT extern const base::Feature kHttpCacheHotTier;
+
+// Reads several QUIC packets per system call with recvmmsg(), and sends
+// batched writes with UDP generic segmentation offload, where supported.
+NET_EXPORT extern const base::Feature kQuicBatchedUdpIO;
+
+// Races a DNS query against a second nameserver when the first one takes
+// longer than its estimated round-trip time, instead of waiting for the full
+// retransmission timeout.
+NET_EXPORT extern const base::Feature kDnsHedgedQueries;
+
+// Remembers how many sockets each socket pool group had in use at once, and
+// preconnects that many when the group is next used after going away.
+NET_EXPORT extern const base::Feature kSocketPoolWarming;
+
 }  // namespace features
 }  // namespace net
 
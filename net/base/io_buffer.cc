@@ -4,8 +4,16 @@
 
 #include "net/base/io_buffer.h"
 
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "base/atomicops.h"
+#include "base/lazy_instance.h"
 #include "base/logging.h"
+#include "base/macros.h"
 #include "base/numerics/safe_math.h"
+#include "base/threading/thread_local.h"
 
 namespace net {
 
@@ -24,6 +32,88 @@ void AssertValidBufferSize(int size) {
   CHECK_GE(size, 0);
 }
 
+// Blocks larger than this aren't cached, and a thread caches no more than
+// kMaxCachedBlocks of them, which is enough for the sockets that are read from
+// on a thread at a time.
+const size_t kMaxCachedBlockSize = 64 * 1024;
+const size_t kMaxCachedBlocks = 16;
+
+// The memory of destroyed RecycledIOBuffers, on one thread.
+class BlockCache {
+ public:
+  BlockCache() = default;
+
+  ~BlockCache() { Clear(); }
+
+  // Deletes all cached blocks.
+  void Clear() {
+    for (const auto& block : blocks_)
+      delete[] block.second;
+    blocks_.clear();
+  }
+
+  // Returns the number of bytes of the cached blocks.
+  size_t GetMemorySize() const {
+    size_t size = 0;
+    for (const auto& block : blocks_)
+      size += block.first;
+    return size;
+  }
+
+  // Returns a cached block of |size| bytes, or nullptr if there's none.
+  char* Take(size_t size) {
+    for (auto it = blocks_.rbegin(); it != blocks_.rend(); ++it) {
+      if (it->first == size) {
+        char* data = it->second;
+        blocks_.erase(std::next(it).base());
+        return data;
+      }
+    }
+    return nullptr;
+  }
+
+  // Takes ownership of |data|, a block of |size| bytes, and returns true if
+  // it's cached.
+  bool Put(char* data, size_t size) {
+    if (size > kMaxCachedBlockSize)
+      return false;
+    if (blocks_.size() == kMaxCachedBlocks) {
+      delete[] blocks_.front().second;
+      blocks_.erase(blocks_.begin());
+    }
+    blocks_.emplace_back(size, data);
+    return true;
+  }
+
+ private:
+  std::vector<std::pair<size_t, char*>> blocks_;
+
+  DISALLOW_COPY_AND_ASSIGN(BlockCache);
+};
+
+base::LazyInstance<base::ThreadLocalOwnedPointer<BlockCache>>::Leaky
+    g_block_cache = LAZY_INSTANCE_INITIALIZER;
+
+base::subtle::Atomic32 g_recycled_io_buffer_allocations = 0;
+
+BlockCache* GetBlockCache() {
+  BlockCache* cache = g_block_cache.Get().Get();
+  if (!cache) {
+    g_block_cache.Get().Set(std::make_unique<BlockCache>());
+    cache = g_block_cache.Get().Get();
+  }
+  return cache;
+}
+
+char* TakeOrAllocateBlock(size_t size) {
+  AssertValidBufferSize(size);
+  char* data = GetBlockCache()->Take(size);
+  if (data)
+    return data;
+  base::subtle::NoBarrier_AtomicIncrement(&g_recycled_io_buffer_allocations, 1);
+  return new char[size];
+}
+
 }  // namespace
 
 IOBuffer::IOBuffer()
@@ -72,6 +162,31 @@ IOBufferWithSize::IOBufferWithSize(char* data, size_t size)
 
 IOBufferWithSize::~IOBufferWithSize() = default;
 
+RecycledIOBuffer::RecycledIOBuffer(size_t size)
+    : IOBuffer(TakeOrAllocateBlock(size)), size_(size) {}
+
+// static
+size_t RecycledIOBuffer::GetAllocationCountForTesting() {
+  return base::subtle::NoBarrier_Load(&g_recycled_io_buffer_allocations);
+}
+
+// static
+void RecycledIOBuffer::ReleaseCachedMemory() {
+  GetBlockCache()->Clear();
+}
+
+// static
+size_t RecycledIOBuffer::GetCachedMemorySize() {
+  return GetBlockCache()->GetMemorySize();
+}
+
+RecycledIOBuffer::~RecycledIOBuffer() {
+  // Keep the memory from being deleted by the base class destructor if it was
+  // cached.
+  if (GetBlockCache()->Put(data_, size_))
+    data_ = nullptr;
+}
+
 StringIOBuffer::StringIOBuffer(const std::string& s)
     : IOBuffer(static_cast<char*>(NULL)),
       string_data_(s) {
@@ -120,6 +120,33 @@ class NET_EXPORT IOBufferWithSize : public IOBuffer {
   int size_;
 };
 
+// This version recycles its memory: when it's destroyed, its memory is kept in
+// a small cache on the thread that destroys it, for the next RecycledIOBuffer
+// of the same size that's created on that thread. Use it for buffers that are
+// allocated for each read and released soon after, like those that sockets
+// read into, to avoid the cost of allocating them.
+class NET_EXPORT RecycledIOBuffer : public IOBuffer {
+ public:
+  explicit RecycledIOBuffer(size_t size);
+
+  int size() const { return static_cast<int>(size_); }
+
+  // Frees the memory cached on the calling thread, e.g. under memory pressure.
+  static void ReleaseCachedMemory();
+
+  // Returns the number of bytes cached on the calling thread.
+  static size_t GetCachedMemorySize();
+
+  // Returns the number of RecycledIOBuffers created so far whose memory had to
+  // be allocated, rather than taken from a cache.
+  static size_t GetAllocationCountForTesting();
+
+ private:
+  ~RecycledIOBuffer() override;
+
+  const size_t size_;
+};
+
 // This is a read only IOBuffer.  The data is stored in a string and
 // the IOBuffer interface does not provide a proper way to modify it.
 class NET_EXPORT StringIOBuffer : public IOBuffer {
@@ -0,0 +1,44 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/base/io_buffer.h"
+
+#include <string.h>
+
+#include "base/memory/scoped_refptr.h"
+#include "base/test/perf_time_logger.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+// The size of the buffers that SSL sockets read into.
+constexpr size_t kBufferSize = 17 * 1024;
+constexpr int kNumBuffers = 1000000;
+
+// Allocates a buffer for each read, fills it in like a read would, and
+// releases it, like a socket that's read from continuously.
+template <typename Buffer>
+void AllocateAndRelease(const char* name) {
+  base::PerfTimeLogger timer(name);
+  for (int i = 0; i < kNumBuffers; ++i) {
+    auto buffer = base::MakeRefCounted<Buffer>(kBufferSize);
+    memset(buffer->data(), i, 1500);
+  }
+  timer.Done();
+}
+
+}  // namespace
+
+TEST(IOBufferPerfTest, AllocateAndRelease) {
+  AllocateAndRelease<IOBufferWithSize>("IOBuffer_allocate_17k_1M");
+
+  size_t allocations = RecycledIOBuffer::GetAllocationCountForTesting();
+  AllocateAndRelease<RecycledIOBuffer>("RecycledIOBuffer_allocate_17k_1M");
+  EXPECT_LE(RecycledIOBuffer::GetAllocationCountForTesting() - allocations,
+            1u);
+}
+
+}  // namespace net
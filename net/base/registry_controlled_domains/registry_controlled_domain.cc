@@ -198,6 +198,21 @@ base::StringPiece GetDomainAndRegistryAsStringPiece(
   return GetDomainAndRegistryImpl(host, filter);
 }
 
+// Returns true if canonicalizing |host| would leave it as it is, because it
+// consists only of lowercase ASCII letters, digits, hyphens and dots. Most
+// hosts passed to the functions below are, and they're looked up in place.
+bool IsCanonicalHostString(base::StringPiece host) {
+  if (host.empty())
+    return false;
+  for (char c : host) {
+    if (!base::IsAsciiLower(c) && !base::IsAsciiDigit(c) && c != '-' &&
+        c != '.') {
+      return false;
+    }
+  }
+  return true;
+}
+
 // These two functions append the given string as-is to the given output,
 // converting to UTF-8 if necessary.
 void AppendInvalidString(base::StringPiece str, url::CanonOutput* output) {
@@ -338,6 +353,9 @@ std::string GetDomainAndRegistry(const GURL& gurl,
 
 std::string GetDomainAndRegistry(base::StringPiece host,
                                  PrivateRegistryFilter filter) {
+  if (IsCanonicalHostString(host))
+    return GetDomainAndRegistryAsStringPiece(host, filter).as_string();
+
   url::CanonHostInfo host_info;
   const std::string canon_host(CanonicalizeHost(host, &host_info));
   if (canon_host.empty() || host_info.IsIPAddress())
@@ -382,6 +400,14 @@ size_t GetRegistryLength(
 bool HostHasRegistryControlledDomain(base::StringPiece host,
                                      UnknownRegistryFilter unknown_filter,
                                      PrivateRegistryFilter private_filter) {
+  if (IsCanonicalHostString(host)) {
+    if (url::HostIsIPAddress(host))
+      return false;
+    size_t rcd_length =
+        GetRegistryLengthImpl(host, unknown_filter, private_filter);
+    return (rcd_length != 0) && (rcd_length != std::string::npos);
+  }
+
   url::CanonHostInfo host_info;
   const std::string canon_host(CanonicalizeHost(host, &host_info));
 
@@ -0,0 +1,82 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/base/registry_controlled_domains/registry_controlled_domain.h"
+
+#include <string>
+#include <vector>
+
+#include "base/stl_util.h"
+#include "base/strings/stringprintf.h"
+#include "base/test/perf_time_logger.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace net {
+namespace registry_controlled_domains {
+
+namespace {
+
+constexpr int kNumHosts = 1000000;
+
+// Registries in roughly the proportions of a list of popular sites, with some
+// multi-label, private and wildcard ones.
+const char* const kRegistries[] = {
+    "com", "com", "com", "com", "com", "org", "net", "de", "co.uk", "ru",
+    "com.br", "jp", "co.jp", "in", "blogspot.com", "github.io", "ck", "io",
+};
+
+// Creates hosts with one to three labels before the registry.
+std::vector<std::string> CreateHosts() {
+  std::vector<std::string> hosts;
+  hosts.reserve(kNumHosts);
+  for (int i = 0; i < kNumHosts; ++i) {
+    const char* registry = kRegistries[i % base::size(kRegistries)];
+    switch (i % 3) {
+      case 0:
+        hosts.push_back(base::StringPrintf("site%d.%s", i, registry));
+        break;
+      case 1:
+        hosts.push_back(base::StringPrintf("www.site%d.%s", i, registry));
+        break;
+      default:
+        hosts.push_back(
+            base::StringPrintf("cdn.static.site%d.%s", i, registry));
+        break;
+    }
+  }
+  return hosts;
+}
+
+}  // namespace
+
+TEST(RegistryControlledDomainPerfTest, GetDomainAndRegistry) {
+  std::vector<std::string> hosts = CreateHosts();
+  size_t total_length = 0;
+
+  base::PerfTimeLogger host_timer("GetDomainAndRegistry_1M_hosts");
+  for (const std::string& host : hosts) {
+    total_length +=
+        GetDomainAndRegistry(host, INCLUDE_PRIVATE_REGISTRIES).length();
+  }
+  host_timer.Done();
+  EXPECT_GT(total_length, 0u);
+
+  std::vector<GURL> urls;
+  urls.reserve(hosts.size());
+  for (const std::string& host : hosts)
+    urls.emplace_back("https://" + host + "/");
+
+  total_length = 0;
+  base::PerfTimeLogger url_timer("GetDomainAndRegistry_1M_urls");
+  for (const GURL& url : urls) {
+    total_length +=
+        GetDomainAndRegistry(url, INCLUDE_PRIVATE_REGISTRIES).length();
+  }
+  url_timer.Done();
+  EXPECT_GT(total_length, 0u);
+}
+
+}  // namespace registry_controlled_domains
+}  // namespace net
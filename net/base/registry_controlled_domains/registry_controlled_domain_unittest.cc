@@ -167,6 +167,11 @@ TEST_F(RegistryControlledDomainTest, TestGetDomainAndRegistry) {
   EXPECT_EQ("", GetDomainFromHost("192.168.0.1"));
   EXPECT_EQ("", GetDomainFromHost("localhost."));
   EXPECT_EQ("", GetDomainFromHost(".localhost."));
+
+  // Hosts that aren't canonical are canonicalized first.
+  EXPECT_EQ("baz.jp", GetDomainFromHost("A.Baz.JP"));
+  EXPECT_EQ("baz.jp", GetDomainFromHost("a%2Ebaz.jp"));
+  EXPECT_EQ("", GetDomainFromHost("0x7f.1"));
 }
 
 TEST_F(RegistryControlledDomainTest, TestGetRegistryLength) {
@@ -340,6 +345,14 @@ TEST_F(RegistryControlledDomainTest, HostHasRegistryControlledDomain) {
   // Regular, match.
   EXPECT_TRUE(HostHasRegistryControlledDomain(
       "www.Google.Jp", EXCLUDE_UNKNOWN_REGISTRIES, EXCLUDE_PRIVATE_REGISTRIES));
+  EXPECT_TRUE(HostHasRegistryControlledDomain(
+      "www.google.jp", EXCLUDE_UNKNOWN_REGISTRIES, EXCLUDE_PRIVATE_REGISTRIES));
+
+  // IP addresses, whether or not they're canonical.
+  EXPECT_FALSE(HostHasRegistryControlledDomain(
+      "192.168.0.1", INCLUDE_UNKNOWN_REGISTRIES, EXCLUDE_PRIVATE_REGISTRIES));
+  EXPECT_FALSE(HostHasRegistryControlledDomain(
+      "0x7f.1", INCLUDE_UNKNOWN_REGISTRIES, EXCLUDE_PRIVATE_REGISTRIES));
 }
 
 TEST_F(RegistryControlledDomainTest, TestSameDomainOrHost) {
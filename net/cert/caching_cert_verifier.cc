@@ -17,22 +17,36 @@ namespace {
 // The maximum number of cache entries to use for the ExpiringCache.
 const unsigned kMaxCacheEntries = 256;
 
+// The maximum number of entries of a SharedCache, which holds the results of
+// several verifiers.
+const unsigned kMaxSharedCacheEntries = 1024;
+
 // The number of seconds to cache entries.
 const unsigned kTTLSecs = 1800;  // 30 minutes.
 
 }  // namespace
 
 CachingCertVerifier::CachingCertVerifier(std::unique_ptr<CertVerifier> verifier)
+    : CachingCertVerifier(std::move(verifier), nullptr) {}
+
+CachingCertVerifier::CachingCertVerifier(std::unique_ptr<CertVerifier> verifier,
+                                         SharedCache* shared_cache)
     : verifier_(std::move(verifier)),
       config_id_(0u),
-      cache_(kMaxCacheEntries),
+      cache_(shared_cache ? 0 : kMaxCacheEntries),
+      shared_cache_(shared_cache),
+      shared_config_id_(0),
       requests_(0u),
       cache_hits_(0u) {
+  if (shared_cache_)
+    shared_config_id_ = shared_cache_->GetConfigId(Config());
   CertDatabase::GetInstance()->AddObserver(this);
 }
 
 CachingCertVerifier::~CachingCertVerifier() {
   CertDatabase::GetInstance()->RemoveObserver(this);
+  if (shared_cache_)
+    shared_cache_->ReleaseConfigId(shared_config_id_);
 }
 
 int CachingCertVerifier::Verify(const CertVerifier::RequestParams& params,
@@ -44,8 +58,7 @@ int CachingCertVerifier::Verify(const CertVerifier::RequestParams& params,
 
   requests_++;
 
-  const CertVerificationCache::value_type* cached_entry =
-      cache_.Get(params, CacheValidityPeriod(base::Time::Now()));
+  const CachedResult* cached_entry = GetCachedResult(params);
   if (cached_entry) {
     ++cache_hits_;
     *verify_result = cached_entry->result;
@@ -69,9 +82,61 @@ int CachingCertVerifier::Verify(const CertVerifier::RequestParams& params,
 void CachingCertVerifier::SetConfig(const CertVerifier::Config& config) {
   verifier_->SetConfig(config);
   config_id_++;
+  if (shared_cache_) {
+    // Results for the old configuration stay in the shared cache, for the
+    // other verifiers that use it.
+    int old_config_id = shared_config_id_;
+    shared_config_id_ = shared_cache_->GetConfigId(config);
+    shared_cache_->ReleaseConfigId(old_config_id);
+  }
   ClearCache();
 }
 
+CachingCertVerifier::SharedCache::SharedCache()
+    : cache_(kMaxSharedCacheEntries), next_config_id_(0) {
+  CertDatabase::GetInstance()->AddObserver(this);
+}
+
+CachingCertVerifier::SharedCache::~SharedCache() {
+  DCHECK(configs_.empty());
+  CertDatabase::GetInstance()->RemoveObserver(this);
+}
+
+CachingCertVerifier::SharedCache::ConfigEntry::ConfigEntry(int id,
+                                                           const Config& config)
+    : id(id), config(config), verifier_count(0) {}
+
+CachingCertVerifier::SharedCache::ConfigEntry::~ConfigEntry() = default;
+
+int CachingCertVerifier::SharedCache::GetConfigId(const Config& config) {
+  for (ConfigEntry& entry : configs_) {
+    if (entry.config == config) {
+      ++entry.verifier_count;
+      return entry.id;
+    }
+  }
+  // Ids aren't reused, so that results cached for a configuration that's no
+  // longer in use are never returned for another one.
+  configs_.emplace_back(next_config_id_++, config);
+  configs_.back().verifier_count = 1;
+  return configs_.back().id;
+}
+
+void CachingCertVerifier::SharedCache::ReleaseConfigId(int id) {
+  for (auto it = configs_.begin(); it != configs_.end(); ++it) {
+    if (it->id != id)
+      continue;
+    if (--it->verifier_count == 0)
+      configs_.erase(it);
+    return;
+  }
+  NOTREACHED();
+}
+
+void CachingCertVerifier::SharedCache::OnCertDBChanged() {
+  cache_.Clear();
+}
+
 CachingCertVerifier::CachedResult::CachedResult() : error(ERR_FAILED) {}
 
 CachingCertVerifier::CachedResult::~CachedResult() = default;
@@ -119,6 +184,15 @@ bool CachingCertVerifier::CacheExpirationFunctor::operator()(
          now.verification_time < expiration.expiration_time;
 }
 
+const CachingCertVerifier::CachedResult* CachingCertVerifier::GetCachedResult(
+    const RequestParams& params) {
+  CacheValidityPeriod now(base::Time::Now());
+  if (shared_cache_)
+    return shared_cache_->cache_.Get(SharedCacheKey(shared_config_id_, params),
+                                     now);
+  return cache_.Get(params, now);
+}
+
 void CachingCertVerifier::OnRequestFinished(uint32_t config_id,
                                             const RequestParams& params,
                                             base::Time start_time,
@@ -168,10 +242,16 @@ void CachingCertVerifier::AddResultToCache(
   CachedResult cached_result;
   cached_result.error = error;
   cached_result.result = verify_result;
-  cache_.Put(
-      params, cached_result, CacheValidityPeriod(start_time),
-      CacheValidityPeriod(start_time,
-                          start_time + base::TimeDelta::FromSeconds(kTTLSecs)));
+  CacheValidityPeriod validity_period(
+      start_time, start_time + base::TimeDelta::FromSeconds(kTTLSecs));
+  if (shared_cache_) {
+    shared_cache_->cache_.Put(SharedCacheKey(shared_config_id_, params),
+                              cached_result, CacheValidityPeriod(start_time),
+                              validity_period);
+    return;
+  }
+  cache_.Put(params, cached_result, CacheValidityPeriod(start_time),
+             validity_period);
 }
 
 void CachingCertVerifier::OnCertDBChanged() {
@@ -180,11 +260,13 @@ void CachingCertVerifier::OnCertDBChanged() {
 }
 
 void CachingCertVerifier::ClearCache() {
+  // A shared cache clears itself when the certificate database changes, and
+  // is keyed by configuration.
   cache_.Clear();
 }
 
 size_t CachingCertVerifier::GetCacheSize() const {
-  return cache_.size();
+  return shared_cache_ ? shared_cache_->cache_.size() : cache_.size();
 }
 
 }  // namespace net
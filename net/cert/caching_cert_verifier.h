@@ -6,6 +6,8 @@
 #define NET_CERT_CACHING_CERT_VERIFIER_H_
 
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include "net/base/completion_once_callback.h"
 #include "net/base/expiring_cache.h"
@@ -35,11 +37,19 @@ namespace net {
 class NET_EXPORT CachingCertVerifier : public CertVerifier,
                                        public CertDatabase::Observer {
  public:
+  class SharedCache;
+
   // Creates a CachingCertVerifier that will use |verifier| to perform the
   // actual verifications if they're not already cached or if the cached
   // item has expired.
   explicit CachingCertVerifier(std::unique_ptr<CertVerifier> verifier);
 
+  // Creates a CachingCertVerifier that caches its results in |shared_cache|,
+  // which must outlive it, rather than in a cache of its own. All the
+  // verifiers that share a cache must verify against the same trust store.
+  CachingCertVerifier(std::unique_ptr<CertVerifier> verifier,
+                      SharedCache* shared_cache);
+
   ~CachingCertVerifier() override;
 
   // CertVerifier implementation:
@@ -55,6 +65,9 @@ class NET_EXPORT CachingCertVerifier : public CertVerifier,
   FRIEND_TEST_ALL_PREFIXES(CachingCertVerifierTest, Visitor);
   FRIEND_TEST_ALL_PREFIXES(CachingCertVerifierTest, AddsEntries);
   FRIEND_TEST_ALL_PREFIXES(CachingCertVerifierTest, DifferentCACerts);
+  FRIEND_TEST_ALL_PREFIXES(CachingCertVerifierTest, SharedCacheHit);
+  FRIEND_TEST_ALL_PREFIXES(CachingCertVerifierTest,
+                           SharedCacheSeparatesConfigs);
 
   // CachedResult contains the result of a certificate verification.
   struct NET_EXPORT_PRIVATE CachedResult {
@@ -92,6 +105,17 @@ class NET_EXPORT CachingCertVerifier : public CertVerifier,
                                               CacheValidityPeriod,
                                               CacheExpirationFunctor>;
 
+  // Entries of a SharedCache are keyed by the id that it gave to the
+  // configuration of the verifier too, since results vary with it.
+  using SharedCacheKey = std::pair<int, RequestParams>;
+  using SharedCertVerificationCache = ExpiringCache<SharedCacheKey,
+                                                    CachedResult,
+                                                    CacheValidityPeriod,
+                                                    CacheExpirationFunctor>;
+
+  // Returns the cached result for |params|, or nullptr if there's none.
+  const CachedResult* GetCachedResult(const RequestParams& params);
+
   // Handles completion of the request matching |params|, which started at
   // |start_time| and with config |config_id|, completing. |verify_result| and
   // |result| are added to the cache, and then |callback| (the original caller's
@@ -126,12 +150,59 @@ class NET_EXPORT CachingCertVerifier : public CertVerifier,
   uint32_t config_id_;
   CertVerificationCache cache_;
 
+  // If set, results are cached in |shared_cache_| instead of |cache_|, under
+  // |shared_config_id_|.
+  SharedCache* const shared_cache_;
+  int shared_config_id_;
+
   uint64_t requests_;
   uint64_t cache_hits_;
 
   DISALLOW_COPY_AND_ASSIGN(CachingCertVerifier);
 };
 
+// A cache of verification results that's shared by several
+// CachingCertVerifiers, such as those of the different profiles in a process,
+// so that a chain verified by one of them isn't verified again by the others.
+// Results are only shared between verifiers with equal configurations. Like
+// the verifiers, it must only be used on one sequence.
+class NET_EXPORT CachingCertVerifier::SharedCache
+    : public CertDatabase::Observer {
+ public:
+  SharedCache();
+  ~SharedCache() override;
+
+ private:
+  friend class CachingCertVerifier;
+
+  struct ConfigEntry {
+    ConfigEntry(int id, const Config& config);
+    ~ConfigEntry();
+
+    int id;
+    Config config;
+    // The number of verifiers that use |config|.
+    int verifier_count;
+  };
+
+  // Returns the id of |config|, adding it if no verifier uses it yet. Each
+  // call must be balanced by a call to ReleaseConfigId().
+  int GetConfigId(const Config& config);
+  void ReleaseConfigId(int id);
+
+  // CertDatabase::Observer methods:
+  void OnCertDBChanged() override;
+
+  SharedCertVerificationCache cache_;
+
+  // The configurations in use by the verifiers that share this cache. There's
+  // typically only one or two of them.
+  std::vector<ConfigEntry> configs_;
+  int next_config_id_;
+
+  DISALLOW_COPY_AND_ASSIGN(SharedCache);
+};
+
 }  // namespace net
 
 #endif  // NET_CERT_CACHING_CERT_VERIFIER_H_
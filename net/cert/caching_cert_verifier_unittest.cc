@@ -128,4 +128,80 @@ TEST_F(CachingCertVerifierTest, DifferentCACerts) {
   ASSERT_EQ(2u, verifier_.GetCacheSize());
 }
 
+// Verifiers that share a cache see each other's results.
+TEST_F(CachingCertVerifierTest, SharedCacheHit) {
+  scoped_refptr<X509Certificate> test_cert(
+      ImportCertFromFile(GetTestCertsDirectory(), "ok_cert.pem"));
+  ASSERT_TRUE(test_cert.get());
+
+  CachingCertVerifier::SharedCache shared_cache;
+  CachingCertVerifier verifier1(std::make_unique<MockCertVerifier>(),
+                                &shared_cache);
+  CachingCertVerifier verifier2(std::make_unique<MockCertVerifier>(),
+                                &shared_cache);
+
+  CertVerifyResult verify_result;
+  TestCompletionCallback callback;
+  std::unique_ptr<CertVerifier::Request> request;
+  CertVerifier::RequestParams params(test_cert, "www.example.com", 0,
+                                     std::string());
+
+  int error = callback.GetResult(verifier1.Verify(
+      params, &verify_result, callback.callback(), &request,
+      NetLogWithSource()));
+  ASSERT_TRUE(IsCertificateError(error));
+  EXPECT_EQ(0u, verifier1.cache_hits());
+  EXPECT_EQ(1u, verifier2.GetCacheSize());
+
+  error = verifier2.Verify(params, &verify_result, callback.callback(),
+                           &request, NetLogWithSource());
+  // Synchronous completion.
+  ASSERT_NE(ERR_IO_PENDING, error);
+  ASSERT_TRUE(IsCertificateError(error));
+  EXPECT_FALSE(request);
+  EXPECT_EQ(1u, verifier2.cache_hits());
+}
+
+// Verifiers that share a cache, but have different configurations, don't see
+// each other's results, and don't clear them when their configuration changes.
+TEST_F(CachingCertVerifierTest, SharedCacheSeparatesConfigs) {
+  scoped_refptr<X509Certificate> test_cert(
+      ImportCertFromFile(GetTestCertsDirectory(), "ok_cert.pem"));
+  ASSERT_TRUE(test_cert.get());
+
+  CachingCertVerifier::SharedCache shared_cache;
+  CachingCertVerifier verifier1(std::make_unique<MockCertVerifier>(),
+                                &shared_cache);
+  CachingCertVerifier verifier2(std::make_unique<MockCertVerifier>(),
+                                &shared_cache);
+  CertVerifier::Config config;
+  config.enable_rev_checking = true;
+  verifier2.SetConfig(config);
+
+  CertVerifyResult verify_result;
+  TestCompletionCallback callback;
+  std::unique_ptr<CertVerifier::Request> request;
+  CertVerifier::RequestParams params(test_cert, "www.example.com", 0,
+                                     std::string());
+
+  int error = callback.GetResult(verifier1.Verify(
+      params, &verify_result, callback.callback(), &request,
+      NetLogWithSource()));
+  ASSERT_TRUE(IsCertificateError(error));
+  error = callback.GetResult(verifier2.Verify(params, &verify_result,
+                                              callback.callback(), &request,
+                                              NetLogWithSource()));
+  ASSERT_TRUE(IsCertificateError(error));
+  EXPECT_EQ(0u, verifier2.cache_hits());
+  EXPECT_EQ(2u, verifier1.GetCacheSize());
+
+  // Once they have the same configuration, they share results.
+  verifier1.SetConfig(config);
+  EXPECT_EQ(2u, verifier1.GetCacheSize());
+  error = verifier1.Verify(params, &verify_result, callback.callback(),
+                           &request, NetLogWithSource());
+  ASSERT_NE(ERR_IO_PENDING, error);
+  EXPECT_EQ(1u, verifier1.cache_hits());
+}
+
 }  // namespace net
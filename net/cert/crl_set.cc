@@ -4,6 +4,8 @@
 
 #include "net/cert/crl_set.h"
 
+#include <algorithm>
+
 #include "base/base64.h"
 #include "base/json/json_reader.h"
 #include "base/time/time.h"
@@ -242,6 +244,8 @@ bool CRLSet::Parse(base::StringPiece data, scoped_refptr<CRLSet>* out_crl_set) {
     if (!ReadCRL(&data, &spki_hash, &blocked_serials)) {
       return false;
     }
+    // Sorted for CheckSerial(). CRLSets are usually generated sorted already.
+    std::sort(blocked_serials.begin(), blocked_serials.end());
     crl_set->crls_[std::move(spki_hash)] = std::move(blocked_serials);
   }
 
@@ -303,10 +307,15 @@ CRLSet::Result CRLSet::CheckSerial(
   if (it == crls_.end())
     return UNKNOWN;
 
-  for (const auto& issuer_serial : it->second) {
-    if (issuer_serial == serial)
-      return REVOKED;
-  }
+  // Some issuers have thousands of revoked serials, so they're kept sorted.
+  const std::vector<std::string>& issuer_serials = it->second;
+  auto serial_it = std::lower_bound(
+      issuer_serials.begin(), issuer_serials.end(), serial,
+      [](const std::string& issuer_serial, base::StringPiece serial) {
+        return base::StringPiece(issuer_serial) < serial;
+      });
+  if (serial_it != issuer_serials.end() && *serial_it == serial)
+    return REVOKED;
 
   return GOOD;
 }
@@ -103,8 +103,8 @@ class NET_EXPORT CRLSet : public base::RefCountedThreadSafe<CRLSet> {
   // not_after_ contains the time, in UNIX epoch seconds, after which the
   // CRLSet should be considered stale, or 0 if no such time was given.
   uint64_t not_after_;
-  // crls_ is a map from the SHA-256 hash of an X.501 subject name to a list
-  // of revoked serial numbers.
+  // crls_ is a map from the SHA-256 hash of an X.501 subject name to a sorted
+  // list of revoked serial numbers.
   CRLList crls_;
   // blocked_spkis_ contains the SHA256 hashes of SPKIs which are to be blocked
   // no matter where in a certificate chain they might appear.
@@ -104,6 +104,15 @@ TEST(CRLSetTest, Parse) {
             set->CheckSerial(
                 std::string("\x47\x54\x3E\x79\x00\x03\x00\x00\x14\xF5", 10),
                 gia_spki_hash));
+  for (const std::string& serial : serials)
+    EXPECT_EQ(CRLSet::REVOKED, set->CheckSerial(serial, gia_spki_hash));
+  EXPECT_EQ(CRLSet::GOOD,
+            set->CheckSerial(
+                std::string("\x64\x63\x49\xD2\x00\x03\x00\x00\x1D\x78", 10),
+                gia_spki_hash));
+  EXPECT_EQ(CRLSet::GOOD,
+            set->CheckSerial(std::string("\x10\x0D\x7F\x30", 4),
+                             gia_spki_hash));
 
   EXPECT_FALSE(set->IsExpired());
 }
@@ -639,6 +639,16 @@ void CookieMonster::GetCookieListWithOptions(const GURL& url,
   if (HasCookieableScheme(url)) {
     std::vector<CanonicalCookie*> cookie_ptrs;
     FindCookiesForRegistryControlledHost(url, &cookie_ptrs);
+    // On sites with many subdomains, most cookies under the key are for other
+    // hosts or paths. Unless they have to be reported as excluded, drop them
+    // before they're sorted and filtered one by one.
+    if (!options.return_excluded_cookies()) {
+      const std::string host = url.host();
+      const std::string path = url.path();
+      base::EraseIf(cookie_ptrs, [&host, &path](const CanonicalCookie* cc) {
+        return !cc->IsDomainMatch(host) || !cc->IsOnPath(path);
+      });
+    }
     std::sort(cookie_ptrs.begin(), cookie_ptrs.end(), CookieSorter);
 
     cookies.reserve(cookie_ptrs.size());
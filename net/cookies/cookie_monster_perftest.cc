@@ -298,6 +298,33 @@ TEST_F(CookieMonsterTest, TestDomainLine) {
   timer2.Done();
 }
 
+// Many subdomains of a site, each with a few host and path cookies, so that
+// the cookies for one request are a small part of those under its key.
+TEST_F(CookieMonsterTest, TestManyCookiesPerDomain) {
+  auto cm = std::make_unique<CookieMonster>(nullptr, nullptr, nullptr);
+  SetCookieCallback setCookieCallback;
+  GetCookieListCallback getCookieListCallback;
+
+  // Stays below CookieMonster::kDomainMaxCookies, so that none is evicted.
+  const int kNumSubdomains = 50;
+  for (int i = 0; i < kNumSubdomains; i++) {
+    GURL gurl(base::StringPrintf("https://s%02d.ads.com/", i));
+    setCookieCallback.SetCookie(cm.get(), gurl, "a=b");
+    setCookieCallback.SetCookie(cm.get(), gurl, "c=d; path=/track");
+    setCookieCallback.SetCookie(cm.get(), gurl, "e=f; path=/other");
+  }
+
+  GURL probe_gurl("https://s07.ads.com/track/pixel");
+  const CookieList& cookie_list =
+      getCookieListCallback.GetCookieList(cm.get(), probe_gurl);
+  EXPECT_EQ(2u, cookie_list.size());
+  base::PerfTimeLogger timer("Cookie_monster_query_many_cookies_per_domain");
+  for (int i = 0; i < kNumCookies; i++) {
+    getCookieListCallback.GetCookieList(cm.get(), probe_gurl);
+  }
+  timer.Done();
+}
+
 TEST_F(CookieMonsterTest, TestImport) {
   scoped_refptr<MockPersistentCookieStore> store(new MockPersistentCookieStore);
   std::vector<std::unique_ptr<CanonicalCookie>> initial_cookies;
@@ -3580,6 +3580,49 @@ TEST_F(DiskCacheBackendTest, Backend_UsageStats) {
   EXPECT_EQ(1, std::count(stats.begin(), stats.end(), hits));
 }
 
+TEST_F(DiskCacheBackendTest, SimpleCacheUsageStats) {
+  SetSimpleCacheMode();
+  InitCache();
+  const int kSize = 100;
+  scoped_refptr<net::IOBuffer> buffer =
+      base::MakeRefCounted<net::IOBuffer>(kSize);
+  CacheTestFillBuffer(buffer->data(), kSize, false);
+
+  disk_cache::Entry* entry;
+  ASSERT_THAT(CreateEntry("key", &entry), IsOk());
+  EXPECT_EQ(kSize, WriteData(entry, 1, 0, buffer.get(), kSize, false));
+  entry->Close();
+  disk_cache::SimpleBackendImpl::FlushWorkerPoolForTesting();
+  base::RunLoop().RunUntilIdle();
+
+  // Creating an entry isn't a hit.
+  disk_cache::StatsItems stats;
+  cache_->GetStats(&stats);
+  EXPECT_EQ(1, std::count(stats.begin(), stats.end(),
+                          disk_cache::StatsItems::value_type("Hits", "0")));
+
+  ASSERT_THAT(OpenEntry("key", &entry), IsOk());
+  EXPECT_EQ(kSize, ReadData(entry, 1, 0, buffer.get(), kSize));
+  entry->Close();
+  disk_cache::SimpleBackendImpl::FlushWorkerPoolForTesting();
+  base::RunLoop().RunUntilIdle();
+
+  stats.clear();
+  cache_->GetStats(&stats);
+  EXPECT_EQ(1, std::count(stats.begin(), stats.end(),
+                          disk_cache::StatsItems::value_type("Hits", "1")));
+  auto syscalls = std::find_if(
+      stats.begin(), stats.end(),
+      [](const disk_cache::StatsItems::value_type& item) {
+        return item.first == "Syscalls per hit";
+      });
+  ASSERT_NE(stats.end(), syscalls);
+  double syscalls_per_hit = 0;
+  ASSERT_TRUE(base::StringToDouble(syscalls->second, &syscalls_per_hit));
+  // At least the open, stat, read and close of file 0.
+  EXPECT_LE(4, syscalls_per_hit);
+}
+
 void DiskCacheBackendTest::BackendDoomAll() {
   InitCache();
 
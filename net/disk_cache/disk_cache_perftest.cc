@@ -18,6 +18,7 @@
 #include "base/strings/string_util.h"
 #include "base/test/perf_time_logger.h"
 #include "base/test/test_file_util.h"
+#include "base/threading/thread_task_runner_handle.h"
 #include "base/threading/thread.h"
 #include "build/build_config.h"
 #include "net/base/cache_type.h"
@@ -625,4 +626,183 @@ TEST(SimpleIndexPerfTest, EvictionPerformance) {
              << "ms";
 }
 
+// Spreads the entry hashes of the large index tests like SHA-1 hashes would.
+uint64_t LargeIndexEntryHash(int i) {
+  return static_cast<uint64_t>(i + 1) * UINT64_C(0x9E3779B97F4A7C15);
+}
+
+const int kLargeIndexEntries = 1000000;
+
+// Measures how quickly SimpleIndex can compute which entries to evict when the
+// index is large enough to sample entries instead of sorting them.
+TEST(SimpleIndexPerfTest, EvictionPerformanceLargeIndex) {
+  class NoOpDelegate : public disk_cache::SimpleIndexDelegate {
+    void DoomEntries(std::vector<uint64_t>* entry_hashes,
+                     net::CompletionOnceCallback callback) override {}
+  };
+
+  NoOpDelegate delegate;
+  base::Time start(base::Time::Now());
+
+  double evict_elapsed_ms = 0;
+  const int kIterations = 10;
+  for (int iteration = 0; iteration < kIterations; ++iteration) {
+    disk_cache::SimpleIndex index(/* io_thread = */ nullptr,
+                                  /* cleanup_tracker = */ nullptr, &delegate,
+                                  net::DISK_CACHE,
+                                  /* simple_index_file = */ nullptr);
+
+    // Make sure large enough to not evict on insertion.
+    index.SetMaxSize(kLargeIndexEntries * 2);
+
+    for (int i = 0; i < kLargeIndexEntries; ++i) {
+      index.InsertEntryForTesting(
+          LargeIndexEntryHash(i),
+          disk_cache::EntryMetadata(start + base::TimeDelta::FromSeconds(i),
+                                    1u));
+    }
+
+    // Trigger an eviction.
+    base::ElapsedTimer timer;
+    index.SetMaxSize(kLargeIndexEntries);
+    index.UpdateEntrySize(LargeIndexEntryHash(0), 1u);
+    evict_elapsed_ms += timer.Elapsed().InMillisecondsF();
+  }
+
+  LOG(ERROR) << "Average time to evict from " << kLargeIndexEntries
+             << " entries:" << (evict_elapsed_ms / kIterations) << "ms";
+}
+
+// Measures how long writing a large index blocks the IO thread, when all of it
+// changed and when only a few entries changed since the previous write.
+TEST_F(DiskCachePerfTest, SimpleIndexWriteLargeIndex) {
+  disk_cache::SimpleIndexFile index_file(
+      base::ThreadTaskRunnerHandle::Get(), base::ThreadTaskRunnerHandle::Get(),
+      net::DISK_CACHE, cache_path_);
+  disk_cache::SimpleIndex::EntrySet entries;
+  base::Time start(base::Time::Now());
+  for (int i = 0; i < kLargeIndexEntries; ++i) {
+    disk_cache::SimpleIndex::InsertInEntrySet(
+        LargeIndexEntryHash(i),
+        disk_cache::EntryMetadata(start + base::TimeDelta::FromSeconds(i),
+                                  1000u),
+        &entries);
+  }
+
+  index_file.WriteToDisk(
+      net::DISK_CACHE, disk_cache::SimpleIndex::INDEX_WRITE_REASON_IDLE,
+      entries, entries.size() * 1000u, base::TimeTicks::Now(), false,
+      base::Closure());
+  entries.ClearDirtyShards();
+  base::RunLoop().RunUntilIdle();
+
+  const int kIterations = 10;
+  double full_elapsed_ms = 0;
+  double incremental_elapsed_ms = 0;
+  for (int iteration = 0; iteration < kIterations; ++iteration) {
+    // A new SimpleIndexFile has to serialize everything.
+    disk_cache::SimpleIndexFile fresh_index_file(
+        base::ThreadTaskRunnerHandle::Get(),
+        base::ThreadTaskRunnerHandle::Get(), net::DISK_CACHE, cache_path_);
+    base::ElapsedTimer full_timer;
+    fresh_index_file.WriteToDisk(
+        net::DISK_CACHE, disk_cache::SimpleIndex::INDEX_WRITE_REASON_IDLE,
+        entries, entries.size() * 1000u, base::TimeTicks::Now(), false,
+        base::Closure());
+    full_elapsed_ms += full_timer.Elapsed().InMillisecondsF();
+    base::RunLoop().RunUntilIdle();
+
+    // The way the index writes after a few entries were used.
+    for (int i = 0; i < 10; ++i) {
+      entries.find(LargeIndexEntryHash(iteration * 10 + i))
+          ->second.SetLastUsedTime(base::Time::Now());
+    }
+    base::ElapsedTimer incremental_timer;
+    index_file.WriteToDisk(
+        net::DISK_CACHE, disk_cache::SimpleIndex::INDEX_WRITE_REASON_IDLE,
+        entries, entries.size() * 1000u, base::TimeTicks::Now(), false,
+        base::Closure());
+    incremental_elapsed_ms += incremental_timer.Elapsed().InMillisecondsF();
+    entries.ClearDirtyShards();
+    base::RunLoop().RunUntilIdle();
+  }
+
+  LOG(ERROR) << "Average time to serialize " << kLargeIndexEntries
+             << " entries:" << (full_elapsed_ms / kIterations) << "ms";
+  LOG(ERROR) << "Average time to serialize " << kLargeIndexEntries
+             << " entries with 10 modified:"
+             << (incremental_elapsed_ms / kIterations) << "ms";
+}
+
+// Measures how long a cold start takes to answer its first lookup, when it has
+// to load the whole index and when it maps the index file instead.
+TEST_F(DiskCachePerfTest, SimpleIndexColdStartLookup) {
+  disk_cache::SimpleIndexFile index_file(
+      base::ThreadTaskRunnerHandle::Get(), base::ThreadTaskRunnerHandle::Get(),
+      net::DISK_CACHE, cache_path_);
+  disk_cache::SimpleIndex::EntrySet entries;
+  base::Time start(base::Time::Now());
+  for (int i = 0; i < kLargeIndexEntries; ++i) {
+    disk_cache::SimpleIndex::InsertInEntrySet(
+        LargeIndexEntryHash(i),
+        disk_cache::EntryMetadata(start + base::TimeDelta::FromSeconds(i),
+                                  1000u),
+        &entries);
+  }
+  net::TestClosure write_closure;
+  index_file.WriteToDisk(
+      net::DISK_CACHE, disk_cache::SimpleIndex::INDEX_WRITE_REASON_SHUTDOWN,
+      entries, entries.size() * 1000u, base::TimeTicks::Now(), false,
+      write_closure.closure());
+  write_closure.WaitForResult();
+  const base::FilePath index_path =
+      cache_path_.AppendASCII("index-dir").AppendASCII("the-real-index");
+  const uint64_t kHash = LargeIndexEntryHash(kLargeIndexEntries / 2);
+
+  const int kIterations = 10;
+  double load_elapsed_ms = 0;
+  double map_elapsed_ms = 0;
+  for (int iteration = 0; iteration < kIterations; ++iteration) {
+    ASSERT_TRUE(base::EvictFileFromSystemCache(index_path));
+    {
+      base::ElapsedTimer timer;
+      disk_cache::SimpleIndexLoadResult result;
+      base::RunLoop run_loop;
+      index_file.LoadIndexEntries(base::Time(), run_loop.QuitClosure(),
+                                  &result);
+      run_loop.Run();
+      ASSERT_TRUE(result.entries.count(kHash));
+      load_elapsed_ms += timer.Elapsed().InMillisecondsF();
+    }
+
+    ASSERT_TRUE(base::EvictFileFromSystemCache(index_path));
+    {
+      base::ElapsedTimer timer;
+      std::unique_ptr<disk_cache::MappedIndexFile> mapped_index;
+      base::RunLoop run_loop;
+      index_file.MapIndexFile(
+          base::Time(),
+          base::BindOnce(
+              [](std::unique_ptr<disk_cache::MappedIndexFile>* out,
+                 base::OnceClosure done,
+                 std::unique_ptr<disk_cache::MappedIndexFile> result) {
+                *out = std::move(result);
+                std::move(done).Run();
+              },
+              &mapped_index, run_loop.QuitClosure()));
+      run_loop.Run();
+      ASSERT_TRUE(mapped_index);
+      ASSERT_TRUE(mapped_index->Lookup(kHash, nullptr));
+      map_elapsed_ms += timer.Elapsed().InMillisecondsF();
+    }
+  }
+
+  LOG(ERROR) << "Average time to the first lookup after loading "
+             << kLargeIndexEntries
+             << " entries:" << (load_elapsed_ms / kIterations) << "ms";
+  LOG(ERROR) << "Average time to the first lookup after mapping "
+             << kLargeIndexEntries
+             << " entries:" << (map_elapsed_ms / kIterations) << "ms";
+}
+
 }  // namespace
@@ -0,0 +1,931 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/disk_cache/memory/hot_tier_backend.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/callback_helpers.h"
+#include "base/hash.h"
+#include "base/logging.h"
+#include "base/metrics/histogram_macros.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/stringprintf.h"
+#include "base/trace_event/memory_usage_estimator.h"
+#include "base/trace_event/process_memory_dump.h"
+#include "net/base/io_buffer.h"
+#include "net/base/net_errors.h"
+
+namespace disk_cache {
+
+namespace {
+
+constexpr int kStreamCount = 3;
+
+// How many lookups the frequency sketch counts before halving its counters, so
+// that its estimates follow changes in popularity.
+constexpr int kSketchSampleSize = 40 * 1024;
+
+}  // namespace
+
+// The data of an entry held by the memory tier.
+struct HotTierBackend::HotObject : public base::RefCounted<HotObject> {
+  HotObject() = default;
+
+  int64_t size() const {
+    int64_t size = 0;
+    for (const std::string& stream : streams)
+      size += stream.size();
+    return size;
+  }
+
+  std::string streams[kStreamCount];
+  base::Time last_used;
+  base::Time last_modified;
+
+ private:
+  friend class base::RefCounted<HotObject>;
+  ~HotObject() = default;
+
+  DISALLOW_COPY_AND_ASSIGN(HotObject);
+};
+
+// A count-min sketch of how often keys were looked up recently, with 4-bit
+// saturating counters that are halved every kSketchSampleSize lookups.
+class HotTierBackend::FrequencySketch {
+ public:
+  FrequencySketch() { memset(counters_, 0, sizeof(counters_)); }
+
+  void Increment(const std::string& key) {
+    size_t indices[kDepth];
+    GetIndices(key, indices);
+    for (size_t row = 0; row < kDepth; ++row) {
+      if (counters_[row][indices[row]] < kMaxCount)
+        ++counters_[row][indices[row]];
+    }
+    if (++sample_count_ == kSketchSampleSize)
+      Halve();
+  }
+
+  int Estimate(const std::string& key) const {
+    size_t indices[kDepth];
+    GetIndices(key, indices);
+    int estimate = kMaxCount;
+    for (size_t row = 0; row < kDepth; ++row)
+      estimate = std::min<int>(estimate, counters_[row][indices[row]]);
+    return estimate;
+  }
+
+ private:
+  static constexpr size_t kDepth = 4;
+  static constexpr size_t kWidth = 4096;
+  static constexpr uint8_t kMaxCount = 15;
+
+  // Double hashing: the rows use independent enough functions of one hash.
+  void GetIndices(const std::string& key, size_t* indices) const {
+    const uint32_t hash = base::Hash(key);
+    const uint32_t step = ((hash * 0x85ebca6b) ^ (hash >> 13)) | 1;
+    for (size_t row = 0; row < kDepth; ++row)
+      indices[row] = (hash + row * step) % kWidth;
+  }
+
+  void Halve() {
+    for (size_t row = 0; row < kDepth; ++row) {
+      for (size_t i = 0; i < kWidth; ++i)
+        counters_[row][i] >>= 1;
+    }
+    sample_count_ /= 2;
+  }
+
+  uint8_t counters_[kDepth][kWidth];
+  int sample_count_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(FrequencySketch);
+};
+
+// The data read so far from an entry of the wrapped backend. A capture is
+// disabled, and stops growing, as soon as the entry can't be admitted.
+class HotTierBackend::Capture : public base::RefCounted<Capture> {
+ public:
+  explicit Capture(int max_size) : max_size_(max_size) {}
+
+  void Disable() {
+    enabled_ = false;
+    for (std::string& stream : streams_)
+      std::string().swap(stream);
+  }
+
+  // Records that |result| bytes were read at |offset| of stream |index| into
+  // |buf|. Only sequential reads can be captured.
+  void OnRead(int index, int offset, IOBuffer* buf, int result) {
+    if (!enabled_)
+      return;
+    if (result < 0 || index < 0 || index >= kStreamCount || offset < 0) {
+      Disable();
+      return;
+    }
+    std::string& stream = streams_[index];
+    const size_t end = static_cast<size_t>(offset) + result;
+    // Reading captured data again doesn't change anything.
+    if (end <= stream.size())
+      return;
+    if (static_cast<size_t>(offset) > stream.size() ||
+        size_ + (end - stream.size()) > static_cast<size_t>(max_size_)) {
+      Disable();
+      return;
+    }
+    size_ += end - stream.size();
+    stream.append(buf->data() + (stream.size() - offset), end - stream.size());
+  }
+
+  // Returns the captured data of |entry|, or null if not all of it was read.
+  scoped_refptr<HotObject> TakeObject(Entry* entry) {
+    if (!enabled_ || entry->CouldBeSparse())
+      return nullptr;
+    for (int i = 0; i < kStreamCount; ++i) {
+      if (static_cast<size_t>(entry->GetDataSize(i)) != streams_[i].size())
+        return nullptr;
+    }
+    auto object = base::MakeRefCounted<HotObject>();
+    for (int i = 0; i < kStreamCount; ++i)
+      object->streams[i].swap(streams_[i]);
+    object->last_used = entry->GetLastUsed();
+    object->last_modified = entry->GetLastModified();
+    enabled_ = false;
+    return object;
+  }
+
+  static void OnReadComplete(scoped_refptr<Capture> capture,
+                             int index,
+                             int offset,
+                             scoped_refptr<IOBuffer> buf,
+                             CompletionOnceCallback callback,
+                             int result) {
+    capture->OnRead(index, offset, buf.get(), result);
+    std::move(callback).Run(result);
+  }
+
+ private:
+  friend class base::RefCounted<Capture>;
+  ~Capture() = default;
+
+  const int max_size_;
+  bool enabled_ = true;
+  size_t size_ = 0;
+  std::string streams_[kStreamCount];
+
+  DISALLOW_COPY_AND_ASSIGN(Capture);
+};
+
+// An entry of the wrapped backend. Its reads are captured for admission to the
+// memory tier, and any change to it invalidates the memory tier.
+class HotTierBackend::CapturingEntry : public Entry {
+ public:
+  CapturingEntry(base::WeakPtr<HotTierBackend> backend,
+                 Entry* entry,
+                 int max_size)
+      : backend_(std::move(backend)),
+        entry_(entry),
+        key_(entry->GetKey()),
+        capture_(base::MakeRefCounted<Capture>(max_size)) {
+    backend_->captures_.emplace(key_, capture_.get());
+  }
+
+  // Entry implementation.
+  void Doom() override {
+    Invalidate();
+    entry_->Doom();
+  }
+
+  void Close() override {
+    if (backend_) {
+      auto range = backend_->captures_.equal_range(key_);
+      for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == capture_.get()) {
+          backend_->captures_.erase(it);
+          break;
+        }
+      }
+      scoped_refptr<HotObject> object = capture_->TakeObject(entry_);
+      if (object)
+        backend_->Admit(key_, std::move(object));
+    }
+    entry_->Close();
+    delete this;
+  }
+
+  std::string GetKey() const override { return key_; }
+  base::Time GetLastUsed() const override { return entry_->GetLastUsed(); }
+  base::Time GetLastModified() const override {
+    return entry_->GetLastModified();
+  }
+  int32_t GetDataSize(int index) const override {
+    return entry_->GetDataSize(index);
+  }
+
+  int ReadData(int index,
+               int offset,
+               IOBuffer* buf,
+               int buf_len,
+               CompletionOnceCallback callback) override {
+    int rv = entry_->ReadData(
+        index, offset, buf, buf_len,
+        base::BindOnce(&Capture::OnReadComplete, capture_, index, offset,
+                       base::WrapRefCounted(buf), std::move(callback)));
+    if (rv != net::ERR_IO_PENDING)
+      capture_->OnRead(index, offset, buf, rv);
+    return rv;
+  }
+
+  int WriteData(int index,
+                int offset,
+                IOBuffer* buf,
+                int buf_len,
+                CompletionOnceCallback callback,
+                bool truncate) override {
+    Invalidate();
+    return entry_->WriteData(index, offset, buf, buf_len, std::move(callback),
+                             truncate);
+  }
+
+  int ReadSparseData(int64_t offset,
+                     IOBuffer* buf,
+                     int buf_len,
+                     CompletionOnceCallback callback) override {
+    capture_->Disable();
+    return entry_->ReadSparseData(offset, buf, buf_len, std::move(callback));
+  }
+
+  int WriteSparseData(int64_t offset,
+                      IOBuffer* buf,
+                      int buf_len,
+                      CompletionOnceCallback callback) override {
+    Invalidate();
+    return entry_->WriteSparseData(offset, buf, buf_len, std::move(callback));
+  }
+
+  int GetAvailableRange(int64_t offset,
+                        int len,
+                        int64_t* start,
+                        CompletionOnceCallback callback) override {
+    return entry_->GetAvailableRange(offset, len, start, std::move(callback));
+  }
+
+  bool CouldBeSparse() const override { return entry_->CouldBeSparse(); }
+  void CancelSparseIO() override { entry_->CancelSparseIO(); }
+  net::Error ReadyForSparseIO(CompletionOnceCallback callback) override {
+    return entry_->ReadyForSparseIO(std::move(callback));
+  }
+
+  void SetLastUsedTimeForTest(base::Time time) override {
+    entry_->SetLastUsedTimeForTest(time);
+  }
+
+ private:
+  ~CapturingEntry() override = default;
+
+  // Drops the entry from the memory tier. This also disables |capture_|.
+  void Invalidate() {
+    capture_->Disable();
+    if (backend_)
+      backend_->Invalidate(key_);
+  }
+
+  base::WeakPtr<HotTierBackend> backend_;
+  Entry* const entry_;
+  const std::string key_;
+  const scoped_refptr<Capture> capture_;
+
+  DISALLOW_COPY_AND_ASSIGN(CapturingEntry);
+};
+
+// An entry opened from the memory tier. Reads are served from memory; the
+// first operation that needs the wrapped backend, like a write, opens the
+// entry there and is run on it, together with every later operation.
+class HotTierBackend::HotEntry : public Entry {
+ public:
+  HotEntry(base::WeakPtr<HotTierBackend> backend,
+           const std::string& key,
+           net::RequestPriority priority,
+           scoped_refptr<const HotObject> object)
+      : backend_(std::move(backend)),
+        key_(key),
+        priority_(priority),
+        object_(std::move(object)),
+        weak_factory_(this) {}
+
+  // Entry implementation.
+  void Doom() override {
+    Invalidate();
+    RunOnWrappedEntry(base::BindOnce([](Entry* entry,
+                                        CompletionOnceCallback callback) {
+                        entry->Doom();
+                        return static_cast<int>(net::OK);
+                      }),
+                      CompletionOnceCallback());
+  }
+
+  void Close() override {
+    closed_ = true;
+    // Pending operations still run, and close the entry when they're done.
+    if (state_ == State::kOpening || running_pending_operations_)
+      return;
+    CloseNow();
+  }
+
+  std::string GetKey() const override { return key_; }
+
+  base::Time GetLastUsed() const override {
+    return state_ == State::kOpen ? wrapped_entry_->GetLastUsed()
+                                  : object_->last_used;
+  }
+
+  base::Time GetLastModified() const override {
+    return state_ == State::kOpen ? wrapped_entry_->GetLastModified()
+                                  : object_->last_modified;
+  }
+
+  int32_t GetDataSize(int index) const override {
+    if (state_ == State::kOpen)
+      return wrapped_entry_->GetDataSize(index);
+    if (index < 0 || index >= kStreamCount)
+      return 0;
+    return object_->streams[index].size();
+  }
+
+  int ReadData(int index,
+               int offset,
+               IOBuffer* buf,
+               int buf_len,
+               CompletionOnceCallback callback) override {
+    if (state_ != State::kInMemory) {
+      return RunOnWrappedEntry(
+          base::BindOnce(
+              [](int index, int offset, scoped_refptr<IOBuffer> buf,
+                 int buf_len, Entry* entry, CompletionOnceCallback callback) {
+                return entry->ReadData(index, offset, buf.get(), buf_len,
+                                       std::move(callback));
+              },
+              index, offset, base::WrapRefCounted(buf), buf_len),
+          std::move(callback));
+    }
+
+    if (index < 0 || index >= kStreamCount || buf_len < 0)
+      return net::ERR_INVALID_ARGUMENT;
+    const std::string& stream = object_->streams[index];
+    if (offset < 0 || static_cast<size_t>(offset) >= stream.size())
+      return 0;
+    const int bytes =
+        std::min(static_cast<size_t>(buf_len), stream.size() - offset);
+    memcpy(buf->data(), stream.data() + offset, bytes);
+    return bytes;
+  }
+
+  int WriteData(int index,
+                int offset,
+                IOBuffer* buf,
+                int buf_len,
+                CompletionOnceCallback callback,
+                bool truncate) override {
+    Invalidate();
+    return RunOnWrappedEntry(
+        base::BindOnce(
+            [](int index, int offset, scoped_refptr<IOBuffer> buf, int buf_len,
+               bool truncate, Entry* entry, CompletionOnceCallback callback) {
+              return entry->WriteData(index, offset, buf.get(), buf_len,
+                                      std::move(callback), truncate);
+            },
+            index, offset, base::WrapRefCounted(buf), buf_len, truncate),
+        std::move(callback));
+  }
+
+  int ReadSparseData(int64_t offset,
+                     IOBuffer* buf,
+                     int buf_len,
+                     CompletionOnceCallback callback) override {
+    return RunOnWrappedEntry(
+        base::BindOnce(
+            [](int64_t offset, scoped_refptr<IOBuffer> buf, int buf_len,
+               Entry* entry, CompletionOnceCallback callback) {
+              return entry->ReadSparseData(offset, buf.get(), buf_len,
+                                           std::move(callback));
+            },
+            offset, base::WrapRefCounted(buf), buf_len),
+        std::move(callback));
+  }
+
+  int WriteSparseData(int64_t offset,
+                      IOBuffer* buf,
+                      int buf_len,
+                      CompletionOnceCallback callback) override {
+    Invalidate();
+    return RunOnWrappedEntry(
+        base::BindOnce(
+            [](int64_t offset, scoped_refptr<IOBuffer> buf, int buf_len,
+               Entry* entry, CompletionOnceCallback callback) {
+              return entry->WriteSparseData(offset, buf.get(), buf_len,
+                                            std::move(callback));
+            },
+            offset, base::WrapRefCounted(buf), buf_len),
+        std::move(callback));
+  }
+
+  int GetAvailableRange(int64_t offset,
+                        int len,
+                        int64_t* start,
+                        CompletionOnceCallback callback) override {
+    return RunOnWrappedEntry(
+        base::BindOnce(
+            [](int64_t offset, int len, int64_t* start, Entry* entry,
+               CompletionOnceCallback callback) {
+              return entry->GetAvailableRange(offset, len, start,
+                                              std::move(callback));
+            },
+            offset, len, start),
+        std::move(callback));
+  }
+
+  // Only entries that weren't sparse are admitted.
+  bool CouldBeSparse() const override {
+    return state_ == State::kOpen && wrapped_entry_->CouldBeSparse();
+  }
+
+  void CancelSparseIO() override {
+    if (state_ == State::kOpen)
+      wrapped_entry_->CancelSparseIO();
+  }
+
+  net::Error ReadyForSparseIO(CompletionOnceCallback callback) override {
+    if (state_ != State::kOpen)
+      return net::OK;
+    return wrapped_entry_->ReadyForSparseIO(std::move(callback));
+  }
+
+  void SetLastUsedTimeForTest(base::Time time) override {
+    RunOnWrappedEntry(base::BindOnce(
+                          [](base::Time time, Entry* entry,
+                             CompletionOnceCallback callback) {
+                            entry->SetLastUsedTimeForTest(time);
+                            return static_cast<int>(net::OK);
+                          },
+                          time),
+                      CompletionOnceCallback());
+  }
+
+ private:
+  enum class State {
+    kInMemory,
+    kOpening,
+    kOpen,
+    kFailed,
+  };
+
+  // An operation on the wrapped entry. It returns its result, or
+  // ERR_IO_PENDING to pass it to the callback later.
+  using EntryOperation =
+      base::OnceCallback<int(Entry* entry, CompletionOnceCallback callback)>;
+
+  ~HotEntry() override = default;
+
+  void Invalidate() {
+    if (backend_)
+      backend_->Invalidate(key_);
+  }
+
+  // Runs |operation| on the wrapped entry, opening it first if needed. If the
+  // open doesn't complete synchronously, |operation| is queued after it, and
+  // this returns ERR_IO_PENDING.
+  int RunOnWrappedEntry(EntryOperation operation,
+                        CompletionOnceCallback callback) {
+    if (state_ == State::kInMemory)
+      OpenWrappedEntry();
+    switch (state_) {
+      case State::kInMemory:
+        NOTREACHED();
+        return net::ERR_FAILED;
+      case State::kOpening:
+        pending_operations_.push_back(base::BindOnce(
+            &HotEntry::RunPendingOperation, base::Unretained(this),
+            std::move(operation), std::move(callback)));
+        return net::ERR_IO_PENDING;
+      case State::kOpen:
+        return std::move(operation).Run(wrapped_entry_, std::move(callback));
+      case State::kFailed:
+        return net::ERR_FAILED;
+    }
+    NOTREACHED();
+    return net::ERR_FAILED;
+  }
+
+  void RunPendingOperation(EntryOperation operation,
+                           CompletionOnceCallback callback) {
+    if (!callback) {
+      if (state_ == State::kOpen)
+        std::move(operation).Run(wrapped_entry_, CompletionOnceCallback());
+      return;
+    }
+    if (state_ != State::kOpen) {
+      std::move(callback).Run(net::ERR_FAILED);
+      return;
+    }
+    // The caller already got ERR_IO_PENDING, so a synchronous result goes to
+    // the callback too.
+    net::CompletionRepeatingCallback repeating_callback =
+        base::AdaptCallbackForRepeating(std::move(callback));
+    int rv = std::move(operation).Run(wrapped_entry_, repeating_callback);
+    if (rv != net::ERR_IO_PENDING)
+      repeating_callback.Run(rv);
+  }
+
+  void OpenWrappedEntry() {
+    if (!backend_) {
+      state_ = State::kFailed;
+      return;
+    }
+    state_ = State::kOpening;
+    net::Error rv = backend_->backend_->OpenEntry(
+        key_, priority_, &wrapped_entry_,
+        base::BindOnce(&HotEntry::OnWrappedEntryOpened,
+                       weak_factory_.GetWeakPtr()));
+    if (rv != net::ERR_IO_PENDING)
+      OnWrappedEntryOpened(rv);
+  }
+
+  void OnWrappedEntryOpened(int result) {
+    state_ = result == net::OK ? State::kOpen : State::kFailed;
+    running_pending_operations_ = true;
+    std::vector<base::OnceClosure> operations;
+    operations.swap(pending_operations_);
+    for (base::OnceClosure& operation : operations)
+      std::move(operation).Run();
+    running_pending_operations_ = false;
+    if (closed_)
+      CloseNow();
+  }
+
+  void CloseNow() {
+    if (wrapped_entry_)
+      wrapped_entry_->Close();
+    delete this;
+  }
+
+  base::WeakPtr<HotTierBackend> backend_;
+  const std::string key_;
+  const net::RequestPriority priority_;
+  const scoped_refptr<const HotObject> object_;
+
+  State state_ = State::kInMemory;
+  Entry* wrapped_entry_ = nullptr;
+  std::vector<base::OnceClosure> pending_operations_;
+  bool running_pending_operations_ = false;
+  bool closed_ = false;
+
+  base::WeakPtrFactory<HotEntry> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(HotEntry);
+};
+
+// Wraps the entries opened by an iterator of the wrapped backend.
+class HotTierBackend::WrappingIterator : public Backend::Iterator {
+ public:
+  WrappingIterator(base::WeakPtr<HotTierBackend> backend,
+                   std::unique_ptr<Backend::Iterator> iterator)
+      : backend_(std::move(backend)), iterator_(std::move(iterator)) {}
+  ~WrappingIterator() override = default;
+
+  net::Error OpenNextEntry(Entry** next_entry,
+                           CompletionOnceCallback callback) override {
+    net::Error rv = iterator_->OpenNextEntry(
+        next_entry,
+        base::BindOnce(&HotTierBackend::OnOpenComplete, backend_,
+                       base::TimeTicks(), next_entry, std::move(callback)));
+    if (rv != net::ERR_IO_PENDING && backend_)
+      backend_->FinishOpen(base::TimeTicks(), next_entry, rv);
+    return rv;
+  }
+
+ private:
+  base::WeakPtr<HotTierBackend> backend_;
+  std::unique_ptr<Backend::Iterator> iterator_;
+
+  DISALLOW_COPY_AND_ASSIGN(WrappingIterator);
+};
+
+HotTierBackend::HotTierBackend(std::unique_ptr<Backend> backend,
+                               int64_t max_bytes,
+                               int max_entry_size)
+    : backend_(std::move(backend)),
+      max_bytes_(max_bytes),
+      max_entry_size_(max_entry_size),
+      hot_entries_(HotEntryMap::NO_AUTO_EVICT),
+      sketch_(std::make_unique<FrequencySketch>()),
+      memory_pressure_listener_(
+          base::BindRepeating(&HotTierBackend::OnMemoryPressure,
+                              base::Unretained(this))),
+      weak_factory_(this) {}
+
+HotTierBackend::~HotTierBackend() = default;
+
+net::CacheType HotTierBackend::GetCacheType() const {
+  return backend_->GetCacheType();
+}
+
+int32_t HotTierBackend::GetEntryCount() const {
+  return backend_->GetEntryCount();
+}
+
+net::Error HotTierBackend::OpenOrCreateEntry(const std::string& key,
+                                             net::RequestPriority priority,
+                                             EntryWithOpened* entry_struct,
+                                             CompletionOnceCallback callback) {
+  const base::TimeTicks start_time = base::TimeTicks::Now();
+  scoped_refptr<const HotObject> object = Lookup(key);
+  if (object) {
+    entry_struct->entry = new HotEntry(weak_factory_.GetWeakPtr(), key,
+                                       priority, std::move(object));
+    entry_struct->opened = true;
+    UMA_HISTOGRAM_CUSTOM_MICROSECONDS_TIMES(
+        "HttpCache.HotTier.OpenLatency.Hit",
+        base::TimeTicks::Now() - start_time,
+        base::TimeDelta::FromMicroseconds(1), base::TimeDelta::FromSeconds(1),
+        50);
+    return net::OK;
+  }
+
+  net::Error rv = backend_->OpenOrCreateEntry(
+      key, priority, entry_struct,
+      base::BindOnce(&HotTierBackend::OnOpenComplete,
+                     weak_factory_.GetWeakPtr(), start_time,
+                     &entry_struct->entry, std::move(callback)));
+  if (rv != net::ERR_IO_PENDING)
+    FinishOpen(start_time, &entry_struct->entry, rv);
+  return rv;
+}
+
+net::Error HotTierBackend::OpenEntry(const std::string& key,
+                                     net::RequestPriority priority,
+                                     Entry** entry,
+                                     CompletionOnceCallback callback) {
+  const base::TimeTicks start_time = base::TimeTicks::Now();
+  scoped_refptr<const HotObject> object = Lookup(key);
+  if (object) {
+    *entry = new HotEntry(weak_factory_.GetWeakPtr(), key, priority,
+                          std::move(object));
+    UMA_HISTOGRAM_CUSTOM_MICROSECONDS_TIMES(
+        "HttpCache.HotTier.OpenLatency.Hit",
+        base::TimeTicks::Now() - start_time,
+        base::TimeDelta::FromMicroseconds(1), base::TimeDelta::FromSeconds(1),
+        50);
+    return net::OK;
+  }
+
+  net::Error rv = backend_->OpenEntry(
+      key, priority, entry,
+      base::BindOnce(&HotTierBackend::OnOpenComplete,
+                     weak_factory_.GetWeakPtr(), start_time, entry,
+                     std::move(callback)));
+  if (rv != net::ERR_IO_PENDING)
+    FinishOpen(start_time, entry, rv);
+  return rv;
+}
+
+net::Error HotTierBackend::CreateEntry(const std::string& key,
+                                       net::RequestPriority priority,
+                                       Entry** entry,
+                                       CompletionOnceCallback callback) {
+  Invalidate(key);
+  net::Error rv = backend_->CreateEntry(
+      key, priority, entry,
+      base::BindOnce(&HotTierBackend::OnOpenComplete,
+                     weak_factory_.GetWeakPtr(), base::TimeTicks(), entry,
+                     std::move(callback)));
+  if (rv != net::ERR_IO_PENDING)
+    FinishOpen(base::TimeTicks(), entry, rv);
+  return rv;
+}
+
+net::Error HotTierBackend::DoomEntry(const std::string& key,
+                                     net::RequestPriority priority,
+                                     CompletionOnceCallback callback) {
+  Invalidate(key);
+  return backend_->DoomEntry(key, priority, std::move(callback));
+}
+
+net::Error HotTierBackend::DoomAllEntries(CompletionOnceCallback callback) {
+  InvalidateAll();
+  return backend_->DoomAllEntries(std::move(callback));
+}
+
+net::Error HotTierBackend::DoomEntriesBetween(base::Time initial_time,
+                                              base::Time end_time,
+                                              CompletionOnceCallback callback) {
+  InvalidateAll();
+  return backend_->DoomEntriesBetween(initial_time, end_time,
+                                      std::move(callback));
+}
+
+net::Error HotTierBackend::DoomEntriesSince(base::Time initial_time,
+                                            CompletionOnceCallback callback) {
+  InvalidateAll();
+  return backend_->DoomEntriesSince(initial_time, std::move(callback));
+}
+
+int64_t HotTierBackend::CalculateSizeOfAllEntries(
+    Int64CompletionOnceCallback callback) {
+  return backend_->CalculateSizeOfAllEntries(std::move(callback));
+}
+
+int64_t HotTierBackend::CalculateSizeOfEntriesBetween(
+    base::Time initial_time,
+    base::Time end_time,
+    Int64CompletionOnceCallback callback) {
+  return backend_->CalculateSizeOfEntriesBetween(initial_time, end_time,
+                                                 std::move(callback));
+}
+
+std::unique_ptr<Backend::Iterator> HotTierBackend::CreateIterator() {
+  return std::make_unique<WrappingIterator>(weak_factory_.GetWeakPtr(),
+                                            backend_->CreateIterator());
+}
+
+void HotTierBackend::GetStats(base::StringPairs* stats) {
+  backend_->GetStats(stats);
+
+  std::pair<std::string, std::string> item;
+  item.first = "Hot tier lookups";
+  item.second = base::NumberToString(lookup_count_);
+  stats->push_back(item);
+
+  item.first = "Hot tier hits";
+  item.second = base::NumberToString(hit_count_);
+  stats->push_back(item);
+
+  item.first = "Hot tier hit ratio";
+  item.second = base::StringPrintf(
+      "%.3f",
+      lookup_count_ ? static_cast<double>(hit_count_) / lookup_count_ : 0.0);
+  stats->push_back(item);
+
+  item.first = "Hot tier size";
+  item.second = base::NumberToString(hot_size_);
+  stats->push_back(item);
+}
+
+void HotTierBackend::OnExternalCacheHit(const std::string& key) {
+  backend_->OnExternalCacheHit(key);
+}
+
+size_t HotTierBackend::DumpMemoryStats(
+    base::trace_event::ProcessMemoryDump* pmd,
+    const std::string& parent_absolute_name) const {
+  base::trace_event::MemoryAllocatorDump* dump =
+      pmd->CreateAllocatorDump(parent_absolute_name + "/hot_tier_backend");
+  size_t size = sizeof(FrequencySketch) + hot_size_ +
+                base::trace_event::EstimateMemoryUsage(captures_);
+  for (const auto& hot_entry : hot_entries_)
+    size += base::trace_event::EstimateMemoryUsage(hot_entry.first);
+  dump->AddScalar(base::trace_event::MemoryAllocatorDump::kNameSize,
+                  base::trace_event::MemoryAllocatorDump::kUnitsBytes, size);
+  dump->AddScalar("hot_tier_max_size",
+                  base::trace_event::MemoryAllocatorDump::kUnitsBytes,
+                  max_bytes_);
+  return size + backend_->DumpMemoryStats(pmd, parent_absolute_name);
+}
+
+uint8_t HotTierBackend::GetEntryInMemoryData(const std::string& key) {
+  return backend_->GetEntryInMemoryData(key);
+}
+
+void HotTierBackend::SetEntryInMemoryData(const std::string& key,
+                                          uint8_t data) {
+  backend_->SetEntryInMemoryData(key, data);
+}
+
+int64_t HotTierBackend::MaxFileSize() const {
+  return backend_->MaxFileSize();
+}
+
+scoped_refptr<const HotTierBackend::HotObject> HotTierBackend::Lookup(
+    const std::string& key) {
+  ++lookup_count_;
+  sketch_->Increment(key);
+  auto it = hot_entries_.Get(key);
+  const bool hit = it != hot_entries_.end();
+  UMA_HISTOGRAM_BOOLEAN("HttpCache.HotTier.Hit", hit);
+  if (!hit)
+    return nullptr;
+  ++hit_count_;
+  // Keep the eviction order of the wrapped backend up to date.
+  backend_->OnExternalCacheHit(key);
+  return it->second;
+}
+
+void HotTierBackend::Admit(const std::string& key,
+                           scoped_refptr<HotObject> object) {
+  const int64_t size = object->size();
+  if (size > max_entry_size_ || size > max_bytes_)
+    return;
+
+  // Only make room by evicting entries that were used less often. An existing
+  // entry for |key| is replaced, so its space counts as free.
+  auto existing = hot_entries_.Peek(key);
+  const int frequency = sketch_->Estimate(key);
+  int64_t freed =
+      existing != hot_entries_.end() ? existing->second->size() : 0;
+  for (auto it = hot_entries_.rbegin();
+       hot_size_ - freed + size > max_bytes_ && it != hot_entries_.rend();
+       ++it) {
+    if (it->first == key)
+      continue;
+    if (sketch_->Estimate(it->first) >= frequency)
+      return;
+    freed += it->second->size();
+  }
+
+  if (existing != hot_entries_.end()) {
+    hot_size_ -= existing->second->size();
+    hot_entries_.Erase(existing);
+  }
+  EvictTill(max_bytes_ - size);
+
+  hot_size_ += size;
+  hot_entries_.Put(key, std::move(object));
+}
+
+void HotTierBackend::Invalidate(const std::string& key) {
+  auto it = hot_entries_.Peek(key);
+  if (it != hot_entries_.end()) {
+    hot_size_ -= it->second->size();
+    hot_entries_.Erase(it);
+  }
+  auto range = captures_.equal_range(key);
+  for (auto capture = range.first; capture != range.second; ++capture)
+    capture->second->Disable();
+}
+
+void HotTierBackend::InvalidateAll() {
+  hot_entries_.Clear();
+  hot_size_ = 0;
+  for (auto& capture : captures_)
+    capture.second->Disable();
+}
+
+void HotTierBackend::EvictTill(int64_t target_size) {
+  while (hot_size_ > target_size && !hot_entries_.empty()) {
+    auto victim = hot_entries_.rbegin();
+    hot_size_ -= victim->second->size();
+    hot_entries_.Erase(victim);
+  }
+}
+
+void HotTierBackend::WrapEntry(Entry** entry) {
+  *entry = new CapturingEntry(weak_factory_.GetWeakPtr(), *entry,
+                              max_entry_size_);
+}
+
+void HotTierBackend::FinishOpen(base::TimeTicks start_time,
+                                Entry** entry,
+                                int result) {
+  if (!start_time.is_null()) {
+    UMA_HISTOGRAM_CUSTOM_MICROSECONDS_TIMES(
+        "HttpCache.HotTier.OpenLatency.Miss",
+        base::TimeTicks::Now() - start_time,
+        base::TimeDelta::FromMicroseconds(1), base::TimeDelta::FromSeconds(1),
+        50);
+  }
+  if (result == net::OK)
+    WrapEntry(entry);
+}
+
+// static
+void HotTierBackend::OnOpenComplete(base::WeakPtr<HotTierBackend> backend,
+                                    base::TimeTicks start_time,
+                                    Entry** entry,
+                                    CompletionOnceCallback callback,
+                                    int result) {
+  if (backend)
+    backend->FinishOpen(start_time, entry, result);
+  std::move(callback).Run(result);
+}
+
+void HotTierBackend::OnMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level) {
+  switch (memory_pressure_level) {
+    case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE:
+      break;
+    case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE:
+      EvictTill(max_bytes_ / 2);
+      break;
+    case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL:
+      EvictTill(0);
+      break;
+  }
+}
+
+}  // namespace disk_cache
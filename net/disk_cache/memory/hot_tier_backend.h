@@ -0,0 +1,159 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_DISK_CACHE_MEMORY_HOT_TIER_BACKEND_H_
+#define NET_DISK_CACHE_MEMORY_HOT_TIER_BACKEND_H_
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "base/containers/mru_cache.h"
+#include "base/macros.h"
+#include "base/memory/memory_pressure_listener.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "net/base/net_export.h"
+#include "net/disk_cache/disk_cache.h"
+
+namespace disk_cache {
+
+// A Backend that keeps small, frequently used entries of another backend in
+// memory, and opens them without going through it. The HttpCache puts it in
+// front of its disk backend, so that hits on hot resources don't wait for the
+// disk. Since the wrapping is below the HttpCache, its transactions and shared
+// writers see the usual Backend and Entry semantics.
+//
+// The memory tier is a read cache: every entry it holds is also stored by the
+// wrapped backend. Entries are admitted when they are closed after all their
+// streams were read, if those fit in |max_entry_size| bytes. Any change to an
+// entry, and any doom, goes to the wrapped backend and drops the entry from the
+// memory tier; entries opened from the memory tier open the wrapped entry the
+// first time they need it.
+//
+// The memory tier holds up to |max_bytes| bytes, in LRU order. Admission is
+// TinyLFU-style: a sketch estimates how often each key was opened recently,
+// and a new entry only replaces the least recently used ones if it was opened
+// more often than them, so that a scan of one-off entries doesn't flush the
+// hot ones.
+class NET_EXPORT_PRIVATE HotTierBackend final : public Backend {
+ public:
+  HotTierBackend(std::unique_ptr<Backend> backend,
+                 int64_t max_bytes,
+                 int max_entry_size);
+  ~HotTierBackend() override;
+
+  // The number of entries in the memory tier, and their total size.
+  size_t hot_entry_count() const { return hot_entries_.size(); }
+  int64_t hot_size() const { return hot_size_; }
+
+  // Backend implementation.
+  net::CacheType GetCacheType() const override;
+  int32_t GetEntryCount() const override;
+  net::Error OpenOrCreateEntry(const std::string& key,
+                               net::RequestPriority priority,
+                               EntryWithOpened* entry_struct,
+                               CompletionOnceCallback callback) override;
+  net::Error OpenEntry(const std::string& key,
+                       net::RequestPriority priority,
+                       Entry** entry,
+                       CompletionOnceCallback callback) override;
+  net::Error CreateEntry(const std::string& key,
+                         net::RequestPriority priority,
+                         Entry** entry,
+                         CompletionOnceCallback callback) override;
+  net::Error DoomEntry(const std::string& key,
+                       net::RequestPriority priority,
+                       CompletionOnceCallback callback) override;
+  net::Error DoomAllEntries(CompletionOnceCallback callback) override;
+  net::Error DoomEntriesBetween(base::Time initial_time,
+                                base::Time end_time,
+                                CompletionOnceCallback callback) override;
+  net::Error DoomEntriesSince(base::Time initial_time,
+                              CompletionOnceCallback callback) override;
+  int64_t CalculateSizeOfAllEntries(
+      Int64CompletionOnceCallback callback) override;
+  int64_t CalculateSizeOfEntriesBetween(
+      base::Time initial_time,
+      base::Time end_time,
+      Int64CompletionOnceCallback callback) override;
+  std::unique_ptr<Iterator> CreateIterator() override;
+  void GetStats(base::StringPairs* stats) override;
+  void OnExternalCacheHit(const std::string& key) override;
+  size_t DumpMemoryStats(
+      base::trace_event::ProcessMemoryDump* pmd,
+      const std::string& parent_absolute_name) const override;
+  uint8_t GetEntryInMemoryData(const std::string& key) override;
+  void SetEntryInMemoryData(const std::string& key, uint8_t data) override;
+  int64_t MaxFileSize() const override;
+
+ private:
+  class Capture;
+  class CapturingEntry;
+  class FrequencySketch;
+  class HotEntry;
+  class WrappingIterator;
+  struct HotObject;
+
+  using HotEntryMap = base::MRUCache<std::string, scoped_refptr<HotObject>>;
+
+  // Returns the entry for |key| in the memory tier, or null.
+  scoped_refptr<const HotObject> Lookup(const std::string& key);
+
+  // Adds the data captured from an entry to the memory tier, if there's room.
+  void Admit(const std::string& key, scoped_refptr<HotObject> object);
+
+  // Drops |key| from the memory tier, and stops the open entries of |key| from
+  // being admitted.
+  void Invalidate(const std::string& key);
+
+  // Drops everything from the memory tier.
+  void InvalidateAll();
+
+  // Drops the least recently used entries until the memory tier holds at most
+  // |target_size| bytes.
+  void EvictTill(int64_t target_size);
+
+  // Wraps |*entry| so that the memory tier learns about its reads and writes.
+  void WrapEntry(Entry** entry);
+
+  // Completes an operation of the wrapped backend that returned |*entry|.
+  // Records the latency of a miss if |start_time| isn't null.
+  void FinishOpen(base::TimeTicks start_time, Entry** entry, int result);
+  static void OnOpenComplete(base::WeakPtr<HotTierBackend> backend,
+                             base::TimeTicks start_time,
+                             Entry** entry,
+                             CompletionOnceCallback callback,
+                             int result);
+
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level);
+
+  const std::unique_ptr<Backend> backend_;
+  const int64_t max_bytes_;
+  const int max_entry_size_;
+
+  HotEntryMap hot_entries_;
+  int64_t hot_size_ = 0;
+  std::unique_ptr<FrequencySketch> sketch_;
+
+  // The captures of the open entries, by key.
+  std::unordered_multimap<std::string, Capture*> captures_;
+
+  int64_t lookup_count_ = 0;
+  int64_t hit_count_ = 0;
+
+  base::MemoryPressureListener memory_pressure_listener_;
+
+  base::WeakPtrFactory<HotTierBackend> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(HotTierBackend);
+};
+
+}  // namespace disk_cache
+
+#endif  // NET_DISK_CACHE_MEMORY_HOT_TIER_BACKEND_H_
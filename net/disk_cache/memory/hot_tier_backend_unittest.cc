@@ -0,0 +1,214 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/disk_cache/memory/hot_tier_backend.h"
+
+#include <memory>
+#include <string>
+
+#include "base/strings/string_split.h"
+#include "net/base/io_buffer.h"
+#include "net/base/net_errors.h"
+#include "net/base/test_completion_callback.h"
+#include "net/disk_cache/memory/mem_backend_impl.h"
+#include "net/test/test_with_scoped_task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace disk_cache {
+
+namespace {
+
+constexpr int kMaxEntrySize = 1024;
+
+class HotTierBackendTest : public net::TestWithScopedTaskEnvironment {
+ protected:
+  void CreateBackend(int64_t max_bytes) {
+    backend_ = std::make_unique<HotTierBackend>(
+        MemBackendImpl::CreateBackend(1024 * 1024, nullptr), max_bytes,
+        kMaxEntrySize);
+  }
+
+  Entry* OpenEntry(const std::string& key) {
+    Entry* entry = nullptr;
+    net::TestCompletionCallback callback;
+    int rv = backend_->OpenEntry(key, net::HIGHEST, &entry,
+                                 callback.callback());
+    return callback.GetResult(rv) == net::OK ? entry : nullptr;
+  }
+
+  void WriteEntry(const std::string& key,
+                  const std::string& headers,
+                  const std::string& body) {
+    Entry* entry = nullptr;
+    net::TestCompletionCallback callback;
+    int rv = backend_->CreateEntry(key, net::HIGHEST, &entry,
+                                   callback.callback());
+    ASSERT_EQ(net::OK, callback.GetResult(rv));
+    WriteStream(entry, 0, headers);
+    WriteStream(entry, 1, body);
+    entry->Close();
+  }
+
+  void WriteStream(Entry* entry, int index, const std::string& data) {
+    auto buf = base::MakeRefCounted<net::StringIOBuffer>(data);
+    net::TestCompletionCallback callback;
+    int rv = entry->WriteData(index, 0, buf.get(), data.size(),
+                              callback.callback(), true);
+    EXPECT_EQ(static_cast<int>(data.size()), callback.GetResult(rv));
+  }
+
+  // Reads |length| bytes of stream |index| in chunks of |chunk_size|.
+  std::string ReadStream(Entry* entry, int index, int length, int chunk_size) {
+    std::string data;
+    while (static_cast<int>(data.size()) < length) {
+      auto buf = base::MakeRefCounted<net::IOBuffer>(chunk_size);
+      net::TestCompletionCallback callback;
+      int rv = entry->ReadData(index, data.size(), buf.get(), chunk_size,
+                               callback.callback());
+      rv = callback.GetResult(rv);
+      if (rv <= 0)
+        break;
+      data.append(buf->data(), rv);
+    }
+    return data;
+  }
+
+  // Opens |key| and reads all of it, which admits it to the memory tier if
+  // there's room.
+  void OpenAndReadEntry(const std::string& key) {
+    Entry* entry = OpenEntry(key);
+    ASSERT_TRUE(entry);
+    ReadStream(entry, 0, entry->GetDataSize(0), 7);
+    ReadStream(entry, 1, entry->GetDataSize(1), 7);
+    entry->Close();
+  }
+
+  std::string GetStat(const std::string& name) {
+    base::StringPairs stats;
+    backend_->GetStats(&stats);
+    for (const auto& stat : stats) {
+      if (stat.first == name)
+        return stat.second;
+    }
+    return std::string();
+  }
+
+  std::unique_ptr<HotTierBackend> backend_;
+};
+
+}  // namespace
+
+TEST_F(HotTierBackendTest, AdmitsEntriesReadInFull) {
+  CreateBackend(64 * 1024);
+  WriteEntry("key", "headers", "the body of the entry");
+  EXPECT_EQ(0u, backend_->hot_entry_count());
+
+  OpenAndReadEntry("key");
+  EXPECT_EQ(1u, backend_->hot_entry_count());
+  EXPECT_EQ(28, backend_->hot_size());
+  EXPECT_EQ("0", GetStat("Hot tier hits"));
+
+  Entry* entry = OpenEntry("key");
+  ASSERT_TRUE(entry);
+  EXPECT_EQ("1", GetStat("Hot tier hits"));
+  EXPECT_EQ("key", entry->GetKey());
+  EXPECT_EQ(7, entry->GetDataSize(0));
+  EXPECT_EQ("headers", ReadStream(entry, 0, 7, 100));
+  EXPECT_EQ("the body of the entry", ReadStream(entry, 1, 21, 4));
+  entry->Close();
+}
+
+TEST_F(HotTierBackendTest, PartialReadsAreNotAdmitted) {
+  CreateBackend(64 * 1024);
+  WriteEntry("key", "headers", "the body of the entry");
+
+  Entry* entry = OpenEntry("key");
+  ASSERT_TRUE(entry);
+  ReadStream(entry, 0, 7, 7);
+  ReadStream(entry, 1, 4, 4);
+  entry->Close();
+  EXPECT_EQ(0u, backend_->hot_entry_count());
+}
+
+TEST_F(HotTierBackendTest, LargeEntriesAreNotAdmitted) {
+  CreateBackend(64 * 1024);
+  WriteEntry("key", "headers", std::string(kMaxEntrySize, 'a'));
+
+  OpenAndReadEntry("key");
+  EXPECT_EQ(0u, backend_->hot_entry_count());
+}
+
+TEST_F(HotTierBackendTest, WritesInvalidate) {
+  CreateBackend(64 * 1024);
+  WriteEntry("key", "headers", "body");
+  OpenAndReadEntry("key");
+  ASSERT_EQ(1u, backend_->hot_entry_count());
+
+  // The write goes to the wrapped backend, through an entry opened lazily.
+  Entry* entry = OpenEntry("key");
+  ASSERT_TRUE(entry);
+  WriteStream(entry, 1, "new body");
+  EXPECT_EQ(0u, backend_->hot_entry_count());
+  EXPECT_EQ("new body", ReadStream(entry, 1, 8, 100));
+  entry->Close();
+
+  entry = OpenEntry("key");
+  ASSERT_TRUE(entry);
+  EXPECT_EQ("new body", ReadStream(entry, 1, 8, 100));
+  entry->Close();
+}
+
+TEST_F(HotTierBackendTest, DoomsInvalidate) {
+  CreateBackend(64 * 1024);
+  WriteEntry("key", "headers", "body");
+  OpenAndReadEntry("key");
+  ASSERT_EQ(1u, backend_->hot_entry_count());
+
+  net::TestCompletionCallback callback;
+  int rv = backend_->DoomEntry("key", net::HIGHEST, callback.callback());
+  EXPECT_EQ(net::OK, callback.GetResult(rv));
+  EXPECT_EQ(0u, backend_->hot_entry_count());
+  EXPECT_FALSE(OpenEntry("key"));
+
+  WriteEntry("other", "headers", "body");
+  OpenAndReadEntry("other");
+  ASSERT_EQ(1u, backend_->hot_entry_count());
+  rv = backend_->DoomAllEntries(callback.callback());
+  EXPECT_EQ(net::OK, callback.GetResult(rv));
+  EXPECT_EQ(0u, backend_->hot_entry_count());
+  EXPECT_FALSE(OpenEntry("other"));
+}
+
+// A key that was opened once doesn't replace one that was opened often.
+TEST_F(HotTierBackendTest, AdmissionPrefersFrequentKeys) {
+  CreateBackend(20);
+  WriteEntry("hot", "headers", "body");
+  WriteEntry("cold", "headers", "body");
+
+  OpenAndReadEntry("hot");
+  for (int i = 0; i < 3; ++i) {
+    Entry* entry = OpenEntry("hot");
+    ASSERT_TRUE(entry);
+    entry->Close();
+  }
+  ASSERT_EQ(1u, backend_->hot_entry_count());
+
+  OpenAndReadEntry("cold");
+  EXPECT_EQ(1u, backend_->hot_entry_count());
+  EXPECT_EQ("3", GetStat("Hot tier hits"));
+
+  // Once "cold" is used more often than "hot", it takes its place: it's
+  // admitted on its fifth read, and the sixth open is a hit.
+  for (int i = 0; i < 5; ++i)
+    OpenAndReadEntry("cold");
+  EXPECT_EQ(1u, backend_->hot_entry_count());
+  EXPECT_EQ("4", GetStat("Hot tier hits"));
+
+  Entry* entry = OpenEntry("hot");
+  ASSERT_TRUE(entry);
+  entry->Close();
+  EXPECT_EQ("4", GetStat("Hot tier hits"));
+}
+
+}  // namespace disk_cache
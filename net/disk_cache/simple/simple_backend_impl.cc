@@ -24,6 +24,8 @@
 #include "base/metrics/histogram_functions.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/single_thread_task_runner.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/stringprintf.h"
 #include "base/system/sys_info.h"
 #include "base/task/post_task.h"
 #include "base/task/task_scheduler/task_scheduler.h"
@@ -671,6 +673,23 @@ void SimpleBackendImpl::GetStats(base::StringPairs* stats) {
   item.first = "Cache type";
   item.second = "Simple Cache";
   stats->push_back(item);
+
+  item.first = "Hits";
+  item.second = base::NumberToString(hit_count_);
+  stats->push_back(item);
+
+  item.first = "Syscalls per hit";
+  item.second = base::StringPrintf(
+      "%.1f", hit_count_ ? static_cast<double>(hit_syscall_count_) / hit_count_
+                         : 0.0);
+  stats->push_back(item);
+}
+
+void SimpleBackendImpl::OnEntryClosed(bool opened, int syscall_count) {
+  if (!opened)
+    return;
+  ++hit_count_;
+  hit_syscall_count_ += syscall_count;
 }
 
 void SimpleBackendImpl::OnExternalCacheHit(const std::string& key) {
@@ -99,6 +99,11 @@ class NET_EXPORT_PRIVATE SimpleBackendImpl : public Backend,
   // doom completed.
   void OnDoomComplete(uint64_t entry_hash);
 
+  // An entry that made |syscall_count| file system calls in its lifetime was
+  // closed. The calls made by the entries that were opened, rather than
+  // created, are reported per cache hit in GetStats().
+  void OnEntryClosed(bool opened, int syscall_count);
+
   // SimpleIndexDelegate:
   void DoomEntries(std::vector<uint64_t>* entry_hashes,
                    CompletionOnceCallback callback) override;
@@ -309,6 +314,11 @@ class NET_EXPORT_PRIVATE SimpleBackendImpl : public Backend,
 
   uint32_t entry_count_ = 0;
 
+  // The number of entries opened from disk and then closed, and the file
+  // system calls they made.
+  int64_t hit_count_ = 0;
+  int64_t hit_syscall_count_ = 0;
+
 #if defined(OS_ANDROID)
   base::android::ApplicationStatusListener* app_status_listener_ = nullptr;
 #endif
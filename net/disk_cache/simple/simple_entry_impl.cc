@@ -58,7 +58,7 @@ enum SimpleEntryWriteResult {
 
 OpenEntryIndexEnum ComputeIndexState(SimpleBackendImpl* backend,
                                      uint64_t entry_hash) {
-  if (!backend->index()->initialized())
+  if (!backend->index()->lookups_ready())
     return INDEX_NOEXIST;
   if (backend->index()->Has(entry_hash))
     return INDEX_HIT;
@@ -1655,6 +1655,12 @@ void SimpleEntryImpl::CloseOperationComplete(
          STATE_UNINITIALIZED == state_);
   net_log_.AddEvent(net::NetLogEventType::SIMPLE_CACHE_ENTRY_CLOSE_END);
   AdjustOpenEntryCountBy(cache_type_, -1);
+  if (in_results->opened) {
+    SIMPLE_CACHE_UMA(COUNTS_1000, "EntrySyscallsPerHit", cache_type_,
+                     in_results->syscall_count);
+  }
+  if (backend_)
+    backend_->OnEntryClosed(in_results->opened, in_results->syscall_count);
   if (cache_type_ == net::APP_CACHE &&
       in_results->estimated_trailer_prefetch_size > 0 && backend_.get() &&
       backend_->index()) {
@@ -5,7 +5,9 @@
 #include "net/disk_cache/simple/simple_index.h"
 
 #include <algorithm>
+#include <iterator>
 #include <limits>
+#include <random>
 #include <string>
 #include <utility>
 
@@ -16,6 +18,7 @@
 #include "base/metrics/field_trial.h"
 #include "base/numerics/safe_conversions.h"
 #include "base/pickle.h"
+#include "base/rand_util.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_tokenizer.h"
 #include "base/task_runner.h"
@@ -55,6 +58,33 @@ const uint32_t kBytesInKb = 1024;
 // treated the same.
 static const int kEstimatedEntryOverhead = 512;
 
+// Indices with more entries than this choose the entries to evict by sampling
+// instead of sorting them all.
+const size_t kMaxEntriesForExactEviction = 50000;
+
+// When sampling, the eviction score threshold is estimated from this many
+// random entries. The threshold is chosen so that the entries above it add up
+// to kEvictionSampleOvershoot times the amount to evict, so that the entries
+// to evict are found after looking at about 1/kEvictionSampleOvershoot of the
+// index, and are among the kEvictionSampleOvershoot times more entries that
+// should be evicted first.
+const size_t kEvictionSampleSize = 1024;
+const uint64_t kEvictionSampleOvershoot = 2;
+
+// Returns the eviction score of |metadata|: the higher, the sooner the entry
+// should be evicted.
+uint64_t GetEvictionScore(const disk_cache::EntryMetadata& metadata,
+                          uint32_t now,
+                          bool use_size) {
+  uint64_t score = now - metadata.RawTimeForSorting();
+  if (use_size) {
+    // Will not overflow since we're multiplying two 32-bit values and storing
+    // them in a 64-bit variable.
+    score *= metadata.GetEntrySize() + kEstimatedEntryOverhead;
+  }
+  return score;
+}
+
 }  // namespace
 
 namespace disk_cache {
@@ -150,8 +180,19 @@ bool EntryMetadata::Deserialize(net::CacheType cache_type,
   int64_t tmp_time_or_prefetch_size;
   uint64_t tmp_entry_size;
   if (!it->ReadInt64(&tmp_time_or_prefetch_size) ||
-      !it->ReadUInt64(&tmp_entry_size) ||
-      tmp_entry_size > std::numeric_limits<uint32_t>::max())
+      !it->ReadUInt64(&tmp_entry_size))
+    return false;
+  return Deserialize(cache_type, tmp_time_or_prefetch_size, tmp_entry_size,
+                     has_entry_in_memory_data,
+                     app_cache_has_trailer_prefetch_size);
+}
+
+bool EntryMetadata::Deserialize(net::CacheType cache_type,
+                                int64_t tmp_time_or_prefetch_size,
+                                uint64_t tmp_entry_size,
+                                bool has_entry_in_memory_data,
+                                bool app_cache_has_trailer_prefetch_size) {
+  if (tmp_entry_size > std::numeric_limits<uint32_t>::max())
     return false;
   if (cache_type == net::APP_CACHE) {
     if (app_cache_has_trailer_prefetch_size) {
@@ -176,6 +217,121 @@ bool EntryMetadata::Deserialize(net::CacheType cache_type,
   return true;
 }
 
+constexpr size_t ShardedEntrySet::kShardCount;
+
+ShardedEntrySet::ShardedEntrySet() = default;
+
+ShardedEntrySet::ShardedEntrySet(const ShardedEntrySet& other) = default;
+
+ShardedEntrySet::ShardedEntrySet(ShardedEntrySet&& other) = default;
+
+ShardedEntrySet::~ShardedEntrySet() = default;
+
+ShardedEntrySet& ShardedEntrySet::operator=(const ShardedEntrySet& other) =
+    default;
+
+ShardedEntrySet& ShardedEntrySet::operator=(ShardedEntrySet&& other) = default;
+
+ShardedEntrySet::iterator ShardedEntrySet::begin() {
+  iterator it(&shards_, 0, shards_[0].begin());
+  it.SkipEmptyShards();
+  return it;
+}
+
+ShardedEntrySet::const_iterator ShardedEntrySet::begin() const {
+  const_iterator it(&shards_, 0, shards_[0].begin());
+  it.SkipEmptyShards();
+  return it;
+}
+
+ShardedEntrySet::iterator ShardedEntrySet::end() {
+  return iterator(&shards_, kShardCount, Shard::iterator());
+}
+
+ShardedEntrySet::const_iterator ShardedEntrySet::end() const {
+  return const_iterator(&shards_, kShardCount, Shard::const_iterator());
+}
+
+ShardedEntrySet::iterator ShardedEntrySet::find(uint64_t entry_hash) {
+  const size_t shard_index = GetShardIndex(entry_hash);
+  Shard::iterator it = shards_[shard_index].find(entry_hash);
+  if (it == shards_[shard_index].end())
+    return end();
+  // The caller may modify the entry.
+  dirty_shards_.set(shard_index);
+  return iterator(&shards_, shard_index, it);
+}
+
+ShardedEntrySet::const_iterator ShardedEntrySet::find(
+    uint64_t entry_hash) const {
+  const size_t shard_index = GetShardIndex(entry_hash);
+  Shard::const_iterator it = shards_[shard_index].find(entry_hash);
+  if (it == shards_[shard_index].end())
+    return end();
+  return const_iterator(&shards_, shard_index, it);
+}
+
+size_t ShardedEntrySet::count(uint64_t entry_hash) const {
+  return shards_[GetShardIndex(entry_hash)].count(entry_hash);
+}
+
+std::pair<ShardedEntrySet::iterator, bool> ShardedEntrySet::insert(
+    const value_type& value) {
+  const size_t shard_index = GetShardIndex(value.first);
+  std::pair<Shard::iterator, bool> result = shards_[shard_index].insert(value);
+  if (result.second)
+    ++size_;
+  // Even if nothing was inserted, the caller may modify the existing entry.
+  dirty_shards_.set(shard_index);
+  return std::make_pair(iterator(&shards_, shard_index, result.first),
+                        result.second);
+}
+
+void ShardedEntrySet::erase(iterator it) {
+  DCHECK_LT(it.shard_index_, kShardCount);
+  shards_[it.shard_index_].erase(it.it_);
+  --size_;
+  dirty_shards_.set(it.shard_index_);
+}
+
+size_t ShardedEntrySet::erase(uint64_t entry_hash) {
+  const size_t shard_index = GetShardIndex(entry_hash);
+  const size_t erased = shards_[shard_index].erase(entry_hash);
+  if (erased) {
+    size_ -= erased;
+    dirty_shards_.set(shard_index);
+  }
+  return erased;
+}
+
+void ShardedEntrySet::clear() {
+  for (Shard& shard : shards_)
+    shard.clear();
+  size_ = 0;
+  dirty_shards_.set();
+}
+
+void ShardedEntrySet::swap(ShardedEntrySet& other) {
+  shards_.swap(other.shards_);
+  std::swap(dirty_shards_, other.dirty_shards_);
+  std::swap(size_, other.size_);
+}
+
+void ShardedEntrySet::reserve(size_t count) {
+  // Hashes are uniformly distributed, so leave a little slack for the shards
+  // that end up larger than average.
+  const size_t per_shard = count / kShardCount + count / (kShardCount * 16);
+  for (Shard& shard : shards_)
+    shard.reserve(per_shard + 1);
+}
+
+size_t ShardedEntrySet::EstimateMemoryUsage() const {
+  size_t usage = 0;
+  for (const Shard& shard : shards_)
+    usage += base::trace_event::EstimateMemoryUsage(shard);
+  return usage;
+}
+
 SimpleIndex::SimpleIndex(
     const scoped_refptr<base::SingleThreadTaskRunner>& io_thread,
     scoped_refptr<BackendCleanupTracker> cleanup_tracker,
@@ -219,6 +375,12 @@ void SimpleIndex::Initialize(base::Time cache_mtime) {
   }
 #endif
 
+  // Mapping the index file is much faster than loading it, so the mapping can
+  // answer lookups while the entries are being loaded.
+  index_file_->MapIndexFile(
+      cache_mtime,
+      base::BindOnce(&SimpleIndex::OnIndexFileMapped, AsWeakPtr()));
+
   SimpleIndexLoadResult* load_result = new SimpleIndexLoadResult();
   std::unique_ptr<SimpleIndexLoadResult> load_result_scoped(load_result);
   base::Closure reply = base::Bind(
@@ -318,8 +480,10 @@ size_t SimpleIndex::EstimateMemoryUsage() const {
 base::Time SimpleIndex::GetLastUsedTime(uint64_t entry_hash) {
   DCHECK(io_thread_checker_.CalledOnValidThread());
   DCHECK_NE(cache_type_, net::APP_CACHE);
-  auto it = entries_set_.find(entry_hash);
-  if (it == entries_set_.end())
+  // Look up through a const reference so the shard isn't marked dirty.
+  const EntrySet& entries = entries_set_;
+  auto it = entries.find(entry_hash);
+  if (it == entries.end())
     return base::Time();
   return it->second.GetLastUsedTime();
 }
@@ -373,8 +537,18 @@ void SimpleIndex::Remove(uint64_t entry_hash) {
 
 bool SimpleIndex::Has(uint64_t hash) const {
   DCHECK(io_thread_checker_.CalledOnValidThread());
-  // If not initialized, always return true, forcing it to go to the disk.
-  return !initialized_ || entries_set_.count(hash) > 0;
+  if (entries_set_.count(hash) > 0)
+    return true;
+  if (initialized_)
+    return false;
+  // If not initialized, use the mapped index file, taking into account the
+  // entries removed since. Without one, return true, forcing it to go to the
+  // disk.
+  if (mapped_index_) {
+    return removed_entries_.count(hash) == 0 &&
+           mapped_index_->Lookup(hash, nullptr);
+  }
+  return true;
 }
 
 uint8_t SimpleIndex::GetEntryInMemoryData(uint64_t entry_hash) const {
@@ -413,7 +587,8 @@ void SimpleIndex::StartEvictionIfNeeded() {
   DCHECK(io_thread_checker_.CalledOnValidThread());
   if (eviction_in_progress_ || cache_size_ <= high_watermark_)
     return;
-  // Take all live key hashes from the index and sort them by time.
+  // Pick the live key hashes that were used the longest time ago, weighted by
+  // size.
   eviction_in_progress_ = true;
   eviction_start_time_ = base::TimeTicks::Now();
   SIMPLE_CACHE_UMA(
@@ -423,33 +598,17 @@ void SimpleIndex::StartEvictionIfNeeded() {
       MEMORY_KB, "Eviction.MaxCacheSizeOnStart2", cache_type_,
       static_cast<base::HistogramBase::Sample>(max_size_ / kBytesInKb));
 
-  // Flatten for sorting.
-  std::vector<std::pair<uint64_t, const EntrySet::value_type*>> entries;
-  entries.reserve(entries_set_.size());
   uint32_t now = (base::Time::Now() - base::Time::UnixEpoch()).InSeconds();
   bool use_size = base::FeatureList::IsEnabled(kSimpleCacheEvictionWithSize);
-  for (EntrySet::const_iterator i = entries_set_.begin();
-       i != entries_set_.end(); ++i) {
-    uint64_t sort_value = now - i->second.RawTimeForSorting();
-    if (use_size) {
-      // Will not overflow since we're multiplying two 32-bit values and storing
-      // them in a 64-bit variable.
-      sort_value *= i->second.GetEntrySize() + kEstimatedEntryOverhead;
-    }
-    // Subtract so we don't need a custom comparator.
-    entries.emplace_back(std::numeric_limits<uint64_t>::max() - sort_value,
-                         &*i);
-  }
-
-  uint64_t evicted_so_far_size = 0;
   const uint64_t amount_to_evict = cache_size_ - low_watermark_;
+  uint64_t evicted_so_far_size = 0;
   std::vector<uint64_t> entry_hashes;
-  std::sort(entries.begin(), entries.end());
-  for (const auto& score_metadata_pair : entries) {
-    if (evicted_so_far_size >= amount_to_evict)
-      break;
-    evicted_so_far_size += score_metadata_pair.second->second.GetEntrySize();
-    entry_hashes.push_back(score_metadata_pair.second->first);
+  if (entries_set_.size() <= kMaxEntriesForExactEviction) {
+    SelectEntriesToEvictExactly(now, use_size, amount_to_evict, &entry_hashes,
+                                &evicted_so_far_size);
+  } else {
+    SampleEntriesToEvict(now, use_size, amount_to_evict, &entry_hashes,
+                         &evicted_so_far_size);
   }
 
   SIMPLE_CACHE_UMA(COUNTS_1M,
@@ -466,6 +625,110 @@ void SimpleIndex::StartEvictionIfNeeded() {
                                                    AsWeakPtr()));
 }
 
+void SimpleIndex::SelectEntriesToEvictExactly(
+    uint32_t now,
+    bool use_size,
+    uint64_t amount_to_evict,
+    std::vector<uint64_t>* entry_hashes,
+    uint64_t* evicted_size) const {
+  // Flatten for sorting.
+  std::vector<std::pair<uint64_t, const EntrySet::value_type*>> entries;
+  entries.reserve(entries_set_.size());
+  for (const auto& entry : entries_set_) {
+    // Subtract so we don't need a custom comparator.
+    entries.emplace_back(std::numeric_limits<uint64_t>::max() -
+                             GetEvictionScore(entry.second, now, use_size),
+                         &entry);
+  }
+
+  std::sort(entries.begin(), entries.end());
+  for (const auto& score_metadata_pair : entries) {
+    if (*evicted_size >= amount_to_evict)
+      break;
+    *evicted_size += score_metadata_pair.second->second.GetEntrySize();
+    entry_hashes->push_back(score_metadata_pair.second->first);
+  }
+}
+
+void SimpleIndex::SampleEntriesToEvict(uint32_t now,
+                                       bool use_size,
+                                       uint64_t amount_to_evict,
+                                       std::vector<uint64_t>* entry_hashes,
+                                       uint64_t* evicted_size) const {
+  // The generator only needs to spread the samples, so a cheap one seeded
+  // once per eviction is good enough.
+  std::minstd_rand generator(static_cast<uint32_t>(base::RandUint64()));
+
+  // Estimate from a random sample of the entries the eviction score above
+  // which entries add up to kEvictionSampleOvershoot times the amount to
+  // evict.
+  std::vector<std::pair<uint64_t, uint32_t>> sample;
+  sample.reserve(kEvictionSampleSize);
+  uint64_t sample_size = 0;
+  for (size_t attempt = 0;
+       attempt < 2 * kEvictionSampleSize && sample.size() < kEvictionSampleSize;
+       ++attempt) {
+    const EntrySet::Shard& shard =
+        entries_set_.shard(generator() % EntrySet::kShardCount);
+    if (shard.empty())
+      continue;
+    // Buckets are on average less than one entry long, so a random entry of
+    // a random bucket is close to a random entry of the shard.
+    const size_t bucket = generator() % shard.bucket_count();
+    const size_t bucket_size = shard.bucket_size(bucket);
+    if (!bucket_size)
+      continue;
+    auto it = shard.begin(bucket);
+    std::advance(it, generator() % bucket_size);
+    const EntryMetadata& metadata = it->second;
+    sample.emplace_back(GetEvictionScore(metadata, now, use_size),
+                        metadata.GetEntrySize());
+    sample_size += metadata.GetEntrySize();
+  }
+  std::sort(sample.begin(), sample.end(),
+            [](const std::pair<uint64_t, uint32_t>& a,
+               const std::pair<uint64_t, uint32_t>& b) {
+              return a.first > b.first;
+            });
+  const double fraction_to_evict =
+      static_cast<double>(amount_to_evict) / cache_size_;
+  const uint64_t sample_amount_to_evict = static_cast<uint64_t>(
+      sample_size * kEvictionSampleOvershoot * fraction_to_evict);
+  uint64_t threshold = 0;
+  uint64_t sample_evicted = 0;
+  for (const auto& score_size_pair : sample) {
+    threshold = score_size_pair.first;
+    sample_evicted += score_size_pair.second;
+    if (sample_evicted >= sample_amount_to_evict)
+      break;
+  }
+
+  // Take the entries above the threshold, starting from a random shard. If
+  // the sample was unlucky and they don't add up to enough, lower the
+  // threshold and look at the entries between the old and the new thresholds.
+  const size_t first_shard = generator() % EntrySet::kShardCount;
+  uint64_t upper_threshold = std::numeric_limits<uint64_t>::max();
+  while (true) {
+    for (size_t i = 0; i < EntrySet::kShardCount; ++i) {
+      const EntrySet::Shard& shard =
+          entries_set_.shard((first_shard + i) % EntrySet::kShardCount);
+      for (const auto& entry : shard) {
+        const uint64_t score = GetEvictionScore(entry.second, now, use_size);
+        if (score < threshold || score >= upper_threshold)
+          continue;
+        *evicted_size += entry.second.GetEntrySize();
+        entry_hashes->push_back(entry.first);
+        if (*evicted_size >= amount_to_evict)
+          return;
+      }
+    }
+    if (threshold == 0)
+      return;
+    upper_threshold = threshold;
+    threshold /= 2;
+  }
+}
+
 int32_t SimpleIndex::GetTrailerPrefetchSize(uint64_t entry_hash) const {
   DCHECK(io_thread_checker_.CalledOnValidThread());
   DCHECK_EQ(cache_type_, net::APP_CACHE);
@@ -561,9 +824,18 @@ bool SimpleIndex::UpdateEntryIteratorSize(
   return original_size != (*it)->second.GetEntrySize();
 }
 
+void SimpleIndex::OnIndexFileMapped(
+    std::unique_ptr<MappedIndexFile> mapped_index) {
+  DCHECK(io_thread_checker_.CalledOnValidThread());
+  // The entries may have been loaded first.
+  if (!initialized_)
+    mapped_index_ = std::move(mapped_index);
+}
+
 void SimpleIndex::MergeInitializingSet(
     std::unique_ptr<SimpleIndexLoadResult> load_result) {
   DCHECK(io_thread_checker_.CalledOnValidThread());
+  mapped_index_.reset();
 
   EntrySet* index_file_entries = &load_result->entries;
 
@@ -676,6 +948,9 @@ void SimpleIndex::WriteToDisk(IndexWriteToDiskReason reason) {
 
   index_file_->WriteToDisk(cache_type_, reason, entries_set_, cache_size_,
                            start, app_on_background_, after_write);
+  // The index file keeps the serialization of the clean shards, so only the
+  // shards modified from now on need to be serialized by the next write.
+  entries_set_.ClearDirtyShards();
 }
 
 }  // namespace disk_cache
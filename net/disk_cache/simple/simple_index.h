@@ -5,8 +5,12 @@
 #ifndef NET_DISK_CACHE_SIMPLE_SIMPLE_INDEX_H_
 #define NET_DISK_CACHE_SIMPLE_SIMPLE_INDEX_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
+#include <array>
+#include <bitset>
+#include <iterator>
 #include <list>
 #include <memory>
 #include <unordered_map>
@@ -42,6 +46,7 @@ class PickleIterator;
 namespace disk_cache {
 
 class BackendCleanupTracker;
+class MappedIndexFile;
 class SimpleIndexDelegate;
 class SimpleIndexFile;
 struct SimpleIndexLoadResult;
@@ -78,6 +83,13 @@ class NET_EXPORT_PRIVATE EntryMetadata {
                    base::PickleIterator* it,
                    bool has_entry_in_memory_data,
                    bool app_cache_has_trailer_prefetch_size);
+  // Same as above, with the two fields read from the index file by the
+  // caller.
+  bool Deserialize(net::CacheType cache_type,
+                   int64_t time_or_prefetch_size,
+                   uint64_t entry_size,
+                   bool has_entry_in_memory_data,
+                   bool app_cache_has_trailer_prefetch_size);
 
   static base::TimeDelta GetLowerEpsilonForTimeComparisons() {
     return base::TimeDelta::FromSeconds(1);
@@ -112,6 +124,138 @@ class NET_EXPORT_PRIVATE EntryMetadata {
 };
 static_assert(sizeof(EntryMetadata) == 8, "incorrect metadata size");
 
+// A map from entry hash to EntryMetadata, split by hash into a fixed number of
+// shards. It has the subset of the std::unordered_map interface that the index
+// uses, and additionally remembers which shards were modified since the last
+// call to ClearDirtyShards(), so that SimpleIndexFile only needs to serialize
+// the shards that changed. The shards also let the index sample entries for
+// eviction without walking every entry.
+//
+// Modifications are tracked through insert(), erase(), clear() and the
+// non-const find(): a non-const find() that returns an entry conservatively
+// marks its shard as dirty. Modifying entries while iterating from begin() is
+// not tracked.
+class NET_EXPORT_PRIVATE ShardedEntrySet {
+ public:
+  using Shard = std::unordered_map<uint64_t, EntryMetadata>;
+  using key_type = Shard::key_type;
+  using mapped_type = Shard::mapped_type;
+  using value_type = Shard::value_type;
+
+  // Large enough that a shard of a cache with a million entries serializes in
+  // well under a millisecond.
+  static constexpr size_t kShardCount = 64;
+
+  template <typename ShardArray, typename ShardIterator>
+  class IteratorImpl {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = ShardedEntrySet::value_type;
+    using difference_type = ptrdiff_t;
+    using pointer = typename std::iterator_traits<ShardIterator>::pointer;
+    using reference = typename std::iterator_traits<ShardIterator>::reference;
+
+    IteratorImpl() = default;
+    IteratorImpl(ShardArray* shards, size_t shard_index, ShardIterator it)
+        : shards_(shards), shard_index_(shard_index), it_(it) {}
+    // Allows converting an iterator to a const_iterator.
+    template <typename OtherArray, typename OtherIterator>
+    IteratorImpl(const IteratorImpl<OtherArray, OtherIterator>& other)
+        : shards_(other.shards_),
+          shard_index_(other.shard_index_),
+          it_(other.it_) {}
+
+    reference operator*() const { return *it_; }
+    pointer operator->() const { return &*it_; }
+
+    IteratorImpl& operator++() {
+      ++it_;
+      SkipEmptyShards();
+      return *this;
+    }
+
+    bool operator==(const IteratorImpl& other) const {
+      return shard_index_ == other.shard_index_ &&
+             (shard_index_ == kShardCount || it_ == other.it_);
+    }
+    bool operator!=(const IteratorImpl& other) const {
+      return !(*this == other);
+    }
+
+   private:
+    friend class ShardedEntrySet;
+    template <typename, typename>
+    friend class IteratorImpl;
+
+    // Moves to the first entry of the next non-empty shard if |it_| is at the
+    // end of its shard.
+    void SkipEmptyShards() {
+      while (it_ == (*shards_)[shard_index_].end()) {
+        if (++shard_index_ == kShardCount)
+          return;
+        it_ = (*shards_)[shard_index_].begin();
+      }
+    }
+
+    ShardArray* shards_ = nullptr;
+    size_t shard_index_ = kShardCount;
+    ShardIterator it_;
+  };
+
+  using ShardArray = std::array<Shard, kShardCount>;
+  using iterator = IteratorImpl<ShardArray, Shard::iterator>;
+  using const_iterator = IteratorImpl<const ShardArray, Shard::const_iterator>;
+
+  ShardedEntrySet();
+  ShardedEntrySet(const ShardedEntrySet& other);
+  ShardedEntrySet(ShardedEntrySet&& other);
+  ~ShardedEntrySet();
+
+  ShardedEntrySet& operator=(const ShardedEntrySet& other);
+  ShardedEntrySet& operator=(ShardedEntrySet&& other);
+
+  static size_t GetShardIndex(uint64_t entry_hash) {
+    // Entry hashes are the leading bytes of a SHA-1, so the low bits are as
+    // good as any.
+    return entry_hash % kShardCount;
+  }
+
+  iterator begin();
+  const_iterator begin() const;
+  iterator end();
+  const_iterator end() const;
+
+  iterator find(uint64_t entry_hash);
+  const_iterator find(uint64_t entry_hash) const;
+  size_t count(uint64_t entry_hash) const;
+
+  std::pair<iterator, bool> insert(const value_type& value);
+  void erase(iterator it);
+  size_t erase(uint64_t entry_hash);
+  void clear();
+  void swap(ShardedEntrySet& other);
+
+  // Reserves room for |count| entries, spread evenly over the shards.
+  void reserve(size_t count);
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  const Shard& shard(size_t shard_index) const { return shards_[shard_index]; }
+
+  bool IsShardDirty(size_t shard_index) const {
+    return dirty_shards_[shard_index];
+  }
+  void ClearDirtyShards() { dirty_shards_.reset(); }
+
+  size_t EstimateMemoryUsage() const;
+
+ private:
+  ShardArray shards_;
+  std::bitset<kShardCount> dirty_shards_;
+  size_t size_ = 0;
+};
+
 // This class is not Thread-safe.
 class NET_EXPORT_PRIVATE SimpleIndex
     : public base::SupportsWeakPtr<SimpleIndex> {
@@ -171,7 +315,7 @@ class NET_EXPORT_PRIVATE SimpleIndex
   bool UpdateEntrySize(uint64_t entry_hash,
                        base::StrictNumeric<uint32_t> entry_size);
 
-  using EntrySet = std::unordered_map<uint64_t, EntryMetadata>;
+  using EntrySet = ShardedEntrySet;
 
   // Insert an entry in the given set if there is not already entry present.
   // Returns true if the set was modified.
@@ -217,6 +361,11 @@ class NET_EXPORT_PRIVATE SimpleIndex
   // Returns whether the index has been initialized yet.
   bool initialized() const { return initialized_; }
 
+  // Returns whether Has() reflects the contents of the cache. This is the case
+  // once the index is initialized, and before that if the index file could be
+  // mapped.
+  bool lookups_ready() const { return initialized_ || mapped_index_; }
+
   IndexInitMethod init_method() const { return init_method_; }
 
   // Returns the estimate of dynamically allocated memory in bytes.
@@ -248,6 +397,22 @@ class NET_EXPORT_PRIVATE SimpleIndex
   void StartEvictionIfNeeded();
   void EvictionDone(int result);
 
+  // Append to |entry_hashes| the entries to evict to free |amount_to_evict|
+  // bytes, and add their sizes to |evicted_size|. The first sorts all the
+  // entries by eviction score. The second estimates from a random sample the
+  // score of the entries to evict and takes entries scoring above it, which is
+  // approximate but much faster for large indices.
+  void SelectEntriesToEvictExactly(uint32_t now,
+                                   bool use_size,
+                                   uint64_t amount_to_evict,
+                                   std::vector<uint64_t>* entry_hashes,
+                                   uint64_t* evicted_size) const;
+  void SampleEntriesToEvict(uint32_t now,
+                            bool use_size,
+                            uint64_t amount_to_evict,
+                            std::vector<uint64_t>* entry_hashes,
+                            uint64_t* evicted_size) const;
+
   void PostponeWritingToDisk();
 
   // Update the size of the entry pointed to by the given iterator.  Return
@@ -256,6 +421,7 @@ class NET_EXPORT_PRIVATE SimpleIndex
                                base::StrictNumeric<uint32_t> entry_size);
 
   // Must run on IO Thread.
+  void OnIndexFileMapped(std::unique_ptr<MappedIndexFile> mapped_index);
   void MergeInitializingSet(std::unique_ptr<SimpleIndexLoadResult> load_result);
 
 #if defined(OS_ANDROID)
@@ -289,6 +455,9 @@ class NET_EXPORT_PRIVATE SimpleIndex
 
   std::unique_ptr<SimpleIndexFile> index_file_;
 
+  // The index file, mapped to answer Has() until the index is initialized.
+  std::unique_ptr<MappedIndexFile> mapped_index_;
+
   scoped_refptr<base::SingleThreadTaskRunner> io_thread_;
 
   // All nonstatic SimpleEntryImpl methods should always be called on the IO
@@ -4,10 +4,14 @@
 
 #include "net/disk_cache/simple/simple_index_file.h"
 
+#include <string.h>
+
+#include <algorithm>
 #include <utility>
 #include <vector>
 
 #include "base/bind.h"
+#include "base/callback.h"
 #include "base/files/file.h"
 #include "base/files/file_util.h"
 #include "base/files/memory_mapped_file.h"
@@ -36,8 +40,10 @@ const int kEntryFilesSuffixLength = 2;
 const int kMaxEntriesInIndex = 1000000;
 
 // Here 8 comes from the key size.
+const int kEntryOnDiskSizeBytes = 8 + EntryMetadata::kOnDiskSizeBytes;
+
 const int64_t kMaxIndexFileSizeBytes =
-    kMaxEntriesInIndex * (8 + EntryMetadata::kOnDiskSizeBytes);
+    kMaxEntriesInIndex * kEntryOnDiskSizeBytes;
 
 uint32_t CalculatePickleCRC(const base::Pickle& pickle) {
   return simple_util::Crc32(pickle.payload(), pickle.payload_size());
@@ -133,6 +139,29 @@ bool WritePickleFile(base::Pickle* pickle, const base::FilePath& file_name) {
   return true;
 }
 
+// Reads the shard table that follows the IndexMetadata since version 10, and
+// returns whether it's consistent with |entry_count|. |out_shard_sizes| may be
+// null.
+bool ReadShardTable(base::PickleIterator* it,
+                    uint64_t entry_count,
+                    uint32_t* out_shard_sizes) {
+  uint32_t shard_count;
+  if (!it->ReadUInt32(&shard_count) ||
+      shard_count != SimpleIndex::EntrySet::kShardCount) {
+    return false;
+  }
+  uint64_t total = 0;
+  for (uint32_t i = 0; i < shard_count; ++i) {
+    uint32_t shard_size;
+    if (!it->ReadUInt32(&shard_size))
+      return false;
+    total += shard_size;
+    if (out_shard_sizes)
+      out_shard_sizes[i] = shard_size;
+  }
+  return total == entry_count;
+}
+
 // Called for each cache directory traversal iteration.
 void ProcessEntryFile(net::CacheType cache_type,
                       SimpleIndex::EntrySet* entries,
@@ -349,11 +378,11 @@ bool SimpleIndexFile::IndexMetadata::CheckIndexMetadata() {
     return false;
   }
 
-  static_assert(kSimpleVersion == 9, "index metadata reader out of date");
+  static_assert(kSimpleVersion == 10, "index metadata reader out of date");
   // No |reason_| is saved in the version 6 file format.
   if (version_ == 6)
     return reason_ == SimpleIndex::INDEX_WRITE_REASON_MAX;
-  return (version_ == 7 || version_ == 8 || version_ == 9) &&
+  return (version_ == 7 || version_ == 8 || version_ == 9 || version_ == 10) &&
          reason_ < SimpleIndex::INDEX_WRITE_REASON_MAX;
 }
 
@@ -383,6 +412,15 @@ void SimpleIndexFile::LoadIndexEntries(base::Time cache_last_modified,
   worker_pool_->PostTaskAndReply(FROM_HERE, task, callback);
 }
 
+void SimpleIndexFile::MapIndexFile(base::Time cache_last_modified,
+                                   MapIndexCallback callback) {
+  base::PostTaskAndReplyWithResult(
+      worker_pool_.get(), FROM_HERE,
+      base::BindOnce(&SimpleIndexFile::SyncMapIndexFile, cache_type_,
+                     cache_last_modified, index_file_),
+      std::move(callback));
+}
+
 void SimpleIndexFile::WriteToDisk(net::CacheType cache_type,
                                   SimpleIndex::IndexWriteToDiskReason reason,
                                   const SimpleIndex::EntrySet& entry_set,
@@ -393,7 +431,8 @@ void SimpleIndexFile::WriteToDisk(net::CacheType cache_type,
   UmaRecordIndexWriteReason(reason, cache_type_);
   IndexMetadata index_metadata(reason, entry_set.size(), cache_size);
   std::unique_ptr<base::Pickle> pickle =
-      Serialize(cache_type, index_metadata, entry_set);
+      SerializeIncrementally(cache_type, index_metadata, entry_set,
+                             &serialized_shards_);
   base::Closure task =
       base::Bind(&SimpleIndexFile::SyncWriteToDisk,
                  cache_type_, cache_directory_, index_file_, temp_index_file_,
@@ -476,6 +515,24 @@ void SimpleIndexFile::SyncLoadIndexEntries(
   UmaRecordIndexInitMethod(out_result->init_method, cache_type);
 }
 
+// static
+std::unique_ptr<MappedIndexFile> SimpleIndexFile::SyncMapIndexFile(
+    net::CacheType cache_type,
+    base::Time cache_last_modified,
+    const base::FilePath& index_file_path) {
+  const base::TimeTicks start = base::TimeTicks::Now();
+  std::unique_ptr<MappedIndexFile> mapped_index =
+      MappedIndexFile::Open(cache_type, index_file_path);
+  // Like SyncLoadIndexEntries(), don't trust an index older than the cache.
+  if (!mapped_index ||
+      cache_last_modified > mapped_index->cache_last_modified()) {
+    return nullptr;
+  }
+  SIMPLE_CACHE_UMA(TIMES, "IndexMapTime", cache_type,
+                   base::TimeTicks::Now() - start);
+  return mapped_index;
+}
+
 // static
 void SimpleIndexFile::SyncLoadFromDisk(net::CacheType cache_type,
                                        const base::FilePath& index_filename,
@@ -520,13 +577,62 @@ std::unique_ptr<base::Pickle> SimpleIndexFile::Serialize(
     net::CacheType cache_type,
     const SimpleIndexFile::IndexMetadata& index_metadata,
     const SimpleIndex::EntrySet& entries) {
-  std::unique_ptr<base::Pickle> pickle = std::make_unique<SimpleIndexPickle>();
+  std::vector<std::string> serialized_shards;
+  return SerializeIncrementally(cache_type, index_metadata, entries,
+                                &serialized_shards);
+}
 
+// static
+std::unique_ptr<base::Pickle> SimpleIndexFile::SerializeIncrementally(
+    net::CacheType cache_type,
+    const SimpleIndexFile::IndexMetadata& index_metadata,
+    const SimpleIndex::EntrySet& entries,
+    std::vector<std::string>* serialized_shards) {
+  using EntrySet = SimpleIndex::EntrySet;
+  const bool serialize_all = serialized_shards->size() != EntrySet::kShardCount;
+  serialized_shards->resize(EntrySet::kShardCount);
+
+  // Every field of an entry is 8 bytes long, so the pickled entries of a shard
+  // can be copied verbatim after the entries of the previous shards. They are
+  // sorted by hash, for MappedIndexFile.
+  size_t entries_size = 0;
+  std::vector<const EntrySet::value_type*> sorted_entries;
+  for (size_t i = 0; i < EntrySet::kShardCount; ++i) {
+    std::string& serialized_shard = (*serialized_shards)[i];
+    if (serialize_all || entries.IsShardDirty(i)) {
+      sorted_entries.clear();
+      for (const auto& entry : entries.shard(i))
+        sorted_entries.push_back(&entry);
+      std::sort(sorted_entries.begin(), sorted_entries.end(),
+                [](const EntrySet::value_type* a,
+                   const EntrySet::value_type* b) {
+                  return a->first < b->first;
+                });
+      base::Pickle shard_pickle;
+      for (const EntrySet::value_type* entry : sorted_entries) {
+        shard_pickle.WriteUInt64(entry->first);
+        entry->second.Serialize(cache_type, &shard_pickle);
+      }
+      serialized_shard.assign(shard_pickle.payload(),
+                              shard_pickle.payload_size());
+    }
+    DCHECK_EQ(entries.shard(i).size() * kEntryOnDiskSizeBytes,
+              serialized_shard.size());
+    entries_size += serialized_shard.size();
+  }
+
+  std::unique_ptr<base::Pickle> pickle = std::make_unique<SimpleIndexPickle>();
   index_metadata.Serialize(pickle.get());
-  for (auto it = entries.begin(); it != entries.end(); ++it) {
-    pickle->WriteUInt64(it->first);
-    it->second.Serialize(cache_type, pickle.get());
+  if (index_metadata.has_shard_table()) {
+    pickle->WriteUInt32(EntrySet::kShardCount);
+    for (size_t i = 0; i < EntrySet::kShardCount; ++i) {
+      pickle->WriteUInt32(
+          base::checked_cast<uint32_t>(entries.shard(i).size()));
+    }
   }
+  pickle->Reserve(entries_size + sizeof(int64_t));
+  for (const std::string& serialized_shard : *serialized_shards)
+    pickle->WriteBytes(serialized_shard.data(), serialized_shard.size());
   return pickle;
 }
 
@@ -568,6 +674,12 @@ void SimpleIndexFile::Deserialize(net::CacheType cache_type,
     return;
   }
 
+  if (index_metadata.has_shard_table() &&
+      !ReadShardTable(&pickle_it, index_metadata.entry_count(), nullptr)) {
+    LOG(WARNING) << "Invalid shard table in Simple Index file.";
+    return;
+  }
+
   entries->reserve(index_metadata.entry_count() + kExtraSizeForMerge);
   while (entries->size() < index_metadata.entry_count()) {
     uint64_t hash_key;
@@ -628,4 +740,95 @@ bool SimpleIndexFile::LegacyIsIndexFileStale(
   return index_mtime < cache_last_modified;
 }
 
+// static
+std::unique_ptr<MappedIndexFile> MappedIndexFile::Open(
+    net::CacheType cache_type,
+    const base::FilePath& index_filename) {
+  auto file = std::make_unique<base::MemoryMappedFile>();
+  if (!file->Initialize(index_filename))
+    return nullptr;
+  // Lookups touch few pages, in no particular order.
+  file->SetAccessPattern(base::MemoryMappedFile::AccessPattern::kRandom);
+  std::unique_ptr<MappedIndexFile> mapped_index(
+      new MappedIndexFile(cache_type, std::move(file)));
+  if (!mapped_index->Initialize())
+    return nullptr;
+  return mapped_index;
+}
+
+MappedIndexFile::MappedIndexFile(net::CacheType cache_type,
+                                 std::unique_ptr<base::MemoryMappedFile> file)
+    : cache_type_(cache_type), file_(std::move(file)) {}
+
+MappedIndexFile::~MappedIndexFile() = default;
+
+bool MappedIndexFile::Initialize() {
+  if (!base::IsValueInRangeForNumericType<int>(file_->length()))
+    return false;
+  SimpleIndexPickle pickle(reinterpret_cast<const char*>(file_->data()),
+                           base::checked_cast<int>(file_->length()));
+  if (!pickle.data() || !pickle.HeaderValid())
+    return false;
+
+  base::PickleIterator pickle_it(pickle);
+  SimpleIndexFile::IndexMetadata index_metadata;
+  if (!index_metadata.Deserialize(&pickle_it) ||
+      !index_metadata.CheckIndexMetadata() ||
+      !index_metadata.has_shard_table()) {
+    return false;
+  }
+  entry_count_ = index_metadata.entry_count();
+
+  uint32_t shard_sizes[SimpleIndex::EntrySet::kShardCount];
+  if (!ReadShardTable(&pickle_it, entry_count_, shard_sizes))
+    return false;
+  shard_begin_[0] = 0;
+  for (size_t i = 0; i < SimpleIndex::EntrySet::kShardCount; ++i)
+    shard_begin_[i + 1] = shard_begin_[i] + shard_sizes[i];
+
+  int64_t cache_last_modified;
+  const int entries_size =
+      base::checked_cast<int>(entry_count_ * kEntryOnDiskSizeBytes);
+  if (!pickle_it.ReadBytes(&entries_, entries_size) ||
+      !pickle_it.ReadInt64(&cache_last_modified)) {
+    return false;
+  }
+  cache_last_modified_ = base::Time::FromInternalValue(cache_last_modified);
+  return true;
+}
+
+bool MappedIndexFile::Lookup(uint64_t entry_hash,
+                             EntryMetadata* out_metadata) const {
+  const size_t shard = SimpleIndex::EntrySet::GetShardIndex(entry_hash);
+  // The entries are only 4-byte aligned in the file, so read them with
+  // memcpy().
+  auto read_uint64 = [this](uint64_t entry, size_t field) {
+    uint64_t value;
+    memcpy(&value,
+           entries_ + entry * kEntryOnDiskSizeBytes + field * sizeof(uint64_t),
+           sizeof(value));
+    return value;
+  };
+
+  uint64_t begin = shard_begin_[shard];
+  uint64_t end = shard_begin_[shard + 1];
+  while (begin < end) {
+    const uint64_t middle = begin + (end - begin) / 2;
+    const uint64_t middle_hash = read_uint64(middle, 0);
+    if (middle_hash == entry_hash) {
+      if (!out_metadata)
+        return true;
+      return out_metadata->Deserialize(
+          cache_type_, static_cast<int64_t>(read_uint64(middle, 1)),
+          read_uint64(middle, 2), /* has_entry_in_memory_data = */ true,
+          /* app_cache_has_trailer_prefetch_size = */ true);
+    }
+    if (middle_hash < entry_hash)
+      begin = middle + 1;
+    else
+      end = middle;
+  }
+  return false;
+}
+
 }  // namespace disk_cache
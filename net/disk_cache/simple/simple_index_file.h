@@ -7,11 +7,14 @@
 
 #include <stdint.h>
 
+#include <array>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "base/callback.h"
 #include "base/files/file_path.h"
+#include "base/files/memory_mapped_file.h"
 #include "base/gtest_prod_util.h"
 #include "base/logging.h"
 #include "base/macros.h"
@@ -28,6 +31,8 @@ class TaskRunner;
 
 namespace disk_cache {
 
+class MappedIndexFile;
+
 const uint64_t kSimpleIndexMagicNumber = UINT64_C(0x656e74657220796f);
 
 struct NET_EXPORT_PRIVATE SimpleIndexLoadResult {
@@ -44,9 +49,12 @@ struct NET_EXPORT_PRIVATE SimpleIndexLoadResult {
 
 // Simple Index File format is a pickle of IndexMetadata and EntryMetadata
 // objects. The file format is as follows: one instance of |IndexMetadata|
-// followed by |EntryMetadata| repeated |entry_count| times. To learn more about
-// the format see |SimpleIndexFile::Serialize()| and
-// |SimpleIndexFile::LoadFromDisk()|.
+// followed by |EntryMetadata| repeated |entry_count| times. Since version 10,
+// the |IndexMetadata| is followed by the number of entries in each shard of
+// the SimpleIndex::EntrySet, and the entries are grouped by shard and sorted by
+// hash within each shard, so that MappedIndexFile can look entries up in the
+// file without deserializing it. To learn more about the format see
+// |SimpleIndexFile::Serialize()| and |SimpleIndexFile::LoadFromDisk()|.
 //
 // The non-static methods must run on the IO thread. All the real
 // work is done in the static methods, which are run on the cache thread
@@ -70,6 +78,7 @@ class NET_EXPORT_PRIVATE SimpleIndexFile {
     uint64_t entry_count() const { return entry_count_; }
     bool has_entry_in_memory_data() const { return version_ >= 8; }
     bool app_cache_has_trailer_prefetch_size() const { return version_ >= 9; }
+    bool has_shard_table() const { return version_ >= 10; }
 
    private:
     FRIEND_TEST_ALL_PREFIXES(IndexMetadataTest, Basics);
@@ -78,9 +87,11 @@ class NET_EXPORT_PRIVATE SimpleIndexFile {
     FRIEND_TEST_ALL_PREFIXES(SimpleIndexFileTest, ReadV7Format);
     FRIEND_TEST_ALL_PREFIXES(SimpleIndexFileTest, ReadV8Format);
     FRIEND_TEST_ALL_PREFIXES(SimpleIndexFileTest, ReadV8FormatAppCache);
+    FRIEND_TEST_ALL_PREFIXES(SimpleIndexFileTest, ReadV9Format);
     friend class V6IndexMetadataForTest;
     friend class V7IndexMetadataForTest;
     friend class V8IndexMetadataForTest;
+    friend class V9IndexMetadataForTest;
 
     uint64_t magic_number_ = kSimpleIndexMagicNumber;
     uint32_t version_ = kSimpleVersion;
@@ -95,6 +106,9 @@ class NET_EXPORT_PRIVATE SimpleIndexFile {
                   const base::FilePath& cache_directory);
   virtual ~SimpleIndexFile();
 
+  using MapIndexCallback =
+      base::OnceCallback<void(std::unique_ptr<MappedIndexFile>)>;
+
   // Gets index entries based on current disk context. On error it may leave
   // |out_result.did_load| untouched, but still return partial and consistent
   // results in |out_result.entries|.
@@ -102,6 +116,13 @@ class NET_EXPORT_PRIVATE SimpleIndexFile {
                                 const base::Closure& callback,
                                 SimpleIndexLoadResult* out_result);
 
+  // Maps the index file, which is usually much faster than loading its
+  // entries, and runs |callback| with the result. The result is null unless
+  // the index file is fresh relative to |cache_last_modified| and in the
+  // mappable format.
+  virtual void MapIndexFile(base::Time cache_last_modified,
+                            MapIndexCallback callback);
+
   // Writes the specified set of entries to disk.
   virtual void WriteToDisk(net::CacheType cache_type,
                            SimpleIndex::IndexWriteToDiskReason reason,
@@ -131,6 +152,12 @@ class NET_EXPORT_PRIVATE SimpleIndexFile {
                                    const base::FilePath& index_file_path,
                                    SimpleIndexLoadResult* out_result);
 
+  // Synchronous (IO performing) implementation of MapIndexFile.
+  static std::unique_ptr<MappedIndexFile> SyncMapIndexFile(
+      net::CacheType cache_type,
+      base::Time cache_last_modified,
+      const base::FilePath& index_file_path);
+
   // Load the index file from disk returning an EntrySet.
   static void SyncLoadFromDisk(net::CacheType cache_type,
                                const base::FilePath& index_filename,
@@ -147,6 +174,16 @@ class NET_EXPORT_PRIVATE SimpleIndexFile {
       const SimpleIndexFile::IndexMetadata& index_metadata,
       const SimpleIndex::EntrySet& entries);
 
+  // Same as Serialize(), but takes the serialization of the shards of
+  // |entries| that aren't dirty from |serialized_shards|, and stores there the
+  // serialization of the shards that are. If |serialized_shards| doesn't have
+  // one string per shard, all the shards are serialized.
+  static std::unique_ptr<base::Pickle> SerializeIncrementally(
+      net::CacheType cache_type,
+      const SimpleIndexFile::IndexMetadata& index_metadata,
+      const SimpleIndex::EntrySet& entries,
+      std::vector<std::string>* serialized_shards);
+
   // Appends cache modification time data to the serialized format. This is
   // performed on a thread accessing the disk. It is not combined with the main
   // serialization path to avoid extra thread hops or copying the pickle to the
@@ -201,6 +238,10 @@ class NET_EXPORT_PRIVATE SimpleIndexFile {
   const base::FilePath index_file_;
   const base::FilePath temp_index_file_;
 
+  // The serialized entries of each shard of the last entry set written, so
+  // that WriteToDisk() only needs to serialize the shards modified since.
+  std::vector<std::string> serialized_shards_;
+
   static const char kIndexDirectory[];
   static const char kIndexFileName[];
   static const char kTempIndexFileName[];
@@ -208,6 +249,54 @@ class NET_EXPORT_PRIVATE SimpleIndexFile {
   DISALLOW_COPY_AND_ASSIGN(SimpleIndexFile);
 };
 
+// A read-only, memory-mapped view of an index file in the format of version 10
+// and later. It answers lookups right after the file is mapped, by binary
+// search in the entries of the shard of the hash, so that the cache can tell
+// hits from misses while the index is still being loaded.
+//
+// Opening the file only checks that it's well-formed, not its checksum, so
+// that it doesn't need to read the whole file: answers from a corrupt file may
+// be wrong until the index finishes loading, which does verify the checksum.
+// The methods must be called on a single sequence.
+class NET_EXPORT_PRIVATE MappedIndexFile {
+ public:
+  ~MappedIndexFile();
+
+  // Returns nullptr if |index_filename| can't be mapped or isn't a well-formed
+  // index file of version 10 or later.
+  static std::unique_ptr<MappedIndexFile> Open(
+      net::CacheType cache_type,
+      const base::FilePath& index_filename);
+
+  // Returns whether the index file has an entry for |entry_hash|, and if so
+  // and |out_metadata| isn't null, stores its metadata there.
+  bool Lookup(uint64_t entry_hash, EntryMetadata* out_metadata) const;
+
+  uint64_t entry_count() const { return entry_count_; }
+
+  // The modification time of the cache directory when the index was written.
+  base::Time cache_last_modified() const { return cache_last_modified_; }
+
+ private:
+  MappedIndexFile(net::CacheType cache_type,
+                  std::unique_ptr<base::MemoryMappedFile> file);
+
+  // Parses and validates the headers and shard table of |file_|.
+  bool Initialize();
+
+  const net::CacheType cache_type_;
+  const std::unique_ptr<base::MemoryMappedFile> file_;
+
+  uint64_t entry_count_ = 0;
+  base::Time cache_last_modified_;
+
+  // The serialized entries, and the index of the first entry of each shard.
+  // The entries of shard i are [shard_begin_[i], shard_begin_[i + 1]).
+  const char* entries_ = nullptr;
+  std::array<uint64_t, SimpleIndex::EntrySet::kShardCount + 1> shard_begin_;
+
+  DISALLOW_COPY_AND_ASSIGN(MappedIndexFile);
+};
 
 }  // namespace disk_cache
 
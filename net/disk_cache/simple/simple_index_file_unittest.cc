@@ -4,7 +4,12 @@
 
 #include "net/disk_cache/simple/simple_index_file.h"
 
+#include <string.h>
+
+#include <limits>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "base/files/file.h"
 #include "base/files/file_util.h"
@@ -16,6 +21,7 @@
 #include "base/run_loop.h"
 #include "base/single_thread_task_runner.h"
 #include "base/stl_util.h"
+#include "base/test/bind_test_util.h"
 #include "base/threading/thread.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "base/time/time.h"
@@ -149,12 +155,23 @@ class V8IndexMetadataForTest : public SimpleIndexFile::IndexMetadata {
 
 // This friend derived class is able to reexport its ancestors private methods
 // as public, for use in tests.
+class V9IndexMetadataForTest : public SimpleIndexFile::IndexMetadata {
+ public:
+  V9IndexMetadataForTest(uint64_t entry_count, uint64_t cache_size)
+      : SimpleIndexFile::IndexMetadata(SimpleIndex::INDEX_WRITE_REASON_SHUTDOWN,
+                                       entry_count,
+                                       cache_size) {
+    version_ = 9;
+  }
+};
+
 class WrappedSimpleIndexFile : public SimpleIndexFile {
  public:
   using SimpleIndexFile::Deserialize;
   using SimpleIndexFile::LegacyIsIndexFileStale;
   using SimpleIndexFile::Serialize;
   using SimpleIndexFile::SerializeFinalData;
+  using SimpleIndexFile::SerializeIncrementally;
 
   explicit WrappedSimpleIndexFile(const base::FilePath& index_file_directory)
       : SimpleIndexFile(base::ThreadTaskRunnerHandle::Get(),
@@ -233,6 +250,55 @@ TEST_F(SimpleIndexFileTest, Serialize) {
   }
 }
 
+// Serializing only the dirty shards gives the same result as serializing
+// everything.
+TEST_F(SimpleIndexFileTest, SerializeIncrementally) {
+  SimpleIndex::EntrySet entries;
+  const uint64_t kNumHashes = 1000;
+  for (uint64_t hash = 1; hash <= kNumHashes; ++hash) {
+    SimpleIndex::InsertInEntrySet(
+        hash, EntryMetadata(Time(), static_cast<uint32_t>(hash)), &entries);
+  }
+  std::vector<std::string> serialized_shards;
+  SimpleIndexFile::IndexMetadata index_metadata(
+      SimpleIndex::INDEX_WRITE_REASON_SHUTDOWN, entries.size(), 456);
+  WrappedSimpleIndexFile::SerializeIncrementally(
+      net::DISK_CACHE, index_metadata, entries, &serialized_shards);
+  EXPECT_EQ(SimpleIndex::EntrySet::kShardCount, serialized_shards.size());
+  entries.ClearDirtyShards();
+
+  // Modify, remove and add a few entries.
+  entries.find(10)->second.SetEntrySize(12345u);
+  entries.erase(20);
+  SimpleIndex::InsertInEntrySet(kNumHashes + 1, EntryMetadata(Time(), 1u),
+                                &entries);
+  SimpleIndexFile::IndexMetadata new_index_metadata(
+      SimpleIndex::INDEX_WRITE_REASON_SHUTDOWN, entries.size(), 456);
+  std::unique_ptr<base::Pickle> incremental_pickle =
+      WrappedSimpleIndexFile::SerializeIncrementally(
+          net::DISK_CACHE, new_index_metadata, entries, &serialized_shards);
+  std::unique_ptr<base::Pickle> full_pickle = WrappedSimpleIndexFile::Serialize(
+      net::DISK_CACHE, new_index_metadata, entries);
+  ASSERT_EQ(full_pickle->size(), incremental_pickle->size());
+  EXPECT_EQ(0, memcmp(full_pickle->data(), incremental_pickle->data(),
+                      full_pickle->size()));
+
+  WrappedSimpleIndexFile::SerializeFinalData(base::Time::Now(),
+                                             incremental_pickle.get());
+  base::Time when_index_last_saw_cache;
+  SimpleIndexLoadResult deserialize_result;
+  WrappedSimpleIndexFile::Deserialize(
+      net::DISK_CACHE, static_cast<const char*>(incremental_pickle->data()),
+      incremental_pickle->size(), &when_index_last_saw_cache,
+      &deserialize_result);
+  EXPECT_TRUE(deserialize_result.did_load);
+  const SimpleIndex::EntrySet& new_entries = deserialize_result.entries;
+  EXPECT_EQ(kNumHashes, new_entries.size());
+  EXPECT_EQ(RoundSize(12345u), new_entries.find(10)->second.GetEntrySize());
+  EXPECT_EQ(0u, new_entries.count(20));
+  EXPECT_EQ(1u, new_entries.count(kNumHashes + 1));
+}
+
 TEST_F(SimpleIndexFileTest, SerializeAppCache) {
   SimpleIndex::EntrySet entries;
   static const uint64_t kHashes[] = {11, 22, 33};
@@ -411,6 +477,44 @@ TEST_F(SimpleIndexFileTest, ReadV8FormatAppCache) {
   }
 }
 
+TEST_F(SimpleIndexFileTest, ReadV9Format) {
+  static const uint64_t kHashes[] = {11, 22, 33};
+  static const size_t kNumHashes = base::size(kHashes);
+
+  // V9 to V10 only adds the shard table, which V9 files don't have.
+  V9IndexMetadataForTest v9_metadata(kNumHashes, 100 * 1024 * 1024);
+  EXPECT_FALSE(v9_metadata.has_shard_table());
+
+  EntryMetadata metadata_entries[kNumHashes];
+  SimpleIndex::EntrySet entries;
+  for (size_t i = 0; i < kNumHashes; ++i) {
+    metadata_entries[i] =
+        EntryMetadata(base::Time::Now(), static_cast<uint32_t>(kHashes[i]));
+    metadata_entries[i].SetInMemoryData(static_cast<uint8_t>(i));
+    SimpleIndex::InsertInEntrySet(kHashes[i], metadata_entries[i], &entries);
+  }
+  std::unique_ptr<base::Pickle> pickle =
+      WrappedSimpleIndexFile::Serialize(net::DISK_CACHE, v9_metadata, entries);
+  ASSERT_TRUE(pickle.get() != NULL);
+  base::Time now = base::Time::Now();
+  WrappedSimpleIndexFile::SerializeFinalData(now, pickle.get());
+
+  base::Time when_index_last_saw_cache;
+  SimpleIndexLoadResult deserialize_result;
+  WrappedSimpleIndexFile::Deserialize(
+      net::DISK_CACHE, static_cast<const char*>(pickle->data()), pickle->size(),
+      &when_index_last_saw_cache, &deserialize_result);
+  EXPECT_TRUE(deserialize_result.did_load);
+  EXPECT_EQ(now, when_index_last_saw_cache);
+  const SimpleIndex::EntrySet& new_entries = deserialize_result.entries;
+  ASSERT_EQ(entries.size(), new_entries.size());
+  for (size_t i = 0; i < kNumHashes; ++i) {
+    auto it = new_entries.find(kHashes[i]);
+    ASSERT_TRUE(new_entries.end() != it);
+    EXPECT_TRUE(CompareTwoEntryMetadata(it->second, metadata_entries[i]));
+  }
+}
+
 TEST_F(SimpleIndexFileTest, LegacyIsIndexFileStale) {
   base::ScopedTempDir cache_dir;
   ASSERT_TRUE(cache_dir.CreateUniqueTempDir());
@@ -486,6 +590,109 @@ TEST_F(SimpleIndexFileTest, WriteThenLoadIndex) {
     EXPECT_EQ(1U, load_index_result.entries.count(kHashes[i]));
 }
 
+TEST_F(SimpleIndexFileTest, WriteThenMapIndex) {
+  base::ScopedTempDir cache_dir;
+  ASSERT_TRUE(cache_dir.CreateUniqueTempDir());
+
+  SimpleIndex::EntrySet entries;
+  const uint64_t kNumHashes = 1000;
+  for (uint64_t i = 0; i < kNumHashes; ++i) {
+    // Spread the hashes over the shards, and over the whole range.
+    const uint64_t hash = (i + 1) * UINT64_C(0x9E3779B97F4A7C15);
+    EntryMetadata metadata(Time::Now(), static_cast<uint32_t>(i * 256));
+    metadata.SetInMemoryData(static_cast<uint8_t>(i));
+    SimpleIndex::InsertInEntrySet(hash, metadata, &entries);
+  }
+
+  net::TestClosure closure;
+  WrappedSimpleIndexFile simple_index_file(cache_dir.GetPath());
+  simple_index_file.WriteToDisk(
+      net::DISK_CACHE, SimpleIndex::INDEX_WRITE_REASON_SHUTDOWN, entries,
+      kNumHashes * 256, base::TimeTicks(), false, closure.closure());
+  closure.WaitForResult();
+
+  std::unique_ptr<MappedIndexFile> mapped_index = MappedIndexFile::Open(
+      net::DISK_CACHE, simple_index_file.GetIndexFilePath());
+  ASSERT_TRUE(mapped_index);
+  EXPECT_EQ(kNumHashes, mapped_index->entry_count());
+  for (const auto& entry : entries) {
+    EntryMetadata metadata;
+    ASSERT_TRUE(mapped_index->Lookup(entry.first, &metadata));
+    EXPECT_TRUE(CompareTwoEntryMetadata(entry.second, metadata));
+    EXPECT_TRUE(mapped_index->Lookup(entry.first, nullptr));
+    EXPECT_FALSE(mapped_index->Lookup(entry.first + 1, nullptr));
+  }
+  EXPECT_FALSE(mapped_index->Lookup(0, nullptr));
+  EXPECT_FALSE(mapped_index->Lookup(std::numeric_limits<uint64_t>::max(),
+                                    nullptr));
+
+  // MapIndexFile() only returns the mapping if the index is fresh.
+  base::Time cache_mtime;
+  ASSERT_TRUE(simple_util::GetMTime(cache_dir.GetPath(), &cache_mtime));
+  {
+    base::RunLoop run_loop;
+    simple_index_file.MapIndexFile(
+        cache_mtime,
+        base::BindLambdaForTesting(
+            [&](std::unique_ptr<MappedIndexFile> result) {
+              EXPECT_TRUE(result);
+              run_loop.Quit();
+            }));
+    run_loop.Run();
+  }
+  {
+    base::RunLoop run_loop;
+    simple_index_file.MapIndexFile(
+        cache_mtime + base::TimeDelta::FromMinutes(1),
+        base::BindLambdaForTesting(
+            [&](std::unique_ptr<MappedIndexFile> result) {
+              EXPECT_FALSE(result);
+              run_loop.Quit();
+            }));
+    run_loop.Run();
+  }
+}
+
+// Index files from before version 10, and truncated ones, can't be mapped.
+TEST_F(SimpleIndexFileTest, MapUnmappableIndex) {
+  base::ScopedTempDir cache_dir;
+  ASSERT_TRUE(cache_dir.CreateUniqueTempDir());
+  const base::FilePath index_path = cache_dir.GetPath().AppendASCII("index");
+
+  SimpleIndex::EntrySet entries;
+  SimpleIndex::InsertInEntrySet(11, EntryMetadata(Time(), 11u), &entries);
+  SimpleIndex::InsertInEntrySet(22, EntryMetadata(Time(), 22u), &entries);
+
+  V9IndexMetadataForTest v9_metadata(entries.size(), 33);
+  std::unique_ptr<base::Pickle> pickle =
+      WrappedSimpleIndexFile::Serialize(net::DISK_CACHE, v9_metadata, entries);
+  WrappedSimpleIndexFile::SerializeFinalData(base::Time::Now(), pickle.get());
+  ASSERT_EQ(static_cast<int>(pickle->size()),
+            base::WriteFile(index_path,
+                            static_cast<const char*>(pickle->data()),
+                            pickle->size()));
+  EXPECT_FALSE(MappedIndexFile::Open(net::DISK_CACHE, index_path));
+
+  SimpleIndexFile::IndexMetadata metadata(
+      SimpleIndex::INDEX_WRITE_REASON_SHUTDOWN, entries.size(), 33);
+  pickle =
+      WrappedSimpleIndexFile::Serialize(net::DISK_CACHE, metadata, entries);
+  WrappedSimpleIndexFile::SerializeFinalData(base::Time::Now(), pickle.get());
+  ASSERT_EQ(static_cast<int>(pickle->size()),
+            base::WriteFile(index_path,
+                            static_cast<const char*>(pickle->data()),
+                            pickle->size()));
+  EXPECT_TRUE(MappedIndexFile::Open(net::DISK_CACHE, index_path));
+
+  ASSERT_EQ(static_cast<int>(pickle->size() - 8),
+            base::WriteFile(index_path,
+                            static_cast<const char*>(pickle->data()),
+                            pickle->size() - 8));
+  EXPECT_FALSE(MappedIndexFile::Open(net::DISK_CACHE, index_path));
+  EXPECT_FALSE(MappedIndexFile::Open(net::DISK_CACHE,
+                                     cache_dir.GetPath().AppendASCII("none")));
+}
+
 TEST_F(SimpleIndexFileTest, LoadCorruptIndex) {
   base::ScopedTempDir cache_dir;
   ASSERT_TRUE(cache_dir.CreateUniqueTempDir());
@@ -21,8 +21,10 @@
 #include "base/test/mock_entropy_provider.h"
 #include "base/test/scoped_feature_list.h"
 #include "base/threading/platform_thread.h"
+#include "base/threading/thread_task_runner_handle.h"
 #include "base/time/time.h"
 #include "net/base/cache_type.h"
+#include "net/base/test_completion_callback.h"
 #include "net/disk_cache/backend_cleanup_tracker.h"
 #include "net/disk_cache/simple/simple_index_delegate.h"
 #include "net/disk_cache/simple/simple_index_file.h"
@@ -77,6 +79,11 @@ class MockSimpleIndexFile : public SimpleIndexFile,
     ++load_index_entries_calls_;
   }
 
+  void MapIndexFile(base::Time cache_last_modified,
+                    MapIndexCallback callback) override {
+    map_callback_ = std::move(callback);
+  }
+
   void WriteToDisk(net::CacheType cache_type,
                    SimpleIndex::IndexWriteToDiskReason reason,
                    const SimpleIndex::EntrySet& entry_set,
@@ -93,12 +100,14 @@ class MockSimpleIndexFile : public SimpleIndexFile,
   }
 
   const base::Closure& load_callback() const { return load_callback_; }
+  MapIndexCallback TakeMapCallback() { return std::move(map_callback_); }
   SimpleIndexLoadResult* load_result() const { return load_result_; }
   int load_index_entries_calls() const { return load_index_entries_calls_; }
   int disk_writes() const { return disk_writes_; }
 
  private:
   base::Closure load_callback_;
+  MapIndexCallback map_callback_;
   SimpleIndexLoadResult* load_result_ = nullptr;
   int load_index_entries_calls_ = 0;
   int disk_writes_ = 0;
@@ -329,6 +338,54 @@ TEST_F(SimpleIndexTest, Has) {
   index()->Remove(kHash1);
 }
 
+// Once the index file is mapped, "Has()" answers from it before the index is
+// initialized.
+TEST_F(SimpleIndexTest, HasWithMappedIndex) {
+  base::ScopedTempDir cache_dir;
+  ASSERT_TRUE(cache_dir.CreateUniqueTempDir());
+  {
+    SimpleIndex::EntrySet entries;
+    SimpleIndex::InsertInEntrySet(
+        hashes_.at<1>(), EntryMetadata(base::Time::Now(), 256u), &entries);
+    SimpleIndex::InsertInEntrySet(
+        hashes_.at<2>(), EntryMetadata(base::Time::Now(), 256u), &entries);
+    SimpleIndexFile index_file(base::ThreadTaskRunnerHandle::Get(),
+                               base::ThreadTaskRunnerHandle::Get(),
+                               CacheType(), cache_dir.GetPath());
+    net::TestClosure closure;
+    index_file.WriteToDisk(CacheType(),
+                           SimpleIndex::INDEX_WRITE_REASON_SHUTDOWN, entries,
+                           512u, base::TimeTicks(), false, closure.closure());
+    closure.WaitForResult();
+  }
+
+  EXPECT_FALSE(index()->lookups_ready());
+  EXPECT_TRUE(index()->Has(hashes_.at<3>()));
+  std::unique_ptr<MappedIndexFile> mapped_index = MappedIndexFile::Open(
+      CacheType(), cache_dir.GetPath()
+                       .AppendASCII("index-dir")
+                       .AppendASCII("the-real-index"));
+  ASSERT_TRUE(mapped_index);
+  index_file_->TakeMapCallback().Run(std::move(mapped_index));
+  EXPECT_TRUE(index()->lookups_ready());
+  EXPECT_FALSE(index()->initialized());
+
+  EXPECT_TRUE(index()->Has(hashes_.at<1>()));
+  EXPECT_TRUE(index()->Has(hashes_.at<2>()));
+  EXPECT_FALSE(index()->Has(hashes_.at<3>()));
+  index()->Remove(hashes_.at<2>());
+  EXPECT_FALSE(index()->Has(hashes_.at<2>()));
+  index()->Insert(hashes_.at<3>());
+  EXPECT_TRUE(index()->Has(hashes_.at<3>()));
+
+  // The loaded entries replace the mapping.
+  InsertIntoIndexFileReturn(hashes_.at<1>(), base::Time::Now(), 256);
+  ReturnIndexFile();
+  EXPECT_TRUE(index()->Has(hashes_.at<1>()));
+  EXPECT_FALSE(index()->Has(hashes_.at<2>()));
+  EXPECT_TRUE(index()->Has(hashes_.at<3>()));
+}
+
 TEST_F(SimpleIndexTest, UseIfExists) {
   // Confirm the base index has dispatched the request for index entries.
   EXPECT_TRUE(index_file_.get());
@@ -707,6 +764,65 @@ TEST_F(SimpleIndexTest, EvictBySize2) {
   ASSERT_EQ(2u, last_doom_entry_hashes().size());
 }
 
+// Large indices pick the entries to evict by sampling; they should still be
+// among the least recently used ones.
+TEST_F(SimpleIndexTest, EvictBySampling) {
+  base::test::ScopedFeatureList features;
+  features.InitAndDisableFeature(kSimpleCacheEvictionWithSize);
+
+  const int kEntries = 100000;
+  const uint32_t kEntrySize = 256u;
+  const base::Time oldest = base::Time::Now() - base::TimeDelta::FromDays(2);
+  for (int i = 0; i < kEntries; ++i) {
+    InsertIntoIndexFileReturn(i + 1, oldest + base::TimeDelta::FromSeconds(i),
+                              kEntrySize);
+  }
+  index()->SetMaxSize(kEntries * kEntrySize);
+  ReturnIndexFile();
+  EXPECT_EQ(0, doom_entries_calls());
+
+  index()->UpdateEntrySize(kEntries, 2 * kEntrySize);
+  EXPECT_EQ(1, doom_entries_calls());
+  // About a tenth of the cache is evicted.
+  EXPECT_LE(index()->GetCacheSize(), kEntries * kEntrySize * 9 / 10);
+  EXPECT_GT(index()->GetCacheSize(), kEntries * kEntrySize * 8 / 10);
+  for (uint64_t entry_hash : last_doom_entry_hashes())
+    EXPECT_LE(entry_hash, static_cast<uint64_t>(kEntries / 2));
+}
+
+TEST(ShardedEntrySetTest, DirtyShards) {
+  ShardedEntrySet entry_set;
+  const uint64_t kHash1 = 1;
+  const uint64_t kHash2 = 2;
+  const size_t kShard1 = ShardedEntrySet::GetShardIndex(kHash1);
+  const size_t kShard2 = ShardedEntrySet::GetShardIndex(kHash2);
+  ASSERT_NE(kShard1, kShard2);
+
+  entry_set.insert(std::make_pair(kHash1, EntryMetadata()));
+  entry_set.insert(std::make_pair(kHash2, EntryMetadata()));
+  EXPECT_EQ(2u, entry_set.size());
+  EXPECT_TRUE(entry_set.IsShardDirty(kShard1));
+  EXPECT_TRUE(entry_set.IsShardDirty(kShard2));
+
+  entry_set.ClearDirtyShards();
+  EXPECT_FALSE(entry_set.IsShardDirty(kShard1));
+  EXPECT_FALSE(entry_set.IsShardDirty(kShard2));
+
+  // Const lookups don't dirty the shard, but modifying lookups do.
+  const ShardedEntrySet& const_entry_set = entry_set;
+  EXPECT_NE(const_entry_set.end(), const_entry_set.find(kHash1));
+  EXPECT_FALSE(entry_set.IsShardDirty(kShard1));
+  entry_set.find(kHash1)->second.SetInMemoryData(1);
+  EXPECT_TRUE(entry_set.IsShardDirty(kShard1));
+  EXPECT_FALSE(entry_set.IsShardDirty(kShard2));
+
+  EXPECT_EQ(1u, entry_set.erase(kHash2));
+  EXPECT_TRUE(entry_set.IsShardDirty(kShard2));
+  EXPECT_EQ(1u, entry_set.size());
+  ASSERT_NE(const_entry_set.end(), const_entry_set.begin());
+  EXPECT_EQ(kHash1, entry_set.begin()->first);
+}
+
 // Confirm all the operations queue a disk write at some point in the
 // future.
 TEST_F(SimpleIndexTest, DiskWriteQueued) {
@@ -8,6 +8,8 @@
 #include <cstring>
 #include <functional>
 #include <limits>
+#include <utility>
+#include <vector>
 
 #include "base/compiler_specific.h"
 #include "base/containers/stack_container.h"
@@ -123,6 +125,34 @@ int FileIndexForSubFile(SimpleFileTracker::SubFile sub_file) {
   return sub_file == SimpleFileTracker::SubFile::FILE_0 ? 0 : 1;
 }
 
+// A piece of data to write, and its offset in the file.
+using PendingWrite = std::pair<int64_t, base::StringPiece>;
+
+// Writes |writes| to |file| with one vectored write per run of adjacent
+// pieces. Returns the number of writes issued, or -1 on failure.
+int WriteCoalesced(base::File* file, std::vector<PendingWrite>* writes) {
+  std::stable_sort(writes->begin(), writes->end(),
+                   [](const PendingWrite& a, const PendingWrite& b) {
+                     return a.first < b.first;
+                   });
+  int write_count = 0;
+  size_t i = 0;
+  while (i < writes->size()) {
+    const int64_t offset = (*writes)[i].first;
+    int64_t end = offset;
+    std::vector<base::StringPiece> run;
+    while (i < writes->size() && (*writes)[i].first == end) {
+      run.push_back((*writes)[i].second);
+      end += (*writes)[i].second.size();
+      ++i;
+    }
+    ++write_count;
+    if (!simple_util::WriteVectored(file, offset, run))
+      return -1;
+  }
+  return write_count;
+}
+
 }  // namespace
 
 // Helper class to track a range of data prefetched from a file.
@@ -376,6 +406,7 @@ void SimpleSynchronousEntry::OpenEntry(
   out_results->sync_entry = sync_entry;
   out_results->computed_trailer_prefetch_size =
       sync_entry->computed_trailer_prefetch_size();
+  sync_entry->opened_ = true;
 }
 
 // static
@@ -565,6 +596,7 @@ void SimpleSynchronousEntry::ReadData(const ReadRequest& in_entry_op,
   // be handled in the SimpleEntryImpl.
   DCHECK_GT(in_entry_op.buf_len, 0);
   DCHECK(!empty_file_omitted_[file_index]);
+  ++syscall_count_;
   int bytes_read =
       file->Read(file_offset, out_buf->data(), in_entry_op.buf_len);
   if (bytes_read > 0) {
@@ -668,6 +700,7 @@ void SimpleSynchronousEntry::WriteData(const WriteRequest& in_entry_op,
     // The EOF record and the eventual stream afterward need to be zeroed out.
     const int64_t file_eof_offset =
         out_entry_stat->GetEOFOffsetInFile(key_.size(), index);
+    ++syscall_count_;
     if (!file->SetLength(file_eof_offset)) {
       RecordWriteResult(cache_type_, SYNC_WRITE_RESULT_PRETRUNCATE_FAILURE);
       Doom();
@@ -676,6 +709,7 @@ void SimpleSynchronousEntry::WriteData(const WriteRequest& in_entry_op,
     }
   }
   if (buf_len > 0) {
+    ++syscall_count_;
     if (file->Write(file_offset, in_buf->data(), buf_len) != buf_len) {
       RecordWriteResult(cache_type_, SYNC_WRITE_RESULT_WRITE_FAILURE);
       Doom();
@@ -690,6 +724,7 @@ void SimpleSynchronousEntry::WriteData(const WriteRequest& in_entry_op,
     out_entry_stat->set_data_size(index, offset + buf_len);
     int file_eof_offset =
         out_entry_stat->GetLastEOFOffsetInFile(key_.size(), index);
+    ++syscall_count_;
     if (!file->SetLength(file_eof_offset)) {
       RecordWriteResult(cache_type_, SYNC_WRITE_RESULT_TRUNCATE_FAILURE);
       Doom();
@@ -1007,38 +1042,30 @@ void SimpleSynchronousEntry::Close(
   base::ElapsedTimer close_time;
   DCHECK(stream_0_data);
 
+  // The writes are collected per file, so that the adjacent ones can be issued
+  // together: stream 1's EOF record, stream 0, sha256(key) and stream 0's EOF
+  // record are contiguous at the end of file 0.
+  std::vector<PendingWrite> writes[kSimpleEntryNormalFileCount];
+  SimpleFileEOF eof_records[kSimpleEntryStreamCount];
+  net::SHA256HashValue key_sha256;
+  bool failed = false;
   for (auto it = crc32s_to_write->begin(); it != crc32s_to_write->end(); ++it) {
     const int stream_index = it->index;
     const int file_index = GetFileIndexFromStreamIndex(stream_index);
     if (empty_file_omitted_[file_index])
       continue;
 
-    SimpleFileTracker::FileHandle file =
-        file_tracker_->Acquire(this, SubFileForFileIndex(file_index));
-    if (!file.IsOK()) {
-      RecordCloseResult(cache_type_, CLOSE_RESULT_WRITE_FAILURE);
-      Doom();
-      break;
-    }
-
     if (stream_index == 0) {
       // Write stream 0 data.
       int stream_0_offset = entry_stat.GetOffsetInFile(key_.size(), 0, 0);
-      if (file->Write(stream_0_offset, stream_0_data->data(),
-                      entry_stat.data_size(0)) != entry_stat.data_size(0)) {
-        RecordCloseResult(cache_type_, CLOSE_RESULT_WRITE_FAILURE);
-        DVLOG(1) << "Could not write stream 0 data.";
-        Doom();
-      }
-      net::SHA256HashValue hash_value;
-      CalculateSHA256OfKey(key_, &hash_value);
-      if (file->Write(stream_0_offset + entry_stat.data_size(0),
-                      reinterpret_cast<char*>(hash_value.data),
-                      sizeof(hash_value)) != sizeof(hash_value)) {
-        RecordCloseResult(cache_type_, CLOSE_RESULT_WRITE_FAILURE);
-        DVLOG(1) << "Could not write stream 0 data.";
-        Doom();
-      }
+      writes[file_index].emplace_back(
+          stream_0_offset,
+          base::StringPiece(stream_0_data->data(), entry_stat.data_size(0)));
+      CalculateSHA256OfKey(key_, &key_sha256);
+      writes[file_index].emplace_back(
+          stream_0_offset + entry_stat.data_size(0),
+          base::StringPiece(reinterpret_cast<char*>(key_sha256.data),
+                            sizeof(key_sha256)));
 
       // Re-compute stream 0 CRC if the data got changed (we may be here even
       // if it didn't change if stream 0's position on disk got changed due to
@@ -1050,10 +1077,10 @@ void SimpleSynchronousEntry::Close(
       }
 
       out_results->estimated_trailer_prefetch_size =
-          entry_stat.data_size(0) + sizeof(hash_value) + sizeof(SimpleFileEOF);
+          entry_stat.data_size(0) + sizeof(key_sha256) + sizeof(SimpleFileEOF);
     }
 
-    SimpleFileEOF eof_record;
+    SimpleFileEOF& eof_record = eof_records[stream_index];
     eof_record.stream_size = entry_stat.data_size(stream_index);
     eof_record.final_magic_number = kSimpleFinalMagicNumber;
     eof_record.flags = 0;
@@ -1066,19 +1093,36 @@ void SimpleSynchronousEntry::Close(
     // If stream 0 changed size, the file needs to be resized, otherwise the
     // next open will yield wrong stream sizes. On stream 1 and stream 2 proper
     // resizing of the file is handled in SimpleSynchronousEntry::WriteData().
-    if (stream_index == 0 && !file->SetLength(eof_offset)) {
-      RecordCloseResult(cache_type_, CLOSE_RESULT_WRITE_FAILURE);
-      DVLOG(1) << "Could not truncate stream 0 file.";
-      Doom();
-      break;
+    if (stream_index == 0) {
+      SimpleFileTracker::FileHandle file =
+          file_tracker_->Acquire(this, SubFileForFileIndex(file_index));
+      ++syscall_count_;
+      if (!file.IsOK() || !file->SetLength(eof_offset)) {
+        RecordCloseResult(cache_type_, CLOSE_RESULT_WRITE_FAILURE);
+        DVLOG(1) << "Could not truncate stream 0 file.";
+        Doom();
+        failed = true;
+        break;
+      }
     }
-    if (file->Write(eof_offset, reinterpret_cast<const char*>(&eof_record),
-                    sizeof(eof_record)) != sizeof(eof_record)) {
+    writes[file_index].emplace_back(
+        eof_offset,
+        base::StringPiece(reinterpret_cast<const char*>(&eof_record),
+                          sizeof(eof_record)));
+  }
+  for (int i = 0; i < kSimpleEntryNormalFileCount && !failed; ++i) {
+    if (writes[i].empty())
+      continue;
+    SimpleFileTracker::FileHandle file =
+        file_tracker_->Acquire(this, SubFileForFileIndex(i));
+    int write_count = file.IsOK() ? WriteCoalesced(file.get(), &writes[i]) : -1;
+    if (write_count < 0) {
       RecordCloseResult(cache_type_, CLOSE_RESULT_WRITE_FAILURE);
-      DVLOG(1) << "Could not write eof record.";
+      DVLOG(1) << "Could not write stream 0 data or eof records.";
       Doom();
       break;
     }
+    syscall_count_ += write_count;
   }
   for (int i = 0; i < kSimpleEntryNormalFileCount; ++i) {
     if (empty_file_omitted_[i])
@@ -1090,6 +1134,8 @@ void SimpleSynchronousEntry::Close(
       if (!file.IsOK() || !CheckHeaderAndKey(file.get(), i))
         Doom();
     }
+    if (!empty_file_omitted_[i])
+      ++syscall_count_;
     CloseFile(i);
   }
 
@@ -1100,6 +1146,8 @@ void SimpleSynchronousEntry::Close(
   SIMPLE_CACHE_UMA(TIMES, "DiskCloseLatency", cache_type_,
                    close_time.Elapsed());
   RecordCloseResult(cache_type_, CLOSE_RESULT_SUCCESS);
+  out_results->syscall_count = syscall_count_;
+  out_results->opened = opened_;
   have_open_files_ = false;
   delete this;
 }
@@ -1137,6 +1185,7 @@ bool SimpleSynchronousEntry::MaybeOpenFile(int file_index,
               base::File::FLAG_WRITE | base::File::FLAG_SHARE_DELETE;
   std::unique_ptr<base::File> file =
       std::make_unique<base::File>(filename, flags);
+  ++syscall_count_;
   *out_error = file->error_details();
 
   if (CanOmitEmptyFile(file_index) && !file->IsValid() &&
@@ -1236,6 +1285,7 @@ bool SimpleSynchronousEntry::OpenFiles(SimpleEntryStat* out_entry_stat) {
     base::File::Info file_info;
     SimpleFileTracker::FileHandle file =
         file_tracker_->Acquire(this, SubFileForFileIndex(i));
+    ++syscall_count_;
     bool success = file.IsOK() && file->GetInfo(&file_info);
     if (!success) {
       DLOG(WARNING) << "Could not get platform file info.";
@@ -1359,6 +1409,7 @@ bool SimpleSynchronousEntry::CheckHeaderAndKey(base::File* file,
                                                int file_index) {
   std::vector<char> header_data(key_.empty() ? kInitialHeaderRead
                                              : GetHeaderSize(key_.size()));
+  ++syscall_count_;
   int bytes_read = file->Read(0, header_data.data(), header_data.size());
   const SimpleFileHeader* header =
       reinterpret_cast<const SimpleFileHeader*>(header_data.data());
@@ -1388,6 +1439,7 @@ bool SimpleSynchronousEntry::CheckHeaderAndKey(base::File* file,
     int bytes_to_read = expected_header_size - old_size;
     // This resize will invalidate iterators, since it is enlarging header_data.
     header_data.resize(expected_header_size);
+    ++syscall_count_;
     int bytes_read =
         file->Read(old_size, header_data.data() + old_size, bytes_to_read);
     if (bytes_read != bytes_to_read) {
@@ -1597,6 +1649,7 @@ int SimpleSynchronousEntry::ReadAndValidateStream0AndMaybe1(
     // Prefetch the entire file.
     prefetch_mode = OPEN_PREFETCH_FULL;
     RecordOpenPrefetchMode(cache_type_, prefetch_mode);
+    ++syscall_count_;
     if (!prefetch_data.PrefetchFromFile(&file, 0, file_size))
       return net::ERR_FAILED;
   } else if (trailer_prefetch_size > 0) {
@@ -1605,6 +1658,7 @@ int SimpleSynchronousEntry::ReadAndValidateStream0AndMaybe1(
     RecordOpenPrefetchMode(cache_type_, prefetch_mode);
     size_t length = std::min(trailer_prefetch_size, file_size);
     size_t offset = file_size - length;
+    ++syscall_count_;
     if (!prefetch_data.PrefetchFromFile(&file, offset, length))
       return net::ERR_FAILED;
     SIMPLE_CACHE_UMA(COUNTS_100000, "EntryTrailerPrefetchSize", cache_type_,
@@ -1747,6 +1801,7 @@ bool SimpleSynchronousEntry::ReadFromFileOrPrefetched(
   }
 
   // If we have not prefetched the range then we must read it from disk.
+  ++syscall_count_;
   return file->Read(start_numeric, dest, length_numeric) == size;
 }
 
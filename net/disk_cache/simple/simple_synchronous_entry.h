@@ -112,6 +112,11 @@ struct SimpleEntryCreationResults {
 
 struct SimpleEntryCloseResults {
   int32_t estimated_trailer_prefetch_size = -1;
+
+  // The number of file system calls the entry made since it was opened or
+  // created, and whether it was opened rather than created.
+  int syscall_count = 0;
+  bool opened = false;
 };
 
 // Worker thread interface to the very simple cache. This interface is not
@@ -509,6 +514,11 @@ class SimpleSynchronousEntry {
   // propagated back to the index in order to optimize the next open.
   int32_t computed_trailer_prefetch_size_ = -1;
 
+  // The number of file system calls on the entry's files so far, and whether
+  // the entry was opened (rather than created) from disk.
+  int syscall_count_ = 0;
+  bool opened_ = false;
+
   // True if the corresponding stream is empty and therefore no on-disk file
   // was created to store it.
   bool empty_file_omitted_[kSimpleEntryNormalFileCount];
@@ -8,12 +8,14 @@
 #include <stdint.h>
 
 #include <string>
+#include <vector>
 
 #include "base/strings/string_piece.h"
 #include "net/base/net_export.h"
 #include "net/disk_cache/simple/simple_file_tracker.h"
 
 namespace base {
+class File;
 class FilePath;
 class Time;
 }
@@ -85,6 +87,14 @@ NET_EXPORT_PRIVATE bool GetMTime(const base::FilePath& path,
 // is possible to immediately create a new file with the same name.
 NET_EXPORT_PRIVATE bool SimpleCacheDeleteFile(const base::FilePath& path);
 
+// Writes |buffers| one after the other to |file|, starting at |offset|. Where
+// the platform supports it, this is a single vectored write rather than one
+// write per buffer. Returns false if not all the data could be written.
+NET_EXPORT_PRIVATE bool WriteVectored(
+    base::File* file,
+    int64_t offset,
+    const std::vector<base::StringPiece>& buffers);
+
 uint32_t Crc32(const char* data, int length);
 
 uint32_t IncrementalCrc32(uint32_t previous_crc, const char* data, int length);
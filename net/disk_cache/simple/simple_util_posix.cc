@@ -4,7 +4,13 @@
 
 #include "net/disk_cache/simple/simple_util.h"
 
+#include <sys/uio.h>
+
+#include "base/files/file.h"
 #include "base/files/file_util.h"
+#include "base/posix/eintr_wrapper.h"
+#include "base/threading/scoped_blocking_call.h"
+#include "build/build_config.h"
 
 namespace disk_cache {
 namespace simple_util {
@@ -13,5 +19,52 @@ bool SimpleCacheDeleteFile(const base::FilePath& path) {
   return base::DeleteFile(path, false);
 }
 
+bool WriteVectored(base::File* file,
+                   int64_t offset,
+                   const std::vector<base::StringPiece>& buffers) {
+#if defined(OS_MACOSX) || defined(OS_ANDROID)
+  // pwritev() isn't available on all the supported versions of macOS, nor in
+  // Bionic before API level 24.
+  for (const base::StringPiece& buffer : buffers) {
+    if (file->Write(offset, buffer.data(), buffer.size()) !=
+        static_cast<int>(buffer.size())) {
+      return false;
+    }
+    offset += buffer.size();
+  }
+  return true;
+#else
+  base::ScopedBlockingCall scoped_blocking_call(
+      FROM_HERE, base::BlockingType::MAY_BLOCK);
+  std::vector<struct iovec> iov(buffers.size());
+  size_t bytes_left = 0;
+  for (size_t i = 0; i < buffers.size(); ++i) {
+    iov[i].iov_base = const_cast<char*>(buffers[i].data());
+    iov[i].iov_len = buffers[i].size();
+    bytes_left += buffers[i].size();
+  }
+
+  size_t first = 0;
+  while (bytes_left > 0) {
+    ssize_t rv = HANDLE_EINTR(pwritev(file->GetPlatformFile(), &iov[first],
+                                      iov.size() - first, offset));
+    if (rv <= 0)
+      return false;
+    offset += rv;
+    bytes_left -= rv;
+
+    // Skip what was written, in case the write was partial.
+    size_t written = rv;
+    while (written > 0 && written >= iov[first].iov_len)
+      written -= iov[first++].iov_len;
+    if (written > 0) {
+      iov[first].iov_base = static_cast<char*>(iov[first].iov_base) + written;
+      iov[first].iov_len -= written;
+    }
+  }
+  return true;
+#endif
+}
+
 }  // namespace simple_util
 }  // namespace disk_cache
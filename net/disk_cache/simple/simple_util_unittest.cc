@@ -4,7 +4,11 @@
 
 #include <stdint.h>
 #include <string>
+#include <vector>
 
+#include "base/files/file.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
 #include "base/logging.h"
 #include "net/disk_cache/simple/simple_util.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -15,6 +19,7 @@ using disk_cache::simple_util::GetEntryHashKeyFromHexString;
 using disk_cache::simple_util::GetEntryHashKey;
 using disk_cache::simple_util::GetFileSizeFromDataSize;
 using disk_cache::simple_util::GetDataSizeFromFileSize;
+using disk_cache::simple_util::WriteVectored;
 
 class SimpleUtilTest : public testing::Test {};
 
@@ -76,3 +81,22 @@ TEST_F(SimpleUtilTest, SizesAndOffsets) {
   const int file_size = GetFileSizeFromDataSize(key.size(), data_size);
   EXPECT_EQ(data_size, GetDataSizeFromFileSize(key.size(), file_size));
 }
+
+TEST_F(SimpleUtilTest, WriteVectored) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  const base::FilePath path = temp_dir.GetPath().AppendASCII("file");
+  base::File file(path, base::File::FLAG_CREATE | base::File::FLAG_READ |
+                            base::File::FLAG_WRITE);
+  ASSERT_TRUE(file.IsValid());
+  ASSERT_EQ(4, file.Write(0, "0123", 4));
+
+  const std::string large(100000, 'x');
+  std::vector<base::StringPiece> buffers = {"ab", "", large, "cd"};
+  ASSERT_TRUE(WriteVectored(&file, 2, buffers));
+  ASSERT_TRUE(WriteVectored(&file, 0, {}));
+
+  std::string contents;
+  ASSERT_TRUE(base::ReadFileToString(path, &contents));
+  EXPECT_EQ("01ab" + large + "cd", contents);
+}
@@ -6,6 +6,7 @@
 
 #include <windows.h>
 
+#include "base/files/file.h"
 #include "base/files/file_util.h"
 #include "base/format_macros.h"
 #include "base/rand_util.h"
@@ -41,5 +42,20 @@ bool SimpleCacheDeleteFile(const base::FilePath& path) {
   return DeleteCacheFile(path);
 }
 
+bool WriteVectored(base::File* file,
+                   int64_t offset,
+                   const std::vector<base::StringPiece>& buffers) {
+  // WriteFileGather() only works on unbuffered files, so write the buffers
+  // one at a time.
+  for (const base::StringPiece& buffer : buffers) {
+    if (file->Write(offset, buffer.data(), buffer.size()) !=
+        static_cast<int>(buffer.size())) {
+      return false;
+    }
+    offset += buffer.size();
+  }
+  return true;
+}
+
 }  // namespace simple_util
 }  // namespace disk_cache
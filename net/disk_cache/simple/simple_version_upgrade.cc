@@ -216,6 +216,11 @@ SimpleCacheConsistencyResult UpgradeSimpleCacheOnDisk(
     version_from++;
   }
 
+  if (version_from == 9) {
+    // Likewise, V9 -> V10 is handled entirely by the index reader.
+    version_from++;
+  }
+
   DCHECK_EQ(kSimpleVersion, version_from);
 
   if (!new_fake_index_needed)
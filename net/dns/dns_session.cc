@@ -285,6 +285,16 @@ base::TimeDelta DnsSession::NextTimeout(unsigned server_index, int attempt) {
   return std::min(timeout * (1 << num_backoffs), max_timeout_);
 }
 
+base::TimeDelta DnsSession::NextHedgeDelay(unsigned server_index) {
+  DCHECK_LT(server_index, server_stats_.size());
+
+  // Jacobson/Karels retransmission timeout, from the estimates updated in
+  // RecordRTT(). Until the server has responded, this is the initial timeout.
+  const ServerStats& stats = *server_stats_[server_index];
+  base::TimeDelta delay = stats.rtt_estimate + stats.rtt_deviation * 4;
+  return std::max(delay, base::TimeDelta::FromMilliseconds(kMinTimeoutMs));
+}
+
 // Allocate a socket, already connected to the server address.
 std::unique_ptr<DnsSession::SocketLease> DnsSession::AllocateSocket(
     unsigned server_index,
@@ -98,6 +98,11 @@ class NET_EXPORT_PRIVATE DnsSession
   // for exponential backoff.
   base::TimeDelta NextTimeout(unsigned server_index, int attempt);
 
+  // Return how long to wait for a response from the server before racing
+  // another server against it. Derived from the server's RTT estimate, and
+  // usually much shorter than NextTimeout().
+  base::TimeDelta NextHedgeDelay(unsigned server_index);
+
   // Allocate a socket, already connected to the server address.
   // When the SocketLease is destroyed, the socket will be freed.
   std::unique_ptr<SocketLease> AllocateSocket(unsigned server_index,
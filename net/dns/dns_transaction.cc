@@ -16,6 +16,7 @@
 #include "base/bind.h"
 #include "base/callback_helpers.h"
 #include "base/containers/circular_deque.h"
+#include "base/feature_list.h"
 #include "base/location.h"
 #include "base/macros.h"
 #include "base/memory/ptr_util.h"
@@ -34,6 +35,7 @@
 #include "build/build_config.h"
 #include "net/base/completion_once_callback.h"
 #include "net/base/elements_upload_data_stream.h"
+#include "net/base/features.h"
 #include "net/base/io_buffer.h"
 #include "net/base/ip_address.h"
 #include "net/base/ip_endpoint.h"
@@ -791,7 +793,9 @@ class DnsTCPAttempt : public DnsAttempt {
 // The timeout for each DnsUDPAttempt is given by DnsSession::NextTimeout.
 // The first server to attempt on each query is given by
 // DnsSession::NextFirstServerIndex, and the order is round-robin afterwards.
-// Each server is attempted DnsConfig::attempts times.
+// Each server is attempted DnsConfig::attempts times. With the
+// DnsHedgedQueries feature, a query that takes longer than the first server's
+// DnsSession::NextHedgeDelay is raced against the next server.
 class DnsTransactionImpl : public DnsTransaction,
                            public base::SupportsWeakPtr<DnsTransactionImpl> {
  public:
@@ -814,6 +818,7 @@ class DnsTransactionImpl : public DnsTransaction,
         doh_attempts_(0),
         had_tcp_attempt_(false),
         doh_attempt_(false),
+        had_hedged_attempt_(false),
         first_server_index_(0),
         request_priority_(DEFAULT_PRIORITY) {
     DCHECK(session_.get());
@@ -843,6 +848,7 @@ class DnsTransactionImpl : public DnsTransaction,
   void Start() override {
     DCHECK(!callback_.is_null());
     DCHECK(attempts_.empty());
+    start_time_ = base::TimeTicks::Now();
     net_log_.BeginEvent(NetLogEventType::DNS_TRANSACTION,
                         base::Bind(&NetLogStartCallback, &hostname_, qtype_));
     AttemptResult result(PrepareSearch(), NULL);
@@ -943,6 +949,15 @@ class DnsTransactionImpl : public DnsTransaction,
     bool secure = result.attempt ? result.attempt->secure() : false;
 
     timer_.Stop();
+    hedge_timer_.Stop();
+    // Cancel the attempts that lost the race.
+    ClearAttempts(result.attempt);
+
+    if (result.rv == OK) {
+      UMA_HISTOGRAM_MEDIUM_TIMES("AsyncDNS.TransactionTime",
+                                 base::TimeTicks::Now() - start_time_);
+      UMA_HISTOGRAM_BOOLEAN("AsyncDNS.TransactionHedged", had_hedged_attempt_);
+    }
 
     net_log_.EndEventWithNetErrorCode(NetLogEventType::DNS_TRANSACTION,
                                       result.rv);
@@ -951,6 +966,8 @@ class DnsTransactionImpl : public DnsTransaction,
   }
 
   AttemptResult MakeAttempt() {
+    // A new attempt replaces any hedged attempt that was yet to be made.
+    hedge_timer_.Stop();
     DnsConfig config = session_->config();
     // In AUTOMATIC and SECURE mode, make an HTTP attempt unless we have already
     // made more attempts than we have configured servers.
@@ -1013,6 +1030,18 @@ class DnsTransactionImpl : public DnsTransaction,
       base::TimeDelta timeout =
           session_->NextTimeout(non_doh_server_index, attempt_number);
       timer_.Start(FROM_HERE, timeout, this, &DnsTransactionImpl::OnTimeout);
+
+      // Only the first attempt at each name is hedged, so at most two servers
+      // are raced before the timeout.
+      if (attempt_number == doh_attempts_ && config.nameservers.size() > 1 &&
+          base::FeatureList::IsEnabled(features::kDnsHedgedQueries)) {
+        base::TimeDelta hedge_delay =
+            session_->NextHedgeDelay(non_doh_server_index);
+        if (hedge_delay < timeout) {
+          hedge_timer_.Start(FROM_HERE, hedge_delay, this,
+                             &DnsTransactionImpl::OnHedgeTimeout);
+        }
+      }
     }
     return AttemptResult(rv, attempt);
   }
@@ -1077,6 +1106,7 @@ class DnsTransactionImpl : public DnsTransaction,
     // Cancel all attempts that have not received a response, no point waiting
     // on them.
     ClearAttempts(nullptr);
+    hedge_timer_.Stop();
 
     unsigned attempt_number = attempts_.size();
 
@@ -1248,6 +1278,19 @@ class DnsTransactionImpl : public DnsTransaction,
       DoCallback(result);
   }
 
+  // Races another server against the attempt in flight, which is still
+  // waiting for a response. Unlike OnTimeout(), the slow server isn't
+  // recorded as failed, since it may still respond.
+  void OnHedgeTimeout() {
+    if (callback_.is_null() || !MoreAttemptsAllowed())
+      return;
+    DCHECK(!attempts_.empty());
+    had_hedged_attempt_ = true;
+    AttemptResult result = ProcessAttemptResult(MakeUDPAttempt());
+    if (result.rv != ERR_IO_PENDING)
+      DoCallback(result);
+  }
+
   scoped_refptr<DnsSession> session_;
   std::string hostname_;
   uint16_t qtype_;
@@ -1269,11 +1312,14 @@ class DnsTransactionImpl : public DnsTransaction,
   uint16_t doh_attempts_;
   bool had_tcp_attempt_;
   bool doh_attempt_;
+  bool had_hedged_attempt_;
 
   // Index of the first server to try on each search query.
   int first_server_index_;
 
+  base::TimeTicks start_time_;
   base::OneShotTimer timer_;
+  base::OneShotTimer hedge_timer_;
 
   URLRequestContext* url_request_context_;
   RequestPriority request_priority_;
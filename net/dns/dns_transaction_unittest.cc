@@ -21,9 +21,11 @@
 #include "base/strings/stringprintf.h"
 #include "base/sys_byteorder.h"
 #include "base/test/metrics/histogram_tester.h"
+#include "base/test/scoped_feature_list.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "base/time/time.h"
 #include "base/values.h"
+#include "net/base/features.h"
 #include "net/base/ip_address.h"
 #include "net/base/port_util.h"
 #include "net/base/upload_bytes_element_reader.h"
@@ -1155,6 +1157,37 @@ TEST_F(DnsTransactionTestWithMockTime, ServerFallbackAndRotate) {
   CheckServerOrder(kOrder, base::size(kOrder));
 }
 
+// A query that takes longer than the first server's RTT estimate is raced
+// against the next server, well before it times out.
+TEST_F(DnsTransactionTestWithMockTime, HedgedQuery) {
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitAndEnableFeature(features::kDnsHedgedQueries);
+  ConfigureNumServers(2);
+  ConfigureFactory();
+
+  // The first server usually responds quickly.
+  for (int i = 0; i < 40; ++i)
+    session_->RecordRTT(0, base::TimeDelta::FromMilliseconds(10));
+  ASSERT_LT(session_->NextHedgeDelay(0), session_->NextTimeout(0, 0));
+
+  AddQueryAndTimeout(kT0HostName, kT0Qtype);
+  AddAsyncQueryAndResponse(0 /* id */, kT0HostName, kT0Qtype,
+                           kT0ResponseDatagram,
+                           base::size(kT0ResponseDatagram));
+
+  base::HistogramTester histograms;
+  TransactionHelper helper0(kT0HostName, kT0Qtype, kT0RecordCount,
+                            false /* expected_secure */);
+  EXPECT_FALSE(helper0.Run(transaction_factory_.get()));
+  FastForwardBy(session_->NextHedgeDelay(0));
+  EXPECT_TRUE(helper0.has_completed());
+
+  unsigned kOrder[] = {0, 1};
+  CheckServerOrder(kOrder, base::size(kOrder));
+  histograms.ExpectUniqueSample("AsyncDNS.TransactionHedged", true, 1);
+  histograms.ExpectTotalCount("AsyncDNS.TransactionTime", 1);
+}
+
 TEST_F(DnsTransactionTest, SuffixSearchAboveNdots) {
   config_.ndots = 2;
   config_.search.push_back("a");
@@ -358,7 +358,8 @@ const HostCache::EntryStaleness HostCache::kNotStale = {
     base::TimeDelta::FromSeconds(-1), 0, 0};
 
 HostCache::HostCache(size_t max_entries)
-    : max_entries_(max_entries),
+    : current_network_entries_(0),
+      max_entries_(max_entries),
       network_changes_(0),
       restore_size_(0),
       delegate_(nullptr),
@@ -536,7 +537,7 @@ void HostCache::Set(const Key& key,
     result_changed =
         entry.error() == OK && (it->second.error() != entry.error() ||
                                 overall_delta != DELTA_IDENTICAL);
-    entries_.erase(it);
+    RemoveEntry(it);
   } else {
     result_changed = true;
     if (size() == max_entries_)
@@ -552,12 +553,25 @@ void HostCache::Set(const Key& key,
 void HostCache::AddEntry(const Key& key, Entry&& entry) {
   DCHECK_GT(max_entries_, size());
   DCHECK_EQ(0u, entries_.count(key));
-  entries_.emplace(key, std::move(entry));
+  auto it = entries_.emplace(key, std::move(entry)).first;
+  expiry_index_.emplace(it->second.expires(), &*it);
+  if (it->second.network_changes() == network_changes_)
+    ++current_network_entries_;
   DCHECK_GE(max_entries_, size());
 }
 
+void HostCache::RemoveEntry(EntryMap::iterator it) {
+  size_t erased = expiry_index_.erase(
+      std::make_pair(it->second.expires(), &*it));
+  DCHECK_EQ(1u, erased);
+  if (it->second.network_changes() == network_changes_)
+    --current_network_entries_;
+  entries_.erase(it);
+}
+
 void HostCache::OnNetworkChange() {
   ++network_changes_;
+  current_network_entries_ = 0;
 }
 
 void HostCache::set_persistence_delegate(PersistenceDelegate* delegate) {
@@ -575,6 +589,8 @@ void HostCache::clear() {
     return;
 
   entries_.clear();
+  expiry_index_.clear();
+  current_network_entries_ = 0;
   if (delegate_)
     delegate_->ScheduleWrite();
 }
@@ -593,7 +609,7 @@ void HostCache::ClearForHosts(
     auto next_it = std::next(it);
 
     if (host_filter.Run(it->first.hostname)) {
-      entries_.erase(it);
+      RemoveEntry(it);
       changed = true;
     }
 
@@ -788,16 +804,17 @@ std::unique_ptr<HostCache> HostCache::CreateDefaultCache() {
 void HostCache::EvictOneEntry(base::TimeTicks now) {
   DCHECK_LT(0u, entries_.size());
 
-  auto oldest_it = entries_.begin();
-  for (auto it = entries_.begin(); it != entries_.end(); ++it) {
-    if ((it->second.expires() < oldest_it->second.expires()) &&
-        (it->second.IsStale(now, network_changes_) ||
-         !oldest_it->second.IsStale(now, network_changes_))) {
-      oldest_it = it;
-    }
+  // Evict the stale entry that expires first, or if none is stale, the entry
+  // that expires first. The first entry of |expiry_index_| is stale if any
+  // entry has expired, so other stale entries need to be searched for only if
+  // some entries are from before the last network change.
+  auto index_it = expiry_index_.begin();
+  if (current_network_entries_ < entries_.size()) {
+    while (!index_it->second->second.IsStale(now, network_changes_))
+      ++index_it;
   }
 
-  entries_.erase(oldest_it);
+  RemoveEntry(entries_.find(index_it->second->first));
 }
 
 const HostCache::Key* HostCache::GetMatchingKey(
@@ -10,6 +10,7 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <tuple>
 #include <utility>
@@ -365,12 +366,20 @@ class NET_EXPORT HostCache {
   bool caching_is_disabled() const { return max_entries_ == 0; }
 
   void EvictOneEntry(base::TimeTicks now);
-  // Helper to insert an Entry into the cache.
+  // Helpers to insert an Entry into the cache, and to remove one from it.
   void AddEntry(const Key& key, Entry&& entry);
+  void RemoveEntry(EntryMap::iterator it);
 
   // Map from hostname (presumably in lowercase canonicalized format) to
   // a resolved result entry.
   EntryMap entries_;
+  // The entries of |entries_|, ordered by expiration time, so that eviction
+  // doesn't have to scan the whole cache.
+  std::set<std::pair<base::TimeTicks, const EntryMap::value_type*>>
+      expiry_index_;
+  // Number of entries that were set since the last network change, and so
+  // aren't stale unless they've expired.
+  size_t current_network_entries_;
   size_t max_entries_;
   int network_changes_;
   // Number of cache entries that were restored in the last call to
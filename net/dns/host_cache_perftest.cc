@@ -0,0 +1,63 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/dns/host_cache.h"
+
+#include <string>
+#include <vector>
+
+#include "base/strings/stringprintf.h"
+#include "base/test/perf_time_logger.h"
+#include "base/time/time.h"
+#include "net/base/address_list.h"
+#include "net/base/net_errors.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+// Large enough for eviction and lookups to dominate, as in a proxy that
+// resolves many hostnames.
+constexpr size_t kMaxCacheEntries = 10000;
+constexpr int kNumHostnames = 100000;
+
+std::vector<HostCache::Key> CreateKeys() {
+  std::vector<HostCache::Key> keys;
+  for (int i = 0; i < kNumHostnames; ++i) {
+    keys.emplace_back(base::StringPrintf("host%d.example.com", i),
+                      DnsQueryType::UNSPECIFIED, 0, HostResolverSource::ANY);
+  }
+  return keys;
+}
+
+}  // namespace
+
+// Sets entries for many more hostnames than the cache holds, so that each
+// insertion evicts an entry, and looks them up.
+TEST(HostCachePerfTest, SetAndLookup) {
+  std::vector<HostCache::Key> keys = CreateKeys();
+  HostCache cache(kMaxCacheEntries);
+  HostCache::Entry entry(OK, AddressList(), HostCache::Entry::SOURCE_DNS);
+  base::TimeTicks now;
+
+  base::PerfTimeLogger set_timer("HostCache_set_100k_hostnames");
+  for (int i = 0; i < kNumHostnames; ++i) {
+    cache.Set(keys[i], entry, now,
+              base::TimeDelta::FromSeconds(60 + i % 600));
+  }
+  set_timer.Done();
+  EXPECT_EQ(kMaxCacheEntries, cache.size());
+
+  int hits = 0;
+  base::PerfTimeLogger lookup_timer("HostCache_lookup_100k_hostnames");
+  for (int i = 0; i < kNumHostnames; ++i) {
+    if (cache.Lookup(keys[i], now))
+      ++hits;
+  }
+  lookup_timer.Done();
+  EXPECT_EQ(static_cast<int>(kMaxCacheEntries), hits);
+}
+
+}  // namespace net
@@ -541,6 +541,38 @@ TEST(HostCacheTest, Evict) {
   EXPECT_TRUE(cache.Lookup(key3, now));
 }
 
+// Entries are evicted in order of expiration, including after other entries
+// were replaced or cleared.
+TEST(HostCacheTest, EvictInExpirationOrder) {
+  HostCache cache(3);
+
+  base::TimeTicks now;
+  HostCache::Entry entry =
+      HostCache::Entry(OK, AddressList(), HostCache::Entry::SOURCE_UNKNOWN);
+
+  cache.Set(Key("foobar1.com"), entry, now, base::TimeDelta::FromSeconds(30));
+  cache.Set(Key("foobar2.com"), entry, now, base::TimeDelta::FromSeconds(10));
+  cache.Set(Key("foobar3.com"), entry, now, base::TimeDelta::FromSeconds(20));
+  // Replacing |foobar2.com| moves it to the end of the expiration order.
+  cache.Set(Key("foobar2.com"), entry, now, base::TimeDelta::FromSeconds(40));
+  EXPECT_EQ(3u, cache.size());
+
+  cache.Set(Key("foobar4.com"), entry, now, base::TimeDelta::FromSeconds(50));
+  EXPECT_EQ(3u, cache.size());
+  EXPECT_FALSE(cache.Lookup(Key("foobar3.com"), now));
+
+  cache.ClearForHosts(base::BindRepeating(
+      [](const std::string& host) { return host == "foobar1.com"; }));
+  EXPECT_EQ(2u, cache.size());
+  cache.Set(Key("foobar5.com"), entry, now, base::TimeDelta::FromSeconds(60));
+  cache.Set(Key("foobar6.com"), entry, now, base::TimeDelta::FromSeconds(70));
+  EXPECT_EQ(3u, cache.size());
+  EXPECT_FALSE(cache.Lookup(Key("foobar2.com"), now));
+  EXPECT_TRUE(cache.Lookup(Key("foobar4.com"), now));
+  EXPECT_TRUE(cache.Lookup(Key("foobar5.com"), now));
+  EXPECT_TRUE(cache.Lookup(Key("foobar6.com"), now));
+}
+
 // Try to retrieve stale entries from the cache. They should be returned by
 // |LookupStale()| but not |Lookup()|, with correct |EntryStaleness| data.
 TEST(HostCacheTest, Stale) {
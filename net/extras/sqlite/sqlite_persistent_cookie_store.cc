@@ -256,6 +256,7 @@ class SQLitePersistentCookieStore::Backend
         : op_(op), cc_(cc) {}
 
     OperationType op() const { return op_; }
+    void set_op(OperationType op) { op_ = op; }
     const CanonicalCookie& cc() const { return cc_; }
 
    private:
@@ -319,6 +320,9 @@ class SQLitePersistentCookieStore::Backend
                       const CanonicalCookie& cc);
   // Commit our pending operations to the database.
   void Commit();
+  // Deletes the row of |po|'s cookie with |del_smt|, as part of Commit().
+  // Returns false on failure.
+  bool DeleteCookieFromDB(sql::Statement* del_smt, const PendingOperation& po);
   // Close() executed on the background runner.
   void InternalBackgroundClose();
 
@@ -1294,6 +1298,13 @@ void SQLitePersistentCookieStore::Backend::BatchOperation(
         // At most delete + add before (and no access time updates after above
         // conditional).
         DCHECK_LE(ops_for_key.size(), 2u);
+        if (!ops_for_key.empty() &&
+            ops_for_key.back()->op() == PendingOperation::COOKIE_ADD) {
+          // The cookie hasn't been written yet, so write it with the new
+          // access time instead of updating it after adding it.
+          ops_for_key.pop_back();
+          po->set_op(PendingOperation::COOKIE_ADD);
+        }
       } else {
         // Nothing special is done for adds, since if they're overwriting,
         // they'll be preceded by deletes anyway.
@@ -1340,6 +1351,8 @@ void SQLitePersistentCookieStore::Backend::Commit() {
   if (!db_.get() || ops.empty())
     return;
 
+  base::TimeTicks commit_start = base::TimeTicks::Now();
+
   sql::Statement add_smt(db_->GetCachedStatement(
       SQL_FROM_HERE,
       "INSERT INTO cookies (creation_utc, host_key, name, value, "
@@ -1349,6 +1362,17 @@ void SQLitePersistentCookieStore::Backend::Commit() {
   if (!add_smt.is_valid())
     return;
 
+  // Used for an add that overwrites a deleted cookie. Since (host_key, name,
+  // path) is unique, it replaces the deleted row in one statement.
+  sql::Statement replace_smt(db_->GetCachedStatement(
+      SQL_FROM_HERE,
+      "INSERT OR REPLACE INTO cookies (creation_utc, host_key, name, value, "
+      "encrypted_value, path, expires_utc, is_secure, is_httponly, "
+      "firstpartyonly, last_access_utc, has_expires, is_persistent, priority) "
+      "VALUES (?,?,?,?,?,?,?,?,?,?,?,?,?,?)"));
+  if (!replace_smt.is_valid())
+    return;
+
   sql::Statement update_access_smt(
       db_->GetCachedStatement(SQL_FROM_HERE,
                               "UPDATE cookies SET last_access_utc=? WHERE "
@@ -1368,49 +1392,61 @@ void SQLitePersistentCookieStore::Backend::Commit() {
     return;
 
   bool trouble = false;
+  int statement_count = 0;
   for (auto& kv : ops) {
-    for (std::unique_ptr<PendingOperation>& po_entry : kv.second) {
+    // Set when a delete is left for the add that follows it to replace.
+    bool replace = false;
+    for (auto it = kv.second.begin(); it != kv.second.end(); ++it) {
       // Free the cookies as we commit them to the database.
-      std::unique_ptr<PendingOperation> po(std::move(po_entry));
+      std::unique_ptr<PendingOperation> po(std::move(*it));
       switch (po->op()) {
-        case PendingOperation::COOKIE_ADD:
-          add_smt.Reset(true);
-          add_smt.BindInt64(0, po->cc().CreationDate().ToInternalValue());
-          add_smt.BindString(1, po->cc().Domain());
-          add_smt.BindString(2, po->cc().Name());
+        case PendingOperation::COOKIE_ADD: {
+          sql::Statement& smt = replace ? replace_smt : add_smt;
+          replace = false;
+          smt.Reset(true);
+          smt.BindInt64(0, po->cc().CreationDate().ToInternalValue());
+          smt.BindString(1, po->cc().Domain());
+          smt.BindString(2, po->cc().Name());
           if (crypto_ && crypto_->ShouldEncrypt()) {
             std::string encrypted_value;
             if (!crypto_->EncryptString(po->cc().Value(), &encrypted_value)) {
               DLOG(WARNING) << "Could not encrypt a cookie, skipping add.";
               RecordCookieCommitProblem(COOKIE_COMMIT_PROBLEM_ENCRYPT_FAILED);
               trouble = true;
+              // The cookie that was to be replaced still has to be deleted.
+              if (&smt == &replace_smt) {
+                ++statement_count;
+                DeleteCookieFromDB(&del_smt, *po);
+              }
               continue;
             }
-            add_smt.BindCString(3, "");  // value
+            smt.BindCString(3, "");  // value
             // BindBlob() immediately makes an internal copy of the data.
-            add_smt.BindBlob(4, encrypted_value.data(),
-                             static_cast<int>(encrypted_value.length()));
+            smt.BindBlob(4, encrypted_value.data(),
+                         static_cast<int>(encrypted_value.length()));
           } else {
-            add_smt.BindString(3, po->cc().Value());
-            add_smt.BindBlob(4, "", 0);  // encrypted_value
+            smt.BindString(3, po->cc().Value());
+            smt.BindBlob(4, "", 0);  // encrypted_value
           }
-          add_smt.BindString(5, po->cc().Path());
-          add_smt.BindInt64(6, po->cc().ExpiryDate().ToInternalValue());
-          add_smt.BindInt(7, po->cc().IsSecure());
-          add_smt.BindInt(8, po->cc().IsHttpOnly());
-          add_smt.BindInt(
-              9, CookieSameSiteToDBCookieSameSite(po->cc().SameSite()));
-          add_smt.BindInt64(10, po->cc().LastAccessDate().ToInternalValue());
-          add_smt.BindInt(11, po->cc().IsPersistent());
-          add_smt.BindInt(12, po->cc().IsPersistent());
-          add_smt.BindInt(
-              13, CookiePriorityToDBCookiePriority(po->cc().Priority()));
-          if (!add_smt.Run()) {
+          smt.BindString(5, po->cc().Path());
+          smt.BindInt64(6, po->cc().ExpiryDate().ToInternalValue());
+          smt.BindInt(7, po->cc().IsSecure());
+          smt.BindInt(8, po->cc().IsHttpOnly());
+          smt.BindInt(9,
+                      CookieSameSiteToDBCookieSameSite(po->cc().SameSite()));
+          smt.BindInt64(10, po->cc().LastAccessDate().ToInternalValue());
+          smt.BindInt(11, po->cc().IsPersistent());
+          smt.BindInt(12, po->cc().IsPersistent());
+          smt.BindInt(13,
+                      CookiePriorityToDBCookiePriority(po->cc().Priority()));
+          ++statement_count;
+          if (!smt.Run()) {
             DLOG(WARNING) << "Could not add a cookie to the DB.";
             RecordCookieCommitProblem(COOKIE_COMMIT_PROBLEM_ADD);
             trouble = true;
           }
           break;
+        }
 
         case PendingOperation::COOKIE_UPDATEACCESS:
           update_access_smt.Reset(true);
@@ -1419,6 +1455,7 @@ void SQLitePersistentCookieStore::Backend::Commit() {
           update_access_smt.BindString(1, po->cc().Name());
           update_access_smt.BindString(2, po->cc().Domain());
           update_access_smt.BindString(3, po->cc().Path());
+          ++statement_count;
           if (!update_access_smt.Run()) {
             DLOG(WARNING)
                 << "Could not update cookie last access time in the DB.";
@@ -1428,15 +1465,14 @@ void SQLitePersistentCookieStore::Backend::Commit() {
           break;
 
         case PendingOperation::COOKIE_DELETE:
-          del_smt.Reset(true);
-          del_smt.BindString(0, po->cc().Name());
-          del_smt.BindString(1, po->cc().Domain());
-          del_smt.BindString(2, po->cc().Path());
-          if (!del_smt.Run()) {
-            DLOG(WARNING) << "Could not delete a cookie from the DB.";
-            RecordCookieCommitProblem(COOKIE_COMMIT_PROBLEM_DELETE);
-            trouble = true;
+          if (std::next(it) != kv.second.end() &&
+              (*std::next(it))->op() == PendingOperation::COOKIE_ADD) {
+            replace = true;
+            break;
           }
+          ++statement_count;
+          if (!DeleteCookieFromDB(&del_smt, *po))
+            trouble = true;
           break;
 
         default:
@@ -1446,6 +1482,9 @@ void SQLitePersistentCookieStore::Backend::Commit() {
     }
   }
   bool succeeded = transaction.Commit();
+  UMA_HISTOGRAM_TIMES("Cookie.TimeCommit",
+                      base::TimeTicks::Now() - commit_start);
+  UMA_HISTOGRAM_COUNTS_10000("Cookie.CommitStatementCount", statement_count);
   UMA_HISTOGRAM_ENUMERATION("Cookie.BackingStoreUpdateResults",
                             succeeded
                                 ? (trouble ? BACKING_STORE_RESULTS_MIXED
@@ -1454,6 +1493,21 @@ void SQLitePersistentCookieStore::Backend::Commit() {
                             BACKING_STORE_RESULTS_LAST_ENTRY);
 }
 
+bool SQLitePersistentCookieStore::Backend::DeleteCookieFromDB(
+    sql::Statement* del_smt,
+    const PendingOperation& po) {
+  del_smt->Reset(true);
+  del_smt->BindString(0, po.cc().Name());
+  del_smt->BindString(1, po.cc().Domain());
+  del_smt->BindString(2, po.cc().Path());
+  if (!del_smt->Run()) {
+    DLOG(WARNING) << "Could not delete a cookie from the DB.";
+    RecordCookieCommitProblem(COOKIE_COMMIT_PROBLEM_DELETE);
+    return false;
+  }
+  return true;
+}
+
 void SQLitePersistentCookieStore::Backend::SetBeforeFlushCallback(
     base::RepeatingClosure callback) {
   base::AutoLock locked(before_flush_callback_lock_);
@@ -4,6 +4,7 @@
 
 #include "net/extras/sqlite/sqlite_persistent_cookie_store.h"
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <set>
@@ -285,6 +286,45 @@ TEST_F(SQLitePersistentCookieStoreTest, TestPersistance) {
   ASSERT_EQ(0U, cookies.size());
 }
 
+// A cookie overwritten in a batch, and one whose access time is updated
+// before it's written, are persisted with their latest state.
+TEST_F(SQLitePersistentCookieStoreTest, TestCoalescedOperationsPersist) {
+  InitializeStore(false, false);
+  base::Time creation = base::Time::Now();
+  AddCookie("A", "B", "foo.bar", "/", creation);
+  Flush();
+
+  CanonicalCookie old_cookie("A", "B", "foo.bar", "/", creation, creation,
+                             base::Time(), false, false,
+                             CookieSameSite::DEFAULT_MODE,
+                             COOKIE_PRIORITY_DEFAULT);
+  store_->DeleteCookie(old_cookie);
+  AddCookie("A", "C", "foo.bar", "/", creation);
+
+  base::Time access_time = creation + base::TimeDelta::FromMinutes(1);
+  CanonicalCookie new_cookie("X", "Y", "foo.bar", "/", creation, creation,
+                             base::Time(), false, false,
+                             CookieSameSite::DEFAULT_MODE,
+                             COOKIE_PRIORITY_DEFAULT);
+  store_->AddCookie(new_cookie);
+  new_cookie.SetLastAccessDate(access_time);
+  store_->UpdateCookieAccessTime(new_cookie);
+  DestroyStore();
+
+  CanonicalCookieVector cookies;
+  CreateAndLoad(false, false, &cookies);
+  ASSERT_EQ(2U, cookies.size());
+  std::sort(cookies.begin(), cookies.end(),
+            [](const std::unique_ptr<CanonicalCookie>& a,
+               const std::unique_ptr<CanonicalCookie>& b) {
+              return a->Name() < b->Name();
+            });
+  EXPECT_EQ("A", cookies[0]->Name());
+  EXPECT_EQ("C", cookies[0]->Value());
+  EXPECT_EQ("X", cookies[1]->Name());
+  EXPECT_EQ(access_time, cookies[1]->LastAccessDate());
+}
+
 TEST_F(SQLitePersistentCookieStoreTest, TestSessionCookiesDeletedOnStartup) {
   // Initialize the cookie store with 3 persistent cookies, 5 transient
   // cookies.
@@ -1322,10 +1362,10 @@ TEST_F(SQLitePersistentCookieStoreTest, Coalescing) {
       {{Op::kUpdate, Op::kDelete}, 1u},
       {{Op::kAdd, Op::kUpdate, Op::kDelete}, 1u},
       {{Op::kUpdate, Op::kUpdate}, 1u},
-      {{Op::kAdd, Op::kUpdate, Op::kUpdate}, 2u},
+      {{Op::kAdd, Op::kUpdate, Op::kUpdate}, 1u},
       {{Op::kDelete, Op::kAdd}, 2u},
-      {{Op::kDelete, Op::kAdd, Op::kUpdate}, 3u},
-      {{Op::kDelete, Op::kAdd, Op::kUpdate, Op::kUpdate}, 3u},
+      {{Op::kDelete, Op::kAdd, Op::kUpdate}, 2u},
+      {{Op::kDelete, Op::kAdd, Op::kUpdate, Op::kUpdate}, 2u},
       {{Op::kDelete, Op::kDelete}, 1u},
       {{Op::kDelete, Op::kAdd, Op::kDelete}, 1u},
       {{Op::kDelete, Op::kAdd, Op::kUpdate, Op::kDelete}, 1u}};
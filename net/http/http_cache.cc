@@ -18,6 +18,7 @@
 #include "base/memory/ptr_util.h"
 #include "base/memory/ref_counted.h"
 #include "base/metrics/field_trial.h"
+#include "base/metrics/field_trial_params.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/pickle.h"
 #include "base/single_thread_task_runner.h"
@@ -38,6 +39,7 @@
 #include "net/base/net_errors.h"
 #include "net/base/upload_data_stream.h"
 #include "net/disk_cache/disk_cache.h"
+#include "net/disk_cache/memory/hot_tier_backend.h"
 #include "net/http/http_cache_lookup_manager.h"
 #include "net/http/http_cache_transaction.h"
 #include "net/http/http_cache_writers.h"
@@ -56,6 +58,17 @@
 
 namespace net {
 
+namespace {
+
+// The sizes of the memory tier of kHttpCacheHotTier, and of the largest entry
+// it holds.
+constexpr base::FeatureParam<int> kHotTierSizeKB{&features::kHttpCacheHotTier,
+                                                 "size_kb", 8 * 1024};
+constexpr base::FeatureParam<int> kHotTierMaxEntrySizeKB{
+    &features::kHttpCacheHotTier, "max_entry_size_kb", 64};
+
+}  // namespace
+
 HttpCache::DefaultBackend::DefaultBackend(CacheType type,
                                           BackendType backend_type,
                                           const base::FilePath& path,
@@ -1510,6 +1523,12 @@ void HttpCache::OnBackendCreated(int result, PendingOp* pending_op) {
     backend_factory_.reset();  // Reclaim memory.
     if (result == OK) {
       disk_cache_ = std::move(pending_op->backend);
+      if (base::FeatureList::IsEnabled(features::kHttpCacheHotTier) &&
+          disk_cache_->GetCacheType() != MEMORY_CACHE) {
+        disk_cache_ = std::make_unique<disk_cache::HotTierBackend>(
+            std::move(disk_cache_), kHotTierSizeKB.Get() * 1024,
+            kHotTierMaxEntrySizeKB.Get() * 1024);
+      }
     }
   }
 
@@ -18,6 +18,7 @@
 #include "base/trace_event/memory_dump_request_args.h"
 #include "base/trace_event/process_memory_dump.h"
 #include "base/values.h"
+#include "net/base/io_buffer.h"
 #include "net/http/http_auth_handler_factory.h"
 #include "net/http/http_response_body_drainer.h"
 #include "net/http/http_stream_factory.h"
@@ -492,6 +493,16 @@ void HttpNetworkSession::DumpMemoryStats(
     ssl_client_session_cache_.DumpMemoryStats(pmd, name);
   }
 
+  // The socket read buffers cached for reuse are shared by all the sessions on
+  // this thread, so they are reported once.
+  const char kRecycledIOBuffersDumpName[] = "net/recycled_io_buffers";
+  if (!pmd->GetAllocatorDump(kRecycledIOBuffersDumpName)) {
+    pmd->CreateAllocatorDump(kRecycledIOBuffersDumpName)
+        ->AddScalar(base::trace_event::MemoryAllocatorDump::kNameSize,
+                    base::trace_event::MemoryAllocatorDump::kUnitsBytes,
+                    RecycledIOBuffer::GetCachedMemorySize());
+  }
+
   // Create an empty row under parent's dump so size can be attributed correctly
   // if |this| is shared between URLRequestContexts.
   base::trace_event::MemoryAllocatorDump* empty_row_dump =
@@ -539,6 +550,7 @@ void HttpNetworkSession::OnMemoryPressure(
     case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE:
     case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL:
       CloseIdleConnections();
+      RecycledIOBuffer::ReleaseCachedMemory();
       break;
   }
 }
@@ -31,6 +31,9 @@ QuicChromiumPacketReader::QuicChromiumPacketReader(
       yield_after_(quic::QuicTime::Infinite()),
       read_buffer_(base::MakeRefCounted<IOBufferWithSize>(
           static_cast<size_t>(quic::kMaxPacketSize))),
+      batched_reads_(true),
+      batch_buffer_(base::MakeRefCounted<IOBufferWithSize>(
+          static_cast<size_t>(quic::kMaxPacketSize) * kQuicMaxPacketsPerRead)),
       net_log_(net_log),
       weak_factory_(this) {}
 
@@ -46,17 +49,15 @@ void QuicChromiumPacketReader::StartReading() {
 
     DCHECK(socket_);
     read_pending_ = true;
-    int rv =
-        socket_->Read(read_buffer_.get(), read_buffer_->size(),
-                      base::BindOnce(&QuicChromiumPacketReader::OnReadComplete,
-                                     weak_factory_.GetWeakPtr()));
+    int rv = ReadFromSocket();
     UMA_HISTOGRAM_BOOLEAN("Net.QuicSession.AsyncRead", rv == ERR_IO_PENDING);
     if (rv == ERR_IO_PENDING) {
       num_packets_read_ = 0;
       return;
     }
 
-    if (++num_packets_read_ > yield_after_packets_ ||
+    num_packets_read_ += batched_reads_ && rv > 0 ? rv : 1;
+    if (num_packets_read_ > yield_after_packets_ ||
         clock_->Now() > yield_after_) {
       num_packets_read_ = 0;
       // Data was read, process it.
@@ -74,8 +75,26 @@ void QuicChromiumPacketReader::StartReading() {
 }
 
 size_t QuicChromiumPacketReader::EstimateMemoryUsage() const {
-  // Return the size of |read_buffer_|.
-  return quic::kMaxPacketSize;
+  // Return the size of |read_buffer_| and |batch_buffer_|.
+  return quic::kMaxPacketSize + (batch_buffer_ ? batch_buffer_->size() : 0);
+}
+
+int QuicChromiumPacketReader::ReadFromSocket() {
+  if (batched_reads_) {
+    int rv = socket_->ReadMultiple(
+        batch_buffer_.get(), quic::kMaxPacketSize, kQuicMaxPacketsPerRead,
+        &batch_sizes_,
+        base::BindOnce(&QuicChromiumPacketReader::OnReadComplete,
+                       weak_factory_.GetWeakPtr()));
+    if (rv != ERR_NOT_IMPLEMENTED)
+      return rv;
+    // The socket reads one packet at a time.
+    batched_reads_ = false;
+    batch_buffer_ = nullptr;
+  }
+  return socket_->Read(read_buffer_.get(), read_buffer_->size(),
+                       base::BindOnce(&QuicChromiumPacketReader::OnReadComplete,
+                                      weak_factory_.GetWeakPtr()));
 }
 
 bool QuicChromiumPacketReader::ProcessReadResult(int result) {
@@ -88,15 +107,36 @@ bool QuicChromiumPacketReader::ProcessReadResult(int result) {
     return false;
   }
 
-  quic::QuicReceivedPacket packet(read_buffer_->data(), result, clock_->Now());
   IPEndPoint local_address;
   IPEndPoint peer_address;
   socket_->GetLocalAddress(&local_address);
   socket_->GetPeerAddress(&peer_address);
-  return visitor_->OnPacket(
-      packet,
-      quic::QuicSocketAddress(quic::QuicSocketAddressImpl(local_address)),
-      quic::QuicSocketAddress(quic::QuicSocketAddressImpl(peer_address)));
+  const quic::QuicSocketAddress quic_local_address(
+      (quic::QuicSocketAddressImpl(local_address)));
+  const quic::QuicSocketAddress quic_peer_address(
+      (quic::QuicSocketAddressImpl(peer_address)));
+  if (!batched_reads_) {
+    quic::QuicReceivedPacket packet(read_buffer_->data(), result,
+                                    clock_->Now());
+    return visitor_->OnPacket(packet, quic_local_address, quic_peer_address);
+  }
+
+  DCHECK_EQ(static_cast<size_t>(result), batch_sizes_.size());
+  const quic::QuicTime now = clock_->Now();
+  for (int i = 0; i < result; ++i) {
+    int size = batch_sizes_[i];
+    if (size == 0)
+      size = ERR_CONNECTION_CLOSED;
+    if (size < 0) {
+      visitor_->OnReadError(size, socket_);
+      return false;
+    }
+    quic::QuicReceivedPacket packet(
+        batch_buffer_->data() + i * quic::kMaxPacketSize, size, now);
+    if (!visitor_->OnPacket(packet, quic_local_address, quic_peer_address))
+      return false;
+  }
+  return true;
 }
 
 void QuicChromiumPacketReader::OnReadComplete(int result) {
@@ -6,6 +6,8 @@
 #ifndef NET_QUIC_QUIC_CHROMIUM_PACKET_READER_H_
 #define NET_QUIC_QUIC_CHROMIUM_PACKET_READER_H_
 
+#include <vector>
+
 #include "base/macros.h"
 #include "base/memory/weak_ptr.h"
 #include "net/base/io_buffer.h"
@@ -26,6 +28,10 @@ namespace net {
 const int kQuicYieldAfterPacketsRead = 32;
 const int kQuicYieldAfterDurationMilliseconds = 2;
 
+// The most packets QuicChromiumPacketReader reads with one system call, on
+// sockets that support DatagramClientSocket::ReadMultiple().
+const int kQuicMaxPacketsPerRead = 16;
+
 class NET_EXPORT_PRIVATE QuicChromiumPacketReader {
  public:
   class NET_EXPORT_PRIVATE Visitor {
@@ -54,6 +60,10 @@ class NET_EXPORT_PRIVATE QuicChromiumPacketReader {
   size_t EstimateMemoryUsage() const;
 
  private:
+  // Reads from |socket_|, with ReadMultiple() while the socket supports it.
+  // Returns the number of bytes read by Read(), or the number of packets read
+  // by ReadMultiple(), or a net error code.
+  int ReadFromSocket();
   // A completion callback invoked when a read completes.
   void OnReadComplete(int result);
   // Return true if reading should continue.
@@ -68,6 +78,12 @@ class NET_EXPORT_PRIVATE QuicChromiumPacketReader {
   quic::QuicTime::Delta yield_after_duration_;
   quic::QuicTime yield_after_;
   scoped_refptr<IOBufferWithSize> read_buffer_;
+  // Whether reads go through ReadMultiple(), into |batch_buffer_|, which holds
+  // kQuicMaxPacketsPerRead packets of quic::kMaxPacketSize bytes, with their
+  // sizes in |batch_sizes_|.
+  bool batched_reads_;
+  scoped_refptr<IOBufferWithSize> batch_buffer_;
+  std::vector<int> batch_sizes_;
   NetLogWithSource net_log_;
 
   base::WeakPtrFactory<QuicChromiumPacketReader> weak_factory_;
@@ -0,0 +1,137 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/quic/quic_chromium_packet_reader.h"
+
+#include <string.h>
+
+#include <memory>
+#include <string>
+
+#include "base/run_loop.h"
+#include "base/time/time.h"
+#include "net/base/io_buffer.h"
+#include "net/base/ip_address.h"
+#include "net/base/ip_endpoint.h"
+#include "net/base/net_errors.h"
+#include "net/base/test_completion_callback.h"
+#include "net/log/net_log_source.h"
+#include "net/socket/udp_client_socket.h"
+#include "net/socket/udp_server_socket.h"
+#include "net/test/gtest_util.h"
+#include "net/test/test_with_scoped_task_environment.h"
+#include "net/third_party/quic/platform/impl/quic_chromium_clock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+using net::test::IsOk;
+
+namespace net {
+
+namespace {
+
+constexpr int kPacketSize = 1350;
+// Small enough for the receive buffer to hold a whole burst, so that nothing
+// is dropped on loopback.
+constexpr int kBurstSize = 256;
+constexpr int kBurstCount = 400;
+
+class CountingVisitor : public QuicChromiumPacketReader::Visitor {
+ public:
+  void Expect(int packets, base::OnceClosure done) {
+    remaining_ = packets;
+    done_ = std::move(done);
+  }
+
+  void OnReadError(int result, const DatagramClientSocket* socket) override {
+    ADD_FAILURE() << ErrorToString(result);
+  }
+
+  bool OnPacket(const quic::QuicReceivedPacket& packet,
+                const quic::QuicSocketAddress& local_address,
+                const quic::QuicSocketAddress& peer_address) override {
+    EXPECT_EQ(static_cast<size_t>(kPacketSize), packet.length());
+    if (--remaining_ == 0)
+      std::move(done_).Run();
+    return true;
+  }
+
+ private:
+  int remaining_ = 0;
+  base::OnceClosure done_;
+};
+
+// Sends bursts of QUIC-sized packets over loopback to a
+// QuicChromiumPacketReader, and reports the rate at which it delivers them.
+class QuicChromiumPacketReaderPerfTest : public TestWithScopedTaskEnvironment {
+ protected:
+  QuicChromiumPacketReaderPerfTest()
+      : TestWithScopedTaskEnvironment(
+            base::test::ScopedTaskEnvironment::MainThreadType::IO) {}
+
+  void RunTest(bool batched_io) {
+    UDPServerSocket server(nullptr, NetLogSource());
+    ASSERT_THAT(server.Listen(IPEndPoint(IPAddress::IPv4Localhost(), 0)),
+                IsOk());
+    IPEndPoint server_address;
+    ASSERT_THAT(server.GetLocalAddress(&server_address), IsOk());
+
+    UDPClientSocket client(DatagramSocket::DEFAULT_BIND, nullptr,
+                           NetLogSource());
+    if (batched_io)
+      client.EnableBatchedIO();
+    ASSERT_THAT(client.Connect(server_address), IsOk());
+    ASSERT_THAT(client.SetReceiveBufferSize(4 * kBurstSize * kPacketSize),
+                IsOk());
+    IPEndPoint client_address;
+    ASSERT_THAT(client.GetLocalAddress(&client_address), IsOk());
+
+    CountingVisitor visitor;
+    QuicChromiumPacketReader reader(
+        &client, quic::QuicChromiumClock::GetInstance(), &visitor,
+        kQuicYieldAfterPacketsRead,
+        quic::QuicTime::Delta::FromMilliseconds(
+            kQuicYieldAfterDurationMilliseconds),
+        NetLogWithSource());
+    reader.StartReading();
+
+    auto buffer = base::MakeRefCounted<IOBufferWithSize>(kPacketSize);
+    memset(buffer->data(), 'q', kPacketSize);
+    base::TimeTicks start = base::TimeTicks::Now();
+    for (int burst = 0; burst < kBurstCount; ++burst) {
+      base::RunLoop run_loop;
+      visitor.Expect(kBurstSize, run_loop.QuitClosure());
+      for (int i = 0; i < kBurstSize; ++i) {
+        TestCompletionCallback callback;
+        int rv = server.SendTo(buffer.get(), kPacketSize, client_address,
+                               callback.callback());
+        ASSERT_EQ(kPacketSize, callback.GetResult(rv));
+      }
+      run_loop.Run();
+    }
+    base::TimeDelta elapsed = base::TimeTicks::Now() - start;
+
+    perf_test::PrintResult(
+        "QuicChromiumPacketReader_Throughput", "",
+        batched_io ? "batched" : "single",
+        kBurstCount * kBurstSize / elapsed.InSecondsF(), "packets/s", true);
+    perf_test::PrintResult(
+        "QuicChromiumPacketReader_Throughput", "",
+        batched_io ? "batched_mbps" : "single_mbps",
+        8.0 * kBurstCount * kBurstSize * kPacketSize / elapsed.InSecondsF() / 1e6,
+        "Mbit/s", true);
+  }
+};
+
+}  // namespace
+
+TEST_F(QuicChromiumPacketReaderPerfTest, Read) {
+  RunTest(false);
+}
+
+TEST_F(QuicChromiumPacketReaderPerfTest, ReadBatched) {
+  RunTest(true);
+}
+
+}  // namespace net
@@ -27,6 +27,7 @@
 #include "base/trace_event/trace_event.h"
 #include "base/values.h"
 #include "crypto/openssl_util.h"
+#include "net/base/features.h"
 #include "net/base/ip_address.h"
 #include "net/base/net_errors.h"
 #include "net/base/trace_constants.h"
@@ -1647,6 +1648,8 @@ std::unique_ptr<DatagramClientSocket> QuicStreamFactory::CreateSocket(
       DatagramSocket::DEFAULT_BIND, net_log, source);
   if (enable_socket_recv_optimization_)
     socket->EnableRecvOptimization();
+  if (base::FeatureList::IsEnabled(features::kQuicBatchedUdpIO))
+    socket->EnableBatchedIO();
   return socket;
 }
 
@@ -9,6 +9,7 @@
 
 #include "base/bind.h"
 #include "base/compiler_specific.h"
+#include "base/feature_list.h"
 #include "base/format_macros.h"
 #include "base/location.h"
 #include "base/logging.h"
@@ -21,6 +22,7 @@
 #include "base/trace_event/memory_allocator_dump.h"
 #include "base/trace_event/process_memory_dump.h"
 #include "base/values.h"
+#include "net/base/features.h"
 #include "net/base/net_errors.h"
 #include "net/log/net_log.h"
 #include "net/log/net_log_event_type.h"
@@ -36,6 +38,10 @@ namespace {
 // after a certain timeout has passed without receiving an ACK.
 bool g_connect_backup_jobs_enabled = true;
 
+// The number of removed groups whose socket demand is remembered with
+// features::kSocketPoolWarming.
+const size_t kMaxSocketDemandEntries = 256;
+
 }  // namespace
 
 namespace internal {
@@ -92,7 +98,9 @@ ClientSocketPoolBaseHelper::ClientSocketPoolBaseHelper(
     base::TimeDelta unused_idle_socket_timeout,
     base::TimeDelta used_idle_socket_timeout,
     ConnectJobFactory* connect_job_factory)
-    : idle_socket_count_(0),
+    : warm_groups_(base::FeatureList::IsEnabled(features::kSocketPoolWarming)),
+      socket_demand_(kMaxSocketDemandEntries),
+      idle_socket_count_(0),
       connecting_socket_count_(0),
       handed_out_socket_count_(0),
       max_sockets_(max_sockets),
@@ -354,7 +362,8 @@ int ClientSocketPoolBaseHelper::RequestSocketInternal(
                     connect_job->connect_timing(), handle, base::TimeDelta(),
                     GetOrCreateGroup(group_name), request.net_log());
     } else {
-      AddIdleSocket(connect_job->PassSocket(), GetOrCreateGroup(group_name));
+      AddIdleSocket(connect_job->PassSocket(), group_name,
+                    GetOrCreateGroup(group_name));
     }
   } else if (rv == ERR_IO_PENDING) {
     // If we don't have any sockets in this group, set a timer for potentially
@@ -391,44 +400,20 @@ int ClientSocketPoolBaseHelper::RequestSocketInternal(
 
 bool ClientSocketPoolBaseHelper::AssignIdleSocketToRequest(
     const Request& request, Group* group) {
-  std::list<IdleSocket>* idle_sockets = group->mutable_idle_sockets();
-  auto idle_socket_it = idle_sockets->end();
-
-  // Iterate through the idle sockets forwards (oldest to newest)
-  //   * Delete any disconnected ones.
-  //   * If we find a used idle socket, assign to |idle_socket|.  At the end,
-  //   the |idle_socket_it| will be set to the newest used idle socket.
-  for (auto it = idle_sockets->begin(); it != idle_sockets->end();) {
-    // Check whether socket is usable. Note that it's unlikely that the socket
-    // is not usuable because this function is always invoked after a
-    // reusability check, but in theory socket can be closed asynchronously.
-    if (!it->IsUsable()) {
-      DecrementIdleCount();
-      delete it->socket;
-      it = idle_sockets->erase(it);
-      continue;
-    }
-
-    if (it->socket->WasEverUsed()) {
-      // We found one we can reuse!
-      idle_socket_it = it;
-    }
-
-    ++it;
-  }
-
-  // If we haven't found an idle socket, that means there are no used idle
-  // sockets.  Pick the oldest (first) idle socket (FIFO).
-
-  if (idle_socket_it == idle_sockets->end() && !idle_sockets->empty())
-    idle_socket_it = idle_sockets->begin();
-
-  if (idle_socket_it != idle_sockets->end()) {
-    DecrementIdleCount();
-    base::TimeDelta idle_time =
-        base::TimeTicks::Now() - idle_socket_it->start_time;
-    IdleSocket idle_socket = *idle_socket_it;
-    idle_sockets->erase(idle_socket_it);
+  // Prefer the most recently used idle socket, and if none of the idle sockets
+  // were used before, pick the oldest one (FIFO). Check whether the sockets are
+  // usable on the way. Note that it's unlikely that a socket is not usable
+  // because this function is always invoked after a reusability check, but in
+  // theory sockets can be closed asynchronously.
+  IdleSocket idle_socket;
+  bool found =
+      PopUsableIdleSocket(group->mutable_used_idle_sockets(), true /* newest */,
+                          &idle_socket) ||
+      PopUsableIdleSocket(group->mutable_unused_idle_sockets(),
+                          false /* newest */, &idle_socket);
+  UpdateIdleExpiry(group);
+  if (found) {
+    base::TimeDelta idle_time = base::TimeTicks::Now() - idle_socket.start_time;
     // TODO(davidben): If |idle_time| is under some low watermark, consider
     // treating as UNUSED rather than UNUSED_IDLE. This will avoid
     // HttpNetworkTransaction retrying on some errors.
@@ -541,7 +526,7 @@ size_t ClientSocketPoolBaseHelper::IdleSocketCountInGroup(
   auto i = group_map_.find(group_name);
   CHECK(i != group_map_.end());
 
-  return i->second->idle_sockets().size();
+  return i->second->idle_socket_count();
 }
 
 LoadState ClientSocketPoolBaseHelper::GetLoadState(
@@ -602,12 +587,12 @@ ClientSocketPoolBaseHelper::GetInfoAsValue(const std::string& name,
     group_dict->SetInteger("active_socket_count", group->active_socket_count());
 
     auto idle_socket_list = std::make_unique<base::ListValue>();
-    std::list<IdleSocket>::const_iterator idle_socket;
-    for (idle_socket = group->idle_sockets().begin();
-         idle_socket != group->idle_sockets().end();
-         idle_socket++) {
-      int source_id = idle_socket->socket->NetLog().source().id;
-      idle_socket_list->AppendInteger(source_id);
+    for (const auto* idle_sockets :
+         {&group->unused_idle_sockets(), &group->used_idle_sockets()}) {
+      for (const IdleSocket& idle_socket : *idle_sockets) {
+        int source_id = idle_socket.socket->NetLog().source().id;
+        idle_socket_list->AppendInteger(source_id);
+      }
     }
     group_dict->Set("idle_sockets", std::move(idle_socket_list));
 
@@ -638,14 +623,17 @@ void ClientSocketPoolBaseHelper::DumpMemoryStats(
   size_t cert_count = 0;
   size_t cert_size = 0;
   for (const auto& kv : group_map_) {
-    for (const auto& socket : kv.second->idle_sockets()) {
-      StreamSocket::SocketMemoryStats stats;
-      socket.socket->DumpMemoryStats(&stats);
-      total_size += stats.total_size;
-      buffer_size += stats.buffer_size;
-      cert_count += stats.cert_count;
-      cert_size += stats.cert_size;
-      ++socket_count;
+    for (const auto* idle_sockets : {&kv.second->unused_idle_sockets(),
+                                     &kv.second->used_idle_sockets()}) {
+      for (const IdleSocket& socket : *idle_sockets) {
+        StreamSocket::SocketMemoryStats stats;
+        socket.socket->DumpMemoryStats(&stats);
+        total_size += stats.total_size;
+        buffer_size += stats.buffer_size;
+        cert_count += stats.cert_count;
+        cert_size += stats.cert_size;
+        ++socket_count;
+      }
     }
   }
   // Only create a MemoryAllocatorDump if there is at least one idle socket
@@ -685,6 +673,20 @@ void ClientSocketPoolBaseHelper::CleanupIdleSockets(bool force) {
   // inside the inner loop, since it shouldn't change by any meaningful amount.
   base::TimeTicks now = base::TimeTicks::Now();
 
+  if (!force) {
+    // Only go through the groups with idle sockets that timed out. Cleaning up
+    // a group moves it to when its next idle socket times out, or removes it
+    // from the queue.
+    while (!idle_expiry_queue_.empty() &&
+           idle_expiry_queue_.begin()->first <= now) {
+      auto group_it = idle_expiry_queue_.begin()->second;
+      CleanupIdleSocketsInGroup(false, group_it->second, now);
+      if (group_it->second->IsEmpty())
+        RemoveGroup(group_it);
+    }
+    return;
+  }
+
   for (auto i = group_map_.begin(); i != group_map_.end();) {
     Group* group = i->second;
     CleanupIdleSocketsInGroup(force, group, now);
@@ -702,16 +704,25 @@ void ClientSocketPoolBaseHelper::CleanupIdleSocketsInGroup(
     bool force,
     Group* group,
     const base::TimeTicks& now) {
-  auto idle_socket_it = group->mutable_idle_sockets()->begin();
-  while (idle_socket_it != group->idle_sockets().end()) {
-    base::TimeDelta timeout = idle_socket_it->socket->WasEverUsed()
-                                  ? used_idle_socket_timeout_
-                                  : unused_idle_socket_timeout_;
+  CleanupIdleSocketList(force, used_idle_socket_timeout_, now,
+                        group->mutable_used_idle_sockets());
+  CleanupIdleSocketList(force, unused_idle_socket_timeout_, now,
+                        group->mutable_unused_idle_sockets());
+  UpdateIdleExpiry(group);
+}
+
+void ClientSocketPoolBaseHelper::CleanupIdleSocketList(
+    bool force,
+    base::TimeDelta timeout,
+    const base::TimeTicks& now,
+    std::list<IdleSocket>* idle_sockets) {
+  auto idle_socket_it = idle_sockets->begin();
+  while (idle_socket_it != idle_sockets->end()) {
     bool timed_out = (now - idle_socket_it->start_time) >= timeout;
     bool should_clean_up = force || timed_out || !idle_socket_it->IsUsable();
     if (should_clean_up) {
       delete idle_socket_it->socket;
-      idle_socket_it = group->mutable_idle_sockets()->erase(idle_socket_it);
+      idle_socket_it = idle_sockets->erase(idle_socket_it);
       DecrementIdleCount();
     } else {
       ++idle_socket_it;
@@ -719,6 +730,62 @@ void ClientSocketPoolBaseHelper::CleanupIdleSocketsInGroup(
   }
 }
 
+void ClientSocketPoolBaseHelper::UpdateIdleExpiry(Group* group) {
+  const base::Optional<IdleExpiryQueue::iterator>& position =
+      group->idle_expiry_position();
+  if (!position) {
+    DCHECK_EQ(0u, group->idle_socket_count());
+    return;
+  }
+
+  IdleExpiryQueue::iterator old_position = *position;
+  if (group->idle_socket_count() == 0) {
+    idle_expiry_queue_.erase(old_position);
+    group->set_idle_expiry_position(base::nullopt);
+    return;
+  }
+
+  base::TimeTicks expiry = GetIdleExpiry(*group);
+  if (old_position->first == expiry)
+    return;
+  GroupMap::iterator group_it = old_position->second;
+  idle_expiry_queue_.erase(old_position);
+  group->set_idle_expiry_position(idle_expiry_queue_.emplace(expiry, group_it));
+}
+
+base::TimeTicks ClientSocketPoolBaseHelper::GetIdleExpiry(
+    const Group& group) const {
+  DCHECK_GT(group.idle_socket_count(), 0u);
+  base::TimeTicks expiry = base::TimeTicks::Max();
+  if (!group.used_idle_sockets().empty()) {
+    expiry = group.used_idle_sockets().front().start_time +
+             used_idle_socket_timeout_;
+  }
+  if (!group.unused_idle_sockets().empty()) {
+    expiry = std::min(expiry, group.unused_idle_sockets().front().start_time +
+                                  unused_idle_socket_timeout_);
+  }
+  return expiry;
+}
+
+bool ClientSocketPoolBaseHelper::PopUsableIdleSocket(
+    std::list<IdleSocket>* idle_sockets,
+    bool newest,
+    IdleSocket* idle_socket) {
+  while (!idle_sockets->empty()) {
+    *idle_socket = newest ? idle_sockets->back() : idle_sockets->front();
+    if (newest)
+      idle_sockets->pop_back();
+    else
+      idle_sockets->pop_front();
+    DecrementIdleCount();
+    if (idle_socket->IsUsable())
+      return true;
+    delete idle_socket->socket;
+  }
+  return false;
+}
+
 ClientSocketPoolBaseHelper::Group* ClientSocketPoolBaseHelper::GetOrCreateGroup(
     const std::string& group_name) {
   auto it = group_map_.find(group_name);
@@ -737,10 +804,29 @@ void ClientSocketPoolBaseHelper::RemoveGroup(const std::string& group_name) {
 }
 
 void ClientSocketPoolBaseHelper::RemoveGroup(GroupMap::iterator it) {
+  DCHECK(!it->second->idle_expiry_position());
+  if (warm_groups_) {
+    int peak_sockets = it->second->peak_active_socket_count();
+    if (peak_sockets > 1) {
+      socket_demand_.Put(it->first, peak_sockets);
+    } else {
+      auto demand_it = socket_demand_.Peek(it->first);
+      if (demand_it != socket_demand_.end())
+        socket_demand_.Erase(demand_it);
+    }
+  }
   delete it->second;
   group_map_.erase(it);
 }
 
+int ClientSocketPoolBaseHelper::GetPredictedSocketCount(
+    const std::string& group_name) const {
+  auto it = socket_demand_.Peek(group_name);
+  if (it == socket_demand_.end())
+    return 0;
+  return it->second;
+}
+
 // static
 bool ClientSocketPoolBaseHelper::connect_backup_jobs_enabled() {
   return g_connect_backup_jobs_enabled;
@@ -784,7 +870,7 @@ void ClientSocketPoolBaseHelper::ReleaseSocket(
       id == pool_generation_number_;
   if (can_reuse) {
     // Add it to the idle list.
-    AddIdleSocket(std::move(socket), group);
+    AddIdleSocket(std::move(socket), group_name, group);
     OnAvailableSocketSlot(group_name, group);
   } else {
     socket.reset();
@@ -926,7 +1012,7 @@ void ClientSocketPoolBaseHelper::OnConnectJobComplete(
       InvokeUserCallbackLater(request->handle(), request->release_callback(),
                               result, request->socket_tag());
     } else {
-      AddIdleSocket(std::move(socket), group);
+      AddIdleSocket(std::move(socket), group_name, group);
       OnAvailableSocketSlot(group_name, group);
       CheckForStalledSocketGroups();
     }
@@ -1017,7 +1103,7 @@ void ClientSocketPoolBaseHelper::ProcessPendingRequest(
   // If the group has no idle sockets, and can't make use of an additional slot,
   // either because it's at the limit or because it's at the socket per group
   // limit, then there's nothing to do.
-  if (group->idle_sockets().empty() &&
+  if (group->idle_socket_count() == 0 &&
       !group->CanUseAdditionalSocketSlot(max_sockets_per_group_)) {
     return;
   }
@@ -1075,14 +1161,28 @@ void ClientSocketPoolBaseHelper::HandOutSocket(
 
 void ClientSocketPoolBaseHelper::AddIdleSocket(
     std::unique_ptr<StreamSocket> socket,
+    const std::string& group_name,
     Group* group) {
   DCHECK(socket);
   IdleSocket idle_socket;
   idle_socket.socket = socket.release();
   idle_socket.start_time = base::TimeTicks::Now();
 
-  group->mutable_idle_sockets()->push_back(idle_socket);
+  if (idle_socket.socket->WasEverUsed())
+    group->mutable_used_idle_sockets()->push_back(idle_socket);
+  else
+    group->mutable_unused_idle_sockets()->push_back(idle_socket);
   IncrementIdleCount();
+
+  if (group->idle_expiry_position()) {
+    UpdateIdleExpiry(group);
+    return;
+  }
+  auto group_it = group_map_.find(group_name);
+  DCHECK(group_it != group_map_.end());
+  DCHECK_EQ(group, group_it->second);
+  group->set_idle_expiry_position(
+      idle_expiry_queue_.emplace(GetIdleExpiry(*group), group_it));
 }
 
 void ClientSocketPoolBaseHelper::CancelAllConnectJobs() {
@@ -1151,21 +1251,29 @@ bool ClientSocketPoolBaseHelper::CloseOneIdleSocketExceptInGroup(
     const Group* exception_group) {
   CHECK_GT(idle_socket_count(), 0);
 
-  for (auto i = group_map_.begin(); i != group_map_.end(); ++i) {
-    Group* group = i->second;
+  // Close the idle socket that would time out first, which only requires
+  // looking at the groups with idle sockets.
+  for (const auto& expiry : idle_expiry_queue_) {
+    GroupMap::iterator group_it = expiry.second;
+    Group* group = group_it->second;
     if (exception_group == group)
       continue;
-    std::list<IdleSocket>* idle_sockets = group->mutable_idle_sockets();
-
-    if (!idle_sockets->empty()) {
-      delete idle_sockets->front().socket;
-      idle_sockets->pop_front();
-      DecrementIdleCount();
-      if (group->IsEmpty())
-        RemoveGroup(i);
 
-      return true;
+    std::list<IdleSocket>* idle_sockets = group->mutable_unused_idle_sockets();
+    if (!group->used_idle_sockets().empty() &&
+        group->used_idle_sockets().front().start_time +
+                used_idle_socket_timeout_ ==
+            expiry.first) {
+      idle_sockets = group->mutable_used_idle_sockets();
     }
+    delete idle_sockets->front().socket;
+    idle_sockets->pop_front();
+    DecrementIdleCount();
+    UpdateIdleExpiry(group);
+    if (group->IsEmpty())
+      RemoveGroup(group_it);
+
+    return true;
   }
 
   return false;
@@ -1224,7 +1332,8 @@ void ClientSocketPoolBaseHelper::TryToCloseSocketsInLayeredPools() {
 ClientSocketPoolBaseHelper::Group::Group()
     : never_assigned_job_count_(0),
       unbound_requests_(NUM_PRIORITIES),
-      active_socket_count_(0) {}
+      active_socket_count_(0),
+      peak_active_socket_count_(0) {}
 
 ClientSocketPoolBaseHelper::Group::~Group() {
   DCHECK_EQ(0u, never_assigned_job_count());
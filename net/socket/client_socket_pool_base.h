@@ -25,6 +25,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <algorithm>
 #include <cstddef>
 #include <list>
 #include <map>
@@ -34,9 +35,11 @@
 #include <utility>
 #include <vector>
 
+#include "base/containers/mru_cache.h"
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
+#include "base/optional.h"
 #include "base/time/time.h"
 #include "base/timer/timer.h"
 #include "net/base/address_list.h"
@@ -264,6 +267,11 @@ class NET_EXPORT_PRIVATE ClientSocketPoolBaseHelper
 
   bool HasGroup(const std::string& group_name) const;
 
+  // Returns how many sockets |group_name| had handed out at once the last time
+  // the pool had a group by that name, or 0 if that isn't known. Only tracked
+  // with features::kSocketPoolWarming.
+  int GetPredictedSocketCount(const std::string& group_name) const;
+
   // Closes all idle sockets if |force| is true.  Else, only closes idle
   // sockets that timed out or can't be reused.  Made public for testing.
   void CleanupIdleSockets(bool force);
@@ -324,6 +332,13 @@ class NET_EXPORT_PRIVATE ClientSocketPoolBaseHelper
 
   using RequestQueue = PriorityQueue<std::unique_ptr<Request>>;
 
+  class Group;
+  using GroupMap = std::map<std::string, Group*>;
+
+  // The groups that have idle sockets, ordered by when the first of their idle
+  // sockets times out.
+  using IdleExpiryQueue = std::multimap<base::TimeTicks, GroupMap::iterator>;
+
   // A Group is allocated per group_name when there are idle sockets, unbound
   // request, or bound requests. Otherwise, the Group object is removed from the
   // map.
@@ -356,7 +371,7 @@ class NET_EXPORT_PRIVATE ClientSocketPoolBaseHelper
     ~Group();
 
     bool IsEmpty() const {
-      return active_socket_count_ == 0 && idle_sockets_.empty() &&
+      return active_socket_count_ == 0 && idle_socket_count() == 0 &&
              jobs_.empty() && unbound_requests_.empty() &&
              bound_requests_.empty();
     }
@@ -367,7 +382,7 @@ class NET_EXPORT_PRIVATE ClientSocketPoolBaseHelper
 
     int NumActiveSocketSlots() const {
       return active_socket_count_ + static_cast<int>(jobs_.size()) +
-             static_cast<int>(idle_sockets_.size()) +
+             static_cast<int>(idle_socket_count()) +
              static_cast<int>(bound_requests_.size());
     }
 
@@ -465,7 +480,11 @@ class NET_EXPORT_PRIVATE ClientSocketPoolBaseHelper
     // is the same as the current priority of the request, this is a no-op.
     void SetPriority(ClientSocketHandle* handle, RequestPriority priority);
 
-    void IncrementActiveSocketCount() { active_socket_count_++; }
+    void IncrementActiveSocketCount() {
+      active_socket_count_++;
+      peak_active_socket_count_ =
+          std::max(peak_active_socket_count_, active_socket_count_);
+    }
     void DecrementActiveSocketCount() { active_socket_count_--; }
 
     // Whether the request in |unbound_requests_| with a given handle has a job.
@@ -474,9 +493,38 @@ class NET_EXPORT_PRIVATE ClientSocketPoolBaseHelper
 
     size_t unassigned_job_count() const { return unassigned_jobs_.size(); }
     const JobList& jobs() const { return jobs_; }
-    const std::list<IdleSocket>& idle_sockets() const { return idle_sockets_; }
+    // The idle sockets that were used before, and the ones that weren't. Each
+    // list is ordered from oldest to newest, so since each kind of socket has
+    // its own timeout, the front of each list is the next of its sockets to
+    // time out.
+    const std::list<IdleSocket>& used_idle_sockets() const {
+      return used_idle_sockets_;
+    }
+    const std::list<IdleSocket>& unused_idle_sockets() const {
+      return unused_idle_sockets_;
+    }
+    std::list<IdleSocket>* mutable_used_idle_sockets() {
+      return &used_idle_sockets_;
+    }
+    std::list<IdleSocket>* mutable_unused_idle_sockets() {
+      return &unused_idle_sockets_;
+    }
+    size_t idle_socket_count() const {
+      return used_idle_sockets_.size() + unused_idle_sockets_.size();
+    }
     int active_socket_count() const { return active_socket_count_; }
-    std::list<IdleSocket>* mutable_idle_sockets() { return &idle_sockets_; }
+    int peak_active_socket_count() const { return peak_active_socket_count_; }
+
+    // The position of the group in the pool's IdleExpiryQueue. Set exactly
+    // when the group has idle sockets.
+    const base::Optional<IdleExpiryQueue::iterator>& idle_expiry_position()
+        const {
+      return idle_expiry_position_;
+    }
+    void set_idle_expiry_position(
+        base::Optional<IdleExpiryQueue::iterator> position) {
+      idle_expiry_position_ = position;
+    }
     size_t never_assigned_job_count() const {
       return never_assigned_job_count_;
     }
@@ -570,7 +618,9 @@ class NET_EXPORT_PRIVATE ClientSocketPoolBaseHelper
     // when a request is cancelled.
     size_t never_assigned_job_count_;
 
-    std::list<IdleSocket> idle_sockets_;
+    std::list<IdleSocket> used_idle_sockets_;
+    std::list<IdleSocket> unused_idle_sockets_;
+    base::Optional<IdleExpiryQueue::iterator> idle_expiry_position_;
     JobList jobs_;  // For bookkeeping purposes, there is a copy of the raw
                     // pointer of each element of |jobs_| stored either in
                     // |unassigned_jobs_|, or as the associated |job_| of an
@@ -578,6 +628,7 @@ class NET_EXPORT_PRIVATE ClientSocketPoolBaseHelper
     std::list<ConnectJob*> unassigned_jobs_;
     RequestQueue unbound_requests_;
     int active_socket_count_;  // number of active sockets used by clients
+    int peak_active_socket_count_;  // highest |active_socket_count_| so far
     // A timer for when to start the backup job.
     base::OneShotTimer backup_job_timer_;
 
@@ -587,8 +638,6 @@ class NET_EXPORT_PRIVATE ClientSocketPoolBaseHelper
     std::vector<BoundRequest> bound_requests_;
   };
 
-  using GroupMap = std::map<std::string, Group*>;
-
   struct CallbackResultPair {
     CallbackResultPair();
     CallbackResultPair(CompletionOnceCallback callback_in, int result_in);
@@ -610,6 +659,29 @@ class NET_EXPORT_PRIVATE ClientSocketPoolBaseHelper
                                  Group* group,
                                  const base::TimeTicks& now);
 
+  // Does the same for |idle_sockets|, whose sockets time out after |timeout|.
+  void CleanupIdleSocketList(bool force,
+                             base::TimeDelta timeout,
+                             const base::TimeTicks& now,
+                             std::list<IdleSocket>* idle_sockets);
+
+  // Moves |group| to the right position in |idle_expiry_queue_| after some of
+  // its idle sockets were removed or added. |group| must either be in the
+  // queue already, or have no idle sockets.
+  void UpdateIdleExpiry(Group* group);
+
+  // Returns when the first idle socket of |group| times out. |group| must have
+  // idle sockets.
+  base::TimeTicks GetIdleExpiry(const Group& group) const;
+
+  // Removes sockets from |idle_sockets|, newest first if |newest| is true, and
+  // oldest first otherwise, until it finds a usable one, which is written to
+  // |idle_socket|. Returns false if there was none. Deletes the unusable
+  // sockets it went through.
+  bool PopUsableIdleSocket(std::list<IdleSocket>* idle_sockets,
+                           bool newest,
+                           IdleSocket* idle_socket);
+
   Group* GetOrCreateGroup(const std::string& group_name);
   void RemoveGroup(const std::string& group_name);
   void RemoveGroup(GroupMap::iterator it);
@@ -642,8 +714,11 @@ class NET_EXPORT_PRIVATE ClientSocketPoolBaseHelper
                      Group* group,
                      const NetLogWithSource& net_log);
 
-  // Adds |socket| to the list of idle sockets for |group|.
-  void AddIdleSocket(std::unique_ptr<StreamSocket> socket, Group* group);
+  // Adds |socket| to the list of idle sockets for |group|, whose name is
+  // |group_name|.
+  void AddIdleSocket(std::unique_ptr<StreamSocket> socket,
+                     const std::string& group_name,
+                     Group* group);
 
   // Iterates through |group_map_|, canceling all ConnectJobs and deleting
   // groups if they are no longer needed.
@@ -700,6 +775,17 @@ class NET_EXPORT_PRIVATE ClientSocketPoolBaseHelper
 
   GroupMap group_map_;
 
+  // The groups of |group_map_| that have idle sockets, so that timed out
+  // sockets can be found without going through every group.
+  IdleExpiryQueue idle_expiry_queue_;
+
+  // Whether features::kSocketPoolWarming is enabled.
+  const bool warm_groups_;
+
+  // For each recently removed group that had several sockets handed out at
+  // once, the highest number of them. Most recently removed first.
+  base::MRUCache<std::string, int> socket_demand_;
+
   // Map of the ClientSocketHandles for which we have a pending Task to invoke a
   // callback.  This is necessary since, before we invoke said callback, it's
   // possible that the request is cancelled.
@@ -848,7 +934,16 @@ class ClientSocketPoolBase {
         handle, std::move(callback), proxy_auth_callback, priority, socket_tag,
         respect_limits, internal::ClientSocketPoolBaseHelper::NORMAL, params,
         net_log);
-    return helper_.RequestSocket(group_name, std::move(request));
+    bool new_group = !helper_.HasGroup(group_name);
+    int rv = helper_.RequestSocket(group_name, std::move(request));
+    // When a group comes back, preconnect the sockets it needed last time, so
+    // that its next requests don't have to wait for their connections.
+    if (new_group && (rv == OK || rv == ERR_IO_PENDING)) {
+      int predicted_sockets = helper_.GetPredictedSocketCount(group_name);
+      if (predicted_sockets > 1)
+        RequestSockets(group_name, params, predicted_sockets, net_log);
+    }
+    return rv;
   }
 
   // RequestSockets bundles up the parameters into a Request and then forwards
@@ -0,0 +1,109 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/strings/stringprintf.h"
+#include "base/test/perf_time_logger.h"
+#include "base/time/time.h"
+#include "net/base/host_port_pair.h"
+#include "net/base/net_errors.h"
+#include "net/dns/mock_host_resolver.h"
+#include "net/log/net_log_with_source.h"
+#include "net/socket/client_socket_handle.h"
+#include "net/socket/socket_tag.h"
+#include "net/socket/transport_client_socket_pool.h"
+#include "net/socket/transport_client_socket_pool_test_util.h"
+#include "net/socket/transport_connect_job.h"
+#include "net/test/test_with_scoped_task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+// Enough groups for a walk over all of them to dominate the cost of a request,
+// as with a busy proxy.
+constexpr int kNumGroups = 10000;
+constexpr int kNumRounds = 10;
+
+// Requests and releases sockets to many hosts through a pool that keeps an
+// idle socket for each of them, which is what happens to a pool that serves
+// many hosts.
+class ClientSocketPoolBasePerfTest : public TestWithScopedTaskEnvironment {
+ protected:
+  ClientSocketPoolBasePerfTest()
+      : client_socket_factory_(nullptr),
+        pool_(kNumGroups,
+              1 /* max_sockets_per_group */,
+              base::TimeDelta::FromDays(1) /* unused_idle_socket_timeout */,
+              &client_socket_factory_,
+              &host_resolver_,
+              nullptr /* proxy_delegate */,
+              nullptr /* cert_verifier */,
+              nullptr /* channel_id_server */,
+              nullptr /* transport_security_state */,
+              nullptr /* cert_transparency_verifier */,
+              nullptr /* ct_policy_enforcer */,
+              nullptr /* ssl_client_session_cache */,
+              nullptr /* ssl_client_session_cache_privacy_mode */,
+              nullptr /* ssl_config_service */,
+              nullptr /* socket_performance_watcher_factory */,
+              nullptr /* network_quality_estimator */,
+              nullptr /* net_log */) {
+    host_resolver_.set_synchronous_mode(true);
+    for (int i = 0; i < kNumGroups; ++i) {
+      HostPortPair host_port_pair(
+          base::StringPrintf("10.0.%d.%d", i / 256, i % 256), 80);
+      group_names_.push_back(host_port_pair.ToString());
+      params_.push_back(
+          TransportClientSocketPool::SocketParams::
+              CreateFromTransportSocketParams(
+                  base::MakeRefCounted<TransportSocketParams>(
+                      host_port_pair, false, OnHostResolutionCallback())));
+    }
+  }
+
+  // Requests a socket for each group, and releases it to the pool.
+  void RequestAndReleaseSockets() {
+    for (int i = 0; i < kNumGroups; ++i) {
+      ClientSocketHandle handle;
+      int rv = handle.Init(group_names_[i], params_[i], DEFAULT_PRIORITY,
+                           SocketTag(),
+                           ClientSocketPool::RespectLimits::ENABLED,
+                           CompletionOnceCallback(),
+                           ClientSocketPool::ProxyAuthCallback(), &pool_,
+                           NetLogWithSource());
+      ASSERT_EQ(OK, rv);
+    }
+  }
+
+  MockTransportClientSocketFactory client_socket_factory_;
+  MockHostResolver host_resolver_;
+  TransportClientSocketPool pool_;
+  std::vector<std::string> group_names_;
+  std::vector<scoped_refptr<TransportClientSocketPool::SocketParams>> params_;
+};
+
+}  // namespace
+
+TEST_F(ClientSocketPoolBasePerfTest, ReuseIdleSockets) {
+  {
+    base::PerfTimeLogger timer("ClientSocketPoolBase_connect_10k_groups");
+    RequestAndReleaseSockets();
+  }
+  ASSERT_EQ(kNumGroups, pool_.IdleSocketCount());
+
+  base::PerfTimeLogger timer("ClientSocketPoolBase_reuse_10k_groups");
+  for (int round = 0; round < kNumRounds; ++round)
+    RequestAndReleaseSockets();
+  timer.Done();
+  EXPECT_EQ(kNumGroups, pool_.IdleSocketCount());
+
+  pool_.CloseIdleSockets();
+}
+
+}  // namespace net
@@ -21,9 +21,11 @@
 #include "base/stl_util.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/stringprintf.h"
+#include "base/test/scoped_feature_list.h"
 #include "base/threading/platform_thread.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "base/values.h"
+#include "net/base/features.h"
 #include "net/base/load_timing_info.h"
 #include "net/base/load_timing_info_test_util.h"
 #include "net/base/net_errors.h"
@@ -2471,6 +2473,84 @@ TEST_F(ClientSocketPoolBaseTest, CleanupTimedOutIdleSocketsNoReuse) {
       entries, 1, NetLogEventType::SOCKET_POOL_REUSED_AN_EXISTING_SOCKET));
 }
 
+// Make sure that cleaning up timed out idle sockets only closes those, and
+// leaves the idle sockets of other groups alone.
+TEST_F(ClientSocketPoolBaseTest, CleanupTimedOutIdleSocketsInSomeGroups) {
+  CreatePoolWithIdleTimeouts(
+      kDefaultMaxSockets, kDefaultMaxSocketsPerGroup,
+      base::TimeDelta(),  // Time out unused sockets immediately.
+      base::TimeDelta::FromDays(1));  // Don't time out used sockets.
+
+  ClientSocketHandle handles[3];
+  const char* const kGroups[] = {"a", "b", "c"};
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(OK, handles[i].Init(kGroups[i], params_, LOWEST, SocketTag(),
+                                  ClientSocketPool::RespectLimits::ENABLED,
+                                  CompletionOnceCallback(),
+                                  ClientSocketPool::ProxyAuthCallback(),
+                                  pool_.get(), NetLogWithSource()));
+  }
+
+  // Use the socket of "b", and release all of them.
+  EXPECT_EQ(1, handles[1].socket()->Write(NULL, 1, CompletionOnceCallback(),
+                                          TRAFFIC_ANNOTATION_FOR_TESTS));
+  for (auto& handle : handles)
+    handle.Reset();
+  ASSERT_EQ(3, pool_->IdleSocketCount());
+
+  pool_->CleanupTimedOutIdleSockets();
+  EXPECT_EQ(1, pool_->IdleSocketCount());
+  EXPECT_FALSE(pool_->HasGroup("a"));
+  ASSERT_TRUE(pool_->HasGroup("b"));
+  EXPECT_EQ(1u, pool_->IdleSocketCountInGroup("b"));
+  EXPECT_FALSE(pool_->HasGroup("c"));
+
+  // The used socket is still reused.
+  ClientSocketHandle handle;
+  EXPECT_EQ(OK, handle.Init("b", params_, LOWEST, SocketTag(),
+                            ClientSocketPool::RespectLimits::ENABLED,
+                            CompletionOnceCallback(),
+                            ClientSocketPool::ProxyAuthCallback(), pool_.get(),
+                            NetLogWithSource()));
+  EXPECT_TRUE(handle.is_reused());
+  EXPECT_EQ(0, pool_->IdleSocketCount());
+}
+
+// Make sure that the most recently used idle socket is reused first, ahead of
+// the unused ones.
+TEST_F(ClientSocketPoolBaseTest, ReuseMostRecentlyUsedIdleSocket) {
+  CreatePool(kDefaultMaxSockets, kDefaultMaxSocketsPerGroup);
+
+  ClientSocketHandle handles[3];
+  for (auto& handle : handles) {
+    EXPECT_EQ(OK, handle.Init("a", params_, LOWEST, SocketTag(),
+                              ClientSocketPool::RespectLimits::ENABLED,
+                              CompletionOnceCallback(),
+                              ClientSocketPool::ProxyAuthCallback(),
+                              pool_.get(), NetLogWithSource()));
+  }
+  StreamSocket* used_sockets[] = {handles[0].socket(), handles[1].socket()};
+  for (StreamSocket* socket : used_sockets) {
+    EXPECT_EQ(1, socket->Write(NULL, 1, CompletionOnceCallback(),
+                               TRAFFIC_ANNOTATION_FOR_TESTS));
+  }
+  handles[2].Reset();
+  handles[0].Reset();
+  handles[1].Reset();
+  ASSERT_EQ(3u, pool_->IdleSocketCountInGroup("a"));
+
+  for (int i = 1; i >= 0; --i) {
+    EXPECT_EQ(OK, handles[i].Init("a", params_, LOWEST, SocketTag(),
+                                  ClientSocketPool::RespectLimits::ENABLED,
+                                  CompletionOnceCallback(),
+                                  ClientSocketPool::ProxyAuthCallback(),
+                                  pool_.get(), NetLogWithSource()));
+    EXPECT_EQ(ClientSocketHandle::REUSED_IDLE, handles[i].reuse_type());
+    EXPECT_EQ(used_sockets[i], handles[i].socket());
+  }
+  EXPECT_EQ(1u, pool_->IdleSocketCountInGroup("a"));
+}
+
 // Make sure that we process all pending requests even when we're stalling
 // because of multiple releasing disconnected sockets.
 TEST_F(ClientSocketPoolBaseTest, MultipleReleasingDisconnectedSockets) {
@@ -3312,6 +3392,64 @@ TEST_F(ClientSocketPoolBaseTest, RequestSockets) {
   EXPECT_EQ(2u, pool_->IdleSocketCountInGroup("a"));
 }
 
+// Checks that a group that had several sockets in use at once gets them
+// preconnected when it's used again after being removed.
+TEST_F(ClientSocketPoolBaseTest, WarmRemovedGroup) {
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitAndEnableFeature(features::kSocketPoolWarming);
+  CreatePool(kDefaultMaxSockets, kDefaultMaxSocketsPerGroup);
+
+  ClientSocketHandle handles[kDefaultMaxSocketsPerGroup];
+  for (ClientSocketHandle& handle : handles) {
+    EXPECT_EQ(OK, handle.Init("a", params_, DEFAULT_PRIORITY, SocketTag(),
+                              ClientSocketPool::RespectLimits::ENABLED,
+                              CompletionOnceCallback(),
+                              ClientSocketPool::ProxyAuthCallback(),
+                              pool_.get(), NetLogWithSource()));
+  }
+  for (ClientSocketHandle& handle : handles)
+    handle.Reset();
+  pool_->CloseIdleSockets();
+  ASSERT_FALSE(pool_->HasGroup("a"));
+
+  connect_job_factory_->set_job_type(TestConnectJob::kMockPendingJob);
+  ClientSocketHandle handle;
+  TestCompletionCallback callback;
+  EXPECT_EQ(
+      ERR_IO_PENDING,
+      handle.Init("a", params_, DEFAULT_PRIORITY, SocketTag(),
+                  ClientSocketPool::RespectLimits::ENABLED,
+                  callback.callback(), ClientSocketPool::ProxyAuthCallback(),
+                  pool_.get(), NetLogWithSource()));
+  EXPECT_EQ(2u, pool_->NumConnectJobsInGroup("a"));
+  EXPECT_EQ(1u, pool_->NumUnassignedConnectJobsInGroup("a"));
+
+  // A group that only needed one socket isn't warmed.
+  ClientSocketHandle handle_b;
+  connect_job_factory_->set_job_type(TestConnectJob::kMockJob);
+  EXPECT_EQ(OK, handle_b.Init("b", params_, DEFAULT_PRIORITY, SocketTag(),
+                              ClientSocketPool::RespectLimits::ENABLED,
+                              CompletionOnceCallback(),
+                              ClientSocketPool::ProxyAuthCallback(),
+                              pool_.get(), NetLogWithSource()));
+  handle_b.Reset();
+  pool_->CloseIdleSocketsInGroup("b");
+  ASSERT_FALSE(pool_->HasGroup("b"));
+
+  connect_job_factory_->set_job_type(TestConnectJob::kMockPendingJob);
+  TestCompletionCallback callback_b;
+  EXPECT_EQ(ERR_IO_PENDING,
+            handle_b.Init("b", params_, DEFAULT_PRIORITY, SocketTag(),
+                          ClientSocketPool::RespectLimits::ENABLED,
+                          callback_b.callback(),
+                          ClientSocketPool::ProxyAuthCallback(), pool_.get(),
+                          NetLogWithSource()));
+  EXPECT_EQ(1u, pool_->NumConnectJobsInGroup("b"));
+
+  EXPECT_THAT(callback.WaitForResult(), IsOk());
+  EXPECT_THAT(callback_b.WaitForResult(), IsOk());
+}
+
 TEST_F(ClientSocketPoolBaseTest, RequestSocketsWhenAlreadyHaveAConnectJob) {
   CreatePool(kDefaultMaxSockets, kDefaultMaxSocketsPerGroup);
   connect_job_factory_->set_job_type(TestConnectJob::kMockPendingJob);
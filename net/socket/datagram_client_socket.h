@@ -5,7 +5,10 @@
 #ifndef NET_SOCKET_DATAGRAM_CLIENT_SOCKET_H_
 #define NET_SOCKET_DATAGRAM_CLIENT_SOCKET_H_
 
+#include <vector>
+
 #include "net/base/datagram_buffer.h"
+#include "net/base/net_errors.h"
 #include "net/base/net_export.h"
 #include "net/base/network_change_notifier.h"
 #include "net/socket/datagram_socket.h"
@@ -50,6 +53,30 @@ class NET_EXPORT_PRIVATE DatagramClientSocket : public DatagramSocket,
   // By default, this method is no-op.
   virtual void EnableRecvOptimization() {}
 
+  // Enables |ReadMultiple()|, and UDP generic segmentation offload for
+  // |WriteAsync()|, on platforms that support them. Must be called before
+  // the socket is connected. By default, this method is no-op.
+  virtual void EnableBatchedIO() {}
+
+  // Reads up to |max_datagrams| datagrams of up to |datagram_size| bytes with
+  // a single system call. Datagram i is stored at
+  // |buf->data() + i * datagram_size|, so |buf| must hold
+  // |max_datagrams * datagram_size| bytes, and its size is stored in
+  // |(*sizes)[i]|, or ERR_MSG_TOO_BIG if it was truncated.
+  //
+  // Returns the number of datagrams read or a net error code. As with |Read|,
+  // ERR_IO_PENDING means that the result will be passed to |callback|, and
+  // |sizes| must be kept alive until then. Returns ERR_NOT_IMPLEMENTED if the
+  // socket can't read several datagrams at once, in which case the caller
+  // should use |Read|.
+  virtual int ReadMultiple(IOBuffer* buf,
+                           int datagram_size,
+                           int max_datagrams,
+                           std::vector<int>* sizes,
+                           CompletionOnceCallback callback) {
+    return ERR_NOT_IMPLEMENTED;
+  }
+
   // As Write, but internally this can delay writes and batch them up
   // for writing in a separate task.  This is to increase throughput
   // in bulk transfer scenarios (in QUIC) where a substantial
@@ -120,9 +120,13 @@ int SocketBIOAdapter::BIORead(char* out, int len) {
     // layer reads the record header and body in separate reads to avoid
     // overreading, but issuing one is more efficient. SSL sockets are not
     // reused after shutdown for non-SSL traffic, so overreading is fine.
+    //
+    // The buffer is released as soon as it's drained, so that idle sockets
+    // don't hold on to it, and it's recycled to make that cheap.
     DCHECK(!read_buffer_);
     DCHECK_EQ(0, read_offset_);
-    read_buffer_ = base::MakeRefCounted<IOBuffer>(read_buffer_capacity_);
+    read_buffer_ = base::MakeRefCounted<RecycledIOBuffer>(
+        static_cast<size_t>(read_buffer_capacity_));
     int result = ERR_READ_IF_READY_NOT_IMPLEMENTED;
     if (base::FeatureList::IsEnabled(Socket::kReadIfReadyExperiment)) {
       result = socket_->ReadIfReady(
@@ -189,4 +189,23 @@ void UDPClientSocket::EnableRecvOptimization() {
 #endif
 }
 
+void UDPClientSocket::EnableBatchedIO() {
+#if defined(OS_POSIX)
+  socket_.EnableBatchedIO();
+#endif
+}
+
+int UDPClientSocket::ReadMultiple(IOBuffer* buf,
+                                  int datagram_size,
+                                  int max_datagrams,
+                                  std::vector<int>* sizes,
+                                  CompletionOnceCallback callback) {
+#if defined(OS_POSIX)
+  return socket_.ReadMultiple(buf, datagram_size, max_datagrams, sizes,
+                              std::move(callback));
+#else
+  return ERR_NOT_IMPLEMENTED;
+#endif
+}
+
 }  // namespace net
@@ -65,6 +65,12 @@ class NET_EXPORT_PRIVATE UDPClientSocket : public DatagramClientSocket {
   void SetMsgConfirm(bool confirm) override;
   const NetLogWithSource& NetLog() const override;
   void EnableRecvOptimization() override;
+  void EnableBatchedIO() override;
+  int ReadMultiple(IOBuffer* buf,
+                   int datagram_size,
+                   int max_datagrams,
+                   std::vector<int>* sizes,
+                   CompletionOnceCallback callback) override;
 
   void SetWriteAsyncEnabled(bool enabled) override;
   bool WriteAsyncEnabled() override;
@@ -11,6 +11,8 @@
 #include <netinet/in.h>
 #include <sys/ioctl.h>
 
+#include <algorithm>
+
 #include "base/bind.h"
 #include "base/callback.h"
 #include "base/callback_helpers.h"
@@ -43,6 +45,18 @@
 #include "net/socket/udp_net_log_parameters.h"
 #include "net/traffic_annotation/network_traffic_annotation.h"
 
+#if HAVE_SENDMMSG
+#include <netinet/udp.h>
+
+// From linux/udp.h, for sysroots that predate UDP GSO (Linux 4.18).
+#ifndef SOL_UDP
+#define SOL_UDP 17
+#endif
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+#endif  // HAVE_SENDMMSG
+
 #if defined(OS_ANDROID)
 #include <dlfcn.h>
 #include "base/android/build_info.h"
@@ -197,10 +211,13 @@ UDPSocketPosix::UDPSocketPosix(DatagramSocket::BindType bind_type,
       write_async_outstanding_(0),
       read_buf_len_(0),
       recv_from_address_(NULL),
+      read_max_datagrams_(0),
+      read_sizes_(nullptr),
       write_buf_len_(0),
       net_log_(NetLogWithSource::Make(net_log, NetLogSourceType::UDP_SOCKET)),
       bound_network_(NetworkChangeNotifier::kInvalidNetworkHandle),
       experimental_recv_optimization_enabled_(false),
+      batched_io_enabled_(false),
       weak_factory_(this) {
   net_log_.BeginEvent(NetLogEventType::SOCKET_ALIVE,
                       source.ToEventParametersCallback());
@@ -301,6 +318,8 @@ void UDPSocketPosix::Close() {
   read_buf_len_ = 0;
   read_callback_.Reset();
   recv_from_address_ = NULL;
+  read_max_datagrams_ = 0;
+  read_sizes_ = nullptr;
   write_buf_ = NULL;
   write_buf_len_ = 0;
   write_callback_.Reset();
@@ -410,6 +429,44 @@ int UDPSocketPosix::RecvFrom(IOBuffer* buf,
   return ERR_IO_PENDING;
 }
 
+int UDPSocketPosix::ReadMultiple(IOBuffer* buf,
+                                 int datagram_size,
+                                 int max_datagrams,
+                                 std::vector<int>* sizes,
+                                 CompletionOnceCallback callback) {
+  DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
+  DCHECK_NE(kInvalidSocket, socket_);
+  CHECK(read_callback_.is_null());
+  DCHECK(!callback.is_null());  // Synchronous operation not supported
+  DCHECK_GT(datagram_size, 0);
+  DCHECK_GT(max_datagrams, 0);
+
+  if (!HAVE_SENDMMSG || !batched_io_enabled_ || !is_connected_ ||
+      !remote_address_) {
+    return ERR_NOT_IMPLEMENTED;
+  }
+
+  int result = InternalReadMultiple(buf, datagram_size, max_datagrams, sizes);
+  if (result != ERR_IO_PENDING)
+    return result;
+
+  if (!base::MessageLoopCurrentForIO::Get()->WatchFileDescriptor(
+          socket_, true, base::MessagePumpForIO::WATCH_READ,
+          &read_socket_watcher_, &read_watcher_)) {
+    PLOG(ERROR) << "WatchFileDescriptor failed on read";
+    result = MapSystemError(errno);
+    LogRead(result, NULL, 0, NULL);
+    return result;
+  }
+
+  read_buf_ = buf;
+  read_buf_len_ = datagram_size;
+  read_max_datagrams_ = max_datagrams;
+  read_sizes_ = sizes;
+  read_callback_ = std::move(callback);
+  return ERR_IO_PENDING;
+}
+
 int UDPSocketPosix::Write(
     IOBuffer* buf,
     int buf_len,
@@ -737,12 +794,20 @@ void UDPSocketPosix::DoWriteCallback(int rv) {
 }
 
 void UDPSocketPosix::DidCompleteRead() {
-  int result =
-      InternalRecvFrom(read_buf_.get(), read_buf_len_, recv_from_address_);
+  int result;
+  if (read_sizes_) {
+    result = InternalReadMultiple(read_buf_.get(), read_buf_len_,
+                                  read_max_datagrams_, read_sizes_);
+  } else {
+    result =
+        InternalRecvFrom(read_buf_.get(), read_buf_len_, recv_from_address_);
+  }
   if (result != ERR_IO_PENDING) {
     read_buf_ = NULL;
     read_buf_len_ = 0;
     recv_from_address_ = NULL;
+    read_max_datagrams_ = 0;
+    read_sizes_ = nullptr;
     bool ok = read_socket_watcher_.StopWatchingFileDescriptor();
     DCHECK(ok);
     DoReadCallback(result);
@@ -880,6 +945,53 @@ int UDPSocketPosix::InternalRecvFromNonConnectedSocket(IOBuffer* buf,
   return result;
 }
 
+int UDPSocketPosix::InternalReadMultiple(IOBuffer* buf,
+                                         int datagram_size,
+                                         int max_datagrams,
+                                         std::vector<int>* sizes) {
+#if HAVE_SENDMMSG
+  DCHECK(is_connected_);
+  DCHECK(remote_address_);
+  max_datagrams = std::min(max_datagrams, kReadMultipleMaxDatagrams);
+  struct iovec msg_iov[kReadMultipleMaxDatagrams];
+  struct mmsghdr msgvec[kReadMultipleMaxDatagrams];
+  for (int i = 0; i < max_datagrams; ++i) {
+    msg_iov[i].iov_base = buf->data() + i * datagram_size;
+    msg_iov[i].iov_len = datagram_size;
+    std::memset(&msgvec[i], 0, sizeof(msgvec[i]));
+    msgvec[i].msg_hdr.msg_iov = &msg_iov[i];
+    msgvec[i].msg_hdr.msg_iovlen = 1;
+  }
+
+  int count =
+      HANDLE_EINTR(recvmmsg(socket_, msgvec, max_datagrams, 0, nullptr));
+  SockaddrStorage sock_addr;
+  bool success =
+      remote_address_->ToSockAddr(sock_addr.addr, &sock_addr.addr_len);
+  DCHECK(success);
+  if (count < 0) {
+    int result = MapSystemError(errno);
+    if (result != ERR_IO_PENDING)
+      LogRead(result, NULL, sock_addr.addr_len, sock_addr.addr);
+    return result;
+  }
+
+  sizes->clear();
+  for (int i = 0; i < count; ++i) {
+    const int result = (msgvec[i].msg_hdr.msg_flags & MSG_TRUNC)
+                           ? ERR_MSG_TOO_BIG
+                           : static_cast<int>(msgvec[i].msg_len);
+    sizes->push_back(result);
+    LogRead(result, buf->data() + i * datagram_size, sock_addr.addr_len,
+            sock_addr.addr);
+  }
+  return count;
+#else
+  NOTREACHED();
+  return ERR_NOT_IMPLEMENTED;
+#endif  // HAVE_SENDMMSG
+}
+
 int UDPSocketPosix::InternalSendTo(IOBuffer* buf,
                                    int buf_len,
                                    const IPEndPoint* address) {
@@ -1167,7 +1279,8 @@ void UDPSocketPosix::ApplySocketTag(const SocketTag& tag) {
   tag_ = tag;
 }
 
-UDPSocketPosixSender::UDPSocketPosixSender() : sendmmsg_enabled_(false) {}
+UDPSocketPosixSender::UDPSocketPosixSender()
+    : sendmmsg_enabled_(false), gso_enabled_(false) {}
 UDPSocketPosixSender::~UDPSocketPosixSender() {}
 
 SendResult::SendResult() : rv(0), write_count(0) {}
@@ -1218,10 +1331,93 @@ SendResult UDPSocketPosixSender::InternalSendmmsgBuffers(
   }
   return send_result;
 }
+
+SendResult UDPSocketPosixSender::InternalSendGSOBuffers(
+    int fd,
+    DatagramBuffers buffers) const {
+  // The kernel takes at most 64 segments, and 64 KB, per message.
+  constexpr int kMaxSegments = 64;
+  constexpr size_t kMaxMessageSize = 65535 - 8 - 40;
+  union ControlMessage {
+    char buf[CMSG_SPACE(sizeof(uint16_t))];
+    struct cmsghdr align;
+  };
+  const size_t buffer_count = buffers.size();
+  base::StackVector<struct iovec, kWriteAsyncMaxBuffersThreshold + 1> msg_iov;
+  base::StackVector<struct mmsghdr, kWriteAsyncMaxBuffersThreshold + 1> msgvec;
+  base::StackVector<ControlMessage, kWriteAsyncMaxBuffersThreshold + 1>
+      controls;
+  base::StackVector<int, kWriteAsyncMaxBuffersThreshold + 1> segment_counts;
+  msg_iov->resize(buffer_count);
+  msgvec->resize(buffer_count);
+  controls->resize(buffer_count);
+  segment_counts->resize(buffer_count);
+
+  // Each message takes a run of buffers of the same size, and possibly one
+  // shorter buffer, which the kernel sends as the last datagram of the run.
+  size_t message_count = 0;
+  size_t i = 0;
+  auto it = buffers.begin();
+  while (it != buffers.end()) {
+    struct mmsghdr& message = msgvec[message_count];
+    std::memset(&message, 0, sizeof(message));
+    message.msg_hdr.msg_iov = &msg_iov[i];
+    const size_t segment_size = (*it)->length();
+    size_t message_size = 0;
+    int segments = 0;
+    while (it != buffers.end() && segments < kMaxSegments &&
+           (*it)->length() <= segment_size &&
+           message_size + (*it)->length() <= kMaxMessageSize) {
+      const bool last = (*it)->length() < segment_size || segment_size == 0;
+      msg_iov[i].iov_base = const_cast<char*>((*it)->data());
+      msg_iov[i].iov_len = (*it)->length();
+      message_size += (*it)->length();
+      ++segments;
+      ++i;
+      ++it;
+      if (last)
+        break;
+    }
+    message.msg_hdr.msg_iovlen = segments;
+    if (segments > 1) {
+      message.msg_hdr.msg_control = controls[message_count].buf;
+      message.msg_hdr.msg_controllen = sizeof(controls[message_count].buf);
+      struct cmsghdr* cmsg = CMSG_FIRSTHDR(&message.msg_hdr);
+      cmsg->cmsg_level = SOL_UDP;
+      cmsg->cmsg_type = UDP_SEGMENT;
+      cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+      const uint16_t gso_size = segment_size;
+      std::memcpy(CMSG_DATA(cmsg), &gso_size, sizeof(gso_size));
+    }
+    segment_counts[message_count++] = segments;
+  }
+
+  int result = HANDLE_EINTR(Sendmmsg(fd, &msgvec[0], message_count, 0));
+  SendResult send_result(0, 0, std::move(buffers));
+  if (result < 0) {
+    send_result.rv = MapSystemError(errno);
+  } else {
+    for (int j = 0; j < result; ++j)
+      send_result.write_count += segment_counts[j];
+  }
+  return send_result;
+}
 #endif
 
 SendResult UDPSocketPosixSender::SendBuffers(int fd, DatagramBuffers buffers) {
 #if HAVE_SENDMMSG
+  if (gso_enabled_) {
+    auto result = InternalSendGSOBuffers(fd, std::move(buffers));
+    // Kernels without UDP_SEGMENT reject the message with EINVAL, and devices
+    // that can't offload the checksums with EIO.
+    if (LIKELY(result.rv != ERR_INVALID_ARGUMENT && result.rv != ERR_FAILED &&
+               result.rv != ERR_NOT_IMPLEMENTED)) {
+      return result;
+    }
+    DLOG(WARNING) << "UDP GSO not supported, falling back";
+    gso_enabled_ = false;
+    buffers = std::move(result.buffers);
+  }
   if (sendmmsg_enabled_) {
     auto result = InternalSendmmsgBuffers(fd, std::move(buffers));
     if (LIKELY(result.rv != ERR_NOT_IMPLEMENTED)) {
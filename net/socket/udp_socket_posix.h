@@ -10,6 +10,7 @@
 #include <sys/types.h>
 
 #include <memory>
+#include <vector>
 
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
@@ -74,6 +75,8 @@ const int kWriteAsyncMaxBuffersThreshold = 16;
 const int kWriteAsyncPostBuffersThreshold = kWriteAsyncMaxBuffersThreshold / 2;
 // Don't unblock writer unless pending async writes are less than this.
 const int kWriteAsyncCallbackBuffersThreshold = kWriteAsyncMaxBuffersThreshold;
+// Don't read more than this many datagrams with one |ReadMultiple()|.
+const int kReadMultipleMaxDatagrams = 16;
 
 // To allow mock |Send|/|Sendmsg| in testing.  This has to be
 // reference counted thread safe because |SendBuffers| and
@@ -91,6 +94,15 @@ class NET_EXPORT UDPSocketPosixSender
 #endif
   }
 
+  // Sends runs of equally sized buffers as single UDP_SEGMENT (GSO)
+  // messages, which the kernel splits into datagrams. Falls back to the other
+  // methods if the kernel or the device can't.
+  void SetGSOEnabled(bool enabled) {
+#if HAVE_SENDMMSG
+    gso_enabled_ = enabled;
+#endif
+  }
+
  protected:
   friend class base::RefCountedThreadSafe<UDPSocketPosixSender>;
 
@@ -109,12 +121,14 @@ class NET_EXPORT UDPSocketPosixSender
   SendResult InternalSendBuffers(int fd, DatagramBuffers buffers) const;
 #if HAVE_SENDMMSG
   SendResult InternalSendmmsgBuffers(int fd, DatagramBuffers buffers) const;
+  SendResult InternalSendGSOBuffers(int fd, DatagramBuffers buffers) const;
 #endif
 
  private:
   UDPSocketPosixSender(const UDPSocketPosixSender&) = delete;
   UDPSocketPosixSender& operator=(const UDPSocketPosixSender&) = delete;
   bool sendmmsg_enabled_;
+  bool gso_enabled_;
 };
 
 class NET_EXPORT UDPSocketPosix {
@@ -242,6 +256,15 @@ class NET_EXPORT UDPSocketPosix {
                IPEndPoint* address,
                CompletionOnceCallback callback);
 
+  // Refer to datagram_client_socket.h. Only connected sockets with
+  // |EnableBatchedIO()| can read several datagrams at once; the others return
+  // ERR_NOT_IMPLEMENTED.
+  int ReadMultiple(IOBuffer* buf,
+                   int datagram_size,
+                   int max_datagrams,
+                   std::vector<int>* sizes,
+                   CompletionOnceCallback callback);
+
   // Sends to a socket with a particular destination.
   // |buf| is the buffer to send.
   // |buf_len| is the number of bytes to send.
@@ -386,6 +409,14 @@ class NET_EXPORT UDPSocketPosix {
     experimental_recv_optimization_enabled_ = true;
   }
 
+  // Enables |ReadMultiple()| with recvmmsg(), and GSO for |WriteAsync()|, on
+  // platforms that support them.
+  void EnableBatchedIO() {
+    DCHECK(sender_ != nullptr);
+    batched_io_enabled_ = true;
+    sender_->SetGSOEnabled(true);
+  }
+
  protected:
   // WriteAsync batching etc. are to improve throughput of large high
   // bandwidth uploads.
@@ -523,6 +554,13 @@ class NET_EXPORT UDPSocketPosix {
                                          IPEndPoint* address);
   int InternalSendTo(IOBuffer* buf, int buf_len, const IPEndPoint* address);
 
+  // Reads up to |max_datagrams| datagrams with one recvmmsg() call, see
+  // |ReadMultiple()|.
+  int InternalReadMultiple(IOBuffer* buf,
+                           int datagram_size,
+                           int max_datagrams,
+                           std::vector<int>* sizes);
+
   // Applies |socket_options_| to |socket_|. Should be called before
   // Bind().
   int SetMulticastOptions();
@@ -598,6 +636,10 @@ class NET_EXPORT UDPSocketPosix {
   scoped_refptr<IOBuffer> read_buf_;
   int read_buf_len_;
   IPEndPoint* recv_from_address_;
+  // Set while a |ReadMultiple()| is pending, in which case |read_buf_len_| is
+  // the size of each datagram.
+  int read_max_datagrams_;
+  std::vector<int>* read_sizes_;
 
   // The buffer used by InternalWrite() to retry Write requests
   scoped_refptr<IOBuffer> write_buf_;
@@ -629,6 +671,9 @@ class NET_EXPORT UDPSocketPosix {
   // enable_experimental_recv_optimization() method.
   bool experimental_recv_optimization_enabled_;
 
+  // Set by |EnableBatchedIO()|.
+  bool batched_io_enabled_;
+
   THREAD_CHECKER(thread_checker_);
 
   // Used for alternate writes that are posted for concurrent execution.
@@ -336,6 +336,48 @@ TEST_F(UDPSocketPosixTest, SendInternalSendmmsgFallback) {
   EXPECT_EQ(kNumMsgs, result.buffers.size());
 }
 
+// Runs of buffers of the same size, the last of which may be shorter, are
+// sent as one UDP_SEGMENT message each.
+TEST_F(UDPSocketPosixTest, SendInternalGSO) {
+  socket_.sender()->SetGSOEnabled(true);
+  AddBuffers();
+  EXPECT_CALL(*socket_.sender(), Sendmmsg(_, _, 2, _))
+      .WillOnce(Invoke([](int sockfd, struct mmsghdr* msgvec,
+                          unsigned int vlen, unsigned int flags) {
+        EXPECT_EQ(1u, msgvec[0].msg_hdr.msg_iovlen);
+        EXPECT_EQ(0u, msgvec[0].msg_hdr.msg_controllen);
+        EXPECT_EQ(2u, msgvec[1].msg_hdr.msg_iovlen);
+        struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msgvec[1].msg_hdr);
+        EXPECT_TRUE(cmsg);
+        uint16_t segment_size = 0;
+        memcpy(&segment_size, CMSG_DATA(cmsg), sizeof(segment_size));
+        EXPECT_EQ(kSecondMsg.length(), segment_size);
+        return 2;
+      }));
+  SendResult result = socket_.sender()->SendBuffers(1, std::move(buffers_));
+  EXPECT_EQ(0, result.rv);
+  EXPECT_EQ(3, result.write_count);
+  EXPECT_EQ(kNumMsgs, result.buffers.size());
+}
+
+TEST_F(UDPSocketPosixTest, SendInternalGSOFallback) {
+  socket_.sender()->SetGSOEnabled(true);
+  AddBuffers();
+  {
+    InSequence dummy;
+    EXPECT_CALL(*socket_.sender(), Sendmmsg(_, _, 2, _))
+        .WillOnce(InvokeWithoutArgs([] {
+          errno = EINVAL;
+          return -1;
+        }));
+    ExpectSends();
+  }
+  SendResult result = socket_.sender()->SendBuffers(1, std::move(buffers_));
+  EXPECT_EQ(0, result.rv);
+  EXPECT_EQ(3, result.write_count);
+  EXPECT_EQ(kNumMsgs, result.buffers.size());
+}
+
 #endif  // HAVE_SENDMMSG
 
 TEST_F(UDPSocketPosixTest, DidSendBuffers) {
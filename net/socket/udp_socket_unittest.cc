@@ -5,6 +5,7 @@
 #include "net/socket/udp_socket.h"
 
 #include <algorithm>
+#include <vector>
 
 #include "base/bind.h"
 #include "base/containers/circular_deque.h"
@@ -311,6 +312,72 @@ TEST_F(UDPSocketTest, PartialRecv) {
   EXPECT_EQ(second_packet, received);
 }
 
+TEST_F(UDPSocketTest, ReadMultipleNotEnabled) {
+  UDPServerSocket server_socket(nullptr, NetLogSource());
+  ASSERT_THAT(server_socket.Listen(IPEndPoint(IPAddress::IPv4Localhost(), 0)),
+              IsOk());
+  IPEndPoint server_address;
+  ASSERT_THAT(server_socket.GetLocalAddress(&server_address), IsOk());
+
+  UDPClientSocket client_socket(DatagramSocket::DEFAULT_BIND, nullptr,
+                                NetLogSource());
+  ASSERT_THAT(client_socket.Connect(server_address), IsOk());
+
+  std::vector<int> sizes;
+  TestCompletionCallback callback;
+  EXPECT_THAT(client_socket.ReadMultiple(buffer_.get(), kMaxRead, 1, &sizes,
+                                         callback.callback()),
+              IsError(ERR_NOT_IMPLEMENTED));
+}
+
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+TEST_F(UDPSocketTest, ReadMultiple) {
+  UDPServerSocket server_socket(nullptr, NetLogSource());
+  ASSERT_THAT(server_socket.Listen(IPEndPoint(IPAddress::IPv4Localhost(), 0)),
+              IsOk());
+  IPEndPoint server_address;
+  ASSERT_THAT(server_socket.GetLocalAddress(&server_address), IsOk());
+
+  UDPClientSocket client_socket(DatagramSocket::DEFAULT_BIND, nullptr,
+                                NetLogSource());
+  client_socket.EnableBatchedIO();
+  ASSERT_THAT(client_socket.Connect(server_address), IsOk());
+
+  // The server learns the client's address from its first packet.
+  ASSERT_EQ(5, WriteSocket(&client_socket, "hello"));
+  ASSERT_EQ("hello", RecvFromSocket(&server_socket));
+
+  const int kDatagramSize = 20;
+  const std::string kMessages[] = {"first", "second datagram", "third"};
+  for (const std::string& message : kMessages) {
+    ASSERT_EQ(static_cast<int>(message.size()),
+              SendToSocket(&server_socket, message));
+  }
+
+  // Loopback datagrams are queued by the time SendTo() returns, so a single
+  // read gets all of them.
+  auto buffer = base::MakeRefCounted<IOBuffer>(4 * kDatagramSize);
+  std::vector<int> sizes;
+  TestCompletionCallback callback;
+  int rv = client_socket.ReadMultiple(buffer.get(), kDatagramSize, 4, &sizes,
+                                      callback.callback());
+  ASSERT_EQ(3, callback.GetResult(rv));
+  ASSERT_EQ(3u, sizes.size());
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(kMessages[i],
+              std::string(buffer->data() + i * kDatagramSize, sizes[i]));
+  }
+
+  // A datagram larger than |kDatagramSize| is reported as truncated.
+  ASSERT_EQ(kDatagramSize + 1,
+            SendToSocket(&server_socket, std::string(kDatagramSize + 1, 'a')));
+  rv = client_socket.ReadMultiple(buffer.get(), kDatagramSize, 4, &sizes,
+                                  callback.callback());
+  ASSERT_EQ(1, callback.GetResult(rv));
+  EXPECT_EQ(ERR_MSG_TOO_BIG, sizes[0]);
+}
+#endif  // defined(OS_LINUX) || defined(OS_ANDROID)
+
 #if defined(OS_MACOSX) || defined(OS_ANDROID) || defined(OS_FUCHSIA)
 // - MacOS: requires root permissions on OSX 10.7+.
 // - Android: devices attached to testbots don't have default network, so
@@ -59,17 +59,36 @@ class SpdyBuffer::SharedFrameIOBuffer : public IOBuffer {
   DISALLOW_COPY_AND_ASSIGN(SharedFrameIOBuffer);
 };
 
+SpdyBuffer::SharedFrame::SharedFrame(
+    std::unique_ptr<spdy::SpdySerializedFrame> data,
+    scoped_refptr<IOBuffer> backing_buffer)
+    : data(std::move(data)), backing_buffer(std::move(backing_buffer)) {}
+
+SpdyBuffer::SharedFrame::~SharedFrame() = default;
+
 SpdyBuffer::SpdyBuffer(std::unique_ptr<spdy::SpdySerializedFrame> frame)
-    : shared_frame_(new SharedFrame(std::move(frame))), offset_(0) {}
+    : shared_frame_(new SharedFrame(std::move(frame), nullptr)), offset_(0) {}
 
 // The given data may not be strictly a SPDY frame; we (ab)use
 // |frame_| just as a container.
-SpdyBuffer::SpdyBuffer(const char* data, size_t size) :
-    shared_frame_(new SharedFrame()),
-    offset_(0) {
+SpdyBuffer::SpdyBuffer(const char* data, size_t size)
+    : shared_frame_(
+          new SharedFrame(MakeSpdySerializedFrame(data, size), nullptr)),
+      offset_(0) {}
+
+SpdyBuffer::SpdyBuffer(scoped_refptr<IOBuffer> buffer,
+                       const char* data,
+                       size_t size)
+    : shared_frame_(new SharedFrame(
+          std::make_unique<spdy::SpdySerializedFrame>(const_cast<char*>(data),
+                                                      size,
+                                                      false /* owns_buffer */),
+          std::move(buffer))),
+      offset_(0) {
+  DCHECK(shared_frame_->backing_buffer);
+  DCHECK_GE(data, shared_frame_->backing_buffer->data());
   CHECK_GT(size, 0u);
   CHECK_LE(size, kMaxSpdyFrameSize);
-  shared_frame_->data = MakeSpdySerializedFrame(data, size);
 }
 
 SpdyBuffer::~SpdyBuffer() {
@@ -99,6 +118,10 @@ scoped_refptr<IOBuffer> SpdyBuffer::GetIOBufferForRemainingData() {
 
 size_t SpdyBuffer::EstimateMemoryUsage() const {
   // TODO(xunjieli): Estimate |consume_callbacks_|. https://crbug.com/669108.
+  // Only the data of |backing_buffer| that this buffer uses is counted, since
+  // the rest of it is shared with other buffers, or unused.
+  if (shared_frame_->backing_buffer)
+    return shared_frame_->data->size();
   return base::trace_event::EstimateMemoryUsage(shared_frame_->data);
 }
 
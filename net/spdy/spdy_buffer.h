@@ -56,6 +56,12 @@ class NET_EXPORT_PRIVATE SpdyBuffer {
   // non-NULL and |size| must be non-zero.
   SpdyBuffer(const char* data, size_t size);
 
+  // Construct with the |size| bytes at |data|, which must be within
+  // |buffer|, without copying them. |buffer| is kept alive for as long
+  // as the data may be used, including through
+  // GetIOBufferForRemainingData(). |size| must be non-zero.
+  SpdyBuffer(scoped_refptr<IOBuffer> buffer, const char* data, size_t size);
+
   // If there are bytes remaining in the buffer, triggers a call to
   // any consume callbacks with a DISCARD source.
   ~SpdyBuffer();
@@ -92,10 +98,22 @@ class NET_EXPORT_PRIVATE SpdyBuffer {
  private:
   void ConsumeHelper(size_t consume_size, ConsumeSource consume_source);
 
-  // Ref-count the passed-in spdy::SpdySerializedFrame to support the semantics
-  // of |GetIOBufferForRemainingData()|.
-  typedef base::RefCountedData<std::unique_ptr<spdy::SpdySerializedFrame>>
-      SharedFrame;
+  // Ref-count the passed-in spdy::SpdySerializedFrame, and the IOBuffer that
+  // holds its data if it doesn't own it, to support the semantics of
+  // |GetIOBufferForRemainingData()|.
+  struct SharedFrame : public base::RefCountedThreadSafe<SharedFrame> {
+    SharedFrame(std::unique_ptr<spdy::SpdySerializedFrame> data,
+                scoped_refptr<IOBuffer> backing_buffer);
+
+    const std::unique_ptr<spdy::SpdySerializedFrame> data;
+    const scoped_refptr<IOBuffer> backing_buffer;
+
+   private:
+    friend class base::RefCountedThreadSafe<SharedFrame>;
+    ~SharedFrame();
+
+    DISALLOW_COPY_AND_ASSIGN(SharedFrame);
+  };
 
   class SharedFrameIOBuffer;
 
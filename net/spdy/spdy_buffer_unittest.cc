@@ -54,6 +54,36 @@ TEST_F(SpdyBufferTest, DataConstructor) {
   EXPECT_EQ(std::string(kData, kDataSize), BufferToString(buffer));
 }
 
+// Construct a SpdyBuffer from part of an IOBuffer and make sure it
+// points to the IOBuffer's data, and keeps the IOBuffer alive.
+TEST_F(SpdyBufferTest, IOBufferConstructor) {
+  auto io_buffer = base::MakeRefCounted<IOBuffer>(kDataSize + 2);
+  std::memcpy(io_buffer->data() + 1, kData, kDataSize);
+  SpdyBuffer buffer(io_buffer, io_buffer->data() + 1, kDataSize);
+  const char* data = io_buffer->data() + 1;
+  io_buffer = nullptr;
+
+  EXPECT_EQ(data, buffer.GetRemainingData());
+  EXPECT_EQ(kDataSize, buffer.GetRemainingSize());
+  EXPECT_EQ(std::string(kData, kDataSize), BufferToString(buffer));
+}
+
+// Make sure the IOBuffer returned by GetIOBufferForRemainingData()
+// keeps the IOBuffer that a SpdyBuffer points into alive.
+TEST_F(SpdyBufferTest, IOBufferForRemainingDataOutlivesSharedBuffer) {
+  auto io_buffer = base::MakeRefCounted<IOBuffer>(kDataSize);
+  auto buffer =
+      std::make_unique<SpdyBuffer>(io_buffer, io_buffer->data(), kDataSize);
+  io_buffer = nullptr;
+  scoped_refptr<IOBuffer> remaining_data_buffer =
+      buffer->GetIOBufferForRemainingData();
+  buffer.reset();
+
+  // This will cause a use-after-free error if |remaining_data_buffer| doesn't
+  // keep the original IOBuffer alive.
+  std::memcpy(remaining_data_buffer->data(), kData, kDataSize);
+}
+
 void IncrementBy(size_t* x,
                  SpdyBuffer::ConsumeSource expected_consume_source,
                  size_t delta,
@@ -4,11 +4,15 @@
 
 #include "net/spdy/spdy_session.h"
 
+#include <string.h>
+
 #include <algorithm>
 #include <limits>
 #include <map>
+#include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "base/bind.h"
 #include "base/feature_list.h"
@@ -88,6 +92,15 @@ constexpr net::NetworkTrafficAnnotationTag
     )");
 
 const int kReadBufferSize = 8 * 1024;
+// DATA payloads at least this large keep a reference to the read buffer they
+// were read into, instead of being copied out of it. Each read uses a new read
+// buffer, so sharing it only costs memory when a small payload keeps a whole
+// read buffer alive; this bounds the overhead to 4x.
+const size_t kMinSharedReadBufferDataSize = kReadBufferSize / 4;
+// Frames that are waiting to be written are coalesced into a single socket
+// write, and so a single TLS record, until the write reaches this size.
+// Copying them costs less than the syscalls and record overhead it saves.
+const size_t kMaxCoalescedWriteSize = 16 * 1024;
 const int kDefaultConnectionAtRiskOfLossSeconds = 10;
 const int kHungIntervalSeconds = 10;
 
@@ -853,8 +866,6 @@ SpdySession::SpdySession(
       num_active_pushed_streams_(0u),
       bytes_pushed_count_(0u),
       bytes_pushed_and_unclaimed_count_(0u),
-      in_flight_write_frame_type_(spdy::SpdyFrameType::DATA),
-      in_flight_write_frame_size_(0),
       availability_state_(STATE_AVAILABLE),
       read_state_(READ_STATE_DO_READ),
       write_state_(WRITE_STATE_IDLE),
@@ -2302,45 +2313,46 @@ int SpdySession::DoWrite() {
     DCHECK_GT(in_flight_write_->GetRemainingSize(), 0u);
   } else {
     // Grab the next frame to send.
-    spdy::SpdyFrameType frame_type = spdy::SpdyFrameType::DATA;
-    std::unique_ptr<SpdyBufferProducer> producer;
-    base::WeakPtr<SpdyStream> stream;
-    if (!write_queue_.Dequeue(&frame_type, &producer, &stream,
-                              &in_flight_write_traffic_annotation)) {
+    if (write_queue_.IsEmpty()) {
       write_state_ = WRITE_STATE_IDLE;
       return ERR_IO_PENDING;
     }
+    DCHECK(in_flight_write_frames_.empty());
+    in_flight_write_ = ProduceNextWrite(&in_flight_write_traffic_annotation);
+    if (!in_flight_write_)
+      return ERR_UNEXPECTED;
 
-    if (stream.get())
-      CHECK(!stream->IsClosed());
-
-    // Activate the stream only when sending the HEADERS frame to
-    // guarantee monotonically-increasing stream IDs.
-    if (frame_type == spdy::SpdyFrameType::HEADERS) {
-      CHECK(stream.get());
-      CHECK_EQ(stream->stream_id(), 0u);
-      std::unique_ptr<SpdyStream> owned_stream =
-          ActivateCreatedStream(stream.get());
-      InsertActivatedStream(std::move(owned_stream));
-
-      if (stream_hi_water_mark_ > kLastStreamId) {
-        CHECK_EQ(stream->stream_id(), kLastStreamId);
-        // We've exhausted the stream ID space, and no new streams may be
-        // created after this one.
-        MakeUnavailable();
-        StartGoingAway(kLastStreamId, ERR_ABORTED);
-      }
+    // Coalesce the frames that follow it, in priority order, while the write
+    // is small. The write as a whole is annotated as its first frame.
+    std::vector<std::unique_ptr<SpdyBuffer>> coalesced_writes;
+    size_t write_size = in_flight_write_->GetRemainingSize();
+    while (write_size < kMaxCoalescedWriteSize && !write_queue_.IsEmpty()) {
+      MutableNetworkTrafficAnnotationTag traffic_annotation;
+      std::unique_ptr<SpdyBuffer> buffer =
+          ProduceNextWrite(&traffic_annotation);
+      if (!buffer)
+        break;
+      write_size += buffer->GetRemainingSize();
+      coalesced_writes.push_back(std::move(buffer));
     }
 
-    in_flight_write_ = producer->ProduceBuffer();
-    if (!in_flight_write_) {
-      NOTREACHED();
-      return ERR_UNEXPECTED;
+    if (!coalesced_writes.empty()) {
+      auto data = std::make_unique<char[]>(write_size);
+      size_t offset = 0;
+      coalesced_writes.insert(coalesced_writes.begin(),
+                              std::move(in_flight_write_));
+      for (const auto& buffer : coalesced_writes) {
+        size_t size = buffer->GetRemainingSize();
+        memcpy(data.get() + offset, buffer->GetRemainingData(), size);
+        // The frames count as consumed once they're copied, so that their
+        // consume callbacks don't give back flow control window for them.
+        buffer->Consume(size);
+        offset += size;
+      }
+      in_flight_write_ = std::make_unique<SpdyBuffer>(
+          std::make_unique<spdy::SpdySerializedFrame>(data.release(),
+                                                      write_size, true));
     }
-    in_flight_write_frame_type_ = frame_type;
-    in_flight_write_frame_size_ = in_flight_write_->GetRemainingSize();
-    DCHECK_GE(in_flight_write_frame_size_, spdy::kFrameMinimumSize);
-    in_flight_write_stream_ = stream;
   }
 
   write_state_ = WRITE_STATE_DO_WRITE_COMPLETE;
@@ -2362,9 +2374,7 @@ int SpdySession::DoWriteComplete(int result) {
   if (result < 0) {
     DCHECK_NE(result, ERR_IO_PENDING);
     in_flight_write_.reset();
-    in_flight_write_frame_type_ = spdy::SpdyFrameType::DATA;
-    in_flight_write_frame_size_ = 0;
-    in_flight_write_stream_.reset();
+    in_flight_write_frames_.clear();
     in_flight_write_traffic_annotation.reset();
     write_state_ = WRITE_STATE_DO_WRITE;
     DoDrainSession(static_cast<Error>(result), "Write error");
@@ -2377,24 +2387,39 @@ int SpdySession::DoWriteComplete(int result) {
 
   if (result > 0) {
     in_flight_write_->Consume(static_cast<size_t>(result));
-    if (in_flight_write_stream_.get())
-      in_flight_write_stream_->AddRawSentBytes(static_cast<size_t>(result));
 
-    // We only notify the stream when we've fully written the pending frame.
-    if (in_flight_write_->GetRemainingSize() == 0) {
+    // Attribute the written bytes to the frames they belong to. We only
+    // notify a stream when we've fully written its frame.
+    size_t written = static_cast<size_t>(result);
+    while (written > 0) {
+      DCHECK(!in_flight_write_frames_.empty());
+      InFlightFrame& frame = in_flight_write_frames_.front();
+      size_t frame_written = std::min(written, frame.remaining_size);
+      frame.remaining_size -= frame_written;
+      written -= frame_written;
+      if (frame.stream.get())
+        frame.stream->AddRawSentBytes(frame_written);
+      if (frame.remaining_size > 0)
+        break;
+
+      // Pop the frame before notifying its stream, which may delete streams
+      // of other in-flight frames.
+      InFlightFrame completed_frame = std::move(frame);
+      in_flight_write_frames_.pop_front();
+
       // It is possible that the stream was cancelled while we were
       // writing to the socket.
-      if (in_flight_write_stream_.get()) {
-        DCHECK_GT(in_flight_write_frame_size_, 0u);
-        in_flight_write_stream_->OnFrameWriteComplete(
-            in_flight_write_frame_type_, in_flight_write_frame_size_);
+      if (completed_frame.stream.get()) {
+        DCHECK_GT(completed_frame.size, 0u);
+        completed_frame.stream->OnFrameWriteComplete(completed_frame.frame_type,
+                                                     completed_frame.size);
       }
+    }
 
-      // Cleanup the write which just completed.
+    // Cleanup the write which just completed.
+    if (in_flight_write_->GetRemainingSize() == 0) {
+      DCHECK(in_flight_write_frames_.empty());
       in_flight_write_.reset();
-      in_flight_write_frame_type_ = spdy::SpdyFrameType::DATA;
-      in_flight_write_frame_size_ = 0;
-      in_flight_write_stream_.reset();
     }
   }
 
@@ -2402,6 +2427,48 @@ int SpdySession::DoWriteComplete(int result) {
   return OK;
 }
 
+std::unique_ptr<SpdyBuffer> SpdySession::ProduceNextWrite(
+    MutableNetworkTrafficAnnotationTag* traffic_annotation) {
+  spdy::SpdyFrameType frame_type = spdy::SpdyFrameType::DATA;
+  std::unique_ptr<SpdyBufferProducer> producer;
+  base::WeakPtr<SpdyStream> stream;
+  if (!write_queue_.Dequeue(&frame_type, &producer, &stream,
+                            traffic_annotation)) {
+    return nullptr;
+  }
+
+  if (stream.get())
+    CHECK(!stream->IsClosed());
+
+  // Activate the stream only when sending the HEADERS frame to
+  // guarantee monotonically-increasing stream IDs.
+  if (frame_type == spdy::SpdyFrameType::HEADERS) {
+    CHECK(stream.get());
+    CHECK_EQ(stream->stream_id(), 0u);
+    std::unique_ptr<SpdyStream> owned_stream =
+        ActivateCreatedStream(stream.get());
+    InsertActivatedStream(std::move(owned_stream));
+
+    if (stream_hi_water_mark_ > kLastStreamId) {
+      CHECK_EQ(stream->stream_id(), kLastStreamId);
+      // We've exhausted the stream ID space, and no new streams may be
+      // created after this one.
+      MakeUnavailable();
+      StartGoingAway(kLastStreamId, ERR_ABORTED);
+    }
+  }
+
+  std::unique_ptr<SpdyBuffer> buffer = producer->ProduceBuffer();
+  if (!buffer) {
+    NOTREACHED();
+    return nullptr;
+  }
+  size_t size = buffer->GetRemainingSize();
+  DCHECK_GE(size, spdy::kFrameMinimumSize);
+  in_flight_write_frames_.push_back({frame_type, size, size, stream});
+  return buffer;
+}
+
 void SpdySession::SendInitialData() {
   DCHECK(enable_sending_initial_data_);
   DCHECK(buffered_spdy_framer_.get());
@@ -2710,12 +2777,13 @@ void SpdySession::InsertActivatedStream(std::unique_ptr<SpdyStream> stream) {
 }
 
 void SpdySession::DeleteStream(std::unique_ptr<SpdyStream> stream, int status) {
-  if (in_flight_write_stream_.get() == stream.get()) {
-    // If we're deleting the stream for the in-flight write, we still
-    // need to let the write complete, so we clear
-    // |in_flight_write_stream_| and let the write finish on its own
-    // without notifying |in_flight_write_stream_|.
-    in_flight_write_stream_.reset();
+  for (InFlightFrame& frame : in_flight_write_frames_) {
+    if (frame.stream.get() == stream.get()) {
+      // If we're deleting the stream for an in-flight frame, we still
+      // need to let the write complete, so we clear the frame's stream
+      // and let the write finish on its own without notifying it.
+      frame.stream.reset();
+    }
   }
 
   write_queue_.RemovePendingWritesForStream(stream.get());
@@ -3062,7 +3130,13 @@ void SpdySession::OnStreamFrameData(spdy::SpdyStreamId stream_id,
   if (data) {
     DCHECK_GT(len, 0u);
     CHECK_LE(len, static_cast<size_t>(kReadBufferSize));
-    buffer = std::make_unique<SpdyBuffer>(data, len);
+    if (len >= kMinSharedReadBufferDataSize && read_buffer_ &&
+        data >= read_buffer_->data() &&
+        data + len <= read_buffer_->data() + kReadBufferSize) {
+      buffer = std::make_unique<SpdyBuffer>(read_buffer_, data, len);
+    } else {
+      buffer = std::make_unique<SpdyBuffer>(data, len);
+    }
 
     DecreaseRecvWindowSize(static_cast<int32_t>(len));
     buffer->AddConsumeCallback(base::Bind(&SpdySession::OnReadBufferConsumed,
@@ -704,6 +704,13 @@ class NET_EXPORT SpdySession : public BufferedSpdyFramerVisitorInterface,
   int DoWrite();
   int DoWriteComplete(int result);
 
+  // Dequeues the next frame producer from |write_queue_| and produces its
+  // frame, activating its stream first if it's a HEADERS frame. Appends the
+  // frame to |in_flight_write_frames_|. Returns null if |write_queue_| is
+  // empty.
+  std::unique_ptr<SpdyBuffer> ProduceNextWrite(
+      MutableNetworkTrafficAnnotationTag* traffic_annotation);
+
   // TODO(akalin): Rename the Send* and Write* functions below to
   // Enqueue*.
 
@@ -960,8 +967,9 @@ class NET_EXPORT SpdySession : public BufferedSpdyFramerVisitorInterface,
   // The socket for this session.
   StreamSocket* socket_;
 
-  // The read buffer used to read data from the socket.
-  // Non-null if there is a Read() pending.
+  // The read buffer used to read data from the socket. Non-null if there is a
+  // Read() pending, and while the data it read is processed. A new one is used
+  // for each read, since SpdyBuffers may keep a reference to it.
   scoped_refptr<IOBuffer> read_buffer_;
 
   spdy::SpdyStreamId stream_hi_water_mark_;  // The next stream id to use.
@@ -1016,15 +1024,22 @@ class NET_EXPORT SpdySession : public BufferedSpdyFramerVisitorInterface,
 
   // Data for the frame we are currently sending.
 
-  // The buffer we're currently writing.
+  // A frame in |in_flight_write_|.
+  struct InFlightFrame {
+    spdy::SpdyFrameType frame_type;
+    // The size of the frame, and the number of its bytes that are yet to be
+    // written.
+    size_t size;
+    size_t remaining_size;
+    // The stream to notify when the frame has been written to the socket
+    // completely.
+    base::WeakPtr<SpdyStream> stream;
+  };
+
+  // The buffer we're currently writing. It holds the frames in
+  // |in_flight_write_frames_|, in order.
   std::unique_ptr<SpdyBuffer> in_flight_write_;
-  // The type of the frame in |in_flight_write_|.
-  spdy::SpdyFrameType in_flight_write_frame_type_;
-  // The size of the frame in |in_flight_write_|.
-  size_t in_flight_write_frame_size_;
-  // The stream to notify when |in_flight_write_| has been written to
-  // the socket completely.
-  base::WeakPtr<SpdyStream> in_flight_write_stream_;
+  base::circular_deque<InFlightFrame> in_flight_write_frames_;
 
   // Traffic annotation for the write in progress.
   MutableNetworkTrafficAnnotationTag in_flight_write_traffic_annotation;
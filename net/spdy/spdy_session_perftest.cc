@@ -0,0 +1,132 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/spdy/spdy_session.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/run_loop.h"
+#include "base/time/time.h"
+#include "net/base/host_port_pair.h"
+#include "net/base/proxy_server.h"
+#include "net/base/request_priority.h"
+#include "net/log/net_log_with_source.h"
+#include "net/socket/socket_tag.h"
+#include "net/socket/socket_test_util.h"
+#include "net/spdy/spdy_buffer.h"
+#include "net/spdy/spdy_stream.h"
+#include "net/spdy/spdy_stream_test_util.h"
+#include "net/spdy/spdy_test_util_common.h"
+#include "net/test/cert_test_util.h"
+#include "net/test/gtest_util.h"
+#include "net/test/test_data_directory.h"
+#include "net/test/test_with_scoped_task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+#include "url/gurl.h"
+
+namespace net {
+
+namespace {
+
+constexpr int kFramePayloadSize = 16 * 1024;
+constexpr int kFrameCount = 4096;
+
+// Copies the data of the stream into a fixed buffer as it arrives, like the
+// URLLoader copies it into its data pipe.
+class DrainingDelegate : public test::StreamDelegateBase {
+ public:
+  explicit DrainingDelegate(const base::WeakPtr<SpdyStream>& stream)
+      : StreamDelegateBase(stream), sink_(kFramePayloadSize) {}
+
+  void OnDataReceived(std::unique_ptr<SpdyBuffer> buffer) override {
+    while (buffer && buffer->GetRemainingSize() > 0) {
+      size_t size = std::min(buffer->GetRemainingSize(), sink_.size());
+      memcpy(sink_.data(), buffer->GetRemainingData(), size);
+      buffer->Consume(size);
+      received_bytes_ += size;
+    }
+  }
+
+  int64_t received_bytes() const { return received_bytes_; }
+
+ private:
+  std::vector<char> sink_;
+  int64_t received_bytes_ = 0;
+};
+
+class SpdySessionPerfTest : public TestWithScopedTaskEnvironment {
+ protected:
+  SpdySessionPerfTest()
+      : TestWithScopedTaskEnvironment(
+            base::test::ScopedTaskEnvironment::MainThreadType::IO) {}
+};
+
+}  // namespace
+
+// Receives a large response over an HTTP/2 session, and reports the rate at
+// which its data is delivered to the stream.
+TEST_F(SpdySessionPerfTest, ReceiveData) {
+  SpdyTestUtil spdy_util;
+  spdy::SpdySerializedFrame resp(
+      spdy_util.ConstructSpdyGetReply(nullptr, 0, 1));
+  std::string payload(kFramePayloadSize, 'h');
+  spdy::SpdySerializedFrame data_frame(
+      spdy_util.ConstructSpdyDataFrame(1, payload, /*fin=*/false));
+  spdy::SpdySerializedFrame last_data_frame(
+      spdy_util.ConstructSpdyDataFrame(1, payload, /*fin=*/true));
+
+  std::vector<MockRead> reads;
+  reads.push_back(CreateMockRead(resp, 0, SYNCHRONOUS));
+  for (int i = 0; i < kFrameCount - 1; ++i)
+    reads.push_back(CreateMockRead(data_frame, 0, SYNCHRONOUS));
+  reads.push_back(CreateMockRead(last_data_frame, 0, SYNCHRONOUS));
+  reads.push_back(MockRead(ASYNC, 0));
+  // Without mock writes, the request and the WINDOW_UPDATE frames that the
+  // session sends as the data is consumed are all written synchronously.
+  StaticSocketDataProvider data(reads, base::span<MockWrite>());
+
+  SpdySessionDependencies session_deps;
+  session_deps.socket_factory->AddSocketDataProvider(&data);
+  SSLSocketDataProvider ssl(SYNCHRONOUS, OK);
+  ssl.ssl_info.cert =
+      ImportCertFromFile(GetTestCertsDirectory(), "spdy_pooling.pem");
+  ASSERT_TRUE(ssl.ssl_info.cert);
+  session_deps.socket_factory->AddSSLSocketDataProvider(&ssl);
+
+  std::unique_ptr<HttpNetworkSession> http_session =
+      SpdySessionDependencies::SpdyCreateSession(&session_deps);
+  GURL url(kDefaultUrl);
+  SpdySessionKey key(HostPortPair::FromURL(url), ProxyServer::Direct(),
+                     PRIVACY_MODE_DISABLED,
+                     SpdySessionKey::IsProxySession::kFalse, SocketTag());
+  base::WeakPtr<SpdySession> session =
+      CreateSpdySession(http_session.get(), key, NetLogWithSource());
+
+  base::WeakPtr<SpdyStream> stream = CreateStreamSynchronously(
+      SPDY_REQUEST_RESPONSE_STREAM, session, url, MEDIUM, NetLogWithSource());
+  ASSERT_TRUE(stream);
+  DrainingDelegate delegate(stream);
+  stream->SetDelegate(&delegate);
+  stream->SendRequestHeaders(spdy_util.ConstructGetHeaderBlock(kDefaultUrl),
+                             NO_MORE_DATA_TO_SEND);
+
+  base::TimeTicks start = base::TimeTicks::Now();
+  EXPECT_THAT(delegate.WaitForClose(), test::IsOk());
+  base::TimeDelta elapsed = base::TimeTicks::Now() - start;
+  EXPECT_EQ(static_cast<int64_t>(kFramePayloadSize) * kFrameCount,
+            delegate.received_bytes());
+
+  perf_test::PrintResult("SpdySession_ReceiveData", "", "throughput",
+                         8.0 * delegate.received_bytes() /
+                             elapsed.InSecondsF() / 1e6,
+                         "Mbit/s", true);
+}
+
+}  // namespace net
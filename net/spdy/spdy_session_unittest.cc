@@ -1233,6 +1233,61 @@ TEST_F(SpdySessionTest, PingAndWriteLoop) {
   EXPECT_FALSE(session_);
 }
 
+// Frames that are queued together are coalesced into a single write, in
+// priority order.
+TEST_F(SpdySessionTest, CoalesceQueuedFrames) {
+  spdy::SpdySerializedFrame req1(
+      spdy_util_.ConstructSpdyGet(nullptr, 0, 1, HIGHEST));
+  spdy::SpdySerializedFrame req2(
+      spdy_util_.ConstructSpdyGet(nullptr, 0, 3, LOWEST));
+  spdy::SpdySerializedFrame reqs(CombineFrames({&req1, &req2}));
+  MockWrite writes[] = {
+      CreateMockWrite(reqs, 0),
+  };
+
+  MockRead reads[] = {
+      MockRead(ASYNC, ERR_IO_PENDING, 1), MockRead(ASYNC, 0, 2)  // EOF
+  };
+
+  SequencedSocketData data(reads, writes);
+  session_deps_.socket_factory->AddSocketDataProvider(&data);
+
+  AddSSLSocketData();
+
+  CreateNetworkSession();
+  CreateSpdySession();
+
+  base::WeakPtr<SpdyStream> spdy_stream_lowest =
+      CreateStreamSynchronously(SPDY_REQUEST_RESPONSE_STREAM, session_,
+                                test_url_, LOWEST, NetLogWithSource());
+  test::StreamDelegateDoNothing delegate_lowest(spdy_stream_lowest);
+  spdy_stream_lowest->SetDelegate(&delegate_lowest);
+
+  base::WeakPtr<SpdyStream> spdy_stream_highest =
+      CreateStreamSynchronously(SPDY_REQUEST_RESPONSE_STREAM, session_,
+                                test_url_, HIGHEST, NetLogWithSource());
+  test::StreamDelegateDoNothing delegate_highest(spdy_stream_highest);
+  spdy_stream_highest->SetDelegate(&delegate_highest);
+
+  spdy_stream_lowest->SendRequestHeaders(
+      spdy_util_.ConstructGetHeaderBlock(kDefaultUrl), NO_MORE_DATA_TO_SEND);
+  spdy_stream_highest->SendRequestHeaders(
+      spdy_util_.ConstructGetHeaderBlock(kDefaultUrl), NO_MORE_DATA_TO_SEND);
+
+  base::RunLoop().RunUntilIdle();
+  EXPECT_TRUE(data.AllWriteDataConsumed());
+  EXPECT_EQ(1u, spdy_stream_highest->stream_id());
+  EXPECT_EQ(3u, spdy_stream_lowest->stream_id());
+  EXPECT_EQ(static_cast<int64_t>(req1.size()),
+            spdy_stream_highest->raw_sent_bytes());
+  EXPECT_EQ(static_cast<int64_t>(req2.size()),
+            spdy_stream_lowest->raw_sent_bytes());
+
+  data.Resume();
+  base::RunLoop().RunUntilIdle();
+  EXPECT_FALSE(session_);
+}
+
 TEST_F(SpdySessionTest, StreamIdSpaceExhausted) {
   const spdy::SpdyStreamId kLastStreamId = 0x7fffffff;
 
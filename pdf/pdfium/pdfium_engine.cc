@@ -789,7 +789,7 @@ void PDFiumEngine::Paint(const pp::Rect& rect,
   DCHECK(pending);
 
   pp::Rect leftover = rect;
-  for (size_t i = 0; i < visible_pages_.size(); ++i) {
+  for (size_t i = 0; i < visible_pages_.size() && !leftover.IsEmpty(); ++i) {
     int index = visible_pages_[i];
     // Convert the current page's rectangle to screen rectangle.  We do this
     // instead of the reverse (converting the dirty rectangle from screen to
@@ -191,11 +191,15 @@ bool MetafileSkia::FinishDocument() {
       break;
   }
 
-  for (const Page& page : data_->pages) {
+  for (Page& page : data_->pages) {
     cc::SkiaPaintCanvas canvas(
         doc->beginPage(page.size.width(), page.size.height()));
     canvas.drawPicture(page.content, custom_callback);
     doc->endPage();
+    // The page has been written to |doc|. Drop its recording so large jobs do
+    // not keep every recording alive next to the finished output. Only the
+    // page size is needed after this point.
+    page.content.reset();
   }
   doc->close();
 
@@ -515,8 +515,7 @@ void VideoEncoderVpx::SetActiveMapFromRegion(
 
     uint8_t* map = active_map_.get() + top * active_map_size_.width();
     for (int y = top; y <= bottom; ++y) {
-      for (int x = left; x <= right; ++x)
-        map[x] = 1;
+      memset(map + left, 1, right - left + 1);
       map += active_map_size_.width();
     }
   }
@@ -120,13 +120,18 @@ void ImageDecoderImpl::DecodeAnimation(const std::vector<uint8_t>& encoded_data,
 
   auto frames = blink::WebImage::AnimationFromData(blink::WebData(
       reinterpret_cast<const char*>(encoded_data.data()), encoded_data.size()));
+  if (frames.empty()) {
+    std::move(callback).Run(std::vector<mojom::AnimationFramePtr>());
+    return;
+  }
 
   int64_t max_frame_size_in_bytes = max_size_in_bytes / frames.size();
   std::vector<mojom::AnimationFramePtr> decoded_images;
+  decoded_images.reserve(frames.size());
 
-  for (const blink::WebImage::AnimationFrame& frame : frames) {
+  for (blink::WebImage::AnimationFrame& frame : frames) {
     auto image_frame = mojom::AnimationFrame::New();
-    image_frame->bitmap = frame.bitmap;
+    image_frame->bitmap = std::move(frame.bitmap);
     image_frame->duration = frame.duration;
 
     ResizeImage(&image_frame->bitmap, shrink_to_fit, max_frame_size_in_bytes);
@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "base/bind.h"
@@ -65,13 +66,26 @@ class Request {
         base::Bind(&Request::OnRequestDone, base::Unretained(this)));
   }
 
+  void DecodeAnimation(const std::vector<unsigned char>& image, bool shrink) {
+    decoder_->DecodeAnimation(
+        image, shrink, kTestMaxImageSize,
+        base::BindOnce(&Request::OnAnimationDone, base::Unretained(this)));
+  }
+
   const SkBitmap& bitmap() const { return bitmap_; }
+  const std::vector<mojom::AnimationFramePtr>& frames() const {
+    return frames_;
+  }
 
  private:
   void OnRequestDone(const SkBitmap& result_image) { bitmap_ = result_image; }
+  void OnAnimationDone(std::vector<mojom::AnimationFramePtr> frames) {
+    frames_ = std::move(frames);
+  }
 
   ImageDecoderImpl* decoder_;
   SkBitmap bitmap_;
+  std::vector<mojom::AnimationFramePtr> frames_;
 };
 
 // We need to ensure that Blink and V8 are initialized in order to use content's
@@ -164,4 +178,14 @@ TEST_F(ImageDecoderImplTest, DecodeImageFailed) {
   EXPECT_TRUE(request.bitmap().isNull());
 }
 
+TEST_F(ImageDecoderImplTest, DecodeAnimationFailed) {
+  const char kRandomData[] = "u gycfy7xdjkhfgui bdui ";
+  std::vector<unsigned char> gif(kRandomData,
+                                 kRandomData + sizeof(kRandomData));
+
+  Request request(decoder());
+  request.DecodeAnimation(gif, false);
+  EXPECT_TRUE(request.frames().empty());
+}
+
 }  // namespace data_decoder
@@ -39,8 +39,11 @@
 #include "net/base/net_errors.h"
 #include "net/base/network_delegate.h"
 #include "net/base/registry_controlled_domains/registry_controlled_domain.h"
+#include "net/cert/caching_cert_verifier.h"
 #include "net/cert/cert_verifier.h"
+#include "net/cert/cert_verify_proc.h"
 #include "net/cert/ct_verify_result.h"
+#include "net/cert/multi_threaded_cert_verifier.h"
 #include "net/cookies/cookie_monster.h"
 #include "net/dns/host_cache.h"
 #include "net/dns/mapped_host_resolver.h"
@@ -104,8 +107,6 @@
 
 #if defined(OS_CHROMEOS)
 #include "crypto/nss_util_internal.h"
-#include "net/cert/caching_cert_verifier.h"
-#include "net/cert/multi_threaded_cert_verifier.h"
 #include "services/network/cert_verifier_with_trust_anchors.h"
 #include "services/network/cert_verify_proc_chromeos.h"
 #include "services/network/nss_temp_certs_cache_chromeos.h"
@@ -143,8 +144,6 @@
 #endif
 
 #if BUILDFLAG(TRIAL_COMPARISON_CERT_VERIFIER_SUPPORTED)
-#include "net/cert/caching_cert_verifier.h"
-#include "net/cert/cert_verify_proc.h"
 #include "net/cert/cert_verify_proc_builtin.h"
 #include "services/network/trial_comparison_cert_verifier_mojo.h"
 #endif
@@ -2163,6 +2162,14 @@ URLRequestContextOwner NetworkContext::MakeURLRequestContext() {
               net::CreateCertVerifyProcBuiltin()));
     }
 #endif
+    if (!cert_verifier && network_service_) {
+      // Contexts that use the default trust store share their results, so
+      // that other profiles don't verify the same chains again.
+      cert_verifier = std::make_unique<net::CachingCertVerifier>(
+          std::make_unique<net::MultiThreadedCertVerifier>(
+              net::CertVerifyProc::CreateDefault()),
+          network_service_->shared_cert_verifier_cache());
+    }
     if (!cert_verifier)
       cert_verifier = net::CertVerifier::CreateDefault();
   }
@@ -22,6 +22,7 @@
 #include "base/timer/timer.h"
 #include "build/build_config.h"
 #include "mojo/public/cpp/bindings/binding.h"
+#include "net/cert/caching_cert_verifier.h"
 #include "net/http/http_auth_preferences.h"
 #include "net/log/net_log.h"
 #include "net/log/trace_net_log_observer.h"
@@ -235,6 +236,12 @@ class COMPONENT_EXPORT(NETWORK_SERVICE) NetworkService
     return crl_set_distributor_.get();
   }
 
+  // Returns the cache of certificate verification results that's shared by
+  // the NetworkContexts that verify against the default trust store.
+  net::CachingCertVerifier::SharedCache* shared_cert_verifier_cache() {
+    return &shared_cert_verifier_cache_;
+  }
+
   bool os_crypt_config_set() const { return os_crypt_config_set_; }
 
   static NetworkService* GetNetworkServiceForTesting();
@@ -334,6 +341,8 @@ class COMPONENT_EXPORT(NETWORK_SERVICE) NetworkService
 #endif  // BUILDFLAG(IS_CT_SUPPORTED)
   std::unique_ptr<CRLSetDistributor> crl_set_distributor_;
 
+  net::CachingCertVerifier::SharedCache shared_cert_verifier_cache_;
+
   // A timer that periodically calls UpdateLoadInfo while there are pending
   // loads and not waiting on an ACK from the client for the last sent
   // LoadInfo callback.
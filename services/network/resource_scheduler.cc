@@ -6,6 +6,8 @@
 
 #include <stdint.h>
 
+#include <iterator>
+#include <map>
 #include <string>
 #include <utility>
 
@@ -506,6 +508,7 @@ class ResourceScheduler::Client : public net::EffectiveConnectionTypeObserver {
 
   void InsertInFlightRequest(ScheduledResourceRequestImpl* request) {
     in_flight_requests_.insert(request);
+    ++in_flight_requests_per_host_[request->host_port_pair()];
     SetRequestAttributes(request, DetermineRequestAttributes(request));
     RecordRequestCountMetrics();
 
@@ -529,12 +532,17 @@ class ResourceScheduler::Client : public net::EffectiveConnectionTypeObserver {
   void EraseInFlightRequest(ScheduledResourceRequestImpl* request) {
     size_t erased = in_flight_requests_.erase(request);
     DCHECK_EQ(1u, erased);
+    auto host_it = in_flight_requests_per_host_.find(request->host_port_pair());
+    DCHECK(host_it != in_flight_requests_per_host_.end());
+    if (--host_it->second == 0)
+      in_flight_requests_per_host_.erase(host_it);
     // Clear any special state that we were tracking for this request.
     SetRequestAttributes(request, kAttributeNone);
   }
 
   void ClearInFlightRequests() {
     in_flight_requests_.clear();
+    in_flight_requests_per_host_.clear();
     in_flight_delayable_count_ = 0;
     total_layout_blocking_count_ = 0;
   }
@@ -657,16 +665,9 @@ class ResourceScheduler::Client : public net::EffectiveConnectionTypeObserver {
       return false;
     }
 
-    size_t same_host_count = 0;
-    for (RequestSet::const_iterator it = in_flight_requests_.begin();
-         it != in_flight_requests_.end(); ++it) {
-      if (active_request_host.Equals((*it)->host_port_pair())) {
-        same_host_count++;
-        if (same_host_count >= kMaxNumDelayableRequestsPerHostPerClient)
-          return true;
-      }
-    }
-    return false;
+    auto it = in_flight_requests_per_host_.find(active_request_host);
+    return it != in_flight_requests_per_host_.end() &&
+           it->second >= kMaxNumDelayableRequestsPerHostPerClient;
   }
 
   void RecordMetricsOnStartRequest(const ScheduledResourceRequestImpl& request,
@@ -909,16 +910,16 @@ class ResourceScheduler::Client : public net::EffectiveConnectionTypeObserver {
       ShouldStartReqResult query_result = ShouldStartRequest(request);
 
       if (query_result == START_REQUEST) {
+        // Starting a request only brings the client closer to its limits, so
+        // the requests that were skipped before this one still can't start,
+        // and evaluation goes on from the next one rather than from the
+        // highest priority request. That keeps a scan linear when many
+        // requests are held back by the per-host limit. Starting
+        // asynchronously leaves the pending list as it is.
+        RequestQueue::NetQueue::iterator next_iter = std::next(request_iter);
         pending_requests_.Erase(request);
         StartRequest(request, START_ASYNC, trigger);
-
-        // StartRequest can modify the pending list, so we (re)start evaluation
-        // from the currently highest priority request. Avoid copying a singular
-        // iterator, which would trigger undefined behavior.
-        if (pending_requests_.GetNextHighestIterator() ==
-            pending_requests_.End())
-          break;
-        request_iter = pending_requests_.GetNextHighestIterator();
+        request_iter = next_iter;
       } else if (query_result == DO_NOT_START_REQUEST_AND_KEEP_SEARCHING) {
         ++request_iter;
         continue;
@@ -970,6 +971,8 @@ class ResourceScheduler::Client : public net::EffectiveConnectionTypeObserver {
   // is enabled.
   RequestQueue pending_requests_;
   RequestSet in_flight_requests_;
+  // The number of in-flight requests to each host, for the per-host limit.
+  std::map<net::HostPortPair, size_t> in_flight_requests_per_host_;
   // The number of delayable in-flight requests.
   size_t in_flight_delayable_count_;
   // The number of layout-blocking in-flight requests.
@@ -0,0 +1,100 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "services/network/resource_scheduler.h"
+
+#include <memory>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/message_loop/message_loop.h"
+#include "base/run_loop.h"
+#include "base/strings/stringprintf.h"
+#include "base/test/perf_time_logger.h"
+#include "net/base/request_priority.h"
+#include "net/traffic_annotation/network_traffic_annotation_test_helper.h"
+#include "net/url_request/url_request.h"
+#include "net/url_request/url_request_test_util.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace network {
+
+namespace {
+
+const int kChildId = 30;
+const int kRouteId = 75;
+
+// A page with many subresources, spread over a few hosts.
+const int kNumRequests = 5000;
+const int kNumHosts = 20;
+
+class Request {
+ public:
+  Request(net::URLRequestContext* context,
+          ResourceScheduler* scheduler,
+          int index)
+      : url_request_(context->CreateRequest(
+            GURL(base::StringPrintf("http://host%d/%d", index % kNumHosts,
+                                    index)),
+            index % 10 == 0 ? net::HIGHEST : net::LOWEST, nullptr,
+            TRAFFIC_ANNOTATION_FOR_TESTS)),
+        scheduled_request_(scheduler->ScheduleRequest(
+            kChildId, kRouteId, true, url_request_.get())) {
+    scheduled_request_->set_resume_callback(
+        base::BindRepeating(&Request::Resume, base::Unretained(this)));
+    bool deferred = false;
+    scheduled_request_->WillStartRequest(&deferred);
+    started_ = !deferred;
+  }
+
+  ~Request() {
+    // The ScheduledResourceRequest unregisters itself from the URLRequest.
+    scheduled_request_.reset();
+  }
+
+  bool started() const { return started_; }
+
+ private:
+  void Resume() { started_ = true; }
+
+  bool started_ = false;
+  std::unique_ptr<net::URLRequest> url_request_;
+  std::unique_ptr<ResourceScheduler::ScheduledResourceRequest>
+      scheduled_request_;
+};
+
+}  // namespace
+
+// Schedules many requests for one client, and completes them as they start,
+// which makes the scheduler look for startable requests each time.
+TEST(ResourceSchedulerPerfTest, ManyRequestsPerClient) {
+  base::MessageLoop message_loop;
+  net::TestURLRequestContext context;
+  ResourceScheduler scheduler(true);
+  scheduler.OnClientCreated(kChildId, kRouteId, nullptr);
+
+  base::PerfTimeLogger timer("ResourceScheduler_5k_requests");
+  std::vector<std::unique_ptr<Request>> requests;
+  for (int i = 0; i < kNumRequests; ++i)
+    requests.push_back(std::make_unique<Request>(&context, &scheduler, i));
+
+  int completed = 0;
+  while (completed < kNumRequests) {
+    int completed_before = completed;
+    for (auto& request : requests) {
+      if (request && request->started()) {
+        request.reset();
+        ++completed;
+      }
+    }
+    ASSERT_LT(completed_before, completed);
+    base::RunLoop().RunUntilIdle();
+  }
+  timer.Done();
+
+  scheduler.OnClientDeleted(kChildId, kRouteId);
+}
+
+}  // namespace network
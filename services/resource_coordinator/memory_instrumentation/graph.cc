@@ -134,7 +134,7 @@ Node* Node::GetChild(base::StringPiece name) {
   DCHECK(!name.empty());
   DCHECK_EQ(std::string::npos, name.find('/'));
 
-  auto child = children_.find(name.as_string());
+  auto child = children_.find(name);
   return child == children_.end() ? nullptr : child->second;
 }
 
@@ -6,6 +6,7 @@
 #define SERVICES_RESOURCE_COORDINATOR_MEMORY_INSTRUMENTATION_GRAPH_H_
 
 #include <forward_list>
+#include <functional>
 #include <map>
 #include <memory>
 #include <set>
@@ -155,8 +156,10 @@ class GlobalDumpGraph {
       guid_ = guid;
     }
     GlobalDumpGraph::Edge* owns_edge() const { return owns_edge_; }
-    std::map<std::string, Node*>* children() { return &children_; }
-    const std::map<std::string, Node*>& const_children() const {
+    std::map<std::string, Node*, std::less<>>* children() {
+      return &children_;
+    }
+    const std::map<std::string, Node*, std::less<>>& const_children() const {
       return children_;
     }
     std::vector<GlobalDumpGraph::Edge*>* owned_by_edges() {
@@ -174,7 +177,9 @@ class GlobalDumpGraph {
     Node* const parent_;
     base::trace_event::MemoryAllocatorDumpGuid guid_;
     std::map<std::string, Entry> entries_;
-    std::map<std::string, Node*> children_;
+    // Transparent comparator so GetChild() can look up path tokens without
+    // copying them into a std::string.
+    std::map<std::string, Node*, std::less<>> children_;
     bool explicit_ = false;
     bool weak_ = false;
     uint64_t not_owning_sub_size_ = 0;
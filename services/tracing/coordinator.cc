@@ -17,6 +17,7 @@
 #include "base/json/json_writer.h"
 #include "base/json/string_escape.h"
 #include "base/logging.h"
+#include "base/metrics/histogram_macros.h"
 #include "base/strings/string_split.h"
 #include "base/strings/string_util.h"
 #include "base/task/post_task.h"
@@ -63,7 +64,8 @@ class Coordinator::TraceStreamer : public base::SupportsWeakPtr<TraceStreamer> {
         coordinator_(coordinator),
         metadata_(new base::DictionaryValue()),
         stream_is_empty_(true),
-        json_field_name_written_(false) {}
+        json_field_name_written_(false),
+        peak_buffered_bytes_(0) {}
 
   // Destroyed on |backend_task_runner_|.
   ~TraceStreamer() = default;
@@ -110,7 +112,7 @@ class Coordinator::TraceStreamer : public base::SupportsWeakPtr<TraceStreamer> {
   // Handles synchronize writes to |stream_|, if the stream is not already
   // closed.
   void WriteToStream(const std::string& data) {
-    if (stream_.is_valid())
+    if (stream_.is_valid() && !data.empty())
       mojo::BlockingCopyFromString(data, stream_);
   }
 
@@ -125,6 +127,7 @@ class Coordinator::TraceStreamer : public base::SupportsWeakPtr<TraceStreamer> {
     // |traceEvent| chunks to the stream, we wait until all agents that send
     // |traceEvent| chunks are done, and then, we start writing
     // |systemTraceEvents| chunks.
+    UpdatePeakBufferedBytes();
     if (!streaming_label_.empty() && streaming_label_ != label)
       return;
 
@@ -158,6 +161,8 @@ class Coordinator::TraceStreamer : public base::SupportsWeakPtr<TraceStreamer> {
             WriteToStream("}");
             stream_is_empty_ = false;
           }
+          UMA_HISTOGRAM_MEMORY_KB("Tracing.Coordinator.PeakBufferedTraceDataKB",
+                                  peak_buffered_bytes_ / 1024);
           // Recorder connections should be closed on their binding thread.
           main_task_runner_->PostTask(
               FROM_HERE,
@@ -203,11 +208,15 @@ class Coordinator::TraceStreamer : public base::SupportsWeakPtr<TraceStreamer> {
         std::string escaped;
         base::EscapeJSONString(recorder->data(), false /* put_in_quotes */,
                                &escaped);
-        WriteToStream(prefix + escaped);
+        WriteToStream(prefix);
+        WriteToStream(escaped);
       } else {
         if (prefix.empty() && !stream_is_empty_)
           prefix = ",";
-        WriteToStream(prefix + recorder->data());
+        // Write the prefix separately so the buffered chunks, which can be
+        // large, are not copied again.
+        WriteToStream(prefix);
+        WriteToStream(recorder->data());
       }
       stream_is_empty_ = false;
       recorder->clear_data();
@@ -233,6 +242,18 @@ class Coordinator::TraceStreamer : public base::SupportsWeakPtr<TraceStreamer> {
     return waiting_for_agents;
   }
 
+  // Called from |backend_task_runner_|. Data from recorders whose label is not
+  // being streamed stays in memory until its turn, so track the high-water mark
+  // of what is held across all recorders.
+  void UpdatePeakBufferedBytes() {
+    size_t buffered_bytes = 0;
+    for (const auto& key_value : recorders_) {
+      for (const auto& recorder : key_value.second)
+        buffered_bytes += recorder->data().size();
+    }
+    peak_buffered_bytes_ = std::max(peak_buffered_bytes_, buffered_bytes);
+  }
+
   // Called from |backend_task_runner_|.
   void StreamMetadata() {
     if (!agent_label_.empty())
@@ -270,6 +291,7 @@ class Coordinator::TraceStreamer : public base::SupportsWeakPtr<TraceStreamer> {
   std::unique_ptr<base::DictionaryValue> metadata_;
   bool stream_is_empty_;
   bool json_field_name_written_;
+  size_t peak_buffered_bytes_;
 
   DISALLOW_COPY_AND_ASSIGN(TraceStreamer);
 };
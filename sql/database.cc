@@ -9,8 +9,10 @@
 #include <stdint.h>
 #include <string.h>
 
+#include "base/bind.h"
 #include "base/debug/alias.h"
 #include "base/debug/dump_without_crashing.h"
+#include "base/files/file.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
 #include "base/format_macros.h"
@@ -28,6 +30,7 @@
 #include "base/strings/stringprintf.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/synchronization/lock.h"
+#include "base/task/post_task.h"
 #include "base/threading/scoped_blocking_call.h"
 #include "base/trace_event/memory_dump_manager.h"
 #include "build/build_config.h"
@@ -46,6 +49,25 @@ namespace {
 // TODO(shess): Better story on this.  http://crbug.com/56559
 const int kBusyTimeoutSeconds = 1;
 
+// Maximum number of idle prepared statements kept by GetUniqueStatement().
+const size_t kUniqueStatementCacheSize = 16;
+
+// Reads up to |size| bytes from the start of the file at |path| and discards
+// them, so that later reads by SQLite hit the filesystem cache.
+void ReadFileToWarmCache(const base::FilePath& path, int64_t size) {
+  base::File file(path, base::File::FLAG_OPEN | base::File::FLAG_READ);
+  if (!file.IsValid())
+    return;
+
+  constexpr int kChunkSize = 64 * 1024;
+  std::unique_ptr<char[]> buf(new char[kChunkSize]);
+  for (int64_t pos = 0; pos < size; pos += kChunkSize) {
+    const int bytes_read = file.Read(pos, buf.get(), kChunkSize);
+    if (bytes_read <= 0)
+      return;
+  }
+}
+
 class ScopedBusyTimeout {
  public:
   explicit ScopedBusyTimeout(sqlite3* db) : db_(db) {}
@@ -259,7 +281,8 @@ Database::Database()
       mmap_disabled_(false),
       mmap_enabled_(false),
       total_changes_at_last_release_(0),
-      stats_histogram_(nullptr) {}
+      stats_histogram_(nullptr),
+      unique_statement_cache_(kUniqueStatementCacheSize) {}
 
 Database::~Database() {
   Close();
@@ -314,6 +337,7 @@ void Database::CloseInternal(bool forced) {
 
   // Release cached statements.
   statement_cache_.clear();
+  unique_statement_cache_.Clear();
 
   // With cached statements released, in-use statements will remain.
   // Closing the database while statements are in use is an API
@@ -407,6 +431,28 @@ void Database::Preload() {
   }
 }
 
+void Database::PreloadInBackground() {
+  if (!db_) {
+    DCHECK(poisoned_) << "Cannot preload null db";
+    return;
+  }
+
+  const base::FilePath path = DbPath();
+  if (path.empty())
+    return;
+
+  // Use the same amount as Preload(). ReadFileToWarmCache() stops at the end
+  // of the file.
+  DCHECK(page_size_);
+  const int64_t preload_size =
+      static_cast<int64_t>(page_size_) * (cache_size_ ? cache_size_ : 2000);
+  base::PostTaskWithTraits(
+      FROM_HERE,
+      {base::MayBlock(), base::TaskPriority::BEST_EFFORT,
+       base::TaskShutdownBehavior::CONTINUE_ON_SHUTDOWN},
+      base::BindOnce(&ReadFileToWarmCache, path, preload_size));
+}
+
 // SQLite keeps unused pages associated with a database in a cache.  It asks
 // the cache for pages by an id, and if the page is present and the database is
 // unchanged, it considers the content of the page valid and doesn't read it
@@ -1314,7 +1360,28 @@ scoped_refptr<Database::StatementRef> Database::GetCachedStatement(
 
 scoped_refptr<Database::StatementRef> Database::GetUniqueStatement(
     const char* sql) {
-  return GetStatementImpl(this, sql);
+  if (!base::FeatureList::IsEnabled(features::kSqlReuseUniqueStatements))
+    return GetStatementImpl(this, sql);
+
+  auto it = unique_statement_cache_.Get(sql);
+  if (it != unique_statement_cache_.end()) {
+    // Only hand out the cached statement if no Statement is using it, so that
+    // callers keep getting a statement of their own.
+    if (it->second->HasOneRef() && it->second->is_valid()) {
+      sqlite3_reset(it->second->stmt());
+      sqlite3_clear_bindings(it->second->stmt());
+      return it->second;
+    }
+    if (!it->second->is_valid())
+      unique_statement_cache_.Erase(it);
+  }
+
+  scoped_refptr<StatementRef> statement = GetStatementImpl(this, sql);
+  if (statement->is_valid() &&
+      unique_statement_cache_.Peek(sql) == unique_statement_cache_.end()) {
+    unique_statement_cache_.Put(sql, statement);
+  }
+  return statement;
 }
 
 scoped_refptr<Database::StatementRef> Database::GetStatementImpl(
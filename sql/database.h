@@ -17,6 +17,7 @@
 #include "base/compiler_specific.h"
 #include "base/component_export.h"
 #include "base/containers/flat_map.h"
+#include "base/containers/mru_cache.h"
 #include "base/gtest_prod_util.h"
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
@@ -251,6 +252,12 @@ class COMPONENT_EXPORT(SQL) Database {
   // everything else.
   void Preload();
 
+  // Like Preload(), but reads the file on a background sequence through a
+  // separate file handle, so the caller doesn't block. This only warms the
+  // filesystem cache; the pages are faulted in cheaply on first use. Does
+  // nothing for in-memory and temporary databases.
+  void PreloadInBackground();
+
   // Release all non-essential memory associated with this database connection.
   void TrimMemory();
 
@@ -402,9 +409,13 @@ class COMPONENT_EXPORT(SQL) Database {
   // valid SQL, returns true.
   bool IsSQLValid(const char* sql);
 
-  // Returns a non-cached statement for the given SQL. Use this for SQL that
-  // is only executed once or only rarely (there is overhead associated with
-  // keeping a statement cached).
+  // Returns a statement for the given SQL that is not shared with any other
+  // live Statement. Use this for SQL that is only executed once or only rarely
+  // (there is overhead associated with keeping a statement cached).
+  //
+  // Prepared statements that are no longer in use are kept in a small LRU
+  // cache keyed by |sql| (see kSqlReuseUniqueStatements), so calling this in a
+  // loop with the same SQL does not re-prepare the statement each time.
   //
   // See GetCachedStatement above for examples and error information.
   scoped_refptr<StatementRef> GetUniqueStatement(const char* sql);
@@ -739,6 +750,12 @@ class COMPONENT_EXPORT(SQL) Database {
   // throughout a process' lifetime.
   base::flat_map<StatementID, scoped_refptr<StatementRef>> statement_cache_;
 
+  // Recently used statements handed out by GetUniqueStatement(), keyed by
+  // their SQL. An entry is only reused when this cache holds the only
+  // reference to it, i.e. when no Statement is using it.
+  base::MRUCache<std::string, scoped_refptr<StatementRef>>
+      unique_statement_cache_;
+
   // A list of all StatementRefs we've given out. Each ref must register with
   // us when it's created or destroyed. This allows us to potentially close
   // any open statements when we encounter an error.
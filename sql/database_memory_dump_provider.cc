@@ -50,6 +50,17 @@ bool DatabaseMemoryDumpProvider::OnMemoryDump(
   dump->AddScalar("statement_size",
                   base::trace_event::MemoryAllocatorDump::kUnitsBytes,
                   statement_size);
+
+  int cache_hit_count = 0;
+  int cache_miss_count = 0;
+  if (GetDbCacheStats(&cache_hit_count, &cache_miss_count)) {
+    dump->AddScalar("cache_hit_count",
+                    base::trace_event::MemoryAllocatorDump::kUnitsObjects,
+                    cache_hit_count);
+    dump->AddScalar("cache_miss_count",
+                    base::trace_event::MemoryAllocatorDump::kUnitsObjects,
+                    cache_miss_count);
+  }
   return true;
 }
 
@@ -96,6 +107,25 @@ bool DatabaseMemoryDumpProvider::GetDbMemoryUsage(int* cache_size,
   return true;
 }
 
+bool DatabaseMemoryDumpProvider::GetDbCacheStats(int* cache_hit_count,
+                                                 int* cache_miss_count) {
+  base::AutoLock lock(lock_);
+  if (!db_)
+    return false;
+
+  // The high water mark is not tracked for cache hits and misses.
+  int dummy_int;
+  int status =
+      sqlite3_db_status(db_, SQLITE_DBSTATUS_CACHE_HIT, cache_hit_count,
+                        &dummy_int, 0 /* resetFlag */);
+  DCHECK_EQ(SQLITE_OK, status);
+  status = sqlite3_db_status(db_, SQLITE_DBSTATUS_CACHE_MISS, cache_miss_count,
+                             &dummy_int, 0 /* resetFlag */);
+  DCHECK_EQ(SQLITE_OK, status);
+
+  return true;
+}
+
 std::string DatabaseMemoryDumpProvider::FormatDumpName() const {
   return base::StringPrintf(
       "sqlite/%s_connection/0x%" PRIXPTR,
@@ -42,6 +42,10 @@ class DatabaseMemoryDumpProvider
  private:
   bool GetDbMemoryUsage(int* cache_size, int* schema_size, int* statement_size);
 
+  // Returns the number of page cache hits (reads that did not need to go to
+  // the file) and misses since the database was opened.
+  bool GetDbCacheStats(int* cache_hit_count, int* cache_miss_count);
+
   std::string FormatDumpName() const;
 
   sqlite3* db_;  // not owned.
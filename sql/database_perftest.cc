@@ -0,0 +1,118 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/files/file_path.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/macros.h"
+#include "base/test/scoped_feature_list.h"
+#include "base/timer/elapsed_timer.h"
+#include "sql/database.h"
+#include "sql/sql_features.h"
+#include "sql/statement.h"
+#include "sql/transaction.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace sql {
+
+namespace {
+
+constexpr int kNumRows = 10000;
+constexpr int kNumReads = 10000;
+
+constexpr char kInsertSql[] = "INSERT INTO foo (a, b) VALUES (?, ?)";
+constexpr char kSelectSql[] = "SELECT b FROM foo WHERE a=?";
+
+bool BindRow(size_t row, Statement* statement) {
+  return statement->BindInt64(0, row) &&
+         statement->BindString(1, "value" + std::to_string(row));
+}
+
+class SQLDatabasePerfTest : public testing::TestWithParam<bool> {
+ public:
+  SQLDatabasePerfTest() = default;
+
+  void SetUp() override {
+    feature_list_.InitWithFeatureState(features::kSqlReuseUniqueStatements,
+                                       GetParam());
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    ASSERT_TRUE(
+        db_.Open(temp_dir_.GetPath().AppendASCII("SQLDatabasePerfTest.db")));
+    ASSERT_TRUE(
+        db_.Execute("CREATE TABLE foo (a INTEGER PRIMARY KEY, b TEXT)"));
+  }
+
+  void TearDown() override { db_.Close(); }
+
+  std::string trace() const {
+    return GetParam() ? "statement_reuse" : "no_statement_reuse";
+  }
+
+  void PrintRate(const std::string& measurement,
+                 int count,
+                 const base::ElapsedTimer& timer) {
+    perf_test::PrintResult(measurement, "", trace(),
+                           count / timer.Elapsed().InSecondsF(), "runs/s",
+                           true);
+  }
+
+ protected:
+  base::ScopedTempDir temp_dir_;
+  Database db_;
+
+ private:
+  base::test::ScopedFeatureList feature_list_;
+
+  DISALLOW_COPY_AND_ASSIGN(SQLDatabasePerfTest);
+};
+
+// Inserts rows the way many callers do today: one GetUniqueStatement() per row
+// inside a transaction.
+TEST_P(SQLDatabasePerfTest, BulkInsertUniqueStatementPerRow) {
+  base::ElapsedTimer timer;
+  Transaction transaction(&db_);
+  ASSERT_TRUE(transaction.Begin());
+  for (int row = 0; row < kNumRows; ++row) {
+    Statement statement(db_.GetUniqueStatement(kInsertSql));
+    ASSERT_TRUE(BindRow(row, &statement));
+    ASSERT_TRUE(statement.Run());
+  }
+  ASSERT_TRUE(transaction.Commit());
+  PrintRate("bulk_insert_statement_per_row", kNumRows, timer);
+}
+
+TEST_P(SQLDatabasePerfTest, BulkInsertRunBatch) {
+  base::ElapsedTimer timer;
+  Statement statement(db_.GetUniqueStatement(kInsertSql));
+  ASSERT_TRUE(statement.RunBatch(kNumRows, base::BindRepeating(&BindRow)));
+  PrintRate("bulk_insert_run_batch", kNumRows, timer);
+}
+
+TEST_P(SQLDatabasePerfTest, PointReads) {
+  {
+    Statement statement(db_.GetUniqueStatement(kInsertSql));
+    ASSERT_TRUE(statement.RunBatch(kNumRows, base::BindRepeating(&BindRow)));
+  }
+
+  base::ElapsedTimer timer;
+  for (int i = 0; i < kNumReads; ++i) {
+    Statement statement(db_.GetUniqueStatement(kSelectSql));
+    statement.BindInt64(0, (i * 7919) % kNumRows);
+    ASSERT_TRUE(statement.Step());
+  }
+  PrintRate("point_reads", kNumReads, timer);
+}
+
+INSTANTIATE_TEST_SUITE_P(, SQLDatabasePerfTest, testing::Bool());
+
+}  // namespace
+
+}  // namespace sql
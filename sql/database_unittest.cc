@@ -15,6 +15,7 @@
 #include "base/test/gtest_util.h"
 #include "base/test/metrics/histogram_tester.h"
 #include "base/test/scoped_feature_list.h"
+#include "base/test/scoped_task_environment.h"
 #include "base/trace_event/process_memory_dump.h"
 #include "build/build_config.h"
 #include "sql/database.h"
@@ -208,6 +209,41 @@ TEST_F(SQLDatabaseTest, CachedStatement) {
       << "Using a different SQL with the same statement ID should DCHECK";
 }
 
+TEST_F(SQLDatabaseTest, UniqueStatementReuse) {
+  static const char kSql[] = "SELECT a FROM foo";
+  ASSERT_TRUE(db().Execute("CREATE TABLE foo (a, b)"));
+  ASSERT_TRUE(db().Execute("INSERT INTO foo(a, b) VALUES (12, 13)"));
+
+  sqlite3_stmt* raw_statement;
+  {
+    scoped_refptr<sql::Database::StatementRef> first_ref =
+        db().GetUniqueStatement(kSql);
+    raw_statement = first_ref->stmt();
+    sql::Statement first(std::move(first_ref));
+    ASSERT_TRUE(first.is_valid());
+    ASSERT_TRUE(first.Step());
+
+    // A second statement with the same SQL must not share the prepared
+    // statement with one that is still in use.
+    scoped_refptr<sql::Database::StatementRef> second_ref =
+        db().GetUniqueStatement(kSql);
+    EXPECT_NE(raw_statement, second_ref->stmt());
+    sql::Statement second(std::move(second_ref));
+    ASSERT_TRUE(second.is_valid());
+    ASSERT_TRUE(second.Step());
+    EXPECT_EQ(12, second.ColumnInt(0));
+  }
+
+  // Once idle, the prepared statement is handed out again, reset.
+  scoped_refptr<sql::Database::StatementRef> ref =
+      db().GetUniqueStatement(kSql);
+  EXPECT_EQ(raw_statement, ref->stmt()) << "statement was not reused";
+  sql::Statement s(std::move(ref));
+  ASSERT_TRUE(s.is_valid());
+  ASSERT_TRUE(s.Step()) << "reused statement was not reset";
+  EXPECT_EQ(12, s.ColumnInt(0));
+}
+
 TEST_F(SQLDatabaseTest, IsSQLValidTest) {
   ASSERT_TRUE(db().Execute("CREATE TABLE foo (a, b)"));
   ASSERT_TRUE(db().IsSQLValid("SELECT a FROM foo"));
@@ -1043,6 +1079,32 @@ TEST_F(SQLDatabaseTest, OnMemoryDump) {
   base::trace_event::ProcessMemoryDump pmd(args);
   ASSERT_TRUE(db().memory_dump_provider_->OnMemoryDump(args, &pmd));
   EXPECT_GE(pmd.allocator_dumps().size(), 1u);
+
+  // The page cache hit and miss counts show how many reads the cache saved.
+  bool found_cache_hit_count = false;
+  bool found_cache_miss_count = false;
+  for (const auto& dump : pmd.allocator_dumps()) {
+    for (const auto& entry : dump.second->entries()) {
+      found_cache_hit_count |= entry.name == "cache_hit_count";
+      found_cache_miss_count |= entry.name == "cache_miss_count";
+    }
+  }
+  EXPECT_TRUE(found_cache_hit_count);
+  EXPECT_TRUE(found_cache_miss_count);
+}
+
+TEST_F(SQLDatabaseTest, PreloadInBackground) {
+  base::test::ScopedTaskEnvironment scoped_task_environment;
+  ASSERT_TRUE(db().Execute("CREATE TABLE foo (a, b)"));
+  ASSERT_TRUE(db().Execute("INSERT INTO foo (a, b) VALUES (12, 13)"));
+
+  db().PreloadInBackground();
+  scoped_task_environment.RunUntilIdle();
+
+  // The database is unaffected by the background read.
+  sql::Statement s(db().GetUniqueStatement("SELECT b FROM foo"));
+  ASSERT_TRUE(s.Step());
+  EXPECT_EQ(13, s.ColumnInt(0));
 }
 
 // Test that the functions to collect diagnostic data run to completion, without
@@ -18,6 +18,11 @@ namespace features {
 const base::Feature kSqlTempStoreMemory{"SqlTempStoreMemory",
                                         base::FEATURE_DISABLED_BY_DEFAULT};
 
+// Database::GetUniqueStatement() reuses idle prepared statements with the same
+// SQL instead of compiling the SQL again.
+const base::Feature kSqlReuseUniqueStatements{
+    "SqlReuseUniqueStatements", base::FEATURE_ENABLED_BY_DEFAULT};
+
 }  // namespace features
 
 }  // namespace sql
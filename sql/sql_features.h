@@ -13,6 +13,7 @@ namespace sql {
 namespace features {
 
 COMPONENT_EXPORT(SQL) extern const base::Feature kSqlTempStoreMemory;
+COMPONENT_EXPORT(SQL) extern const base::Feature kSqlReuseUniqueStatements;
 
 }  // namespace features
 
@@ -7,6 +7,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "base/callback.h"
 #include "base/logging.h"
 #include "base/numerics/safe_conversions.h"
 #include "base/strings/string_util.h"
@@ -74,6 +75,25 @@ bool Statement::Step() {
   return StepInternal() == SQLITE_ROW;
 }
 
+bool Statement::RunBatch(size_t num_rows, const BindRowCallback& bind_row) {
+  Database* database = ref_->database();
+  if (!is_valid() || !database)
+    return false;
+
+  if (!database->BeginTransaction())
+    return false;
+  for (size_t row = 0; row < num_rows; ++row) {
+    Reset(true);
+    if (!bind_row.Run(row, this) || !Run()) {
+      Reset(true);
+      database->RollbackTransaction();
+      return false;
+    }
+  }
+  Reset(true);
+  return database->CommitTransaction();
+}
+
 void Statement::Reset(bool clear_bound_vars) {
   base::Optional<base::ScopedBlockingCall> scoped_blocking_call;
   ref_->InitScopedBlockingCall(&scoped_blocking_call);
@@ -9,6 +9,7 @@
 #include <string>
 #include <vector>
 
+#include "base/callback_forward.h"
 #include "base/component_export.h"
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
@@ -88,6 +89,22 @@ class COMPONENT_EXPORT(SQL) Statement {
   //   return s.Succeeded();
   bool Step();
 
+  // Runs the statement once for each of |num_rows| rows inside a single
+  // transaction. Before each run, the bound variables are cleared and
+  // |bind_row| is called with the row index to bind the row's values; it
+  // returns false to abort. Returns true if all rows ran and the transaction
+  // committed. On failure, the transaction is rolled back.
+  //
+  // Example:
+  //   sql::Statement s(db.GetUniqueStatement("INSERT INTO foo VALUES (?)"));
+  //   s.RunBatch(ids.size(), base::BindRepeating(
+  //       [](const std::vector<int64_t>* ids, size_t row, sql::Statement* s) {
+  //         return s->BindInt64(0, (*ids)[row]);
+  //       }, &ids));
+  using BindRowCallback =
+      base::RepeatingCallback<bool(size_t row, Statement* statement)>;
+  bool RunBatch(size_t num_rows, const BindRowCallback& bind_row);
+
   // Resets the statement to its initial condition. This includes any current
   // result row, and also the bound variables if the |clear_bound_vars| is true.
   void Reset(bool clear_bound_vars);
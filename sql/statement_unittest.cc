@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include <string>
+#include <vector>
 
 #include "base/bind.h"
 #include "base/files/file_util.h"
@@ -60,6 +61,50 @@ TEST_F(SQLStatementTest, Run) {
   EXPECT_TRUE(s.Succeeded());
 }
 
+namespace {
+
+bool BindRowValue(const std::vector<int>* values,
+                  size_t row,
+                  sql::Statement* statement) {
+  if ((*values)[row] < 0)
+    return false;
+  return statement->BindInt(0, (*values)[row]);
+}
+
+int CountRows(sql::Database& db) {
+  sql::Statement count(db.GetUniqueStatement("SELECT COUNT(*) FROM foo"));
+  return count.Step() ? count.ColumnInt(0) : -1;
+}
+
+}  // namespace
+
+TEST_F(SQLStatementTest, RunBatch) {
+  ASSERT_TRUE(db().Execute("CREATE TABLE foo (a)"));
+
+  const std::vector<int> values = {1, 2, 3, 4};
+  sql::Statement s(db().GetUniqueStatement("INSERT INTO foo (a) VALUES (?)"));
+  EXPECT_TRUE(s.RunBatch(values.size(),
+                         base::BindRepeating(&BindRowValue, &values)));
+  EXPECT_EQ(4, CountRows(db()));
+  EXPECT_EQ(0, db().transaction_nesting());
+
+  sql::Statement sum(db().GetUniqueStatement("SELECT SUM(a) FROM foo"));
+  ASSERT_TRUE(sum.Step());
+  EXPECT_EQ(10, sum.ColumnInt(0));
+}
+
+TEST_F(SQLStatementTest, RunBatchRollsBackOnFailure) {
+  ASSERT_TRUE(db().Execute("CREATE TABLE foo (a)"));
+
+  // The negative value makes the bind callback fail on the third row.
+  const std::vector<int> values = {1, 2, -1, 4};
+  sql::Statement s(db().GetUniqueStatement("INSERT INTO foo (a) VALUES (?)"));
+  EXPECT_FALSE(s.RunBatch(values.size(),
+                          base::BindRepeating(&BindRowValue, &values)));
+  EXPECT_EQ(0, CountRows(db()));
+  EXPECT_EQ(0, db().transaction_nesting());
+}
+
 // Error callback called for error running a statement.
 TEST_F(SQLStatementTest, ErrorCallback) {
   ASSERT_TRUE(db().Execute("CREATE TABLE foo (a INTEGER PRIMARY KEY, b)"));
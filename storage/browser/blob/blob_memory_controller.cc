@@ -1060,6 +1060,7 @@ void BlobMemoryController::RecordTracingCounters() const {
   TRACE_COUNTER2("Blob", "MemoryUsage", "TotalStorage", blob_memory_used_,
                  "InFlightToDisk", in_flight_memory_used_);
   TRACE_COUNTER1("Blob", "DiskUsage", disk_used_);
+  TRACE_COUNTER1("Blob", "PeakMemoryUsage", peak_blob_memory_used_);
   TRACE_COUNTER1("Blob", "TransfersPendingOnDisk",
                  pending_memory_quota_tasks_.size());
   TRACE_COUNTER1("Blob", "TransfersBytesPendingOnDisk",
@@ -1097,6 +1098,7 @@ void BlobMemoryController::GrantMemoryAllocations(
   blob_memory_used_ += total_bytes;
   UMA_HISTOGRAM_COUNTS_1M("Storage.Blob.StorageSizeAfterAppend",
                           blob_memory_used_ / 1024);
+  peak_blob_memory_used_ = std::max(peak_blob_memory_used_, blob_memory_used_);
 
   for (auto& item : *items) {
     item->set_state(ShareableBlobDataItem::QUOTA_GRANTED);
@@ -1117,6 +1119,11 @@ void BlobMemoryController::RevokeMemoryAllocation(uint64_t item_id,
   blob_memory_used_ -= length;
   UMA_HISTOGRAM_COUNTS_1M("Storage.Blob.StorageSizeAfterAppend",
                           blob_memory_used_ / 1024);
+  if (blob_memory_used_ == 0 && peak_blob_memory_used_ != 0) {
+    UMA_HISTOGRAM_MEMORY_KB("Storage.Blob.MemoryHighWaterMarkInKB",
+                            peak_blob_memory_used_ / 1024);
+    peak_blob_memory_used_ = 0;
+  }
 
   auto iterator = populated_memory_items_.Get(item_id);
   if (iterator != populated_memory_items_.end()) {
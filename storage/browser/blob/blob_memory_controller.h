@@ -164,6 +164,7 @@ class COMPONENT_EXPORT(STORAGE_BROWSER) BlobMemoryController {
       const std::vector<scoped_refptr<ShareableBlobDataItem>>& items);
 
   size_t memory_usage() const { return blob_memory_used_; }
+  size_t peak_memory_usage() const { return peak_blob_memory_used_; }
   uint64_t disk_usage() const { return disk_used_; }
 
   base::WeakPtr<BlobMemoryController> GetWeakPtr();
@@ -284,6 +285,11 @@ class COMPONENT_EXPORT(STORAGE_BROWSER) BlobMemoryController {
   // This is the amount of memory we're using for blobs in RAM, including the
   // in_flight_memory_used_.
   size_t blob_memory_used_ = 0;
+  // The high-water mark of |blob_memory_used_| since blob memory was last
+  // fully released. It is recorded to UMA and reset each time usage drops back
+  // to zero, so every burst of blob activity (e.g. a large upload) reports how
+  // high memory got before paging caught up.
+  size_t peak_blob_memory_used_ = 0;
   // This is memory we're temporarily using while we try to write blob items to
   // disk.
   size_t in_flight_memory_used_ = 0;
@@ -11,6 +11,7 @@
 #include "base/message_loop/message_loop.h"
 #include "base/run_loop.h"
 #include "base/system/sys_info.h"
+#include "base/test/metrics/histogram_tester.h"
 #include "base/test/test_simple_task_runner.h"
 #include "base/threading/thread_restrictions.h"
 #include "base/threading/thread_task_runner_handle.h"
@@ -275,6 +276,39 @@ TEST_F(BlobMemoryControllerTest, SimpleMemoryRequest) {
   EXPECT_EQ(0u, controller.memory_usage());
 }
 
+TEST_F(BlobMemoryControllerTest, PeakMemoryUsage) {
+  base::HistogramTester histogram_tester;
+  BlobMemoryController controller(temp_dir_.GetPath(), file_runner_);
+  SetTestMemoryLimits(&controller);
+
+  BlobDataBuilder builder("id");
+  builder.AppendFutureData(100);
+  std::vector<scoped_refptr<ShareableBlobDataItem>> items =
+      CreateSharedDataItems(builder);
+  controller.ReserveMemoryQuota(items, GetMemoryRequestCallback());
+  EXPECT_TRUE(memory_quota_result_);
+
+  BlobDataBuilder builder2("id2");
+  builder2.AppendFutureData(200);
+  std::vector<scoped_refptr<ShareableBlobDataItem>> items2 =
+      CreateSharedDataItems(builder2);
+  controller.ReserveMemoryQuota(items2, GetMemoryRequestCallback());
+  EXPECT_TRUE(memory_quota_result_);
+  EXPECT_EQ(300u, controller.peak_memory_usage());
+
+  // The high-water mark survives partial releases.
+  items.clear();
+  EXPECT_EQ(200u, controller.memory_usage());
+  EXPECT_EQ(300u, controller.peak_memory_usage());
+  histogram_tester.ExpectTotalCount("Storage.Blob.MemoryHighWaterMarkInKB", 0);
+
+  // It is reported and reset once all blob memory is released.
+  items2.clear();
+  EXPECT_EQ(0u, controller.memory_usage());
+  EXPECT_EQ(0u, controller.peak_memory_usage());
+  histogram_tester.ExpectTotalCount("Storage.Blob.MemoryHighWaterMarkInKB", 1);
+}
+
 TEST_F(BlobMemoryControllerTest, PageToDisk) {
   const std::string kId = "id";
   const std::string kId2 = "id2";
@@ -147,13 +147,14 @@ void ClientUsageTracker::UpdateUsageCache(const url::Origin& origin,
                                           int64_t delta) {
   std::string host = net::GetHostOrSpecFromURL(origin.GetURL());
   if (base::ContainsKey(cached_hosts_, host)) {
-    if (!IsUsageCacheEnabledForOrigin(origin))
+    if (!IsUsageCacheEnabledForOrigin(host, origin))
       return;
 
     // Constrain |delta| to avoid negative usage values.
     // TODO(michaeln): crbug/463729
-    delta = std::max(delta, -cached_usage_by_host_[host][origin]);
-    cached_usage_by_host_[host][origin] += delta;
+    int64_t& cached_usage = cached_usage_by_host_[host][origin];
+    delta = std::max(delta, -cached_usage);
+    cached_usage += delta;
     UpdateGlobalUsageValue(IsStorageUnlimited(origin) ? &global_unlimited_usage_
                                                       : &global_limited_usage_,
                            delta);
@@ -424,7 +425,13 @@ bool ClientUsageTracker::GetCachedOriginUsage(const url::Origin& origin,
 
 bool ClientUsageTracker::IsUsageCacheEnabledForOrigin(
     const url::Origin& origin) const {
-  std::string host = net::GetHostOrSpecFromURL(origin.GetURL());
+  return IsUsageCacheEnabledForOrigin(
+      net::GetHostOrSpecFromURL(origin.GetURL()), origin);
+}
+
+bool ClientUsageTracker::IsUsageCacheEnabledForOrigin(
+    const std::string& host,
+    const url::Origin& origin) const {
   return !OriginSetContainsOrigin(non_cached_limited_origins_by_host_,
                                   host, origin) &&
       !OriginSetContainsOrigin(non_cached_unlimited_origins_by_host_,
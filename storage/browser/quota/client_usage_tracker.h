@@ -95,6 +95,12 @@ class ClientUsageTracker : public SpecialStoragePolicy::Observer,
   int64_t GetCachedGlobalUnlimitedUsage();
   bool GetCachedOriginUsage(const url::Origin& origin, int64_t* usage) const;
 
+  // Same as the public overload, for callers that already computed |host|
+  // from |origin|. UpdateUsageCache() runs on every storage write, so it
+  // avoids re-deriving the host from the origin's URL.
+  bool IsUsageCacheEnabledForOrigin(const std::string& host,
+                                    const url::Origin& origin) const;
+
   // SpecialStoragePolicy::Observer overrides
   void OnGranted(const GURL& origin_url, int change_flags) override;
   void OnRevoked(const GURL& origin_url, int change_flags) override;
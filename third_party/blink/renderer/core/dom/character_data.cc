@@ -214,9 +214,13 @@ void CharacterData::SetDataAndUpdate(const String& new_data,
 
 void CharacterData::DidModifyData(const String& old_data, UpdateSource source) {
   if (MutationObserverInterestGroup* mutation_recipients =
-          MutationObserverInterestGroup::CreateForCharacterDataMutation(*this))
+          MutationObserverInterestGroup::CreateForCharacterDataMutation(
+              *this)) {
     mutation_recipients->EnqueueMutationRecord(
-        MutationRecord::CreateCharacterData(this, old_data));
+        MutationRecord::CreateCharacterData(
+            this,
+            mutation_recipients->IsOldValueRequested() ? old_data : String()));
+  }
 
   if (parentNode()) {
     ContainerNode::ChildrenChange change = {
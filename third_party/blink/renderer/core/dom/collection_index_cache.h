@@ -151,6 +151,20 @@ inline NodeType* CollectionIndexCache<Collection, NodeType>::NodeAt(
     return CachedNode();
   }
 
+  // No cached node, but the length may still be known (e.g. after
+  // NodeInserted() or NodeRemoved()). Start from the end if it is closer, so
+  // that accessing the last item after an append does not walk the whole
+  // collection.
+  if (IsCachedNodeCountValid() && CachedNodeCount() - 1 - index < index &&
+      collection.CanTraverseBackward()) {
+    NodeType* last_node = collection.TraverseToLast();
+    DCHECK(last_node);
+    SetCachedNode(last_node, CachedNodeCount() - 1);
+    if (index < CachedNodeCount() - 1)
+      return NodeBeforeCachedNode(collection, index);
+    return last_node;
+  }
+
   // No valid cache yet, let's find the first matching element.
   NodeType* first_node = collection.TraverseToFirst();
   if (!first_node) {
@@ -4528,9 +4528,14 @@ void Element::WillModifyAttribute(const QualifiedName& name,
 
   if (MutationObserverInterestGroup* recipients =
           MutationObserverInterestGroup::CreateForAttributesMutation(*this,
-                                                                     name))
-    recipients->EnqueueMutationRecord(
-        MutationRecord::CreateAttributes(this, name, old_value));
+                                                                     name)) {
+    // When no observer asked for attributeOldValue, leave it out of the record
+    // so that the interest group does not have to allocate a second record
+    // with a null oldValue.
+    recipients->EnqueueMutationRecord(MutationRecord::CreateAttributes(
+        this, name,
+        recipients->IsOldValueRequested() ? old_value : g_null_atom));
+  }
 
   probe::WillModifyDOMAttr(this, old_value, new_value);
 }
@@ -4960,9 +4965,11 @@ void Element::InlineStyleChanged() {
     // We don't use getAttribute() here to get a style attribute value
     // before the change.
     AtomicString old_value;
-    if (const Attribute* attribute =
-            GetElementData()->Attributes().Find(kStyleAttr))
-      old_value = attribute->Value();
+    if (recipients->IsOldValueRequested()) {
+      if (const Attribute* attribute =
+              GetElementData()->Attributes().Find(kStyleAttr))
+        old_value = attribute->Value();
+    }
     recipients->EnqueueMutationRecord(
         MutationRecord::CreateAttributes(this, kStyleAttr, old_value));
     // Need to synchronize every time so that following MutationRecords will
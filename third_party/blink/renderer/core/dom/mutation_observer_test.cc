@@ -7,6 +7,7 @@
 #include "testing/gtest/include/gtest/gtest.h"
 #include "third_party/blink/renderer/core/dom/mutation_observer_init.h"
 #include "third_party/blink/renderer/core/dom/mutation_observer_registration.h"
+#include "third_party/blink/renderer/core/dom/mutation_record.h"
 #include "third_party/blink/renderer/core/html/html_document.h"
 #include "third_party/blink/renderer/core/html/html_element.h"
 
@@ -58,4 +59,42 @@ TEST(MutationObserverTest, DisconnectCrash) {
   // The test passes if disconnect() didn't crash.  crbug.com/657613.
 }
 
+TEST(MutationObserverTest, AttributeOldValueOnlyForRequestingObservers) {
+  Persistent<Document> document = HTMLDocument::CreateForTest();
+  auto* root = ToHTMLElement(document->CreateRawElement(html_names::kHTMLTag));
+  document->AppendChild(root);
+  root->setAttribute(html_names::kTitleAttr, "before");
+
+  Persistent<MutationObserver> with_old_value = MutationObserver::Create(
+      MakeGarbageCollected<EmptyMutationCallback>(*document));
+  MutationObserverInit* init = MutationObserverInit::Create();
+  init->setAttributeOldValue(true);
+  with_old_value->observe(root, init, ASSERT_NO_EXCEPTION);
+
+  Persistent<MutationObserver> without_old_value = MutationObserver::Create(
+      MakeGarbageCollected<EmptyMutationCallback>(*document));
+  init = MutationObserverInit::Create();
+  init->setAttributes(true);
+  without_old_value->observe(root, init, ASSERT_NO_EXCEPTION);
+
+  root->setAttribute(html_names::kTitleAttr, "after");
+
+  MutationRecordVector records = with_old_value->takeRecords();
+  ASSERT_EQ(1u, records.size());
+  EXPECT_EQ("before", records[0]->oldValue());
+
+  records = without_old_value->takeRecords();
+  ASSERT_EQ(1u, records.size());
+  EXPECT_TRUE(records[0]->oldValue().IsNull());
+
+  // With only the observer that did not ask for it, the old value is dropped
+  // at record creation.
+  with_old_value->disconnect();
+  root->setAttribute(html_names::kTitleAttr, "again");
+  records = without_old_value->takeRecords();
+  ASSERT_EQ(1u, records.size());
+  EXPECT_TRUE(records[0]->oldValue().IsNull());
+  without_old_value->disconnect();
+}
+
 }  // namespace blink
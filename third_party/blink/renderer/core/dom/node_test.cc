@@ -16,6 +16,7 @@
 #include "third_party/blink/renderer/core/dom/shadow_root_init.h"
 #include "third_party/blink/renderer/core/editing/testing/editing_test_base.h"
 #include "third_party/blink/renderer/core/html/html_div_element.h"
+#include "third_party/blink/renderer/core/html_names.h"
 
 namespace blink {
 
@@ -349,4 +350,25 @@ TEST_F(NodeTest, LazyReattachCommentAndPI) {
   EXPECT_FALSE(pi->NeedsStyleRecalc());
 }
 
+TEST_F(NodeTest, ChildNodesItemAfterMutation) {
+  SetBodyContent("<div id='parent'><b></b><i></i><u></u></div>");
+  Element* parent = GetDocument().getElementById("parent");
+  NodeList* child_nodes = parent->childNodes();
+  EXPECT_EQ(3u, child_nodes->length());
+
+  // Insertions and removals keep the cached length but drop the cached node,
+  // so indexed access has to pick a fresh starting point.
+  Element* appended = GetDocument().CreateRawElement(html_names::kSpanTag);
+  parent->appendChild(appended, ASSERT_NO_EXCEPTION);
+  EXPECT_EQ(appended, child_nodes->item(3));
+  EXPECT_EQ(parent->firstChild(), child_nodes->item(0));
+  EXPECT_EQ(parent->lastChild()->previousSibling(), child_nodes->item(2));
+
+  parent->removeChild(parent->firstChild(), ASSERT_NO_EXCEPTION);
+  EXPECT_EQ(3u, child_nodes->length());
+  EXPECT_EQ(appended, child_nodes->item(2));
+  EXPECT_EQ(parent->firstChild()->nextSibling(), child_nodes->item(1));
+  EXPECT_EQ(nullptr, child_nodes->item(3));
+}
+
 }  // namespace blink
@@ -44,11 +44,6 @@ void HitTestCacheEntry::Trace(blink::Visitor* visitor) {
   visitor->Trace(result);
 }
 
-void HitTestCacheEntry::CacheValues(const HitTestCacheEntry& other) {
-  *this = other;
-  result.CacheValues(other.result);
-}
-
 void HitTestCache::AddCachedResult(const HitTestLocation& location,
                                    const HitTestResult& result,
                                    uint64_t dom_tree_version) {
@@ -69,10 +64,12 @@ void HitTestCache::AddCachedResult(const HitTestLocation& location,
   if (items_.size() < HIT_TEST_CACHE_SIZE)
     items_.resize(update_index_ + 1);
 
-  HitTestCacheEntry cache_entry;
+  // Fill the slot in place rather than going through a temporary entry, which
+  // would copy the location and result twice.
+  HitTestCacheEntry& cache_entry = items_.at(update_index_);
   cache_entry.location = location;
   cache_entry.result = result;
-  items_.at(update_index_).CacheValues(cache_entry);
+  cache_entry.result.CacheValues(result);
   dom_tree_version_ = dom_tree_version;
 
   update_index_++;
@@ -40,8 +40,6 @@ struct HitTestCacheEntry {
   void Trace(blink::Visitor*);
   HitTestLocation location;
   HitTestResult result;
-
-  void CacheValues(const HitTestCacheEntry&);
 };
 
 class CORE_EXPORT HitTestCache final
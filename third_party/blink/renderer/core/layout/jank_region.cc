@@ -4,6 +4,8 @@
 
 #include "third_party/blink/renderer/core/layout/jank_region.h"
 
+#include <algorithm>
+
 namespace blink {
 
 namespace {
@@ -33,6 +35,9 @@ struct SweepEvent {
 class BasicIntervals {
  public:
   // Add all the endpoints before creating the index.
+  void ReserveEndpoints(wtf_size_t count) {
+    endpoints_.ReserveInitialCapacity(count);
+  }
   void AddEndpoint(int endpoint);
   void CreateIndex();
 
@@ -42,9 +47,11 @@ class BasicIntervals {
   unsigned SegmentLength(Segment) const;
 
  private:
+  unsigned IndexOf(int endpoint) const;
+
+  // Sorted and de-duplicated by CreateIndex(), after which an endpoint's index
+  // is found by binary search.
   Vector<int> endpoints_;
-  // Avoid WTF::HashMap as key may be 0 or -1.
-  std::unordered_map<int, unsigned> endpoint_to_index_;
 
 #if DCHECK_IS_ON()
   bool has_index_ = false;
@@ -59,19 +66,14 @@ class BasicIntervals {
 
 inline void BasicIntervals::AddEndpoint(int endpoint) {
   DCHECK_HAS_INDEX(false);
-
-  // We can't index yet, but use the map to de-dupe.
-  auto ret = endpoint_to_index_.insert(std::make_pair(endpoint, 0u));
-  if (ret.second)
-    endpoints_.push_back(endpoint);
+  endpoints_.push_back(endpoint);
 }
 
 void BasicIntervals::CreateIndex() {
   DCHECK_HAS_INDEX(false);
   std::sort(endpoints_.begin(), endpoints_.end());
-  unsigned i = 0;
-  for (const int& e : endpoints_)
-    endpoint_to_index_[e] = i++;
+  int* unique_end = std::unique(endpoints_.begin(), endpoints_.end());
+  endpoints_.Shrink(static_cast<wtf_size_t>(unique_end - endpoints_.begin()));
 
 #if DCHECK_IS_ON()
   has_index_ = true;
@@ -85,7 +87,14 @@ inline unsigned BasicIntervals::NumIntervals() const {
 
 inline Segment BasicIntervals::SegmentFromEndpoints(int start, int end) const {
   DCHECK_HAS_INDEX(true);
-  return Segment{endpoint_to_index_.at(start), endpoint_to_index_.at(end) - 1};
+  return Segment{IndexOf(start), IndexOf(end) - 1};
+}
+
+inline unsigned BasicIntervals::IndexOf(int endpoint) const {
+  const int* it =
+      std::lower_bound(endpoints_.begin(), endpoints_.end(), endpoint);
+  DCHECK(it != endpoints_.end() && *it == endpoint);
+  return static_cast<unsigned>(it - endpoints_.begin());
 }
 
 inline unsigned BasicIntervals::SegmentLength(Segment segment) const {
@@ -261,6 +270,7 @@ uint64_t Sweeper::Sweep() const {
 }
 
 void Sweeper::InitIntervals(BasicIntervals& y_vals) const {
+  y_vals.ReserveEndpoints(rects_.size() << 1);
   for (const IntRect& rect : rects_) {
     y_vals.AddEndpoint(rect.Y());
     y_vals.AddEndpoint(rect.MaxY());
@@ -648,14 +648,21 @@ void LayoutBlock::UpdateBlockChildDirtyBitsBeforeLayout(bool relayout_children,
     // is outside the spanner but inside the multicol container.
     return;
   }
+  // The remaining checks consult the child's style, so skip them when every
+  // child is being relaid out anyway.
+  if (relayout_children) {
+    child.SetChildNeedsLayout(kMarkOnlyThis);
+    return;
+  }
   // FIXME: Technically percentage height objects only need a relayout if their
   // percentage isn't going to be turned into an auto value. Add a method to
   // determine this, so that we can avoid the relayout.
-  bool has_relative_logical_height =
-      child.HasRelativeLogicalHeight() ||
-      (child.IsAnonymous() && HasRelativeLogicalHeight()) ||
-      child.StretchesToViewport();
-  if (relayout_children || (has_relative_logical_height && !IsLayoutView()) ||
+  bool affected_by_relative_logical_height =
+      !IsLayoutView() &&
+      (child.HasRelativeLogicalHeight() ||
+       (child.IsAnonymous() && HasRelativeLogicalHeight()) ||
+       child.StretchesToViewport());
+  if (affected_by_relative_logical_height ||
       (height_available_to_children_changed_ &&
        ChangeInAvailableLogicalHeightAffectsChild(this, child)) ||
       (child.IsListMarker() && IsListItem() &&
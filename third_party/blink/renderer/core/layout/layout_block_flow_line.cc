@@ -625,26 +625,26 @@ static inline void SetLogicalWidthForTextRun(
   glyph_overflow.SetFromBounds(glyph_bounds, font, measured_width);
 
   run->box_->SetLogicalWidth(LayoutUnit(measured_width) + hyphen_width);
-  if (!fallback_fonts.IsEmpty()) {
-    DCHECK(run->box_->IsText());
-    GlyphOverflowAndFallbackFontsMap::ValueType* it =
-        text_box_data_map
-            .insert(ToInlineTextBox(run->box_),
-                    std::make_pair(Vector<const SimpleFontData*>(),
-                                   GlyphOverflow()))
-            .stored_value;
+  bool has_fallback_fonts = !fallback_fonts.IsEmpty();
+  bool has_glyph_overflow = !glyph_overflow.IsApproximatelyZero();
+  if (!has_fallback_fonts && !has_glyph_overflow)
+    return;
+
+  // Runs with both fallback fonts and glyph overflow share a single entry, so
+  // look it up once.
+  DCHECK(run->box_->IsText());
+  GlyphOverflowAndFallbackFontsMap::ValueType* it =
+      text_box_data_map
+          .insert(ToInlineTextBox(run->box_),
+                  std::make_pair(Vector<const SimpleFontData*>(),
+                                 GlyphOverflow()))
+          .stored_value;
+  if (has_fallback_fonts) {
     DCHECK(it->value.first.IsEmpty());
     CopyToVector(fallback_fonts, it->value.first);
     run->box_->Parent()->ClearDescendantsHaveSameLineHeightAndBaseline();
   }
-  if (!glyph_overflow.IsApproximatelyZero()) {
-    DCHECK(run->box_->IsText());
-    GlyphOverflowAndFallbackFontsMap::ValueType* it =
-        text_box_data_map
-            .insert(ToInlineTextBox(run->box_),
-                    std::make_pair(Vector<const SimpleFontData*>(),
-                                   GlyphOverflow()))
-            .stored_value;
+  if (has_glyph_overflow) {
     it->value.second = glyph_overflow;
     run->box_->ClearKnownToHaveNoOverflow();
   }
@@ -25,6 +25,7 @@
 #include <memory>
 #include <utility>
 
+#include "base/metrics/histogram_macros.h"
 #include "third_party/blink/public/mojom/fetch/fetch_api_request.mojom-shared.h"
 #include "third_party/blink/public/platform/web_client_hints_type.h"
 #include "third_party/blink/public/platform/web_url_request.h"
@@ -565,6 +566,7 @@ void ImageLoader::DoUpdateFromElement(
       }
     }
 
+    fetch_start_time_ = base::TimeTicks::Now();
     new_image_content = ImageResourceContent::Fetch(params, document.Fetcher());
 
     // If this load is starting while navigating away, treat it as an auditing
@@ -747,6 +749,27 @@ void ImageLoader::ImageChanged(ImageResourceContent* content,
       IncrementLoadEventDelayCount::Create(document);
 }
 
+void ImageLoader::RecordFetchToFinishTime() {
+  if (fetch_start_time_.is_null())
+    return;
+  base::TimeDelta elapsed = base::TimeTicks::Now() - fetch_start_time_;
+  fetch_start_time_ = base::TimeTicks();
+
+  // Use the same visibility signal that drives image fetch priorities. Skip
+  // boxes with stale geometry rather than forcing a layout.
+  LayoutObject* layout_object = GetElement()->GetLayoutObject();
+  if (!layout_object || !layout_object->IsBox() || layout_object->NeedsLayout())
+    return;
+  if (ToLayoutBox(layout_object)->ComputeResourcePriority().visibility ==
+      ResourcePriority::kVisible) {
+    UMA_HISTOGRAM_MEDIUM_TIMES("Blink.ImageLoader.FetchToFinishTime.Visible",
+                               elapsed);
+  } else {
+    UMA_HISTOGRAM_MEDIUM_TIMES(
+        "Blink.ImageLoader.FetchToFinishTime.NotVisible", elapsed);
+  }
+}
+
 void ImageLoader::ImageNotifyFinished(ImageResourceContent* resource) {
   RESOURCE_LOADING_DVLOG(1)
       << "ImageLoader::imageNotifyFinished " << this
@@ -790,6 +813,7 @@ void ImageLoader::ImageNotifyFinished(ImageResourceContent* resource) {
     image_content_->UpdateImageAnimationPolicy();
 
   UpdateLayoutObject();
+  RecordFetchToFinishTime();
 
   if (image_content_ && image_content_->HasImage()) {
     Image& image = *image_content_->GetImage();
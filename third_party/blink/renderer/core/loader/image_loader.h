@@ -25,6 +25,7 @@
 
 #include <memory>
 #include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
 #include "third_party/blink/public/platform/task_type.h"
 #include "third_party/blink/renderer/bindings/core/v8/script_promise.h"
 #include "third_party/blink/renderer/bindings/core/v8/script_promise_resolver.h"
@@ -200,6 +201,10 @@ class CORE_EXPORT ImageLoader : public GarbageCollectedFinalized<ImageLoader>,
 
   void DispatchDecodeRequestsIfComplete();
   void RejectPendingDecodes(UpdateType = UpdateType::kAsync);
+
+  // Reports how long the current fetch took, split by whether the image is in
+  // the viewport when it finishes.
+  void RecordFetchToFinishTime();
   void DecodeRequestFinished(uint64_t request_id, bool success);
 
   Member<Element> element_;
@@ -238,6 +243,10 @@ class CORE_EXPORT ImageLoader : public GarbageCollectedFinalized<ImageLoader>,
 
   LazyImageLoadState lazy_image_load_state_;
 
+  // When the current image fetch was issued by DoUpdateFromElement(). Null
+  // once the fetch has been reported or for ImageDocument loads.
+  base::TimeTicks fetch_start_time_;
+
   // DecodeRequest represents a single request to the Decode() function. The
   // decode requests have one of the following states:
   //
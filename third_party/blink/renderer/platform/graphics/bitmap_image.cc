@@ -92,8 +92,15 @@ scoped_refptr<SharedBuffer> BitmapImage::Data() {
 }
 
 void BitmapImage::NotifyMemoryChanged() {
-  if (GetImageObserver())
-    GetImageObserver()->DecodedSizeChangedTo(this, TotalFrameBytes());
+  if (!GetImageObserver())
+    return;
+  // The cached frame is recreated on every DataChanged() and ResetAnimation()
+  // without changing the decoded size, so only report actual changes.
+  size_t decoded_size = TotalFrameBytes();
+  if (decoded_size == reported_decoded_size_)
+    return;
+  reported_decoded_size_ = decoded_size;
+  GetImageObserver()->DecodedSizeChangedTo(this, decoded_size);
 }
 
 size_t BitmapImage::TotalFrameBytes() {
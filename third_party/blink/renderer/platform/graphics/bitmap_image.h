@@ -174,6 +174,9 @@ class PLATFORM_EXPORT BitmapImage final : public Image {
   size_t frame_count_;
 
   PaintImage::AnimationSequenceId reset_animation_sequence_id_ = 0;
+
+  // The decoded size last passed to ImageObserver::DecodedSizeChangedTo().
+  size_t reported_decoded_size_ = 0;
 };
 
 DEFINE_IMAGE_TYPE_CASTS(BitmapImage);
@@ -128,6 +128,7 @@ class BitmapImageTest : public testing::Test {
       last_decoded_size_changed_delta_ =
           SafeCast<int>(new_size) - SafeCast<int>(last_decoded_size_);
       last_decoded_size_ = new_size;
+      decoded_size_change_count_++;
     }
     bool ShouldPauseAnimation(const Image*) override { return false; }
     void AsyncLoadCompleted(const Image*) override { NOTREACHED(); }
@@ -136,6 +137,7 @@ class BitmapImageTest : public testing::Test {
 
     size_t last_decoded_size_;
     int last_decoded_size_changed_delta_;
+    int decoded_size_change_count_ = 0;
   };
 
   static scoped_refptr<SharedBuffer> ReadFile(const char* file_name) {
@@ -339,6 +341,22 @@ TEST_F(BitmapImageTest, recachingFrameAfterDataChanged) {
   EXPECT_EQ(0, LastDecodedSizeChange());
 }
 
+TEST_F(BitmapImageTest, UnchangedDecodedSizeIsNotReported) {
+  LoadImage("animated-10color.gif");
+  image_->PaintImageForCurrentFrame();
+  EXPECT_EQ(1, image_observer_->decoded_size_change_count_);
+
+  image_->DataChanged(true);
+  image_->PaintImageForCurrentFrame();
+  image_->ResetAnimation();
+  image_->PaintImageForCurrentFrame();
+  EXPECT_EQ(1, image_observer_->decoded_size_change_count_);
+
+  DestroyDecodedData();
+  EXPECT_EQ(2, image_observer_->decoded_size_change_count_);
+  EXPECT_EQ(0u, image_observer_->last_decoded_size_);
+}
+
 TEST_F(BitmapImageTest, ConstantImageIdForPartiallyLoadedImages) {
   scoped_refptr<SharedBuffer> image_data = ReadFile("green.jpg");
   ASSERT_TRUE(image_data.get());
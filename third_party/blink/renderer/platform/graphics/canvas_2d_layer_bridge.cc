@@ -107,7 +107,11 @@ Canvas2DLayerBridge::~Canvas2DLayerBridge() {
 
 void Canvas2DLayerBridge::StartRecording() {
   DCHECK(is_deferral_enabled_);
-  recorder_ = std::make_unique<PaintRecorder>();
+  // The recorder is reusable once the previous recording has been finished,
+  // so keep it (and its display item list) across flushes instead of
+  // reallocating it every frame.
+  if (!recorder_)
+    recorder_ = std::make_unique<PaintRecorder>();
   cc::PaintCanvas* canvas =
       recorder_->beginRecording(size_.Width(), size_.Height());
   // Always save an initial frame, to support resetting the top level matrix
@@ -267,7 +267,6 @@ bool DrainWorklistWithDeadline(TimeTicks deadline,
   typename Worklist::EntryType item;
   while (worklist->Pop(WorklistTaskId::MainThread, &item)) {
     callback(item);
-    processed_callback_count++;
     if (++processed_callback_count == kDeadlineCheckInterval) {
       if (deadline <= CurrentTimeTicks()) {
         return false;
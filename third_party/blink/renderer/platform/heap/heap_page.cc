@@ -678,7 +678,9 @@ void NormalPageArena::AllocatePage() {
         CHECK(result);
         page_memory = memory;
       } else {
-        GetThreadState()->Heap().GetFreePagePool()->Add(ArenaIndex(), memory);
+        // The rest of the freshly reserved region was never committed.
+        GetThreadState()->Heap().GetFreePagePool()->AddUncommitted(
+            ArenaIndex(), memory);
       }
     }
   }
@@ -1218,12 +1220,9 @@ void FreeList::Clear() {
 
 int FreeList::BucketIndexForSize(size_t size) {
   DCHECK_GT(size, 0u);
-  int index = -1;
-  while (size) {
-    size >>= 1;
-    index++;
-  }
-  return index;
+  // Index of the most significant set bit, i.e. floor(log2(size)).
+  return static_cast<int>(sizeof(size_t) * 8 - 1) -
+         base::bits::CountLeadingZeroBitsSizeT(size);
 }
 
 bool FreeList::TakeSnapshot(const String& dump_base_name) {
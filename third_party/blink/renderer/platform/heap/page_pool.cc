@@ -33,6 +33,10 @@ void PagePool::Add(int index, PageMemory* memory) {
   // while in the pool.  This also allows the physical memory, backing the
   // page, to be given back to the OS.
   memory->Decommit();
+  AddUncommitted(index, memory);
+}
+
+void PagePool::AddUncommitted(int index, PageMemory* memory) {
   PoolEntry* entry = new PoolEntry(memory, pool_[index]);
   pool_[index] = entry;
 }
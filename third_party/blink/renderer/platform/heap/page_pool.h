@@ -27,6 +27,10 @@ class PagePool {
   PagePool();
   ~PagePool();
   void Add(int, PageMemory*);
+  // Like Add(), for memory that has been reserved but never committed. Such
+  // memory is already inaccessible and holds no physical pages, so the
+  // decommit system calls can be skipped.
+  void AddUncommitted(int, PageMemory*);
   PageMemory* Take(int);
 
  private:
@@ -1149,6 +1149,14 @@ void UpdateHistograms(const ThreadHeapStatsCollector::Event& event) {
       "BlinkGC.AtomicPhaseMarking",
       event.scope_data[ThreadHeapStatsCollector::kAtomicPhaseMarking]);
 
+  // The whole main-thread pause, of which marking above is one part. Stack
+  // scanning only ever happens inside the pause, so it is reported alongside.
+  UMA_HISTOGRAM_TIMES("BlinkGC.AtomicPhase",
+                      event.scope_data[ThreadHeapStatsCollector::kAtomicPhase]);
+  UMA_HISTOGRAM_TIMES(
+      "BlinkGC.AtomicPhase.VisitStackRoots",
+      event.scope_data[ThreadHeapStatsCollector::kVisitStackRoots]);
+
   UMA_HISTOGRAM_TIMES(
       "BlinkGC.CompleteSweep",
       event.scope_data[ThreadHeapStatsCollector::kCompleteSweep]);
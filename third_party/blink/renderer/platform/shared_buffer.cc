@@ -181,7 +181,11 @@ SharedBuffer::Iterator SharedBuffer::end() const {
 }
 
 void SharedBuffer::MergeSegmentsIntoBuffer() {
+  if (segments_.IsEmpty())
+    return;
   wtf_size_t bytes_left = size_ - buffer_.size();
+  // Grow the flat buffer once instead of once per appended segment.
+  buffer_.ReserveCapacity(size_);
   for (const auto& segment : segments_) {
     wtf_size_t bytes_to_copy = std::min<wtf_size_t>(bytes_left, kSegmentSize);
     buffer_.Append(segment.get(), bytes_to_copy);
@@ -63,9 +63,10 @@ class PLATFORM_EXPORT SharedBuffer : public RefCounted<SharedBuffer> {
       return temp;
     }
     bool operator==(const Iterator& that) const {
-      return std::equal(value_.begin(), value_.end(), that.value_.begin(),
-                        that.value_.end()) &&
-             buffer_ == that.buffer_;
+      // Iterators are equal when they view the same bytes, so compare the
+      // spans by identity rather than by content.
+      return value_.data() == that.value_.data() &&
+             value_.size() == that.value_.size() && buffer_ == that.buffer_;
     }
     bool operator!=(const Iterator& that) const { return !(*this == that); }
     const base::span<const char>& operator*() const {
@@ -360,6 +360,20 @@ TEST(SharedBufferIteratorTest, SegmentedPartOnly) {
   EXPECT_EQ(it, buffer->cend());
 }
 
+TEST(SharedBufferIteratorTest, SegmentsWithSameContentAreDistinct) {
+  Vector<char> data(SharedBuffer::kSegmentSize * 3, 'a');
+  auto buffer = SharedBuffer::Create();
+  buffer->Append(data);
+
+  auto first = buffer->cbegin();
+  auto second = first;
+  ++second;
+  ASSERT_NE(second, buffer->cend());
+  ASSERT_EQ(first->size(), second->size());
+  EXPECT_NE(first, second);
+  EXPECT_EQ(second, buffer->GetIteratorAt(first->size()));
+}
+
 TEST(SharedBufferIteratorTest, ConsecutivePartAndSegmentedPart) {
   Vector<char> data(SharedBuffer::kSegmentSize * 2 + 256);
   std::generate(data.begin(), data.end(), &std::rand);
@@ -114,17 +114,28 @@ void TimerBase::SetNextFireTime(TimeTicks now, TimeDelta delay) {
 
   TimeTicks new_time = now + delay;
 
-  if (next_fire_time_ != new_time) {
-    next_fire_time_ = new_time;
+  if (next_fire_time_ == new_time)
+    return;
 
-    // Cancel any previously posted task.
-    weak_ptr_factory_.InvalidateWeakPtrs();
+  next_fire_time_ = new_time;
 
-    TimerTaskRunner()->PostDelayedTask(
-        location_,
-        WTF::Bind(&TimerBase::RunInternal, weak_ptr_factory_.GetWeakPtr()),
-        delay);
-  }
+  // If the posted task runs no later than the new deadline, keep it and let
+  // RunInternal() post the remainder. Timers that are restarted over and over
+  // with a later deadline then don't churn the delayed task queue.
+  if (IsActive() && posted_fire_time_ <= new_time)
+    return;
+
+  // Cancel any previously posted task.
+  weak_ptr_factory_.InvalidateWeakPtrs();
+  PostRunTask(delay);
+}
+
+void TimerBase::PostRunTask(TimeDelta delay) {
+  posted_fire_time_ = next_fire_time_;
+  TimerTaskRunner()->PostDelayedTask(
+      location_,
+      WTF::Bind(&TimerBase::RunInternal, weak_ptr_factory_.GetWeakPtr()),
+      delay);
 }
 
 NO_SANITIZE_ADDRESS
@@ -132,6 +143,13 @@ void TimerBase::RunInternal() {
   if (!CanFire())
     return;
 
+  if (posted_fire_time_ < next_fire_time_) {
+    // The timer was pushed back after this task was posted.
+    PostRunTask(
+        std::max(next_fire_time_ - TimerCurrentTimeTicks(), TimeDelta()));
+    return;
+  }
+
   weak_ptr_factory_.InvalidateWeakPtrs();
 
   TRACE_EVENT0("blink", "TimerBase::run");
@@ -91,10 +91,14 @@ class PLATFORM_EXPORT TimerBase {
   TimeTicks TimerCurrentTimeTicks() const;
 
   void SetNextFireTime(TimeTicks now, TimeDelta delay);
+  void PostRunTask(TimeDelta delay);
 
   void RunInternal();
 
   TimeTicks next_fire_time_;   // 0 if inactive
+  // Run time of the currently posted task. May be earlier than
+  // |next_fire_time_| if the timer was restarted with a later deadline.
+  TimeTicks posted_fire_time_;
   TimeDelta repeat_interval_;  // 0 if not repeating
   base::Location location_;
   scoped_refptr<base::SingleThreadTaskRunner> web_task_runner_;
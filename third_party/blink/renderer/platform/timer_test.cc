@@ -310,7 +310,7 @@ TEST_F(TimerTest, PostingTimerTwiceWithNewerRunTimeCancelsOriginalTask) {
   EXPECT_THAT(run_times_, ElementsAre(start_time_ + TimeDelta::FromSeconds(0)));
 }
 
-TEST_F(TimerTest, PostingTimerTwiceWithLaterRunTimeCancelsOriginalTask) {
+TEST_F(TimerTest, PostingTimerTwiceWithLaterRunTimeFiresOnceAtLaterRunTime) {
   TaskRunnerTimer<TimerTest> timer(GetTaskRunner(), this,
                                    &TimerTest::CountingTask);
   timer.StartOneShot(TimeDelta(), FROM_HERE);
@@ -321,6 +321,22 @@ TEST_F(TimerTest, PostingTimerTwiceWithLaterRunTimeCancelsOriginalTask) {
               ElementsAre(start_time_ + TimeDelta::FromSeconds(10)));
 }
 
+TEST_F(TimerTest, PostingTimerWithLaterRunTimeKeepsOriginalTask) {
+  TaskRunnerTimer<TimerTest> timer(GetTaskRunner(), this,
+                                   &TimerTest::CountingTask);
+  timer.StartOneShot(TimeDelta::FromSeconds(10), FROM_HERE);
+  timer.StartOneShot(TimeDelta::FromSeconds(20), FROM_HERE);
+  EXPECT_EQ(TimeDelta::FromSeconds(20), timer.NextFireInterval());
+
+  TimeDelta run_time;
+  EXPECT_TRUE(TimeTillNextDelayedTask(&run_time));
+  EXPECT_EQ(TimeDelta::FromSeconds(10), run_time);
+
+  platform_->RunUntilIdle();
+  EXPECT_THAT(run_times_,
+              ElementsAre(start_time_ + TimeDelta::FromSeconds(20)));
+}
+
 TEST_F(TimerTest, StartRepeatingTask) {
   TaskRunnerTimer<TimerTest> timer(GetTaskRunner(), this,
                                    &TimerTest::CountingTask);
@@ -122,6 +122,22 @@ TEST(HashSetTest, ReserveCapacity) {
   TestReserveCapacity<128>();
 }
 
+TEST(HashSetTest, RepeatedAddAndEraseOnMinimumSizeTable) {
+  HashSet<int> set;
+  set.insert(1);
+  const unsigned capacity = set.Capacity();
+  // Cycling distinct keys through an otherwise empty table must not leave
+  // tombstones behind that force it to grow.
+  for (int i = 2; i < 1000; ++i) {
+    set.erase(i - 1);
+    EXPECT_TRUE(set.IsEmpty());
+    set.insert(i);
+    EXPECT_EQ(capacity, set.Capacity());
+    EXPECT_TRUE(set.Contains(i));
+    EXPECT_FALSE(set.Contains(i - 1));
+  }
+}
+
 TEST(HashSetTest, HashSetOwnPtr) {
   bool deleted1 = false, deleted2 = false;
 
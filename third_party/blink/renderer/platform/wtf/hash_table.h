@@ -1550,8 +1550,17 @@ void HashTable<Key,
   ++deleted_count_;
   --key_count_;
 
-  if (ShouldShrink())
+  if (ShouldShrink()) {
     Shrink();
+  } else if (!key_count_ && table_size_ <= KeyTraits::kMinimumTableSize) {
+    // A minimum-size table is never shrunk, so tombstones from repeated
+    // add/erase cycles would otherwise pile up until the next
+    // rehash-in-place. Once the table is empty, turn them back into empty
+    // buckets so that lookups terminate on the first probe again.
+    for (unsigned i = 0; i < table_size_; ++i)
+      InitializeBucket(table_[i]);
+    deleted_count_ = 0;
+  }
 }
 
 template <typename Key,
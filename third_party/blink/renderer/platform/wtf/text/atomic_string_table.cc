@@ -40,18 +40,25 @@ scoped_refptr<StringImpl> AtomicStringTable::AddToStringTable(const T& value) {
 
 template <typename CharacterType>
 struct HashTranslatorCharBuffer {
+  HashTranslatorCharBuffer(const CharacterType* s, unsigned length)
+      : s(s),
+        length(length),
+        hash(StringHasher::ComputeHashAndMaskTop8Bits(s, length)) {}
+
   const CharacterType* s;
   unsigned length;
+  unsigned hash;
 };
 
 typedef HashTranslatorCharBuffer<UChar> UCharBuffer;
 struct UCharBufferTranslator {
-  static unsigned GetHash(const UCharBuffer& buf) {
-    return StringHasher::ComputeHashAndMaskTop8Bits(buf.s, buf.length);
-  }
+  static unsigned GetHash(const UCharBuffer& buf) { return buf.hash; }
 
   static bool Equal(StringImpl* const& str, const UCharBuffer& buf) {
-    return WTF::Equal(str, buf.s, buf.length);
+    // Every string in the table has its hash cached, so comparing it first
+    // lets colliding probes skip the character comparison.
+    return str->ExistingHash() == buf.hash &&
+           WTF::Equal(str, buf.s, buf.length);
   }
 
   static void Translate(StringImpl*& location,
@@ -80,7 +87,8 @@ struct HashAndUTF8CharactersTranslator {
 
   static bool Equal(StringImpl* const& string,
                     const HashAndUTF8Characters& buffer) {
-    if (buffer.utf16_length != string->length())
+    if (buffer.hash != string->ExistingHash() ||
+        buffer.utf16_length != string->length())
       return false;
 
     // If buffer contains only ASCII characters UTF-8 and UTF16 length are the
@@ -155,18 +163,17 @@ scoped_refptr<StringImpl> AtomicStringTable::Add(const UChar* s,
   if (!length)
     return StringImpl::empty_;
 
-  UCharBuffer buffer = {s, length};
+  UCharBuffer buffer(s, length);
   return AddToStringTable<UCharBuffer, UCharBufferTranslator>(buffer);
 }
 
 typedef HashTranslatorCharBuffer<LChar> LCharBuffer;
 struct LCharBufferTranslator {
-  static unsigned GetHash(const LCharBuffer& buf) {
-    return StringHasher::ComputeHashAndMaskTop8Bits(buf.s, buf.length);
-  }
+  static unsigned GetHash(const LCharBuffer& buf) { return buf.hash; }
 
   static bool Equal(StringImpl* const& str, const LCharBuffer& buf) {
-    return WTF::Equal(str, buf.s, buf.length);
+    return str->ExistingHash() == buf.hash &&
+           WTF::Equal(str, buf.s, buf.length);
   }
 
   static void Translate(StringImpl*& location,
@@ -188,7 +195,7 @@ scoped_refptr<StringImpl> AtomicStringTable::Add(const LChar* s,
   if (!length)
     return StringImpl::empty_;
 
-  LCharBuffer buffer = {s, length};
+  LCharBuffer buffer(s, length);
   return AddToStringTable<LCharBuffer, LCharBufferTranslator>(buffer);
 }
 
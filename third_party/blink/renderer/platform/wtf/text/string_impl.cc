@@ -340,57 +340,46 @@ wtf_size_t StringImpl::CopyTo(UChar* buffer,
   return number_of_characters_to_copy;
 }
 
-scoped_refptr<StringImpl> StringImpl::LowerASCII() {
-  // First scan the string for uppercase and non-ASCII characters:
-  if (Is8Bit()) {
-    wtf_size_t first_index_to_be_lowered = length_;
-    for (wtf_size_t i = 0; i < length_; ++i) {
-      LChar ch = Characters8()[i];
-      if (IsASCIIUpper(ch)) {
-        first_index_to_be_lowered = i;
-        break;
-      }
-    }
-
-    // Nothing to do if the string is all ASCII with no uppercase.
-    if (first_index_to_be_lowered == length_) {
-      return this;
-    }
-
-    LChar* data8;
-    scoped_refptr<StringImpl> new_impl = CreateUninitialized(length_, data8);
-    memcpy(data8, Characters8(), first_index_to_be_lowered);
-
-    for (wtf_size_t i = first_index_to_be_lowered; i < length_; ++i) {
-      LChar ch = Characters8()[i];
-      data8[i] = IsASCIIUpper(ch) ? ToASCIILower(ch) : ch;
-    }
-    return new_impl;
-  }
-  bool no_upper = true;
-  UChar ored = 0;
-
-  const UChar* end = Characters16() + length_;
-  for (const UChar* chp = Characters16(); chp != end; ++chp) {
-    if (IsASCIIUpper(*chp))
-      no_upper = false;
-    ored |= *chp;
+namespace {
+
+// Returns |string| itself when no character needs converting, otherwise a copy
+// in which |convert| has been applied to every character matching
+// |needs_conversion|.
+template <typename CharType, typename NeedsConversion, typename Convert>
+scoped_refptr<StringImpl> ConvertASCIICase(StringImpl* string,
+                                           const CharType* data,
+                                           NeedsConversion needs_conversion,
+                                           Convert convert) {
+  const wtf_size_t length = string->length();
+  wtf_size_t first_index_to_convert = 0;
+  while (first_index_to_convert < length &&
+         !needs_conversion(data[first_index_to_convert]))
+    ++first_index_to_convert;
+
+  if (first_index_to_convert == length)
+    return string;
+
+  CharType* new_data;
+  scoped_refptr<StringImpl> new_impl =
+      StringImpl::CreateUninitialized(length, new_data);
+  memcpy(new_data, data, first_index_to_convert * sizeof(CharType));
+  for (wtf_size_t i = first_index_to_convert; i < length; ++i) {
+    CharType c = data[i];
+    new_data[i] = needs_conversion(c) ? convert(c) : c;
   }
-  // Nothing to do if the string is all ASCII with no uppercase.
-  if (no_upper && !(ored & ~0x7F))
-    return this;
-
-  CHECK_LE(length_, static_cast<wtf_size_t>(numeric_limits<wtf_size_t>::max()));
-  wtf_size_t length = length_;
+  return new_impl;
+}
 
-  UChar* data16;
-  scoped_refptr<StringImpl> new_impl = CreateUninitialized(length_, data16);
+}  // namespace
 
-  for (wtf_size_t i = 0; i < length; ++i) {
-    UChar c = Characters16()[i];
-    data16[i] = IsASCIIUpper(c) ? ToASCIILower(c) : c;
-  }
-  return new_impl;
+scoped_refptr<StringImpl> StringImpl::LowerASCII() {
+  // Non-ASCII characters are left untouched, so only ASCII uppercase
+  // characters make a copy necessary.
+  auto is_upper = [](auto c) { return IsASCIIUpper(c); };
+  auto to_lower = [](auto c) { return ToASCIILower(c); };
+  if (Is8Bit())
+    return ConvertASCIICase(this, Characters8(), is_upper, to_lower);
+  return ConvertASCIICase(this, Characters16(), is_upper, to_lower);
 }
 
 scoped_refptr<StringImpl> StringImpl::LowerUnicode() {
@@ -565,25 +554,11 @@ upconvert:
 }
 
 scoped_refptr<StringImpl> StringImpl::UpperASCII() {
-  if (Is8Bit()) {
-    LChar* data8;
-    scoped_refptr<StringImpl> new_impl = CreateUninitialized(length_, data8);
-
-    for (wtf_size_t i = 0; i < length_; ++i) {
-      LChar c = Characters8()[i];
-      data8[i] = IsASCIILower(c) ? ToASCIIUpper(c) : c;
-    }
-    return new_impl;
-  }
-
-  UChar* data16;
-  scoped_refptr<StringImpl> new_impl = CreateUninitialized(length_, data16);
-
-  for (wtf_size_t i = 0; i < length_; ++i) {
-    UChar c = Characters16()[i];
-    data16[i] = IsASCIILower(c) ? ToASCIIUpper(c) : c;
-  }
-  return new_impl;
+  auto is_lower = [](auto c) { return IsASCIILower(c); };
+  auto to_upper = [](auto c) { return ToASCIIUpper(c); };
+  if (Is8Bit())
+    return ConvertASCIICase(this, Characters8(), is_lower, to_upper);
+  return ConvertASCIICase(this, Characters16(), is_lower, to_upper);
 }
 
 static inline bool LocaleIdMatchesLang(const AtomicString& locale_id,
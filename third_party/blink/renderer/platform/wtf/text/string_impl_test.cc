@@ -158,4 +158,18 @@ TEST(StringImplTest, UpperASCII) {
       StringImpl::Create(kTestWithNonASCIIComparison, 2)->UpperASCII().get()));
 }
 
+TEST(StringImplTest, ASCIICaseConversionReturnsSelfWhenUnchanged) {
+  // Non-ASCII characters must not force a copy.
+  static const UChar kLowerWithNonASCII[3] = {0x0061, 0x00c1, 0};  // a\xC1
+  static const UChar kUpperWithNonASCII[3] = {0x0041, 0x00e1, 0};  // A\xE1
+  scoped_refptr<StringImpl> lower = StringImpl::Create(kLowerWithNonASCII, 2);
+  EXPECT_EQ(lower.get(), lower->LowerASCII().get());
+  scoped_refptr<StringImpl> upper = StringImpl::Create(kUpperWithNonASCII, 2);
+  EXPECT_EQ(upper.get(), upper->UpperASCII().get());
+
+  scoped_refptr<StringImpl> upper8 = StringImpl::Create("LINK\xE1");
+  EXPECT_EQ(upper8.get(), upper8->UpperASCII().get());
+  EXPECT_NE(upper8.get(), upper8->LowerASCII().get());
+}
+
 }  // namespace WTF
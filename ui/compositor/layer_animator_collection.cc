@@ -5,6 +5,7 @@
 #include "ui/compositor/layer_animator_collection.h"
 
 #include <set>
+#include <vector>
 
 #include "base/time/time.h"
 #include "ui/compositor/compositor.h"
@@ -45,11 +46,14 @@ bool LayerAnimatorCollection::HasActiveAnimators() const {
 
 void LayerAnimatorCollection::OnAnimationStep(base::TimeTicks now) {
   last_tick_time_ = now;
-  std::set<scoped_refptr<LayerAnimator> > list = animators_;
-  for (auto iter = list.begin(); iter != list.end(); ++iter) {
+  // Step a snapshot, since stepping may start or stop animators. A vector
+  // avoids rebuilding a tree of the animators on every frame.
+  std::vector<scoped_refptr<LayerAnimator>> list(animators_.begin(),
+                                                 animators_.end());
+  for (const auto& animator : list) {
     // Make sure the animator is still valid.
-    if (animators_.count(*iter) > 0)
-      (*iter)->Step(now);
+    if (animators_.count(animator) > 0)
+      animator->Step(now);
   }
   if (!HasActiveAnimators() && compositor_)
     compositor_->RemoveAnimationObserver(this);
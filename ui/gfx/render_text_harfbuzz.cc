@@ -6,6 +6,7 @@
 
 #include <limits>
 #include <set>
+#include <utility>
 
 #include "base/command_line.h"
 #include "base/containers/mru_cache.h"
@@ -1035,9 +1036,11 @@ struct ShapeRunWithFontInput {
     text = full_text.substr(context_start, context_end - context_start);
 
     // Pre-compute the hash to avoid having to re-hash text at every comparison.
-    // Attempt to minimize collisions by including the font and text in the
-    // hash.
-    hash = (uintptr_t)skia_face.get() ^ base::Hash(text);
+    // Attempt to minimize collisions by including the font, size, range and
+    // text in the hash; the same string is commonly shaped at several sizes.
+    hash = base::HashInts(
+        base::HashInts((uintptr_t)skia_face.get(), base::Hash(text)),
+        base::HashInts(font_size, range.start()));
   }
 
   bool operator==(const ShapeRunWithFontInput& other) const {
@@ -1924,7 +1927,7 @@ void RenderTextHarfBuzz::ShapeRunsWithFont(
       ShapeRunWithFont(cache_key, &output);
       run->UpdateFontParamsAndShape(font_params, output);
       if (can_use_cache)
-        cache.get()->Put(cache_key, output);
+        cache.get()->Put(cache_key, std::move(output));
     }
 
     // Check to see if we still have missing glyphs.
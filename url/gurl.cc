@@ -282,6 +282,25 @@ GURL GURL::GetOrigin() const {
   if (SchemeIsFileSystem())
     return inner_url_->GetOrigin();
 
+  // |spec_| is already canonical, so without user info the origin is just the
+  // prefix up to the end of the host or port followed by "/". Build it
+  // directly rather than canonicalizing all components again.
+  if (has_host() && !has_username() && !has_password() &&
+      (!has_port() || parsed_.port.len > 0) && !SchemeIsFile()) {
+    int origin_end = has_port() ? parsed_.port.end() : parsed_.host.end();
+    std::string origin_spec;
+    origin_spec.reserve(origin_end + 1);
+    origin_spec.append(spec_, 0, origin_end);
+    origin_spec.push_back('/');
+
+    url::Parsed origin_parsed;
+    origin_parsed.scheme = parsed_.scheme;
+    origin_parsed.host = parsed_.host;
+    origin_parsed.port = parsed_.port;
+    origin_parsed.path = url::Component(origin_end, 1);
+    return GURL(std::move(origin_spec), origin_parsed, true);
+  }
+
   url::Replacements<char> replacements;
   replacements.ClearUsername();
   replacements.ClearPassword();
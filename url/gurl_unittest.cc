@@ -342,11 +342,24 @@ TEST(GURLTest, GetOrigin) {
        "http://google.com:21/"},
       {"blob:null/guid-goes-here", ""},
       {"blob:http://origin/guid-goes-here", "" /* should be http://origin/ */},
+      {"https://www.google.com:8443/foo?q#b", "https://www.google.com:8443/"},
+      {"http://[::1]:80/foo", "http://[::1]/"},
+      {"http://[::1]:81/foo", "http://[::1]:81/"},
+      {"HTTP://WWW.Google.COM./path", "http://www.google.com./"},
   };
   for (size_t i = 0; i < base::size(cases); i++) {
     GURL url(cases[i].input);
     GURL origin = url.GetOrigin();
     EXPECT_EQ(cases[i].expected, origin.spec());
+    if (!origin.is_valid())
+      continue;
+
+    // The result must match a full canonicalization of the origin spec.
+    GURL reparsed(origin.spec());
+    EXPECT_EQ(reparsed, origin);
+    EXPECT_EQ(reparsed.host(), origin.host());
+    EXPECT_EQ(reparsed.port(), origin.port());
+    EXPECT_EQ(reparsed.path(), origin.path());
   }
 }
 
@@ -77,6 +77,29 @@ const unsigned char kPathCharLookup[0x100] = {
      ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,
      ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE};
 
+// Returns true if |uch| is ASCII and needs no special handling in
+// DoPartialPath(), i.e. it is copied to the output unchanged.
+template <typename UCHAR>
+bool IsPlainPathChar(UCHAR uch) {
+  return uch < 0x80 && !(kPathCharLookup[uch] & SPECIAL);
+}
+
+// Appends |spec[begin, end)|, which must consist of plain path characters.
+void AppendPlainPathRun(const char* spec,
+                        int begin,
+                        int end,
+                        CanonOutput* output) {
+  output->Append(&spec[begin], end - begin);
+}
+
+void AppendPlainPathRun(const base::char16* spec,
+                        int begin,
+                        int end,
+                        CanonOutput* output) {
+  for (int i = begin; i < end; i++)
+    output->push_back(static_cast<char>(spec[i]));
+}
+
 enum DotDisposition {
   // The given dot is just part of a filename and is not special.
   NOT_A_DIRECTORY,
@@ -369,8 +392,16 @@ bool DoPartialPath(const CHAR* spec,
           AppendEscapedChar(out_ch, output);
         }
       } else {
-        // Nothing special about this character, just append it.
-        output->push_back(out_ch);
+        // Nothing special about this character. Most path characters are like
+        // this, so append it together with the run of plain characters that
+        // follows it.
+        int run_end = i + 1;
+        while (run_end < end &&
+               IsPlainPathChar(static_cast<UCHAR>(spec[run_end]))) {
+          run_end++;
+        }
+        AppendPlainPathRun(spec, i, run_end, output);
+        i = run_end - 1;
       }
     }
   }
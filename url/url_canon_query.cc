@@ -51,6 +51,22 @@ bool IsAllASCII(const CHAR* spec, const Component& query) {
   return true;
 }
 
+// Appends |source[begin, end)|, which must consist of 7-bit query characters.
+void AppendQueryRun(const char* source,
+                    int begin,
+                    int end,
+                    CanonOutput* output) {
+  output->Append(&source[begin], end - begin);
+}
+
+void AppendQueryRun(const base::char16* source,
+                    int begin,
+                    int end,
+                    CanonOutput* output) {
+  for (int i = begin; i < end; i++)
+    output->push_back(static_cast<char>(source[i]));
+}
+
 // Appends the given string to the output, escaping characters that do not
 // match the given |type| in SharedCharTypes. This version will accept 8 or 16
 // bit characters, but assumes that they have only 7-bit values. It also assumes
@@ -59,10 +75,19 @@ template<typename CHAR>
 void AppendRaw8BitQueryString(const CHAR* source, int length,
                               CanonOutput* output) {
   for (int i = 0; i < length; i++) {
-    if (!IsQueryChar(static_cast<unsigned char>(source[i])))
+    if (!IsQueryChar(static_cast<unsigned char>(source[i]))) {
       AppendEscapedChar(static_cast<unsigned char>(source[i]), output);
-    else  // Doesn't need escaping.
-      output->push_back(static_cast<char>(source[i]));
+      continue;
+    }
+    // Doesn't need escaping. Append it along with the run of query characters
+    // that follows it.
+    int run_end = i + 1;
+    while (run_end < length &&
+           IsQueryChar(static_cast<unsigned char>(source[run_end]))) {
+      run_end++;
+    }
+    AppendQueryRun(source, i, run_end, output);
+    i = run_end - 1;
   }
 }
 
@@ -132,4 +132,43 @@ TEST(URLParse, GURL) {
   gurl_timer.Done();
 }
 
+TEST(URLParse, GURLCopyAndCompare) {
+  const GURL gurl1(kTypicalUrl1);
+  const GURL gurl2(kTypicalUrl2);
+  const GURL gurl3(kTypicalUrl3);
+
+  base::PerfTimeLogger copy_timer("Typical_GURL_Copy_AMillion");
+  for (int i = 0; i < 333333; i++) {  // divide by 3 so we get 1M
+    GURL copy1(gurl1);
+    GURL copy2(gurl2);
+    GURL copy3(gurl3);
+  }
+  copy_timer.Done();
+
+  GURL other1(kTypicalUrl1);
+  int equal_count = 0;
+  base::PerfTimeLogger compare_timer("Typical_GURL_Compare_AMillion");
+  for (int i = 0; i < 333333; i++) {  // divide by 3 so we get 1M
+    equal_count += gurl1 == other1;
+    equal_count += gurl1 == gurl2;
+    equal_count += gurl2 < gurl3;
+  }
+  compare_timer.Done();
+  EXPECT_EQ(333333, equal_count);
+}
+
+TEST(URLParse, GURLGetOrigin) {
+  const GURL gurl1(kTypicalUrl1);
+  const GURL gurl2(kTypicalUrl2);
+  const GURL gurl3(kTypicalUrl3);
+
+  base::PerfTimeLogger origin_timer("Typical_GURL_GetOrigin_AMillion");
+  for (int i = 0; i < 333333; i++) {  // divide by 3 so we get 1M
+    GURL origin1 = gurl1.GetOrigin();
+    GURL origin2 = gurl2.GetOrigin();
+    GURL origin3 = gurl3.GetOrigin();
+  }
+  origin_timer.Done();
+}
+
 }  // namespace